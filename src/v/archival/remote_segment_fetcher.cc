@@ -0,0 +1,371 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Licensed as a Redpanda Enterprise file under the Redpanda Community
+// License (the "License"); you may not use this file except in compliance with
+// the License. You may obtain a copy of the License at
+//
+// https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+
+#include "archival/remote_segment_fetcher.h"
+
+#include "archival/logger.h"
+#include "bytes/iobuf.h"
+#include "model/record.h"
+#include "resource_mgmt/throttle.h"
+#include "storage/fs_utils.h"
+#include "storage/hydrated_segment_cache.h"
+#include "storage/parser.h"
+#include "storage/parser_errc.h"
+#include "vlog.h"
+
+#include <seastar/core/circular_buffer.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include <fmt/ostream.h>
+
+#include <algorithm>
+#include <filesystem>
+
+namespace archival {
+
+class remote_segment_reader;
+
+/// Materializes batches parsed from an archived segment into the
+/// reader's slice buffer; the offset, type and timestamp filtering
+/// mirrors the local skipping_consumer so remote reads observe the
+/// same semantics as local ones.
+class collecting_consumer final : public storage::batch_consumer {
+public:
+    explicit collecting_consumer(remote_segment_reader& reader) noexcept
+      : _reader(reader) {}
+
+    consume_result consume_batch_start(
+      model::record_batch_header,
+      size_t physical_base_offset,
+      size_t bytes_on_disk) override;
+
+    void consume_records(iobuf&&) override;
+    stop_parser consume_batch_end() override;
+    void print(std::ostream&) const override;
+
+private:
+    remote_segment_reader& _reader;
+    model::record_batch_header _header;
+    iobuf _records;
+};
+
+/// Streams batches out of a sequence of archived segments. One segment
+/// is open at a time: its body is fetched with a single GetObject and
+/// parsed incrementally, so at most a slice buffer plus the http read
+/// buffer is in memory regardless of segment size.
+class remote_segment_reader final : public model::record_batch_reader::impl {
+public:
+    using storage_t = model::record_batch_reader::storage_t;
+
+    /// per-slice buffer bound; same prefetch window as the local
+    /// log_segment_batch_reader
+    static constexpr size_t max_buffer_size = 32 * 1024; // 32KB
+
+    remote_segment_reader(
+      const s3::configuration& conf,
+      s3::bucket_name bucket,
+      std::vector<ss::sstring> keys,
+      storage::log_reader_config config,
+      storage::hydrated_segment_cache* cache)
+      : _client(conf)
+      , _bucket(std::move(bucket))
+      , _keys(std::move(keys))
+      , _config(config)
+      , _cache(cache) {}
+
+    bool is_end_of_stream() const final { return _eos; }
+
+    ss::future<storage_t> do_load_slice(model::timeout_clock::time_point) final;
+
+    ss::future<> finally() noexcept final {
+        return close_current().finally(
+          [this] { return _client.shutdown(); });
+    }
+
+    void print(std::ostream& os) final {
+        fmt::print(
+          os, "archival::remote_segment_reader config {}", _config);
+    }
+
+private:
+    friend class collecting_consumer;
+
+    struct tmp_state {
+        ss::circular_buffer<model::record_batch> buffer;
+        size_t buffer_size = 0;
+        bool is_full() const { return buffer_size >= max_buffer_size; }
+    };
+
+    void add_one(model::record_batch&&);
+    ss::future<> open_next_segment();
+    ss::future<> close_current();
+
+    bool is_done() const {
+        return _config.start_offset > _config.max_offset
+               || _config.bytes_consumed >= _config.max_bytes
+               || _config.over_budget;
+    }
+
+    s3::client _client;
+    s3::bucket_name _bucket;
+    std::vector<ss::sstring> _keys;
+    storage::hydrated_segment_cache* _cache;
+    size_t _next_key{0};
+    storage::log_reader_config _config;
+    model::term_id _term;
+    std::unique_ptr<storage::continuous_batch_parser> _parser;
+    tmp_state _state;
+    bool _eos{false};
+};
+
+storage::batch_consumer::consume_result
+collecting_consumer::consume_batch_start(
+  model::record_batch_header header,
+  size_t /*physical_base_offset*/,
+  size_t /*bytes_on_disk*/) {
+    if (header.last_offset() < _reader._config.start_offset) {
+        return skip_batch::yes;
+    }
+    if (header.base_offset() > _reader._config.max_offset) {
+        return stop_parser::yes;
+    }
+    if (
+      _reader._config.type_filter
+      && _reader._config.type_filter != header.type) {
+        _reader._config.start_offset = header.last_offset() + model::offset(1);
+        return skip_batch::yes;
+    }
+    if (_reader._config.filter && !_reader._config.filter(header)) {
+        _reader._config.start_offset = header.last_offset() + model::offset(1);
+        return skip_batch::yes;
+    }
+    if (_reader._config.first_timestamp > header.first_timestamp) {
+        _reader._config.start_offset = header.last_offset() + model::offset(1);
+        return skip_batch::yes;
+    }
+    if (
+      (_reader._config.strict_max_bytes || _reader._config.bytes_consumed)
+      && (_reader._config.bytes_consumed + header.size_bytes)
+           > _reader._config.max_bytes) {
+        _reader._config.over_budget = true;
+        return stop_parser::yes;
+    }
+    _header = header;
+    // the raft term is not stored in batch headers on disk; for local
+    // reads it is recovered from segment metadata, here from the
+    // archived segment's filename
+    _header.ctx.term = _reader._term;
+    return skip_batch::no;
+}
+
+void collecting_consumer::consume_records(iobuf&& records) {
+    _records = std::move(records);
+}
+
+storage::batch_consumer::stop_parser
+collecting_consumer::consume_batch_end() {
+    _reader.add_one(model::record_batch(
+      _header, std::move(_records), model::record_batch::tag_ctor_ng{}));
+    if (_header.last_offset() >= _reader._config.max_offset) {
+        return stop_parser::yes;
+    }
+    if (_reader._config.bytes_consumed >= _reader._config.max_bytes) {
+        return stop_parser::yes;
+    }
+    _header = {};
+    return stop_parser(_reader._state.is_full());
+}
+
+void collecting_consumer::print(std::ostream& os) const {
+    fmt::print(os, "archival::collecting_consumer");
+}
+
+void remote_segment_reader::add_one(model::record_batch&& batch) {
+    _state.buffer.emplace_back(std::move(batch));
+    auto& b = _state.buffer.back();
+    _config.start_offset = b.header().last_offset() + model::offset(1);
+    const auto size_bytes = b.header().size_bytes;
+    _config.bytes_consumed += size_bytes;
+    _state.buffer_size += size_bytes;
+}
+
+static ss::future<ss::stop_iteration>
+write_throttled(ss::output_stream<char>& out, ss::temporary_buffer<char> buf) {
+    if (buf.empty()) {
+        return ss::make_ready_future<ss::stop_iteration>(
+          ss::stop_iteration::yes);
+    }
+    auto sz = buf.size();
+    return background_throttle::shard_local()
+      .archival_fetch()
+      .acquire(sz)
+      .then([&out, buf = std::move(buf)]() mutable {
+          return out.write(std::move(buf));
+      })
+      .then([] { return ss::stop_iteration::no; });
+}
+
+ss::future<> remote_segment_reader::open_next_segment() {
+    auto key = _keys[_next_key++];
+    auto name = std::filesystem::path(key.c_str()).filename().string();
+    if (auto meta = storage::segment_path::parse_segment_filename(
+          ss::sstring(name))) {
+        _term = meta->term;
+    }
+    if (_cache != nullptr) {
+        // hydrate through the cache: the first reader of this segment
+        // downloads it, everyone else parses the cached file
+        return _cache
+          ->get(
+            key,
+            [this, key](ss::output_stream<char>& out) {
+                vlog(archival_log.debug, "downloading archived segment {}", key);
+                return _client.get_object(_bucket, s3::object_key(key))
+                  .then([&out](http::client::response_stream_ref stream) {
+                      return ss::do_with(
+                        stream->as_input_stream(),
+                        [&out](ss::input_stream<char>& in) {
+                            // pace the download chunk by chunk against
+                            // the shared background throttle
+                            return ss::repeat([&in, &out] {
+                                       return in.read().then(
+                                         [&out](
+                                           ss::temporary_buffer<char> buf) {
+                                             return write_throttled(
+                                               out, std::move(buf));
+                                         });
+                                   })
+                              .then([&in] { return in.close(); });
+                        });
+                  });
+            })
+          .then([this](ss::file f) {
+              _parser = std::make_unique<storage::continuous_batch_parser>(
+                std::make_unique<collecting_consumer>(*this),
+                ss::make_file_input_stream(std::move(f)));
+          });
+    }
+    vlog(archival_log.debug, "hydrating archived segment {}", key);
+    return _client.get_object(_bucket, s3::object_key(std::move(key)))
+      .then([this](http::client::response_stream_ref stream) {
+          // the input stream holds a reference on the response stream
+          _parser = std::make_unique<storage::continuous_batch_parser>(
+            std::make_unique<collecting_consumer>(*this),
+            stream->as_input_stream());
+      });
+}
+
+ss::future<> remote_segment_reader::close_current() {
+    if (!_parser) {
+        return ss::make_ready_future<>();
+    }
+    auto parser = std::move(_parser);
+    auto raw = parser.get();
+    return raw->close().finally([p = std::move(parser)] {});
+}
+
+ss::future<remote_segment_reader::storage_t>
+remote_segment_reader::do_load_slice(model::timeout_clock::time_point timeout) {
+    if (is_done() || (!_parser && _next_key == _keys.size())) {
+        _eos = true;
+        return close_current().then(
+          [] { return ss::make_ready_future<storage_t>(); });
+    }
+    auto opened = _parser ? ss::make_ready_future<>() : open_next_segment();
+    return std::move(opened)
+      .then([this] { return _parser->consume(); })
+      .then([this, timeout](result<size_t> consumed) -> ss::future<storage_t> {
+          if (!consumed) {
+              if (consumed.error() != storage::parser_errc::end_of_stream) {
+                  _eos = true;
+                  return close_current().then([e = consumed.error()] {
+                      return ss::make_exception_future<storage_t>(
+                        std::runtime_error(fmt::format(
+                          "error parsing archived segment: {}", e.message())));
+                  });
+              }
+              // segment exhausted; fall through and advance
+          }
+          auto tmp = std::exchange(_state, {});
+          if (tmp.buffer.empty()) {
+              // this segment yielded nothing more (end of its stream or
+              // every batch was skipped); move to the next archived one
+              return close_current().then(
+                [this, timeout] { return do_load_slice(timeout); });
+          }
+          return ss::make_ready_future<storage_t>(std::move(tmp.buffer));
+      })
+      .handle_exception([this](std::exception_ptr e) {
+          _eos = true;
+          return close_current().then(
+            [e] { return ss::make_exception_future<storage_t>(e); });
+      });
+}
+
+std::vector<ss::sstring> remote_segment_fetcher::select_segments(
+  const std::vector<s3::client::list_bucket_item>& items,
+  model::offset start,
+  model::offset max) {
+    // keys that do not parse as "<base>-<term>-<version>.log" (indices,
+    // snapshots, or unrelated objects under the prefix) are ignored
+    std::vector<std::pair<model::offset, ss::sstring>> segments;
+    segments.reserve(items.size());
+    for (const auto& item : items) {
+        auto name = std::filesystem::path(item.key.c_str())
+                      .filename()
+                      .string();
+        auto meta = storage::segment_path::parse_segment_filename(
+          ss::sstring(name));
+        if (!meta) {
+            continue;
+        }
+        segments.emplace_back(meta->base_offset, item.key);
+    }
+    std::sort(segments.begin(), segments.end());
+    std::vector<ss::sstring> keys;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (segments[i].first > max) {
+            break;
+        }
+        // drop segments known to end before the requested start
+        if (i + 1 < segments.size() && segments[i + 1].first <= start) {
+            continue;
+        }
+        keys.push_back(std::move(segments[i].second));
+    }
+    return keys;
+}
+
+ss::future<std::optional<model::record_batch_reader>>
+remote_segment_fetcher::fetch(
+  const model::ntp& ntp, storage::log_reader_config config) {
+    vlog(
+      archival_log.debug,
+      "looking up archived segments for {} at offset {}",
+      ntp,
+      config.start_offset);
+    auto client = ss::make_lw_shared<s3::client>(_conf);
+    auto prefix = s3::object_key(ss::format("{}/", ntp.path()));
+    return client->list_objects_v2(_bucket, std::move(prefix))
+      .then([this, config](s3::client::list_bucket_result res) {
+          auto keys = select_segments(
+            res.contents, config.start_offset, config.max_offset);
+          if (keys.empty()) {
+              return std::optional<model::record_batch_reader>{};
+          }
+          return std::optional<model::record_batch_reader>(
+            model::make_record_batch_reader<remote_segment_reader>(
+              _conf, _bucket, std::move(keys), config, _cache));
+      })
+      .finally([client] {
+          return client->shutdown().finally([client] {});
+      });
+}
+
+} // namespace archival
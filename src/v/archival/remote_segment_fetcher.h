@@ -0,0 +1,77 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "model/record_batch_reader.h"
+#include "s3/client.h"
+#include "seastarx.h"
+#include "storage/remote_fetcher.h"
+#include "storage/types.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/sstring.hh>
+
+#include <optional>
+#include <vector>
+
+namespace storage {
+class hydrated_segment_cache;
+} // namespace storage
+
+namespace archival {
+
+/// \brief Reads archived log segments back from object storage.
+///
+/// Segments are uploaded by external tooling under the same layout the
+/// log_manager uses on disk:
+///
+///   <namespace>/<topic>/<partition>/<base offset>-<term>-<version>.log
+///
+/// so the segment holding a given offset is located with one prefixed
+/// listing and no manifest. Batches stream through the same parser the
+/// local read path uses, bounded to the local segment reader's per-slice
+/// buffer, so an archived read never materializes a whole segment in
+/// memory.
+class remote_segment_fetcher final : public storage::remote_fetcher {
+public:
+    remote_segment_fetcher(s3::configuration conf, s3::bucket_name bucket)
+      : _conf(std::move(conf))
+      , _bucket(std::move(bucket)) {}
+
+    ss::future<std::optional<model::record_batch_reader>>
+    fetch(const model::ntp&, storage::log_reader_config) final;
+
+    /// for ss::sharded<>
+    ss::future<> stop() { return ss::make_ready_future<>(); }
+
+    /// Serve repeated reads of one archived segment from local disk:
+    /// with a cache installed segments are hydrated into it once and
+    /// parsed from the cached file. The pointer is held, not owned.
+    void set_cache(storage::hydrated_segment_cache* cache) { _cache = cache; }
+
+    /// Pick the archived segments that may hold offsets in [start, max]
+    /// from a listing of the ntp prefix, in base offset order. A segment
+    /// spans [base, next segment base); the last segment's end is not
+    /// known from the listing so it is always a candidate and the reader
+    /// filters on batch headers.
+    static std::vector<ss::sstring> select_segments(
+      const std::vector<s3::client::list_bucket_item>&,
+      model::offset start,
+      model::offset max);
+
+private:
+    s3::configuration _conf;
+    s3::bucket_name _bucket;
+    storage::hydrated_segment_cache* _cache{nullptr};
+};
+
+} // namespace archival
@@ -0,0 +1,64 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Licensed as a Redpanda Enterprise file under the Redpanda Community
+// License (the "License"); you may not use this file except in compliance with
+// the License. You may obtain a copy of the License at
+//
+// https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+
+#include "archival/remote_segment_fetcher.h"
+#include "model/fundamental.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+using item_t = s3::client::list_bucket_item;
+
+static std::vector<item_t> make_listing() {
+    // deliberately unordered; includes non-segment keys that must be
+    // ignored
+    return {
+      item_t{.key = "kafka/t/0/2000-2-v1.log"},
+      item_t{.key = "kafka/t/0/0-1-v1.log"},
+      item_t{.key = "kafka/t/0/1000-1-v1.base_index"},
+      item_t{.key = "kafka/t/0/1000-1-v1.log"},
+      item_t{.key = "kafka/t/0/manifest.json"},
+    };
+}
+
+SEASTAR_THREAD_TEST_CASE(test_select_segments) {
+    using fetcher = archival::remote_segment_fetcher;
+    auto listing = make_listing();
+
+    // a range inside one segment selects exactly that segment
+    auto keys = fetcher::select_segments(
+      listing, model::offset(1500), model::offset(1600));
+    BOOST_REQUIRE_EQUAL(keys.size(), 1);
+    BOOST_REQUIRE_EQUAL(keys[0], "kafka/t/0/1000-1-v1.log");
+
+    // a range spanning segments selects all of them, in offset order
+    keys = fetcher::select_segments(
+      listing, model::offset(500), model::offset(2500));
+    BOOST_REQUIRE_EQUAL(keys.size(), 3);
+    BOOST_REQUIRE_EQUAL(keys[0], "kafka/t/0/0-1-v1.log");
+    BOOST_REQUIRE_EQUAL(keys[1], "kafka/t/0/1000-1-v1.log");
+    BOOST_REQUIRE_EQUAL(keys[2], "kafka/t/0/2000-2-v1.log");
+
+    // the last segment's end is unknown, so it stays a candidate even
+    // for offsets past its base
+    keys = fetcher::select_segments(
+      listing, model::offset(5000), model::offset(6000));
+    BOOST_REQUIRE_EQUAL(keys.size(), 1);
+    BOOST_REQUIRE_EQUAL(keys[0], "kafka/t/0/2000-2-v1.log");
+
+    // a max offset below every base selects nothing... except offset 0
+    // belongs to the first segment
+    keys = fetcher::select_segments(
+      listing, model::offset(0), model::offset(0));
+    BOOST_REQUIRE_EQUAL(keys.size(), 1);
+    BOOST_REQUIRE_EQUAL(keys[0], "kafka/t/0/0-1-v1.log");
+
+    // an empty listing selects nothing
+    keys = fetcher::select_segments(
+      {}, model::offset(0), model::offset(1000));
+    BOOST_REQUIRE(keys.empty());
+}
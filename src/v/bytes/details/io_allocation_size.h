@@ -24,19 +24,20 @@ class io_allocation_size {
 public:
     static constexpr size_t max_chunk_size = 128 * 1024;
     static constexpr size_t default_chunk_size = 512;
+    static constexpr size_t min_chunk_size = 64;
 
     // the largest size handled by seastar's small object pool
     static constexpr size_t ss_max_small_allocation = 16384;
 
 public:
-    // >>> x=512
-    // >>> while x < int((1024*128)):
-    // ...     print(x)
-    // ...     x=int(((x*3)+1)/2)
-    // ...     x=int(min(1024*128,x))
-    // print(1024*128)
-    static constexpr std::array<uint32_t, 15> alloc_table =
-      // computed from a python script above
+    // ~1.5x growth steps while sizes are served by seastar's small object
+    // pool, then power of two steps that map exactly onto spans in the
+    // large allocation pool. continuing the 1.5x sequence above 16KiB
+    // (19683, 29525, 44288, ...) makes every large fragment round up
+    // internally and waste up to a third of its span; with exact span
+    // sizes a freed fragment goes back onto the per-shard pool free list
+    // and the next allocation of the same class is a plain free list pop
+    static constexpr std::array<uint32_t, 13> alloc_table =
       {{512,
         768,
         1152,
@@ -46,14 +47,26 @@ public:
         5832,
         8748,
         13122,
-        19683,
-        29525,
-        44288,
-        66432,
-        99648,
+        16384,
+        32768,
+        65536,
         131072}};
     static size_t next_allocation_size(size_t data_size);
 
+    // sizing for the first fragment of an iobuf. most iobufs on the
+    // metadata path hold a single tiny payload - a topic name, a key -
+    // and never grow; power of two classes between min_chunk_size and
+    // default_chunk_size keep those out of the regular growth steps
+    // instead of paying the full first step for a handful of bytes.
+    // anything at least default_chunk_size follows the regular table
+    static size_t first_allocation_size(size_t data_size) {
+        if (data_size >= default_chunk_size) {
+            return next_allocation_size(data_size);
+        }
+        return std::max(
+          min_chunk_size, static_cast<size_t>(1) << ss::log2ceil(data_size));
+    }
+
     // if the size falls into the range of seastar's small allocator, allow a
     // full allocation. otherwise, allocate on lower bound power of 2 size which
     // aligns with a span bucket in seastar's large allocation pool.
@@ -28,7 +28,6 @@
 #include <seastar/core/smp.hh>
 #include <seastar/core/temporary_buffer.hh>
 
-#include <boost/container_hash/hash.hpp> // hash_combine
 #include <fmt/format.h>
 
 #include <cstddef>
@@ -121,6 +120,21 @@ public:
      */
     iobuf copy() const;
 
+    /// number of fragments backing the payload. O(n) in fragments
+    size_t fragment_count() const;
+
+    /// true when the per-fragment bookkeeping plus trailing allocation
+    /// slack crosses compact_overhead_percent of the payload - the point
+    /// where the one-time copy of compact() pays for itself on buffers
+    /// that stay resident (e.g. the batch cache)
+    bool should_compact() const;
+
+    /// re-packs the payload into the fewest fragments the allocator
+    /// supports, shedding list-node overhead and allocation slack at the
+    /// price of one copy of the payload. meant for long-lived buffers,
+    /// not hot-path data
+    void compact();
+
     /// makes a reservation with the internal storage. adds a layer of
     /// indirection instead of raw byte pointer to allow the
     /// details::io_fragments to internally compact buffers as long as they
@@ -169,6 +183,13 @@ public:
     const_iterator cend() const;
 
 private:
+    /// below this many fragments the bookkeeping can never be a noticeable
+    /// slice of the payload and compaction is a wasted copy
+    static constexpr size_t compact_min_fragments = 4;
+    /// fragment bookkeeping + slack as a percentage of the payload above
+    /// which should_compact() recommends re-packing
+    static constexpr size_t compact_overhead_percent = 10;
+
     /// \brief trims the back, and appends direct.
     void prepend_take_ownership(fragment*);
 
@@ -230,8 +251,13 @@ inline void iobuf::prepend_take_ownership(fragment* f) {
 
 inline void iobuf::create_new_fragment(size_t sz) {
     oncore_debug_verify(_verify_shard);
-    auto chunk_max = std::max(sz, last_allocation_size());
-    auto asz = details::io_allocation_size::next_allocation_size(chunk_max);
+    size_t asz;
+    if (_frags.empty()) {
+        asz = details::io_allocation_size::first_allocation_size(sz);
+    } else {
+        auto chunk_max = std::max(sz, last_allocation_size());
+        asz = details::io_allocation_size::next_allocation_size(chunk_max);
+    }
     auto f = new fragment(ss::temporary_buffer<char>(asz), fragment::empty{});
     append_take_ownership(f);
 }
@@ -401,11 +427,16 @@ iobuf iobuf_copy(iobuf::iterator_consumer& in, size_t len);
 namespace std {
 template<>
 struct hash<::iobuf> {
+    /// depends only on the byte sequence - equal iobufs with different
+    /// fragment layouts hash the same. fnv-1a to stay dependency free
     size_t operator()(const ::iobuf& b) const {
-        size_t h = 0;
+        constexpr size_t prime = 0x100000001b3;
+        size_t h = 0xcbf29ce484222325;
         for (auto& f : b) {
-            boost::hash_combine(
-              h, std::hash<std::string_view>{}({f.get(), f.size()}));
+            const char* p = f.get();
+            for (size_t i = 0; i < f.size(); ++i) {
+                h = (h ^ static_cast<unsigned char>(p[i])) * prime;
+            }
         }
         return h;
     }
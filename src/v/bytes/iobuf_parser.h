@@ -88,6 +88,11 @@ public:
         return _in.consume(n, std::forward<Consumer>(f));
     }
 
+    template<typename Output>
+    void consume_to(size_t n, Output out) {
+        _in.consume_to(n, out);
+    }
+
     iobuf copy(size_t len) { return iobuf_copy(_in, len); }
 
 protected:
@@ -13,6 +13,7 @@
 #include "bytes/iobuf_istreambuf.h"
 #include "bytes/iobuf_ostreambuf.h"
 #include "bytes/tests/utils.h"
+#include "hashing/xx.h"
 
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/testing/thread_test_case.hh>
@@ -333,7 +334,7 @@ SEASTAR_THREAD_TEST_CASE(iobuf_as_ostream) {
 }
 
 SEASTAR_THREAD_TEST_CASE(alloctor_forward_progress) {
-    static constexpr std::array<uint32_t, 14> src = {{
+    static constexpr std::array<uint32_t, 12> src = {{
       512,
       768,
       1152,
@@ -343,13 +344,11 @@ SEASTAR_THREAD_TEST_CASE(alloctor_forward_progress) {
       5832,
       8748,
       13122,
-      19683,
-      29525,
-      44288,
-      66432,
-      99648,
+      16384,
+      32768,
+      65536,
     }};
-    static constexpr std::array<uint32_t, 14> expected = {{
+    static constexpr std::array<uint32_t, 12> expected = {{
       768,
       1152,
       1728,
@@ -358,11 +357,9 @@ SEASTAR_THREAD_TEST_CASE(alloctor_forward_progress) {
       5832,
       8748,
       13122,
-      19683,
-      29525,
-      44288,
-      66432,
-      99648,
+      16384,
+      32768,
+      65536,
       131072,
     }};
     BOOST_REQUIRE_EQUAL(src.size(), expected.size());
@@ -373,6 +370,61 @@ SEASTAR_THREAD_TEST_CASE(alloctor_forward_progress) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(equality_and_hash_are_fragmentation_independent) {
+    const ss::sstring data = random_generators::gen_alphanum_string(1000);
+    iobuf contiguous;
+    contiguous.append(data.data(), data.size());
+
+    // prepend unconditionally creates a fragment, forcing a different
+    // layout over the same byte sequence
+    iobuf fragmented;
+    for (size_t end = data.size(); end > 0;) {
+        const size_t start = end < 7 ? 0 : end - 7;
+        ss::temporary_buffer<char> chunk(data.data() + start, end - start);
+        fragmented.prepend(std::move(chunk));
+        end = start;
+    }
+    BOOST_REQUIRE(contiguous == fragmented);
+    BOOST_REQUIRE_EQUAL(
+      std::hash<iobuf>{}(contiguous), std::hash<iobuf>{}(fragmented));
+
+    incremental_xxhash64 a;
+    a.update(contiguous);
+    incremental_xxhash64 b;
+    b.update(fragmented);
+    const auto expected = xxhash_64(data.data(), data.size());
+    BOOST_CHECK_EQUAL(a.digest(), expected);
+    BOOST_CHECK_EQUAL(b.digest(), expected);
+
+    // differing bytes with equal sizes must still compare unequal
+    iobuf other = contiguous.copy();
+    other.trim_front(1);
+    other.prepend(ss::temporary_buffer<char>(1));
+    BOOST_REQUIRE(!(contiguous == other));
+}
+
+SEASTAR_THREAD_TEST_CASE(small_first_fragment_is_right_sized) {
+    // a tiny payload must not pay the full first growth step
+    {
+        iobuf buf;
+        buf.append("topic-name", 10);
+        BOOST_REQUIRE_EQUAL(buf.begin()->capacity(), 64);
+    }
+    {
+        iobuf buf;
+        const auto b = random_generators::gen_alphanum_string(100);
+        buf.append(b.data(), b.size());
+        BOOST_REQUIRE_EQUAL(buf.begin()->capacity(), 128);
+    }
+    // at the default chunk size the regular growth table takes over
+    {
+        iobuf buf;
+        const auto b = random_generators::gen_alphanum_string(512);
+        buf.append(b.data(), b.size());
+        BOOST_REQUIRE_EQUAL(buf.begin()->capacity(), 768);
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(test_next_chunk_allocation_append_temp_buf) {
     const auto b = random_generators::gen_alphanum_string(1024);
 
@@ -383,7 +435,7 @@ SEASTAR_THREAD_TEST_CASE(test_next_chunk_allocation_append_temp_buf) {
     }
     // slow but tha'ts life.
     auto distance = std::distance(buf.begin(), buf.end());
-    BOOST_REQUIRE_EQUAL(distance, 324);
+    BOOST_REQUIRE_EQUAL(distance, 323);
     constexpr size_t sz = 40000 * 1024;
     auto msg = iobuf_as_scattered(std::move(buf));
     BOOST_REQUIRE_EQUAL(msg.size(), sz);
@@ -399,7 +451,7 @@ SEASTAR_THREAD_TEST_CASE(test_next_chunk_allocation_append_iobuf) {
     }
     // slow but tha'ts life.
     auto distance = std::distance(buf.begin(), buf.end());
-    BOOST_REQUIRE_EQUAL(distance, 324);
+    BOOST_REQUIRE_EQUAL(distance, 323);
     constexpr size_t sz = 40000 * 1024;
     auto msg = iobuf_as_scattered(std::move(buf));
     BOOST_REQUIRE_EQUAL(msg.size(), sz);
@@ -568,3 +620,33 @@ SEASTAR_THREAD_TEST_CASE(iobuf_as_istream) {
     BOOST_REQUIRE_EQUAL(underlying.size_bytes(), out.size());
     BOOST_REQUIRE_EQUAL(a + b, out);
 }
+
+SEASTAR_THREAD_TEST_CASE(iobuf_compact_repacks_fragmented_payload) {
+    const auto data = random_generators::gen_alphanum_string(16);
+    iobuf buf;
+    for (int i = 0; i < 64; ++i) {
+        ss::temporary_buffer<char> b(data.size());
+        std::copy_n(data.data(), data.size(), b.get_write());
+        // one full fragment per buffer
+        buf.prepend(std::move(b));
+    }
+    const auto expected = buf.copy();
+    const auto frags_before = buf.fragment_count();
+    BOOST_REQUIRE_EQUAL(frags_before, 64);
+    BOOST_REQUIRE(buf.should_compact());
+
+    buf.compact();
+
+    BOOST_REQUIRE(buf == expected);
+    BOOST_REQUIRE_LT(buf.fragment_count(), frags_before);
+    BOOST_REQUIRE(!buf.should_compact());
+}
+
+SEASTAR_THREAD_TEST_CASE(iobuf_should_compact_ignores_small_buffers) {
+    iobuf buf;
+    buf.append("abc", 3);
+    // too few fragments for the bookkeeping to matter
+    BOOST_REQUIRE(!buf.should_compact());
+    buf.compact();
+    BOOST_REQUIRE_EQUAL(buf.size_bytes(), 3);
+}
@@ -128,7 +128,9 @@ ss::future<> maybe_create_tcp_client(
                       .server_addr = new_addr,
                       .credentials = cert,
                       .disable_metrics = rpc::metrics_disabled(
-                        config::shard_local_cfg().disable_metrics)},
+                        config::shard_local_cfg().disable_metrics),
+                      .flush_delay
+                      = config::shard_local_cfg().rpc_client_flush_delay()},
                     rpc::make_exponential_backoff_policy<rpc::clock_type>(
                       std::chrono::seconds(1), std::chrono::seconds(60)));
               });
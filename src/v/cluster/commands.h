@@ -171,15 +171,54 @@ std::optional<deserializer<Cmd>> make_deserializer(command_type tp) {
 }
 } // namespace internal
 
+/// Serialize a set of commands of the same type into a single batch with one
+/// record per command. Each record keeps the layout produced by
+/// serialize_cmd, so key based compaction and per record deserialization are
+/// unaffected, while N commands cost one replication round and one fsync.
+template<typename Cmd>
+CONCEPT(requires ControllerCommand<Cmd>)
+ss::future<model::record_batch> serialize_cmds(std::vector<Cmd> cmds) {
+    return ss::do_with(
+      std::move(cmds),
+      simple_batch_builder(Cmd::batch_type, model::offset(0)),
+      [](std::vector<Cmd>& cmds, simple_batch_builder& builder) {
+          return ss::do_for_each(
+                   cmds,
+                   [&builder](Cmd& cmd) {
+                       return ss::do_with(
+                         iobuf{},
+                         iobuf{},
+                         [&builder, &cmd](iobuf& key_buf, iobuf& value_buf) {
+                             auto value_f
+                               = reflection::async_adl<command_type>{}
+                                   .to(value_buf, Cmd::type)
+                                   .then([&value_buf,
+                                          v = std::move(cmd.value)]() mutable {
+                                       return reflection::adl<
+                                         typename Cmd::value_t>{}
+                                         .to(value_buf, std::move(v));
+                                   });
+                             auto key_f
+                               = reflection::async_adl<typename Cmd::key_t>{}
+                                   .to(key_buf, std::move(cmd.key));
+                             return ss::when_all_succeed(
+                                      std::move(key_f), std::move(value_f))
+                               .discard_result()
+                               .then([&builder, &key_buf, &value_buf] {
+                                   builder.add_raw_kv(
+                                     std::move(key_buf), std::move(value_buf));
+                               });
+                         });
+                   })
+            .then([&builder] { return std::move(builder).build(); });
+      });
+}
+
 template<typename... Commands>
 ss::future<std::variant<Commands...>>
-deserialize(model::record_batch b, commands_type_list<Commands...>) {
-    vassert(
-      b.record_count() == 1,
-      "Currently we expect single command in single batch");
-    auto records = b.copy_records();
-    iobuf_parser v_parser(records.begin()->release_value());
-    iobuf_parser k_parser(records.begin()->release_key());
+deserialize_record(model::record r, commands_type_list<Commands...>) {
+    iobuf_parser v_parser(r.release_value());
+    iobuf_parser k_parser(r.release_key());
     // chose deserializer
     auto cmd_type = reflection::adl<command_type>{}.from(v_parser);
     std::optional<std::variant<internal::deserializer<Commands>...>> ret;
@@ -195,4 +234,37 @@ deserialize(model::record_batch b, commands_type_list<Commands...>) {
       },
       *ret);
 }
+
+template<typename... Commands>
+ss::future<std::variant<Commands...>>
+deserialize(model::record_batch b, commands_type_list<Commands...> list) {
+    vassert(
+      b.record_count() == 1,
+      "Currently we expect single command in single batch");
+    auto records = b.copy_records();
+    return deserialize_record(std::move(*records.begin()), list);
+}
+
+/// Deserialize every command carried by a batch, in record order. Single
+/// command batches yield a one element vector, so both layouts decode
+/// through the same path.
+template<typename... Commands>
+ss::future<std::vector<std::variant<Commands...>>>
+deserialize_commands(model::record_batch b, commands_type_list<Commands...>) {
+    using ret_t = std::vector<std::variant<Commands...>>;
+    return ss::do_with(
+      b.copy_records(), ret_t{}, [](auto& records, ret_t& cmds) {
+          cmds.reserve(records.size());
+          return ss::do_for_each(
+                   records,
+                   [&cmds](model::record& r) {
+                       return deserialize_record(
+                                std::move(r), commands_type_list<Commands...>{})
+                         .then([&cmds](std::variant<Commands...> cmd) {
+                             cmds.push_back(std::move(cmd));
+                         });
+                   })
+            .then([&cmds] { return std::move(cmds); });
+      });
+}
 } // namespace cluster
@@ -89,12 +89,28 @@ ss::future<> controller::start() {
             std::ref(_as));
       })
       .then([this] {
-          return _stm.invoke_on(controller_stm_shard, &controller_stm::start);
+          return _snapshot.start_single(
+            _raft0,
+            std::ref(_stm),
+            std::ref(_tp_state),
+            std::ref(_partition_allocator),
+            std::ref(_tp_updates_dispatcher));
       })
       .then([this] {
+          // members have to be registered before hydrating the snapshot
+          // so that allocation state updates account them
           return _members_manager.invoke_on(
             members_manager::shard, &members_manager::start);
       })
+      .then([this] {
+          // recover state from the latest controller snapshot before the
+          // stm starts replaying the log suffix
+          return _snapshot.invoke_on(
+            controller_snapshot::shard, &controller_snapshot::hydrate);
+      })
+      .then([this] {
+          return _stm.invoke_on(controller_stm_shard, &controller_stm::start);
+      })
       .then([this] {
           return _stm.invoke_on(controller_stm_shard, [](controller_stm& stm) {
               // we do not have to use timeout in here as all the batches to
@@ -102,11 +118,31 @@ ss::future<> controller::start() {
               return stm.wait(stm.bootstrap_last_applied(), model::no_timeout);
           });
       })
+      .then([this] {
+          return _snapshot.invoke_on(
+            controller_snapshot::shard, &controller_snapshot::start);
+      })
       .then(
-        [this] { return _backend.invoke_on_all(&controller_backend::start); });
+        [this] { return _backend.invoke_on_all(&controller_backend::start); })
+      .then([this] {
+          return _balancer.start_single(
+            _raft0,
+            std::ref(_tp_state),
+            std::ref(_members_table),
+            std::ref(_partition_leaders),
+            std::ref(_tp_frontend),
+            std::ref(_partition_manager),
+            std::ref(_shard_table));
+      })
+      .then([this] {
+          return _balancer.invoke_on(
+            partition_balancer::shard, &partition_balancer::start);
+      });
 }
 ss::future<> controller::stop() {
     return _as.invoke_on_all(&ss::abort_source::request_abort)
+      .then([this] { return _balancer.stop(); })
+      .then([this] { return _snapshot.stop(); })
       .then([this] { return _stm.stop(); })
       .then([this] { return _members_manager.stop(); })
       .then([this] { return _tp_frontend.stop(); })
@@ -13,9 +13,11 @@
 
 #include "cluster/controller_backend.h"
 #include "cluster/controller_service.h"
+#include "cluster/controller_snapshot.h"
 #include "cluster/controller_stm.h"
 #include "cluster/members_manager.h"
 #include "cluster/metadata_dissemination_service.h"
+#include "cluster/partition_balancer.h"
 #include "cluster/partition_leaders_table.h"
 #include "cluster/partition_manager.h"
 #include "cluster/shard_table.h"
@@ -68,7 +70,9 @@ private:
     ss::sharded<topics_frontend> _tp_frontend;     // instance per core
     ss::sharded<controller_backend> _backend;      // instance per core
     ss::sharded<controller_stm> _stm;              // single instance
+    ss::sharded<controller_snapshot> _snapshot;    // single instance
     ss::sharded<controller_service> _service;      // instance per core
+    ss::sharded<partition_balancer> _balancer;     // single instance
     ss::sharded<rpc::connection_cache>& _connections;
     ss::sharded<partition_manager>& _partition_manager;
     ss::sharded<shard_table>& _shard_table;
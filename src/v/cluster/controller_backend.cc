@@ -20,6 +20,7 @@
 #include "model/fundamental.h"
 #include "model/metadata.h"
 #include "outcome.h"
+#include "prometheus/prometheus_sanitize.h"
 #include "raft/configuration.h"
 #include "raft/types.h"
 #include "ssx/future-util.h"
@@ -28,6 +29,7 @@
 #include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/metrics.hh>
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/sharded.hh>
 #include <seastar/core/smp.hh>
@@ -54,7 +56,9 @@ controller_backend::controller_backend(
   , _partition_leaders_table(leaders)
   , _self(model::node_id(config::shard_local_cfg().node_id))
   , _data_directory(config::shard_local_cfg().data_directory().as_sstring())
-  , _as(as) {}
+  , _as(as)
+  , _max_concurrent_ops(
+      config::shard_local_cfg().controller_backend_max_concurrent_ops()) {}
 
 ss::future<> controller_backend::stop() {
     _housekeeping_timer.cancel();
@@ -62,12 +66,51 @@ ss::future<> controller_backend::stop() {
 }
 
 ss::future<> controller_backend::start() {
+    setup_metrics();
     start_topics_reconciliation_loop();
     _housekeeping_timer.set_callback([this] { housekeeping(); });
     _housekeeping_timer.arm_periodic(std::chrono::seconds(1));
     return ss::now();
 }
 
+void controller_backend::setup_metrics() {
+    namespace sm = ss::metrics;
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("cluster:controller_backend"),
+      {
+        sm::make_gauge(
+          "pending_partition_operations",
+          [this] {
+              size_t pending = 0;
+              for (const auto& [ntp, deltas] : _topic_deltas) {
+                  pending += deltas.size();
+              }
+              return pending;
+          },
+          sm::description("Number of partition operations awaiting "
+                          "reconciliation on this shard")),
+        sm::make_derive(
+          "partitions_created",
+          [this] { return _partitions_created; },
+          sm::description("Total number of partitions created")),
+        sm::make_derive(
+          "partitions_deleted",
+          [this] { return _partitions_deleted; },
+          sm::description("Total number of partitions deleted")),
+        sm::make_derive(
+          "partitions_updated",
+          [this] { return _partitions_updated; },
+          sm::description("Total number of partition updates applied")),
+        sm::make_histogram(
+          "partition_operation_latency",
+          [this] { return _op_hist.seastar_histogram_logform(); },
+          sm::description("Partition operation execution latency")),
+      });
+}
+
 ss::future<> controller_backend::fetch_deltas() {
     return _topics.local()
       .wait_for_changes(_as.local())
@@ -137,13 +180,18 @@ ss::future<> controller_backend::reconcile_topics() {
         if (_topic_deltas.empty()) {
             return ss::now();
         }
-        // reconcile NTPs in parallel
-        return ss::parallel_for_each(
+        // reconcile NTPs in parallel. deltas for different ntps are
+        // independent of each other, deltas of a single ntp are applied in
+        // order by reconcile_ntp. chunking bounds how many ntps are worked
+        // on at a time and yields between chunks, so a node rejoining with
+        // a large backlog neither stalls the reactor nor serializes
+        return ssx::concurrent_for_each(
                  _topic_deltas.begin(),
                  _topic_deltas.end(),
                  [this](underlying_t::value_type& ntp_deltas) {
                      return reconcile_ntp(ntp_deltas.second);
-                 })
+                 },
+                 _max_concurrent_ops)
           .then([this] {
               // cleanup empty NTP keys
               for (auto it = _topic_deltas.cbegin();
@@ -199,26 +247,36 @@ controller_backend::execute_partitition_op(const topic_table::delta& delta) {
      */
     vlog(clusterlog.trace, "Executing operation: {}", delta);
     model::revision_id rev(delta.offset());
-    // new partitions
-
-    // only create partitions for this backend
-    // partitions created on current shard at this node
-    switch (delta.type) {
-    case topic_table::delta::op_type::add:
-        if (!has_local_replicas(_self, delta.p_as.replicas)) {
-            return ss::make_ready_future<std::error_code>(errc::success);
+    auto measure = _op_hist.auto_measure();
+    auto f = [&]() -> ss::future<std::error_code> {
+        // new partitions
+
+        // only create partitions for this backend
+        // partitions created on current shard at this node
+        switch (delta.type) {
+        case topic_table::delta::op_type::add:
+            if (!has_local_replicas(_self, delta.p_as.replicas)) {
+                return ss::make_ready_future<std::error_code>(errc::success);
+            }
+            return create_partition(
+              delta.ntp,
+              delta.p_as.group,
+              rev,
+              create_brokers_set(delta.p_as.replicas, _members_table.local()));
+        case topic_table::delta::op_type::del:
+            return delete_partition(delta.ntp, rev);
+        case topic_table::delta::op_type::update:
+            return process_partition_update(delta.ntp, delta.p_as, rev)
+              .then([this](std::error_code ec) {
+                  if (!ec) {
+                      ++_partitions_updated;
+                  }
+                  return ec;
+              });
         }
-        return create_partition(
-          delta.ntp,
-          delta.p_as.group,
-          rev,
-          create_brokers_set(delta.p_as.replicas, _members_table.local()));
-    case topic_table::delta::op_type::del:
-        return delete_partition(delta.ntp, rev);
-    case topic_table::delta::op_type::update:
-        return process_partition_update(delta.ntp, delta.p_as, rev);
-    }
-    __builtin_unreachable();
+        __builtin_unreachable();
+    }();
+    return f.finally([m = std::move(measure)] {});
 }
 
 ss::future<std::error_code> controller_backend::process_partition_update(
@@ -235,7 +293,7 @@ ss::future<std::error_code> controller_backend::process_partition_update(
         }
         // this partition has to be removed eventually
 
-        return update_partition_replica_set(ntp, p_as.replicas)
+        return update_partition_replica_set(ntp, p_as.replicas, rev)
           .then([this, ntp, rev](std::error_code ec) {
               if (!ec) {
                   return delete_partition(ntp, rev);
@@ -246,7 +304,7 @@ ss::future<std::error_code> controller_backend::process_partition_update(
 
     // partition already exists, update configuration
     if (partition) {
-        return update_partition_replica_set(ntp, p_as.replicas);
+        return update_partition_replica_set(ntp, p_as.replicas, rev);
     }
     // create partition with empty configuration. Configuration
     // will be populated during node recovery
@@ -277,7 +335,9 @@ bool is_configuration_up_to_date(
 }
 
 ss::future<std::error_code> controller_backend::update_partition_replica_set(
-  const model::ntp& ntp, const std::vector<model::broker_shard>& replicas) {
+  const model::ntp& ntp,
+  const std::vector<model::broker_shard>& replicas,
+  model::revision_id rev) {
     vlog(
       clusterlog.trace,
       "updating partition {} replicas with {}",
@@ -293,11 +353,10 @@ ss::future<std::error_code> controller_backend::update_partition_replica_set(
     // we are the leader, update configuration
     if (partition->is_leader()) {
         auto brokers = create_brokers_set(replicas, _members_table.local());
-        // TODO: replace with correct revision_id, this feature is not used yet.
-        //       The `update_partition_replica` set method is never called.
-        //       We have to fix this before enabling partition moving
-        return partition->update_replica_set(
-          std::move(brokers), model::revision_id(0));
+        // the command offset the delta was derived from; raft rejects
+        // configurations with a stale revision so a retried delta can not
+        // clobber a newer replica set
+        return partition->update_replica_set(std::move(brokers), rev);
     }
     // not the leader, wait for configuration update, only declare success
     // when configuration was actually updated
@@ -340,7 +399,8 @@ ss::future<std::error_code> controller_backend::create_partition(
                 cfg->make_ntp_config(_data_directory, ntp.tp.partition, rev),
                 group_id,
                 std::move(members))
-              .discard_result();
+              .discard_result()
+              .then([this] { ++_partitions_created; });
     }
 
     return f
@@ -377,7 +437,10 @@ controller_backend::delete_partition(model::ntp ntp, model::revision_id rev) {
           // remove partition
           return _partition_manager.local().remove(ntp);
       })
-      .then([] { return make_error_code(errc::success); });
+      .then([this] {
+          ++_partitions_deleted;
+          return make_error_code(errc::success);
+      });
 }
 
 } // namespace cluster
@@ -18,8 +18,10 @@
 #include "cluster/topic_table.h"
 #include "model/fundamental.h"
 #include "outcome.h"
+#include "utils/hdr_hist.h"
 
 #include <seastar/core/gate.hh>
+#include <seastar/core/metrics_registration.hh>
 #include <seastar/core/sharded.hh>
 
 namespace cluster {
@@ -62,9 +64,12 @@ private:
     ss::future<std::error_code>
       delete_partition(model::ntp, model::revision_id);
     ss::future<std::error_code> update_partition_replica_set(
-      const model::ntp&, const std::vector<model::broker_shard>&);
+      const model::ntp&,
+      const std::vector<model::broker_shard>&,
+      model::revision_id);
 
     void housekeeping();
+    void setup_metrics();
 
     ss::sharded<topic_table>& _topics;
     ss::sharded<shard_table>& _shard_table;
@@ -77,6 +82,16 @@ private:
     underlying_t _topic_deltas;
     ss::timer<> _housekeeping_timer;
     ss::semaphore _topics_sem{1};
+    // I/O budget - limits the number of partition operations executed
+    // concurrently so that a node rejoining with a large backlog does not
+    // overwhelm the shard
+    size_t _max_concurrent_ops;
     ss::gate _gate;
+
+    hdr_hist _op_hist;
+    uint64_t _partitions_created{0};
+    uint64_t _partitions_deleted{0};
+    uint64_t _partitions_updated{0};
+    ss::metrics::metric_groups _metrics;
 };
 } // namespace cluster
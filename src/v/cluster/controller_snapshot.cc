@@ -0,0 +1,154 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/controller_snapshot.h"
+
+#include "cluster/commands.h"
+#include "cluster/logger.h"
+#include "config/configuration.h"
+#include "model/timeout_clock.h"
+#include "reflection/adl.h"
+#include "vlog.h"
+
+#include <seastar/core/do_with.hh>
+#include <seastar/core/future-util.hh>
+
+namespace cluster {
+
+static constexpr int8_t controller_snapshot_version = 1;
+
+iobuf encode_controller_snapshot(controller_snapshot_data data) {
+    iobuf out;
+    reflection::serialize(
+      out,
+      controller_snapshot_version,
+      data.highest_group_id,
+      int32_t(data.topics.size()));
+    for (auto& e : data.topics) {
+        reflection::serialize(out, e.offset, std::move(e.topic));
+    }
+    return out;
+}
+
+controller_snapshot_data decode_controller_snapshot(iobuf data) {
+    iobuf_parser parser(std::move(data));
+    auto version = reflection::adl<int8_t>{}.from(parser);
+    vassert(
+      version == controller_snapshot_version,
+      "Unsupported controller snapshot version: {}",
+      version);
+    controller_snapshot_data ret;
+    ret.highest_group_id = reflection::adl<raft::group_id>{}.from(parser);
+    auto n = reflection::adl<int32_t>{}.from(parser);
+    ret.topics.reserve(n);
+    while (n-- > 0) {
+        auto offset = reflection::adl<model::offset>{}.from(parser);
+        auto topic = reflection::adl<topic_configuration_assignment>{}.from(
+          parser);
+        ret.topics.push_back(topic_table::snapshot_entry{
+          .topic = std::move(topic), .offset = offset});
+    }
+    return ret;
+}
+
+controller_snapshot::controller_snapshot(
+  consensus_ptr raft0,
+  ss::sharded<controller_stm>& stm,
+  ss::sharded<topic_table>& topics,
+  ss::sharded<partition_allocator>& allocator,
+  topic_updates_dispatcher& dispatcher)
+  : _raft0(raft0)
+  , _stm(stm)
+  , _topics(topics)
+  , _allocator(allocator)
+  , _dispatcher(dispatcher) {}
+
+ss::future<> controller_snapshot::hydrate() {
+    return _raft0->read_snapshot_data().then([this](std::optional<iobuf> buf) {
+        if (!buf) {
+            return ss::now();
+        }
+        auto data = decode_controller_snapshot(std::move(*buf));
+        vlog(
+          clusterlog.info,
+          "recovering controller state from snapshot with {} topics",
+          data.topics.size());
+        _allocator.local().update_highest_group_id(data.highest_group_id);
+        return ss::do_with(
+          std::move(data.topics),
+          [this](std::vector<topic_table::snapshot_entry>& topics) {
+              return ss::do_for_each(
+                topics, [this](topic_table::snapshot_entry& entry) {
+                    auto tp_ns = entry.topic.cfg.tp_ns;
+                    return _dispatcher
+                      .apply_snapshot_topic(
+                        create_topic_cmd(
+                          std::move(tp_ns), std::move(entry.topic)),
+                        entry.offset)
+                      .then([&entry](std::error_code ec) {
+                          vassert(
+                            ec == errc::success,
+                            "Failed to recover topic from controller "
+                            "snapshot at offset {} - {}",
+                            entry.offset,
+                            ec.message());
+                      });
+                });
+          });
+    });
+}
+
+ss::future<> controller_snapshot::start() {
+    _timer.set_callback([this] {
+        (void)ss::with_gate(_gate, [this] {
+            return maybe_take_snapshot().handle_exception(
+              [](const std::exception_ptr& e) {
+                  vlog(
+                    clusterlog.warn,
+                    "Error taking controller snapshot - {}",
+                    e);
+              });
+        });
+    });
+    _timer.arm_periodic(check_interval);
+    return ss::now();
+}
+
+ss::future<> controller_snapshot::stop() {
+    _timer.cancel();
+    return _gate.close();
+}
+
+ss::future<> controller_snapshot::maybe_take_snapshot() {
+    const auto committed = _raft0->committed_offset();
+    const auto backlog = committed() - _raft0->start_offset()();
+    const auto capacity = config::shard_local_cfg().controller_log_capacity();
+    if (backlog < static_cast<int64_t>(capacity)) {
+        return ss::now();
+    }
+    return take_snapshot(committed);
+}
+
+ss::future<> controller_snapshot::take_snapshot(model::offset offset) {
+    // wait until everything the snapshot will cover is applied locally
+    return _stm.local()
+      .wait(offset, model::timeout_clock::now() + apply_timeout)
+      .then([this, offset] {
+          vlog(clusterlog.info, "taking controller snapshot at {}", offset);
+          auto data = encode_controller_snapshot(controller_snapshot_data{
+            .highest_group_id = _allocator.local().highest_group_id(),
+            .topics = _topics.local().snapshot_entries()});
+          return _raft0->write_snapshot(raft::write_snapshot_cfg(
+            offset,
+            std::move(data),
+            raft::write_snapshot_cfg::should_prefix_truncate::yes));
+      });
+}
+
+} // namespace cluster
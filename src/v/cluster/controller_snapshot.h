@@ -0,0 +1,85 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "cluster/controller_stm.h"
+#include "cluster/partition_allocator.h"
+#include "cluster/topic_table.h"
+#include "cluster/topic_updates_dispatcher.h"
+#include "cluster/types.h"
+#include "model/fundamental.h"
+
+#include <seastar/core/gate.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
+
+namespace cluster {
+
+/// Snapshot data materialized from controller state. Cluster membership
+/// is not included as it is already carried by the raft snapshot
+/// metadata latest configuration.
+struct controller_snapshot_data {
+    /// highest group id ever assigned, may be greater than any group in
+    /// topics when topics were deleted since
+    raft::group_id highest_group_id;
+    std::vector<topic_table::snapshot_entry> topics;
+};
+
+iobuf encode_controller_snapshot(controller_snapshot_data);
+controller_snapshot_data decode_controller_snapshot(iobuf);
+
+/// Bounds controller log replay cost at startup. The controller state is
+/// periodically materialized into a raft0 snapshot and the controller
+/// log is prefix truncated, so bootstrap hydrates one snapshot and
+/// replays a short log suffix instead of the full command history.
+///
+/// Controller state is deterministic, hence every node snapshots its own
+/// applied state - taking a snapshot and truncating are local decisions.
+/// There is only one instance of the controller snapshot running on the
+/// controller stm shard.
+class controller_snapshot {
+public:
+    static constexpr ss::shard_id shard = controller_stm_shard;
+
+    controller_snapshot(
+      consensus_ptr,
+      ss::sharded<controller_stm>&,
+      ss::sharded<topic_table>&,
+      ss::sharded<partition_allocator>&,
+      topic_updates_dispatcher&);
+
+    /// Restores controller state from the latest local snapshot, if any.
+    /// Has to be called before the controller stm starts replaying the
+    /// log and after allocation nodes are registered
+    ss::future<> hydrate();
+
+    /// Starts the periodic snapshot check
+    ss::future<> start();
+    ss::future<> stop();
+
+private:
+    static constexpr std::chrono::seconds check_interval{60};
+    static constexpr std::chrono::seconds apply_timeout{30};
+
+    ss::future<> maybe_take_snapshot();
+    ss::future<> take_snapshot(model::offset);
+
+    consensus_ptr _raft0;
+    ss::sharded<controller_stm>& _stm;
+    ss::sharded<topic_table>& _topics;
+    ss::sharded<partition_allocator>& _allocator;
+    topic_updates_dispatcher& _dispatcher;
+    ss::timer<> _timer;
+    ss::gate _gate;
+};
+
+} // namespace cluster
@@ -16,6 +16,8 @@
 
 #include <seastar/core/sharded.hh>
 
+#include <algorithm>
+
 namespace cluster {
 
 id_allocator::id_allocator(
@@ -27,7 +29,8 @@ id_allocator::id_allocator(
 
 ss::future<allocate_id_reply>
 id_allocator::allocate_id(allocate_id_request&& req, rpc::streaming_context&) {
-    return _id_allocator_frontend.local().do_allocate_id(req.timeout);
+    return _id_allocator_frontend.local().do_allocate_range(
+      std::max<int64_t>(req.count, 1), req.timeout);
 }
 
 } // namespace cluster
@@ -16,6 +16,7 @@
 #include "cluster/partition_manager.h"
 #include "cluster/topics_frontend.h"
 #include "cluster/types.h"
+#include "utils/mutex.h"
 
 #include <seastar/core/sharded.hh>
 
@@ -38,6 +39,11 @@ class id_allocator;
 //
 // when the service recieves a call it triggers id_allocator_frontend
 // which in its own turn pass the request to the id_allocator_stm
+//
+// to avoid a raft round trip (or a cross node rpc) per allocation each
+// frontend leases a whole range of ids from the stm
+// (id_allocator_batch_size at a time) and hands out single ids from the
+// lease locally; only a shard that exhausted its lease talks to the stm
 class id_allocator_frontend {
 public:
     id_allocator_frontend(
@@ -61,14 +67,25 @@ private:
     ss::sharded<partition_leaders_table>& _leaders;
     std::unique_ptr<cluster::controller>& _controller;
 
-    ss::future<allocate_id_reply> dispatch_allocate_id_to_leader(
-      model::node_id, model::timeout_clock::duration);
+    ss::future<allocate_id_reply> dispatch_allocate_range_to_leader(
+      model::node_id, int64_t count, model::timeout_clock::duration);
 
     ss::future<allocate_id_reply>
-    do_allocate_id(model::timeout_clock::duration timeout);
+    allocate_range(int64_t count, model::timeout_clock::duration timeout);
+
+    ss::future<allocate_id_reply> do_allocate_range(
+      int64_t count, model::timeout_clock::duration timeout);
 
     ss::future<bool> try_create_id_allocator_topic();
 
+    // the locally leased range of ids, [_local_base, _local_base +
+    // _local_range), served without touching the stm
+    int64_t _local_base{0};
+    int64_t _local_range{0};
+    // serializes lease refills so concurrent allocations on an exhausted
+    // lease request a single range
+    mutex _lease_mutex;
+
     friend id_allocator;
 };
 } // namespace cluster
@@ -65,12 +65,24 @@ metadata_cache::get_topic_timestamp_type(model::topic_namespace_view tp) const {
     return _topics_state.local().get_topic_timestamp_type(tp);
 }
 
-std::vector<model::topic_metadata> metadata_cache::all_topics_metadata() const {
-    auto all_md = _topics_state.local().all_topics_metadata();
-    for (auto& md : all_md) {
-        fill_partition_leaders(_leaders.local(), md);
+metadata_cache::topics_snapshot_ptr
+metadata_cache::all_topics_metadata() const {
+    const auto topics_v = _topics_state.local().topics_version();
+    const auto leaders_v = _leaders.local().leaders_version();
+    if (
+      !_topics_snapshot || topics_v != _snapshot_topics_version
+      || leaders_v != _snapshot_leaders_version) {
+        auto all_md = _topics_state.local().all_topics_metadata();
+        for (auto& md : all_md) {
+            fill_partition_leaders(_leaders.local(), md);
+        }
+        _topics_snapshot
+          = ss::make_lw_shared<const std::vector<model::topic_metadata>>(
+            std::move(all_md));
+        _snapshot_topics_version = topics_v;
+        _snapshot_leaders_version = leaders_v;
     }
-    return all_md;
+    return _topics_snapshot;
 }
 
 std::optional<broker_ptr> metadata_cache::get_broker(model::node_id nid) const {
@@ -102,4 +114,12 @@ std::optional<model::node_id> metadata_cache::get_controller_leader_id() {
     return _leaders.local().get_leader(model::controller_ntp);
 }
 
+topic_table::version metadata_cache::topics_version() const {
+    return _topics_state.local().topics_version();
+}
+
+partition_leaders_table::version metadata_cache::leaders_version() const {
+    return _leaders.local().leaders_version();
+}
+
 } // namespace cluster
@@ -22,6 +22,7 @@
 
 #include <seastar/core/future.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/shared_ptr.hh>
 
 #include <absl/container/flat_hash_map.h>
 
@@ -80,8 +81,16 @@ public:
     std::optional<model::timestamp_type>
       get_topic_timestamp_type(model::topic_namespace_view) const;
 
-    /// Returns metadata of all topics.
-    std::vector<model::topic_metadata> all_topics_metadata() const;
+    /// Immutable snapshot of all topics metadata, shared between readers
+    using topics_snapshot_ptr
+      = ss::lw_shared_ptr<const std::vector<model::topic_metadata>>;
+
+    /// Returns metadata of all topics with partition leaders filled in.
+    ///
+    /// The returned snapshot is immutable and shared - repeated calls return
+    /// the same instance without copying until the topic or leaders table
+    /// reports a new version, then the snapshot is rebuilt once.
+    topics_snapshot_ptr all_topics_metadata() const;
 
     /// Returns all brokers, returns copy as the content of broker can change
     std::vector<broker_ptr> all_brokers() const;
@@ -113,9 +122,22 @@ public:
     /// If present returns a leader of raft0 group
     std::optional<model::node_id> get_controller_leader_id();
 
+    /// Versions of the underlying topic and leaders tables. Comparing the
+    /// pair is enough to detect that any topic or partition leadership
+    /// information returned by this cache may have changed.
+    topic_table::version topics_version() const;
+    partition_leaders_table::version leaders_version() const;
+
 private:
     ss::sharded<topic_table>& _topics_state;
     ss::sharded<members_table>& _members_table;
     ss::sharded<partition_leaders_table>& _leaders;
+
+    // lazily rebuilt snapshot served by all_topics_metadata() together with
+    // the versions it was built at, mutable as rebuilding is transparent to
+    // the const readers
+    mutable topics_snapshot_ptr _topics_snapshot;
+    mutable topic_table::version _snapshot_topics_version{-1};
+    mutable partition_leaders_table::version _snapshot_leaders_version{-1};
 };
 } // namespace cluster
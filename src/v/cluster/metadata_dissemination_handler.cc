@@ -48,24 +48,30 @@ metadata_dissemination_handler::do_update_leadership(
                   leader.ntp, leader.term, leader.leader_id);
             }
         })
-      .then([] { return ss::make_ready_future<update_leadership_reply>(); });
+      .then([this] {
+          return ss::make_ready_future<update_leadership_reply>(
+            update_leadership_reply{_leaders.local().leaders_version()});
+      });
 }
 
-static get_leadership_reply
-make_get_leadership_reply(const partition_leaders_table& leaders) {
+static get_leadership_reply make_get_leadership_reply(
+  const partition_leaders_table& leaders,
+  partition_leaders_table::version known_version) {
     ntp_leaders ret;
-    leaders.for_each_leader([&ret](
-                              model::topic_namespace_view tp_ns,
-                              model::partition_id pid,
-                              std::optional<model::node_id> leader,
-                              model::term_id term) mutable {
-        ret.emplace_back(ntp_leader{
-          .ntp = model::ntp(tp_ns.ns, tp_ns.tp, pid),
-          .term = term,
-          .leader_id = leader});
-    });
+    leaders.for_each_updated_leader(
+      known_version,
+      [&ret](
+        model::topic_namespace_view tp_ns,
+        model::partition_id pid,
+        std::optional<model::node_id> leader,
+        model::term_id term) mutable {
+          ret.emplace_back(ntp_leader{
+            .ntp = model::ntp(tp_ns.ns, tp_ns.tp, pid),
+            .term = term,
+            .leader_id = leader});
+      });
 
-    return get_leadership_reply{std::move(ret)};
+    return get_leadership_reply{std::move(ret), leaders.leaders_version()};
 }
 
 ss::future<get_leadership_reply> metadata_dissemination_handler::get_leadership(
@@ -73,7 +79,7 @@ ss::future<get_leadership_reply> metadata_dissemination_handler::get_leadership(
     return ss::with_scheduling_group(
       get_scheduling_group(), [this, req = std::move(req)]() mutable {
           return ss::make_ready_future<get_leadership_reply>(
-            make_get_leadership_reply(_leaders.local()));
+            make_get_leadership_reply(_leaders.local(), req.known_version));
       });
 }
 
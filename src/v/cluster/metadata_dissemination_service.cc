@@ -24,6 +24,7 @@
 #include "model/timeout_clock.h"
 #include "rpc/connection_cache.h"
 #include "rpc/types.h"
+#include "utils/lazy_message.h"
 #include "utils/retry.h"
 #include "vassert.h"
 #include "vlog.h"
@@ -223,6 +224,16 @@ ss::future<> metadata_dissemination_service::process_get_update_reply(
           *meta.next);
         return ss::make_ready_future<>();
     }
+    if (auto it = _peer_versions.find(*meta.next);
+        it != _peer_versions.end()
+        && reply_result.value().version < it->second) {
+        // the peer restarted and its version counter started over, our
+        // incremental request may have skipped entries. forget the
+        // recorded version so the retry asks for a full snapshot
+        _peer_versions.erase(it);
+        return ss::make_ready_future<>();
+    }
+    _peer_versions[*meta.next] = reply_result.value().version;
     // Update all NTP leaders
     return _leaders
       .invoke_on_all([reply = std::move(reply_result.value())](
@@ -238,15 +249,21 @@ ss::future<result<get_leadership_reply>>
 metadata_dissemination_service::dispatch_get_metadata_update(
   model::node_id id) {
     vlog(clusterlog.debug, "Requesting metadata update from node {}", id);
+    // ask only for the entries that changed since we last saw the peer's
+    // leaders table
+    auto known_version = partition_leaders_table::version{-1};
+    if (auto it = _peer_versions.find(id); it != _peer_versions.end()) {
+        known_version = it->second;
+    }
     return _clients.local()
       .with_node_client<metadata_dissemination_rpc_client_protocol>(
         _self,
         ss::this_shard_id(),
         id,
-        [this](metadata_dissemination_rpc_client_protocol c) {
+        [this, known_version](metadata_dissemination_rpc_client_protocol c) {
             return c
               .get_leadership(
-                get_leadership_request{},
+                get_leadership_request{known_version},
                 rpc::client_opts(
                   rpc::clock_type::now() + _dissemination_interval))
               .then(&rpc::get_ctx_data<get_leadership_reply>);
@@ -320,15 +337,18 @@ ss::future<> metadata_dissemination_service::dispatch_one_update(
                   _dissemination_interval + rpc::clock_type::now()))
               .then(&rpc::get_ctx_data<update_leadership_reply>);
         })
-      .then([target_id, &meta](result<update_leadership_reply> r) {
+      .then([this, target_id, &meta](result<update_leadership_reply> r) {
           if (r) {
               meta.finished = true;
+              // remember the version the peer's table reached so later
+              // refreshes from that peer can be incremental
+              _peer_versions[target_id] = r.value().version;
               return;
           }
           vlog(
             clusterlog.warn,
             "Error sending metadata update {} to {}",
-            r.error().message(),
+            lazy::msg(r.error()),
             target_id);
       })
       .handle_exception([](std::exception_ptr e) {
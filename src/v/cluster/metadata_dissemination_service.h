@@ -139,6 +139,11 @@ private:
     std::vector<ntp_leader> _requests;
     std::vector<model::node_id> _seed_server_ids;
     broker_updates_t _pending_updates;
+    // last seen version of each peer's leaders table, piggybacked on
+    // dissemination replies. metadata refreshes request only the entries
+    // that changed on the peer since the recorded version
+    absl::flat_hash_map<model::node_id, partition_leaders_table::version>
+      _peer_versions;
     mutex _lock;
     ss::timer<> _dispatch_timer;
     ss::abort_source _as;
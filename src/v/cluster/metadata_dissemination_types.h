@@ -10,6 +10,7 @@
  */
 
 #pragma once
+#include "cluster/partition_leaders_table.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
 
@@ -29,12 +30,23 @@ struct update_leadership_request {
     ntp_leaders leaders;
 };
 
-struct update_leadership_reply {};
+struct update_leadership_reply {
+    // responder's leaders table version, piggybacked so the sender can
+    // request an incremental snapshot from this node later on
+    partition_leaders_table::version version{-1};
+};
 
-struct get_leadership_request {};
+struct get_leadership_request {
+    // entries at or below this version of the responder's table are
+    // already known to the caller and are omitted from the reply,
+    // version{-1} requests a full snapshot
+    partition_leaders_table::version known_version{-1};
+};
 
 struct get_leadership_reply {
     ntp_leaders leaders;
+    // responder's leaders table version at the time the snapshot was taken
+    partition_leaders_table::version version{-1};
 };
 
 inline std::ostream& operator<<(std::ostream& o, const ntp_leader& l) {
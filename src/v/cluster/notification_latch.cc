@@ -12,40 +12,47 @@
 #include "utils/expiring_promise.h"
 
 #include <seastar/core/future.hh>
-#include <seastar/core/shared_ptr.hh>
 
 #include <memory>
-#include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace cluster {
 
 ss::future<errc> notification_latch::wait_for(
   model::offset o, model::timeout_clock::time_point timeout) {
-    promise_ptr pr = std::make_unique<promise_t>();
-    auto [it, _] = _promises.emplace(o, std::move(pr));
-
-    return it->second
-      ->get_future_with_timeout(
-        timeout, [] { return errc::notification_wait_timeout; })
-      .then([this, o](errc ec) {
-          if (auto it = _promises.find(o); it != _promises.end()) {
-              _promises.erase(it);
-          }
-          return ec;
-      });
+    auto& bucket = _promises[o];
+    bucket.push_back(std::make_unique<promise_t>());
+    // a timed out waiter stays in its bucket until a notification passes its
+    // offset; settling it again at that point is a no-op
+    return bucket.back()->get_future_with_timeout(
+      timeout, [] { return errc::notification_wait_timeout; });
 }
 
 void notification_latch::notify(model::offset o) {
-    if (auto it = _promises.find(o); it != _promises.end()) {
-        it->second->set_value(errc::success);
-        _promises.erase(it);
+    // detach the notified prefix before settling anything so waiters
+    // registering from woken continuations never observe a partially swept
+    // map
+    std::vector<std::vector<promise_ptr>> buckets;
+    auto end = _promises.upper_bound(o);
+    for (auto it = _promises.begin(); it != end; ++it) {
+        buckets.push_back(std::move(it->second));
+    }
+    _promises.erase(_promises.begin(), end);
+
+    for (auto& bucket : buckets) {
+        for (auto& pr : bucket) {
+            pr->set_value(errc::success);
+        }
     }
 }
 
 void notification_latch::stop() {
-    for (auto& [_, pr] : _promises) {
-        pr->set_value(errc::shutting_down);
+    for (auto& [_, bucket] : _promises) {
+        for (auto& pr : bucket) {
+            pr->set_value(errc::shutting_down);
+        }
     }
+    _promises.clear();
 }
-} // namespace cluster
\ No newline at end of file
+} // namespace cluster
@@ -16,15 +16,29 @@
 #include "model/timeout_clock.h"
 #include "utils/expiring_promise.h"
 
-#include <absl/container/flat_hash_map.h>
+#include <absl/container/btree_map.h>
+
+#include <memory>
+#include <vector>
 
 namespace cluster {
 /// Cache notifications
+/**
+ * Waiters are bucketed per awaited offset in an ordered map, the same shape
+ * as raft::offset_monitor. Notifying an offset pops every bucket at or below
+ * it from the front of the map in one sweep, so a burst of controller
+ * appends settles all waiters with one tree operation per distinct offset
+ * instead of one lookup and erase per waiter. Notified offsets only advance,
+ * hence waking the whole prefix is safe.
+ */
 class notification_latch {
 private:
     using promise_t = expiring_promise<errc, model::timeout_clock>;
+    // the promise owns a timer whose address must remain stable while armed,
+    // hence the per-waiter indirection
     using promise_ptr = std::unique_ptr<promise_t>;
-    using underlying_t = absl::flat_hash_map<model::offset, promise_ptr>;
+    using underlying_t
+      = absl::btree_map<model::offset, std::vector<promise_ptr>>;
 
 public:
     ss::future<errc> wait_for(model::offset, model::timeout_clock::time_point);
@@ -34,4 +48,4 @@ public:
 private:
     underlying_t _promises;
 };
-} // namespace cluster
\ No newline at end of file
+} // namespace cluster
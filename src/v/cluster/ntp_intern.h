@@ -0,0 +1,53 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "seastarx.h"
+
+#include <seastar/core/metrics.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/core/sstring.hh>
+
+#include <vector>
+
+namespace cluster {
+
+/**
+ * Immutable formatted forms of an ntp. Building the filesystem path and
+ * the per-partition metric labels means string formatting and a handful
+ * of allocations; with tens of thousands of partitions per shard that
+ * churn adds up when the formatted forms are rebuilt at every use.
+ * Instances are created once per partition lifetime, interned on the
+ * partition_manager, and handed out as cheap shared references.
+ */
+struct ntp_strings {
+    /// result of model::ntp::path()
+    ss::sstring path;
+    /// namespace/topic/partition labels for per-partition metric groups
+    std::vector<ss::metrics::label_instance> labels;
+};
+
+using ntp_strings_ptr = ss::lw_shared_ptr<const ntp_strings>;
+
+inline ntp_strings_ptr make_ntp_strings(const model::ntp& ntp) {
+    namespace sm = ss::metrics;
+    return ss::make_lw_shared<const ntp_strings>(ntp_strings{
+      .path = ntp.path(),
+      .labels = {
+        sm::label("namespace")(ntp.ns()),
+        sm::label("topic")(ntp.tp.topic()),
+        sm::label("partition")(ntp.tp.partition()),
+      }});
+}
+
+} // namespace cluster
@@ -32,10 +32,10 @@ partition::partition(consensus_ptr r)
     }
 }
 
-ss::future<> partition::start() {
+ss::future<> partition::start(ntp_strings_ptr strings) {
     auto ntp = _raft->ntp();
 
-    _probe.setup_metrics(ntp);
+    _probe.setup_metrics(ntp, std::move(strings));
 
     auto f = _raft->start();
 
@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include "cluster/ntp_intern.h"
 #include "cluster/partition_probe.h"
+#include "cluster/producer_dedup_table.h"
 #include "cluster/types.h"
 #include "model/metadata.h"
 #include "model/record_batch_reader.h"
@@ -32,7 +34,7 @@ public:
     explicit partition(consensus_ptr r);
 
     raft::group_id group() const { return _raft->group(); }
-    ss::future<> start();
+    ss::future<> start(ntp_strings_ptr strings = nullptr);
     ss::future<> stop();
 
     ss::future<result<raft::replicate_result>>
@@ -60,6 +62,8 @@ public:
      */
     model::offset committed_offset() const { return _raft->committed_offset(); }
 
+    int64_t max_follower_lag() const { return _raft->max_follower_lag(); }
+
     /**
      * <kafka>The last stable offset (LSO) is defined as the first offset such
      * that all lower offsets have been "decided." Non-transactional messages
@@ -98,6 +102,10 @@ public:
 
     bool is_leader() const { return _raft->is_leader(); }
 
+    // leadership backed by a clock lease over the quorum; while this
+    // holds, local reads are linearizable without quorum communication
+    bool has_leader_lease() const { return _raft->has_leader_lease(); }
+
     ss::future<std::error_code>
     transfer_leadership(std::optional<model::node_id> target) {
         return _raft->transfer_leadership(target);
@@ -123,6 +131,11 @@ public:
         return _id_allocator_stm;
     }
 
+    model::term_id term() const { return _raft->term(); }
+
+    /// idempotent producer sequence tracking, valid for the current term
+    producer_dedup_table& dedup() { return _dedup; }
+
 private:
     friend partition_manager;
 
@@ -134,6 +147,7 @@ private:
     std::unique_ptr<raft::id_allocator_stm> _id_allocator_stm;
     ss::abort_source _as;
     partition_probe _probe;
+    producer_dedup_table _dedup;
 
     friend std::ostream& operator<<(std::ostream& o, const partition& x);
 };
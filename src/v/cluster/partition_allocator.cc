@@ -35,65 +35,81 @@ void partition_allocator::rollback(const std::vector<model::broker_shard>& v) {
     }
 }
 
-static inline bool valid_machine_fault_domain_diversity(
-  const std::vector<model::broker_shard>& replicas) {
-    model::node_id sentinel = replicas.begin()->node_id;
-    const uint32_t unique = std::accumulate(
-      replicas.begin(),
-      replicas.end(),
-      uint32_t(1),
-      [&sentinel](uint32_t acc, const model::broker_shard& bs) {
-          if (sentinel != bs.node_id) {
-              acc += 1;
-          }
-          return acc;
-      });
-    return unique == replicas.size();
+// order by remaining capacity, most headroom on top of the heap
+static bool node_heap_cmp(const allocation_node* a, const allocation_node* b) {
+    return a->partition_capacity() < b->partition_capacity();
 }
 
-static bool is_machine_in_replicas(
-  const allocation_node& machine,
-  const std::vector<model::broker_shard>& replicas) {
-    return std::any_of(
-      replicas.begin(),
-      replicas.end(),
-      [&machine](const model::broker_shard& bs) {
-          return machine.id() == bs.node_id;
-      });
+static bool is_rack_in_use(
+  const allocation_node& machine, const std::vector<ss::sstring>& racks) {
+    return machine.rack()
+           && std::find(racks.begin(), racks.end(), *machine.rack())
+                != racks.end();
 }
 
 std::optional<std::vector<model::broker_shard>>
-partition_allocator::allocate_replicas(int16_t replication_factor) {
+partition_allocator::allocate_replicas(
+  int16_t replication_factor, node_heap& candidates) {
     std::vector<model::broker_shard> replicas;
     replicas.reserve(replication_factor);
+    // racks hosting a replica of this partition already
+    std::vector<ss::sstring> racks;
+    racks.reserve(replication_factor);
+    // machines hosting a replica are kept off the heap until the whole
+    // partition is placed, which guarantees machine diversity
+    node_heap chosen;
+    chosen.reserve(replication_factor);
 
     while (replicas.size() < (size_t)replication_factor) {
-        const uint16_t replicas_left = replication_factor - replicas.size();
-        if (_available_machines.size() < replicas_left) {
+        // pop machines until one is on a rack without a replica yet;
+        // skipped ones come off the heap in descending capacity order
+        node_heap skipped;
+        allocation_node* machine = nullptr;
+        while (!candidates.empty()) {
+            std::pop_heap(candidates.begin(), candidates.end(), node_heap_cmp);
+            auto* top = candidates.back();
+            candidates.pop_back();
+            if (is_rack_in_use(*top, racks)) {
+                skipped.push_back(top);
+                continue;
+            }
+            machine = top;
+            break;
+        }
+        if (machine == nullptr && !skipped.empty()) {
+            // fewer racks than replicas: fall back to the machine with
+            // the most headroom, machine diversity still holds
+            machine = skipped.front();
+            skipped.erase(skipped.begin());
+        }
+        for (auto* n : skipped) {
+            candidates.push_back(n);
+            std::push_heap(candidates.begin(), candidates.end(), node_heap_cmp);
+        }
+        if (machine == nullptr) {
             rollback(replicas);
             return std::nullopt;
         }
-        auto& rr = round_robin_ptr();
-        auto& machine = *rr;
-        rr++;
-        if (is_machine_in_replicas(machine, replicas)) {
-            continue;
-        }
-        const uint32_t cpu = machine.allocate();
-        model::broker_shard bs{.node_id = machine.id(), .shard = cpu};
-        replicas.push_back(bs);
-        if (machine.is_full()) {
-            _available_machines.erase(_available_machines.iterator_to(machine));
+        const uint32_t cpu = machine->allocate();
+        replicas.push_back(
+          model::broker_shard{.node_id = machine->id(), .shard = cpu});
+        if (machine->rack()) {
+            racks.push_back(*machine->rack());
         }
+        chosen.push_back(machine);
     }
-    if (!valid_machine_fault_domain_diversity(replicas)) {
-        rollback(replicas);
-        return std::nullopt;
+    for (auto* machine : chosen) {
+        if (machine->is_full()) {
+            _available_machines.erase(
+              _available_machines.iterator_to(*machine));
+        } else {
+            candidates.push_back(machine);
+            std::push_heap(candidates.begin(), candidates.end(), node_heap_cmp);
+        }
     }
     return replicas;
 }
 
-// FIXME: take into account broker.rack diversity & other constraints
 std::optional<partition_allocator::allocation_units>
 partition_allocator::allocate(const topic_configuration& cfg) {
     if (_available_machines.empty()) {
@@ -114,12 +130,22 @@ partition_allocator::allocate(const topic_configuration& cfg) {
           cap);
         return std::nullopt;
     }
+    // one heap for the whole request: placing a partition is
+    // O(replication_factor * log(nodes)) instead of a scan
+    node_heap candidates;
+    candidates.reserve(_available_machines.size());
+    for (auto& machine : _available_machines) {
+        candidates.push_back(&machine);
+    }
+    std::make_heap(candidates.begin(), candidates.end(), node_heap_cmp);
+
     std::vector<partition_assignment> ret;
     ret.reserve(cfg.partition_count);
     for (int32_t i = 0; i < cfg.partition_count; ++i) {
         // all replicas must belong to the same raft group
         raft::group_id partition_group = raft::group_id(_highest_group() + 1);
-        auto replicas_assignment = allocate_replicas(cfg.replication_factor);
+        auto replicas_assignment = allocate_replicas(
+          cfg.replication_factor, candidates);
         if (replicas_assignment == std::nullopt) {
             rollback(ret);
             return std::nullopt;
@@ -225,7 +251,8 @@ partition_allocator::test_only_max_cluster_allocation_partition_capacity()
 std::ostream& operator<<(std::ostream& o, const allocation_node& n) {
     o << "{ node:" << n._id << ", max_partitions_per_core: "
       << allocation_node::max_allocations_per_core
-      << ", partition_capacity:" << n._partition_capacity << ", weights: [";
+      << ", partition_capacity:" << n._partition_capacity
+      << ", rack:" << n._rack.value_or("") << ", weights: [";
     for (auto w : n._weights) {
         o << "(" << w << ")";
     }
@@ -33,10 +33,12 @@ public:
     allocation_node(
       model::node_id id,
       uint32_t cpus,
-      std::unordered_map<ss::sstring, ss::sstring> labels)
+      std::unordered_map<ss::sstring, ss::sstring> labels,
+      std::optional<ss::sstring> rack = std::nullopt)
       : _id(id)
       , _weights(cpus)
-      , _machine_labels(std::move(labels)) {
+      , _machine_labels(std::move(labels))
+      , _rack(std::move(rack)) {
         // add extra weights to core 0
         _weights[0] = core0_extra_weight;
         _partition_capacity = (cpus * max_allocations_per_core)
@@ -47,7 +49,8 @@ public:
       : _id(o._id)
       , _weights(std::move(o._weights))
       , _partition_capacity(o._partition_capacity)
-      , _machine_labels(std::move(o._machine_labels)) {
+      , _machine_labels(std::move(o._machine_labels))
+      , _rack(std::move(o._rack)) {
         _hook.swap_nodes(o._hook);
     }
 
@@ -58,6 +61,7 @@ public:
     uint32_t cpus() const { return _weights.size(); }
     model::node_id id() const { return _id; }
     uint32_t partition_capacity() const { return _partition_capacity; }
+    const std::optional<ss::sstring>& rack() const { return _rack; }
 
 private:
     friend partition_allocator;
@@ -104,6 +108,8 @@ private:
     uint32_t _partition_capacity{0};
     /// generated by `rpk` usually in /etc/redpanda/machine_labels.json
     std::unordered_map<ss::sstring, ss::sstring> _machine_labels;
+    /// fault domain, from model::broker::rack()
+    std::optional<ss::sstring> _rack;
 
     // for partition_allocator
     safe_intrusive_list_hook _hook;
@@ -155,9 +161,7 @@ public:
     /// are up to date, and have the highest known group_id ever assigned
     /// reset to nullptr when no longer leader
     explicit partition_allocator(raft::group_id highest_known_group)
-      : _highest_group(highest_known_group) {
-        _rr = _available_machines.end();
-    }
+      : _highest_group(highest_known_group) {}
     void register_node(ptr n) {
         _available_machines.push_back(*n);
         _machines.emplace(n->id(), std::move(n));
@@ -181,15 +185,25 @@ public:
     void
       update_allocation_state(std::vector<model::broker_shard>, raft::group_id);
 
+    /// raises the highest known group id, used when recovering allocator
+    /// state from the controller snapshot where some group ids may belong
+    /// to topics that were deleted since
+    void update_highest_group_id(raft::group_id gid) {
+        _highest_group = std::max(_highest_group, gid);
+    }
+
+    raft::group_id highest_group_id() const { return _highest_group; }
+
     const underlying_t& allocation_nodes() { return _machines; }
 
-    ~partition_allocator() {
-        _available_machines.clear();
-        _rr = _available_machines.end();
-    }
+    ~partition_allocator() { _available_machines.clear(); }
 
 private:
     friend partition_allocator_tester;
+    /// max-heap of candidate machines ordered by remaining capacity,
+    /// built once per allocation request
+    using node_heap = std::vector<allocation_node*>;
+
     /// rolls back partition assignment, only decrementing
     /// raft-group by distinct raft-group counts
     /// assumes sorted in raft-group order
@@ -197,18 +211,11 @@ private:
     void rollback(const std::vector<model::broker_shard>& v);
 
     std::optional<std::vector<model::broker_shard>>
-    allocate_replicas(int16_t replication_factor);
+    allocate_replicas(int16_t replication_factor, node_heap& candidates);
     iterator find_node(model::node_id id);
 
-    [[gnu::always_inline]] inline cil_t::iterator& round_robin_ptr() {
-        if (_rr == _available_machines.end()) {
-            _rr = _available_machines.begin();
-        }
-        return _rr;
-    }
     raft::group_id _highest_group;
 
-    cil_t::iterator _rr; // round robin
     cil_t _available_machines;
     underlying_t _machines;
 
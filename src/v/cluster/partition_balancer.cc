@@ -0,0 +1,325 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/partition_balancer.h"
+
+#include "cluster/errc.h"
+#include "cluster/logger.h"
+#include "config/configuration.h"
+#include "model/timeout_clock.h"
+#include "raft/consensus.h"
+#include "storage/shard_assignment.h"
+#include "vlog.h"
+
+#include <seastar/core/future-util.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
+#include <algorithm>
+
+namespace cluster {
+
+partition_balancer::partition_balancer(
+  consensus_ptr raft0,
+  ss::sharded<topic_table>& topics,
+  ss::sharded<members_table>& members,
+  ss::sharded<partition_leaders_table>& leaders,
+  ss::sharded<topics_frontend>& frontend,
+  ss::sharded<partition_manager>& partition_manager,
+  ss::sharded<shard_table>& shard_table)
+  : _raft0(std::move(raft0))
+  , _topics(topics)
+  , _members(members)
+  , _leaders(leaders)
+  , _frontend(frontend)
+  , _partition_manager(partition_manager)
+  , _shard_table(shard_table)
+  , _self(_raft0->self().id()) {
+    _timer.set_callback([this] { tick(); });
+}
+
+ss::future<> partition_balancer::start() {
+    if (config::shard_local_cfg().enable_partition_balancing()) {
+        _timer.arm_periodic(
+          config::shard_local_cfg().partition_balancer_tick_ms());
+    }
+    return ss::now();
+}
+
+ss::future<> partition_balancer::stop() {
+    _timer.cancel();
+    return _gate.close();
+}
+
+void partition_balancer::tick() {
+    (void)ss::with_gate(_gate, [this] {
+        return do_tick().handle_exception([](std::exception_ptr e) {
+            vlog(clusterlog.info, "partition balancer tick failed: {}", e);
+        });
+    }).handle_exception_type([](const ss::gate_closed_exception&) {});
+}
+
+ss::future<> partition_balancer::do_tick() { return execute(make_plan()); }
+
+partition_balancer::plan partition_balancer::make_plan() {
+    plan p;
+    auto budget
+      = config::shard_local_cfg().partition_balancer_moves_per_tick();
+    if (budget == 0) {
+        return p;
+    }
+    plan_replica_moves(p, budget);
+    plan_leadership_transfers(p, budget);
+    return p;
+}
+
+void partition_balancer::plan_replica_moves(plan& p, size_t& budget) {
+    // replica moves are replicated controller commands, only the
+    // controller leader may schedule them
+    if (!_raft0->is_leader()) {
+        return;
+    }
+    auto brokers = _members.local().all_brokers();
+    if (brokers.size() < 2) {
+        return;
+    }
+    absl::flat_hash_map<model::node_id, int64_t> counts;
+    absl::flat_hash_map<model::node_id, uint32_t> cores;
+    for (const auto& b : brokers) {
+        counts.emplace(b->id(), 0);
+        cores.emplace(b->id(), b->properties().cores);
+    }
+    // the flat view streams replicas as one contiguous array
+    auto view = _topics.local().flat_metadata();
+    for (const auto& bs : view->replicas) {
+        if (auto it = counts.find(bs.node_id); it != counts.end()) {
+            ++it->second;
+        }
+    }
+    const auto slack = static_cast<int64_t>(
+      config::shard_local_cfg().partition_balancer_slack());
+    absl::flat_hash_set<model::ntp> scheduled;
+    while (budget > 0) {
+        auto [min_it, max_it] = std::minmax_element(
+          counts.begin(), counts.end(), [](const auto& a, const auto& b) {
+              return a.second < b.second;
+          });
+        const auto most = max_it->first;
+        const auto least = min_it->first;
+        if (max_it->second - min_it->second <= slack) {
+            break;
+        }
+        bool found = false;
+        for (const auto& te : view->topics) {
+            for (auto pi = te.partitions_begin;
+                 pi < te.partitions_end && !found;
+                 ++pi) {
+                const auto& pe = view->partitions[pi];
+                const auto r_begin = view->replicas.cbegin()
+                                     + pe.replicas_begin;
+                const auto r_end = view->replicas.cbegin() + pe.replicas_end;
+                auto on_node = [r_begin, r_end](model::node_id id) {
+                    return std::any_of(
+                      r_begin, r_end, [id](const model::broker_shard& bs) {
+                          return bs.node_id == id;
+                      });
+                };
+                if (!on_node(most) || on_node(least)) {
+                    continue;
+                }
+                auto ntp = model::ntp(te.tp_ns.ns, te.tp_ns.tp, pe.id);
+                if (scheduled.contains(ntp)) {
+                    continue;
+                }
+                auto replicas = std::vector<model::broker_shard>(
+                  r_begin, r_end);
+                for (auto& bs : replicas) {
+                    if (bs.node_id == most) {
+                        bs = model::broker_shard{
+                          .node_id = least,
+                          .shard = storage::shard_of(ntp, cores[least])};
+                        break;
+                    }
+                }
+                scheduled.emplace(ntp);
+                p.moves.push_back(replica_move{
+                  .ntp = std::move(ntp), .replicas = std::move(replicas)});
+                --counts[most];
+                ++counts[least];
+                --budget;
+                found = true;
+            }
+            if (found) {
+                break;
+            }
+        }
+        if (!found) {
+            break;
+        }
+    }
+}
+
+void partition_balancer::plan_leadership_transfers(plan& p, size_t& budget) {
+    auto brokers = _members.local().all_brokers();
+    if (brokers.size() < 2) {
+        return;
+    }
+    absl::flat_hash_map<model::node_id, int64_t> leaders;
+    for (const auto& b : brokers) {
+        leaders.emplace(b->id(), 0);
+    }
+    int64_t total = 0;
+    _leaders.local().for_each_leader(
+      [&leaders, &total](
+        model::topic_namespace_view,
+        model::partition_id,
+        std::optional<model::node_id> leader,
+        model::term_id) {
+          if (!leader) {
+              return;
+          }
+          if (auto it = leaders.find(*leader); it != leaders.end()) {
+              ++it->second;
+              ++total;
+          }
+      });
+    const auto avg = total / static_cast<int64_t>(brokers.size());
+    const auto slack = static_cast<int64_t>(
+      config::shard_local_cfg().partition_balancer_slack());
+    if (leaders[_self] <= avg + slack) {
+        return;
+    }
+    // a transfer can only be initiated by the group leader, so each node
+    // sheds its own surplus toward the least-loaded replica
+    auto view = _topics.local().flat_metadata();
+    for (const auto& te : view->topics) {
+        for (auto pi = te.partitions_begin; pi < te.partitions_end; ++pi) {
+            const auto& pe = view->partitions[pi];
+            if (budget == 0 || leaders[_self] <= avg + slack) {
+                return;
+            }
+            auto ntp = model::ntp(te.tp_ns.ns, te.tp_ns.tp, pe.id);
+            if (_leaders.local().get_leader(ntp) != _self) {
+                continue;
+            }
+            std::optional<model::node_id> target;
+            for (auto ri = pe.replicas_begin; ri < pe.replicas_end; ++ri) {
+                const auto& bs = view->replicas[ri];
+                if (bs.node_id == _self) {
+                    continue;
+                }
+                auto it = leaders.find(bs.node_id);
+                if (it == leaders.end()) {
+                    continue;
+                }
+                if (!target || it->second < leaders[*target]) {
+                    target = bs.node_id;
+                }
+            }
+            if (!target || leaders[*target] + slack >= leaders[_self]) {
+                continue;
+            }
+            p.transfers.push_back(
+              leadership_transfer{.ntp = std::move(ntp), .target = *target});
+            --leaders[_self];
+            ++leaders[*target];
+            --budget;
+        }
+    }
+}
+
+ss::future<> partition_balancer::execute(plan p) {
+    if (p.moves.empty() && p.transfers.empty()) {
+        return ss::now();
+    }
+    vlog(
+      clusterlog.debug,
+      "partition balancer scheduling {} replica moves and {} leadership "
+      "transfers",
+      p.moves.size(),
+      p.transfers.size());
+    return ss::do_with(std::move(p), [this](plan& p) {
+        return ss::do_for_each(
+                 p.moves,
+                 [this](replica_move& m) {
+                     return execute_move(std::move(m));
+                 })
+          .then([this, &p] {
+              return ss::do_for_each(
+                p.transfers, [this](leadership_transfer& t) {
+                    return execute_transfer(std::move(t));
+                });
+          });
+    });
+}
+
+ss::future<> partition_balancer::execute_move(replica_move m) {
+    auto ntp = m.ntp;
+    return _frontend.local()
+      .move_partition_replicas(
+        std::move(m.ntp),
+        std::move(m.replicas),
+        model::timeout_clock::now()
+          + config::shard_local_cfg().partition_balancer_tick_ms())
+      .then([ntp](std::error_code ec) {
+          if (ec) {
+              vlog(
+                clusterlog.info,
+                "partition balancer move of {} failed: {}",
+                ntp,
+                ec.message());
+          }
+      })
+      .handle_exception([ntp](std::exception_ptr e) {
+          vlog(
+            clusterlog.info,
+            "partition balancer move of {} failed: {}",
+            ntp,
+            e);
+      });
+}
+
+ss::future<> partition_balancer::execute_transfer(leadership_transfer t) {
+    auto shard = _shard_table.local().shard_for(t.ntp);
+    if (!shard) {
+        return ss::now();
+    }
+    auto ntp = t.ntp;
+    return _partition_manager
+      .invoke_on(
+        *shard,
+        [t = std::move(t)](partition_manager& pm) {
+            auto partition = pm.get(t.ntp);
+            if (!partition || !partition->is_leader()) {
+                // leadership changed between planning and execution
+                return ss::make_ready_future<std::error_code>(
+                  make_error_code(errc::success));
+            }
+            return partition->transfer_leadership(t.target);
+        })
+      .then([ntp](std::error_code ec) {
+          if (ec) {
+              vlog(
+                clusterlog.info,
+                "partition balancer leadership transfer of {} failed: {}",
+                ntp,
+                ec.message());
+          }
+      })
+      .handle_exception([ntp](std::exception_ptr e) {
+          vlog(
+            clusterlog.info,
+            "partition balancer leadership transfer of {} failed: {}",
+            ntp,
+            e);
+      });
+}
+
+} // namespace cluster
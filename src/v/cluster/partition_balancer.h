@@ -0,0 +1,97 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "cluster/members_table.h"
+#include "cluster/partition_leaders_table.h"
+#include "cluster/partition_manager.h"
+#include "cluster/shard_table.h"
+#include "cluster/topic_table.h"
+#include "cluster/topics_frontend.h"
+#include "cluster/types.h"
+#include "model/metadata.h"
+#include "seastarx.h"
+
+#include <seastar/core/gate.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
+
+#include <vector>
+
+namespace cluster {
+
+/**
+ * Continuously nudges the cluster toward balance. Every tick the balancer
+ * takes a snapshot of per-node replica and leadership counts from the
+ * controller tables and schedules a small, bounded batch of replica moves
+ * and leadership transfers, relying on the online reconfiguration path to
+ * carry each move out at recovery-throttle rate.
+ *
+ * Replica moves are scheduled only on the controller leader since they are
+ * replicated controller commands. Leadership is balanced by every node for
+ * the partitions it currently leads, as a transfer has to be initiated by
+ * the group leader itself.
+ */
+class partition_balancer {
+public:
+    static constexpr ss::shard_id shard = 0;
+
+    partition_balancer(
+      consensus_ptr raft0,
+      ss::sharded<topic_table>&,
+      ss::sharded<members_table>&,
+      ss::sharded<partition_leaders_table>&,
+      ss::sharded<topics_frontend>&,
+      ss::sharded<partition_manager>&,
+      ss::sharded<shard_table>&);
+
+    ss::future<> start();
+    ss::future<> stop();
+
+private:
+    struct replica_move {
+        model::ntp ntp;
+        std::vector<model::broker_shard> replicas;
+    };
+
+    struct leadership_transfer {
+        model::ntp ntp;
+        model::node_id target;
+    };
+
+    struct plan {
+        std::vector<replica_move> moves;
+        std::vector<leadership_transfer> transfers;
+    };
+
+    void tick();
+    ss::future<> do_tick();
+    plan make_plan();
+    void plan_replica_moves(plan&, size_t& budget);
+    void plan_leadership_transfers(plan&, size_t& budget);
+    ss::future<> execute(plan);
+    ss::future<> execute_move(replica_move);
+    ss::future<> execute_transfer(leadership_transfer);
+
+    consensus_ptr _raft0;
+    ss::sharded<topic_table>& _topics;
+    ss::sharded<members_table>& _members;
+    ss::sharded<partition_leaders_table>& _leaders;
+    ss::sharded<topics_frontend>& _frontend;
+    ss::sharded<partition_manager>& _partition_manager;
+    ss::sharded<shard_table>& _shard_table;
+    model::node_id _self;
+    ss::timer<> _timer;
+    ss::gate _gate;
+};
+
+} // namespace cluster
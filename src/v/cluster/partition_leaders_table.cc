@@ -9,15 +9,40 @@
 
 #include "cluster/partition_leaders_table.h"
 
+#include "config/configuration.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
+#include "prometheus/prometheus_sanitize.h"
 
 #include <seastar/core/future-util.hh>
+#include <seastar/core/metrics.hh>
 
 #include <optional>
 
 namespace cluster {
 
+partition_leaders_table::partition_leaders_table() { setup_metrics(); }
+
+void partition_leaders_table::setup_metrics() {
+    namespace sm = ss::metrics;
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("cluster:leaders_table"),
+      {
+        sm::make_derive(
+          "lookups",
+          [this] { return _lookups; },
+          sm::description("Total number of partition leader lookups")),
+        sm::make_derive(
+          "misses",
+          [this] { return _misses; },
+          sm::description("Total number of partition leader lookups that "
+                          "found no leader information")),
+      });
+}
+
 ss::future<> partition_leaders_table::stop() {
     while (!_leader_promises.empty()) {
         auto it = _leader_promises.begin();
@@ -32,10 +57,12 @@ ss::future<> partition_leaders_table::stop() {
 
 std::optional<model::node_id> partition_leaders_table::get_leader(
   model::topic_namespace_view tp_ns, model::partition_id pid) const {
+    ++_lookups;
     if (auto it = _leaders.find(leader_key_view{tp_ns, pid});
         it != _leaders.end()) {
         return it->second.id;
     }
+    ++_misses;
     return std::nullopt;
 }
 
@@ -57,15 +84,26 @@ void partition_leaders_table::update_partition_leader(
             model::topic_namespace(ntp.ns, ntp.tp.topic), ntp.tp.partition},
           leader_meta{leader_id, term});
         it = new_it;
+    } else {
+        if (it->second.update_term > term) {
+            // Do nothing if update term is older
+            return;
+        }
+        if (it->second.update_term == term && it->second.id == leader_id) {
+            /*
+             * replayed update, nothing changed. returning before the
+             * version bump keeps incremental snapshots and version-keyed
+             * caches valid and spares waiters a duplicate notification,
+             * so re-disseminated leadership bursts are cheap no-ops
+             */
+            return;
+        }
+        // existing partition
+        it->second.id = leader_id;
+        it->second.update_term = term;
     }
-
-    if (it->second.update_term > term) {
-        // Do nothing if update term is older
-        return;
-    }
-    // existing partition
-    it->second.id = leader_id;
-    it->second.update_term = term;
+    ++_version;
+    it->second.table_version = _version;
 
     // notify waiters if update is setting the leader
     if (!leader_id) {
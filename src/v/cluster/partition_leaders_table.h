@@ -15,6 +15,9 @@
 #include "model/metadata.h"
 #include "utils/concepts-enabled.h"
 #include "utils/expiring_promise.h"
+#include "utils/named_type.h"
+
+#include <seastar/core/metrics_registration.hh>
 
 #include <absl/container/flat_hash_map.h>
 
@@ -27,7 +30,12 @@ namespace cluster {
 /// received by cluster::metadata_dissemination_service.
 class partition_leaders_table {
 public:
-    partition_leaders_table() = default;
+    // monotonic counter incremented on every effective leadership change.
+    // cheap to compare, allows callers caching state derived from the table
+    // to detect that it changed without registering for notifications
+    using version = named_type<int64_t, struct leaders_version_tag>;
+
+    partition_leaders_table();
 
     ss::future<> stop();
 
@@ -58,15 +66,45 @@ public:
         }
     }
 
+    // visits only the leaders that changed after the table reached the
+    // given version, allowing callers that already synced up to `v` to
+    // read an incremental snapshot. version{-1} visits every entry
+    // clang-format off
+    template<typename Func>
+    CONCEPT(requires requires(
+      Func f,
+      model::topic_namespace_view tp_ns,
+      model::partition_id pid,
+      std::optional<model::node_id> leader,
+      model::term_id term) {
+            { f(tp_ns, pid, leader, term) } -> std::same_as<void>;
+    })
+    // clang-format on
+    void for_each_updated_leader(version v, Func&& f) const {
+        for (auto& [k, meta] : _leaders) {
+            if (meta.table_version > v) {
+                f(k.tp_ns, k.pid, meta.id, meta.update_term);
+            }
+        }
+    }
+
     void remove_leader(const model::ntp& ntp) {
-        _leaders.erase(
+        auto erased = _leaders.erase(
           leader_key_view{model::topic_namespace_view(ntp), ntp.tp.partition});
+        if (erased > 0) {
+            ++_version;
+        }
     }
 
     void update_partition_leader(
       const model::ntp&, model::term_id, std::optional<model::node_id>);
 
+    /// Returns version of the current table state
+    version leaders_version() const { return _version; }
+
 private:
+    void setup_metrics();
+
     // optimized to reduce number of ntp copies
     struct leader_key {
         model::topic_namespace tp_ns;
@@ -126,6 +164,9 @@ private:
     struct leader_meta {
         std::optional<model::node_id> id;
         model::term_id update_term;
+        // value of _version when this entry last changed, used to serve
+        // incremental leadership snapshots
+        version table_version{0};
     };
 
     absl::flat_hash_map<leader_key, leader_meta, leader_key_hash, leader_key_eq>
@@ -137,6 +178,14 @@ private:
     absl::
       flat_hash_map<model::ntp, std::vector<expiring_promise<model::node_id>>>
         _leader_promises;
+
+    version _version{0};
+
+    // the table is consulted on every produce/fetch, the counters expose
+    // the traffic volume and hit ratio. mutable as lookups are const
+    mutable uint64_t _lookups{0};
+    mutable uint64_t _misses{0};
+    ss::metrics::metric_groups _metrics;
 };
 
 } // namespace cluster
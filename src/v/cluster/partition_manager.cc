@@ -23,12 +23,121 @@
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/smp.hh>
 
+#include <algorithm>
+
 namespace cluster {
 
 partition_manager::partition_manager(
   ss::sharded<storage::api>& storage, ss::sharded<raft::group_manager>& raft)
   : _storage(storage.local())
-  , _raft_manager(raft) {}
+  , _raft_manager(raft) {
+    _leadership_balance_timer.set_callback(
+      [this] { dispatch_leadership_balance(); });
+}
+
+ss::future<> partition_manager::start() {
+    _leadership_balance_timer.arm_periodic(leadership_balance_interval);
+    return ss::now();
+}
+
+void partition_manager::dispatch_leadership_balance() {
+    if (_gate.is_closed()) {
+        return;
+    }
+    /*
+     * a group elects one leader among its voters, so this shard's fair
+     * share of leaders is the sum of 1/voters over the replicas it hosts.
+     * when hot leaders pile up well beyond that share, offer the excess to
+     * the groups' followers; transfer_leadership picks the most caught up
+     * one. this levels leader-driven work (appends, replication fan-out)
+     * across cores without moving any data.
+     */
+    double expected = 0;
+    std::vector<ss::lw_shared_ptr<partition>> leaders;
+    for (auto& [group, p] : _raft_table) {
+        const auto voters = p->raft()->config().unique_voter_count();
+        expected += 1.0 / std::max<size_t>(voters, 1);
+        if (p->is_leader()) {
+            leaders.push_back(p);
+        }
+    }
+    // tolerate 50% skew and do not bother shards with a handful of leaders
+    auto excess = static_cast<ssize_t>(leaders.size())
+                  - static_cast<ssize_t>(expected * 3 / 2);
+    if (excess <= 0 || leaders.size() < 8) {
+        return;
+    }
+    vlog(
+      clusterlog.info,
+      "Shard holds {} leaders with an expected share of {:.1f}, requesting "
+      "{} leadership transfers",
+      leaders.size(),
+      expected,
+      excess);
+    (void)ss::with_gate(_gate, [this, leaders = std::move(leaders), excess] {
+        return ss::do_with(
+          std::move(leaders), [excess](auto& leaders) mutable {
+              leaders.resize(excess);
+              return ss::parallel_for_each(leaders, [](auto& p) {
+                  return p->transfer_leadership(std::nullopt)
+                    .discard_result()
+                    .handle_exception([ntp = p->ntp()](
+                                        const std::exception_ptr& e) {
+                        vlog(
+                          clusterlog.debug,
+                          "Leadership transfer of {} for balancing failed - "
+                          "{}",
+                          ntp,
+                          e);
+                    });
+              });
+          });
+    });
+}
+
+ss::future<> partition_manager::drain_leadership() {
+    // no point balancing a shard that is about to go away
+    _leadership_balance_timer.cancel();
+    std::vector<ss::lw_shared_ptr<partition>> leaders;
+    for (auto& [group, p] : _raft_table) {
+        if (p->is_leader()) {
+            leaders.push_back(p);
+        }
+    }
+    if (leaders.empty()) {
+        return ss::now();
+    }
+    vlog(
+      clusterlog.info,
+      "Draining leadership of {} partitions before shutdown",
+      leaders.size());
+    return ss::with_gate(_gate, [leaders = std::move(leaders)]() mutable {
+        return ss::do_with(std::move(leaders), [](auto& leaders) {
+            return ss::parallel_for_each(leaders, [](auto& p) {
+                return p->transfer_leadership(std::nullopt)
+                  .then([p](std::error_code ec) {
+                      if (ec) {
+                          vlog(
+                            clusterlog.debug,
+                            "Pre-shutdown leadership transfer of {} failed "
+                            "- {}",
+                            p->ntp(),
+                            ec.message());
+                      }
+                  })
+                  .handle_exception(
+                    [ntp = p->ntp()](const std::exception_ptr& e) {
+                        vlog(
+                          clusterlog.debug,
+                          "Pre-shutdown leadership transfer of {} failed - "
+                          "{}",
+                          ntp,
+                          e);
+                    });
+            });
+        });
+    });
+}
 
 ss::future<consensus_ptr> partition_manager::manage(
   storage::ntp_config ntp_cfg,
@@ -45,14 +154,17 @@ ss::future<consensus_ptr> partition_manager::manage(
                 _ntp_table.emplace(log.config().ntp(), p);
                 _raft_table.emplace(group, p);
                 _manage_watchers.notify(p->ntp(), p);
-                return p->start().then([c] { return c; });
+                return p->start(intern(p->ntp())).then([c] { return c; });
             });
       });
 }
 
 ss::future<> partition_manager::stop() {
-    return ss::parallel_for_each(
-      _ntp_table, [](auto& p) { return p.second->stop(); });
+    _leadership_balance_timer.cancel();
+    return _gate.close().then([this] {
+        return ss::parallel_for_each(
+          _ntp_table, [](auto& p) { return p.second->stop(); });
+    });
 }
 
 ss::future<> partition_manager::remove(const model::ntp& ntp) {
@@ -69,6 +181,7 @@ ss::future<> partition_manager::remove(const model::ntp& ntp) {
     // remove partition from ntp & raft tables
     _ntp_table.erase(ntp);
     _raft_table.erase(group_id);
+    _interned.erase(ntp);
 
     return _raft_manager.local()
       .remove(partition->raft())
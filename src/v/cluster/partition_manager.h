@@ -12,6 +12,7 @@
 #pragma once
 
 #include "cluster/ntp_callbacks.h"
+#include "cluster/ntp_intern.h"
 #include "cluster/partition.h"
 #include "cluster/shard_table.h"
 #include "model/metadata.h"
@@ -21,8 +22,13 @@
 #include "storage/api.h"
 #include "utils/named_type.h"
 
+#include <seastar/core/gate.hh>
+#include <seastar/core/timer.hh>
+
 #include <absl/container/flat_hash_map.h>
 
+#include <chrono>
+
 namespace cluster {
 class partition_manager {
 public:
@@ -55,8 +61,22 @@ public:
         return nullptr;
     }
 
-    ss::future<> start() { return ss::now(); }
+    // how often a shard checks whether it carries more than its share of
+    // leaders. each group elects one leader among its voters, so a shard
+    // hosting N replicas expects to lead roughly the sum of 1/voters over
+    // them; everything beyond the slack is offered to followers
+    static constexpr std::chrono::seconds leadership_balance_interval{30};
+
+    ss::future<> start();
     ss::future<> stop();
+
+    /**
+     * Hand off leadership of every locally led partition to the most
+     * caught-up follower. Called before shutdown begins so a rolling
+     * restart transfers leaders away instead of leaving each group to
+     * wait out an election timeout.
+     */
+    ss::future<> drain_leadership();
     ss::future<consensus_ptr>
       manage(storage::ntp_config, raft::group_id, std::vector<model::broker>);
 
@@ -98,7 +118,22 @@ public:
         _manage_watchers.unregister_notify(id);
     }
 
+    /// shared {path, metric labels} bundle for the ntp. formatted at most
+    /// once per partition lifetime; callers that need the formatted forms
+    /// (probe setup, log lines, admin output) hold the shared reference
+    /// instead of re-formatting
+    ntp_strings_ptr intern(const model::ntp& ntp) {
+        if (auto it = _interned.find(ntp); it != _interned.end()) {
+            return it->second;
+        }
+        auto strings = make_ntp_strings(ntp);
+        _interned.emplace(ntp, strings);
+        return strings;
+    }
+
 private:
+    void dispatch_leadership_balance();
+
     storage::api& _storage;
     /// used to wait for concurrent recoveries
     ss::sharded<raft::group_manager>& _raft_manager;
@@ -108,6 +143,9 @@ private:
     absl::flat_hash_map<model::ntp, ss::lw_shared_ptr<partition>> _ntp_table;
     absl::flat_hash_map<raft::group_id, ss::lw_shared_ptr<partition>>
       _raft_table;
+    absl::flat_hash_map<model::ntp, ntp_strings_ptr> _interned;
+    ss::timer<> _leadership_balance_timer;
+    ss::gate _gate;
 
     friend std::ostream& operator<<(std::ostream&, const partition_manager&);
 };
@@ -16,22 +16,18 @@
 #include <seastar/core/metrics.hh>
 
 namespace cluster {
-void partition_probe::setup_metrics(const model::ntp& ntp) {
+void partition_probe::setup_metrics(
+  const model::ntp& ntp, ntp_strings_ptr strings) {
     namespace sm = ss::metrics;
 
     if (config::shard_local_cfg().disable_metrics()) {
         return;
     }
 
-    auto ns_label = sm::label("namespace");
-    auto topic_label = sm::label("topic");
-    auto partition_label = sm::label("partition");
-
-    const std::vector<sm::label_instance> labels = {
-      ns_label(ntp.ns()),
-      topic_label(ntp.tp.topic()),
-      partition_label(ntp.tp.partition()),
-    };
+    if (!strings) {
+        strings = make_ntp_strings(ntp);
+    }
+    const std::vector<sm::label_instance>& labels = strings->labels;
 
     _metrics.add_group(
       prometheus_sanitize::metrics_name("cluster:partition"),
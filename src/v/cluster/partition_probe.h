@@ -10,6 +10,7 @@
  */
 
 #pragma once
+#include "cluster/ntp_intern.h"
 #include "model/fundamental.h"
 
 #include <seastar/core/metrics_registration.hh>
@@ -25,7 +26,9 @@ public:
     explicit partition_probe(partition& partition)
       : _partition(partition) {}
 
-    void setup_metrics(const model::ntp&);
+    /// the interned label bundle avoids re-formatting the per-partition
+    /// labels; when absent (tests) they are built from the ntp directly
+    void setup_metrics(const model::ntp&, ntp_strings_ptr strings = nullptr);
 
     void add_records_produced(uint64_t num_records) {
         _records_produced += num_records;
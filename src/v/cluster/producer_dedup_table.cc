@@ -0,0 +1,130 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/producer_dedup_table.h"
+
+#include "likely.h"
+
+#include <algorithm>
+
+namespace cluster {
+
+void producer_dedup_table::maybe_reset(model::term_id term) {
+    if (term != _term) {
+        _producers.clear();
+        _term = term;
+    }
+}
+
+bool producer_dedup_table::matches(
+  const seq_range& r, const batch_identity& bid) {
+    return r.epoch == bid.producer_epoch && r.first_seq == bid.first_seq
+           && r.last_seq == bid.last_seq;
+}
+
+void producer_dedup_table::drop_pending(
+  producer_state& state, const batch_identity& bid) {
+    for (uint8_t i = 0; i < state.pending_size; i++) {
+        if (matches(state.pending[i], bid)) {
+            std::copy(
+              state.pending.begin() + i + 1,
+              state.pending.begin() + state.pending_size,
+              state.pending.begin() + i);
+            state.pending_size--;
+            return;
+        }
+    }
+}
+
+producer_dedup_table::check_result
+producer_dedup_table::reserve(const batch_identity& bid, model::term_id term) {
+    maybe_reset(term);
+
+    auto& state = _producers[bid.producer_id];
+    if (bid.producer_epoch < state.epoch) {
+        return check_result{.outcome = status::fenced};
+    }
+
+    // a retry of a batch whose replication has not resolved yet must not
+    // append a second copy and cannot replay an offset either; the
+    // client retries once the original outcome is known
+    for (uint8_t i = 0; i < state.pending_size; i++) {
+        if (matches(state.pending[i], bid)) {
+            return check_result{.outcome = status::in_progress};
+        }
+    }
+
+    if (bid.producer_epoch == state.epoch) {
+        for (uint8_t i = 0; i < state.size; i++) {
+            const auto& r = state.ranges[i];
+            if (matches(r, bid)) {
+                return check_result{
+                  .outcome = status::duplicate, .base_offset = r.base_offset};
+            }
+        }
+        // contiguity is checked against the newest reservation so a
+        // pipelining producer can keep several batches in flight
+        if (state.pending_size > 0 || state.size > 0) {
+            const auto next_seq = state.pending_size > 0
+                                    ? state.pending[state.pending_size - 1]
+                                          .last_seq
+                                        + 1
+                                    : state.newest().last_seq + 1;
+            if (bid.first_seq != next_seq) {
+                // either a gap or a rewind to a range already evicted
+                // from the ring
+                return check_result{.outcome = status::out_of_order};
+            }
+        }
+    }
+    // a bumped epoch restarts the sequence stream; stale ranges are
+    // dropped when the first batch of the new epoch is confirmed
+
+    if (unlikely(state.pending_size == max_cached_batches)) {
+        // more concurrent batches than kafka permits per producer;
+        // reject rather than lose track of a reservation
+        return check_result{.outcome = status::out_of_order};
+    }
+    state.pending[state.pending_size++] = seq_range{
+      .epoch = bid.producer_epoch,
+      .first_seq = bid.first_seq,
+      .last_seq = bid.last_seq};
+    return check_result{.outcome = status::accept};
+}
+
+void producer_dedup_table::confirm(
+  const batch_identity& bid, model::term_id term, model::offset base_offset) {
+    maybe_reset(term);
+
+    auto& state = _producers[bid.producer_id];
+    drop_pending(state, bid);
+    if (bid.producer_epoch > state.epoch) {
+        state.epoch = bid.producer_epoch;
+        state.head = 0;
+        state.size = 0;
+    }
+    state.push(seq_range{
+      .epoch = bid.producer_epoch,
+      .first_seq = bid.first_seq,
+      .last_seq = bid.last_seq,
+      .base_offset = base_offset});
+}
+
+void producer_dedup_table::abandon(
+  const batch_identity& bid, model::term_id term) {
+    if (term != _term) {
+        // the table was or will be reset; nothing to release
+        return;
+    }
+    if (auto it = _producers.find(bid.producer_id); it != _producers.end()) {
+        drop_pending(it->second, bid);
+    }
+}
+
+} // namespace cluster
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "model/record.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <algorithm>
+#include <array>
+
+namespace cluster {
+
+/// Identity of an idempotent record batch, extracted from the batch
+/// header before the batch is wrapped in a reader. Plain values so it
+/// can travel across shards with the produce dispatch.
+struct batch_identity {
+    int64_t producer_id{-1};
+    int16_t producer_epoch{-1};
+    int32_t first_seq{0};
+    int32_t last_seq{0};
+
+    bool is_idempotent() const { return producer_id >= 0; }
+
+    static batch_identity from(const model::record_batch_header& hdr) {
+        return batch_identity{
+          .producer_id = hdr.producer_id,
+          .producer_epoch = hdr.producer_epoch,
+          .first_seq = hdr.base_sequence,
+          .last_seq = hdr.base_sequence + hdr.record_count - 1};
+    }
+};
+
+/**
+ * Leader side tracking of idempotent producer sequences.
+ *
+ * Each producer id maps to a fixed ring of its most recently accepted
+ * batch sequence ranges. The flat storage keeps the hot path free of
+ * per batch allocations: once a producer's slot exists a check and an
+ * update touch a single small map entry.
+ *
+ * The table is in memory and scoped to the current raft term. When the
+ * term changes the table resets and the first batch from each producer
+ * is accepted without validation, since batches replicated by a
+ * previous leader are unknown here. Within a stable term — the
+ * overwhelmingly common case for client retries — duplicate and out of
+ * order sequences are detected exactly. Accepted ranges stay reserved
+ * until their replication resolves, so two concurrent retries of the
+ * same batch can never both reach the log.
+ */
+class producer_dedup_table {
+public:
+    // kafka allows at most five in flight batches per idempotent
+    // producer, so five ranges are enough to recognize any retry the
+    // client is still permitted to send
+    static constexpr size_t max_cached_batches = 5;
+
+    enum class status {
+        // previously unseen batch: range reserved, proceed with replication
+        accept,
+        // retry of a batch that is already in the log
+        duplicate,
+        // retry of a batch whose replication is still in flight
+        in_progress,
+        // gap or rewind in the producer's sequence stream
+        out_of_order,
+        // batch carries an epoch older than the producer's current one
+        fenced,
+    };
+
+    struct check_result {
+        status outcome;
+        // base offset of the original occurrence, set for duplicates
+        model::offset base_offset;
+    };
+
+    /// validate a batch against the producer's recent history and, on
+    /// accept, reserve its sequence range so a concurrent retry of the
+    /// same batch cannot replicate a second copy. every reservation must
+    /// be resolved with confirm() or abandon().
+    check_result reserve(const batch_identity&, model::term_id);
+
+    /// record a successfully replicated batch, releasing its reservation
+    void confirm(const batch_identity&, model::term_id, model::offset);
+
+    /// drop the reservation of a batch whose replication failed so the
+    /// client's retry can be validated afresh
+    void abandon(const batch_identity&, model::term_id);
+
+    size_t size() const { return _producers.size(); }
+
+private:
+    struct seq_range {
+        int16_t epoch{-1};
+        int32_t first_seq{0};
+        int32_t last_seq{0};
+        model::offset base_offset;
+    };
+
+    struct producer_state {
+        int16_t epoch{-1};
+        // ring of accepted ranges, newest at (head - 1) % size
+        std::array<seq_range, max_cached_batches> ranges;
+        uint8_t head{0};
+        uint8_t size{0};
+        // ranges reserved by replications still in flight, oldest first;
+        // bounded by the five in-flight batches kafka permits
+        std::array<seq_range, max_cached_batches> pending;
+        uint8_t pending_size{0};
+
+        const seq_range& newest() const {
+            return ranges[(head + max_cached_batches - 1) % max_cached_batches];
+        }
+
+        void push(seq_range r) {
+            ranges[head] = r;
+            head = (head + 1) % max_cached_batches;
+            size = std::min<uint8_t>(size + 1, max_cached_batches);
+        }
+    };
+
+    // drop all state when the leadership term moves
+    void maybe_reset(model::term_id);
+
+    static bool matches(const seq_range&, const batch_identity&);
+    static void drop_pending(producer_state&, const batch_identity&);
+
+    absl::flat_hash_map<int64_t, producer_state> _producers;
+    model::term_id _term;
+};
+
+} // namespace cluster
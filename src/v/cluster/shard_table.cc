@@ -0,0 +1,46 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/shard_table.h"
+
+#include "config/configuration.h"
+#include "prometheus/prometheus_sanitize.h"
+
+#include <seastar/core/metrics.hh>
+
+namespace cluster {
+
+shard_table::shard_table() { setup_metrics(); }
+
+void shard_table::setup_metrics() {
+    namespace sm = ss::metrics;
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("cluster:shard_table"),
+      {
+        sm::make_derive(
+          "ntp_lookups",
+          [this] { return _ntp_lookups; },
+          sm::description("Total number of ntp to shard lookups")),
+        sm::make_derive(
+          "ntp_misses",
+          [this] { return _ntp_misses; },
+          sm::description(
+            "Total number of ntp to shard lookups that did not "
+            "find the ntp")),
+        sm::make_derive(
+          "group_lookups",
+          [this] { return _group_lookups; },
+          sm::description("Total number of raft group to shard lookups")),
+      });
+}
+
+} // namespace cluster
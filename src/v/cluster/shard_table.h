@@ -15,6 +15,7 @@
 #include "raft/types.h"
 #include "seastarx.h"
 
+#include <seastar/core/metrics_registration.hh>
 #include <seastar/core/reactor.hh> // shard_id
 
 #include <absl/container/flat_hash_map.h>
@@ -24,10 +25,13 @@ namespace cluster {
 /// every core will have a _full_ copy of all indexes
 class shard_table final {
 public:
+    shard_table();
+
     bool contains(const raft::group_id& group) {
         return _group_idx.find(group) != _group_idx.end();
     }
     ss::shard_id shard_for(const raft::group_id& group) {
+        ++_group_lookups;
         return _group_idx.find(group)->second;
     }
 
@@ -35,9 +39,11 @@ public:
      * \brief Lookup the owning shard for an ntp.
      */
     std::optional<ss::shard_id> shard_for(const model::ntp& ntp) {
+        ++_ntp_lookups;
         if (auto it = _ntp_idx.find(ntp); it != _ntp_idx.end()) {
             return it->second;
         }
+        ++_ntp_misses;
         return std::nullopt;
     }
     void insert(model::ntp ntp, ss::shard_id i) {
@@ -51,9 +57,18 @@ public:
     }
 
 private:
+    void setup_metrics();
+
     // kafka index
     absl::flat_hash_map<model::ntp, ss::shard_id> _ntp_idx;
     // raft index
     absl::flat_hash_map<raft::group_id, ss::shard_id> _group_idx;
+
+    // the table is consulted on every produce/fetch to route the request,
+    // the counters expose the traffic volume and hit ratio
+    uint64_t _ntp_lookups{0};
+    uint64_t _ntp_misses{0};
+    uint64_t _group_lookups{0};
+    ss::metrics::metric_groups _metrics;
 };
 } // namespace cluster
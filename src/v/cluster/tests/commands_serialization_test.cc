@@ -117,6 +117,28 @@ FIXTURE_TEST(test_delete_topic_cmd_serialization, cmd_test_fixture) {
     });
 }
 
+FIXTURE_TEST(test_multi_command_batch_serialization, cmd_test_fixture) {
+    std::vector<cluster::delete_topic_cmd> cmds;
+    for (int i = 0; i < 5; ++i) {
+        cmds.push_back(make_delete_topic_cmd(fmt::format("test_tp_{}", i)));
+    }
+
+    auto batch = cluster::serialize_cmds(std::move(cmds)).get0();
+    BOOST_REQUIRE_EQUAL(batch.record_count(), 5);
+
+    auto deser = cluster::deserialize_commands(
+                   std::move(batch),
+                   cluster::make_commands_list<cluster::delete_topic_cmd>())
+                   .get0();
+    BOOST_REQUIRE_EQUAL(deser.size(), 5);
+    for (int i = 0; i < 5; ++i) {
+        ss::visit(deser[i], [i](cluster::delete_topic_cmd c) {
+            BOOST_REQUIRE_EQUAL(
+              c.key.tp, model::topic(fmt::format("test_tp_{}", i)));
+        });
+    }
+}
+
 FIXTURE_TEST(test_move_partition_replicass_command, cmd_test_fixture) {
     auto ntp = model::ntp(test_ns, model::topic("tp"), model::partition_id(20));
     std::vector<model::broker_shard> replicas{
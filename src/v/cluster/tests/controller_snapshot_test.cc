@@ -0,0 +1,77 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/controller_snapshot.h"
+#include "cluster/tests/utils.h"
+#include "cluster/types.h"
+#include "model/compression.h"
+#include "model/fundamental.h"
+#include "model/metadata.h"
+#include "raft/types.h"
+#include "units.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+static cluster::topic_table::snapshot_entry
+make_snapshot_entry(const ss::sstring& topic, int partitions, int64_t offset) {
+    cluster::topic_configuration cfg(
+      test_ns, model::topic(topic), partitions, 3);
+    cfg.segment_size = 100_MiB;
+    cfg.compression = model::compression::snappy;
+
+    std::vector<cluster::partition_assignment> assignments;
+    assignments.reserve(partitions);
+    for (int i = 0; i < partitions; i++) {
+        assignments.push_back(cluster::partition_assignment{
+          raft::group_id(i + 1),
+          model::partition_id(i),
+          {model::broker_shard{.node_id = model::node_id(i % 3), .shard = 2}}});
+    }
+    return cluster::topic_table::snapshot_entry{
+      .topic = cluster::topic_configuration_assignment(
+        cfg, std::move(assignments)),
+      .offset = model::offset(offset)};
+}
+
+SEASTAR_THREAD_TEST_CASE(controller_snapshot_roundtrip) {
+    cluster::controller_snapshot_data data{
+      .highest_group_id = raft::group_id(42),
+      .topics = {
+        make_snapshot_entry("tp-1", 3, 10),
+        make_snapshot_entry("tp-2", 1, 17)}};
+
+    auto decoded = cluster::decode_controller_snapshot(
+      cluster::encode_controller_snapshot(std::move(data)));
+
+    BOOST_REQUIRE_EQUAL(decoded.highest_group_id, raft::group_id(42));
+    BOOST_REQUIRE_EQUAL(decoded.topics.size(), 2);
+    BOOST_REQUIRE_EQUAL(decoded.topics[0].offset, model::offset(10));
+    BOOST_REQUIRE_EQUAL(
+      decoded.topics[0].topic.cfg.tp_ns.tp, model::topic("tp-1"));
+    BOOST_REQUIRE_EQUAL(decoded.topics[0].topic.cfg.partition_count, 3);
+    BOOST_REQUIRE_EQUAL(
+      decoded.topics[0].topic.cfg.compression, model::compression::snappy);
+    BOOST_REQUIRE_EQUAL(decoded.topics[0].topic.assignments.size(), 3);
+    BOOST_REQUIRE_EQUAL(
+      decoded.topics[0].topic.assignments[2].group, raft::group_id(3));
+    BOOST_REQUIRE_EQUAL(
+      decoded.topics[0].topic.assignments[2].replicas.size(), 1);
+    BOOST_REQUIRE_EQUAL(decoded.topics[1].offset, model::offset(17));
+    BOOST_REQUIRE_EQUAL(
+      decoded.topics[1].topic.cfg.tp_ns.tp, model::topic("tp-2"));
+}
+
+SEASTAR_THREAD_TEST_CASE(controller_snapshot_empty_roundtrip) {
+    auto decoded = cluster::decode_controller_snapshot(
+      cluster::encode_controller_snapshot(cluster::controller_snapshot_data{
+        .highest_group_id = raft::group_id(0), .topics = {}}));
+
+    BOOST_REQUIRE_EQUAL(decoded.highest_group_id, raft::group_id(0));
+    BOOST_REQUIRE(decoded.topics.empty());
+}
@@ -0,0 +1,76 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/members_table.h"
+#include "cluster/metadata_cache.h"
+#include "cluster/partition_leaders_table.h"
+#include "cluster/tests/topic_table_fixture.h"
+#include "model/fundamental.h"
+#include "model/metadata.h"
+
+struct metadata_cache_fixture : topic_table_fixture {
+    metadata_cache_fixture() {
+        members.start().get0();
+        leaders.start().get0();
+    }
+
+    ~metadata_cache_fixture() {
+        leaders.stop().get0();
+        members.stop().get0();
+    }
+
+    ss::sharded<cluster::members_table> members;
+    ss::sharded<cluster::partition_leaders_table> leaders;
+};
+
+FIXTURE_TEST(topics_metadata_snapshot_is_shared, metadata_cache_fixture) {
+    cluster::metadata_cache cache(table, members, leaders);
+    create_topics();
+
+    auto s_1 = cache.all_topics_metadata();
+    auto s_2 = cache.all_topics_metadata();
+
+    // repeated reads share the same snapshot instance
+    BOOST_REQUIRE_EQUAL(s_1.get(), s_2.get());
+    BOOST_REQUIRE_EQUAL(s_1->size(), 3);
+}
+
+FIXTURE_TEST(topics_metadata_snapshot_invalidation, metadata_cache_fixture) {
+    cluster::metadata_cache cache(table, members, leaders);
+    create_topics();
+
+    auto s_1 = cache.all_topics_metadata();
+
+    // leadership change produces a new snapshot with the leader filled in
+    leaders.local().update_partition_leader(
+      model::ntp(test_ns, model::topic("test_tp_1"), model::partition_id(0)),
+      model::term_id(1),
+      model::node_id(2));
+    auto s_2 = cache.all_topics_metadata();
+    BOOST_REQUIRE(s_1.get() != s_2.get());
+    auto it = std::find_if(
+      s_2->begin(), s_2->end(), [this](const model::topic_metadata& md) {
+          return md.tp_ns == make_tp_ns("test_tp_1");
+      });
+    BOOST_REQUIRE(it != s_2->end());
+    BOOST_REQUIRE(it->partitions[0].leader_node == model::node_id(2));
+
+    // topic deletion produces a new snapshot, readers holding the old one
+    // still see the state they started with
+    auto res = table.local()
+                 .apply(
+                   cluster::delete_topic_cmd(
+                     make_tp_ns("test_tp_2"), make_tp_ns("test_tp_2")),
+                   model::offset(0))
+                 .get0();
+    BOOST_REQUIRE_EQUAL(res, cluster::errc::success);
+    auto s_3 = cache.all_topics_metadata();
+    BOOST_REQUIRE_EQUAL(s_3->size(), 2);
+    BOOST_REQUIRE_EQUAL(s_1->size(), 3);
+}
@@ -38,6 +38,17 @@ SEASTAR_THREAD_TEST_CASE(test_notify_after_timeout) {
     BOOST_REQUIRE_EQUAL(r, cluster::errc::notification_wait_timeout);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_notify_wakes_earlier_offsets) {
+    cluster::notification_latch latch;
+    auto f_early = latch.wait_for(model::offset(5), model::no_timeout);
+    auto f_a = latch.wait_for(model::offset(10), model::no_timeout);
+    auto f_b = latch.wait_for(model::offset(10), model::no_timeout);
+    latch.notify(model::offset(10));
+    BOOST_REQUIRE_EQUAL(f_early.get0(), cluster::errc::success);
+    BOOST_REQUIRE_EQUAL(f_a.get0(), cluster::errc::success);
+    BOOST_REQUIRE_EQUAL(f_b.get0(), cluster::errc::success);
+}
+
 #if 0
 SEASTAR_THREAD_TEST_CASE(destroy_before_notify_broken_promise) {
     ss::future<cluster::errc> fut = ss::make_ready_future<cluster::errc>(
@@ -156,6 +156,58 @@ FIXTURE_TEST(recovery_test, partition_allocator_tester) {
       allocated_shards);
 }
 
+BOOST_AUTO_TEST_CASE(rack_aware_assignment) {
+    partition_allocator pa(raft::group_id(0));
+    // two machines in each of three racks
+    for (int i = 0; i < 6; ++i) {
+        pa.register_node(std::make_unique<allocation_node>(
+          model::node_id(i),
+          4,
+          std::unordered_map<ss::sstring, ss::sstring>{},
+          ss::sstring(fmt::format("rack_{}", i / 2))));
+    }
+    auto cfg = topic_configuration(
+      model::ns("test_ns"), model::topic("w00t"), 50, 3);
+    auto allocs = pa.allocate(cfg).value();
+    for (auto& a : allocs.get_assignments()) {
+        std::map<int, int> racks;
+        for (auto& bs : a.replicas) {
+            racks[bs.node_id() / 2]++;
+        }
+        // with as many racks as replicas, every replica lands in a
+        // distinct rack
+        BOOST_REQUIRE_EQUAL(racks.size(), 3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(capacity_weighted_assignment) {
+    partition_allocator pa(raft::group_id(0));
+    // three large machines and one with a fraction of the capacity
+    for (int i = 0; i < 3; ++i) {
+        pa.register_node(std::make_unique<allocation_node>(
+          model::node_id(i),
+          10,
+          std::unordered_map<ss::sstring, ss::sstring>{}));
+    }
+    pa.register_node(std::make_unique<allocation_node>(
+      model::node_id(3), 2, std::unordered_map<ss::sstring, ss::sstring>{}));
+
+    auto cfg = topic_configuration(
+      model::ns("test_ns"), model::topic("w00t"), 100, 3);
+    auto allocs = pa.allocate(cfg).value();
+    std::map<model::node_id, int> node_assignment;
+    for (auto& a : allocs.get_assignments()) {
+        for (auto& bs : a.replicas) {
+            node_assignment[bs.node_id]++;
+        }
+    }
+    // replicas flow to the machines with the most remaining capacity
+    BOOST_REQUIRE_EQUAL(node_assignment[model::node_id(0)], 100);
+    BOOST_REQUIRE_EQUAL(node_assignment[model::node_id(1)], 100);
+    BOOST_REQUIRE_EQUAL(node_assignment[model::node_id(2)], 100);
+    BOOST_REQUIRE_EQUAL(node_assignment[model::node_id(3)], 0);
+}
+
 BOOST_AUTO_TEST_CASE(round_robin_load) {
     partition_allocator_tester test(5, 10);
     auto cfg = test.gen_topic_configuration(100, 3);
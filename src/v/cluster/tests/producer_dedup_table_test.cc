@@ -0,0 +1,134 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/producer_dedup_table.h"
+#include "model/fundamental.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+using status = cluster::producer_dedup_table::status;
+
+static cluster::batch_identity
+make_bid(int64_t pid, int16_t epoch, int32_t first, int32_t last) {
+    return cluster::batch_identity{
+      .producer_id = pid,
+      .producer_epoch = epoch,
+      .first_seq = first,
+      .last_seq = last};
+}
+
+SEASTAR_THREAD_TEST_CASE(accepts_then_detects_duplicate) {
+    cluster::producer_dedup_table table;
+    auto term = model::term_id(1);
+    auto bid = make_bid(7, 0, 0, 9);
+
+    BOOST_REQUIRE(table.reserve(bid, term).outcome == status::accept);
+    table.confirm(bid, term, model::offset(100));
+
+    auto res = table.reserve(bid, term);
+    BOOST_REQUIRE(res.outcome == status::duplicate);
+    BOOST_REQUIRE_EQUAL(res.base_offset, model::offset(100));
+}
+
+SEASTAR_THREAD_TEST_CASE(concurrent_retry_of_in_flight_batch_rejected) {
+    cluster::producer_dedup_table table;
+    auto term = model::term_id(1);
+    auto bid = make_bid(7, 0, 0, 9);
+
+    BOOST_REQUIRE(table.reserve(bid, term).outcome == status::accept);
+    // a retry arriving while the first copy is still replicating must
+    // not be accepted a second time
+    BOOST_REQUIRE(table.reserve(bid, term).outcome == status::in_progress);
+
+    table.confirm(bid, term, model::offset(100));
+    auto res = table.reserve(bid, term);
+    BOOST_REQUIRE(res.outcome == status::duplicate);
+    BOOST_REQUIRE_EQUAL(res.base_offset, model::offset(100));
+}
+
+SEASTAR_THREAD_TEST_CASE(abandon_releases_the_reservation) {
+    cluster::producer_dedup_table table;
+    auto term = model::term_id(1);
+    auto bid = make_bid(7, 0, 0, 9);
+
+    BOOST_REQUIRE(table.reserve(bid, term).outcome == status::accept);
+    // replication failed; the client's retry is validated afresh
+    table.abandon(bid, term);
+    BOOST_REQUIRE(table.reserve(bid, term).outcome == status::accept);
+}
+
+SEASTAR_THREAD_TEST_CASE(detects_sequence_gap_and_rewind) {
+    cluster::producer_dedup_table table;
+    auto term = model::term_id(1);
+    table.confirm(make_bid(7, 0, 0, 9), term, model::offset(0));
+
+    // next expected sequence is 10; a pipelining producer may reserve
+    // several contiguous batches before any of them is confirmed
+    BOOST_REQUIRE(
+      table.reserve(make_bid(7, 0, 10, 19), term).outcome == status::accept);
+    BOOST_REQUIRE(
+      table.reserve(make_bid(7, 0, 20, 29), term).outcome == status::accept);
+    // gap
+    BOOST_REQUIRE(
+      table.reserve(make_bid(7, 0, 35, 44), term).outcome
+      == status::out_of_order);
+    // rewind that is not an exact cached batch
+    BOOST_REQUIRE(
+      table.reserve(make_bid(7, 0, 5, 9), term).outcome
+      == status::out_of_order);
+}
+
+SEASTAR_THREAD_TEST_CASE(fences_stale_epoch) {
+    cluster::producer_dedup_table table;
+    auto term = model::term_id(1);
+    table.confirm(make_bid(7, 1, 0, 9), term, model::offset(0));
+
+    BOOST_REQUIRE(
+      table.reserve(make_bid(7, 0, 10, 19), term).outcome == status::fenced);
+
+    // a bumped epoch restarts the sequence stream
+    BOOST_REQUIRE(
+      table.reserve(make_bid(7, 2, 0, 4), term).outcome == status::accept);
+    table.confirm(make_bid(7, 2, 0, 4), term, model::offset(10));
+    BOOST_REQUIRE(
+      table.reserve(make_bid(7, 1, 0, 9), term).outcome == status::fenced);
+}
+
+SEASTAR_THREAD_TEST_CASE(resets_on_term_change) {
+    cluster::producer_dedup_table table;
+    table.confirm(make_bid(7, 0, 0, 9), model::term_id(1), model::offset(0));
+    BOOST_REQUIRE_EQUAL(table.size(), 1);
+
+    // a new term drops state replicated under the previous leader, so
+    // any sequence is accepted without validation; the accepted batch
+    // claims the only slot in the fresh table
+    BOOST_REQUIRE(
+      table.reserve(make_bid(7, 0, 50, 59), model::term_id(2)).outcome
+      == status::accept);
+    BOOST_REQUIRE_EQUAL(table.size(), 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(old_batches_evicted_from_ring) {
+    cluster::producer_dedup_table table;
+    auto term = model::term_id(1);
+
+    auto first = make_bid(7, 0, 0, 9);
+    table.confirm(first, term, model::offset(0));
+    for (int32_t i = 1;
+         i <= int32_t(cluster::producer_dedup_table::max_cached_batches);
+         i++) {
+        auto bid = make_bid(7, 0, i * 10, i * 10 + 9);
+        BOOST_REQUIRE(table.reserve(bid, term).outcome == status::accept);
+        table.confirm(bid, term, model::offset(i * 10));
+    }
+
+    // the first batch has been pushed out of the ring: a retry can no
+    // longer be recognized as a duplicate and must be rejected
+    BOOST_REQUIRE(table.reserve(first, term).outcome == status::out_of_order);
+}
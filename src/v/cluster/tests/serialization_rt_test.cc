@@ -31,6 +31,7 @@ SEASTAR_THREAD_TEST_CASE(topic_config_rt_test) {
     cfg.segment_size = std::optional<size_t>(1_GiB);
     cfg.retention_bytes = tristate<size_t>{};
     cfg.retention_duration = tristate<std::chrono::milliseconds>(10h);
+    cfg.in_memory_storage = true;
 
     auto d = serialize_roundtrip_rpc(std::move(cfg));
 
@@ -48,6 +49,7 @@ SEASTAR_THREAD_TEST_CASE(topic_config_rt_test) {
       model::compaction_strategy::offset, d.compaction_strategy);
     BOOST_CHECK(10h == d.retention_duration.value());
     BOOST_REQUIRE_EQUAL(tristate<size_t>{}, d.retention_bytes);
+    BOOST_REQUIRE_EQUAL(true, d.in_memory_storage);
 }
 
 SEASTAR_THREAD_TEST_CASE(broker_metadata_rt_test) {
@@ -189,3 +191,47 @@ SEASTAR_THREAD_TEST_CASE(config_update_req_resp_test) {
     auto reply_res = serialize_roundtrip_rpc(std::move(reply));
     BOOST_REQUIRE_EQUAL(reply_res.success, true);
 }
+
+SEASTAR_THREAD_TEST_CASE(create_topics_request_async_rt_test) {
+    auto make_request = [] {
+        std::vector<cluster::topic_configuration> topics;
+        topics.emplace_back(model::ns("test"), model::topic("tp-1"), 12, 3);
+        topics.emplace_back(model::ns("test"), model::topic("tp-2"), 6, 1);
+        return cluster::create_topics_request{std::move(topics), 10s};
+    };
+
+    auto d = async_serialize_roundtrip_rpc(make_request()).get0();
+    BOOST_REQUIRE_EQUAL(d.topics.size(), 2);
+    BOOST_REQUIRE_EQUAL(d.topics[0].tp_ns.tp, model::topic("tp-1"));
+    BOOST_REQUIRE_EQUAL(d.topics[0].partition_count, 12);
+    BOOST_REQUIRE_EQUAL(d.topics[1].replication_factor, 1);
+    BOOST_CHECK(d.timeout == 10s);
+
+    // the async codec must keep the synchronous wire format
+    iobuf sync_io = reflection::to_iobuf(make_request());
+    iobuf_parser parser(std::move(sync_io));
+    auto from_sync = reflection::async_adl<cluster::create_topics_request>{}
+                       .from(parser)
+                       .get0();
+    BOOST_REQUIRE_EQUAL(from_sync.topics.size(), 2);
+    BOOST_REQUIRE_EQUAL(from_sync.topics[1].tp_ns.tp, model::topic("tp-2"));
+}
+
+SEASTAR_THREAD_TEST_CASE(create_topics_reply_async_rt_test) {
+    std::vector<cluster::topic_result> results;
+    results.emplace_back(
+      model::topic_namespace(model::ns("test"), model::topic("tp-1")),
+      cluster::errc::success);
+    std::vector<cluster::topic_configuration> configs;
+    configs.emplace_back(model::ns("test"), model::topic("tp-1"), 4, 3);
+    cluster::create_topics_reply reply{
+      std::move(results), {}, std::move(configs)};
+
+    auto d = async_serialize_roundtrip_rpc(std::move(reply)).get0();
+    BOOST_REQUIRE_EQUAL(d.results.size(), 1);
+    BOOST_REQUIRE_EQUAL(d.results[0].tp_ns.tp, model::topic("tp-1"));
+    BOOST_REQUIRE(d.results[0].ec == cluster::errc::success);
+    BOOST_REQUIRE_EQUAL(d.metadata.size(), 0);
+    BOOST_REQUIRE_EQUAL(d.configs.size(), 1);
+    BOOST_REQUIRE_EQUAL(d.configs[0].partition_count, 4);
+}
@@ -105,6 +105,46 @@ FIXTURE_TEST(get_getting_config, topic_table_fixture) {
       tristate(std::make_optional(std::chrono::milliseconds(3600000))));
 }
 
+FIXTURE_TEST(test_versioned_subscription, topic_table_fixture) {
+    auto sub = table.local().subscribe();
+    auto v_0 = table.local().topics_version();
+    create_topics();
+    auto v_1 = table.local().topics_version();
+
+    // subscriber sees only entries changed since its version
+    auto changes = table.local().changes_since(v_0);
+    BOOST_REQUIRE(changes.has_value());
+    BOOST_REQUIRE_EQUAL(changes->size(), 21);
+    BOOST_REQUIRE(table.local().changes_since(v_1)->empty());
+
+    // deltas are retained until acknowledged
+    BOOST_REQUIRE_EQUAL(table.local().changes_since(v_0)->size(), 21);
+    table.local().ack_version(sub, v_1);
+
+    // acknowledged deltas are pruned, a reader that far behind has to
+    // rebuild from the full table state
+    BOOST_REQUIRE(!table.local().changes_since(v_0).has_value());
+    table.local().unsubscribe(sub);
+}
+
+FIXTURE_TEST(test_subscription_retention, topic_table_fixture) {
+    auto fast = table.local().subscribe();
+    auto slow = table.local().subscribe();
+    auto v_0 = table.local().topics_version();
+    create_topics();
+    auto v_1 = table.local().topics_version();
+
+    // the slow subscriber keeps the deltas alive
+    table.local().ack_version(fast, v_1);
+    BOOST_REQUIRE_EQUAL(table.local().changes_since(v_0)->size(), 21);
+
+    // once every subscriber acknowledged the deltas are gone
+    table.local().ack_version(slow, v_1);
+    BOOST_REQUIRE(!table.local().changes_since(v_0).has_value());
+    table.local().unsubscribe(fast);
+    table.local().unsubscribe(slow);
+}
+
 FIXTURE_TEST(test_wait_aborted, topic_table_fixture) {
     ss::abort_source local_as;
     ss::timer<> timer;
@@ -49,13 +49,17 @@ topic_table::apply(create_topic_cmd cmd, model::offset offset) {
           errc::topic_already_exists);
     }
     // calculate delta
+    const auto first_delta = _pending_deltas.size();
     for (auto& pas : cmd.value.assignments) {
         auto ntp = model::ntp(cmd.key.ns, cmd.key.tp, pas.id);
         _pending_deltas.emplace_back(
           std::move(ntp), pas, offset, delta::op_type::add);
     }
 
+    _creation_offsets.insert({cmd.key, offset});
     _topics.insert({cmd.key, std::move(cmd.value)});
+    ++_version;
+    retain_deltas(first_delta);
     notify_waiters();
     return ss::make_ready_future<std::error_code>(errc::success);
 }
@@ -70,12 +74,16 @@ ss::future<> topic_table::stop() {
 ss::future<std::error_code>
 topic_table::apply(delete_topic_cmd cmd, model::offset offset) {
     if (auto tp = _topics.find(cmd.value); tp != _topics.end()) {
+        const auto first_delta = _pending_deltas.size();
         for (auto& p : tp->second.assignments) {
             auto ntp = model::ntp(cmd.key.ns, cmd.key.tp, p.id);
             _pending_deltas.emplace_back(
               std::move(ntp), std::move(p), offset, delta::op_type::del);
         }
         _topics.erase(tp);
+        _creation_offsets.erase(cmd.value);
+        ++_version;
+        retain_deltas(first_delta);
         notify_waiters();
         return ss::make_ready_future<std::error_code>(errc::success);
     }
@@ -104,16 +112,108 @@ topic_table::apply(move_partition_replicas_cmd cmd, model::offset o) {
     current_assignment_it->replicas = cmd.value;
 
     // calculate deleta for backend
+    const auto first_delta = _pending_deltas.size();
     model::ntp ntp(tp->first.ns, tp->first.tp, current_assignment_it->id);
     _pending_deltas.emplace_back(
       std::move(ntp), *current_assignment_it, o, delta::op_type::update);
 
+    ++_version;
+    retain_deltas(first_delta);
     notify_waiters();
 
     return ss::make_ready_future<std::error_code>(errc::success);
 }
 
+void topic_table::retain_deltas(size_t first_new) {
+    if (_subscribers.empty()) {
+        // nothing would ever prune retained deltas, a later subscriber
+        // bootstraps from the full table state anyway
+        _pruned_version = _version;
+        return;
+    }
+    for (auto it = _pending_deltas.cbegin() + first_new;
+         it != _pending_deltas.cend();
+         ++it) {
+        _delta_log.push_back(versioned_delta{.v = _version, .d = *it});
+    }
+}
+
+void topic_table::prune_delta_log() {
+    auto min_acked = _version;
+    for (const auto& [id, acked] : _subscribers) {
+        min_acked = std::min(min_acked, acked);
+    }
+    while (!_delta_log.empty() && _delta_log.front().v <= min_acked) {
+        _delta_log.pop_front();
+    }
+    _pruned_version = std::max(_pruned_version, min_acked);
+}
+
+topic_table::subscription_id topic_table::subscribe() {
+    auto id = _next_subscription_id++;
+    _subscribers.emplace(id, _version);
+    return id;
+}
+
+void topic_table::unsubscribe(subscription_id id) {
+    _subscribers.erase(id);
+    prune_delta_log();
+}
+
+std::optional<std::vector<topic_table::delta>>
+topic_table::changes_since(version v) const {
+    if (v < _pruned_version) {
+        return std::nullopt;
+    }
+    std::vector<delta> ret;
+    for (const auto& vd : _delta_log) {
+        if (vd.v > v) {
+            ret.push_back(vd.d);
+        }
+    }
+    return ret;
+}
+
+void topic_table::ack_version(subscription_id id, version v) {
+    auto it = _subscribers.find(id);
+    if (it == _subscribers.end()) {
+        return;
+    }
+    it->second = std::max(it->second, v);
+    prune_delta_log();
+}
+
+ss::future<std::vector<std::error_code>>
+topic_table::apply_span(std::vector<span_entry> span) {
+    begin_apply_span();
+    return ss::do_with(
+      std::move(span),
+      std::vector<std::error_code>{},
+      [this](
+        std::vector<span_entry>& span, std::vector<std::error_code>& results) {
+          results.reserve(span.size());
+          return ss::do_for_each(
+                   span,
+                   [this, &results](span_entry& entry) {
+                       return std::visit(
+                                [this, o = entry.offset](auto& cmd) {
+                                    return apply(std::move(cmd), o);
+                                },
+                                entry.cmd)
+                         .then([&results](std::error_code ec) {
+                             results.push_back(ec);
+                         });
+                   })
+            .then([&results] { return std::move(results); })
+            .finally([this] { end_apply_span(); });
+      });
+}
+
 void topic_table::notify_waiters() {
+    if (_notifications_deferred) {
+        // a span apply is in flight, end_apply_span runs the flush
+        return;
+    }
     if (_waiters.empty()) {
         return;
     }
@@ -194,6 +294,61 @@ std::vector<model::topic_metadata> topic_table::all_topics_metadata() const {
     });
 }
 
+topic_table::flat_metadata_ptr topic_table::flat_metadata() const {
+    if (_flat_view && _flat_view_version == _version) {
+        return _flat_view;
+    }
+    flat_metadata_view view;
+    view.topics.reserve(_topics.size());
+    size_t partition_count = 0;
+    size_t replica_count = 0;
+    for (const auto& [tp_ns, tca] : _topics) {
+        partition_count += tca.assignments.size();
+        for (const auto& pas : tca.assignments) {
+            replica_count += pas.replicas.size();
+        }
+    }
+    view.partitions.reserve(partition_count);
+    view.replicas.reserve(replica_count);
+    for (const auto& [tp_ns, tca] : _topics) {
+        const auto partitions_begin = static_cast<uint32_t>(
+          view.partitions.size());
+        for (const auto& pas : tca.assignments) {
+            const auto replicas_begin = static_cast<uint32_t>(
+              view.replicas.size());
+            view.replicas.insert(
+              view.replicas.end(),
+              pas.replicas.cbegin(),
+              pas.replicas.cend());
+            view.partitions.push_back(flat_metadata_view::partition_entry{
+              .id = pas.id,
+              .replicas_begin = replicas_begin,
+              .replicas_end = static_cast<uint32_t>(view.replicas.size())});
+        }
+        view.topics.push_back(flat_metadata_view::topic_entry{
+          .tp_ns = tp_ns,
+          .partitions_begin = partitions_begin,
+          .partitions_end = static_cast<uint32_t>(view.partitions.size())});
+    }
+    _flat_view = ss::make_lw_shared<const flat_metadata_view>(std::move(view));
+    _flat_view_version = _version;
+    return _flat_view;
+}
+
+std::vector<topic_table::snapshot_entry> topic_table::snapshot_entries() const {
+    std::vector<snapshot_entry> ret;
+    ret.reserve(_topics.size());
+    for (const auto& [tp_ns, tca] : _topics) {
+        auto it = _creation_offsets.find(tp_ns);
+        vassert(
+          it != _creation_offsets.end(),
+          "Missing creation offset for topic {}",
+          tp_ns);
+        ret.push_back(snapshot_entry{.topic = tca, .offset = it->second});
+    }
+    return ret;
+}
+
 bool topic_table::contains(
   model::topic_namespace_view topic, model::partition_id pid) const {
     if (auto it = _topics.find(topic); it != _topics.end()) {
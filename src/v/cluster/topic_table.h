@@ -16,9 +16,16 @@
 #include "cluster/types.h"
 #include "model/fundamental.h"
 #include "utils/expiring_promise.h"
+#include "utils/named_type.h"
+
+#include <seastar/core/shared_ptr.hh>
 
 #include <absl/container/flat_hash_map.h>
 
+#include <deque>
+#include <variant>
+#include <vector>
+
 namespace cluster {
 
 /// Topic table represent all topics configuration and partition assignments.
@@ -32,6 +39,11 @@ namespace cluster {
 ///
 class topic_table {
 public:
+    // monotonic counter incremented on every mutation of the table. cheap
+    // to compare, allows callers caching state derived from the table to
+    // detect that it changed without registering for notifications
+    using version = named_type<int64_t, struct topic_table_version_tag>;
+
     // delta propagated to backend
     struct delta {
         enum class op_type { add, del, update };
@@ -68,6 +80,27 @@ public:
     ss::future<std::error_code>
       apply(move_partition_replicas_cmd, model::offset);
 
+    /// Batched apply. A span is the decoded form of one log poll worth of
+    /// commands, applied in order with waiters notified once at the end
+    /// instead of once per command
+    using command_variant = std::
+      variant<create_topic_cmd, delete_topic_cmd, move_partition_replicas_cmd>;
+    struct span_entry {
+        command_variant cmd;
+        model::offset offset;
+    };
+    ss::future<std::vector<std::error_code>>
+      apply_span(std::vector<span_entry>);
+
+    /// Defers waiter notification and delta handoff until end_apply_span.
+    /// Used by callers that interleave per command bookkeeping with table
+    /// updates but still want a single notification flush per span
+    void begin_apply_span() { _notifications_deferred = true; }
+    void end_apply_span() {
+        _notifications_deferred = false;
+        notify_waiters();
+    }
+
     ss::future<> stop();
 
     /// Delta API
@@ -76,6 +109,32 @@ public:
 
     bool has_pending_changes() const { return !_pending_deltas.empty(); }
 
+    /// Versioned delta subscriptions
+    ///
+    /// Unlike wait_for_changes, which hands pending deltas to the current
+    /// waiters and then drops them, subscriptions retain deltas tagged with
+    /// the version they were applied at until every subscriber acknowledged
+    /// them. A subscriber periodically asks for the entries changed since
+    /// the version it last acknowledged, so each round costs O(changes)
+    /// instead of re-reading the whole table
+    using subscription_id
+      = named_type<int64_t, struct topic_table_subscription_tag>;
+
+    /// Registers a subscriber. The subscriber is expected to bootstrap from
+    /// the full table state at the current version and follow with
+    /// changes_since/ack_version
+    subscription_id subscribe();
+    void unsubscribe(subscription_id);
+
+    /// Returns deltas applied after the given version, or std::nullopt when
+    /// that version was already pruned and the subscriber fell too far
+    /// behind - it then has to rebuild from the full table state
+    std::optional<std::vector<delta>> changes_since(version) const;
+
+    /// Acknowledges that a subscriber processed all deltas up to the given
+    /// version. Deltas acknowledged by every subscriber are pruned
+    void ack_version(subscription_id, version);
+
     /// Query API
 
     /// Returns list of all topics that exists in the cluster.
@@ -102,6 +161,41 @@ public:
     /// Returns metadata of all topics.
     std::vector<model::topic_metadata> all_topics_metadata() const;
 
+    /// Cache-dense, immutable flattened view of the table: topics,
+    /// partitions and replicas live in three flat arrays referencing each
+    /// other by index ranges, so full-table scans stream through memory
+    /// linearly instead of chasing per-topic and per-partition heap nodes.
+    /// The view is republished lazily when the table version changes and
+    /// shared between readers.
+    struct flat_metadata_view {
+        struct topic_entry {
+            model::topic_namespace tp_ns;
+            uint32_t partitions_begin;
+            uint32_t partitions_end;
+        };
+        struct partition_entry {
+            model::partition_id id;
+            uint32_t replicas_begin;
+            uint32_t replicas_end;
+        };
+        std::vector<topic_entry> topics;
+        std::vector<partition_entry> partitions;
+        std::vector<model::broker_shard> replicas;
+    };
+    using flat_metadata_ptr = ss::lw_shared_ptr<const flat_metadata_view>;
+    flat_metadata_ptr flat_metadata() const;
+
+    /// Configuration, assignments and creation offset of a single topic.
+    /// The creation offset is preserved by the controller snapshot as it
+    /// seeds the on disk partition revision ids
+    struct snapshot_entry {
+        topic_configuration_assignment topic;
+        model::offset offset;
+    };
+
+    /// Returns state of all topics for the controller snapshot
+    std::vector<snapshot_entry> snapshot_entries() const;
+
     /// Checks if it has given partition
     bool contains(model::topic_namespace_view, model::partition_id) const;
 
@@ -112,6 +206,9 @@ public:
     void update_partition_leader(
       const model::ntp&, model::term_id, std::optional<model::node_id>);
 
+    /// Returns version of the current table state
+    version topics_version() const { return _version; }
+
 private:
     struct waiter {
         explicit waiter(uint64_t id)
@@ -120,10 +217,19 @@ private:
         ss::abort_source::subscription sub;
         uint64_t id;
     };
+    struct versioned_delta {
+        version v;
+        delta d;
+    };
     void deallocate_topic_partitions(const std::vector<partition_assignment>&);
 
     void notify_waiters();
 
+    /// copies deltas starting at the given _pending_deltas index into the
+    /// retained log, tagged with the current version
+    void retain_deltas(size_t first_new);
+    void prune_delta_log();
+
     template<typename Func>
     std::vector<std::invoke_result_t<Func, topic_configuration_assignment>>
     transform_topics(Func&&) const;
@@ -134,9 +240,34 @@ private:
       model::topic_namespace_hash,
       model::topic_namespace_eq>
       _topics;
+    // offset of the create command of each topic, kept separately so the
+    // command value type stays unchanged on the wire
+    absl::flat_hash_map<
+      model::topic_namespace,
+      model::offset,
+      model::topic_namespace_hash,
+      model::topic_namespace_eq>
+      _creation_offsets;
 
     std::vector<delta> _pending_deltas;
     std::vector<std::unique_ptr<waiter>> _waiters;
     uint64_t _waiter_id{0};
+    version _version{0};
+    // set while a span is being applied, makes notify_waiters a no-op so
+    // waiters observe one flush per span
+    bool _notifications_deferred{false};
+
+    // deltas retained for subscribers, sorted by version
+    std::deque<versioned_delta> _delta_log;
+    // last version acknowledged by each subscriber
+    absl::flat_hash_map<subscription_id, version> _subscribers;
+    subscription_id _next_subscription_id{0};
+    // highest version already pruned from _delta_log
+    version _pruned_version{0};
+
+    // lazily republished flat view served by flat_metadata(), mutable as
+    // rebuilding is transparent to the const readers
+    mutable flat_metadata_ptr _flat_view;
+    mutable version _flat_view_version{-1};
 };
 } // namespace cluster
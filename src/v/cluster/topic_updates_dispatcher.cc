@@ -27,63 +27,257 @@ topic_updates_dispatcher::topic_updates_dispatcher(
 ss::future<std::error_code>
 topic_updates_dispatcher::apply_update(model::record_batch b) {
     auto base_offset = b.base_offset();
-    return deserialize(std::move(b), commands)
-      .then([this, base_offset](auto cmd) {
-          return ss::visit(
-            std::move(cmd),
-            [this, base_offset](delete_topic_cmd del_cmd) {
-                // delete case - we need state copy to
-                auto tp_md = _topic_table.local().get_topic_metadata(
-                  del_cmd.value);
-                return dispatch_updates_to_cores(del_cmd, base_offset)
-                  .then([this, tp_md](std::error_code ec) {
-                      if (ec == errc::success) {
-                          vassert(
-                            tp_md.has_value(),
-                            "Topic had to exist before successful delete");
-                          deallocate_topic(*tp_md);
-                      }
-                      return ec;
-                  });
-            },
-            [this, base_offset](create_topic_cmd create_cmd) {
-                return dispatch_updates_to_cores(create_cmd, base_offset)
-                  .then([this, create_cmd](std::error_code ec) {
-                      if (ec == errc::success) {
-                          update_allocations(create_cmd);
-                      }
-                      return ec;
-                  });
-            },
-            [this, base_offset](move_partition_replicas_cmd cmd) {
-                auto tp_md = _topic_table.local().get_topic_metadata(
-                  model::topic_namespace_view(cmd.key));
-                return dispatch_updates_to_cores(cmd, base_offset)
-                  .then([this, tp_md, cmd](std::error_code ec) {
-                      if (!ec) {
-                          vassert(
-                            tp_md.has_value(),
-                            "Topic had to exist before successful partition "
-                            "reallocation");
-                          auto it = std::find_if(
-                            std::cbegin(tp_md->partitions),
-                            std::cend(tp_md->partitions),
-                            [p_id = cmd.key.tp.partition](
-                              const model::partition_metadata& pmd) {
-                                return pmd.id == p_id;
-                            });
-                          vassert(
-                            it != tp_md->partitions.cend(),
-                            "Reassigned partition must exist");
-
-                          reallocate_partition(it->replicas, cmd.value);
-                      }
-                      return ec;
+    // bulk topic operations pack many commands into a single controller
+    // batch; they apply in order and the batch reports its first failure
+    return deserialize_commands(std::move(b), commands)
+      .then([this, base_offset](std::vector<topic_table::command_variant> c) {
+          return ss::do_with(
+            std::move(c),
+            std::error_code(errc::success),
+            [this, base_offset](
+              std::vector<topic_table::command_variant>& cmds,
+              std::error_code& result) {
+                return ss::do_for_each(
+                         cmds,
+                         [this, base_offset, &result](
+                           topic_table::command_variant& cmd) {
+                             return apply_cmd(std::move(cmd), base_offset)
+                               .then([&result](std::error_code ec) {
+                                   if (result == errc::success) {
+                                       result = ec;
+                                   }
+                               });
+                         })
+                  .then([&result] { return result; });
+            });
+      });
+}
+
+ss::future<std::error_code> topic_updates_dispatcher::apply_cmd(
+  topic_table::command_variant cmd, model::offset base_offset) {
+    return ss::visit(
+      std::move(cmd),
+      [this, base_offset](delete_topic_cmd del_cmd) {
+          // delete case - we need state copy to
+          auto tp_md = _topic_table.local().get_topic_metadata(del_cmd.value);
+          return dispatch_updates_to_cores(del_cmd, base_offset)
+            .then([this, tp_md](std::error_code ec) {
+                if (ec == errc::success) {
+                    vassert(
+                      tp_md.has_value(),
+                      "Topic had to exist before successful delete");
+                    deallocate_topic(*tp_md);
+                }
+                return ec;
+            });
+      },
+      [this, base_offset](create_topic_cmd create_cmd) {
+          return dispatch_updates_to_cores(create_cmd, base_offset)
+            .then([this, create_cmd](std::error_code ec) {
+                if (ec == errc::success) {
+                    update_allocations(create_cmd);
+                }
+                return ec;
+            });
+      },
+      [this, base_offset](move_partition_replicas_cmd cmd) {
+          auto tp_md = _topic_table.local().get_topic_metadata(
+            model::topic_namespace_view(cmd.key));
+          return dispatch_updates_to_cores(cmd, base_offset)
+            .then([this, tp_md, cmd](std::error_code ec) {
+                if (!ec) {
+                    vassert(
+                      tp_md.has_value(),
+                      "Topic had to exist before successful partition "
+                      "reallocation");
+                    auto it = std::find_if(
+                      std::cbegin(tp_md->partitions),
+                      std::cend(tp_md->partitions),
+                      [p_id = cmd.key.tp.partition](
+                        const model::partition_metadata& pmd) {
+                          return pmd.id == p_id;
+                      });
+                    vassert(
+                      it != tp_md->partitions.cend(),
+                      "Reassigned partition must exist");
+
+                    reallocate_partition(it->replicas, cmd.value);
+                }
+                return ec;
+            });
+      });
+}
+
+ss::future<std::vector<std::error_code>>
+topic_updates_dispatcher::apply_updates(
+  std::vector<model::record_batch> batches) {
+    using span_t = std::vector<topic_table::span_entry>;
+    return ss::do_with(
+      std::move(batches),
+      span_t{},
+      std::vector<std::error_code>{},
+      // number of commands each batch contributed to the span, used to
+      // fold the per command results back into one result per batch
+      std::vector<size_t>{},
+      [this](
+        std::vector<model::record_batch>& batches,
+        span_t& span,
+        std::vector<std::error_code>& results,
+        std::vector<size_t>& batch_sizes) {
+          span.reserve(batches.size());
+          results.reserve(batches.size());
+          batch_sizes.reserve(batches.size());
+          return ss::do_for_each(
+                   batches,
+                   [&span, &batch_sizes](model::record_batch& b) {
+                       auto offset = b.base_offset();
+                       return deserialize_commands(std::move(b), commands)
+                         .then([&span, &batch_sizes, offset](auto cmds) {
+                             batch_sizes.push_back(cmds.size());
+                             for (auto& cmd : cmds) {
+                                 span.push_back(topic_table::span_entry{
+                                   .cmd = std::move(cmd), .offset = offset});
+                             }
+                         });
+                   })
+            .then([this, &span, &results] {
+                // local core first: the allocator bookkeeping for delete
+                // and move needs the table state right before each command
+                // applies, so it is interleaved with the local updates
+                return apply_span_locally(span, results);
+            })
+            .then([this, &span, &results] {
+                // remote cores receive the whole decoded span in a single
+                // call each, with one waiter notification flush per core
+                return ss::parallel_for_each(
+                  boost::irange<ss::shard_id>(1, ss::smp::count),
+                  [this, &span, &results](ss::shard_id shard) {
+                      return _topic_table
+                        .invoke_on(
+                          shard,
+                          [span](topic_table& local_table) mutable {
+                              return local_table.apply_span(std::move(span));
+                          })
+                        .then([&results](std::vector<std::error_code> r) {
+                            vassert(
+                              r.size() == results.size(),
+                              "Shard applied {} commands, expected {}",
+                              r.size(),
+                              results.size());
+                            for (size_t i = 0; i < r.size(); ++i) {
+                                vassert(
+                                  r[i] == results[i],
+                                  "State inconsistency across shards "
+                                  "detected, expected result: {}, have: {}",
+                                  results[i],
+                                  r[i]);
+                            }
+                        });
                   });
+            })
+            .then([&results, &batch_sizes] {
+                // one result per batch: the first failing command in a
+                // multi command batch determines the batch result
+                std::vector<std::error_code> folded;
+                folded.reserve(batch_sizes.size());
+                size_t idx = 0;
+                for (auto count : batch_sizes) {
+                    std::error_code ec = errc::success;
+                    for (size_t i = 0; i < count; ++i, ++idx) {
+                        if (ec == errc::success) {
+                            ec = results[idx];
+                        }
+                    }
+                    folded.push_back(ec);
+                }
+                return folded;
             });
       });
 }
 
+ss::future<> topic_updates_dispatcher::apply_span_locally(
+  const std::vector<topic_table::span_entry>& span,
+  std::vector<std::error_code>& results) {
+    auto& table = _topic_table.local();
+    table.begin_apply_span();
+    return ss::do_for_each(
+             span,
+             [this, &table, &results](const topic_table::span_entry& entry) {
+                 auto offset = entry.offset;
+                 return ss::visit(
+                          entry.cmd,
+                          [this, &table, offset](
+                            const delete_topic_cmd& del_cmd) {
+                              // delete case - we need state copy to
+                              auto tp_md = table.get_topic_metadata(
+                                del_cmd.value);
+                              return table.apply(del_cmd, offset)
+                                .then([this, tp_md](std::error_code ec) {
+                                    if (ec == errc::success) {
+                                        vassert(
+                                          tp_md.has_value(),
+                                          "Topic had to exist before "
+                                          "successful delete");
+                                        deallocate_topic(*tp_md);
+                                    }
+                                    return ec;
+                                });
+                          },
+                          [this, &table, offset](
+                            const create_topic_cmd& create_cmd) {
+                              return table.apply(create_cmd, offset)
+                                .then([this, create_cmd](std::error_code ec) {
+                                    if (ec == errc::success) {
+                                        update_allocations(create_cmd);
+                                    }
+                                    return ec;
+                                });
+                          },
+                          [this, &table, offset](
+                            const move_partition_replicas_cmd& cmd) {
+                              auto tp_md = table.get_topic_metadata(
+                                model::topic_namespace_view(cmd.key));
+                              return table.apply(cmd, offset)
+                                .then([this, tp_md, cmd](std::error_code ec) {
+                                    if (!ec) {
+                                        vassert(
+                                          tp_md.has_value(),
+                                          "Topic had to exist before "
+                                          "successful partition reallocation");
+                                        auto it = std::find_if(
+                                          std::cbegin(tp_md->partitions),
+                                          std::cend(tp_md->partitions),
+                                          [p_id = cmd.key.tp.partition](
+                                            const model::partition_metadata&
+                                              pmd) { return pmd.id == p_id; });
+                                        vassert(
+                                          it != tp_md->partitions.cend(),
+                                          "Reassigned partition must exist");
+
+                                        reallocate_partition(
+                                          it->replicas, cmd.value);
+                                    }
+                                    return ec;
+                                });
+                          })
+                   .then([&results](std::error_code ec) {
+                       results.push_back(ec);
+                   });
+             })
+      .finally([&table] { table.end_apply_span(); });
+}
+
+ss::future<std::error_code> topic_updates_dispatcher::apply_snapshot_topic(
+  create_topic_cmd cmd, model::offset offset) {
+    return dispatch_updates_to_cores(cmd, offset)
+      .then([this, cmd = std::move(cmd)](std::error_code ec) {
+          if (ec == errc::success) {
+              update_allocations(cmd);
+          }
+          return ec;
+      });
+}
+
 template<typename Cmd>
 ss::future<std::error_code> do_apply(
   ss::shard_id shard,
@@ -53,6 +53,21 @@ public:
 
     ss::future<std::error_code> apply_update(model::record_batch);
 
+    /// Batched apply used by the mux stm during command storms. The whole
+    /// span of batches is decoded up front, the local table is updated in
+    /// one pass (interleaved with the allocator bookkeeping that needs the
+    /// pre command state) and each remote core receives the decoded span
+    /// in a single call, with one waiter notification flush per core
+    ss::future<std::vector<std::error_code>>
+      apply_updates(std::vector<model::record_batch>);
+
+    /// Applies a create topic command without the record batch round
+    /// trip. Used when recovering state from the controller snapshot,
+    /// where the original command offset comes from the snapshot instead
+    /// of the log
+    ss::future<std::error_code>
+      apply_snapshot_topic(create_topic_cmd, model::offset);
+
     static constexpr auto commands = make_commands_list<
       create_topic_cmd,
       delete_topic_cmd,
@@ -66,6 +81,13 @@ private:
     template<typename Cmd>
     ss::future<std::error_code> dispatch_updates_to_cores(Cmd, model::offset);
 
+    ss::future<std::error_code>
+      apply_cmd(topic_table::command_variant, model::offset);
+
+    ss::future<> apply_span_locally(
+      const std::vector<topic_table::span_entry>&,
+      std::vector<std::error_code>&);
+
     void update_allocations(const create_topic_cmd&);
     void deallocate_topic(const model::topic_metadata&);
     void reallocate_partition(
@@ -62,18 +62,7 @@ ss::future<std::vector<topic_result>> topics_frontend::create_topics(
               return ss::make_ready_future<std::vector<topic_result>>(
                 create_topic_results(topics, errc::not_leader_controller));
           }
-          std::vector<ss::future<topic_result>> futures;
-          futures.reserve(topics.size());
-
-          std::transform(
-            std::begin(topics),
-            std::end(topics),
-            std::back_inserter(futures),
-            [this, timeout](topic_configuration& t_cfg) {
-                return do_create_topic(std::move(t_cfg), timeout);
-            });
-
-          return ss::when_all_succeed(futures.begin(), futures.end());
+          return do_create_topics(std::move(topics), timeout);
       });
 }
 
@@ -125,34 +114,72 @@ ss::future<std::error_code> topics_frontend::replicate_and_wait(
       });
 }
 
-ss::future<topic_result> topics_frontend::do_create_topic(
-  topic_configuration t_cfg, model::timeout_clock::time_point timeout) {
-    if (!validate_topic_name(t_cfg.tp_ns)) {
-        return ss::make_ready_future<topic_result>(
-          topic_result(t_cfg.tp_ns, errc::invalid_topic_name));
-    }
-    return _allocator
-      .invoke_on(
-        partition_allocator::shard,
-        [t_cfg](partition_allocator& al) { return al.allocate(t_cfg); })
-      .then(
-        [this, t_cfg = std::move(t_cfg), timeout](
-          std::optional<partition_allocator::allocation_units> units) mutable {
-            // no assignments, error
-            if (!units) {
-                return ss::make_ready_future<topic_result>(
-                  topic_result(t_cfg.tp_ns, errc::topic_invalid_partitions));
-            }
-
-            return replicate_create_topic(
-              std::move(t_cfg), std::move(*units), timeout);
-        });
+ss::future<std::error_code> topics_frontend::replicate_and_wait_batch(
+  model::record_batch batch, model::timeout_clock::time_point timeout) {
+    return _stm.invoke_on(
+      controller_stm_shard,
+      [b = std::move(batch), timeout, &as = _as](controller_stm& stm) mutable {
+          return stm.replicate_and_wait(std::move(b), timeout, as.local());
+      });
 }
 
-ss::future<topic_result> topics_frontend::replicate_create_topic(
-  topic_configuration cfg,
-  partition_allocator::allocation_units units,
+ss::future<std::vector<topic_result>> topics_frontend::do_create_topics(
+  std::vector<topic_configuration> topics,
   model::timeout_clock::time_point timeout) {
+    return ss::do_with(
+      std::move(topics),
+      std::vector<topic_result>{},
+      std::vector<pending_create>{},
+      [this, timeout](
+        std::vector<topic_configuration>& topics,
+        std::vector<topic_result>& results,
+        std::vector<pending_create>& pending) {
+          results.reserve(topics.size());
+          pending.reserve(topics.size());
+          return ss::do_for_each(
+                   topics,
+                   [this, &results, &pending](topic_configuration& t_cfg) {
+                       if (!validate_topic_name(t_cfg.tp_ns)) {
+                           results.emplace_back(
+                             t_cfg.tp_ns, errc::invalid_topic_name);
+                           return ss::now();
+                       }
+                       return _allocator
+                         .invoke_on(
+                           partition_allocator::shard,
+                           [t_cfg](partition_allocator& al) {
+                               return al.allocate(t_cfg);
+                           })
+                         .then(
+                           [this, &results, &pending, &t_cfg](
+                             std::optional<partition_allocator::
+                                             allocation_units> units) {
+                               // no assignments, error
+                               if (!units) {
+                                   results.emplace_back(
+                                     t_cfg.tp_ns,
+                                     errc::topic_invalid_partitions);
+                                   return;
+                               }
+                               pending.push_back(make_pending_create(
+                                 std::move(t_cfg), std::move(*units)));
+                           });
+                   })
+            .then([this, timeout, &pending] {
+                return replicate_create_topics(pending, timeout);
+            })
+            .then([&results](std::vector<topic_result> replicated) {
+                std::move(
+                  replicated.begin(),
+                  replicated.end(),
+                  std::back_inserter(results));
+                return std::move(results);
+            });
+      });
+}
+
+topics_frontend::pending_create topics_frontend::make_pending_create(
+  topic_configuration cfg, partition_allocator::allocation_units units) {
     auto tp_ns = cfg.tp_ns;
     create_topic_cmd cmd(
       tp_ns,
@@ -171,33 +198,64 @@ ss::future<topic_result> topics_frontend::replicate_create_topic(
           p_as.replicas.begin()->node_id);
     }
 
-    return replicate_and_wait(std::move(cmd), timeout)
-      .then_wrapped(
-        [this,
-         tp_ns = std::move(tp_ns),
-         units = std::move(units),
-         leaders = std::move(leaders)](ss::future<std::error_code> f) mutable {
-            try {
-                auto error_code = f.get0();
-                auto ret_f = ss::now();
-                if (!error_code) {
-                    ret_f = update_leaders_with_estimates(std::move(leaders));
-                }
-
-                return ret_f.then([tp_ns = std::move(tp_ns),
-                                   error_code]() mutable {
-                    return topic_result(std::move(tp_ns), map_errc(error_code));
-                });
+    return pending_create{
+      .cmd = std::move(cmd),
+      .units = std::move(units),
+      .leaders = std::move(leaders)};
+}
 
-            } catch (...) {
-                vlog(
-                  clusterlog.warn,
-                  "Unable to create topic - {}",
-                  std::current_exception());
-                return ss::make_ready_future<topic_result>(
-                  topic_result(std::move(tp_ns), errc::replication_error));
-            }
-        });
+ss::future<std::vector<topic_result>> topics_frontend::replicate_create_topics(
+  std::vector<pending_create>& pending,
+  model::timeout_clock::time_point timeout) {
+    if (pending.empty()) {
+        return ss::make_ready_future<std::vector<topic_result>>();
+    }
+    std::vector<create_topic_cmd> cmds;
+    std::vector<model::topic_namespace> names;
+    std::vector<ntp_leader> leaders;
+    cmds.reserve(pending.size());
+    names.reserve(pending.size());
+    for (auto& p : pending) {
+        names.push_back(p.cmd.key);
+        std::move(
+          p.leaders.begin(), p.leaders.end(), std::back_inserter(leaders));
+        cmds.push_back(std::move(p.cmd));
+    }
+    // every validated create travels in a single controller batch: one
+    // replication round and one fsync regardless of the topic count. the
+    // commands apply in order and the batch reports its first failure,
+    // which is then attributed to all topics of the batch
+    return serialize_cmds(std::move(cmds))
+      .then([this, timeout](model::record_batch b) {
+          return replicate_and_wait_batch(std::move(b), timeout);
+      })
+      .then_wrapped([this,
+                     names = std::move(names),
+                     leaders = std::move(leaders)](
+                      ss::future<std::error_code> f) mutable {
+          std::error_code ec = errc::success;
+          try {
+              ec = f.get0();
+          } catch (...) {
+              vlog(
+                clusterlog.warn,
+                "Unable to create topics - {}",
+                std::current_exception());
+              ec = errc::replication_error;
+          }
+          auto ret_f = ss::now();
+          if (!ec) {
+              ret_f = update_leaders_with_estimates(std::move(leaders));
+          }
+          return ret_f.then([names = std::move(names), ec]() mutable {
+              std::vector<topic_result> results;
+              results.reserve(names.size());
+              for (auto& tp_ns : names) {
+                  results.emplace_back(std::move(tp_ns), map_errc(ec));
+              }
+              return results;
+          });
+      });
 }
 
 ss::future<> topics_frontend::update_leaders_with_estimates(
@@ -217,40 +275,38 @@ ss::future<> topics_frontend::update_leaders_with_estimates(
 ss::future<std::vector<topic_result>> topics_frontend::delete_topics(
   std::vector<model::topic_namespace> topics,
   model::timeout_clock::time_point timeout) {
-    std::vector<ss::future<topic_result>> futures;
-    futures.reserve(topics.size());
-
-    std::transform(
-      std::begin(topics),
-      std::end(topics),
-      std::back_inserter(futures),
-      [this, timeout](model::topic_namespace& tp_ns) {
-          return do_delete_topic(std::move(tp_ns), timeout);
-      });
-
-    return ss::when_all_succeed(futures.begin(), futures.end());
-}
-
-ss::future<topic_result> topics_frontend::do_delete_topic(
-  model::topic_namespace tp_ns, model::timeout_clock::time_point timeout) {
-    delete_topic_cmd cmd(tp_ns, tp_ns);
-
-    return replicate_and_wait(std::move(cmd), timeout)
+    if (topics.empty()) {
+        return ss::make_ready_future<std::vector<topic_result>>();
+    }
+    std::vector<delete_topic_cmd> cmds;
+    cmds.reserve(topics.size());
+    for (auto& tp_ns : topics) {
+        cmds.emplace_back(tp_ns, tp_ns);
+    }
+    // all deletes travel in a single controller batch, one replication
+    // round. the batch reports its first failure, attributed to all topics
+    return serialize_cmds(std::move(cmds))
+      .then([this, timeout](model::record_batch b) {
+          return replicate_and_wait_batch(std::move(b), timeout);
+      })
       .then_wrapped(
-        [tp_ns = std::move(tp_ns)](ss::future<std::error_code> f) mutable {
+        [topics = std::move(topics)](ss::future<std::error_code> f) mutable {
+            std::error_code ec = errc::success;
             try {
-                auto ec = f.get0();
-                if (ec != errc::success) {
-                    return topic_result(std::move(tp_ns), map_errc(ec));
-                }
-                return topic_result(std::move(tp_ns), errc::success);
+                ec = f.get0();
             } catch (...) {
                 vlog(
                   clusterlog.warn,
-                  "Unable to delete topic - {}",
+                  "Unable to delete topics - {}",
                   std::current_exception());
-                return topic_result(std::move(tp_ns), errc::replication_error);
+                ec = errc::replication_error;
+            }
+            std::vector<topic_result> results;
+            results.reserve(topics.size());
+            for (auto& tp_ns : topics) {
+                results.emplace_back(std::move(tp_ns), map_errc(ec));
             }
+            return results;
         });
 }
 
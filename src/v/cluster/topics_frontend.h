@@ -57,21 +57,30 @@ public:
 private:
     using ntp_leader = std::pair<model::ntp, model::node_id>;
 
-    ss::future<topic_result>
-      do_create_topic(topic_configuration, model::timeout_clock::time_point);
+    // a topic create that passed validation and allocation, waiting for
+    // batched replication through the controller
+    struct pending_create {
+        create_topic_cmd cmd;
+        partition_allocator::allocation_units units;
+        std::vector<ntp_leader> leaders;
+    };
+
+    ss::future<std::vector<topic_result>> do_create_topics(
+      std::vector<topic_configuration>, model::timeout_clock::time_point);
 
-    ss::future<topic_result> replicate_create_topic(
-      topic_configuration,
-      partition_allocator::allocation_units,
-      model::timeout_clock::time_point);
+    pending_create make_pending_create(
+      topic_configuration, partition_allocator::allocation_units);
 
-    ss::future<topic_result>
-      do_delete_topic(model::topic_namespace, model::timeout_clock::time_point);
+    ss::future<std::vector<topic_result>> replicate_create_topics(
+      std::vector<pending_create>&, model::timeout_clock::time_point);
 
     template<typename Cmd>
     ss::future<std::error_code>
     replicate_and_wait(Cmd&&, model::timeout_clock::time_point);
 
+    ss::future<std::error_code> replicate_and_wait_batch(
+      model::record_batch, model::timeout_clock::time_point);
+
     ss::future<std::vector<topic_result>> dispatch_create_to_leader(
       model::node_id,
       std::vector<topic_configuration>,
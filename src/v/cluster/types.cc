@@ -36,7 +36,8 @@ storage::ntp_config topic_configuration::make_ntp_config(
                          || segment_size || retention_bytes.has_value()
                          || retention_bytes.is_disabled()
                          || retention_duration.has_value()
-                         || retention_duration.is_disabled() || is_internal();
+                         || retention_duration.is_disabled() || is_internal()
+                         || in_memory_storage;
     std::unique_ptr<storage::ntp_config::default_overrides> overrides = nullptr;
 
     if (has_overrides) {
@@ -49,7 +50,8 @@ storage::ntp_config topic_configuration::make_ntp_config(
             .retention_time = retention_duration,
             // we disable cache for internal topics as they are read only once
             // during bootstrap.
-            .cache_enabled = storage::with_cache(!is_internal())});
+            .cache_enabled = storage::with_cache(!is_internal()),
+            .in_memory = in_memory_storage});
     }
     return storage::ntp_config(
       model::ntp(tp_ns.ns, tp_ns.tp, p_id),
@@ -84,7 +86,8 @@ std::ostream& operator<<(std::ostream& o, const topic_configuration& cfg) {
       "{{ topic: {}, partition_count: {}, replication_factor: {}, compression: "
       "{}, cleanup_policy_bitflags: {}, compaction_strategy: {}, "
       "retention_bytes: {}, "
-      "retention_duration_hours: {}, segment_size: {}, timestamp_type: {} }}",
+      "retention_duration_hours: {}, segment_size: {}, timestamp_type: {}, "
+      "in_memory_storage: {} }}",
       cfg.tp_ns,
       cfg.partition_count,
       cfg.replication_factor,
@@ -94,7 +97,8 @@ std::ostream& operator<<(std::ostream& o, const topic_configuration& cfg) {
       cfg.retention_bytes,
       cfg.retention_duration,
       cfg.segment_size,
-      cfg.timestamp_type);
+      cfg.timestamp_type,
+      cfg.in_memory_storage);
 
     return o;
 }
@@ -139,7 +143,8 @@ void adl<cluster::topic_configuration>::to(
       t.timestamp_type,
       t.segment_size,
       t.retention_bytes,
-      t.retention_duration);
+      t.retention_duration,
+      t.in_memory_storage);
 }
 
 cluster::topic_configuration
@@ -162,6 +167,7 @@ adl<cluster::topic_configuration>::from(iobuf_parser& in) {
     cfg.retention_bytes = adl<tristate<size_t>>{}.from(in);
     cfg.retention_duration = adl<tristate<std::chrono::milliseconds>>{}.from(
       in);
+    cfg.in_memory_storage = adl<bool>{}.from(in);
 
     return cfg;
 }
@@ -238,6 +244,60 @@ adl<cluster::create_topics_reply>::from(iobuf_parser& in) {
       std::move(results), std::move(md), std::move(cfg)};
 }
 
+ss::future<> async_adl<cluster::create_topics_request>::to(
+  iobuf& out, cluster::create_topics_request&& r) {
+    auto timeout = r.timeout;
+    return async_adl<std::vector<cluster::topic_configuration>>{}
+      .to(out, std::move(r.topics))
+      .then([&out, timeout] { reflection::serialize(out, timeout); });
+}
+
+ss::future<cluster::create_topics_request>
+async_adl<cluster::create_topics_request>::from(iobuf_parser& in) {
+    return async_adl<std::vector<cluster::topic_configuration>>{}
+      .from(in)
+      .then([&in](std::vector<cluster::topic_configuration> topics) {
+          auto timeout = adl<model::timeout_clock::duration>{}.from(in);
+          return cluster::create_topics_request{std::move(topics), timeout};
+      });
+}
+
+ss::future<> async_adl<cluster::create_topics_reply>::to(
+  iobuf& out, cluster::create_topics_reply&& r) {
+    return ss::do_with(std::move(r), [&out](cluster::create_topics_reply& r) {
+        return async_adl<std::vector<cluster::topic_result>>{}
+          .to(out, std::move(r.results))
+          .then([&out, &r] {
+              return async_adl<std::vector<model::topic_metadata>>{}.to(
+                out, std::move(r.metadata));
+          })
+          .then([&out, &r] {
+              return async_adl<std::vector<cluster::topic_configuration>>{}.to(
+                out, std::move(r.configs));
+          });
+    });
+}
+
+ss::future<cluster::create_topics_reply>
+async_adl<cluster::create_topics_reply>::from(iobuf_parser& in) {
+    return async_adl<std::vector<cluster::topic_result>>{}.from(in).then(
+      [&in](std::vector<cluster::topic_result> results) {
+          return async_adl<std::vector<model::topic_metadata>>{}
+            .from(in)
+            .then([&in, results = std::move(results)](
+                    std::vector<model::topic_metadata> md) mutable {
+                return async_adl<std::vector<cluster::topic_configuration>>{}
+                  .from(in)
+                  .then([results = std::move(results), md = std::move(md)](
+                          std::vector<cluster::topic_configuration>
+                            cfg) mutable {
+                      return cluster::create_topics_reply{
+                        std::move(results), std::move(md), std::move(cfg)};
+                  });
+            });
+      });
+}
+
 void adl<model::timeout_clock::duration>::to(iobuf& out, duration dur) {
     // This is a clang bug that cause ss::cpu_to_le to become ambiguous
     // because rep has type of long long
@@ -19,6 +19,7 @@
 #include "model/timeout_clock.h"
 #include "raft/types.h"
 #include "reflection/adl.h"
+#include "reflection/async_adl.h"
 #include "storage/types.h"
 #include "tristate.h"
 #include "utils/to_string.h"
@@ -37,11 +38,15 @@ using broker_ptr = ss::lw_shared_ptr<model::broker>;
 
 struct allocate_id_request {
     model::timeout_clock::duration timeout;
+    // number of consecutive ids to lease in one request
+    int64_t count{1};
 };
 
 struct allocate_id_reply {
     int64_t id;
     errc ec;
+    // the caller owns ids [id, id + range)
+    int64_t range{1};
 };
 
 /// Join request sent by node to join raft-0
@@ -120,6 +125,11 @@ struct topic_configuration {
     tristate<size_t> retention_bytes;
     tristate<std::chrono::milliseconds> retention_duration;
 
+    // Redpanda extension: ephemeral topics backed by the in-memory log.
+    // Data does not survive a restart and retention_bytes becomes the
+    // per partition memory budget.
+    bool in_memory_storage{false};
+
     friend std::ostream& operator<<(std::ostream&, const topic_configuration&);
 };
 
@@ -252,6 +262,23 @@ struct adl<cluster::create_topics_reply> {
     cluster::create_topics_reply from(iobuf);
     cluster::create_topics_reply from(iobuf_parser&);
 };
+// async variants for the topic creation types - their vectors carry one
+// entry per partition, so a 10k partition topic serialized synchronously
+// holds the reactor for the whole encode. element-wise encoding through
+// async_adl<std::vector<>> yields on preemption while keeping the wire
+// format of the adl<> specializations above
+template<>
+struct async_adl<cluster::create_topics_request> {
+    ss::future<> to(iobuf&, cluster::create_topics_request&&);
+    ss::future<cluster::create_topics_request> from(iobuf_parser&);
+};
+
+template<>
+struct async_adl<cluster::create_topics_reply> {
+    ss::future<> to(iobuf&, cluster::create_topics_reply&&);
+    ss::future<cluster::create_topics_reply> from(iobuf_parser&);
+};
+
 template<>
 struct adl<cluster::topic_configuration_assignment> {
     void to(iobuf&, cluster::topic_configuration_assignment&&);
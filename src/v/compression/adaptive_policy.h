@@ -0,0 +1,65 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace compression {
+
+/**
+ * Tracks the achieved compression ratio of a stream of payloads with an
+ * exponentially weighted moving average and answers whether compressing
+ * the next one is expected to pay for itself. Incompressible data
+ * (already compressed media, encrypted blobs) costs the full codec cpu
+ * for no size win; a holder of this policy - typically one per
+ * partition's recompression path - can skip the codec once the data has
+ * proven incompressible.
+ *
+ * The policy starts optimistic and keeps sampling after backing off:
+ * every sample_every-th payload is compressed anyway so a change to
+ * compressible data is noticed.
+ */
+class adaptive_policy {
+public:
+    /// compressed/original size above this is treated as incompressible
+    static constexpr double incompressible_ratio = 0.9;
+    /// after backing off, retry compression on every n-th payload
+    static constexpr uint32_t sample_every = 32;
+
+    bool worth_compressing() {
+        if (_ratio <= incompressible_ratio) {
+            return true;
+        }
+        return (++_skipped % sample_every) == 0;
+    }
+
+    void record(size_t bytes_in, size_t bytes_out) {
+        if (bytes_in == 0) {
+            return;
+        }
+        const double r = static_cast<double>(bytes_out)
+                         / static_cast<double>(bytes_in);
+        _ratio = (alpha * r) + ((1 - alpha) * _ratio);
+    }
+
+    double ratio() const { return _ratio; }
+
+private:
+    // weight of the newest sample; heavy enough that a handful of
+    // incompressible batches flips the policy
+    static constexpr double alpha = 0.3;
+
+    double _ratio{0.0};
+    uint32_t _skipped{0};
+};
+
+} // namespace compression
@@ -33,36 +33,62 @@ static void throw_if_error(size_t rc) {
     }
 }
 
-void stream_zstd::reset_compressor() {
-    _compress.reset(ZSTD_createCCtx());
-    if (!_compress) {
-        throw std::bad_alloc{};
-    }
-}
-stream_zstd::zstd_compress_ctx& stream_zstd::compressor() {
-    if (!_compress) {
-        reset_compressor();
+/*
+ * zstd contexts drag a sizeable workspace behind them (window, tables)
+ * and creating one per operation was the dominant cost of small
+ * compressions. a compression or decompression runs start to finish
+ * without yielding, so one per-shard (thread local) context pair can
+ * back every stream_zstd instance; the session is reset between
+ * operations while the allocated workspace is kept and regrows only
+ * when an operation actually needs more
+ */
+struct zstd_shard_workspace {
+    stream_zstd::zstd_compress_ctx compress{nullptr};
+    stream_zstd::zstd_decompress_ctx decompress{nullptr};
+    stream_zstd::stats counters;
+};
+static thread_local zstd_shard_workspace zstd_workspace;
+
+static ZSTD_CCtx* shard_compress_ctx() {
+    auto& ws = zstd_workspace;
+    if (unlikely(!ws.compress)) {
+        ws.compress.reset(ZSTD_createCCtx());
+        if (!ws.compress) {
+            throw std::bad_alloc{};
+        }
+        ++ws.counters.compress_ctx_created;
+    } else {
+        ++ws.counters.compress_ctx_reused;
     }
-    return _compress;
+    ZSTD_CCtx_reset(ws.compress.get(), ZSTD_reset_session_and_parameters);
+    return ws.compress.get();
 }
 
-void stream_zstd::reset_decompressor() {
-    _decompress.reset(ZSTD_createDCtx());
-    if (!_decompress) {
-        throw std::bad_alloc{};
+static ZSTD_DCtx* shard_decompress_ctx() {
+    auto& ws = zstd_workspace;
+    if (unlikely(!ws.decompress)) {
+        ws.decompress.reset(ZSTD_createDCtx());
+        if (!ws.decompress) {
+            throw std::bad_alloc{};
+        }
+        ++ws.counters.decompress_ctx_created;
+    } else {
+        ++ws.counters.decompress_ctx_reused;
     }
+    ZSTD_DCtx_reset(ws.decompress.get(), ZSTD_reset_session_and_parameters);
+    return ws.decompress.get();
 }
 
-stream_zstd::zstd_decompress_ctx& stream_zstd::decompressor() {
-    if (!_decompress) {
-        reset_decompressor();
-    }
-    return _decompress;
+const stream_zstd::stats& stream_zstd::shard_stats() {
+    return zstd_workspace.counters;
 }
 
 iobuf stream_zstd::do_compress(const iobuf& x) {
-    reset_compressor();
-    ZSTD_CCtx* ctx = compressor().get();
+    ZSTD_CCtx* ctx = shard_compress_ctx();
+    if (_window_log != 0) {
+        throw_if_error(
+          ZSTD_CCtx_setParameter(ctx, ZSTD_c_windowLog, _window_log));
+    }
     // NOTE: always enable content size. **decompression** depends on this
     throw_if_error(ZSTD_CCtx_setPledgedSrcSize(ctx, x.size_bytes()));
     // zstd requires linearized memory
@@ -133,8 +159,7 @@ iobuf stream_zstd::do_uncompress(const iobuf& x) {
         throw std::runtime_error(
           "Asked to stream_zstd::uncompress empty buffer");
     }
-    reset_decompressor();
-    ZSTD_DCtx* dctx = decompressor().get();
+    ZSTD_DCtx* dctx = shard_decompress_ctx();
     iobuf ret;
     ss::temporary_buffer<char> obuf(decompression_step(x));
     ZSTD_outBuffer out = {
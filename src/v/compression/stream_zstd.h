@@ -28,22 +28,33 @@ public:
       // wrap ZSTD C API
       static_sized_deleter_fn<ZSTD_DCtx, &ZSTD_freeDCtx>>;
 
+    /// reuse counters for the calling shard's shared contexts
+    struct stats {
+        uint64_t compress_ctx_created{0};
+        uint64_t compress_ctx_reused{0};
+        uint64_t decompress_ctx_created{0};
+        uint64_t decompress_ctx_reused{0};
+    };
+
+    stream_zstd() = default;
+    /// \brief window_log caps the zstd match window (and with it the
+    /// context workspace size) for compression; 0 keeps the zstd default
+    /// derived from the compression level
+    explicit stream_zstd(int window_log)
+      : _window_log(window_log) {}
+
     iobuf compress(const iobuf& b) { return do_compress(b); }
     iobuf uncompress(const iobuf& b) { return do_uncompress(b); }
     iobuf compress(iobuf&& b) { return do_compress(b); }
     iobuf uncompress(iobuf&& b) { return do_uncompress(b); }
 
+    static const stats& shard_stats();
+
 private:
     iobuf do_compress(const iobuf&);
     iobuf do_uncompress(const iobuf&);
 
-    void reset_compressor();
-    void reset_decompressor();
-    zstd_compress_ctx& compressor();
-    zstd_decompress_ctx& decompressor();
-
-    zstd_compress_ctx _compress{nullptr};
-    zstd_decompress_ctx _decompress{nullptr};
+    int _window_log{0};
 };
 
 } // namespace compression
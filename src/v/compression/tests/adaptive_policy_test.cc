@@ -0,0 +1,57 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE compression
+#include "compression/adaptive_policy.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(policy_starts_optimistic) {
+    compression::adaptive_policy p;
+    BOOST_REQUIRE(p.worth_compressing());
+}
+
+BOOST_AUTO_TEST_CASE(policy_backs_off_on_incompressible_data) {
+    compression::adaptive_policy p;
+    for (int i = 0; i < 10; ++i) {
+        p.record(1000, 995);
+    }
+    BOOST_REQUIRE(!p.worth_compressing());
+}
+
+BOOST_AUTO_TEST_CASE(policy_stays_on_for_compressible_data) {
+    compression::adaptive_policy p;
+    for (int i = 0; i < 10; ++i) {
+        p.record(1000, 300);
+    }
+    BOOST_REQUIRE(p.worth_compressing());
+}
+
+BOOST_AUTO_TEST_CASE(policy_keeps_sampling_after_backing_off) {
+    compression::adaptive_policy p;
+    for (int i = 0; i < 10; ++i) {
+        p.record(1000, 995);
+    }
+    // exactly one payload per sample_every window is still compressed
+    int sampled = 0;
+    for (uint32_t i = 0; i < 2 * compression::adaptive_policy::sample_every;
+         ++i) {
+        if (p.worth_compressing()) {
+            ++sampled;
+        }
+    }
+    BOOST_REQUIRE_EQUAL(sampled, 2);
+
+    // compressible samples bring the codec back for every payload
+    for (int i = 0; i < 10; ++i) {
+        p.record(1000, 300);
+    }
+    BOOST_REQUIRE(p.worth_compressing());
+    BOOST_REQUIRE(p.worth_compressing());
+}
@@ -0,0 +1,76 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "compression/compression.h"
+#include "random/generators.h"
+
+#include <seastar/core/reactor.hh>
+#include <seastar/testing/perf_tests.hh>
+
+// batch-shaped corpora: repetitive alphanumeric payloads compress well,
+// random bytes model already-compressed or encrypted payloads where the
+// codec runs for no size win
+
+static inline iobuf gen_compressible(const size_t data_size) {
+    const auto data = random_generators::gen_alphanum_string(512);
+    iobuf ret;
+    size_t i = data_size;
+    while (i > 0) {
+        const auto step = std::min<size_t>(i, data.size());
+        ret.append(data.data(), step);
+        i -= step;
+    }
+    return ret;
+}
+
+static inline iobuf gen_incompressible(const size_t data_size) {
+    const auto data = random_generators::get_bytes(data_size);
+    iobuf ret;
+    // NOLINTNEXTLINE
+    ret.append(reinterpret_cast<const char*>(data.data()), data.size());
+    return ret;
+}
+
+static constexpr size_t batch_size = 1 << 20;
+
+inline void
+compress_corpus(compression::type t, const iobuf& corpus) {
+    perf_tests::start_measuring_time();
+    perf_tests::do_not_optimize(compression::compressor::compress(corpus, t));
+    perf_tests::stop_measuring_time();
+}
+
+inline void
+uncompress_corpus(compression::type t, const iobuf& corpus) {
+    auto compressed = compression::compressor::compress(corpus, t);
+    perf_tests::start_measuring_time();
+    perf_tests::do_not_optimize(
+      compression::compressor::uncompress(compressed, t));
+    perf_tests::stop_measuring_time();
+}
+
+// NOLINTNEXTLINE
+#define CODEC_BENCH(name, codec)                                               \
+    PERF_TEST(name, compress_1mb) {                                            \
+        compress_corpus(codec, gen_compressible(batch_size));                  \
+    }                                                                          \
+    PERF_TEST(name, compress_1mb_random) {                                     \
+        compress_corpus(codec, gen_incompressible(batch_size));                \
+    }                                                                          \
+    PERF_TEST(name, uncompress_1mb) {                                          \
+        uncompress_corpus(codec, gen_compressible(batch_size));                \
+    }                                                                          \
+    PERF_TEST(name, uncompress_1mb_random) {                                   \
+        uncompress_corpus(codec, gen_incompressible(batch_size));              \
+    }
+
+CODEC_BENCH(codec_gzip, compression::type::gzip)
+CODEC_BENCH(codec_snappy, compression::type::snappy)
+CODEC_BENCH(codec_lz4, compression::type::lz4)
+CODEC_BENCH(codec_zstd, compression::type::zstd)
@@ -65,6 +65,46 @@ SEASTAR_THREAD_TEST_CASE(stream_zstd_test) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(stream_zstd_shard_context_reuse) {
+    const auto before = compression::stream_zstd::shard_stats();
+    compression::stream_zstd a;
+    compression::stream_zstd b;
+    iobuf src = gen(4_KiB);
+    auto c1 = a.compress(src.share(0, 4_KiB));
+    auto c2 = b.compress(src.share(0, 4_KiB));
+    auto d1 = b.uncompress(std::move(c1));
+    auto d2 = a.uncompress(std::move(c2));
+    BOOST_CHECK_EQUAL(d1, src);
+    BOOST_CHECK_EQUAL(d2, src);
+    // all four operations went through the shard contexts, and at most
+    // one context per direction was ever created on this shard
+    const auto after = compression::stream_zstd::shard_stats();
+    BOOST_CHECK_EQUAL(
+      (after.compress_ctx_created + after.compress_ctx_reused)
+        - (before.compress_ctx_created + before.compress_ctx_reused),
+      2);
+    BOOST_CHECK_EQUAL(
+      (after.decompress_ctx_created + after.decompress_ctx_reused)
+        - (before.decompress_ctx_created + before.decompress_ctx_reused),
+      2);
+    BOOST_CHECK(after.compress_ctx_reused > before.compress_ctx_reused);
+    BOOST_CHECK(after.decompress_ctx_reused > before.decompress_ctx_reused);
+    BOOST_CHECK_EQUAL(after.compress_ctx_created, 1);
+    BOOST_CHECK_EQUAL(after.decompress_ctx_created, 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(stream_zstd_capped_window) {
+    // a capped window must interoperate with a default configured reader
+    compression::stream_zstd writer(17);
+    compression::stream_zstd reader;
+    for (size_t i : sizes) {
+        iobuf buf = gen(i);
+        auto cbuf = writer.compress(buf.share(0, i));
+        auto dbuf = reader.uncompress(std::move(cbuf));
+        BOOST_CHECK_EQUAL(dbuf, buf);
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(lz4_block_tests) {
     using fn = compression::internal::lz4_frame_compressor;
     roundtrip_compression(fn::compress, fn::uncompress);
@@ -11,6 +11,7 @@
 
 #pragma once
 #include "config/validation_error.h"
+#include "json/iobuf_buffer.h"
 #include "json/json.h"
 #include "seastarx.h"
 
@@ -42,9 +43,9 @@ public:
 
     // this serializes the property value. a full configuration serialization is
     // performed in config_store::to_json where the json object key is taken
-    // from the property name.
-    virtual void
-    to_json(rapidjson::Writer<rapidjson::StringBuffer>& w) const = 0;
+    // from the property name. the writer streams into an iobuf so large
+    // config dumps never materialize a contiguous staging buffer.
+    virtual void to_json(rapidjson::Writer<json::iobuf_buffer>& w) const = 0;
 
     virtual void print(std::ostream&) const = 0;
     virtual void set_value(YAML::Node) = 0;
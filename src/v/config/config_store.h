@@ -66,7 +66,7 @@ public:
         return errors;
     }
 
-    void to_json(rapidjson::Writer<rapidjson::StringBuffer>& w) const {
+    void to_json(rapidjson::Writer<json::iobuf_buffer>& w) const {
         w.StartObject();
 
         for (const auto& [name, property] : _properties) {
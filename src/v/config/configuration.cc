@@ -67,6 +67,14 @@ configuration::configuration()
       "IpAddress and port for supervisor service",
       required::no,
       unresolved_address("127.0.0.1", 43189))
+  , coproc_supervisor_unix_socket(
+      *this,
+      "coproc_supervisor_unix_socket",
+      "Path to a unix domain socket of the supervisor service. When set it "
+      "is used instead of coproc_supervisor_server, avoiding TCP overhead "
+      "for the engine running on the same host",
+      required::no,
+      "")
   , coproc_max_inflight_bytes(
       *this,
       "coproc_max_inflight_bytes",
@@ -227,6 +235,32 @@ configuration::configuration()
       "Interaval for metadata dissemination batching",
       required::no,
       3'000ms)
+  , enable_partition_balancing(
+      *this,
+      "enable_partition_balancing",
+      "Continuously rebalance partition replicas and leadership across nodes",
+      required::no,
+      false)
+  , partition_balancer_tick_ms(
+      *this,
+      "partition_balancer_tick_ms",
+      "Interval between partition balancer passes",
+      required::no,
+      30'000ms)
+  , partition_balancer_moves_per_tick(
+      *this,
+      "partition_balancer_moves_per_tick",
+      "Maximum replica moves and leadership transfers scheduled per "
+      "balancer pass",
+      required::no,
+      2)
+  , partition_balancer_slack(
+      *this,
+      "partition_balancer_slack",
+      "Per-node partition count difference tolerated before the balancer "
+      "schedules moves",
+      required::no,
+      5)
   , fetch_reads_debounce_timeout(
       *this,
       "fetch_reads_debounce_timeout",
@@ -234,6 +268,14 @@ configuration::configuration()
       "wasn't reached",
       required::no,
       1ms)
+  , enable_follower_fetching(
+      *this,
+      "enable_follower_fetching",
+      "Allow fetch requests to be served from follower replicas. Followers "
+      "only expose offsets the leader has committed, so follower reads are "
+      "bounded-staleness by construction",
+      required::no,
+      false)
   , delete_retention_ms(
       *this,
       "delete_retention_ms",
@@ -319,6 +361,13 @@ configuration::configuration()
       "Max size of requests cached for replication",
       required::no,
       1_MiB)
+  , raft_relaxed_flush_delay_ms(
+      *this,
+      "raft_relaxed_flush_delay_ms",
+      "How long appends accepted with relaxed consistency may sit in the OS "
+      "buffer before a background flush syncs them to disk",
+      required::no,
+      100ms)
   , reclaim_min_size(
       *this,
       "reclaim_min_size",
@@ -355,6 +404,14 @@ configuration::configuration()
       "Enable pid file. You probably don't want to change this.",
       required::no,
       true)
+  , lazy_startup(
+      *this,
+      "lazy_startup",
+      "Bring up non-essential subsystems (coprocessing, archival) after the "
+      "Kafka API starts accepting, shortening the unreachable window during "
+      "a rolling restart",
+      required::no,
+      false)
   , kvstore_flush_interval(
       *this,
       "kvstore_flush_interval",
@@ -373,6 +430,20 @@ configuration::configuration()
       "Fail-safe maximum throttle delay on kafka requests",
       required::no,
       60'000ms)
+  , kafka_produce_lag_throttle_offsets(
+      *this,
+      "kafka_produce_lag_throttle_offsets",
+      "Follower replication lag, in offsets, above which produce responses "
+      "start to carry throttle time. 0 disables lag based backpressure",
+      required::no,
+      0)
+  , kafka_produce_lag_throttle_max_ms(
+      *this,
+      "kafka_produce_lag_throttle_max_ms",
+      "Throttle delay applied to producers once follower replication lag "
+      "reaches twice kafka_produce_lag_throttle_offsets",
+      required::no,
+      1'000ms)
   , raft_io_timeout_ms(
       *this, "raft_io_timeout_ms", "Raft I/O timeout", required::no, 10'000ms)
   , join_retry_timeout_ms(
@@ -435,6 +506,138 @@ configuration::configuration()
       "touching the log until the batch is exhausted.",
       required::no,
       1000)
+  , controller_log_capacity(
+      *this,
+      "controller_log_capacity",
+      "Number of controller commands accumulated in the log before the "
+      "controller state is snapshotted and the log is prefix truncated.",
+      required::no,
+      16384)
+  , controller_backend_max_concurrent_ops(
+      *this,
+      "controller_backend_max_concurrent_ops",
+      "Maximum number of partition operations executed concurrently on "
+      "each shard when reconciling topic changes",
+      required::no,
+      64)
+  , rpc_client_connections_per_peer(
+      *this,
+      "rpc_client_connections_per_peer",
+      "Number of internal RPC connections kept to each peer per shard, "
+      "raft groups are consistently hashed over them",
+      required::no,
+      4)
+  , rpc_client_flush_delay(
+      *this,
+      "rpc_client_flush_delay",
+      "Hold outgoing internal RPC writes for up to this many microseconds "
+      "while the connection is idle so closely spaced requests coalesce "
+      "into fewer packets, 0 flushes immediately",
+      required::no,
+      std::chrono::microseconds(0))
+  , raft_transport_compression(
+      *this,
+      "raft_transport_compression",
+      "Compress raft append entries and snapshot chunks with zstd before "
+      "sending them to peers, votes and heartbeats are never compressed",
+      required::no,
+      false)
+  , storage_attribution_sampling(
+      *this,
+      "storage_attribution_sampling",
+      "Record per-partition I/O attribution samples (bytes, batches, append "
+      "latency) dumped via the admin API, at most one sample per partition "
+      "per second. High cardinality, disabled by default",
+      required::no,
+      false)
+  , latency_trace_sampling_rate(
+      *this,
+      "latency_trace_sampling_rate",
+      "Trace one in this many produce/fetch requests through their "
+      "processing stages, dumped via the admin API. 0 disables tracing",
+      required::no,
+      0)
+  , mutex_contention_sampling_rate(
+      *this,
+      "mutex_contention_sampling_rate",
+      "Time one in this many blocking acquisitions of named mutexes into "
+      "per-mutex wait histograms, exported as metrics and ranked via the "
+      "admin API. 0 disables sampling",
+      required::no,
+      0)
+  , archival_storage_enabled(
+      *this,
+      "archival_storage_enabled",
+      "Serve reads below the local log start from segments archived to S3 "
+      "by external tooling",
+      required::no,
+      false)
+  , archival_storage_s3_access_key(
+      *this,
+      "archival_storage_s3_access_key",
+      "AWS access key used to read archived segments",
+      required::no,
+      std::nullopt)
+  , archival_storage_s3_secret_key(
+      *this,
+      "archival_storage_s3_secret_key",
+      "AWS secret key used to read archived segments",
+      required::no,
+      std::nullopt)
+  , archival_storage_s3_region(
+      *this,
+      "archival_storage_s3_region",
+      "AWS region that hosts the archival bucket",
+      required::no,
+      std::nullopt)
+  , archival_storage_s3_bucket(
+      *this,
+      "archival_storage_s3_bucket",
+      "S3 bucket that holds archived segments",
+      required::no,
+      std::nullopt)
+  , archival_storage_cache_directory(
+      *this,
+      "archival_storage_cache_directory",
+      "Directory for the local cache of hydrated archived segments. "
+      "Defaults to 'archival_cache' under the data directory",
+      required::no,
+      std::nullopt)
+  , archival_storage_cache_max_bytes(
+      *this,
+      "archival_storage_cache_max_bytes",
+      "Disk budget for the local cache of hydrated archived segments, "
+      "split evenly across shards",
+      required::no,
+      20_GiB)
+  , background_bandwidth(
+      *this,
+      "background_bandwidth",
+      "Node-wide cap on all throttled background I/O in bytes/sec, split "
+      "evenly across shards. 0 disables the cap",
+      required::no,
+      0)
+  , raft_recovery_bandwidth(
+      *this,
+      "raft_recovery_bandwidth",
+      "Node-wide read bandwidth for raft follower recovery in bytes/sec, "
+      "split evenly across shards. 0 disables the throttle",
+      required::no,
+      0)
+  , compaction_bandwidth(
+      *this,
+      "compaction_bandwidth",
+      "Node-wide bandwidth for log compaction in bytes/sec, split evenly "
+      "across shards. 0 disables the throttle",
+      required::no,
+      0)
+  , archival_fetch_bandwidth(
+      *this,
+      "archival_fetch_bandwidth",
+      "Node-wide download bandwidth for hydrating archived segments in "
+      "bytes/sec, split evenly across shards. 0 disables the throttle",
+      required::no,
+      0)
   , _advertised_kafka_api(
       *this,
       "advertised_kafka_api",
@@ -43,6 +43,7 @@ struct configuration final : public config_store {
     property<bool> enable_coproc;
     property<unresolved_address> coproc_script_manager_server;
     property<unresolved_address> coproc_supervisor_server;
+    property<ss::sstring> coproc_supervisor_unix_socket;
     property<std::size_t> coproc_max_inflight_bytes;
     property<std::size_t> coproc_max_ingest_bytes;
     property<std::size_t> coproc_max_batch_size;
@@ -74,7 +75,12 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> group_initial_rebalance_delay;
     property<std::chrono::milliseconds> group_new_member_join_timeout;
     property<std::chrono::milliseconds> metadata_dissemination_interval_ms;
+    property<bool> enable_partition_balancing;
+    property<std::chrono::milliseconds> partition_balancer_tick_ms;
+    property<size_t> partition_balancer_moves_per_tick;
+    property<size_t> partition_balancer_slack;
     property<std::chrono::milliseconds> fetch_reads_debounce_timeout;
+    property<bool> enable_follower_fetching;
     // same as delete.retention.ms in kafka
     property<std::chrono::milliseconds> delete_retention_ms;
     property<std::chrono::milliseconds> log_compaction_interval_ms;
@@ -91,6 +97,7 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> replicate_append_timeout_ms;
     property<std::chrono::milliseconds> recovery_append_timeout_ms;
     property<size_t> raft_replicate_batch_window_size;
+    property<std::chrono::milliseconds> raft_relaxed_flush_delay_ms;
 
     property<size_t> reclaim_min_size;
     property<size_t> reclaim_max_size;
@@ -98,9 +105,12 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> reclaim_stable_window;
     property<bool> auto_create_topics_enabled;
     property<bool> enable_pid_file;
+    property<bool> lazy_startup;
     property<std::chrono::milliseconds> kvstore_flush_interval;
     property<size_t> kvstore_max_segment_size;
     property<std::chrono::milliseconds> max_kafka_throttle_delay_ms;
+    property<int64_t> kafka_produce_lag_throttle_offsets;
+    property<std::chrono::milliseconds> kafka_produce_lag_throttle_max_ms;
     property<std::chrono::milliseconds> raft_io_timeout_ms;
     property<std::chrono::milliseconds> join_retry_timeout_ms;
     property<std::chrono::milliseconds> raft_timeout_now_timeout_ms;
@@ -112,6 +122,26 @@ struct configuration final : public config_store {
     property<size_t> max_compacted_log_segment_size;
     property<int16_t> id_allocator_log_capacity;
     property<int16_t> id_allocator_batch_size;
+    property<size_t> controller_log_capacity;
+    property<size_t> controller_backend_max_concurrent_ops;
+    property<size_t> rpc_client_connections_per_peer;
+    property<std::chrono::microseconds> rpc_client_flush_delay;
+    property<bool> raft_transport_compression;
+    property<bool> storage_attribution_sampling;
+    property<uint32_t> latency_trace_sampling_rate;
+    property<uint32_t> mutex_contention_sampling_rate;
+    // Archival
+    property<bool> archival_storage_enabled;
+    property<std::optional<ss::sstring>> archival_storage_s3_access_key;
+    property<std::optional<ss::sstring>> archival_storage_s3_secret_key;
+    property<std::optional<ss::sstring>> archival_storage_s3_region;
+    property<std::optional<ss::sstring>> archival_storage_s3_bucket;
+    property<std::optional<ss::sstring>> archival_storage_cache_directory;
+    property<size_t> archival_storage_cache_max_bytes;
+    property<size_t> background_bandwidth;
+    property<size_t> raft_recovery_bandwidth;
+    property<size_t> compaction_bandwidth;
+    property<size_t> archival_fetch_bandwidth;
 
     configuration();
 
@@ -262,6 +292,23 @@ struct convert<std::chrono::milliseconds> {
     }
 };
 
+template<>
+struct convert<std::chrono::microseconds> {
+    using type = std::chrono::microseconds;
+
+    static Node encode(const type& rhs) { return Node(rhs.count()); }
+
+    static bool decode(const Node& node, type& rhs) {
+        type::rep us;
+        auto res = convert<type::rep>::decode(node, us);
+        if (!res) {
+            return res;
+        }
+        rhs = std::chrono::microseconds(us);
+        return true;
+    }
+};
+
 inline ss::sstring to_absolute(const ss::sstring& path) {
     namespace fs = boost::filesystem;
     if (path.empty()) {
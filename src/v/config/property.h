@@ -19,8 +19,15 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <algorithm>
+#include <optional>
+#include <vector>
+
 namespace config {
 
+template<class T>
+class binding;
+
 template<class T>
 class property : public base_property {
 public:
@@ -53,7 +60,7 @@ public:
     // serialize the value. the key is taken from the property name at the
     // serialization point in config_store::to_json to avoid users from being
     // forced to consume the property as a json object.
-    void to_json(rapidjson::Writer<rapidjson::StringBuffer>& w) const override {
+    void to_json(rapidjson::Writer<json::iobuf_buffer>& w) const override {
         json::rjson_serialize(w, _value);
     }
 
@@ -65,31 +72,123 @@ public:
     }
 
     void set_value(std::any v) override {
-        _value = std::any_cast<T>(std::move(v));
+        update_value(std::any_cast<T>(std::move(v)));
     }
 
-    void set_value(YAML::Node n) override { _value = std::move(n.as<T>()); }
+    void set_value(YAML::Node n) override { update_value(n.as<T>()); }
 
     property<T>& operator()(T v) {
-        _value = std::move(v);
+        update_value(std::move(v));
         return *this;
     }
 
     base_property& operator=(const base_property& pr) override {
-        _value = dynamic_cast<const property<T>&>(pr)._value;
+        update_value(T(dynamic_cast<const property<T>&>(pr)._value));
         return *this;
     }
 
+    /// Returns a binding which holds a live copy of the property value.
+    /// Reading a binding is a plain member load, so hot paths avoid going
+    /// through the configuration store on every request while still
+    /// observing runtime changes to the property.
+    binding<T> bind() { return binding<T>(*this); }
+
+    ~property() override {
+        for (auto* b : _bindings) {
+            b->_parent = nullptr;
+        }
+    }
+
 protected:
+    void update_value(T new_value) {
+        _value = std::move(new_value);
+        for (auto* b : _bindings) {
+            b->update(_value);
+        }
+    }
+
     T _value;
 
 private:
+    friend class binding<T>;
+
     validator _validator;
+    // bindings register/deregister themselves as they are created,
+    // moved and destroyed
+    std::vector<binding<T>*> _bindings;
     constexpr static auto noop_validator = [](const auto&) {
         return std::nullopt;
     };
 };
 
+/**
+ * A binding is a copy of a property value that the property keeps up to
+ * date for as long as the binding is alive. It is intended for consumers
+ * that read configuration on a hot path: materialize the binding once,
+ * then read it like a plain member. An optional watch callback fires
+ * after the value changed, for consumers that need to react rather than
+ * just observe the new value on the next read.
+ */
+template<class T>
+class binding {
+public:
+    binding(const binding&) = delete;
+    binding& operator=(const binding&) = delete;
+
+    binding(binding&& other) noexcept
+      : _parent(other._parent)
+      , _value(std::move(other._value))
+      , _on_change(std::move(other._on_change)) {
+        if (_parent) {
+            std::replace(
+              _parent->_bindings.begin(),
+              _parent->_bindings.end(),
+              &other,
+              this);
+            other._parent = nullptr;
+        }
+    }
+    binding& operator=(binding&&) = delete;
+
+    ~binding() {
+        if (_parent) {
+            auto& bindings = _parent->_bindings;
+            bindings.erase(
+              std::remove(bindings.begin(), bindings.end(), this),
+              bindings.end());
+        }
+    }
+
+    const T& value() const { return _value; }
+    const T& operator()() const { return value(); }
+
+    void watch(ss::noncopyable_function<void()> f) {
+        _on_change = std::move(f);
+    }
+
+private:
+    friend class property<T>;
+
+    explicit binding(property<T>& parent)
+      : _parent(&parent)
+      , _value(parent.value()) {
+        parent._bindings.push_back(this);
+    }
+
+    void update(const T& v) {
+        _value = v;
+        if (_on_change) {
+            (*_on_change)();
+        }
+    }
+
+    // set to nullptr when the property (or this binding, on move-from)
+    // goes away first
+    property<T>* _parent;
+    T _value;
+    std::optional<ss::noncopyable_function<void()>> _on_change;
+};
+
 /*
  * Same as property<std::vector<T>> but will also decode a single T. This can be
  * useful for dealing with backwards compatibility or creating easier yaml
@@ -109,7 +208,7 @@ public:
         } else {
             value.push_back(std::move(n.as<T>()));
         }
-        this->_value = std::move(value);
+        this->update_value(std::move(value));
     }
 };
 
@@ -12,7 +12,7 @@
 namespace json {
 
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w,
+  rapidjson::Writer<json::iobuf_buffer>& w,
   const config::data_directory_path& v) {
     w.StartObject();
 
@@ -23,7 +23,7 @@ void rjson_serialize(
 }
 
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const config::seed_server& v) {
+  rapidjson::Writer<json::iobuf_buffer>& w, const config::seed_server& v) {
     w.StartObject();
     w.Key("node_id");
     rjson_serialize(w, v.id());
@@ -34,7 +34,7 @@ void rjson_serialize(
 }
 
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const config::key_cert& v) {
+  rapidjson::Writer<json::iobuf_buffer>& w, const config::key_cert& v) {
     w.StartObject();
     w.Key("key_file");
     w.String(v.key_file.c_str());
@@ -45,7 +45,7 @@ void rjson_serialize(
 }
 
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const config::tls_config& v) {
+  rapidjson::Writer<json::iobuf_buffer>& w, const config::tls_config& v) {
     w.StartObject();
     w.Key("enabled");
     w.Bool(v.is_enabled());
@@ -67,7 +67,7 @@ void rjson_serialize(
 }
 
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w,
+  rapidjson::Writer<json::iobuf_buffer>& w,
   const std::vector<config::seed_server>& v) {
     w.StartArray();
     for (const auto& e : v) {
@@ -77,7 +77,7 @@ void rjson_serialize(
 }
 
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const custom_aggregate& v) {
+  rapidjson::Writer<json::iobuf_buffer>& w, const custom_aggregate& v) {
     w.StartObject();
 
     w.Key("string_value");
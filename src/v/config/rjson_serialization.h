@@ -15,6 +15,7 @@
 #include "config/seed_server.h"
 #include "config/tests/custom_aggregate.h"
 #include "config/tls_config.h"
+#include "json/iobuf_buffer.h"
 #include "json/json.h"
 #include "seastarx.h"
 
@@ -26,23 +27,23 @@
 namespace json {
 
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w,
+  rapidjson::Writer<json::iobuf_buffer>& w,
   const config::data_directory_path& v);
 
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const config::seed_server& v);
+  rapidjson::Writer<json::iobuf_buffer>& w, const config::seed_server& v);
 
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const config::key_cert& v);
+  rapidjson::Writer<json::iobuf_buffer>& w, const config::key_cert& v);
 
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const config::tls_config& v);
+  rapidjson::Writer<json::iobuf_buffer>& w, const config::tls_config& v);
 
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w,
+  rapidjson::Writer<json::iobuf_buffer>& w,
   const std::vector<config::seed_server>& v);
 
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const custom_aggregate& v);
+  rapidjson::Writer<json::iobuf_buffer>& w, const custom_aggregate& v);
 
 } // namespace json
\ No newline at end of file
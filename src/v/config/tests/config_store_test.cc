@@ -7,6 +7,7 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "bytes/bytes.h"
 #include "config/config_store.h"
 
 #include <seastar/core/thread.hh>
@@ -172,15 +173,19 @@ SEASTAR_THREAD_TEST_CASE(config_json_serialization) {
                                   "\"required_string\": \"test_value_2\""
                                   "}";
 
-    // cfg -> json string
-    rapidjson::StringBuffer cfg_sb;
-    rapidjson::Writer<rapidjson::StringBuffer> cfg_writer(cfg_sb);
+    // cfg -> json iobuf, linearized only for parsing back
+    iobuf cfg_buf;
+    json::iobuf_buffer cfg_ib(cfg_buf);
+    rapidjson::Writer<json::iobuf_buffer> cfg_writer(cfg_ib);
     cfg.to_json(cfg_writer);
-    auto jstr = cfg_sb.GetString();
+    cfg_ib.Flush();
+    auto cfg_bytes = iobuf_to_bytes(cfg_buf);
+    std::string jstr(
+      reinterpret_cast<const char*>(cfg_bytes.data()), cfg_bytes.size());
 
     // json string -> rapidjson doc
     rapidjson::Document res_doc;
-    res_doc.Parse(jstr);
+    res_doc.Parse(jstr.data(), jstr.size());
 
     // json string -> rapidjson doc
     rapidjson::Document exp_doc;
@@ -214,3 +219,31 @@ SEASTAR_THREAD_TEST_CASE(config_json_serialization) {
 
     BOOST_TEST(res_doc["strings"].IsArray());
 }
+
+SEASTAR_THREAD_TEST_CASE(property_bind) {
+    auto cfg = test_config();
+    cfg.read_yaml(minimal_valid_configuration());
+
+    auto int_binding = cfg.optional_int.bind();
+    BOOST_TEST(int_binding() == 100);
+
+    // bindings observe every mutation path of the property
+    cfg.optional_int.set_value(std::any(42));
+    BOOST_TEST(int_binding() == 42);
+    cfg.optional_int(7);
+    BOOST_TEST(int_binding() == 7);
+
+    // watch callbacks fire after the new value is visible
+    int watch_count = 0;
+    int_binding.watch([&int_binding, &watch_count] {
+        ++watch_count;
+        BOOST_TEST(int_binding() == 11);
+    });
+    cfg.optional_int(11);
+    BOOST_TEST(watch_count == 1);
+
+    // moved-from bindings detach, the moved-to binding keeps tracking
+    auto moved_binding = std::move(int_binding);
+    cfg.optional_int(13);
+    BOOST_TEST(moved_binding() == 13);
+}
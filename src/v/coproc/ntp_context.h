@@ -34,15 +34,58 @@ struct ntp_context {
         model::offset last_acked{model::model_limits<model::offset>::min()};
     };
 
+    /// The most recently read window of batches. Scripts subscribed to
+    /// the same input ntp usually advance in lockstep, so one storage
+    /// read is fanned out to all of them: whoever reads first saves the
+    /// window and the others are served shared copies (the underlying
+    /// record data iobufs are refcounted, not duplicated).
+    struct read_window {
+        model::offset start;
+        model::record_batch_reader::data_t batches;
+    };
+
     explicit ntp_context(storage::log lg)
       : log(std::move(lg)) {}
 
     const model::ntp& ntp() const { return log.config().ntp(); }
 
+    /// Get a shared copy of the cached window if it begins at the given
+    /// offset, std::nullopt means the caller has to read from storage
+    std::optional<model::record_batch_reader::data_t>
+    share_window(model::offset start) {
+        if (!window || window->start != start) {
+            return std::nullopt;
+        }
+        model::record_batch_reader::data_t shared;
+        shared.reserve(window->batches.size());
+        for (auto& b : window->batches) {
+            shared.push_back(b.share());
+        }
+        return shared;
+    }
+
+    /// Remember the window a script just read so that other scripts at
+    /// the same offset skip the storage read. Only the latest window is
+    /// kept, bounding the cache to one read's worth of data per ntp.
+    void save_window(
+      model::offset start, model::record_batch_reader::data_t& batches) {
+        if (batches.empty()) {
+            return;
+        }
+        read_window w{.start = start, .batches = {}};
+        w.batches.reserve(batches.size());
+        for (auto& b : batches) {
+            w.batches.push_back(b.share());
+        }
+        window = std::move(w);
+    }
+
     /// Reference to the storage layer for reading from the input ntp
     storage::log log;
     /// Interested scripts write their last read offset of the input ntp
     absl::btree_map<script_id, offset_pair> offsets;
+    /// Latest read window, shared across subscribed scripts
+    std::optional<read_window> window;
 };
 
 using ntp_context_cache
@@ -222,12 +222,27 @@ script_context::read_ntp(ss::lw_shared_ptr<ntp_context> ntp_ctx) {
               return ss::make_ready_future<
                 std::optional<process_batch_request::data>>(std::nullopt);
           }
+          /// Another script at the same offset may have read this window
+          /// already, in which case a shared copy is served and the
+          /// storage read is skipped entirely
+          if (auto shared = ntp_ctx->share_window(cfg->start_offset)) {
+              auto obatch_info = extract_batch_info(std::move(*shared));
+              ntp_ctx->offsets[_id].last_read = obatch_info->last;
+              return ss::make_ready_future<
+                std::optional<process_batch_request::data>>(
+                process_batch_request::data{
+                  .ids = std::vector<script_id>{_id},
+                  .ntp = ntp_ctx->ntp(),
+                  .reader = std::move(obatch_info->rbr)});
+          }
           return ntp_ctx->log.make_reader(*cfg)
             .then([](model::record_batch_reader rbr) {
                 return model::consume_reader_to_memory(
                   std::move(rbr), model::no_timeout);
             })
-            .then([](model::record_batch_reader::data_t data) {
+            .then([ntp_ctx, start = cfg->start_offset](
+                    model::record_batch_reader::data_t data) {
+                ntp_ctx->save_window(start, data);
                 return extract_batch_info(std::move(data));
             })
             .then(
@@ -0,0 +1,53 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "coproc/ntp_context.h"
+#include "model/fundamental.h"
+#include "storage/tests/utils/disk_log_builder.h"
+#include "storage/tests/utils/random_batch.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+SEASTAR_THREAD_TEST_CASE(shared_read_window_fan_out) {
+    storage::disk_log_builder b;
+    b.start().get();
+    coproc::ntp_context ctx(b.get_log());
+
+    /// nothing cached yet
+    BOOST_REQUIRE(!ctx.share_window(model::offset(0)));
+
+    auto batches = storage::test::make_random_batches(model::offset(0), 3);
+    const auto last = batches.back().last_offset();
+    ctx.save_window(model::offset(0), batches);
+
+    /// a script at the same offset gets a shared copy
+    auto shared = ctx.share_window(model::offset(0));
+    BOOST_REQUIRE(shared);
+    BOOST_REQUIRE_EQUAL(shared->size(), 3);
+    BOOST_REQUIRE_EQUAL(shared->back().last_offset(), last);
+
+    /// sharing doesn't consume the window
+    BOOST_REQUIRE(ctx.share_window(model::offset(0)));
+
+    /// a script at a different offset has to read storage itself
+    BOOST_REQUIRE(!ctx.share_window(model::offset(1)));
+
+    /// only the latest window is retained
+    auto next = storage::test::make_random_batches(last + model::offset(1), 2);
+    ctx.save_window(last + model::offset(1), next);
+    BOOST_REQUIRE(!ctx.share_window(model::offset(0)));
+    BOOST_REQUIRE(ctx.share_window(last + model::offset(1)));
+
+    /// empty reads are not cached
+    model::record_batch_reader::data_t empty;
+    ctx.save_window(model::offset(100), empty);
+    BOOST_REQUIRE(!ctx.share_window(model::offset(100)));
+
+    b.stop().get();
+}
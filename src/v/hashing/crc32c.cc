@@ -0,0 +1,93 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "hashing/crc32c.h"
+
+#include <array>
+
+/*
+ * crc combine math, following zlib's crc32_combine with the polynomial
+ * swapped for the reflected Castagnoli polynomial used by crc32c.
+ *
+ * A crc is a linear function of the message over GF(2), so appending
+ * chunk_size zero bytes to a crc is a multiplication by the 32x32 bit
+ * matrix representing x^(8 * chunk_size) mod P. The matrix for any chunk
+ * size is built in O(log(chunk_size)) squarings of the matrix for one
+ * zero bit; the pre/post conditioning of the two crcs cancels under the
+ * final xor.
+ */
+
+namespace {
+
+// reflected CRC-32C (Castagnoli) polynomial
+constexpr uint32_t crc32c_poly = 0x82f63b78;
+
+using gf2_matrix = std::array<uint32_t, 32>;
+
+uint32_t gf2_matrix_times(const gf2_matrix& mat, uint32_t vec) {
+    uint32_t sum = 0;
+    size_t i = 0;
+    while (vec) {
+        if (vec & 1U) {
+            sum ^= mat[i];
+        }
+        vec >>= 1U;
+        ++i;
+    }
+    return sum;
+}
+
+void gf2_matrix_square(gf2_matrix& square, const gf2_matrix& mat) {
+    for (size_t n = 0; n < square.size(); ++n) {
+        square[n] = gf2_matrix_times(mat, mat[n]);
+    }
+}
+
+} // namespace
+
+uint32_t crc32::combine(uint32_t crc, uint32_t chunk_crc, size_t chunk_size) {
+    if (chunk_size == 0) {
+        return crc;
+    }
+
+    gf2_matrix even;
+    gf2_matrix odd;
+
+    // operator for one zero bit: the polynomial, then powers of two
+    odd[0] = crc32c_poly;
+    uint32_t row = 1;
+    for (size_t n = 1; n < odd.size(); ++n) {
+        odd[n] = row;
+        row <<= 1U;
+    }
+
+    // square to the operators for two and four zero bits
+    gf2_matrix_square(even, odd);
+    gf2_matrix_square(odd, even);
+
+    // apply chunk_size zero bytes to crc, squaring the operator for each
+    // bit of the length
+    do {
+        gf2_matrix_square(even, odd);
+        if (chunk_size & 1U) {
+            crc = gf2_matrix_times(even, crc);
+        }
+        chunk_size >>= 1U;
+        if (chunk_size == 0) {
+            break;
+        }
+        gf2_matrix_square(odd, even);
+        if (chunk_size & 1U) {
+            crc = gf2_matrix_times(odd, crc);
+        }
+        chunk_size >>= 1U;
+    } while (chunk_size != 0);
+
+    return crc ^ chunk_crc;
+}
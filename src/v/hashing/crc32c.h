@@ -12,6 +12,8 @@
 #pragma once
 #include <crc32c/crc32c.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 class crc32 {
@@ -33,6 +35,19 @@ public:
 
     uint32_t value() const { return _crc; }
 
+    /**
+     * Merges the crc of a chunk that follows this one in the byte stream,
+     * as if this crc had been extended over the chunk's bytes directly.
+     * The chunk's crc must have been computed from the default seed. The
+     * merge is O(log(chunk_size)) carry-less matrix math, so independently
+     * computed chunk crcs can be stitched together in any reduction order.
+     */
+    static uint32_t combine(uint32_t crc, uint32_t chunk_crc, size_t chunk_size);
+
+    void combine(const crc32& chunk, size_t chunk_size) {
+        _crc = combine(_crc, chunk.value(), chunk_size);
+    }
+
 private:
     uint32_t _crc = 0;
 };
@@ -0,0 +1,62 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE crc32c
+#include "hashing/crc32c.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <numeric>
+#include <vector>
+
+static std::vector<uint8_t> make_data(size_t size) {
+    std::vector<uint8_t> data(size);
+    std::iota(data.begin(), data.end(), 0);
+    return data;
+}
+
+static uint32_t crc_of(const uint8_t* data, size_t size) {
+    crc32 crc;
+    crc.extend(data, size);
+    return crc.value();
+}
+
+BOOST_AUTO_TEST_CASE(combine_matches_single_stream) {
+    const auto data = make_data(4096);
+    const auto expected = crc_of(data.data(), data.size());
+    for (size_t split : {size_t(1), size_t(37), size_t(2048), size_t(4095)}) {
+        const auto first = crc_of(data.data(), split);
+        const auto second = crc_of(data.data() + split, data.size() - split);
+        BOOST_CHECK_EQUAL(
+          crc32::combine(first, second, data.size() - split), expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(combine_empty_chunk_is_identity) {
+    const auto data = make_data(128);
+    const auto crc = crc_of(data.data(), data.size());
+    BOOST_CHECK_EQUAL(crc32::combine(crc, 0, 0), crc);
+}
+
+BOOST_AUTO_TEST_CASE(combine_many_lanes) {
+    const auto data = make_data(1 << 16);
+    const auto expected = crc_of(data.data(), data.size());
+    constexpr size_t lanes = 7;
+    const size_t lane_size = data.size() / lanes;
+    crc32 crc;
+    size_t pos = 0;
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        const size_t size = lane == lanes - 1 ? data.size() - pos : lane_size;
+        crc32 lane_crc;
+        lane_crc.extend(data.data() + pos, size);
+        crc.combine(lane_crc, size);
+        pos += size;
+    }
+    BOOST_CHECK_EQUAL(crc.value(), expected);
+}
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "bytes/iobuf.h"
 #include "seastarx.h"
 
 #include <cstdint>
@@ -41,6 +42,14 @@ public:
     // string override
     void update(std::string_view str) { update(str.data(), str.size()); }
 
+    // iobuf override - hashes fragment by fragment without flattening;
+    // the digest only depends on the byte sequence, not fragmentation
+    void update(const iobuf& b) {
+        for (const auto& f : b) {
+            update(f.get(), f.size());
+        }
+    }
+
     // named type override
     template<
       typename T,
@@ -30,7 +30,17 @@ void chunked_encoder::append_chunk_body(
     for (const auto& buf : header) {
         seq.append(static_cast<const uint8_t*>(buf.data()), buf.size());
     }
-    seq.append(std::move(payload));
+    /*
+     * splice the payload into the output as a standalone full fragment. a
+     * plain append would pack the bytes into the output's spare capacity,
+     * copying every payload between the segment read and the socket; only
+     * the small header and trailer bytes are materialized here while the
+     * body fragments stay shared with the input.
+     */
+    auto frag = new iobuf::fragment( // NOLINT
+      std::move(payload),
+      iobuf::fragment::full{});
+    seq.append_take_ownership(frag);
     boost::beast::http::chunk_crlf crlf;
     for (const auto& buf : crlf) {
         seq.append(static_cast<const uint8_t*>(buf.data()), buf.size());
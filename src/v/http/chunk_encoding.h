@@ -29,11 +29,12 @@ public:
       bool bypass, size_t max_chunk_size = default_chunk_size);
 
     /// Transform single buffer into a series of chunks represented
-    /// as an iobuf.
+    /// as an iobuf. The payload is shared into the output, not copied.
     iobuf encode(ss::temporary_buffer<char>&& buf) const;
 
     /// Transform an iobuf into a series of chunks represented
-    /// as another iobuf.
+    /// as another iobuf. Payload fragments are shared with the input,
+    /// so encoding costs only the per-chunk header and trailer bytes.
     iobuf encode(iobuf&& inp);
 
     /// Put zero size chunk header to indicate EOF
@@ -9,7 +9,6 @@
 
 #include "http/client.h"
 
-#include "bytes/details/io_iterator_consumer.h"
 #include "bytes/iobuf.h"
 
 #include <seastar/core/condition-variable.hh>
@@ -257,22 +256,6 @@ bool client::request_stream::is_done() { return _serializer.is_done(); }
 // Wait until remaining data will be transmitted
 ss::future<> client::request_stream::send_eof() { return _gate.close(); }
 
-static ss::temporary_buffer<char> iobuf_as_tmpbuf(iobuf&& buf) {
-    if (buf.begin() == buf.end()) {
-        // empty buf
-        return ss::temporary_buffer<char>();
-    }
-    auto full_size_bytes = buf.size_bytes();
-    if (auto it = buf.begin(); full_size_bytes == it->size()) {
-        // fast path
-        return std::move(*it).release();
-    }
-    // linearize the iobuf
-    auto consumer = iobuf::iterator_consumer(buf.begin(), buf.end());
-    ss::temporary_buffer<char> res(full_size_bytes);
-    consumer.consume_to(full_size_bytes, res.get_write());
-    return res;
-}
 /// Represents response body as a data source for ss::input_stream
 struct response_data_source final : ss::data_source_impl {
     explicit response_data_source(client::response_stream_ref resp)
@@ -286,39 +269,37 @@ struct response_data_source final : ss::data_source_impl {
         return get();
     }
     ss::future<ss::temporary_buffer<char>> get() final {
-        return ss::do_with(
-          ss::temporary_buffer<char>(),
-          [this](ss::temporary_buffer<char>& result) {
-              return ss::repeat([this, &result] {
-                         if (_done || _io->is_done()) {
-                             return ss::make_ready_future<ss::stop_iteration>(
-                               ss::stop_iteration::yes);
-                         }
-                         return _io->recv_some().then([this, &result](
-                                                        iobuf&& bufseq) {
-                             if (_skip) {
-                                 auto n = std::min(bufseq.size_bytes(), _skip);
-                                 bufseq.trim_front(n);
-                                 _skip -= n;
-                             }
-                             if (bufseq.begin() == bufseq.end()) {
-                                 return ss::make_ready_future<
-                                   ss::stop_iteration>(
-                                   _io->is_done() ? ss::stop_iteration::yes
-                                                  : ss::stop_iteration::no);
-                             }
-                             result = iobuf_as_tmpbuf(std::move(bufseq));
-                             return ss::make_ready_future<ss::stop_iteration>(
-                               ss::stop_iteration::yes);
-                         });
-                     })
-                .then([&result] {
-                    return ss::make_ready_future<ss::temporary_buffer<char>>(
-                      std::move(result));
-                });
+        // the body is yielded one fragment at a time instead of being
+        // linearized into a single temporary_buffer: a multi-fragment
+        // receive would otherwise be copied into a fresh allocation just
+        // to satisfy the data_source interface
+        return ss::repeat([this] {
+                   if (!_pending.empty() || _done || _io->is_done()) {
+                       return ss::make_ready_future<ss::stop_iteration>(
+                         ss::stop_iteration::yes);
+                   }
+                   return _io->recv_some().then([this](iobuf&& bufseq) {
+                       if (_skip) {
+                           auto n = std::min(bufseq.size_bytes(), _skip);
+                           bufseq.trim_front(n);
+                           _skip -= n;
+                       }
+                       _pending.append(std::move(bufseq));
+                       return ss::stop_iteration::no;
+                   });
+               })
+          .then([this] {
+              if (_pending.empty()) {
+                  return ss::make_ready_future<ss::temporary_buffer<char>>();
+              }
+              auto buf = std::move(*_pending.begin()).release();
+              _pending.pop_front();
+              return ss::make_ready_future<ss::temporary_buffer<char>>(
+                std::move(buf));
           });
     }
     client::response_stream_ref _io;
+    iobuf _pending;
     size_t _skip{0};
     bool _done{false};
 };
@@ -348,13 +329,29 @@ ss::future<client::response_stream_ref> client::request(
     return make_request(std::move(header))
       .then([&input](request_response_t reqresp) mutable {
           auto [request, response] = std::move(reqresp);
-          auto fsend = ss::do_with(
-            request->as_output_stream(),
-            [&input](ss::output_stream<char>& output) {
-                return ss::copy(input, output).then([&output] {
-                    return output.close();
-                });
-            });
+          // Feed input buffers straight into the request: send_some takes
+          // ownership of every temporary_buffer, so body fragments flow
+          // from the input to the socket without the buffering copy an
+          // intermediate output_stream stage would add.
+          auto fsend
+            = ss::repeat(
+                [request = request, &input] {
+                    return input.read().then(
+                      [request](ss::temporary_buffer<char> buf) {
+                          if (buf.empty()) {
+                              return ss::make_ready_future<ss::stop_iteration>(
+                                ss::stop_iteration::yes);
+                          }
+                          return request->send_some(std::move(buf)).then([] {
+                              return ss::stop_iteration::no;
+                          });
+                      });
+                })
+                .then([request = request] {
+                    // flushes the header if the body turned out to be empty
+                    return request->send_some(iobuf());
+                })
+                .then([request = request] { return request->send_eof(); });
           return fsend.then([response = response]() {
               return ss::make_ready_future<response_stream_ref>(response);
           });
@@ -0,0 +1,119 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "http/client_pool.h"
+
+#include "http/logger.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/future-util.hh>
+
+#include <algorithm>
+
+namespace http {
+
+client_pool::connection&
+client_pool::connection::operator=(connection&& o) noexcept {
+    if (this != &o) {
+        release();
+        _pool = std::exchange(o._pool, nullptr);
+        _client = std::move(o._client);
+        _failed = o._failed;
+    }
+    return *this;
+}
+
+void client_pool::connection::release() noexcept {
+    if (_pool == nullptr) {
+        return;
+    }
+    _pool->put(std::move(_client), _failed);
+    _pool = nullptr;
+}
+
+client_pool::client_pool(
+  rpc::base_transport::configuration cfg,
+  size_t max_idle,
+  ss::lowres_clock::duration idle_timeout)
+  : _config(std::move(cfg))
+  , _max_idle(max_idle)
+  , _idle_timeout(idle_timeout)
+  , _reaper([this] { reap_idle(); }) {}
+
+client_pool::connection client_pool::acquire() {
+    if (!_idle.empty()) {
+        auto conn = std::move(_idle.back().conn);
+        _idle.pop_back();
+        _stats.connections_reused++;
+        return connection(this, std::move(conn));
+    }
+    _stats.connections_created++;
+    return connection(this, std::make_unique<client>(_config));
+}
+
+void client_pool::put(std::unique_ptr<client> c, bool failed) {
+    if (_gate.is_closed() || failed || _idle.size() >= _max_idle) {
+        if (failed) {
+            _stats.connections_failed++;
+        }
+        background_shutdown(std::move(c));
+        return;
+    }
+    _idle.push_back(idle_entry{
+      .conn = std::move(c),
+      .last_used = ss::lowres_clock::now(),
+    });
+    if (!_reaper.armed()) {
+        _reaper.arm(_idle_timeout);
+    }
+}
+
+void client_pool::reap_idle() {
+    auto deadline = ss::lowres_clock::now() - _idle_timeout;
+    auto it = std::stable_partition(
+      _idle.begin(), _idle.end(), [deadline](const idle_entry& e) {
+          return e.last_used > deadline;
+      });
+    for (auto i = it; i != _idle.end(); ++i) {
+        vlog(http_log.debug, "reaping idle http connection");
+        _stats.connections_reaped++;
+        background_shutdown(std::move(i->conn));
+    }
+    _idle.erase(it, _idle.end());
+    if (!_idle.empty()) {
+        _reaper.arm(_idle_timeout);
+    }
+}
+
+void client_pool::background_shutdown(std::unique_ptr<client> c) {
+    if (_gate.is_closed()) {
+        // stop() is already draining, shut down inline and let the
+        // destructor of the future run in background; the client is
+        // kept alive by the continuation
+        auto& ref = *c;
+        (void)ref.shutdown().finally([c = std::move(c)] {});
+        return;
+    }
+    (void)ss::with_gate(_gate, [c = std::move(c)]() mutable {
+        auto& ref = *c;
+        return ref.shutdown().finally([c = std::move(c)] {});
+    });
+}
+
+ss::future<> client_pool::stop() {
+    _reaper.cancel();
+    auto idle = std::exchange(_idle, {});
+    for (auto& e : idle) {
+        co_await e.conn->shutdown();
+    }
+    co_await _gate.close();
+}
+
+} // namespace http
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "http/client.h"
+#include "rpc/transport.h"
+#include "seastarx.h"
+
+#include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/timer.hh>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace http {
+
+/// \brief Pool of keep-alive connections to a single endpoint.
+///
+/// TLS handshakes dominate the latency of small requests, so instead of
+/// opening a fresh connection per request the pool keeps connections
+/// alive between uses. Connections idle for longer than the idle
+/// timeout are reaped by a background timer. The pool only hands out
+/// connections, it doesn't limit concurrency - callers that need a
+/// limit use their own semaphore.
+class client_pool {
+public:
+    /// idle connections kept alive per pool
+    static constexpr size_t default_max_idle = 8;
+    /// how long a connection may sit idle before it's closed
+    static constexpr ss::lowres_clock::duration default_idle_timeout
+      = std::chrono::seconds(5);
+
+    /// Handshake reuse counters, exposed so users can tell whether the
+    /// pool is effective for their traffic pattern
+    struct usage_stats {
+        /// connections established because the pool was empty
+        uint64_t connections_created{0};
+        /// acquisitions satisfied by an idle keep-alive connection
+        uint64_t connections_reused{0};
+        /// idle connections closed by the reaper
+        uint64_t connections_reaped{0};
+        /// connections marked failed and not returned to the pool
+        uint64_t connections_failed{0};
+    };
+
+    /// RAII handle for a pooled connection. The connection goes back to
+    /// the pool when the handle is destroyed, unless it was marked
+    /// failed, in which case it's shut down in the background.
+    class connection {
+    public:
+        connection() noexcept = default;
+        connection(connection&& o) noexcept
+          : _pool(std::exchange(o._pool, nullptr))
+          , _client(std::move(o._client))
+          , _failed(o._failed) {}
+        connection& operator=(connection&& o) noexcept;
+        connection(const connection&) = delete;
+        connection& operator=(const connection&) = delete;
+        ~connection() noexcept { release(); }
+
+        client& operator*() const noexcept { return *_client; }
+        client* operator->() const noexcept { return _client.get(); }
+
+        /// Mark the connection as unusable (e.g. a request failed
+        /// mid-flight); it won't be returned to the pool
+        void mark_failed() noexcept { _failed = true; }
+
+    private:
+        friend class client_pool;
+        connection(client_pool* pool, std::unique_ptr<client> c) noexcept
+          : _pool(pool)
+          , _client(std::move(c)) {}
+
+        void release() noexcept;
+
+        client_pool* _pool{nullptr};
+        std::unique_ptr<client> _client;
+        bool _failed{false};
+    };
+
+    explicit client_pool(
+      rpc::base_transport::configuration cfg,
+      size_t max_idle = default_max_idle,
+      ss::lowres_clock::duration idle_timeout = default_idle_timeout);
+
+    client_pool(client_pool&&) = delete;
+    client_pool(const client_pool&) = delete;
+    client_pool& operator=(client_pool&&) = delete;
+    client_pool& operator=(const client_pool&) = delete;
+    ~client_pool() = default;
+
+    /// Get a connection, reusing an idle keep-alive one when available.
+    /// The underlying transport connects lazily on the first request.
+    connection acquire();
+
+    const usage_stats& stats() const { return _stats; }
+    size_t idle_connections() const { return _idle.size(); }
+
+    /// Close all idle connections and stop the reaper. In-flight
+    /// connections handed out by acquire() have to be released first.
+    ss::future<> stop();
+
+private:
+    struct idle_entry {
+        std::unique_ptr<client> conn;
+        ss::lowres_clock::time_point last_used;
+    };
+
+    /// Called by the connection handle destructor
+    void put(std::unique_ptr<client> c, bool failed);
+    /// Close connections that have been idle for too long
+    void reap_idle();
+    /// Shutdown a connection without blocking the caller
+    void background_shutdown(std::unique_ptr<client> c);
+
+    rpc::base_transport::configuration _config;
+    size_t _max_idle;
+    ss::lowres_clock::duration _idle_timeout;
+    std::vector<idle_entry> _idle;
+    usage_stats _stats;
+    ss::timer<ss::lowres_clock> _reaper;
+    ss::gate _gate;
+};
+
+} // namespace http
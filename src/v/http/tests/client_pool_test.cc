@@ -0,0 +1,90 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "http/client_pool.h"
+#include "seastarx.h"
+
+#include <seastar/core/sleep.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/net/api.hh>
+#include <seastar/testing/test_case.hh>
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+static rpc::base_transport::configuration test_configuration() {
+    rpc::base_transport::configuration cfg;
+    // the pool connects lazily, nothing listens on this address
+    cfg.server_addr = ss::socket_address(ss::ipv4_addr("127.0.0.1", 14816));
+    return cfg;
+}
+
+SEASTAR_TEST_CASE(test_pool_reuses_idle_connection) {
+    return ss::async([] {
+        http::client_pool pool(test_configuration());
+        http::client* first = nullptr;
+        {
+            auto conn = pool.acquire();
+            first = &*conn;
+        }
+        BOOST_REQUIRE_EQUAL(pool.idle_connections(), 1);
+        {
+            auto conn = pool.acquire();
+            BOOST_REQUIRE_EQUAL(&*conn, first);
+        }
+        BOOST_REQUIRE_EQUAL(pool.stats().connections_created, 1);
+        BOOST_REQUIRE_EQUAL(pool.stats().connections_reused, 1);
+        pool.stop().get();
+    });
+}
+
+SEASTAR_TEST_CASE(test_pool_drops_failed_connection) {
+    return ss::async([] {
+        http::client_pool pool(test_configuration());
+        {
+            auto conn = pool.acquire();
+            conn.mark_failed();
+        }
+        BOOST_REQUIRE_EQUAL(pool.idle_connections(), 0);
+        BOOST_REQUIRE_EQUAL(pool.stats().connections_failed, 1);
+        {
+            auto conn = pool.acquire();
+        }
+        BOOST_REQUIRE_EQUAL(pool.stats().connections_created, 2);
+        BOOST_REQUIRE_EQUAL(pool.stats().connections_reused, 0);
+        pool.stop().get();
+    });
+}
+
+SEASTAR_TEST_CASE(test_pool_reaps_idle_connections) {
+    return ss::async([] {
+        http::client_pool pool(
+          test_configuration(), http::client_pool::default_max_idle, 100ms);
+        { auto conn = pool.acquire(); }
+        BOOST_REQUIRE_EQUAL(pool.idle_connections(), 1);
+        ss::sleep(500ms).get();
+        BOOST_REQUIRE_EQUAL(pool.idle_connections(), 0);
+        BOOST_REQUIRE_EQUAL(pool.stats().connections_reaped, 1);
+        pool.stop().get();
+    });
+}
+
+SEASTAR_TEST_CASE(test_pool_caps_idle_connections) {
+    return ss::async([] {
+        http::client_pool pool(test_configuration(), 1);
+        {
+            auto a = pool.acquire();
+            auto b = pool.acquire();
+        }
+        // only one of the two released connections is kept
+        BOOST_REQUIRE_EQUAL(pool.idle_connections(), 1);
+        pool.stop().get();
+    });
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+
+#include <array>
+#include <cstddef>
+
+namespace json {
+
+/// A rapidjson output stream that appends to an iobuf, the analog of
+/// rapidjson::StringBuffer without the contiguous allocation. Writes are
+/// staged through a small fixed buffer so the per-character Put() calls
+/// issued by rapidjson::Writer do not turn into per-character appends.
+///
+/// iobuf out;
+/// iobuf_buffer buffer(out);
+/// rapidjson::Writer<iobuf_buffer> writer(buffer);
+/// rjson_serialize(writer, v);
+/// buffer.Flush();
+class iobuf_buffer {
+public:
+    using Ch = char;
+
+    explicit iobuf_buffer(iobuf& buf) noexcept
+      : _buf(&buf) {}
+
+    void Put(Ch c) {
+        if (_staged == _staging.size()) {
+            Flush();
+        }
+        _staging[_staged++] = c;
+    }
+
+    void Flush() {
+        if (_staged > 0) {
+            _buf->append(_staging.data(), _staged);
+            _staged = 0;
+        }
+    }
+
+private:
+    static constexpr size_t staging_size = 4096;
+
+    iobuf* _buf;
+    std::array<Ch, staging_size> _staging{};
+    size_t _staged{0};
+};
+
+} // namespace json
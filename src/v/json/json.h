@@ -37,53 +37,133 @@
 #include <rapidjson/writer.h>
 
 #include <chrono>
+#include <sstream>
 #include <type_traits>
 
 namespace json {
 
-void rjson_serialize(rapidjson::Writer<rapidjson::StringBuffer>& w, short v);
+/// The serializers are templated on the writer's output stream so that
+/// callers can serialize into a rapidjson::StringBuffer or stream
+/// directly into an iobuf without materializing a contiguous copy.
 
-void rjson_serialize(rapidjson::Writer<rapidjson::StringBuffer>& w, bool v);
+template<typename Buffer>
+void rjson_serialize(rapidjson::Writer<Buffer>& w, short v) {
+    w.Int(v);
+}
 
-void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, long long v);
+template<typename Buffer>
+void rjson_serialize(rapidjson::Writer<Buffer>& w, bool v) {
+    w.Bool(v);
+}
 
-void rjson_serialize(rapidjson::Writer<rapidjson::StringBuffer>& w, int v);
+template<typename Buffer>
+void rjson_serialize(rapidjson::Writer<Buffer>& w, long long v) {
+    w.Int64(v);
+}
 
-void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, unsigned int v);
+template<typename Buffer>
+void rjson_serialize(rapidjson::Writer<Buffer>& w, int v) {
+    w.Int(v);
+}
+
+template<typename Buffer>
+void rjson_serialize(rapidjson::Writer<Buffer>& w, unsigned int v) {
+    w.Uint(v);
+}
 
-void rjson_serialize(rapidjson::Writer<rapidjson::StringBuffer>& w, long v);
+template<typename Buffer>
+void rjson_serialize(rapidjson::Writer<Buffer>& w, long v) {
+    w.Int64(v);
+}
 
-void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, unsigned long v);
+template<typename Buffer>
+void rjson_serialize(rapidjson::Writer<Buffer>& w, unsigned long v) {
+    w.Uint64(v);
+}
 
-void rjson_serialize(rapidjson::Writer<rapidjson::StringBuffer>& w, double v);
+template<typename Buffer>
+void rjson_serialize(rapidjson::Writer<Buffer>& w, double v) {
+    w.Double(v);
+}
+
+template<typename Buffer>
+void rjson_serialize(rapidjson::Writer<Buffer>& w, std::string_view v) {
+    w.String(v.data(), v.size());
+}
 
+template<typename Buffer>
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, std::string_view s);
+  rapidjson::Writer<Buffer>& w, const ss::socket_address& v) {
+    w.StartObject();
 
+    std::ostringstream a;
+    a << v.addr();
+
+    w.Key("address");
+    w.String(a.str());
+
+    w.Key("port");
+    auto prt = v.port();
+
+    if constexpr (std::is_unsigned_v<decltype(prt)>) {
+        w.Uint(prt);
+    } else {
+        w.Int(prt);
+    }
+    w.EndObject();
+}
+
+template<typename Buffer>
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const ss::socket_address& v);
+  rapidjson::Writer<Buffer>& w, const unresolved_address& v) {
+    w.StartObject();
+
+    w.Key("address");
+    w.String(v.host().c_str());
 
+    w.Key("port");
+    w.Uint(v.port());
+
+    w.EndObject();
+}
+
+template<typename Buffer>
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const unresolved_address& v);
+  rapidjson::Writer<Buffer>& w, const std::chrono::milliseconds& v) {
+    uint64_t _tmp = v.count();
+    rjson_serialize(w, _tmp);
+}
 
+template<typename Buffer>
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w,
-  const std::chrono::milliseconds& v);
+  rapidjson::Writer<Buffer>& w, const std::chrono::microseconds& v) {
+    uint64_t _tmp = v.count();
+    rjson_serialize(w, _tmp);
+}
 
+template<typename Buffer>
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>&, const model::broker_endpoint&);
+  rapidjson::Writer<Buffer>& w, const model::broker_endpoint& ep) {
+    w.StartObject();
+    w.Key("name");
+    w.String(ep.name);
+    w.Key("host");
+    w.String(ep.address.host());
+    w.Key("port");
+    w.Uint(ep.address.port());
+    w.EndObject();
+}
 
-template<typename T, typename = std::enable_if_t<std::is_enum_v<T>>>
-void rjson_serialize(rapidjson::Writer<rapidjson::StringBuffer>& w, T v) {
+template<
+  typename Buffer,
+  typename T,
+  typename = std::enable_if_t<std::is_enum_v<T>>>
+void rjson_serialize(rapidjson::Writer<Buffer>& w, T v) {
     rjson_serialize(w, static_cast<std::underlying_type_t<T>>(v));
 }
 
-template<typename T>
-void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const std::optional<T>& v) {
+template<typename Buffer, typename T>
+void rjson_serialize(rapidjson::Writer<Buffer>& w, const std::optional<T>& v) {
     if (v) {
         rjson_serialize(w, *v);
         return;
@@ -91,15 +171,15 @@ void rjson_serialize(
     w.Null();
 }
 
-template<typename T, typename Tag>
+template<typename Buffer, typename T, typename Tag>
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const named_type<T, Tag>& v) {
+  rapidjson::Writer<Buffer>& w, const named_type<T, Tag>& v) {
     rjson_serialize(w, v());
 }
 
-template<typename T, typename A>
+template<typename Buffer, typename T, typename A>
 void rjson_serialize(
-  rapidjson::Writer<rapidjson::StringBuffer>& w, const std::vector<T, A>& v) {
+  rapidjson::Writer<Buffer>& w, const std::vector<T, A>& v) {
     w.StartArray();
     for (const auto& e : v) {
         rjson_serialize(w, e);
@@ -0,0 +1,370 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "kafka/client/client.h"
+#include "kafka/client/configuration.h"
+#include "kafka/errors.h"
+#include "kafka/requests/kafka_batch_adapter.h"
+#include "model/fundamental.h"
+#include "raft/types.h"
+#include "random/generators.h"
+#include "seastarx.h"
+#include "storage/record_batch_builder.h"
+#include "syschecks/syschecks.h"
+#include "units.h"
+#include "utils/hdr_hist.h"
+#include "utils/unresolved_address.h"
+#include "vlog.h"
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/core/thread.hh>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+static ss::logger bench_log{"bench"};
+
+namespace kc = kafka::client;
+
+void cli_opts(boost::program_options::options_description_easy_init opt) {
+    namespace po = boost::program_options;
+
+    opt(
+      "brokers",
+      po::value<std::string>()->default_value("127.0.0.1:9092"),
+      "comma-separated list of broker host:port");
+
+    opt(
+      "topic",
+      po::value<std::string>()->default_value("bench"),
+      "topic to produce to / consume from");
+
+    opt(
+      "partitions",
+      po::value<int32_t>()->default_value(1),
+      "number of partitions to fan out over, round-robin");
+
+    opt(
+      "record-size",
+      po::value<size_t>()->default_value(1024),
+      "value size of each record, in bytes");
+
+    opt(
+      "records-per-batch",
+      po::value<int32_t>()->default_value(100),
+      "records in each produced batch");
+
+    opt(
+      "compression",
+      po::value<std::string>()->default_value("none"),
+      "compression for broker-bound batches: none, gzip, snappy, lz4, zstd");
+
+    opt(
+      "acks",
+      po::value<int16_t>()->default_value(-1),
+      "produce ack level: -1 (all), 0 or 1");
+
+    opt(
+      "rate",
+      po::value<double>()->default_value(0),
+      "target batches/sec per produce loop, 0 for closed-loop");
+
+    opt(
+      "max-inflight",
+      po::value<size_t>()->default_value(64),
+      "maximum concurrent produce requests");
+
+    opt(
+      "duration-s",
+      po::value<int64_t>()->default_value(30),
+      "how long to run, in seconds");
+
+    opt(
+      "batch-delay-ms",
+      po::value<int64_t>()->default_value(1),
+      "client-side produce linger, in milliseconds");
+
+    opt("consume", po::bool_switch(), "run a consume loop instead of produce");
+
+    opt(
+      "fetch-max-bytes",
+      po::value<int32_t>()->default_value(1048576),
+      "max bytes per fetch request");
+}
+
+struct bench_conf {
+    std::vector<unresolved_address> brokers;
+    model::topic topic;
+    int32_t partitions;
+    size_t record_size;
+    int32_t records_per_batch;
+    std::string compression;
+    int16_t acks;
+    double rate;
+    size_t max_inflight;
+    std::chrono::seconds duration;
+    std::chrono::milliseconds batch_delay;
+    bool consume;
+    int32_t fetch_max_bytes;
+};
+
+inline std::ostream& operator<<(std::ostream& out, const bench_conf& cfg) {
+    // make the output json-able so we can consume it in python for analysis
+    return out << "["
+               << "'topic': " << cfg.topic
+               << ", 'partitions': " << cfg.partitions
+               << ", 'record_size': " << cfg.record_size
+               << ", 'records_per_batch': " << cfg.records_per_batch
+               << ", 'compression': '" << cfg.compression << "'"
+               << ", 'acks': " << cfg.acks << ", 'rate': " << cfg.rate
+               << ", 'mode': '" << (cfg.consume ? "consume" : "produce")
+               << "']";
+}
+
+static std::vector<unresolved_address> parse_brokers(const std::string& arg) {
+    std::vector<std::string> parts;
+    boost::split(parts, arg, boost::is_any_of(","));
+    std::vector<unresolved_address> brokers;
+    for (const auto& part : parts) {
+        auto colon = part.rfind(':');
+        if (colon == std::string::npos) {
+            throw std::invalid_argument(
+              fmt::format("broker '{}' is not host:port", part));
+        }
+        brokers.emplace_back(
+          part.substr(0, colon),
+          boost::lexical_cast<uint16_t>(part.substr(colon + 1)));
+    }
+    return brokers;
+}
+
+bench_conf cfg_from(boost::program_options::variables_map& m) {
+    return bench_conf{
+      .brokers = parse_brokers(m["brokers"].as<std::string>()),
+      .topic = model::topic(m["topic"].as<std::string>()),
+      .partitions = m["partitions"].as<int32_t>(),
+      .record_size = m["record-size"].as<size_t>(),
+      .records_per_batch = m["records-per-batch"].as<int32_t>(),
+      .compression = m["compression"].as<std::string>(),
+      .acks = m["acks"].as<int16_t>(),
+      .rate = m["rate"].as<double>(),
+      .max_inflight = m["max-inflight"].as<size_t>(),
+      .duration = std::chrono::seconds(m["duration-s"].as<int64_t>()),
+      .batch_delay = std::chrono::milliseconds(
+        m["batch-delay-ms"].as<int64_t>()),
+      .consume = m["consume"].as<bool>(),
+      .fetch_max_bytes = m["fetch-max-bytes"].as<int32_t>(),
+    };
+}
+
+static void apply_client_config(const bench_conf& cfg) {
+    auto& ccfg = kc::shard_local_cfg();
+    ccfg.get("produce_ack_level").set_value(cfg.acks);
+    ccfg.get("produce_compression_type").set_value(ss::sstring(cfg.compression));
+    ccfg.get("produce_batch_record_count").set_value(cfg.records_per_batch);
+    // the default linger is tuned for the proxy; latency runs want it low
+    ccfg.get("produce_batch_delay_ms").set_value(cfg.batch_delay);
+}
+
+static model::record_batch make_payload_batch(const bench_conf& cfg) {
+    storage::record_batch_builder builder(
+      raft::data_batch_type, model::offset(0));
+    for (int32_t i = 0; i < cfg.records_per_batch; ++i) {
+        iobuf value;
+        value.append(
+          random_generators::gen_alphanum_string(cfg.record_size).data(),
+          cfg.record_size);
+        builder.add_raw_kv(iobuf(), std::move(value));
+    }
+    return std::move(builder).build();
+}
+
+struct bench_stats {
+    hdr_hist hist;
+    uint64_t ops{0};
+    uint64_t errors{0};
+    uint64_t bytes{0};
+};
+
+static void report(
+  const char* mode, const bench_stats& stats, std::chrono::nanoseconds took) {
+    auto secs = std::chrono::duration<double>(took).count();
+    vlog(
+      bench_log.info,
+      "{}: {} ops, {} errors, {:.2f} ops/s, {:.2f} MiB/s",
+      mode,
+      stats.ops,
+      stats.errors,
+      stats.ops / secs,
+      stats.bytes / secs / 1_MiB);
+    vlog(
+      bench_log.info,
+      "{} latency us: mean {:.0f}, p50 {}, p95 {}, p99 {}, p99.9 {}, max {}",
+      mode,
+      stats.hist.mean(),
+      stats.hist.get_value_at(50.0),
+      stats.hist.get_value_at(95.0),
+      stats.hist.get_value_at(99.0),
+      stats.hist.get_value_at(99.9),
+      stats.hist.get_value_at(100.0));
+}
+
+static void run_produce(kc::client& client, const bench_conf& cfg) {
+    using clock = std::chrono::steady_clock;
+    auto batch = make_payload_batch(cfg);
+    const auto batch_bytes = batch.size_bytes();
+    bench_stats stats;
+    ss::gate gate;
+    ss::semaphore inflight{cfg.max_inflight};
+    const auto start = clock::now();
+    const auto deadline = start + cfg.duration;
+    const auto interval = cfg.rate > 0
+                            ? std::chrono::duration_cast<clock::duration>(
+                              std::chrono::duration<double>(1.0 / cfg.rate))
+                            : clock::duration{};
+    auto next = start;
+    int64_t sent = 0;
+    while (clock::now() < deadline) {
+        if (cfg.rate > 0) {
+            if (auto now = clock::now(); now < next) {
+                ss::sleep(next - now).get();
+            }
+        }
+        // open-loop: latency is measured from the scheduled arrival, not
+        // from when the semaphore let us dispatch, so a slow server can't
+        // hide queueing delay (coordinated omission).
+        const auto scheduled = cfg.rate > 0 ? next : clock::now();
+        next += interval;
+        auto units = ss::get_units(inflight, 1).get0();
+        auto tp = model::topic_partition(
+          cfg.topic,
+          model::partition_id(static_cast<int32_t>(sent % cfg.partitions)));
+        ++sent;
+        (void)ss::with_gate(
+          gate,
+          [&client, &stats, &batch, batch_bytes, tp, scheduled]() mutable {
+              return client.produce_record_batch(std::move(tp), batch.share())
+                .then_wrapped(
+                  [&stats, batch_bytes, scheduled](
+                    ss::future<kafka::produce_response::partition> f) {
+                      auto took = clock::now() - scheduled;
+                      if (f.failed()) {
+                          f.ignore_ready_future();
+                          ++stats.errors;
+                          return;
+                      }
+                      auto res = f.get0();
+                      if (res.error != kafka::error_code::none) {
+                          ++stats.errors;
+                          return;
+                      }
+                      ++stats.ops;
+                      stats.bytes += batch_bytes;
+                      stats.hist.record(
+                        std::chrono::duration_cast<std::chrono::microseconds>(
+                          took)
+                          .count());
+                  });
+          })
+          .finally([units = std::move(units)] {});
+    }
+    gate.close().get();
+    report("produce", stats, clock::now() - start);
+}
+
+static void run_consume(kc::client& client, const bench_conf& cfg) {
+    using clock = std::chrono::steady_clock;
+    bench_stats stats;
+    std::vector<model::offset> offsets(cfg.partitions, model::offset(0));
+    const auto start = clock::now();
+    const auto deadline = start + cfg.duration;
+    int32_t p = 0;
+    while (clock::now() < deadline) {
+        auto tp = model::topic_partition(cfg.topic, model::partition_id(p));
+        const auto t0 = clock::now();
+        auto res
+          = client
+              .fetch_partition(
+                tp,
+                offsets[p],
+                cfg.fetch_max_bytes,
+                std::chrono::milliseconds(500))
+              .get0();
+        stats.hist.record(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+            clock::now() - t0)
+            .count());
+        bool made_progress = false;
+        for (auto& part : res.partitions) {
+            for (auto& r : part.responses) {
+                if (r.error != kafka::error_code::none) {
+                    ++stats.errors;
+                    continue;
+                }
+                if (!r.record_set || r.record_set->empty()) {
+                    continue;
+                }
+                auto record_set = std::move(*r.record_set);
+                while (!record_set.empty()) {
+                    kafka::kafka_batch_adapter kba;
+                    record_set = kba.adapt(std::move(record_set));
+                    if (!kba.batch) {
+                        ++stats.errors;
+                        break;
+                    }
+                    made_progress = true;
+                    ++stats.ops;
+                    stats.bytes += kba.batch->size_bytes();
+                    offsets[p] = kba.batch->last_offset() + model::offset(1);
+                }
+            }
+        }
+        p = (p + 1) % cfg.partitions;
+        if (!made_progress) {
+            // caught up with the log's head; back off a little
+            ss::sleep(std::chrono::milliseconds(10)).get();
+        }
+    }
+    report("consume", stats, clock::now() - start);
+}
+
+int main(int args, char** argv, char** env) {
+    syschecks::initialize_intrinsics();
+    std::setvbuf(stdout, nullptr, _IOLBF, 1024);
+    ss::app_template app;
+    cli_opts(app.add_options());
+    return app.run(args, argv, [&] {
+        auto& cfg = app.configuration();
+        return ss::async([&] {
+            const bench_conf bcfg = cfg_from(cfg);
+            vlog(bench_log.info, "config:{}", bcfg);
+            apply_client_config(bcfg);
+            kc::client client{bcfg.brokers};
+            vlog(bench_log.info, "connecting");
+            client.connect().get();
+            if (bcfg.consume) {
+                run_consume(client, bcfg);
+            } else {
+                run_produce(client, bcfg);
+            }
+            client.stop().get();
+            return 0;
+        });
+    });
+}
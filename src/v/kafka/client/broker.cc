@@ -9,27 +9,46 @@
 
 #include "kafka/client/broker.h"
 
+#include "kafka/client/configuration.h"
 #include "kafka/client/logger.h"
 
 namespace kafka::client {
 
+broker::connection_ptr broker::get_connection() {
+    for (auto& conn : _connections) {
+        if (conn->mtx.ready()) {
+            return conn;
+        }
+    }
+    if (_connections.size() < shard_local_cfg().broker_max_connections()) {
+        auto conn = ss::make_lw_shared<connection>(
+          transport(rpc::base_transport::configuration{.server_addr = _addr}));
+        _connections.push_back(conn);
+        return conn;
+    }
+    return _connections[_next_connection++ % _connections.size()];
+}
+
 ss::future<shared_broker_t>
 make_broker(model::node_id node_id, unresolved_address addr) {
     return addr.resolve()
-      .then([](ss::socket_address addr) {
+      .then([](ss::socket_address resolved) {
           auto client = ss::make_lw_shared<transport>(
-            rpc::base_transport::configuration{.server_addr = addr});
-          return client->connect().then(
-            [client]() mutable { return std::move(client); });
+            rpc::base_transport::configuration{.server_addr = resolved});
+          return client->connect().then([client, resolved]() mutable {
+              return std::make_pair(std::move(client), resolved);
+          });
       })
-      .then([node_id, addr](ss::lw_shared_ptr<transport> client) {
+      .then([node_id, addr](
+              std::pair<ss::lw_shared_ptr<transport>, ss::socket_address> p) {
           vlog(
             kclog.info,
             "connected to broker:{} - {}:{}",
             node_id,
             addr.host(),
             addr.port());
-          return ss::make_lw_shared<broker>(node_id, std::move(*client));
+          return ss::make_lw_shared<broker>(
+            node_id, p.second, std::move(*p.first));
       })
       .handle_exception_type([node_id](const std::system_error& ex) {
           if (
@@ -16,50 +16,58 @@
 #include "model/metadata.h"
 #include "utils/mutex.h"
 
+#include <seastar/core/future-util.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/shared_ptr.hh>
 
 #include <absl/container/flat_hash_set.h>
 
-namespace kafka::client {
-
-struct gated_mutex {
-    gated_mutex()
-      : _mutex{}
-      , _gate{} {}
-
-    template<typename Func>
-    auto with(Func&& func) noexcept {
-        return ss::with_gate(
-          _gate, [this, func{std::forward<Func>(func)}]() mutable {
-              return _mutex.with(
-                [this, func{std::forward<Func>(func)}]() mutable {
-                    _gate.check();
-                    return func();
-                });
-          });
-    }
-
-    ss::future<> close() { return _gate.close(); }
+#include <vector>
 
-    mutex _mutex;
-    ss::gate _gate;
-};
+namespace kafka::client {
 
 class broker : public ss::enable_lw_shared_from_this<broker> {
+    /// \brief A single connection to the broker.
+    ///
+    /// The kafka protocol requires that responses on a connection arrive
+    /// in the order the requests were written, so each connection
+    /// serializes its requests behind a mutex. Concurrency comes from
+    /// dispatching over several connections.
+    struct connection {
+        explicit connection(transport&& client)
+          : client(std::move(client)) {}
+        transport client;
+        mutex mtx;
+    };
+    using connection_ptr = ss::lw_shared_ptr<connection>;
+
 public:
-    broker(model::node_id node_id, transport&& client)
+    broker(model::node_id node_id, ss::socket_address addr, transport&& client)
       : _node_id(node_id)
-      , _client(std::move(client))
-      , _gated_mutex{} {}
+      , _addr(addr) {
+        _connections.push_back(
+          ss::make_lw_shared<connection>(std::move(client)));
+    }
 
     template<typename T, typename Ret = typename T::api_type::response_type>
     CONCEPT(requires(KafkaRequest<typename T::api_type>))
     ss::future<Ret> dispatch(T r) {
-        return _gated_mutex
-          .with([this, r{std::move(r)}]() mutable {
-              return _client.dispatch(std::move(r));
-          })
+        return ss::with_gate(
+                 _gate,
+                 [this, r{std::move(r)}]() mutable {
+                     auto conn = get_connection();
+                     return conn->mtx.with(
+                       [this, conn, r{std::move(r)}]() mutable {
+                           _gate.check();
+                           auto connected = conn->client.is_valid()
+                                              ? ss::now()
+                                              : conn->client.connect();
+                           return connected.then(
+                             [conn, r{std::move(r)}]() mutable {
+                                 return conn->client.dispatch(std::move(r));
+                             });
+                       });
+                 })
           .handle_exception_type([this](const std::bad_optional_access&) {
               // Short read
               return ss::make_exception_future<Ret>(
@@ -70,16 +78,28 @@ public:
 
     model::node_id id() const { return _node_id; }
     ss::future<> stop() {
-        return _gated_mutex.close()
-          .then([this]() { return _client.stop(); })
+        return _gate.close()
+          .then([this]() {
+              return ss::parallel_for_each(
+                _connections,
+                [](const connection_ptr& conn) { return conn->client.stop(); });
+          })
           .finally([b = shared_from_this()]() {});
     }
 
 private:
+    /// \brief Pick a connection to dispatch on.
+    ///
+    /// Prefers an idle connection, growing the pool up to
+    /// broker_max_connections while all of them are busy. Requests past
+    /// the cap queue on the existing connections round-robin.
+    connection_ptr get_connection();
+
     model::node_id _node_id;
-    transport _client;
-    // TODO(Ben): allow overlapped requests
-    gated_mutex _gated_mutex;
+    ss::socket_address _addr;
+    std::vector<connection_ptr> _connections;
+    size_t _next_connection{0};
+    ss::gate _gate;
 };
 
 using shared_broker_t = ss::lw_shared_ptr<broker>;
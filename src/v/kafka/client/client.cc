@@ -150,7 +150,7 @@ ss::future<produce_response::partition> client::produce_record_batch(
       });
 }
 
-ss::future<fetch_response> client::fetch_partition(
+ss::future<fetch_response> client::do_fetch_partition(
   model::topic_partition tp,
   model::offset offset,
   int32_t max_bytes,
@@ -177,6 +177,79 @@ ss::future<fetch_response> client::fetch_partition(
       });
 }
 
+void client::maybe_prefetch(
+  model::topic_partition tp,
+  const fetch_response& res,
+  int32_t max_bytes,
+  std::chrono::milliseconds timeout) {
+    auto next = next_fetch_offset(res);
+    if (!next) {
+        // error or no complete batch: nothing to read ahead of
+        return;
+    }
+    if (_prefetched_bytes >= shard_local_cfg().consumer_prefetch_max_bytes()) {
+        return;
+    }
+    auto& lookahead = _lookaheads[tp];
+    lookahead.offset = *next;
+    lookahead.size_bytes = 0;
+    lookahead.response = do_fetch_partition(tp, *next, max_bytes, timeout)
+                           .then([this, tp, next{*next}](fetch_response res) {
+                               // account the buffered bytes unless the
+                               // lookahead was dropped or replaced while
+                               // in flight
+                               auto it = _lookaheads.find(tp);
+                               if (
+                                 it != _lookaheads.end()
+                                 && it->second.offset == next) {
+                                   size_t sz = 0;
+                                   if (
+                                     !res.partitions.empty()
+                                     && !res.partitions[0].responses.empty()
+                                     && res.partitions[0]
+                                          .responses[0]
+                                          .record_set) {
+                                       sz = res.partitions[0]
+                                              .responses[0]
+                                              .record_set->size_bytes();
+                                   }
+                                   it->second.size_bytes = sz;
+                                   _prefetched_bytes += sz;
+                               }
+                               return res;
+                           });
+}
+
+ss::future<fetch_response> client::fetch_partition(
+  model::topic_partition tp,
+  model::offset offset,
+  int32_t max_bytes,
+  std::chrono::milliseconds timeout) {
+    if (auto it = _lookaheads.find(tp); it != _lookaheads.end()) {
+        if (it->second.offset == offset && it->second.response) {
+            auto fut = std::move(*it->second.response);
+            _prefetched_bytes -= it->second.size_bytes;
+            _lookaheads.erase(it);
+            return fut.then(
+              [this, tp{std::move(tp)}, max_bytes, timeout](
+                fetch_response res) mutable {
+                  maybe_prefetch(std::move(tp), res, max_bytes, timeout);
+                  return res;
+              });
+        }
+        // seek or stale state: drop the lookahead
+        _prefetched_bytes -= it->second.size_bytes;
+        _lookaheads.erase(it);
+    }
+    auto t = tp;
+    return do_fetch_partition(std::move(tp), offset, max_bytes, timeout)
+      .then([this, t{std::move(t)}, max_bytes, timeout](
+              fetch_response res) mutable {
+          maybe_prefetch(std::move(t), res, max_bytes, timeout);
+          return res;
+      });
+}
+
 ss::future<member_id> client::create_consumer(const group_id& group_id) {
     auto build_request = [group_id]() {
         return find_coordinator_request(group_id);
@@ -17,6 +17,7 @@
 #include "kafka/client/configuration.h"
 #include "kafka/client/consumer.h"
 #include "kafka/client/fetcher.h"
+#include "kafka/client/hedging.h"
 #include "kafka/client/producer.h"
 #include "kafka/client/retry_with_mitigation.h"
 #include "kafka/client/transport.h"
@@ -26,6 +27,7 @@
 
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/sleep.hh>
 
 #include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
@@ -83,6 +85,9 @@ public:
     }
 
     /// \brief Dispatch a request to any broker.
+    ///
+    /// These requests are broker-agnostic and idempotent, so a slow
+    /// attempt may be hedged to another broker; see hedged_dispatch.
     template<typename Func>
     CONCEPT(requires requires {
         typename std::invoke_result_t<Func>::api_type::response_type;
@@ -90,10 +95,7 @@ public:
     ss::future<typename std::invoke_result_t<
       Func>::api_type::response_type> dispatch(Func func) {
         return gated_retry_with_mitigation([this, func{std::move(func)}]() {
-            return _brokers.any().then(
-              [func{std::move(func)}](shared_broker_t broker) mutable {
-                  return broker->dispatch(func());
-              });
+            return hedged_dispatch(func);
         });
     }
 
@@ -132,9 +134,84 @@ public:
       std::vector<offset_commit_request_topic> topics);
 
 private:
+    /// \brief Lookahead state for a partition being consumed.
+    ///
+    /// At most one fetch is kept in flight (or buffered) ahead of the
+    /// application's consumption cursor, so a steady poll loop is
+    /// served from the buffer while the next fetch overlaps with
+    /// processing. A poll at an unexpected offset (a seek) drops the
+    /// lookahead.
+    struct fetch_lookahead {
+        /// offset the prefetched response starts at
+        model::offset offset;
+        /// in flight or resolved prefetched response
+        std::optional<ss::future<fetch_response>> response;
+        /// response size, accounted against consumer_prefetch_max_bytes
+        /// once the response resolves
+        size_t size_bytes{0};
+    };
+
     /// \brief Connect and update metdata.
     ss::future<> do_connect(unresolved_address addr);
 
+    /// \brief Dispatch to any broker, hedging the tail.
+    ///
+    /// The primary attempt is raced against a duplicate issued to the
+    /// next round-robin broker once the adaptive hedge delay elapses,
+    /// budget permitting; the first successful response wins and the
+    /// loser completes in the background. With a single broker the
+    /// duplicate lands on the same node, which still helps when the
+    /// slowness is a stuck connection rather than a stuck broker.
+    template<typename Func>
+    ss::future<typename std::invoke_result_t<Func>::api_type::response_type>
+    hedged_dispatch(Func func) {
+        using resp_type =
+          typename std::invoke_result_t<Func>::api_type::response_type;
+        auto state = ss::make_lw_shared<hedge_race<resp_type>>(_hedger);
+        _hedger.on_dispatch();
+        state->arm(
+          _brokers.any().then(
+            [func](shared_broker_t broker) mutable {
+                return broker->dispatch(func());
+            }),
+          false);
+        if (_hedger.may_hedge()) {
+            (void)ss::with_gate(
+              _gate, [this, func{std::move(func)}, state]() mutable {
+                  return ss::sleep(_hedger.delay())
+                    .then([this, func{std::move(func)}, state]() mutable {
+                        if (state->resolved()) {
+                            return;
+                        }
+                        _hedger.on_hedge();
+                        state->arm(
+                          _brokers.any().then(
+                            [func{std::move(func)}](
+                              shared_broker_t broker) mutable {
+                                return broker->dispatch(func());
+                            }),
+                          true);
+                    });
+              });
+        }
+        return state->get_future();
+    }
+
+    /// \brief Fetch from the broker, no lookahead involved.
+    ss::future<fetch_response> do_fetch_partition(
+      model::topic_partition tp,
+      model::offset offset,
+      int32_t max_bytes,
+      std::chrono::milliseconds timeout);
+
+    /// \brief Start a prefetch for the offset following res, within the
+    /// byte budget.
+    void maybe_prefetch(
+      model::topic_partition tp,
+      const fetch_response& res,
+      int32_t max_bytes,
+      std::chrono::milliseconds timeout);
+
     /// \brief Update metadata
     ///
     /// If an existing update is in progress, the future returned will be
@@ -164,6 +241,12 @@ private:
       detail::consumer_hash,
       detail::consumer_eq>
       _consumers;
+    /// \brief Per-partition fetch lookahead.
+    absl::flat_hash_map<model::topic_partition, fetch_lookahead> _lookaheads;
+    /// \brief Bytes held by resolved lookahead responses.
+    size_t _prefetched_bytes{0};
+    /// \brief Hedging policy and counters for any-broker dispatch.
+    hedger _hedger;
     /// \brief Wait for retries.
     ss::gate _gate;
 };
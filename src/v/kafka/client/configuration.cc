@@ -28,6 +28,12 @@ configuration::configuration()
       config::required::no,
       config::tls_config(),
       config::tls_config::validate)
+  , broker_max_connections(
+      *this,
+      "broker_max_connections",
+      "Maximum number of connections to each broker, per shard",
+      config::required::no,
+      8)
   , retries(
       *this,
       "retries",
@@ -40,6 +46,26 @@ configuration::configuration()
       "Delay (in milliseconds) for initial retry backoff",
       config::required::no,
       100ms)
+  , dispatch_hedge_enabled(
+      *this,
+      "dispatch_hedge_enabled",
+      "Duplicate an idempotent broker-agnostic request to another broker "
+      "when the first attempt is still outstanding after the adaptive "
+      "hedge delay, taking the first response",
+      config::required::no,
+      false)
+  , dispatch_hedge_budget_percent(
+      *this,
+      "dispatch_hedge_budget_percent",
+      "Maximum hedged requests as a percent of dispatched requests",
+      config::required::no,
+      10)
+  , dispatch_hedge_min_delay(
+      *this,
+      "dispatch_hedge_min_delay_ms",
+      "Lower bound (in milliseconds) on the adaptive hedge delay",
+      config::required::no,
+      20ms)
   , produce_batch_record_count(
       *this,
       "produce_batch_record_count",
@@ -58,6 +84,20 @@ configuration::configuration()
       "Delay (in milliseconds) to wait before sending batch",
       config::required::no,
       100ms)
+  , produce_ack_level(
+      *this,
+      "produce_ack_level",
+      "Number of acknowledgments the producer requires the leader to have "
+      "received before considering a request complete, -1 for 'all'",
+      config::required::no,
+      -1)
+  , produce_compression_type(
+      *this,
+      "produce_compression_type",
+      "Compression applied to broker-bound batches: none, gzip, snappy, lz4 "
+      "or zstd",
+      config::required::no,
+      "none")
   , consumer_session_timeout(
       *this,
       "consumer_session_timeout_ms",
@@ -75,7 +115,13 @@ configuration::configuration()
       "consumer_heartbeat_interval_ms",
       "Interval (in milliseconds) for consumer heartbeats",
       config::required::no,
-      500ms) {}
+      500ms)
+  , consumer_prefetch_max_bytes(
+      *this,
+      "consumer_prefetch_max_bytes",
+      "Byte budget for fetch responses buffered ahead of consumption",
+      config::required::no,
+      4194304) {}
 
 void configuration::read_yaml(const YAML::Node& root_node) {
     if (!root_node["pandaproxy_client"]) {
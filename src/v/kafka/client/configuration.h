@@ -29,14 +29,21 @@ namespace kafka::client {
 struct configuration final : public config::config_store {
     config::property<std::vector<unresolved_address>> brokers;
     config::property<config::tls_config> broker_tls;
+    config::property<size_t> broker_max_connections;
     config::property<size_t> retries;
     config::property<std::chrono::milliseconds> retry_base_backoff;
+    config::property<bool> dispatch_hedge_enabled;
+    config::property<size_t> dispatch_hedge_budget_percent;
+    config::property<std::chrono::milliseconds> dispatch_hedge_min_delay;
     config::property<int32_t> produce_batch_record_count;
     config::property<int32_t> produce_batch_size_bytes;
     config::property<std::chrono::milliseconds> produce_batch_delay;
+    config::property<int16_t> produce_ack_level;
+    config::property<ss::sstring> produce_compression_type;
     config::property<std::chrono::milliseconds> consumer_session_timeout;
     config::property<std::chrono::milliseconds> consumer_rebalance_timeout;
     config::property<std::chrono::milliseconds> consumer_heartbeat_interval;
+    config::property<size_t> consumer_prefetch_max_bytes;
 
     configuration();
 
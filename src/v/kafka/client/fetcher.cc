@@ -11,6 +11,7 @@
 
 #include "kafka/client/fetcher.h"
 
+#include "bytes/iobuf_parser.h"
 #include "kafka/client/error.h"
 #include "kafka/client/logger.h"
 #include "model/fundamental.h"
@@ -85,4 +86,45 @@ make_fetch_response(const model::topic_partition& tp, std::exception_ptr ex) {
     };
 }
 
+std::optional<model::offset> next_fetch_offset(const fetch_response& res) {
+    if (res.error != error_code::none || res.partitions.empty()) {
+        return std::nullopt;
+    }
+    const auto& responses = res.partitions[0].responses;
+    if (responses.empty() || responses[0].error != error_code::none) {
+        return std::nullopt;
+    }
+    const auto& record_set = responses[0].record_set;
+    if (!record_set || record_set->size_bytes() == 0) {
+        return std::nullopt;
+    }
+
+    // scan the kafka batch headers: for each batch, base_offset(8) and
+    // batch_length(4) are followed by batch_length bytes, of which
+    // partition_leader_epoch(4), magic(1), crc(4) and attributes(2)
+    // precede last_offset_delta(4)
+    constexpr size_t length_prefix = sizeof(int64_t) + sizeof(int32_t);
+    constexpr size_t delta_preamble = sizeof(int32_t) + sizeof(int8_t)
+                                      + sizeof(int32_t) + sizeof(int16_t);
+
+    iobuf_const_parser parser(*record_set);
+    std::optional<model::offset> next;
+    while (parser.bytes_left() >= length_prefix) {
+        auto base_offset = parser.consume_be_type<int64_t>();
+        auto batch_length = parser.consume_be_type<int32_t>();
+        if (
+          batch_length < int32_t(delta_preamble + sizeof(int32_t))
+          || parser.bytes_left() < size_t(batch_length)) {
+            // truncated trailing batch: the broker may return a partial
+            // batch at the tail of the response
+            break;
+        }
+        parser.skip(delta_preamble);
+        auto last_offset_delta = parser.consume_be_type<int32_t>();
+        parser.skip(batch_length - delta_preamble - sizeof(int32_t));
+        next = model::offset(base_offset + last_offset_delta + 1);
+    }
+    return next;
+}
+
 } // namespace kafka::client
\ No newline at end of file
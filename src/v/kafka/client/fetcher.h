@@ -24,4 +24,11 @@ fetch_request make_fetch_request(
 fetch_response
 make_fetch_response(const model::topic_partition& tp, std::exception_ptr ex);
 
+/// \brief Offset following the last complete batch in the response's
+/// record set, determined by scanning batch headers without
+/// materializing the batches. Returns nullopt if the response carries
+/// an error or no complete batch, in which case there is nothing to
+/// prefetch ahead of.
+std::optional<model::offset> next_fetch_offset(const fetch_response& res);
+
 } // namespace kafka::client
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "kafka/client/configuration.h"
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+namespace kafka::client {
+
+/// \brief Sliding window of recent request latencies.
+///
+/// Keeps a fixed number of samples and answers percentile queries over
+/// them. The window is small enough that a query is a copy and an
+/// nth_element over a few cache lines.
+class latency_tracker {
+public:
+    using duration = ss::lowres_clock::duration;
+
+    void record(duration d) {
+        if (_samples.size() < window_size) {
+            _samples.push_back(d);
+            return;
+        }
+        _samples[_next] = d;
+        _next = (_next + 1) % window_size;
+    }
+
+    /// percentile over the current window, or nullopt while too few
+    /// samples arrived for the estimate to mean anything
+    std::optional<duration> percentile(double p) const {
+        if (_samples.size() < min_samples) {
+            return std::nullopt;
+        }
+        auto sorted = _samples;
+        auto nth = sorted.begin()
+                   + static_cast<ssize_t>(p * double(sorted.size() - 1));
+        std::nth_element(sorted.begin(), nth, sorted.end());
+        return *nth;
+    }
+
+private:
+    static constexpr size_t window_size = 128;
+    static constexpr size_t min_samples = 16;
+
+    std::vector<duration> _samples;
+    size_t _next{0};
+};
+
+/// \brief Hedging policy and counters for idempotent any-broker dispatch.
+///
+/// A request whose primary attempt is still outstanding after the
+/// adaptive delay - the p99 of recently observed latencies - may be
+/// duplicated to another broker, with the first successful response
+/// winning. The hedge rate is capped by a budget expressed as a percent
+/// of dispatched requests, so a cluster-wide slowdown cannot double the
+/// request load.
+class hedger {
+public:
+    using duration = latency_tracker::duration;
+
+    bool may_hedge() const {
+        const auto& cfg = shard_local_cfg();
+        if (!cfg.dispatch_hedge_enabled()) {
+            return false;
+        }
+        return _hedges * 100 < _dispatches * cfg.dispatch_hedge_budget_percent();
+    }
+
+    duration delay() const {
+        auto p99 = _latencies.percentile(0.99);
+        if (!p99) {
+            // no meaningful estimate yet, hedge as late as a retry would
+            return shard_local_cfg().retry_base_backoff();
+        }
+        return std::max<duration>(
+          *p99, shard_local_cfg().dispatch_hedge_min_delay());
+    }
+
+    void on_dispatch() { ++_dispatches; }
+    void on_hedge() { ++_hedges; }
+    void on_hedge_win() { ++_hedges_won; }
+    void record_latency(duration d) { _latencies.record(d); }
+
+    uint64_t dispatches() const { return _dispatches; }
+    uint64_t hedges() const { return _hedges; }
+    uint64_t hedges_won() const { return _hedges_won; }
+
+private:
+    latency_tracker _latencies;
+    uint64_t _dispatches{0};
+    uint64_t _hedges{0};
+    uint64_t _hedges_won{0};
+};
+
+/// \brief Race the attempts of one hedged request.
+///
+/// The first successful attempt resolves the future; a failure only
+/// resolves it when no other attempt is outstanding, so a fast-failing
+/// primary still leaves the hedge a chance to win. Losing attempts run
+/// to completion in the background with their results discarded.
+template<typename T>
+class hedge_race : public ss::enable_lw_shared_from_this<hedge_race<T>> {
+public:
+    explicit hedge_race(hedger& h)
+      : _hedger(h)
+      , _start(ss::lowres_clock::now()) {}
+
+    ss::future<T> get_future() { return _promise.get_future(); }
+
+    bool resolved() const { return _resolved; }
+
+    void arm(ss::future<T> f, bool is_hedge) {
+        ++_outstanding;
+        (void)f.then_wrapped(
+          [self = this->shared_from_this(), is_hedge](ss::future<T> r) {
+              self->complete(std::move(r), is_hedge);
+          });
+    }
+
+private:
+    void complete(ss::future<T> r, bool is_hedge) {
+        --_outstanding;
+        if (r.failed()) {
+            auto ex = r.get_exception();
+            if (!_first_ex) {
+                _first_ex = ex;
+            }
+            if (!_resolved && _outstanding == 0) {
+                _resolved = true;
+                _promise.set_exception(_first_ex);
+            }
+            return;
+        }
+        if (_resolved) {
+            r.ignore_ready_future();
+            return;
+        }
+        _resolved = true;
+        _hedger.record_latency(ss::lowres_clock::now() - _start);
+        if (is_hedge) {
+            _hedger.on_hedge_win();
+        }
+        _promise.set_value(r.get0());
+    }
+
+    hedger& _hedger;
+    ss::lowres_clock::time_point _start;
+    ss::promise<T> _promise;
+    bool _resolved{false};
+    size_t _outstanding{0};
+    std::exception_ptr _first_ex;
+};
+
+} // namespace kafka::client
@@ -16,12 +16,16 @@
 #include "kafka/client/produce_batcher.h"
 #include "model/fundamental.h"
 
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/timer.hh>
 #include <seastar/util/noncopyable_function.hh>
 
 #include <absl/container/flat_hash_map.h>
 
+#include <algorithm>
+#include <chrono>
+
 namespace kafka::client {
 
 /// \brief Batch multiple client requests, flush them based on size or time.
@@ -36,6 +40,7 @@ public:
       , _consumer{std::move(c)} {}
 
     ss::future<response> produce(model::record_batch&& batch) {
+        record_arrival(batch.size_bytes());
         _record_count += batch.record_count();
         _size_bytes += batch.size_bytes();
         auto fut = _batcher.produce(std::move(batch));
@@ -80,7 +85,7 @@ private:
 
         if (!timed_out && !threshold_met) {
             _timer.cancel();
-            _timer.arm(shard_local_cfg().produce_batch_delay());
+            _timer.arm(linger_delay(batch_size_bytes));
             return false;
         }
 
@@ -88,12 +93,50 @@ private:
         return true;
     }
 
+    /// \brief Track an exponentially weighted average of the arrival
+    /// rate so the linger can adapt to it.
+    void record_arrival(int32_t size_bytes) {
+        auto now = ss::lowres_clock::now();
+        if (_last_arrival != ss::lowres_clock::time_point{}) {
+            auto interval
+              = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  now - _last_arrival)
+                  .count();
+            auto sample = double(size_bytes)
+                          / double(std::max(interval, int64_t(1)));
+            _rate_bytes_per_ms = _rate_bytes_per_ms == 0.
+                                   ? sample
+                                   : ewma_alpha * sample
+                                       + (1. - ewma_alpha) * _rate_bytes_per_ms;
+        }
+        _last_arrival = now;
+    }
+
+    /// \brief Adaptive linger: wait only as long as the recent arrival
+    /// rate needs to fill the batch, capped by produce_batch_delay. A
+    /// burst of small produces flushes as one batch without waiting out
+    /// the full fixed delay; a trickle still waits the cap.
+    std::chrono::milliseconds linger_delay(int32_t batch_size_bytes) const {
+        auto delay = shard_local_cfg().produce_batch_delay();
+        if (_rate_bytes_per_ms > 0.) {
+            auto fill_ms = double(batch_size_bytes - _size_bytes)
+                           / _rate_bytes_per_ms;
+            delay = std::min(
+              delay, std::chrono::milliseconds(int64_t(fill_ms) + 1));
+        }
+        return delay;
+    }
+
+    static constexpr double ewma_alpha = 0.2;
+
     produce_batcher _batcher{};
     ss::timer<> _timer{};
     consumer _consumer;
     int32_t _record_count{};
     int32_t _size_bytes{};
     bool _in_flight{};
+    ss::lowres_clock::time_point _last_arrival{};
+    double _rate_bytes_per_ms{};
 };
 
 } // namespace kafka::client
@@ -16,29 +16,27 @@
 #include "kafka/client/retry_with_mitigation.h"
 #include "kafka/errors.h"
 #include "kafka/requests/produce_request.h"
+#include "model/compression.h"
 #include "model/fundamental.h"
+#include "storage/parser_utils.h"
+#include "utils/string_switch.h"
 
 #include <seastar/core/gate.hh>
 
+#include <algorithm>
 #include <exception>
 
 namespace kafka::client {
 
-produce_request
-make_produce_request(model::topic_partition tp, model::record_batch&& batch) {
-    std::vector<produce_request::partition> partitions;
-    partitions.emplace_back(produce_request::partition{
-      .id{tp.partition},
-      .data{},
-      .adapter = kafka_batch_adapter{
-        .v2_format = true, .valid_crc = true, .batch{std::move(batch)}}});
-
-    std::vector<produce_request::topic> topics;
-    topics.emplace_back(produce_request::topic{
-      .name{std::move(tp.topic)}, .partitions{std::move(partitions)}});
-    std::optional<ss::sstring> t_id;
-    int16_t acks = -1;
-    return produce_request(t_id, acks, std::move(topics));
+static model::compression produce_compression() {
+    return string_switch<model::compression>(
+             shard_local_cfg().produce_compression_type())
+      .match_all("none", "uncompressed", model::compression::none)
+      .match("gzip", model::compression::gzip)
+      .match("snappy", model::compression::snappy)
+      .match("lz4", model::compression::lz4)
+      .match("zstd", model::compression::zstd)
+      .default_match(model::compression::none);
 }
 
 produce_response::partition
@@ -76,22 +74,95 @@ producer::produce(model::topic_partition tp, model::record_batch&& batch) {
 ss::future<produce_response::partition>
 producer::do_send(model::topic_partition tp, model::record_batch&& batch) {
     return _brokers.find(tp)
-      .then([tp{std::move(tp)},
-             batch{std::move(batch)}](shared_broker_t broker) mutable {
-          return broker->dispatch(
-            make_produce_request(std::move(tp), std::move(batch)));
-      })
-      .then([](produce_response res) mutable {
-          auto topic = std::move(res.topics[0]);
-          auto partition = std::move(topic.partitions[0]);
-          if (partition.error != error_code::none) {
-              return ss::make_exception_future<produce_response::partition>(
-                partition_error(
-                  model::topic_partition(topic.name, partition.id),
-                  partition.error));
+      .then([this, tp{std::move(tp)}, batch{std::move(batch)}](
+              shared_broker_t broker) mutable {
+          auto t = tp;
+          return dispatch_aggregated(
+                   std::move(broker), std::move(tp), std::move(batch))
+            .then([t{std::move(t)}](produce_response::partition partition) {
+                if (partition.error != error_code::none) {
+                    return ss::make_exception_future<
+                      produce_response::partition>(
+                      partition_error(std::move(t), partition.error));
+                }
+                return ss::make_ready_future<produce_response::partition>(
+                  std::move(partition));
+            });
+      });
+}
+
+ss::future<produce_response::partition> producer::dispatch_aggregated(
+  shared_broker_t broker, model::topic_partition tp, model::record_batch&& batch) {
+    auto node = broker->id();
+    auto it = _pending.find(node);
+    if (it == _pending.end()) {
+        it = _pending
+               .emplace(node, ss::make_lw_shared<pending_produce>())
+               .first;
+        auto& pending = *it->second;
+        pending.broker = std::move(broker);
+        pending.timer.set_callback([this, node] { flush_pending(node); });
+        // coalesce everything that flushes in the same reactor poll
+        pending.timer.arm(std::chrono::milliseconds(0));
+    }
+    auto& pending = *it->second;
+
+    auto topic = std::find_if(
+      pending.topics.begin(),
+      pending.topics.end(),
+      [&tp](const produce_request::topic& t) { return t.name == tp.topic; });
+    if (topic == pending.topics.end()) {
+        pending.topics.push_back(produce_request::topic{.name{tp.topic}});
+        topic = std::prev(pending.topics.end());
+    }
+    topic->partitions.push_back(produce_request::partition{
+      .id{tp.partition},
+      .data{},
+      .adapter = kafka_batch_adapter{
+        .v2_format = true, .valid_crc = true, .batch{std::move(batch)}}});
+
+    auto [p_it, inserted] = pending.promises.try_emplace(std::move(tp));
+    vassert(inserted, "partition already pending in broker produce request");
+    return p_it->second.get_future();
+}
+
+void producer::flush_pending(model::node_id node) {
+    auto it = _pending.find(node);
+    if (it == _pending.end()) {
+        return;
+    }
+    auto pending = std::move(it->second);
+    _pending.erase(it);
+
+    std::optional<ss::sstring> t_id;
+    int16_t acks = shard_local_cfg().produce_ack_level();
+    auto req = produce_request(t_id, acks, std::move(pending->topics));
+    (void)pending->broker->dispatch(std::move(req))
+      .then_wrapped([pending](ss::future<produce_response> f) {
+          if (f.failed()) {
+              auto ex = f.get_exception();
+              for (auto& p : pending->promises) {
+                  p.second.set_exception(ex);
+              }
+              return;
+          }
+          auto res = f.get0();
+          for (auto& t : res.topics) {
+              for (auto& p : t.partitions) {
+                  auto p_it = pending->promises.find(
+                    model::topic_partition(t.name, p.id));
+                  if (p_it != pending->promises.end()) {
+                      p_it->second.set_value(std::move(p));
+                      pending->promises.erase(p_it);
+                  }
+              }
+          }
+          // a partition the broker failed to echo back gets an error
+          // response so its batch is retried
+          for (auto& p : pending->promises) {
+              p.second.set_exception(partition_error(
+                p.first, error_code::unknown_server_error));
           }
-          return ss::make_ready_future<produce_response::partition>(
-            std::move(partition));
       });
 }
 
@@ -104,24 +175,36 @@ producer::send(model::topic_partition tp, model::record_batch&& batch) {
       tp,
       record_count);
     auto p_id = tp.partition;
-    return ss::do_with(
-             std::move(batch),
-             [this, tp](model::record_batch& batch) mutable {
-                 return retry_with_mitigation(
-                   shard_local_cfg().retries(),
-                   shard_local_cfg().retry_base_backoff(),
-                   [this, tp{std::move(tp)}, &batch]() {
-                       return do_send(tp, batch.share());
-                   },
-                   [this](std::exception_ptr ex) {
-                       return _error_handler(std::move(ex))
-                         .handle_exception([](std::exception_ptr ex) {
-                             vlog(
-                               kclog.trace, "Error during mitigation: {}", ex);
-                             // ignore failed mitigation
-                         });
-                   });
-             })
+    // Compression has to happen here, on the consumed broker-bound batch;
+    // batches handed to produce() are rebuilt record-by-record by the
+    // batcher, so upstream compression wouldn't survive to the wire.
+    auto compression = produce_compression();
+    auto batch_f = compression == model::compression::none
+                     ? ss::make_ready_future<model::record_batch>(
+                       std::move(batch))
+                     : storage::internal::compress_batch(
+                       compression, std::move(batch));
+    return batch_f
+      .then([this, tp](model::record_batch batch) {
+          return ss::do_with(
+            std::move(batch),
+            [this, tp{std::move(tp)}](model::record_batch& batch) mutable {
+                return retry_with_mitigation(
+                  shard_local_cfg().retries(),
+                  shard_local_cfg().retry_base_backoff(),
+                  [this, tp{std::move(tp)}, &batch]() {
+                      return do_send(tp, batch.share());
+                  },
+                  [this](std::exception_ptr ex) {
+                      return _error_handler(std::move(ex))
+                        .handle_exception([](std::exception_ptr ex) {
+                            vlog(
+                              kclog.trace, "Error during mitigation: {}", ex);
+                            // ignore failed mitigation
+                        });
+                  });
+            });
+      })
       .handle_exception([p_id](std::exception_ptr ex) {
           return make_produce_response(p_id, std::move(ex));
       })
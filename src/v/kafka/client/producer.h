@@ -11,11 +11,14 @@
 
 #pragma once
 
+#include "kafka/client/broker.h"
 #include "kafka/client/produce_batcher.h"
 #include "kafka/client/produce_partition.h"
 #include "model/fundamental.h"
 #include "ssx/future-util.h"
 
+#include <seastar/core/timer.hh>
+
 #include <absl/container/flat_hash_map.h>
 
 namespace kafka::client {
@@ -45,11 +48,40 @@ public:
     }
 
 private:
+    /// \brief Produce request under aggregation for one broker.
+    ///
+    /// Partition batches that become ready close together are combined
+    /// into a single request per destination broker instead of one
+    /// request per partition. The linger is zero length: it coalesces
+    /// everything that flushes within the same reactor poll, which is
+    /// the common case when many partition timers expire together,
+    /// without adding latency for a lone batch.
+    struct pending_produce {
+        shared_broker_t broker;
+        std::vector<produce_request::topic> topics;
+        absl::flat_hash_map<
+          model::topic_partition,
+          ss::promise<produce_response::partition>>
+          promises;
+        ss::timer<> timer;
+    };
+    using pending_produce_ptr = ss::lw_shared_ptr<pending_produce>;
+
     ss::future<> send(model::topic_partition tp, model::record_batch&& batch);
 
     ss::future<produce_response::partition>
     do_send(model::topic_partition tp, model::record_batch&& batch);
 
+    /// append the batch to the broker's pending request, starting one
+    /// if necessary, and return a future for this partition's response
+    ss::future<produce_response::partition> dispatch_aggregated(
+      shared_broker_t broker,
+      model::topic_partition tp,
+      model::record_batch&& batch);
+
+    /// send the broker's pending request and scatter the responses
+    void flush_pending(model::node_id node);
+
     auto make_consumer(model::topic_partition tp) {
         return [this, tp](model::record_batch&& batch) {
             (void)send(tp, std::move(batch));
@@ -67,6 +99,7 @@ private:
 
     absl::flat_hash_map<model::topic_partition, shared_produce_partition>
       _partitions;
+    absl::flat_hash_map<model::node_id, pending_produce_ptr> _pending;
     error_handler _error_handler;
     brokers& _brokers;
 };
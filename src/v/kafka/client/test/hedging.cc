@@ -0,0 +1,87 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/client/hedging.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/tools/old/interface.hpp>
+
+#include <chrono>
+#include <stdexcept>
+
+namespace kc = kafka::client;
+using namespace std::chrono_literals;
+
+SEASTAR_THREAD_TEST_CASE(test_latency_tracker_percentile) {
+    kc::latency_tracker t;
+    // too few samples: no estimate
+    t.record(1ms);
+    BOOST_REQUIRE(!t.percentile(0.99).has_value());
+    for (int i = 0; i < 100; ++i) {
+        t.record(std::chrono::milliseconds(i));
+    }
+    auto p99 = t.percentile(0.99);
+    BOOST_REQUIRE(p99.has_value());
+    BOOST_REQUIRE(*p99 >= 90ms);
+    auto p50 = t.percentile(0.5);
+    BOOST_REQUIRE(*p50 <= *p99);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_hedge_race_first_success_wins) {
+    kc::hedger h;
+    auto race = ss::make_lw_shared<kc::hedge_race<int>>(h);
+    ss::promise<int> slow;
+    race->arm(slow.get_future(), false);
+    race->arm(ss::make_ready_future<int>(42), true);
+    BOOST_REQUIRE_EQUAL(race->get_future().get0(), 42);
+    BOOST_REQUIRE_EQUAL(h.hedges_won(), 1);
+    // the loser completes in the background and is discarded
+    slow.set_value(1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_hedge_race_failure_waits_for_last_attempt) {
+    kc::hedger h;
+    auto race = ss::make_lw_shared<kc::hedge_race<int>>(h);
+    ss::promise<int> hedge;
+    race->arm(
+      ss::make_exception_future<int>(std::runtime_error("primary")), false);
+    BOOST_REQUIRE(!race->resolved());
+    race->arm(hedge.get_future(), true);
+    hedge.set_value(2);
+    BOOST_REQUIRE_EQUAL(race->get_future().get0(), 2);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_hedge_race_all_failed) {
+    kc::hedger h;
+    auto race = ss::make_lw_shared<kc::hedge_race<int>>(h);
+    race->arm(
+      ss::make_exception_future<int>(std::runtime_error("primary")), false);
+    race->arm(
+      ss::make_exception_future<int>(std::runtime_error("hedge")), true);
+    BOOST_REQUIRE_THROW(race->get_future().get0(), std::runtime_error);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_hedger_budget) {
+    kc::shard_local_cfg().dispatch_hedge_enabled.set_value(true);
+    kc::hedger h;
+    for (int i = 0; i < 100; ++i) {
+        h.on_dispatch();
+    }
+    // 10% budget over 100 dispatches admits 10 hedges
+    size_t hedged = 0;
+    while (h.may_hedge()) {
+        h.on_hedge();
+        ++hedged;
+    }
+    BOOST_REQUIRE_EQUAL(hedged, 10);
+    kc::shard_local_cfg().dispatch_hedge_enabled.set_value(false);
+    BOOST_REQUIRE(!h.may_hedge());
+}
@@ -61,22 +61,42 @@ connection_context::throttle_request(
     // distinguish throttling delays from real delays. delays
     // applied to subsequent messages allow backpressure to take
     // affect.
+    //
+    // the quota handle is cached on the connection since nearly every
+    // request on a connection carries the same client id
+    if (
+      !_quota
+      || std::string_view(_quota->client_id)
+           != client_id.value_or(std::string_view())) {
+        _quota = _proto.quota_mgr().get_quota(client_id);
+    }
     auto delay = _proto.quota_mgr().record_tp_and_throttle(
-      client_id, request_size);
+      _quota, request_size);
 
     auto fut = ss::now();
     if (!delay.first_violation) {
         fut = ss::sleep_abortable(delay.duration, _rs.abort_source());
     }
+    // the per-connection budget is reserved before the shard-wide semaphore
+    // so a connection over its own budget queues without holding any of the
+    // memory shared with well behaved connections
     return fut
-      .then(
-        [this, request_size] { return reserve_request_units(request_size); })
-      .then([this, delay](ss::semaphore_units<> units) {
-          return session_resources{
-            .backpressure_delay = delay.duration,
-            .memlocks = std::move(units),
-            .method_latency = _rs.hist().auto_measure(),
-          };
+      .then([this, request_size] {
+          return reserve_connection_units(request_size);
+      })
+      .then([this, request_size, delay](ss::semaphore_units<> conn_units) {
+          return reserve_request_units(request_size)
+            .then([this, delay, conn_units = std::move(conn_units)](
+                    ss::semaphore_units<> units) mutable {
+                return session_resources{
+                  .backpressure_delay = delay.duration,
+                  .memlocks = std::move(units),
+                  .conn_memlocks = std::move(conn_units),
+                  .method_latency = hdr_hist::measurement(_rs.hist()),
+                  .listener_latency = hdr_hist::measurement(
+                    _rs.listener_hist()),
+                };
+            });
       });
 }
 
@@ -98,6 +118,19 @@ connection_context::reserve_request_units(size_t size) {
     return fut;
 }
 
+ss::future<ss::semaphore_units<>>
+connection_context::reserve_connection_units(size_t size) {
+    // same estimate as the shard-wide reservation, clamped to the budget so
+    // that a request larger than the budget can still be admitted alone
+    auto mem_estimate = std::min(
+      size * 2 + 8000, max_request_memory_per_connection); // NOLINT
+    auto fut = ss::get_units(_inflight_memory, mem_estimate);
+    if (_inflight_memory.waiters()) {
+        _rs.probe().waiting_for_connection_memory();
+    }
+    return fut;
+}
+
 ss::future<>
 connection_context::dispatch_method_once(request_header hdr, size_t size) {
     return throttle_request(hdr.client_id, size)
@@ -121,30 +154,39 @@ connection_context::dispatch_method_once(request_header hdr, size_t size) {
                   std::move(hdr),
                   std::move(buf),
                   sres.backpressure_delay);
-                // background process this one full request
+                // background process this one full request. the session
+                // resources travel with the request and are released only
+                // once its response has been written to the socket
                 (void)ss::with_gate(
                   _rs.conn_gate(),
-                  [this, rctx = std::move(rctx)]() mutable {
-                      return do_process(std::move(rctx));
+                  [this,
+                   rctx = std::move(rctx),
+                   sres = std::move(sres)]() mutable {
+                      return do_process(std::move(rctx), std::move(sres));
                   })
                   .handle_exception([self](std::exception_ptr e) {
                       vlog(
                         klog.info, "Detected error processing request: {}", e);
                       self->_rs.conn->shutdown_input();
                   })
-                  .finally([s = std::move(sres), self] {});
+                  .finally([self] {});
             });
       });
 }
 
-ss::future<> connection_context::do_process(request_context ctx) {
+ss::future<> connection_context::do_process(
+  request_context ctx, session_resources sres) {
     const auto correlation = ctx.header().correlation;
     const sequence_id seq = _seq_idx;
     _seq_idx = _seq_idx + sequence_id(1);
     return kafka::process_request(std::move(ctx), _proto.smp_group())
-      .then([this, seq, correlation](response_ptr r) mutable {
+      .then([this, seq, correlation, sres = std::move(sres)](
+              response_ptr r) mutable {
           r->set_correlation(correlation);
-          _responses.insert({seq, std::move(r)});
+          _responses.insert(
+            {seq,
+             response_and_resources{
+               .response = std::move(r), .resources = std::move(sres)}});
           return process_next_response();
       });
 }
@@ -163,18 +205,21 @@ ss::future<> connection_context::process_next_response() {
         _responses.erase(it);
         _rs.probe().request_completed();
 
-        if (r->is_noop()) {
+        if (r.response->is_noop()) {
             return ss::make_ready_future<ss::stop_iteration>(
               ss::stop_iteration::no);
         }
 
-        auto msg = response_as_scattered(std::move(r));
+        auto msg = response_as_scattered(std::move(r.response));
         _rs.probe().add_bytes_sent(msg.size());
         try {
-            return _rs.conn->write(std::move(msg)).then([] {
-                return ss::make_ready_future<ss::stop_iteration>(
-                  ss::stop_iteration::no);
-            });
+            // the session resources are freed once the response is on the
+            // wire, see response_and_resources
+            return _rs.conn->write(std::move(msg))
+              .then([res = std::move(r.resources)] {
+                  return ss::make_ready_future<ss::stop_iteration>(
+                    ss::stop_iteration::no);
+              });
         } catch (...) {
             vlog(
               klog.debug,
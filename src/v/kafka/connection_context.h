@@ -13,6 +13,7 @@
 #include "kafka/requests/response.h"
 #include "rpc/server.h"
 #include "seastarx.h"
+#include "units.h"
 #include "utils/hdr_hist.h"
 #include "utils/named_type.h"
 
@@ -23,7 +24,7 @@
 
 #include <absl/container/flat_hash_map.h>
 
-#include <memory>
+#include <optional>
 
 namespace kafka {
 
@@ -53,29 +54,59 @@ private:
     struct session_resources {
         ss::lowres_clock::duration backpressure_delay;
         ss::semaphore_units<> memlocks;
-        std::unique_ptr<hdr_hist::measurement> method_latency;
+        ss::semaphore_units<> conn_memlocks;
+        std::optional<hdr_hist::measurement> method_latency;
+        // same span as method_latency, recorded into the per-listener
+        // histogram so endpoint tails are separable in metrics
+        std::optional<hdr_hist::measurement> listener_latency;
     };
 
     /// called by throttle_request
     ss::future<ss::semaphore_units<>> reserve_request_units(size_t size);
 
+    /// charges the request against this connection's in flight byte budget
+    ss::future<ss::semaphore_units<>> reserve_connection_units(size_t size);
+
     /// apply correct backpressure sequence
     ss::future<session_resources>
     throttle_request(std::optional<std::string_view>, size_t sz);
 
     ss::future<> dispatch_method_once(request_header, size_t sz);
     ss::future<> process_next_response();
-    ss::future<> do_process(request_context);
+    ss::future<> do_process(request_context, session_resources);
 
 private:
     using sequence_id = named_type<uint64_t, struct kafka_protocol_sequence>;
-    using map_t = absl::flat_hash_map<sequence_id, response_ptr>;
+    /**
+     * Responses are dispatched out of order but sent in order. A staged
+     * response keeps its session resources until it is written to the
+     * socket, so the memory semaphore bounds the amount of out of order
+     * work a connection blocked on a slow head request can accumulate.
+     */
+    struct response_and_resources {
+        response_ptr response;
+        session_resources resources;
+    };
+    using map_t = absl::flat_hash_map<sequence_id, response_and_resources>;
+
+    /**
+     * Bounds the estimated bytes of requests a single connection may have in
+     * flight, complementing the shard-wide memory semaphore which bounds all
+     * connections collectively. The budget is reserved before the request
+     * payload is read off the socket, so a connection over budget simply
+     * stops being read and TCP backpressure reaches the client instead of an
+     * allocation failure hitting the shard.
+     */
+    static constexpr size_t max_request_memory_per_connection = 10_MiB;
 
     protocol& _proto;
     rpc::server::resources _rs;
+    ss::semaphore _inflight_memory{max_request_memory_per_connection};
     sequence_id _next_response;
     sequence_id _seq_idx;
     map_t _responses;
+    // cached quota entry for this connection's client id
+    quota_manager::quota_handle _quota;
 };
 
 } // namespace kafka
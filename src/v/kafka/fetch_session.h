@@ -97,8 +97,12 @@ private:
     using io_list_t = intrusive_list<entry, &entry::_hook>;
 
     static auto make_partition_iterator(io_list_t::const_iterator it) {
+        // return a reference, the fetch path walks all session partitions
+        // every poll round and a copy here would allocate per partition
         return boost::iterators::make_transform_iterator(
-          it, [](const entry& e) { return e.partition; });
+          it, [](const entry& e) -> const kafka::fetch_partition& {
+              return e.partition;
+          });
     }
 
 public:
@@ -48,7 +48,8 @@ group::group(
   kafka::group_id id,
   group_state s,
   config::configuration& conf,
-  ss::lw_shared_ptr<cluster::partition> partition)
+  ss::lw_shared_ptr<cluster::partition> partition,
+  ss::lw_shared_ptr<offset_commit_batcher> batcher)
   : _id(id)
   , _state(s)
   , _state_timestamp(clock_type::now())
@@ -56,18 +57,21 @@ group::group(
   , _num_members_joining(0)
   , _new_member_added(false)
   , _conf(conf)
-  , _partition(partition) {}
+  , _partition(partition)
+  , _commit_batcher(std::move(batcher)) {}
 
 group::group(
   kafka::group_id id,
   group_log_group_metadata& md,
   config::configuration& conf,
-  ss::lw_shared_ptr<cluster::partition> partition)
+  ss::lw_shared_ptr<cluster::partition> partition,
+  ss::lw_shared_ptr<offset_commit_batcher> batcher)
   : _id(id)
   , _num_members_joining(0)
   , _new_member_added(false)
   , _conf(conf)
-  , _partition(partition) {
+  , _partition(partition)
+  , _commit_batcher(std::move(batcher)) {
     _state = md.members.empty() ? group_state::empty : group_state::stable;
     _generation = md.generation;
     _protocol_type = md.protocol_type;
@@ -151,6 +155,13 @@ void group::add_member_no_join(member_ptr member) {
     for (auto& p : member->protocols()) {
         _supported_protocols[p.name]++;
     }
+
+    if (
+      !_max_rebalance_timeout
+      || member->rebalance_timeout() > *_max_rebalance_timeout) {
+        _max_rebalance_timeout = member->rebalance_timeout();
+    }
+    _member_metadata_cache.reset();
 }
 
 ss::future<join_group_response> group::add_member(member_ptr member) {
@@ -175,6 +186,7 @@ ss::future<join_group_response> group::update_member(
     for (auto& p : member->protocols()) {
         _supported_protocols[p.name]++;
     }
+    _member_metadata_cache.reset();
 
     if (!member->is_joining()) {
         _num_members_joining++;
@@ -186,16 +198,25 @@ ss::future<join_group_response> group::update_member(
 }
 
 group::duration_type group::rebalance_timeout() const {
-    auto it = std::max_element(
-      std::cbegin(_members),
-      std::cend(_members),
-      [](const member_map::value_type& a, const member_map::value_type& b) {
-          return a.second->rebalance_timeout() < b.second->rebalance_timeout();
-      });
-    if (likely(it != _members.end())) {
-        return it->second->rebalance_timeout();
-    } else {
-        throw std::runtime_error("no members in group");
+    if (likely(_max_rebalance_timeout.has_value())) {
+        return *_max_rebalance_timeout;
+    }
+    throw std::runtime_error("no members in group");
+}
+
+void group::refresh_aggregates_on_remove(duration_type removed_timeout) {
+    _member_metadata_cache.reset();
+    if (_max_rebalance_timeout && removed_timeout < *_max_rebalance_timeout) {
+        // the removed member did not hold the maximum
+        return;
+    }
+    _max_rebalance_timeout = std::nullopt;
+    for (const auto& m : _members) {
+        if (
+          !_max_rebalance_timeout
+          || m.second->rebalance_timeout() > *_max_rebalance_timeout) {
+            _max_rebalance_timeout = m.second->rebalance_timeout();
+        }
     }
 }
 
@@ -207,20 +228,23 @@ std::vector<member_config> group::member_metadata() const {
           fmt::format("invalid group state: {}", _state));
     }
 
-    std::vector<member_config> out;
-    std::transform(
-      std::cbegin(_members),
-      std::cend(_members),
-      std::back_inserter(out),
-      [this](const member_map::value_type& m) {
-          auto& group_inst = m.second->group_instance_id();
-          auto metadata = m.second->get_protocol_metadata(*_protocol);
-          return member_config{
-            .member_id = m.first,
-            .group_instance_id = group_inst,
-            .metadata = std::move(metadata)};
-      });
-    return out;
+    if (!_member_metadata_cache) {
+        std::vector<member_config> out;
+        std::transform(
+          std::cbegin(_members),
+          std::cend(_members),
+          std::back_inserter(out),
+          [this](const member_map::value_type& m) {
+              auto& group_inst = m.second->group_instance_id();
+              auto metadata = m.second->get_protocol_metadata(*_protocol);
+              return member_config{
+                .member_id = m.first,
+                .group_instance_id = group_inst,
+                .metadata = std::move(metadata)};
+          });
+        _member_metadata_cache = std::move(out);
+    }
+    return *_member_metadata_cache;
 }
 
 void group::add_missing_assignments(assignments_type& assignments) const {
@@ -251,6 +275,7 @@ void group::clear_assignments() const {
 
 void group::advance_generation() {
     ++_generation;
+    _member_metadata_cache.reset();
     if (_members.empty()) {
         _protocol = std::nullopt;
         set_state(group_state::empty);
@@ -704,7 +729,9 @@ void group::complete_join() {
             }
 
             auto leader = is_leader(it->second->id());
+            auto removed_timeout = it->second->rebalance_timeout();
             _members.erase(it++);
+            refresh_aggregates_on_remove(removed_timeout);
 
             if (leader) {
                 if (!_members.empty()) {
@@ -864,7 +891,9 @@ void group::remove_member(member_ptr member) {
             }
         }
         vlog(klog.trace, "removing member {}", member->id());
+        auto removed_timeout = member->rebalance_timeout();
         _members.erase(it);
+        refresh_aggregates_on_remove(removed_timeout);
     }
 
     if (is_leader(member->id())) {
@@ -1212,12 +1241,18 @@ group::store_offsets(offset_commit_request&& r) {
     }
 
     auto batch = std::move(builder).build();
-    auto reader = model::make_memory_record_batch_reader(std::move(batch));
 
-    return _partition
-      ->replicate(
-        std::move(reader),
-        raft::replicate_options(raft::consistency_level::quorum_ack))
+    // route through the shared per partition batcher when available so
+    // commits from concurrent committers coalesce into one append
+    auto replicated = _commit_batcher
+                        ? _commit_batcher->replicate(std::move(batch))
+                        : _partition->replicate(
+                          model::make_memory_record_batch_reader(
+                            std::move(batch)),
+                          raft::replicate_options(
+                            raft::consistency_level::quorum_ack));
+
+    return replicated
       .then([this, req = std::move(r), commits = std::move(offset_commits)](
               result<raft::replicate_result> r) mutable {
           error_code error = r ? error_code::none : error_code::not_coordinator;
@@ -14,6 +14,7 @@
 #include "config/configuration.h"
 #include "kafka/errors.h"
 #include "kafka/groups/member.h"
+#include "kafka/groups/offset_commit_batcher.h"
 #include "kafka/logger.h"
 #include "kafka/requests/heartbeat_request.h"
 #include "kafka/requests/join_group_request.h"
@@ -116,14 +117,16 @@ public:
       kafka::group_id id,
       group_state s,
       config::configuration& conf,
-      ss::lw_shared_ptr<cluster::partition> partition);
+      ss::lw_shared_ptr<cluster::partition> partition,
+      ss::lw_shared_ptr<offset_commit_batcher> batcher = nullptr);
 
     // constructor used when loading state from log
     group(
       kafka::group_id id,
       group_log_group_metadata& md,
       config::configuration& conf,
-      ss::lw_shared_ptr<cluster::partition> partition);
+      ss::lw_shared_ptr<cluster::partition> partition,
+      ss::lw_shared_ptr<offset_commit_batcher> batcher = nullptr);
 
     /// Get the group id.
     const kafka::group_id& id() const { return _id; }
@@ -249,7 +252,8 @@ public:
     /**
      * \brief Get the timeout duration for rebalancing.
      *
-     * Returns the maximum rebalance timeout across all group members.
+     * Returns the maximum rebalance timeout across all group members. The
+     * maximum is tracked incrementally so this is O(1) on the join path.
      *
      * \throws std::runtime_error if the group has no members.
      */
@@ -420,6 +424,10 @@ private:
 
     model::record_batch checkpoint(const assignments_type& assignments);
 
+    /// Refresh cached aggregates after removing a member with the given
+    /// rebalance timeout.
+    void refresh_aggregates_on_remove(duration_type);
+
     kafka::group_id _id;
     group_state _state;
     clock_type::time_point _state_timestamp;
@@ -435,9 +443,27 @@ private:
     bool _new_member_added;
     config::configuration& _conf;
     ss::lw_shared_ptr<cluster::partition> _partition;
+    // shared with the other groups mapped to the same metadata partition,
+    // coalesces offset commit appends. may be null (tests), in which case
+    // commits replicate directly
+    ss::lw_shared_ptr<offset_commit_batcher> _commit_batcher;
     absl::flat_hash_map<model::topic_partition, offset_metadata> _offsets;
     absl::flat_hash_map<model::topic_partition, offset_metadata>
       _pending_offset_commits;
+
+    // aggregates maintained incrementally so that join and sync handling
+    // scales with the number of changed members rather than group size:
+    //
+    //   - _max_rebalance_timeout grows on member addition and is
+    //     recomputed only when the member holding the maximum leaves.
+    //
+    //   - _member_metadata_cache holds member metadata for the current
+    //     generation's protocol. it is built lazily for the leader's join
+    //     response, reused by join response resends, and cleared whenever
+    //     membership or the generation changes.
+    std::optional<duration_type> _max_rebalance_timeout;
+    mutable std::optional<std::vector<join_group_response_member>>
+      _member_metadata_cache;
 };
 
 using group_ptr = ss::lw_shared_ptr<group>;
@@ -17,6 +17,11 @@
 #include "model/record.h"
 #include "resource_mgmt/io_priority.h"
 
+#include <boost/range/irange.hpp>
+
+#include <utility>
+#include <vector>
+
 namespace kafka {
 
 ss::future<> group_manager::start() {
@@ -57,7 +62,10 @@ ss::future<> group_manager::stop() {
         e.second->as.request_abort();
     }
 
-    return _gate.close();
+    return ss::parallel_for_each(
+             _partitions,
+             [](auto& e) { return e.second->batcher->stop(); })
+      .then([this] { return _gate.close(); });
 }
 
 void group_manager::attach_partition(ss::lw_shared_ptr<cluster::partition> p) {
@@ -106,6 +114,66 @@ ss::future<> group_manager::inject_noop(
       .discard_result();
 }
 
+// number of offset ranges read concurrently while recovering a metadata
+// partition. recovery used to replay the whole log through one reader;
+// splitting it keeps several segment reads in flight and shrinks the
+// coordinator warm-up blackout on large partitions
+static constexpr size_t recovery_read_fanout = 4;
+
+static std::vector<std::pair<model::offset, model::offset>>
+recovery_ranges(model::offset start, model::offset committed) {
+    std::vector<std::pair<model::offset, model::offset>> ranges;
+    auto max = model::model_limits<model::offset>::max();
+    int64_t total = committed() - start() + 1;
+    int64_t chunk = total / static_cast<int64_t>(recovery_read_fanout);
+    if (total <= 0 || chunk <= 0) {
+        // empty or tiny log, a single reader covers it
+        ranges.emplace_back(start, max);
+        return ranges;
+    }
+    auto base = start;
+    for (size_t i = 0; i + 1 < recovery_read_fanout; ++i) {
+        auto last = base + model::offset(chunk - 1);
+        ranges.emplace_back(base, last);
+        base = last + model::offset(1);
+    }
+    // the final range is unbounded, exactly like the single reader was
+    ranges.emplace_back(base, max);
+    return ranges;
+}
+
+/*
+ * Folds per-range recovery state into a single consumer, in ascending
+ * range order. A batch straddling a range boundary is consumed by both
+ * neighbouring readers; the merge tolerates that because re-applying the
+ * same batch produces the same state and offset entries carry the offset
+ * they were recovered at.
+ */
+static recovery_batch_consumer
+merge_recovery_chunks(std::vector<recovery_batch_consumer> chunks) {
+    auto merged = std::move(chunks.front());
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        auto& c = chunks[i];
+        for (auto& e : c.loaded_groups) {
+            merged.removed_groups.erase(e.first);
+            merged.loaded_groups[e.first] = std::move(e.second);
+        }
+        for (auto& g : c.removed_groups) {
+            merged.loaded_groups.erase(g);
+            merged.removed_groups.emplace(g);
+        }
+        for (auto& e : c.loaded_offsets) {
+            auto it = merged.loaded_offsets.find(e.first);
+            if (
+              it == merged.loaded_offsets.end()
+              || it->second.first <= e.second.first) {
+                merged.loaded_offsets[e.first] = std::move(e.second);
+            }
+        }
+    }
+    return merged;
+}
+
 ss::future<> group_manager::handle_partition_leader_change(
   ss::lw_shared_ptr<attached_partition> p,
   std::optional<model::node_id> leader_id) {
@@ -130,28 +198,58 @@ ss::future<> group_manager::handle_partition_leader_change(
              * based on the record keys, so this code should be ready to
              * transparently take advantage of key-based compaction in the
              * future.
+             *
+             * the read is split into offset ranges consumed concurrently
+             * and the per-range state is merged into a single view before
+             * the group/offset tables are rebuilt.
              */
-            storage::log_reader_config reader_config(
-              p->partition->start_offset(),
-              model::model_limits<model::offset>::max(),
-              0,
-              std::numeric_limits<size_t>::max(),
-              kafka_read_priority(),
-              raft::data_batch_type,
-              std::nullopt,
-              std::nullopt);
-
-            return p->partition->make_reader(reader_config)
-              .then([this, p, timeout](model::record_batch_reader reader) {
-                  return std::move(reader)
-                    .consume(recovery_batch_consumer(&p->as), timeout)
-                    .then([this, p](recovery_batch_consumer ctx) {
-                        // avoid trying to recover if we stopped the reader
+            auto ranges = recovery_ranges(
+              p->partition->start_offset(), p->partition->committed_offset());
+
+            std::vector<recovery_batch_consumer> chunks;
+            chunks.reserve(ranges.size());
+            for (size_t i = 0; i < ranges.size(); ++i) {
+                chunks.emplace_back(&p->as);
+            }
+
+            return ss::do_with(
+              std::move(chunks),
+              std::move(ranges),
+              [this, p, timeout](
+                std::vector<recovery_batch_consumer>& chunks,
+                std::vector<std::pair<model::offset, model::offset>>& ranges) {
+                  return ss::parallel_for_each(
+                           boost::irange<size_t>(0, ranges.size()),
+                           [p, timeout, &chunks, &ranges](size_t i) {
+                               storage::log_reader_config reader_config(
+                                 ranges[i].first,
+                                 ranges[i].second,
+                                 0,
+                                 std::numeric_limits<size_t>::max(),
+                                 kafka_read_priority(),
+                                 raft::data_batch_type,
+                                 std::nullopt,
+                                 std::nullopt);
+
+                               return p->partition->make_reader(reader_config)
+                                 .then([&chunks, i, timeout](
+                                         model::record_batch_reader reader) {
+                                     return std::move(reader)
+                                       .consume(std::move(chunks[i]), timeout)
+                                       .then([&chunks,
+                                              i](recovery_batch_consumer c) {
+                                           chunks[i] = std::move(c);
+                                       });
+                                 });
+                           })
+                    .then([this, p, &chunks] {
+                        // avoid trying to recover if we stopped the readers
                         // because an abort was requested
                         if (p->as.abort_requested()) {
                             return ss::make_ready_future<>();
                         }
-                        return recover_partition(p->partition, std::move(ctx))
+                        return recover_partition(
+                                 p, merge_recovery_chunks(std::move(chunks)))
                           .then([p] { p->loading = false; });
                     });
               });
@@ -168,7 +266,7 @@ ss::future<> group_manager::handle_partition_leader_change(
  * dependencies that would support optimizing for moves.
  */
 ss::future<> group_manager::recover_partition(
-  ss::lw_shared_ptr<cluster::partition> p, recovery_batch_consumer ctx) {
+  ss::lw_shared_ptr<attached_partition> p, recovery_batch_consumer ctx) {
     /*
      * [group-id -> [topic-partition -> offset-metadata]]
      */
@@ -206,7 +304,8 @@ ss::future<> group_manager::recover_partition(
             continue;
         }
 
-        group = ss::make_lw_shared<kafka::group>(e.first, e.second, _conf, p);
+        group = ss::make_lw_shared<kafka::group>(
+          e.first, e.second, _conf, p->partition, p->batcher);
 
         for (auto& e : offsets) {
             group->insert_offset(
@@ -230,7 +329,7 @@ ss::future<> group_manager::recover_partition(
         }
 
         group = ss::make_lw_shared<kafka::group>(
-          e.first, group_state::empty, _conf, p);
+          e.first, group_state::empty, _conf, p->partition, p->batcher);
 
         for (auto& e : e.second) {
             group->insert_offset(
@@ -409,7 +508,7 @@ group_manager::join_group(join_group_request&& r) {
         }
         auto p = it->second->partition;
         group = ss::make_lw_shared<kafka::group>(
-          r.data.group_id, group_state::empty, _conf, p);
+          r.data.group_id, group_state::empty, _conf, p, it->second->batcher);
         _groups.emplace(r.data.group_id, group);
         klog.trace("created new group {}", group);
         is_new_group = true;
@@ -91,11 +91,17 @@ struct recovery_batch_consumer;
  * - Recovery occurs when the local node is leader, else unload (below)
  *
  * The recovery process reads the entire log and deduplicates entries into the
- * `recovery_batch_consumer` object.
+ * `recovery_batch_consumer` object. The log is split into offset ranges that
+ * are read concurrently, one consumer per range, and the per-range state is
+ * merged in range order into a single consistent view.
  *
  * After the log is read the deduplicated state is used to re-populate the
  * in-memory cache of groups/commits through.
  *
+ * Requests (including read-only offset fetches) are only served once the
+ * full log has been consumed: any partially recovered view may be missing
+ * newer commits, and returning stale offsets would rewind consumers.
+ *
  * Unload (background)
  * ===================
  *
@@ -174,10 +180,14 @@ private:
         ss::semaphore sem{1};
         ss::abort_source as;
         ss::lw_shared_ptr<cluster::partition> partition;
+        // shared by all groups mapped to this partition, coalesces their
+        // offset commit appends into combined replications
+        ss::lw_shared_ptr<offset_commit_batcher> batcher;
 
         attached_partition(ss::lw_shared_ptr<cluster::partition> p)
           : loading(true)
-          , partition(std::move(p)) {}
+          , partition(std::move(p))
+          , batcher(ss::make_lw_shared<offset_commit_batcher>(partition)) {}
     };
 
     absl::flat_hash_map<model::ntp, ss::lw_shared_ptr<attached_partition>>
@@ -193,7 +203,7 @@ private:
       std::optional<model::node_id> leader_id);
 
     ss::future<> recover_partition(
-      ss ::lw_shared_ptr<cluster::partition>, recovery_batch_consumer);
+      ss::lw_shared_ptr<attached_partition>, recovery_batch_consumer);
 
     ss::future<> inject_noop(
       ss::lw_shared_ptr<cluster::partition> p,
@@ -24,11 +24,17 @@
 #include "kafka/types.h"
 #include "seastarx.h"
 
+#include <seastar/core/future-util.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/core/reactor.hh>
 #include <seastar/core/scheduling.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/util/noncopyable_function.hh>
 
+#include <memory>
+#include <optional>
 #include <type_traits>
+#include <vector>
 
 namespace kafka {
 
@@ -39,8 +45,33 @@ namespace kafka {
  * mapped to its associated ntp using the coordinator_ntp_mapper. Given the ntp
  * the owning shard is found using the cluster::shard_table. Finally, a x-core
  * operation on the destination shard's group manager is invoked.
+ *
+ * Operations are not submitted individually. A heartbeat heavy group
+ * workload routes tens of thousands of tiny operations per second, and a
+ * cross core submission apiece keeps the smp queues busy with single-op
+ * messages. Instead every operation is staged in a per destination shard
+ * batch and all operations staged within one reactor poll travel in a
+ * single submission; their results come back together and each caller's
+ * future is resolved on the origin shard.
  */
 class group_router final {
+    /// result of a staged operation. written on the owning shard, read on
+    /// the origin shard strictly after the batch submission resolved
+    template<typename T>
+    struct result_slot {
+        std::optional<T> value;
+        std::exception_ptr ex;
+    };
+
+    struct staged_op {
+        /// executes on the owning shard
+        ss::noncopyable_function<ss::future<>(group_manager&)> run;
+        /// resolves the caller's future back on the origin shard. a
+        /// non-null exception means the batch submission itself failed
+        ss::noncopyable_function<void(std::exception_ptr)> complete;
+    };
+    using op_batch = std::vector<staged_op>;
+
     template<typename Request, typename FwdFunc>
     auto route(Request&& r, FwdFunc func) {
         // get response type from FwdFunc it has return future<response>.
@@ -51,19 +82,87 @@ class group_router final {
         using resp_type = typename return_type::value_type;
 
         auto m = shard_for(r.data.group_id);
-        if (!m) {
+        if (!m || _gate.is_closed()) {
             return ss::make_ready_future<resp_type>(
               resp_type(r, error_code::not_coordinator));
         }
         r.ntp = std::move(m->first);
+
+        auto slot = std::make_unique<result_slot<resp_type>>();
+        auto* s = slot.get();
+        ss::promise<resp_type> p;
+        auto fut = p.get_future();
+        enqueue(
+          m->second,
+          staged_op{
+            .run =
+              [func, r = std::move(r), s](group_manager& mgr) mutable {
+                  return std::invoke(func, mgr, std::move(r))
+                    .then_wrapped([s](ss::future<resp_type> f) {
+                        if (f.failed()) {
+                            s->ex = f.get_exception();
+                        } else {
+                            s->value = f.get0();
+                        }
+                    });
+              },
+            .complete =
+              [p = std::move(p),
+               slot = std::move(slot)](std::exception_ptr ex) mutable {
+                  if (ex) {
+                      p.set_exception(std::move(ex));
+                  } else if (slot->ex) {
+                      p.set_exception(slot->ex);
+                  } else {
+                      p.set_value(std::move(*slot->value));
+                  }
+              },
+          });
+        return fut;
+    }
+
+    void enqueue(ss::shard_id shard, staged_op op) {
+        auto& batch = _batches[shard];
+        batch.push_back(std::move(op));
+        if (batch.size() == 1) {
+            // first op for this shard in the current poll; flush once the
+            // poll's remaining route calls had a chance to stage
+            (void)ss::with_gate(_gate, [this, shard] {
+                return ss::later().then([this, shard] { return flush(shard); });
+            });
+        }
+    }
+
+    ss::future<> flush(ss::shard_id shard) {
+        auto batch = std::make_unique<op_batch>(
+          std::exchange(_batches[shard], op_batch{}));
+        if (batch->empty()) {
+            return ss::now();
+        }
+        /*
+         * the batch stays owned by the origin shard. the owning shard only
+         * runs the staged operations through a pointer, so the requests,
+         * promises and result slots are created and destroyed at home.
+         */
+        auto* b = batch.get();
         return with_scheduling_group(
-          _sg, [this, func, shard = m->second, r = std::move(r)]() mutable {
-              return _group_manager.invoke_on(
-                shard,
-                _ssg,
-                [func, r = std::move(r)](group_manager& mgr) mutable {
-                    return std::invoke(func, mgr, std::move(r));
-                });
+                 _sg,
+                 [this, shard, b] {
+                     return _group_manager.invoke_on(
+                       shard, _ssg, [b](group_manager& mgr) {
+                           return ss::parallel_for_each(
+                             *b,
+                             [&mgr](staged_op& op) { return op.run(mgr); });
+                       });
+                 })
+          .then_wrapped([batch = std::move(batch)](ss::future<> f) {
+              std::exception_ptr ex;
+              if (f.failed()) {
+                  ex = f.get_exception();
+              }
+              for (auto& op : *batch) {
+                  op.complete(ex);
+              }
           });
     }
 
@@ -78,7 +177,11 @@ public:
       , _ssg(smp_group)
       , _group_manager(group_manager)
       , _shards(shards)
-      , _coordinators(coordinators) {}
+      , _coordinators(coordinators)
+      , _batches(ss::smp::count) {}
+
+    /// waits for the staged batches scheduled for flush to drain
+    ss::future<> stop() { return _gate.close(); }
 
     auto join_group(join_group_request&& request) {
         return route(std::move(request), &group_manager::join_group);
@@ -153,6 +256,10 @@ private:
     ss::sharded<group_manager>& _group_manager;
     ss::sharded<cluster::shard_table>& _shards;
     ss::sharded<coordinator_ntp_mapper>& _coordinators;
+    // operations staged for each destination shard during the current
+    // reactor poll
+    std::vector<op_batch> _batches;
+    ss::gate _gate;
 };
 
 } // namespace kafka
@@ -0,0 +1,102 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/groups/offset_commit_batcher.h"
+
+#include "model/record_batch_reader.h"
+#include "raft/errc.h"
+
+#include <utility>
+
+namespace kafka {
+
+ss::future<result<raft::replicate_result>>
+offset_commit_batcher::replicate(model::record_batch batch) {
+    if (_gate.is_closed()) {
+        return ss::make_ready_future<result<raft::replicate_result>>(
+          raft::errc::not_leader);
+    }
+    auto record_count = batch.header().record_count;
+    _pending.push_back(pending_commit{
+      .batch = std::move(batch),
+      .record_count = record_count,
+    });
+    auto f = _pending.back().done.get_future();
+    maybe_flush();
+    return f;
+}
+
+void offset_commit_batcher::maybe_flush() {
+    if (_flush_in_flight || _pending.empty() || _gate.is_closed()) {
+        return;
+    }
+    _flush_in_flight = true;
+    (void)ss::with_gate(_gate, [this] {
+        return flush().finally([this] {
+            _flush_in_flight = false;
+            // pick up commits that arrived while we were replicating
+            maybe_flush();
+        });
+    });
+}
+
+ss::future<> offset_commit_batcher::flush() {
+    auto pending = std::exchange(_pending, {});
+    model::record_batch_reader::data_t batches;
+    batches.reserve(pending.size());
+    for (auto& p : pending) {
+        batches.push_back(std::move(p.batch));
+    }
+    auto reader = model::make_memory_record_batch_reader(std::move(batches));
+    return _partition
+      ->replicate(
+        std::move(reader),
+        raft::replicate_options(raft::consistency_level::quorum_ack))
+      .then_wrapped([pending = std::move(pending)](
+                      ss::future<result<raft::replicate_result>> f) mutable {
+          if (f.failed()) {
+              auto e = f.get_exception();
+              for (auto& p : pending) {
+                  p.done.set_exception(e);
+              }
+              return;
+          }
+          auto r = f.get0();
+          if (!r) {
+              for (auto& p : pending) {
+                  p.done.set_value(r);
+              }
+              return;
+          }
+          /*
+           * the combined append assigned contiguous offsets ending at the
+           * reported last offset. walk the batches backwards to recover
+           * the last offset of each individual batch from its record
+           * count.
+           */
+          auto offset = r.value().last_offset;
+          for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+              it->done.set_value(result<raft::replicate_result>(
+                raft::replicate_result{.last_offset = offset}));
+              offset = offset - model::offset(it->record_count);
+          }
+      });
+}
+
+ss::future<> offset_commit_batcher::stop() {
+    return _gate.close().then([this] {
+        auto pending = std::exchange(_pending, {});
+        for (auto& p : pending) {
+            p.done.set_value(
+              result<raft::replicate_result>(raft::errc::not_leader));
+        }
+    });
+}
+
+} // namespace kafka
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "cluster/partition.h"
+#include "model/record.h"
+#include "outcome.h"
+#include "raft/types.h"
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include <vector>
+
+namespace kafka {
+
+/**
+ * Coalesces offset commit appends to a group metadata partition.
+ *
+ * Without batching every offset commit request becomes its own raft
+ * replication, so a thousand consumers committing every second produce a
+ * thousand tiny quorum round trips on the same partition. The batcher
+ * uses the group commit pattern instead: the first commit starts a
+ * replication immediately, and commits arriving while it is in flight
+ * are buffered and shipped together as a single append once it
+ * completes. Replication traffic then scales with the replication round
+ * trip rather than with the number of committers, and an idle commit
+ * pays no extra latency.
+ *
+ * One batcher is shared by all groups mapped to the same metadata
+ * partition (see group_manager::attached_partition).
+ */
+class offset_commit_batcher {
+public:
+    explicit offset_commit_batcher(ss::lw_shared_ptr<cluster::partition> p)
+      : _partition(std::move(p)) {}
+
+    /**
+     * Enqueue a commit batch. The returned future resolves once the
+     * batch has been replicated, with the last offset assigned to this
+     * batch (not the combined append), so callers can track per commit
+     * log offsets exactly as with an individual replication.
+     */
+    ss::future<result<raft::replicate_result>> replicate(model::record_batch);
+
+    /// fails all buffered commits and waits for in flight flushes
+    ss::future<> stop();
+
+private:
+    struct pending_commit {
+        model::record_batch batch;
+        int32_t record_count{0};
+        ss::promise<result<raft::replicate_result>> done;
+    };
+
+    void maybe_flush();
+    ss::future<> flush();
+
+    ss::lw_shared_ptr<cluster::partition> _partition;
+    std::vector<pending_commit> _pending;
+    bool _flush_in_flight{false};
+    ss::gate _gate;
+};
+
+} // namespace kafka
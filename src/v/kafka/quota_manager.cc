@@ -11,8 +11,11 @@
 
 #include "config/configuration.h"
 #include "kafka/logger.h"
+#include "prometheus/prometheus_sanitize.h"
 #include "vlog.h"
 
+#include <seastar/core/metrics.hh>
+
 namespace kafka {
 using clock = quota_manager::clock;
 using throttle_delay = quota_manager::throttle_delay;
@@ -25,15 +28,36 @@ ss::future<> quota_manager::stop() {
 }
 
 ss::future<> quota_manager::start() {
+    setup_metrics();
     _gc_timer.arm_periodic(_gc_freq);
     return ss::make_ready_future<>();
 }
 
-// record a new observation and return <previous delay, new delay>
-throttle_delay quota_manager::record_tp_and_throttle(
-  std::optional<std::string_view> client_id,
-  uint64_t bytes,
-  clock::time_point now) {
+void quota_manager::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+
+    namespace sm = ss::metrics;
+
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("kafka:quotas"),
+      {sm::make_derive(
+         "throttled_requests",
+         [this] { return _throttled_requests; },
+         sm::description("Number of requests that incurred a throttle delay")),
+       sm::make_derive(
+         "throttle_time_ms",
+         [this] { return _throttle_time_ms; },
+         sm::description("Accumulated throttle delay in milliseconds")),
+       sm::make_gauge(
+         "tracked_clients",
+         [this] { return _quotas.size(); },
+         sm::description("Number of clients with tracked quota state"))});
+}
+
+quota_manager::quota_handle quota_manager::get_quota(
+  std::optional<std::string_view> client_id, clock::time_point now) {
     // requests without a client id are grouped into an anonymous group that
     // shares a default quota. the anonymous group is keyed on empty string.
     auto cid = client_id ? *client_id : "";
@@ -45,59 +69,79 @@ throttle_delay quota_manager::record_tp_and_throttle(
     // equal_to<> overload. this is a general issue we'll be looking at. for
     // now, these client-name strings are small. This will be solved in
     // c++20 via Hash::transparent_key_equal.
-    auto [it, inserted] = _quotas.try_emplace(
-      ss::sstring(cid),
-      quota{
-        now,
-        clock::duration(0),
-        {_default_num_windows, _default_window_width}});
+    auto [it, inserted] = _quotas.try_emplace(ss::sstring(cid), nullptr);
+    if (inserted) {
+        it->second = ss::make_lw_shared<quota>(quota{
+          it->first,
+          now,
+          clock::duration(0),
+          {_default_num_windows, _default_window_width}});
+    }
+    return it->second;
+}
 
+// record a new observation and return <previous delay, new delay>
+throttle_delay quota_manager::record_tp_and_throttle(
+  std::optional<std::string_view> client_id,
+  uint64_t bytes,
+  clock::time_point now) {
+    return record_tp_and_throttle(get_quota(client_id, now), bytes, now);
+}
+
+throttle_delay quota_manager::record_tp_and_throttle(
+  const quota_handle& q, uint64_t bytes, clock::time_point now) {
     // bump to prevent gc
-    if (!inserted) {
-        it->second.last_seen = now;
-    }
+    q->last_seen = now;
 
-    auto rate = it->second.tp_rate.record_and_measure(bytes, now);
+    auto rate = q->tp_rate.record_and_measure(bytes, now);
 
     uint64_t delay_ms = 0;
-    if (rate > _target_tp_rate) {
-        auto diff = rate - _target_tp_rate;
+    if (rate > _target_tp_rate()) {
+        auto diff = rate - _target_tp_rate();
         double delay
-          = (diff / _target_tp_rate)
+          = (diff / _target_tp_rate())
             * (double)std::chrono::duration_cast<std::chrono::milliseconds>(
-                it->second.tp_rate.window_size())
+                q->tp_rate.window_size())
                 .count();
         delay_ms = static_cast<uint64_t>(delay);
     }
-    if (delay_ms > (uint64_t)_max_delay.count()) {
+    if (delay_ms > (uint64_t)_max_delay().count()) {
         vlog(
           klog.info,
           "Found data rate for window of: {} bytes. Client:{}, Estimated "
           "backpressure delay of {}ms. Limiting to {}ms backpressure delay",
           rate,
-          cid,
+          q->client_id,
           delay_ms,
-          _max_delay.count());
-        delay_ms = _max_delay.count();
+          _max_delay().count());
+        delay_ms = _max_delay().count();
+    }
+    if (delay_ms > 0) {
+        _throttled_requests++;
+        _throttle_time_ms += delay_ms;
     }
 
-    auto prev = it->second.delay;
-    it->second.delay = std::chrono::milliseconds(delay_ms);
+    auto prev = q->delay;
+    q->delay = std::chrono::milliseconds(delay_ms);
 
     throttle_delay res{};
     res.first_violation = prev.count() == 0;
-    res.duration = it->second.delay;
+    res.duration = q->delay;
     return res;
 }
 // erase inactive tracked quotas. windows are considered inactive if they
-// have not received any updates in ten window's worth of time.
+// have not received any updates in ten window's worth of time. entries
+// still referenced by a cached handle are kept even when idle so that
+// handles held by open connections never point at orphaned state.
 void quota_manager::gc(clock::duration full_window) {
     auto now = clock::now();
     auto expire_age = full_window * 10;
     // c++20: replace with std::erase_if
     absl::erase_if(
-      _quotas, [now, expire_age](const std::pair<ss::sstring, quota>& q) {
-          return (now - q.second.last_seen) > expire_age;
+      _quotas,
+      [now, expire_age](const std::pair<ss::sstring, quota_handle>& q) {
+          return (now - q.second->last_seen) > expire_age
+                 && q.second.use_count() == 1;
       });
 }
 
@@ -16,6 +16,8 @@
 
 #include <seastar/core/future.hh>
 #include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/timer.hh>
 
@@ -53,12 +55,34 @@ public:
         clock::duration duration;
     };
 
+    // client_id: the tracking key, kept for logging
+    // last_seen: used for gc keepalive
+    // delay: last calculated delay
+    // tp_rate: throughput tracking
+    struct quota {
+        ss::sstring client_id;
+        clock::time_point last_seen;
+        clock::duration delay;
+        rate_tracker tp_rate;
+    };
+
+    /**
+     * Reference to a client's quota entry that may be cached across
+     * requests. A connection serving a stream of requests for the same
+     * client can hold on to the handle to skip the per request key
+     * allocation and map lookup. Handles keep the entry alive: the
+     * garbage collector only drops entries that are both inactive and
+     * unreferenced.
+     */
+    using quota_handle = ss::lw_shared_ptr<quota>;
+
     quota_manager()
       : _default_num_windows(config::shard_local_cfg().default_num_windows())
       , _default_window_width(config::shard_local_cfg().default_window_sec())
-      , _target_tp_rate(config::shard_local_cfg().target_quota_byte_rate())
+      , _target_tp_rate(config::shard_local_cfg().target_quota_byte_rate.bind())
       , _gc_freq(config::shard_local_cfg().quota_manager_gc_sec())
-      , _max_delay(config::shard_local_cfg().max_kafka_throttle_delay_ms()) {
+      , _max_delay(
+          config::shard_local_cfg().max_kafka_throttle_delay_ms.bind()) {
         auto full_window = _default_num_windows * _default_window_width;
         _gc_timer.set_callback([this, full_window] { gc(full_window); });
     }
@@ -74,36 +98,48 @@ public:
 
     ss::future<> start();
 
+    // find or create the quota entry tracking the given client
+    quota_handle get_quota(
+      std::optional<std::string_view> client_id,
+      clock::time_point now = clock::now());
+
     // record a new observation and return <previous delay, new delay>
     throttle_delay record_tp_and_throttle(
       std::optional<std::string_view> client_id,
       uint64_t bytes,
       clock::time_point now = clock::now());
 
+    // record a new observation against a cached quota handle
+    throttle_delay record_tp_and_throttle(
+      const quota_handle& q,
+      uint64_t bytes,
+      clock::time_point now = clock::now());
+
 private:
     // erase inactive tracked quotas. windows are considered inactive if they
     // have not received any updates in ten window's worth of time.
     void gc(clock::duration full_window);
 
-private:
-    // last_seen: used for gc keepalive
-    // delay: last calculated delay
-    // tp_rate: throughput tracking
-    struct quota {
-        clock::time_point last_seen;
-        clock::duration delay;
-        rate_tracker tp_rate;
-    };
+    void setup_metrics();
 
+private:
+    // window geometry is fixed at construction since the per client rate
+    // trackers are built from it; the throttling knobs are bindings so
+    // runtime changes take effect without a restart
     const std::size_t _default_num_windows;
     const clock::duration _default_window_width;
 
-    const uint32_t _target_tp_rate;
-    absl::flat_hash_map<ss::sstring, quota> _quotas;
+    config::binding<uint32_t> _target_tp_rate;
+    absl::flat_hash_map<ss::sstring, quota_handle> _quotas;
 
     ss::timer<> _gc_timer;
     const clock::duration _gc_freq;
-    const clock::duration _max_delay;
+    config::binding<std::chrono::milliseconds> _max_delay;
+
+    // throttling totals exposed as metrics
+    uint64_t _throttled_requests{0};
+    uint64_t _throttle_time_ms{0};
+    ss::metrics::metric_groups _metrics;
 };
 
 } // namespace kafka
@@ -9,6 +9,7 @@
 
 #include "kafka/requests/fetch_request.h"
 
+#include "cluster/metadata_cache.h"
 #include "cluster/partition_manager.h"
 #include "config/configuration.h"
 #include "kafka/errors.h"
@@ -18,7 +19,9 @@
 #include "model/fundamental.h"
 #include "model/namespace.h"
 #include "model/timeout_clock.h"
+#include "raft/offset_monitor.h"
 #include "resource_mgmt/io_priority.h"
+#include "utils/stage_tracer.h"
 #include "utils/to_string.h"
 
 #include <seastar/core/do_with.hh>
@@ -75,6 +78,9 @@ void fetch_request::encode(response_writer& writer, api_version version) {
                 [](int32_t p, response_writer& writer) { writer.write(p); });
           });
     }
+    if (version >= api_version(11)) {
+        writer.write(rack_id);
+    }
 }
 
 void fetch_request::decode(request_context& ctx) {
@@ -117,11 +123,13 @@ void fetch_request::decode(request_context& ctx) {
         forgotten_topics = reader.read_array([](request_reader& reader) {
             return forgotten_topic{
               .name = model::topic(reader.read_string()),
-              .partitions = reader.read_array(
-                [](request_reader& reader) { return reader.read_int32(); }),
+              .partitions = reader.read_be_array<int32_t>(),
             };
         });
     }
+    if (version >= api_version(11)) {
+        rack_id = reader.read_nullable_string();
+    }
 }
 
 std::ostream&
@@ -149,7 +157,7 @@ std::ostream& operator<<(std::ostream& o, const fetch_request& r) {
     fmt::print(
       o,
       "{{replica {} max_wait_time {} session_id {} session_epoch {} min_bytes "
-      "{} max_bytes {} isolation {} topics {} forgotten {}}}",
+      "{} max_bytes {} isolation {} topics {} forgotten {} rack_id {}}}",
       r.replica_id,
       r.max_wait_time,
       r.session_id,
@@ -158,13 +166,16 @@ std::ostream& operator<<(std::ostream& o, const fetch_request& r) {
       r.max_bytes,
       r.isolation_level,
       r.topics,
-      r.forgotten_topics);
+      r.forgotten_topics,
+      r.rack_id);
     return o;
 }
 
 void fetch_response::encode(const request_context& ctx, response& resp) {
-    auto& writer = resp.writer();
-    auto version = ctx.header().version;
+    encode(resp.writer(), ctx.header().version);
+}
+
+void fetch_response::encode(response_writer& writer, api_version version) {
 
     writer.write(int32_t(throttle_time.count())); // v1
 
@@ -192,6 +203,9 @@ void fetch_response::encode(const request_context& ctx, response& resp) {
                       writer.write(t.producer_id);
                       writer.write(int64_t(t.first_offset));
                   });
+                if (version >= api_version(11)) {
+                    writer.write(r.preferred_read_replica);
+                }
                 writer.write(std::move(r.record_set));
             });
       });
@@ -224,12 +238,32 @@ void fetch_response::decode(iobuf buf, api_version version) {
                       .first_offset = model::offset(reader.read_int64()),
                     };
                 }),
+              .preferred_read_replica = model::node_id(
+                version >= api_version(11) ? reader.read_int32() : -1),
               .record_set = reader.read_fragmented_nullable_bytes()};
         });
         return p;
     });
 }
 
+size_t fetch_response::size_estimate() const {
+    // throttle_time, error, session_id and the topic array length; slight
+    // over-estimates for fields gated behind older versions are fine, the
+    // reservation is an upper bound on the fixed-layout bytes
+    size_t size = 3 * sizeof(int32_t) + sizeof(int16_t);
+    for (const auto& t : partitions) {
+        size += sizeof(int16_t) + t.name().size() + sizeof(int32_t);
+        for (const auto& r : t.responses) {
+            // id, aborted array and record set lengths, preferred replica,
+            // error, three offsets, aborted transaction entries
+            size += 4 * sizeof(int32_t) + sizeof(int16_t)
+                    + 3 * sizeof(int64_t)
+                    + r.aborted_transactions.size() * 2 * sizeof(int64_t);
+        }
+    }
+    return size;
+}
+
 std::ostream&
 operator<<(std::ostream& o, const fetch_response::aborted_transaction& t) {
     fmt::print(
@@ -289,11 +323,16 @@ static ss::future<read_result> read_from_partition(
   fetch_config config,
   bool foreign_read,
   std::optional<model::timeout_clock::time_point> deadline) {
-    auto hw = pw.high_watermark();
-    auto lso = pw.last_stable_offset();
-    // if we have no data read, return fast
-    if (hw < config.start_offset) {
-        return ss::make_ready_future<read_result>(hw, lso);
+    std::optional<model::timeout_clock::time_point> debounce_deadline;
+    // if we have no data to read, either return fast or park on the
+    // partition offset monitor until new data is visible or the debounce
+    // deadline expires
+    if (pw.high_watermark() < config.start_offset) {
+        if (!config.debounce_deadline) {
+            return ss::make_ready_future<read_result>(
+              pw.high_watermark(), pw.last_stable_offset());
+        }
+        debounce_deadline = config.debounce_deadline;
     }
 
     storage::log_reader_config reader_config(
@@ -307,13 +346,24 @@ static ss::future<read_result> read_from_partition(
       std::nullopt);
 
     reader_config.strict_max_bytes = config.strict_max_bytes;
-    return pw.make_reader(reader_config)
-      .then([hw, lso, foreign_read, deadline](model::record_batch_reader rdr) {
+    // sampled egress trace: reader creation covers any debounce wait,
+    // the read stage covers pulling the batches off disk or cache
+    auto trace = tracing::stage_tracer::shard_local().maybe_sample("fetch");
+    return pw.make_reader(reader_config, debounce_deadline)
+      .then([pw, foreign_read, deadline, trace = std::move(trace)](
+              model::record_batch_reader rdr) mutable {
+          trace.stage("reader_made");
+          // offsets are read after the reader is created, a read woken up by
+          // the offset monitor sees the advanced watermarks
+          auto hw = pw.high_watermark();
+          auto lso = pw.last_stable_offset();
           // if we are on remote core, we MUST use foreign record batch reader.
           if (foreign_read) {
               return model::consume_reader_to_memory(
                        std::move(rdr), deadline.value_or(model::no_timeout))
-                .then([hw, lso](ss::circular_buffer<model::record_batch> data) {
+                .then([hw, lso, trace = std::move(trace)](
+                        ss::circular_buffer<model::record_batch> data) mutable {
+                    trace.stage("read");
                     return read_result(
                       model::make_foreign_memory_record_batch_reader(
                         std::move(data)),
@@ -323,7 +373,12 @@ static ss::future<read_result> read_from_partition(
           }
           return ss::make_ready_future<read_result>(
             read_result(std::move(rdr), hw, lso));
-      });
+      })
+      .handle_exception_type(
+        [pw](const raft::offset_monitor::wait_aborted&) {
+            // debounce deadline expired with no new data
+            return read_result(pw.high_watermark(), pw.last_stable_offset());
+        });
 }
 
 std::optional<partition_wrapper> make_partition_wrapper(
@@ -358,8 +413,16 @@ ss::future<read_result> read_from_ntp(
           error_code::unknown_topic_or_partition);
     }
     if (unlikely(!partition->is_leader())) {
-        return ss::make_ready_future<read_result>(
-          error_code::not_leader_for_partition);
+        if (!config::shard_local_cfg().enable_follower_fetching()) {
+            return ss::make_ready_future<read_result>(
+              error_code::not_leader_for_partition);
+        }
+        /*
+         * follower reads are bounded-staleness by construction: the raft
+         * layer caps every reader at last_visible_index, which a follower
+         * only advances as the leader's commit index reaches it, so a
+         * follower can never serve uncommitted (truncatable) data.
+         */
     }
     auto partition_wpr = make_partition_wrapper(ntp, partition, mgr);
     if (!partition_wpr) {
@@ -470,10 +533,6 @@ handle_shard_fetch(ss::shard_id shard, op_context& octx, shard_fetch fetch) {
     if (octx.bytes_left <= 0) {
         return ss::now();
     }
-    // no requests for this shard, do nothing
-    if (fetch.requests.empty()) {
-        return ss::now();
-    }
 
     bool foreign_read = shard != ss::this_shard_id();
 
@@ -536,6 +595,18 @@ static std::vector<shard_fetch> group_requests_by_shard(op_context& octx) {
             .timeout = octx.deadline.value_or(model::no_timeout),
             .strict_max_bytes = octx.response_size > 0,
           };
+          /**
+           * retry rounds long poll empty partitions: the read parks on the
+           * partition offset monitor and is woken the moment new data is
+           * visible. the wait is capped with the debounce timeout so that
+           * min_bytes is re-evaluated across all partitions every round
+           */
+          if (!octx.initial_fetch && octx.deadline) {
+              config.debounce_deadline = std::min(
+                *octx.deadline,
+                model::timeout_clock::now()
+                  + config::shard_local_cfg().fetch_reads_debounce_timeout());
+          }
           shard_fetches[*shard].push_back(
             std::move(materialized_ntp), config, resp_it++);
       });
@@ -573,6 +644,13 @@ static ss::future<> fetch_topic_partitions(op_context& octx) {
 
     ss::shard_id shard = 0;
     for (auto& shard_fetch : group_requests_by_shard(octx)) {
+        // do not dispatch to shards that have no partitions in the plan,
+        // a fetch for a few partitions would otherwise pay a no-op future
+        // per shard on every poll round
+        if (shard_fetch.empty()) {
+            ++shard;
+            continue;
+        }
         fetches.push_back(
           handle_shard_fetch(shard++, octx, std::move(shard_fetch)));
     }
@@ -593,6 +671,60 @@ static ss::future<> fetch_topic_partitions(op_context& octx) {
       });
 }
 
+/**
+ * KIP-392 rack aware replica selection: when a consumer advertises a rack
+ * id, point it at a replica whose broker sits in the same rack so its
+ * subsequent fetches stay rack-local. The leader itself is never returned,
+ * -1 (no preference) keeps the client on the leader. Replication fetches
+ * from other brokers are left alone.
+ */
+static void assign_preferred_read_replicas(op_context& octx) {
+    if (!config::shard_local_cfg().enable_follower_fetching()) {
+        return;
+    }
+    if (octx.rctx.header().version < api_version(11)) {
+        return;
+    }
+    if (!octx.request.rack_id || octx.request.rack_id->empty()) {
+        return;
+    }
+    if (octx.request.replica_id >= model::node_id(0)) {
+        return;
+    }
+    auto& cache = octx.rctx.metadata_cache();
+    for (auto& topic : octx.response.partitions) {
+        auto md = cache.get_topic_metadata(
+          model::topic_namespace_view(model::kafka_namespace, topic.name));
+        if (!md) {
+            continue;
+        }
+        for (auto& resp : topic.responses) {
+            if (resp.has_error()) {
+                continue;
+            }
+            auto p_md = std::find_if(
+              md->partitions.cbegin(),
+              md->partitions.cend(),
+              [id = resp.id](const model::partition_metadata& p) {
+                  return p.id == id;
+              });
+            if (p_md == md->partitions.cend()) {
+                continue;
+            }
+            for (auto& replica : p_md->replicas) {
+                if (p_md->leader_node == replica.node_id) {
+                    continue;
+                }
+                auto broker = cache.get_broker(replica.node_id);
+                if (broker && (*broker)->rack() == octx.request.rack_id) {
+                    resp.preferred_read_replica = replica.node_id;
+                    break;
+                }
+            }
+        }
+    }
+}
+
 ss::future<response_ptr>
 fetch_api::process(request_context&& rctx, ss::smp_service_group ssg) {
     return ss::do_with(op_context(std::move(rctx), ssg), [](op_context& octx) {
@@ -609,7 +741,10 @@ fetch_api::process(request_context&& rctx, ss::smp_service_group ssg) {
                 [&octx] { return octx.should_stop_fetch(); },
                 [&octx] { return fetch_topic_partitions(octx); });
           })
-          .then([&octx] { return std::move(octx).send_response(); });
+          .then([&octx] {
+              assign_preferred_read_replicas(octx);
+              return std::move(octx).send_response();
+          });
     });
 }
 
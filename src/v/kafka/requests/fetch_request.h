@@ -34,7 +34,7 @@ struct fetch_api final {
     static constexpr const char* name = "fetch";
     static constexpr api_key key = api_key(1);
     static constexpr api_version min_supported = api_version(4);
-    static constexpr api_version max_supported = api_version(10);
+    static constexpr api_version max_supported = api_version(11);
 
     static ss::future<response_ptr>
     process(request_context&&, ss::smp_service_group);
@@ -71,7 +71,8 @@ struct fetch_request final {
     int32_t session_id = invalid_fetch_session_id;          // >= v7
     int32_t session_epoch = final_fetch_session_epoch;      // >= v7
     std::vector<topic> topics;
-    std::vector<forgotten_topic> forgotten_topics; // >= v7
+    std::vector<forgotten_topic> forgotten_topics;  // >= v7
+    std::optional<ss::sstring> rack_id;             // >= v11
 
     void encode(response_writer& writer, api_version version);
     void decode(request_context& ctx);
@@ -221,6 +222,7 @@ struct fetch_response final {
         model::offset last_stable_offset;                      // >= v4
         model::offset log_start_offset;                        // >= v5
         std::vector<aborted_transaction> aborted_transactions; // >= v4
+        model::node_id preferred_read_replica{-1};             // >= v11
         std::optional<iobuf> record_set;
         /*
          * _not part of kafka protocol
@@ -247,8 +249,16 @@ struct fetch_response final {
     std::vector<partition> partitions;
 
     void encode(const request_context& ctx, response& resp);
+    void encode(response_writer& writer, api_version version);
     void decode(iobuf buf, api_version version);
 
+    /*
+     * bytes of fixed-layout encoding in this response, used to reserve the
+     * response buffer up front. record payloads are spliced in as whole
+     * fragments and deliberately excluded.
+     */
+    size_t size_estimate() const;
+
     friend std::ostream& operator<<(std::ostream&, const fetch_response&);
 
     /*
@@ -478,10 +488,14 @@ public:
       : _partition(partition)
       , _log(log) {}
 
-    ss::future<model::record_batch_reader>
-    make_reader(storage::log_reader_config config) {
+    ss::future<model::record_batch_reader> make_reader(
+      storage::log_reader_config config,
+      std::optional<model::timeout_clock::time_point> debounce_deadline
+      = std::nullopt) {
+        // materialized logs have no offset monitor to park on, reads from
+        // them always resolve immediately
         return _log ? _log->make_reader(config)
-                    : _partition->make_reader(config);
+                    : _partition->make_reader(config, debounce_deadline);
     }
 
     cluster::partition_probe& probe() { return _partition->probe(); }
@@ -506,6 +520,13 @@ struct fetch_config {
     size_t max_bytes;
     model::timeout_clock::time_point timeout;
     bool strict_max_bytes{false};
+    /**
+     * When set and the partition has no data at start_offset the read parks
+     * on the partition consumable offset monitor until new data is visible
+     * or the deadline expires, instead of returning empty and leaving the
+     * fetch loop to re-poll storage.
+     */
+    std::optional<model::timeout_clock::time_point> debounce_deadline;
 };
 /**
  * Simple type aggregating either reader and offsets or an error
@@ -15,6 +15,7 @@
 #include "kafka/requests/request_reader.h"
 #include "likely.h"
 #include "model/record.h"
+#include "model/record_utils.h"
 #include "raft/types.h"
 #include "storage/parser_utils.h"
 #include "vassert.h"
@@ -166,13 +167,15 @@ iobuf kafka_batch_adapter::adapt(iobuf&& kbatch) {
       header, std::move(records), model::record_batch::tag_ctor_ng{});
 
     /**
-     * Perform some type of validation on the uncompressed input. In this case
-     * we make sure that the records can be materialized but we avoid
-     * re-encoding them using the lazy-record optimization.
+     * Perform some type of validation on the uncompressed input. The
+     * structural scan walks the record framing and skips over payload bytes,
+     * so unlike record materialization it does not copy keys, values or
+     * headers; the payload is used verbatim downstream once validated here.
      */
     if (!new_batch.compressed()) {
         try {
-            new_batch.for_each_record([](model::record r) { (void)r; });
+            model::verify_records_structure(
+              new_batch.data(), new_batch.record_count());
         } catch (const std::exception& e) {
             vlog(klog.error, "Parsing uncompressed records: {}", e.what());
             return remainder;
@@ -17,6 +17,10 @@
 #include "model/namespace.h"
 #include "resource_mgmt/io_priority.h"
 
+#include <seastar/core/semaphore.hh>
+
+#include <boost/range/irange.hpp>
+
 namespace kafka {
 
 void list_offsets_request::compute_duplicate_topics() {
@@ -65,126 +69,187 @@ struct list_offsets_ctx {
       , ssg(ssg) {}
 };
 
-static ss::future<list_offset_partition_response> list_offsets_partition(
-  list_offsets_ctx& octx,
-  model::timestamp timestamp,
-  list_offset_topic& topic,
-  list_offset_partition& part) {
-    auto ntp = model::ntp(
-      model::kafka_namespace,
-      model::get_source_topic(topic.name),
-      part.partition_index);
-
-    auto shard = octx.rctx.shards().shard_for(ntp);
-    if (!shard) {
-        return ss::make_ready_future<list_offset_partition_response>(
-          list_offsets_response::make_partition(
-            ntp.tp.partition, error_code::unknown_topic_or_partition));
-    }
+// partition query routed to its home shard, with the response slot it
+// fills in the pre-built response structure
+struct shard_query {
+    model::ntp ntp;
+    model::timestamp timestamp;
+    size_t topic_idx;
+    size_t partition_idx;
+};
 
-    return octx.rctx.partition_manager().invoke_on(
-      *shard,
-      octx.ssg,
-      [timestamp, ntp = std::move(ntp)](cluster::partition_manager& mgr) {
-          auto partition = mgr.get(ntp);
-          if (!partition) {
-              return ss::make_ready_future<list_offset_partition_response>(
-                list_offsets_response::make_partition(
-                  ntp.tp.partition, error_code::unknown_topic_or_partition));
-          }
+// queries grouped by destination shard, indexed by shard id
+using query_plan = std::vector<std::vector<shard_query>>;
 
-          if (!partition->is_leader()) {
-              return ss::make_ready_future<list_offset_partition_response>(
-                list_offsets_response::make_partition(
-                  ntp.tp.partition, error_code::not_leader_for_partition));
-          }
+// upper bound on timequeries executing concurrently on a shard. bulk
+// list_offsets requests covering thousands of partitions would otherwise
+// flood the io queue with index lookups all at once
+static constexpr size_t max_concurrent_queries_per_shard = 16;
 
-          /*
-           * the responses for earliest/latest timestamp queries do not require
-           * that the actual timestamp be returned. only the offset is required.
-           */
-          if (timestamp == list_offsets_request::earliest_timestamp) {
-              return ss::make_ready_future<list_offset_partition_response>(
-                list_offsets_response::make_partition(
-                  ntp.tp.partition,
-                  model::timestamp(-1),
-                  partition->start_offset()));
+/*
+ * Resolves every partition that can be answered without leaving this
+ * core (duplicates, unknown topics, unroutable partitions) directly into
+ * the pre-sized response, and groups the remainder by destination shard.
+ */
+static query_plan build_query_plan(list_offsets_ctx& octx) {
+    query_plan plan(ss::smp::count);
+    auto& topics = octx.response.data.topics;
+    topics.reserve(octx.request.data.topics.size());
 
-          } else if (timestamp == list_offsets_request::latest_timestamp) {
-              return ss::make_ready_future<list_offset_partition_response>(
-                list_offsets_response::make_partition(
-                  ntp.tp.partition,
-                  model::timestamp(-1),
-                  partition->last_stable_offset()));
-          }
+    for (size_t ti = 0; ti < octx.request.data.topics.size(); ++ti) {
+        auto& topic = octx.request.data.topics[ti];
+        list_offset_topic_response tr;
+        tr.name = topic.name;
+        tr.partitions.resize(topic.partitions.size());
 
-          return partition->timequery(timestamp, kafka_read_priority())
-            .then([partition, id = ntp.tp.partition](
-                    std::optional<storage::timequery_result> res) {
-                if (res) {
-                    return ss::make_ready_future<
-                      list_offset_partition_response>(
-                      list_offsets_response::make_partition(
-                        id, res->time, res->offset));
-                }
-                return ss::make_ready_future<list_offset_partition_response>(
-                  list_offsets_response::make_partition(
-                    id, model::timestamp(-1), partition->last_stable_offset()));
-            });
-      });
-}
+        for (size_t pi = 0; pi < topic.partitions.size(); ++pi) {
+            auto& part = topic.partitions[pi];
+            if (octx.request.duplicate_tp(topic.name, part.partition_index)) {
+                tr.partitions[pi] = list_offsets_response::make_partition(
+                  part.partition_index, error_code::invalid_request);
+                continue;
+            }
 
-static ss::future<list_offset_topic_response>
-list_offsets_topic(list_offsets_ctx& octx, list_offset_topic& topic) {
-    std::vector<ss::future<list_offset_partition_response>> partitions;
-    partitions.reserve(topic.partitions.size());
+            if (!octx.rctx.metadata_cache().contains(
+                  model::topic_namespace_view(
+                    model::kafka_namespace,
+                    model::get_source_topic(topic.name)),
+                  part.partition_index)) {
+                tr.partitions[pi] = list_offsets_response::make_partition(
+                  part.partition_index,
+                  error_code::unknown_topic_or_partition);
+                continue;
+            }
 
-    for (auto& part : topic.partitions) {
-        if (octx.request.duplicate_tp(topic.name, part.partition_index)) {
-            partitions.push_back(
-              ss::make_ready_future<list_offset_partition_response>(
-                list_offsets_response::make_partition(
-                  part.partition_index, error_code::invalid_request)));
-            continue;
-        }
+            auto ntp = model::ntp(
+              model::kafka_namespace,
+              model::get_source_topic(topic.name),
+              part.partition_index);
 
-        if (!octx.rctx.metadata_cache().contains(
-              model::topic_namespace_view(
-                model::kafka_namespace, model::get_source_topic(topic.name)),
-              part.partition_index)) {
-            partitions.push_back(
-              ss::make_ready_future<list_offset_partition_response>(
-                list_offsets_response::make_partition(
+            auto shard = octx.rctx.shards().shard_for(ntp);
+            if (!shard) {
+                tr.partitions[pi] = list_offsets_response::make_partition(
                   part.partition_index,
-                  error_code::unknown_topic_or_partition)));
-            continue;
+                  error_code::unknown_topic_or_partition);
+                continue;
+            }
+
+            plan[*shard].push_back(shard_query{
+              .ntp = std::move(ntp),
+              .timestamp = part.timestamp,
+              .topic_idx = ti,
+              .partition_idx = pi,
+            });
         }
+        topics.push_back(std::move(tr));
+    }
+    return plan;
+}
 
-        auto pr = list_offsets_partition(octx, part.timestamp, topic, part);
-        partitions.push_back(std::move(pr));
+static ss::future<list_offset_partition_response> query_partition(
+  cluster::partition_manager& mgr, const shard_query& query) {
+    auto partition = mgr.get(query.ntp);
+    if (!partition) {
+        return ss::make_ready_future<list_offset_partition_response>(
+          list_offsets_response::make_partition(
+            query.ntp.tp.partition, error_code::unknown_topic_or_partition));
     }
 
-    return when_all_succeed(partitions.begin(), partitions.end())
-      .then([name = std::move(topic.name)](
-              std::vector<list_offset_partition_response> parts) mutable {
-          return list_offset_topic_response{
-            .name = std::move(name),
-            .partitions = std::move(parts),
-          };
+    if (!partition->is_leader()) {
+        return ss::make_ready_future<list_offset_partition_response>(
+          list_offsets_response::make_partition(
+            query.ntp.tp.partition, error_code::not_leader_for_partition));
+    }
+
+    /*
+     * the responses for earliest/latest timestamp queries do not require
+     * that the actual timestamp be returned. only the offset is required.
+     */
+    if (query.timestamp == list_offsets_request::earliest_timestamp) {
+        return ss::make_ready_future<list_offset_partition_response>(
+          list_offsets_response::make_partition(
+            query.ntp.tp.partition,
+            model::timestamp(-1),
+            partition->start_offset()));
+
+    } else if (query.timestamp == list_offsets_request::latest_timestamp) {
+        return ss::make_ready_future<list_offset_partition_response>(
+          list_offsets_response::make_partition(
+            query.ntp.tp.partition,
+            model::timestamp(-1),
+            partition->last_stable_offset()));
+    }
+
+    return partition->timequery(query.timestamp, kafka_read_priority())
+      .then([partition, id = query.ntp.tp.partition](
+              std::optional<storage::timequery_result> res) {
+          if (res) {
+              return ss::make_ready_future<list_offset_partition_response>(
+                list_offsets_response::make_partition(
+                  id, res->time, res->offset));
+          }
+          return ss::make_ready_future<list_offset_partition_response>(
+            list_offsets_response::make_partition(
+              id, model::timestamp(-1), partition->last_stable_offset()));
       });
 }
 
-static std::vector<ss::future<list_offset_topic_response>>
-list_offsets_topics(list_offsets_ctx& octx) {
-    std::vector<ss::future<list_offset_topic_response>> topics;
-    topics.reserve(octx.request.data.topics.size());
-
-    for (auto& topic : octx.request.data.topics) {
-        auto tr = list_offsets_topic(octx, topic);
-        topics.push_back(std::move(tr));
+/*
+ * Ships the whole group of queries for one shard in a single invoke_on,
+ * runs them concurrently there under the io budget and writes the
+ * responses back into their slots.
+ */
+static ss::future<> execute_shard_plan(
+  list_offsets_ctx& octx,
+  ss::shard_id shard,
+  std::vector<shard_query>& queries) {
+    std::vector<std::pair<size_t, size_t>> slots;
+    slots.reserve(queries.size());
+    for (const auto& q : queries) {
+        slots.emplace_back(q.topic_idx, q.partition_idx);
     }
 
-    return topics;
+    return octx.rctx.partition_manager()
+      .invoke_on(
+        shard,
+        octx.ssg,
+        [queries = std::move(queries)](cluster::partition_manager& mgr) mutable {
+            using ret_t = std::vector<list_offset_partition_response>;
+            return ss::do_with(
+              std::move(queries),
+              ret_t{},
+              ss::semaphore(max_concurrent_queries_per_shard),
+              [&mgr](
+                std::vector<shard_query>& queries,
+                ret_t& responses,
+                ss::semaphore& iosem) {
+                  responses.resize(queries.size());
+                  return ss::parallel_for_each(
+                           boost::irange<size_t>(0, queries.size()),
+                           [&mgr, &queries, &responses, &iosem](size_t i) {
+                               return ss::with_semaphore(
+                                 iosem,
+                                 1,
+                                 [&mgr, &queries, &responses, i] {
+                                     return query_partition(mgr, queries[i])
+                                       .then(
+                                         [&responses,
+                                          i](list_offset_partition_response r) {
+                                             responses[i] = std::move(r);
+                                         });
+                                 });
+                           })
+                    .then([&responses] { return std::move(responses); });
+              });
+        })
+      .then([&octx, slots = std::move(slots)](
+              std::vector<list_offset_partition_response> responses) {
+          for (size_t i = 0; i < responses.size(); ++i) {
+              auto [ti, pi] = slots[i];
+              octx.response.data.topics[ti].partitions[pi] = std::move(
+                responses[i]);
+          }
+      });
 }
 
 ss::future<response_ptr>
@@ -196,11 +261,18 @@ list_offsets_api::process(request_context&& ctx, ss::smp_service_group ssg) {
 
     return ss::do_with(
       list_offsets_ctx(std::move(ctx), std::move(request), ssg),
-      [](list_offsets_ctx& octx) {
-          auto topics = list_offsets_topics(octx);
-          return when_all_succeed(topics.begin(), topics.end())
-            .then([&octx](std::vector<list_offset_topic_response> topics) {
-                octx.response.data.topics = std::move(topics);
+      query_plan{},
+      [](list_offsets_ctx& octx, query_plan& plan) {
+          plan = build_query_plan(octx);
+          return ss::parallel_for_each(
+                   boost::irange<ss::shard_id>(0, ss::smp::count),
+                   [&octx, &plan](ss::shard_id shard) {
+                       if (plan[shard].empty()) {
+                           return ss::now();
+                       }
+                       return execute_shard_plan(octx, shard, plan[shard]);
+                   })
+            .then([&octx] {
                 return octx.rctx.respond(std::move(octx.response));
             });
       });
@@ -14,6 +14,7 @@
 #include "cluster/types.h"
 #include "config/configuration.h"
 #include "kafka/errors.h"
+#include "kafka/requests/response_writer.h"
 #include "kafka/requests/topics/topic_utils.h"
 #include "likely.h"
 #include "model/metadata.h"
@@ -22,6 +23,8 @@
 #include <seastar/core/future-util.hh>
 #include <seastar/core/thread.hh>
 
+#include <absl/container/flat_hash_map.h>
+
 #include <fmt/ostream.h>
 
 namespace kafka {
@@ -74,8 +77,10 @@ std::ostream& operator<<(std::ostream& o, const metadata_request& r) {
 }
 
 void metadata_response::encode(const request_context& ctx, response& resp) {
-    auto& writer = resp.writer();
-    auto version = ctx.header().version;
+    encode(resp.writer(), ctx.header().version);
+}
+
+void metadata_response::encode(response_writer& writer, api_version version) {
 
     if (version >= api_version(3)) {
         writer.write(int32_t(throttle_time.count()));
@@ -98,9 +103,14 @@ void metadata_response::encode(const request_context& ctx, response& resp) {
     if (version >= api_version(1)) {
         writer.write(controller_id);
     }
-    writer.write_array(topics, [version](const topic& tp, response_writer& rw) {
-        tp.encode(version, rw);
-    });
+    if (topics_encoded) {
+        writer.write_direct(std::move(*topics_encoded));
+    } else {
+        writer.write_array(
+          topics, [version](const topic& tp, response_writer& rw) {
+              tp.encode(version, rw);
+          });
+    }
     if (version >= api_version(8)) {
         writer.write(cluster_authorized_operations);
     }
@@ -145,6 +155,32 @@ void metadata_response::partition::encode(
     }
 }
 
+size_t metadata_response::size_estimate() const {
+    // throttle_time, array lengths, controller id, authorized operations;
+    // fields gated behind older versions are counted anyway, the
+    // reservation is an upper bound on the fixed-layout bytes
+    size_t size = 5 * sizeof(int32_t) + sizeof(int16_t)
+                  + (cluster_id ? cluster_id->size() : 0);
+    for (const auto& b : brokers) {
+        size += 2 * sizeof(int32_t) + 2 * sizeof(int16_t) + b.host.size()
+                + (b.rack ? b.rack->size() : 0);
+    }
+    // a pre-serialized topic section is spliced in, not copied
+    if (!topics_encoded) {
+        for (const auto& t : topics) {
+            size += 2 * sizeof(int16_t) + sizeof(bool) + t.name().size()
+                    + 2 * sizeof(int32_t);
+            for (const auto& p : t.partitions) {
+                size += sizeof(int16_t) + 6 * sizeof(int32_t)
+                        + (p.replica_nodes.size() + p.isr_nodes.size()
+                           + p.offline_replicas.size())
+                            * sizeof(int32_t);
+            }
+        }
+    }
+    return size;
+}
+
 void metadata_response::decode(iobuf buf, api_version version) {
     request_reader reader(std::move(buf));
 
@@ -345,28 +381,72 @@ create_topic(request_context& ctx, model::topic&& topic) {
       });
 }
 
+static std::vector<metadata_response::topic>
+make_all_topics(request_context& ctx) {
+    std::vector<metadata_response::topic> res;
+    auto topics = ctx.metadata_cache().all_topics_metadata();
+    // the snapshot is shared with other readers, copy the entries we
+    // serve. only serve topics from the kafka namespace
+    for (const auto& t_md : *topics) {
+        if (t_md.tp_ns.ns != model::kafka_namespace) {
+            continue;
+        }
+        res.push_back(metadata_response::topic::make_from_topic_metadata(
+          model::topic_metadata(t_md)));
+    }
+    return res;
+}
+
+/**
+ * Shard local cache of the serialized topic array section of the metadata
+ * response. The topic section dominates the response size and is identical
+ * for every list-all-topics request at a given api version, so it is
+ * serialized once per version and the underlying iobuf shared with every
+ * request until the topic or leaders table reports a new version.
+ */
+struct topics_section_cache {
+    cluster::topic_table::version topics_version;
+    cluster::partition_leaders_table::version leaders_version;
+    absl::flat_hash_map<api_version, iobuf> encoded;
+};
+
+static thread_local topics_section_cache topics_cache;
+
+static iobuf serialized_all_topics(request_context& ctx) {
+    const auto topics_v = ctx.metadata_cache().topics_version();
+    const auto leaders_v = ctx.metadata_cache().leaders_version();
+    if (
+      topics_v != topics_cache.topics_version
+      || leaders_v != topics_cache.leaders_version) {
+        topics_cache.encoded.clear();
+        topics_cache.topics_version = topics_v;
+        topics_cache.leaders_version = leaders_v;
+    }
+    const auto version = ctx.header().version;
+    if (auto it = topics_cache.encoded.find(version);
+        it != topics_cache.encoded.end()) {
+        return it->second.share(0, it->second.size_bytes());
+    }
+    auto topics = make_all_topics(ctx);
+    iobuf out;
+    response_writer rw(out);
+    rw.write_array(
+      topics,
+      [version](const metadata_response::topic& tp, response_writer& rw) {
+          tp.encode(version, rw);
+      });
+    auto [it, _] = topics_cache.encoded.emplace(version, std::move(out));
+    return it->second.share(0, it->second.size_bytes());
+}
+
 static ss::future<std::vector<metadata_response::topic>>
 get_topic_metadata(request_context& ctx, metadata_request& request) {
     std::vector<metadata_response::topic> res;
 
     // request can be served from whatever happens to be in the cache
     if (request.list_all_topics) {
-        auto topics = ctx.metadata_cache().all_topics_metadata();
-        // only serve topics from the kafka namespace
-        auto it = std::remove_if(
-          topics.begin(), topics.end(), [](model::topic_metadata& t_md) {
-              return t_md.tp_ns.ns != model::kafka_namespace;
-          });
-        std::transform(
-          topics.begin(),
-          it,
-          std::back_inserter(res),
-          [](model::topic_metadata& t_md) {
-              return metadata_response::topic::make_from_topic_metadata(
-                std::move(t_md));
-          });
         return ss::make_ready_future<std::vector<metadata_response::topic>>(
-          std::move(res));
+          make_all_topics(ctx));
     }
 
     std::vector<ss::future<metadata_response::topic>> new_topics;
@@ -434,6 +514,15 @@ ss::future<response_ptr> metadata_api::process(
 
           metadata_request request;
           request.decode(ctx);
+
+          if (request.list_all_topics) {
+              // the full topic listing is served from the shard local
+              // pre-serialized cache; a metadata fetch against an
+              // unchanged cluster is a single iobuf share
+              reply.topics_encoded = serialized_all_topics(ctx);
+              return ctx.respond(std::move(reply));
+          }
+
           return get_topic_metadata(ctx, request)
             .then([&reply](std::vector<metadata_response::topic> topics) {
                 reply.topics = std::move(topics);
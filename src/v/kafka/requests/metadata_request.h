@@ -91,10 +91,22 @@ struct metadata_response {
     std::optional<ss::sstring> cluster_id; // version >= 2
     model::node_id controller_id;          // version >= 1
     std::vector<topic> topics;
+    // pre-serialized topic array section. when set, encode() splices it
+    // into the response verbatim instead of serializing `topics`. used to
+    // serve list-all-topics requests from the shard local cache
+    std::optional<iobuf> topics_encoded;
     int32_t cluster_authorized_operations = 0; // version >= 8
 
     void encode(const request_context& ctx, response& resp);
+    void encode(response_writer& writer, api_version version);
     void decode(iobuf buf, api_version version);
+
+    /*
+     * bytes of fixed-layout encoding in this response, used to reserve the
+     * response buffer up front. a pre-serialized topic section is spliced
+     * in verbatim and deliberately excluded.
+     */
+    size_t size_estimate() const;
 };
 
 std::ostream& operator<<(std::ostream&, const metadata_response&);
@@ -12,6 +12,8 @@
 #include "bytes/iobuf.h"
 #include "cluster/metadata_cache.h"
 #include "cluster/partition_manager.h"
+#include "cluster/producer_dedup_table.h"
+#include "config/configuration.h"
 #include "kafka/errors.h"
 #include "kafka/requests/kafka_batch_adapter.h"
 #include "kafka/requests/response_writer_utils.h"
@@ -24,15 +26,18 @@
 #include "raft/types.h"
 #include "storage/shard_assignment.h"
 #include "utils/remote.h"
+#include "utils/stage_tracer.h"
 #include "utils/to_string.h"
 #include "vlog.h"
 
 #include <seastar/core/execution_stage.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/smp.hh>
 #include <seastar/util/log.hh>
 
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <string_view>
 
 namespace kafka {
@@ -136,8 +141,10 @@ std::ostream& operator<<(std::ostream& o, const produce_request& r) {
 }
 
 void produce_response::encode(const request_context& ctx, response& resp) {
-    auto& writer = resp.writer();
-    auto version = ctx.header().version;
+    encode(resp.writer(), ctx.header().version);
+}
+
+void produce_response::encode(response_writer& writer, api_version version) {
 
     writer.write_array(topics, [version](topic& t, response_writer& writer) {
         writer.write(t.name);
@@ -250,6 +257,31 @@ reader_from_lcore_batch(model::record_batch&& batch) {
     return model::make_foreign_memory_record_batch_reader(std::move(batch));
 }
 
+/*
+ * Replication-lag backpressure. When the slowest follower trails the leader
+ * by more than the configured threshold, producers are asked to back off
+ * before unreplicated data piles up on the leader. The delay ramps linearly
+ * from zero at the threshold to the configured maximum at twice the
+ * threshold, so a marginally slow follower only nudges producers while a
+ * badly lagging one caps their throughput until it catches up.
+ */
+static std::chrono::milliseconds
+lag_throttle_delay(const cluster::partition& partition) {
+    auto threshold
+      = config::shard_local_cfg().kafka_produce_lag_throttle_offsets();
+    if (threshold <= 0) {
+        return std::chrono::milliseconds(0);
+    }
+    auto lag = partition.max_follower_lag();
+    if (lag <= threshold) {
+        return std::chrono::milliseconds(0);
+    }
+    auto max_delay
+      = config::shard_local_cfg().kafka_produce_lag_throttle_max_ms();
+    auto over = std::min<int64_t>(lag - threshold, threshold);
+    return max_delay * over / threshold;
+}
+
 /*
  * Caller is expected to catch errors that may be thrown while the kafka
  * batch is being deserialized (see reader_from_kafka_batch).
@@ -257,13 +289,55 @@ reader_from_lcore_batch(model::record_batch&& batch) {
 static ss::future<produce_response::partition> partition_append(
   model::partition_id id,
   ss::lw_shared_ptr<cluster::partition> partition,
+  cluster::batch_identity bid,
   model::record_batch_reader reader,
   int16_t acks,
   int32_t num_records) {
+    auto term = partition->term();
+    if (bid.is_idempotent()) {
+        auto res = partition->dedup().reserve(bid, term);
+        switch (res.outcome) {
+        case cluster::producer_dedup_table::status::accept:
+            break;
+        case cluster::producer_dedup_table::status::duplicate:
+            // retry of a batch already in the log: replay the original
+            // response instead of appending a second copy
+            return ss::make_ready_future<produce_response::partition>(
+              produce_response::partition{
+                .id = id,
+                .error = error_code::none,
+                .base_offset = res.base_offset});
+        case cluster::producer_dedup_table::status::in_progress:
+            // retry of a batch still being replicated. neither copy nor
+            // offset are safe to hand out yet; the client backs off and
+            // retries once the original request resolves
+            return ss::make_ready_future<produce_response::partition>(
+              produce_response::partition{
+                .id = id, .error = error_code::duplicate_sequence_number});
+        case cluster::producer_dedup_table::status::out_of_order:
+            return ss::make_ready_future<produce_response::partition>(
+              produce_response::partition{
+                .id = id,
+                .error = error_code::out_of_order_sequence_number});
+        case cluster::producer_dedup_table::status::fenced:
+            return ss::make_ready_future<produce_response::partition>(
+              produce_response::partition{
+                .id = id, .error = error_code::invalid_producer_epoch});
+        }
+    }
+    // sampled end-to-end trace; the raft batcher records its own interior
+    // stages, this one brackets the whole replicate call on the home shard
+    auto trace = tracing::stage_tracer::shard_local().maybe_sample("produce");
     return partition
       ->replicate(std::move(reader), acks_to_replicate_options(acks))
-      .then_wrapped([partition, id, num_records = num_records](
-                      ss::future<result<raft::replicate_result>> f) {
+      .then_wrapped([partition,
+                     id,
+                     bid,
+                     term,
+                     num_records = num_records,
+                     trace = std::move(trace)](
+                      ss::future<result<raft::replicate_result>> f) mutable {
+          trace.stage("replicated");
           produce_response::partition p{.id = id};
           try {
               auto r = f.get0();
@@ -274,151 +348,230 @@ static ss::future<produce_response::partition> partition_append(
                     r.value().last_offset() - (num_records - 1));
                   p.error = error_code::none;
                   partition->probe().add_records_produced(num_records);
+                  if (bid.is_idempotent()) {
+                      partition->dedup().confirm(bid, term, p.base_offset);
+                  }
               } else {
                   p.error = error_code::unknown_server_error;
+                  if (bid.is_idempotent()) {
+                      partition->dedup().abandon(bid, term);
+                  }
               }
           } catch (...) {
               p.error = error_code::unknown_server_error;
+              if (bid.is_idempotent()) {
+                  partition->dedup().abandon(bid, term);
+              }
           }
+          p.lag_throttle = lag_throttle_delay(*partition);
           return p;
       });
 }
 
 /**
- * \brief handle writing to a single topic partition.
+ * \brief Produce a batch on the partition's home shard.
  */
-static ss::future<produce_response::partition> produce_topic_partition(
-  produce_ctx& octx,
-  produce_request::topic& topic,
-  produce_request::partition& part) {
-    auto ntp = model::ntp(model::kafka_namespace, topic.name, part.id);
-
-    /*
-     * A single produce request may contain record batches for many
-     * different partitions that are managed different cores.
-     */
-    auto shard = octx.rctx.shards().shard_for(ntp);
-
-    if (!shard) {
+static ss::future<produce_response::partition> do_produce_topic_partition(
+  cluster::partition_manager& mgr,
+  model::ntp ntp,
+  cluster::batch_identity bid,
+  model::record_batch_reader reader,
+  int32_t num_records,
+  int16_t acks) {
+    auto partition = mgr.get(ntp);
+    if (!partition) {
         return ss::make_ready_future<produce_response::partition>(
           produce_response::partition{
             .id = ntp.tp.partition,
             .error = error_code::unknown_topic_or_partition});
     }
-
-    // steal the batch from the adapter
-    auto batch = std::move(part.adapter.batch.value());
-    /*
-     * grab timestamp type topic configuration option out of the
-     * metadata cache. For append time setting we have to recalculate
-     * the CRC.
-     */
-    auto timestamp_type = octx.rctx.metadata_cache().get_topic_timestamp_type(
-      model::topic_namespace_view(model::kafka_namespace, topic.name));
-
-    if (timestamp_type == model::timestamp_type::append_time) {
-        auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
-          ss::lowres_clock::now().time_since_epoch());
-        batch.set_max_timestamp(
-          model::timestamp_type::append_time, model::timestamp(now.count()));
+    if (unlikely(!partition->is_leader())) {
+        return ss::make_ready_future<produce_response::partition>(
+          produce_response::partition{
+            .id = ntp.tp.partition,
+            .error = error_code::not_leader_for_partition});
     }
-
-    auto num_records = batch.record_count();
-    auto reader = reader_from_lcore_batch(std::move(batch));
-
-    return octx.rctx.partition_manager().invoke_on(
-      *shard,
-      octx.ssg,
-      [reader = std::move(reader),
-       ntp = std::move(ntp),
-       num_records,
-       acks = octx.request.acks](cluster::partition_manager& mgr) mutable {
-          auto partition = mgr.get(ntp);
-          if (!partition) {
-              return ss::make_ready_future<produce_response::partition>(
-                produce_response::partition{
-                  .id = ntp.tp.partition,
-                  .error = error_code::unknown_topic_or_partition});
-          }
-          if (unlikely(!partition->is_leader())) {
-              return ss::make_ready_future<produce_response::partition>(
-                produce_response::partition{
-                  .id = ntp.tp.partition,
-                  .error = error_code::not_leader_for_partition});
-          }
-          return partition_append(
-            ntp.tp.partition, partition, std::move(reader), acks, num_records);
-      });
+    return partition_append(
+      ntp.tp.partition, partition, bid, std::move(reader), acks, num_records);
 }
 
 /**
- * \brief Dispatch and collect topic partition produce responses
+ * A single partition append bound for a remote shard.
+ */
+struct shard_fragment {
+    model::ntp ntp;
+    cluster::batch_identity bid;
+    model::record_batch_reader reader;
+    int32_t num_records;
+};
+
+/**
+ * Partition appends grouped by destination shard. A produce request
+ * carrying batches for many partitions hosted on the same core pays for
+ * one cross-shard submit per shard instead of one per partition. The
+ * slots vector records the response topic index of each fragment and
+ * stays on the source shard so only batch data crosses cores.
  */
-static ss::future<produce_response::topic>
-produce_topic(produce_ctx& octx, produce_request::topic& topic) {
-    std::vector<ss::future<produce_response::partition>> partitions;
-    partitions.reserve(topic.partitions.size());
-
-    for (auto& part : topic.partitions) {
-        if (!octx.rctx.metadata_cache().contains(
-              model::topic_namespace_view(model::kafka_namespace, topic.name),
-              part.id)) {
-            partitions.push_back(
-              ss::make_ready_future<produce_response::partition>(
-                produce_response::partition{
+struct shard_batch {
+    std::vector<shard_fragment> fragments;
+    std::vector<size_t> slots;
+};
+
+/**
+ * \brief Dispatch partition produce requests grouped by home shard.
+ *
+ * The response is built skeleton-first and completed partition results
+ * are routed into it by topic index, so partitions may finish in any
+ * order. Validation failures are recorded into the response
+ * immediately. Partitions hosted on the handler's shard are appended in
+ * place; all others are bundled per destination shard.
+ */
+static std::vector<ss::future<>> dispatch_produce(produce_ctx& octx) {
+    std::vector<ss::future<>> dispatched;
+    std::vector<shard_batch> shards(ss::smp::count);
+
+    octx.response.topics.reserve(octx.request.topics.size());
+    for (size_t i = 0; i < octx.request.topics.size(); i++) {
+        auto& topic = octx.request.topics[i];
+        octx.response.topics.push_back(
+          produce_response::topic{.name = topic.name});
+        auto& rtopic = octx.response.topics.back();
+        rtopic.partitions.reserve(topic.partitions.size());
+
+        for (auto& part : topic.partitions) {
+            if (!octx.rctx.metadata_cache().contains(
+                  model::topic_namespace_view(
+                    model::kafka_namespace, topic.name),
+                  part.id)) {
+                rtopic.partitions.push_back(produce_response::partition{
                   .id = part.id,
-                  .error = error_code::unknown_topic_or_partition}));
-            continue;
-        }
+                  .error = error_code::unknown_topic_or_partition});
+                continue;
+            }
 
-        if (unlikely(!part.adapter.valid_crc)) {
-            partitions.push_back(
-              ss::make_ready_future<produce_response::partition>(
-                produce_response::partition{
-                  .id = part.id, .error = error_code::corrupt_message}));
-            continue;
-        }
+            if (unlikely(!part.adapter.valid_crc)) {
+                rtopic.partitions.push_back(produce_response::partition{
+                  .id = part.id, .error = error_code::corrupt_message});
+                continue;
+            }
 
-        // produce version >= 3 (enforced for all produce requests)
-        // requires exactly one record batch per request and it must use
-        // the v2 format.
-        if (unlikely(!part.adapter.v2_format || !part.adapter.batch)) {
-            partitions.push_back(
-              ss::make_ready_future<produce_response::partition>(
-                produce_response::partition{
-                  .id = part.id, .error = error_code::invalid_record}));
-            continue;
-        }
+            // produce version >= 3 (enforced for all produce requests)
+            // requires exactly one record batch per request and it must use
+            // the v2 format.
+            if (unlikely(!part.adapter.v2_format || !part.adapter.batch)) {
+                rtopic.partitions.push_back(produce_response::partition{
+                  .id = part.id, .error = error_code::invalid_record});
+                continue;
+            }
 
-        auto pr = produce_topic_partition(octx, topic, part);
-        partitions.push_back(std::move(pr));
-    }
+            auto ntp = model::ntp(
+              model::kafka_namespace, topic.name, part.id);
 
-    // collect partition responses and build the topic response
-    return when_all_succeed(partitions.begin(), partitions.end())
-      .then([name = std::move(topic.name)](
-              std::vector<produce_response::partition> parts) mutable {
-          return produce_response::topic{
-            .name = std::move(name),
-            .partitions = std::move(parts),
-          };
-      });
-}
+            /*
+             * A single produce request may contain record batches for many
+             * different partitions that are managed different cores.
+             */
+            auto shard = octx.rctx.shards().shard_for(ntp);
+            if (!shard) {
+                rtopic.partitions.push_back(produce_response::partition{
+                  .id = part.id,
+                  .error = error_code::unknown_topic_or_partition});
+                continue;
+            }
 
-/**
- * \brief Dispatch and collect topic produce responses
- */
-static std::vector<ss::future<produce_response::topic>>
-produce_topics(produce_ctx& octx) {
-    std::vector<ss::future<produce_response::topic>> topics;
-    topics.reserve(octx.request.topics.size());
-
-    for (auto& topic : octx.request.topics) {
-        auto tr = produce_topic(octx, topic);
-        topics.push_back(std::move(tr));
+            // steal the batch from the adapter
+            auto batch = std::move(part.adapter.batch.value());
+            /*
+             * grab timestamp type topic configuration option out of the
+             * metadata cache. For append time setting we have to recalculate
+             * the CRC.
+             */
+            auto timestamp_type
+              = octx.rctx.metadata_cache().get_topic_timestamp_type(
+                model::topic_namespace_view(
+                  model::kafka_namespace, topic.name));
+
+            if (timestamp_type == model::timestamp_type::append_time) {
+                // coarse read: stamping happens once per produced batch and
+                // the field is millisecond resolution. this also fixes the
+                // previous use of the steady lowres_clock epoch, which is
+                // not a wall-clock time.
+                batch.set_max_timestamp(
+                  model::timestamp_type::append_time,
+                  model::timestamp::now_coarse());
+            }
+
+            auto num_records = batch.record_count();
+            auto bid = cluster::batch_identity::from(batch.header());
+
+            if (*shard == ss::this_shard_id()) {
+                /*
+                 * the partition is served from this shard: append directly
+                 * and skip both the smp hop and the foreign reader wrapping
+                 * it requires.
+                 */
+                auto reader = model::make_memory_record_batch_reader(
+                  std::move(batch));
+                dispatched.push_back(
+                  do_produce_topic_partition(
+                    octx.rctx.partition_manager().local(),
+                    std::move(ntp),
+                    bid,
+                    std::move(reader),
+                    num_records,
+                    octx.request.acks)
+                    .then([&octx, i](produce_response::partition p) {
+                        octx.response.topics[i].partitions.push_back(p);
+                    }));
+                continue;
+            }
+
+            auto& sb = shards[*shard];
+            sb.fragments.push_back(shard_fragment{
+              .ntp = std::move(ntp),
+              .bid = bid,
+              .reader = reader_from_lcore_batch(std::move(batch)),
+              .num_records = num_records});
+            sb.slots.push_back(i);
+        }
+    }
+
+    for (ss::shard_id shard = 0; shard < shards.size(); shard++) {
+        auto& sb = shards[shard];
+        if (sb.fragments.empty()) {
+            continue;
+        }
+        auto fut = octx.rctx.partition_manager().invoke_on(
+          shard,
+          octx.ssg,
+          [fragments = std::move(sb.fragments),
+           acks = octx.request.acks](cluster::partition_manager& mgr) mutable {
+              // results are returned in fragment order so the source
+              // shard can route them without shipping slots across cores
+              std::vector<ss::future<produce_response::partition>> parts;
+              parts.reserve(fragments.size());
+              for (auto& f : fragments) {
+                  parts.push_back(do_produce_topic_partition(
+                    mgr,
+                    std::move(f.ntp),
+                    f.bid,
+                    std::move(f.reader),
+                    f.num_records,
+                    acks));
+              }
+              return when_all_succeed(parts.begin(), parts.end());
+          });
+        dispatched.push_back(fut.then(
+          [&octx, slots = std::move(sb.slots)](
+            std::vector<produce_response::partition> parts) {
+              for (size_t i = 0; i < parts.size(); i++) {
+                  octx.response.topics[slots[i]].partitions.push_back(
+                    parts[i]);
+              }
+          }));
     }
 
-    return topics;
+    return dispatched;
 }
 
 ss::future<response_ptr>
@@ -430,17 +583,14 @@ produce_api::process(request_context&& ctx, ss::smp_service_group ssg) {
      *
      * Note that in kafka authorization is performed based on
      * transactional id, producer id, and idempotency. Redpanda does not
-     * yet support these features, so we reject all such requests as if
-     * authorization failed.
+     * yet support transactions, so we reject those requests as if
+     * authorization failed. Idempotent produce is supported: sequence
+     * validation happens on the partition's home shard during dispatch.
      */
     if (request.has_transactional) {
         return ctx.respond(request.make_error_response(
           error_code::transactional_id_authorization_failed));
 
-    } else if (request.has_idempotent) {
-        return ctx.respond(request.make_error_response(
-          error_code::cluster_authorization_failed));
-
     } else if (request.acks < -1 || request.acks > 1) {
         // from kafka source: "if required.acks is outside accepted
         // range, something is wrong with the client Just return an
@@ -460,15 +610,21 @@ produce_api::process(request_context&& ctx, ss::smp_service_group ssg) {
       [](produce_ctx& octx) {
           vlog(klog.trace, "handling produce request {}", octx.request);
 
-          // dispatch produce requests for each topic
-          auto topics = produce_topics(octx);
+          // dispatch produce requests, bundled per destination shard
+          auto dispatched = dispatch_produce(octx);
 
-          // collect topic responses
-          return when_all_succeed(topics.begin(), topics.end())
-            .then([&octx](std::vector<produce_response::topic> topics) {
-                octx.response.topics = std::move(topics);
-            })
+          // wait for all partition results to be routed into the response
+          return when_all_succeed(dispatched.begin(), dispatched.end())
             .then([&octx] {
+                // surface the worst per-partition replication-lag throttle
+                // as the response's throttle time so producers back off
+                for (const auto& topic : octx.response.topics) {
+                    for (const auto& p : topic.partitions) {
+                        octx.response.throttle = std::max(
+                          octx.response.throttle, p.lag_throttle);
+                    }
+                }
+
                 // send response immediately
                 if (octx.request.acks != 0) {
                     return octx.rctx.respond(std::move(octx.response));
@@ -104,6 +104,12 @@ struct produce_response final {
         model::offset base_offset{-1};
         model::timestamp log_append_time{-1};
         model::offset log_start_offset{-1}; // >= v5
+        /*
+         * not part of the kafka protocol: replication-lag throttle delay
+         * computed on the partition's home shard, folded into the
+         * response's top-level throttle time by the handler
+         */
+        std::chrono::milliseconds lag_throttle{0};
     };
 
     struct topic {
@@ -115,6 +121,7 @@ struct produce_response final {
     std::chrono::milliseconds throttle = std::chrono::milliseconds(0);
 
     void encode(const request_context& ctx, response& resp);
+    void encode(response_writer& writer, api_version version);
     void decode(iobuf buf, api_version version);
 };
 
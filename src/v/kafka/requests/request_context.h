@@ -29,9 +29,22 @@
 #include <seastar/util/log.hh>
 
 #include <memory>
+#include <type_traits>
 
 namespace kafka {
 
+namespace detail {
+// detects response types providing a size_estimate() used to reserve the
+// response buffer in one shot before encoding
+template<typename, typename = void>
+struct has_size_estimate : std::false_type {};
+template<typename T>
+struct has_size_estimate<
+  T,
+  std::void_t<decltype(std::declval<const T&>().size_estimate())>>
+  : std::true_type {};
+} // namespace detail
+
 // Fields may not be byte-aligned since we work
 // with the underlying network buffer.
 struct [[gnu::packed]] raw_request_header {
@@ -138,6 +151,11 @@ public:
           ResponseType::api_type::name,
           r);
         auto resp = std::make_unique<response>();
+        // responses that can size themselves get a single up-front buffer
+        // reservation; the estimate excludes spliced payloads
+        if constexpr (detail::has_size_estimate<ResponseType>::value) {
+            resp->reserve(r.size_estimate());
+        }
         r.encode(*this, *resp.get());
         return ss::make_ready_future<response_ptr>(std::move(resp));
     }
@@ -28,6 +28,14 @@ public:
 
     response_writer& writer() { return _writer; }
 
+    /*
+     * Reserve buffer space before encoding starts so fixed-layout writes
+     * land in a single fragment instead of growing the fragment list.
+     * Spliced payloads (record sets, pre-serialized sections) bypass the
+     * reservation and must not be included in the size.
+     */
+    void reserve(size_t size) { _buf.reserve_memory(size); }
+
     const iobuf& buf() const { return _buf; }
     iobuf& buf() { return _buf; }
     iobuf release() && { return std::move(_buf); }
@@ -124,6 +124,12 @@ public:
         return size;
     }
 
+    // write a pre-serialized span directly to output without a length prefix
+    uint32_t write_direct(std::string_view v) {
+        _out->append(v.data(), v.size());
+        return v.size();
+    }
+
     template<typename T, typename Tag>
     uint32_t write(const named_type<T, Tag>& t) {
         return write(t());
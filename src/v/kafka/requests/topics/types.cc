@@ -93,6 +93,11 @@ cluster::topic_configuration to_cluster_type(const creatable_topic& t) {
       config_entries, "retention.bytes");
     cfg.retention_duration = get_tristate_value<std::chrono::milliseconds>(
       config_entries, "retention.ms");
+    // Redpanda specific: `redpanda.storage.type=memory` requests the
+    // ephemeral in-memory log backend for the topic
+    cfg.in_memory_storage
+      = get_config_value<ss::sstring>(config_entries, "redpanda.storage.type")
+        == "memory";
 
     return cfg;
 }
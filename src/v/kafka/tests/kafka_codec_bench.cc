@@ -0,0 +1,259 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/bytes.h"
+#include "kafka/requests/fetch_request.h"
+#include "kafka/requests/metadata_request.h"
+#include "kafka/requests/produce_request.h"
+#include "kafka/requests/response_writer.h"
+#include "model/fundamental.h"
+#include "random/generators.h"
+#include "storage/tests/utils/random_batch.h"
+
+#include <seastar/testing/perf_tests.hh>
+
+#include <fmt/format.h>
+
+/*
+ * Round-trips representative corpora through the hand-written kafka codecs
+ * so encode/decode cost per message type shows up in perf reports (ns/op
+ * and allocations per op) instead of only in end-to-end latency:
+ *
+ *   - a list-all-topics sized metadata response (200 topics, 16 partitions
+ *     each, replication factor 3)
+ *   - a 500 partition fetch request and response (1KiB record set per
+ *     partition)
+ *   - a batched produce request and its response
+ *
+ * The corpora are synthesized through the same codecs the server uses, so
+ * layout changes that regress one side of the round trip fail loudly here.
+ */
+
+namespace {
+
+kafka::metadata_response make_metadata_corpus() {
+    kafka::metadata_response resp;
+    resp.cluster_id = "redpanda.bench";
+    resp.controller_id = model::node_id(0);
+    for (int32_t b = 0; b < 3; ++b) {
+        resp.brokers.push_back(kafka::metadata_response::broker{
+          .node_id = model::node_id(b),
+          .host = "broker.internal.example.com",
+          .port = 9092,
+          .rack = ss::sstring("rack-a"),
+        });
+    }
+    for (int32_t t = 0; t < 200; ++t) {
+        kafka::metadata_response::topic topic;
+        topic.err_code = kafka::error_code::none;
+        topic.name = model::topic(fmt::format("topic-{}", t));
+        for (int32_t p = 0; p < 16; ++p) {
+            topic.partitions.push_back(kafka::metadata_response::partition{
+              .err_code = kafka::error_code::none,
+              .index = model::partition_id(p),
+              .leader = model::node_id(p % 3),
+              .leader_epoch = 1,
+              .replica_nodes
+              = {model::node_id(0), model::node_id(1), model::node_id(2)},
+              .isr_nodes
+              = {model::node_id(0), model::node_id(1), model::node_id(2)},
+            });
+        }
+        resp.topics.push_back(std::move(topic));
+    }
+    return resp;
+}
+
+kafka::fetch_request make_fetch_request_corpus() {
+    kafka::fetch_request req;
+    req.replica_id = model::node_id(-1);
+    req.max_wait_time = std::chrono::milliseconds(500);
+    req.min_bytes = 1;
+    for (int32_t t = 0; t < 5; ++t) {
+        kafka::fetch_request::topic topic;
+        topic.name = model::topic(fmt::format("topic-{}", t));
+        for (int32_t p = 0; p < 100; ++p) {
+            topic.partitions.push_back(kafka::fetch_request::partition{
+              .id = model::partition_id(p),
+              .fetch_offset = model::offset(1024),
+              .partition_max_bytes = 1 << 20,
+            });
+        }
+        req.topics.push_back(std::move(topic));
+    }
+    return req;
+}
+
+kafka::fetch_response make_fetch_response_corpus(const iobuf& record_set) {
+    kafka::fetch_response resp;
+    for (int32_t t = 0; t < 5; ++t) {
+        kafka::fetch_response::partition topic(
+          model::topic(fmt::format("topic-{}", t)));
+        for (int32_t p = 0; p < 100; ++p) {
+            topic.responses.push_back(kafka::fetch_response::partition_response{
+              .id = model::partition_id(p),
+              .error = kafka::error_code::none,
+              .high_watermark = model::offset(2048),
+              .last_stable_offset = model::offset(2048),
+              .record_set = record_set.copy(),
+            });
+        }
+        resp.partitions.push_back(std::move(topic));
+    }
+    return resp;
+}
+
+kafka::produce_response make_produce_response_corpus() {
+    kafka::produce_response resp;
+    for (int32_t t = 0; t < 5; ++t) {
+        kafka::produce_response::topic topic;
+        topic.name = model::topic(fmt::format("topic-{}", t));
+        for (int32_t p = 0; p < 100; ++p) {
+            topic.partitions.push_back(kafka::produce_response::partition{
+              .id = model::partition_id(p),
+              .base_offset = model::offset(4096),
+            });
+        }
+        resp.topics.push_back(std::move(topic));
+    }
+    return resp;
+}
+
+} // namespace
+
+struct codec_bench {
+    codec_bench()
+      : metadata(make_metadata_corpus())
+      , fetch_req(make_fetch_request_corpus())
+      , record_set(bytes_to_iobuf(random_generators::get_bytes(1024)))
+      , fetch_resp(make_fetch_response_corpus(record_set))
+      , produce_resp(make_produce_response_corpus()) {
+        kafka::response_writer md_writer(metadata_wire);
+        make_metadata_corpus().encode(md_writer, metadata_version);
+
+        kafka::response_writer fetch_writer(fetch_wire);
+        make_fetch_response_corpus(record_set)
+          .encode(fetch_writer, fetch_version);
+
+        kafka::response_writer produce_writer(produce_wire);
+        make_produce_response_corpus().encode(produce_writer, produce_version);
+    }
+
+    // encoding a fetch response consumes the record sets; restore them from
+    // the shared corpus buffer so every iteration encodes the same bytes
+    void refresh_fetch_record_sets() {
+        for (auto& topic : fetch_resp.partitions) {
+            for (auto& p : topic.responses) {
+                p.record_set = record_set.share(0, record_set.size_bytes());
+            }
+        }
+    }
+
+    static constexpr auto metadata_version = kafka::api_version(7);
+    static constexpr auto fetch_version = kafka::api_version(10);
+    static constexpr auto produce_version = kafka::api_version(7);
+
+    kafka::metadata_response metadata;
+    kafka::fetch_request fetch_req;
+    iobuf record_set;
+    kafka::fetch_response fetch_resp;
+    kafka::produce_response produce_resp;
+
+    iobuf metadata_wire;
+    iobuf fetch_wire;
+    iobuf produce_wire;
+};
+
+PERF_TEST_F(codec_bench, metadata_response_encode) {
+    iobuf out;
+    kafka::response_writer writer(out);
+    perf_tests::start_measuring_time();
+    metadata.encode(writer, metadata_version);
+    perf_tests::stop_measuring_time();
+    perf_tests::do_not_optimize(out);
+}
+
+PERF_TEST_F(codec_bench, metadata_response_decode) {
+    auto buf = metadata_wire.share(0, metadata_wire.size_bytes());
+    kafka::metadata_response resp;
+    perf_tests::start_measuring_time();
+    resp.decode(std::move(buf), metadata_version);
+    perf_tests::stop_measuring_time();
+    perf_tests::do_not_optimize(resp);
+}
+
+PERF_TEST_F(codec_bench, fetch_request_encode) {
+    iobuf out;
+    kafka::response_writer writer(out);
+    perf_tests::start_measuring_time();
+    fetch_req.encode(writer, fetch_version);
+    perf_tests::stop_measuring_time();
+    perf_tests::do_not_optimize(out);
+}
+
+PERF_TEST_F(codec_bench, fetch_response_encode) {
+    refresh_fetch_record_sets();
+    iobuf out;
+    kafka::response_writer writer(out);
+    perf_tests::start_measuring_time();
+    fetch_resp.encode(writer, fetch_version);
+    perf_tests::stop_measuring_time();
+    perf_tests::do_not_optimize(out);
+}
+
+PERF_TEST_F(codec_bench, fetch_response_decode) {
+    auto buf = fetch_wire.share(0, fetch_wire.size_bytes());
+    kafka::fetch_response resp;
+    perf_tests::start_measuring_time();
+    resp.decode(std::move(buf), fetch_version);
+    perf_tests::stop_measuring_time();
+    perf_tests::do_not_optimize(resp);
+}
+
+PERF_TEST_F(codec_bench, produce_request_encode) {
+    // encoding moves the batches out of the request, so build the batched
+    // corpus per iteration and only measure the codec itself
+    std::vector<kafka::produce_request::topic> topics;
+    kafka::produce_request::topic topic;
+    topic.name = model::topic("topic-0");
+    auto batches = storage::test::make_random_batches(model::offset(0), 16);
+    for (int32_t p = 0; p < static_cast<int32_t>(batches.size()); ++p) {
+        kafka::produce_request::partition partition;
+        partition.id = model::partition_id(p);
+        partition.adapter.batch = std::move(batches[p]);
+        topic.partitions.push_back(std::move(partition));
+    }
+    topics.push_back(std::move(topic));
+    kafka::produce_request req(std::nullopt, -1, std::move(topics));
+
+    iobuf out;
+    kafka::response_writer writer(out);
+    perf_tests::start_measuring_time();
+    req.encode(writer, produce_version);
+    perf_tests::stop_measuring_time();
+    perf_tests::do_not_optimize(out);
+}
+
+PERF_TEST_F(codec_bench, produce_response_encode) {
+    iobuf out;
+    kafka::response_writer writer(out);
+    perf_tests::start_measuring_time();
+    produce_resp.encode(writer, produce_version);
+    perf_tests::stop_measuring_time();
+    perf_tests::do_not_optimize(out);
+}
+
+PERF_TEST_F(codec_bench, produce_response_decode) {
+    auto buf = produce_wire.share(0, produce_wire.size_bytes());
+    kafka::produce_response resp;
+    perf_tests::start_measuring_time();
+    resp.decode(std::move(buf), produce_version);
+    perf_tests::stop_measuring_time();
+    perf_tests::do_not_optimize(resp);
+}
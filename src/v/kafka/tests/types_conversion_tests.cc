@@ -45,6 +45,7 @@ BOOST_AUTO_TEST_CASE(test_all_additional_options) {
         {"retention.bytes", "-1"},
         {"retention.ms", "86400000"},
         {"compaction.strategy", "header"},
+        {"redpanda.storage.type", "memory"},
       }};
 
     auto cluster_tp_config = to_cluster_type(all_options);
@@ -68,4 +69,5 @@ BOOST_AUTO_TEST_CASE(test_all_additional_options) {
       cluster_tp_config.cleanup_policy_bitflags,
       model::cleanup_policy_bitflags::compaction
         | model::cleanup_policy_bitflags::deletion);
+    BOOST_REQUIRE_EQUAL(cluster_tp_config.in_memory_storage, true);
 }
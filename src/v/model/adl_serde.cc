@@ -265,26 +265,23 @@ void adl<model::record_batch>::to(iobuf& out, model::record_batch&& batch) {
       .bhdr = batch.header(),
       .is_compressed = static_cast<int8_t>(batch.compressed() ? 1 : 0)};
     reflection::serialize(out, hdr);
-    if (batch.compressed()) {
-        reflection::serialize(out, std::move(batch).release_data());
-        return;
-    }
-    batch.for_each_record(
-      [&out](model::record r) { reflection::serialize(out, std::move(r)); });
+    /*
+     * the records iobuf is the exact encoding the batch carries on disk, for
+     * compressed and uncompressed batches alike. sharing it is refcounted and
+     * avoids re-parsing and re-encoding every record each time the same batch
+     * is serialized - e.g. once per follower on the raft replicate path.
+     */
+    reflection::serialize(out, std::move(batch).release_data());
 }
 
 model::record_batch adl<model::record_batch>::from(iobuf_parser& in) {
     auto hdr = reflection::adl<batch_header>{}.from(in);
+    auto io = reflection::adl<iobuf>{}.from(in);
     if (hdr.is_compressed == 1) {
-        auto io = reflection::adl<iobuf>{}.from(in);
         return model::record_batch(hdr.bhdr, std::move(io));
     }
-    auto recs = std::vector<model::record>{};
-    recs.reserve(hdr.bhdr.record_count);
-    for (int i = 0; i < hdr.bhdr.record_count; ++i) {
-        recs.push_back(adl<model::record>{}.from(in));
-    }
-    return model::record_batch(hdr.bhdr, std::move(recs));
+    return model::record_batch(
+      hdr.bhdr, std::move(io), model::record_batch::tag_ctor_ng{});
 }
 
 void adl<model::partition_metadata>::to(
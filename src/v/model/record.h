@@ -579,6 +579,8 @@ public:
     const iobuf& data() const { return _records; }
     iobuf&& release_data() && { return std::move(_records); }
     void clear_data() { _records.clear(); }
+    /// re-packs a fragmented payload in place; see iobuf::compact()
+    void compact_data() { _records.compact(); }
 
 private:
     record_batch_header _header;
@@ -13,6 +13,7 @@
 #include <seastar/core/smp.hh>
 
 #include <memory>
+#include <vector>
 
 namespace model {
 using data_t = record_batch_reader::data_t;
@@ -71,6 +72,150 @@ record_batch_reader make_foreign_record_batch_reader(record_batch_reader&& r) {
     return record_batch_reader(std::move(frn));
 }
 
+/// \brief like make_foreign_record_batch_reader, but amortizes cross-core
+/// messaging: each hop to the owner shard keeps pulling slices until
+/// prefetch_bytes worth of batches are buffered, and the extra slices are
+/// then served from local memory without further hops
+record_batch_reader make_prefetching_foreign_record_batch_reader(
+  record_batch_reader&& r, size_t prefetch_bytes) {
+    class prefetching_foreign_reader final : public record_batch_reader::impl {
+    public:
+        prefetching_foreign_reader(
+          std::unique_ptr<record_batch_reader::impl> i, size_t prefetch_bytes)
+          : _ptr(std::move(i))
+          , _prefetch_bytes(prefetch_bytes) {}
+        prefetching_foreign_reader(const prefetching_foreign_reader&) = delete;
+        prefetching_foreign_reader& operator=(const prefetching_foreign_reader&)
+          = delete;
+        prefetching_foreign_reader(prefetching_foreign_reader&&) = delete;
+        prefetching_foreign_reader& operator=(prefetching_foreign_reader&&)
+          = delete;
+        ~prefetching_foreign_reader() override = default;
+
+        bool is_end_of_stream() const final {
+            // slices already pulled to this core are served before the
+            // remote reader is consulted. ok to copy a bool
+            return _prefetched.empty() && _ptr->is_end_of_stream();
+        }
+
+        void print(std::ostream& os) final {
+            fmt::print(
+              os,
+              "prefetching_foreign_record_batch_reader. remote_core:{} "
+              "prefetch_bytes:{} buffered_slices:{} - proxy for:",
+              _ptr.get_owner_shard(),
+              _prefetch_bytes,
+              _prefetched.size());
+            _ptr->print(os);
+        }
+
+        ss::future<storage_t> do_load_slice(timeout_clock::time_point t) final {
+            if (!_prefetched.empty()) {
+                auto slice = std::move(_prefetched.front());
+                _prefetched.pop_front();
+                return ss::make_ready_future<storage_t>(std::move(slice));
+            }
+            auto shard = _ptr.get_owner_shard();
+            if (shard == ss::this_shard_id()) {
+                return pull_slices(t).then([this](std::vector<storage_t> s) {
+                    return take_first(std::move(s));
+                });
+            }
+            // TODO: this function should take an SMP group
+            return ss::smp::submit_to(
+                     shard, [this, t] { return pull_slices(t); })
+              .then([this](std::vector<storage_t> s) {
+                  return take_first(std::move(s));
+              });
+        }
+
+        ss::future<> finally() noexcept final {
+            auto shard = _ptr.get_owner_shard();
+            if (shard == ss::this_shard_id()) {
+                return _ptr->finally();
+            }
+            return ss::smp::submit_to(shard, [this] { return _ptr->finally(); });
+        }
+
+    private:
+        /// runs on the shard that owns the underlying reader. pulls slices
+        /// until the byte budget is spent or the reader runs dry, packaging
+        /// each one for the destination core
+        ss::future<std::vector<storage_t>>
+        pull_slices(timeout_clock::time_point t) {
+            return ss::do_with(
+              std::vector<storage_t>{},
+              size_t{0},
+              [this, t](std::vector<storage_t>& slices, size_t& bytes) {
+                  return ss::repeat(
+                           [this, t, &slices, &bytes] {
+                               if (
+                                 bytes >= _prefetch_bytes
+                                 || _ptr->is_end_of_stream()) {
+                                   return ss::make_ready_future<
+                                     ss::stop_iteration>(
+                                     ss::stop_iteration::yes);
+                               }
+                               return _ptr->do_load_slice(t).then(
+                                 [&slices, &bytes](storage_t recs) {
+                                     return accumulate(
+                                       slices, bytes, std::move(recs));
+                                 });
+                           })
+                    .then([&slices] { return std::move(slices); });
+              });
+        }
+
+        static ss::stop_iteration accumulate(
+          std::vector<storage_t>& slices, size_t& bytes, storage_t recs) {
+            if (likely(std::holds_alternative<data_t>(recs))) {
+                auto& d = std::get<data_t>(recs);
+                if (d.empty()) {
+                    // an empty slice carries no progress information;
+                    // stop rather than spin on the underlying reader
+                    return ss::stop_iteration::yes;
+                }
+                for (auto& b : d) {
+                    bytes += b.memory_usage();
+                }
+                auto p = std::make_unique<data_t>(std::move(d));
+                slices.emplace_back(foreign_data_t{
+                  .buffer = ss::make_foreign(std::move(p)), .index = 0});
+                return ss::stop_iteration::no;
+            }
+            auto& d = std::get<foreign_data_t>(recs);
+            if (d.index >= d.buffer->size()) {
+                return ss::stop_iteration::yes;
+            }
+            for (size_t i = d.index; i < d.buffer->size(); ++i) {
+                bytes += (*d.buffer)[i].memory_usage();
+            }
+            slices.push_back(std::move(recs));
+            return ss::stop_iteration::no;
+        }
+
+        storage_t take_first(std::vector<storage_t> slices) {
+            if (slices.empty()) {
+                return storage_t();
+            }
+            auto first = std::move(slices.front());
+            for (auto it = std::next(slices.begin()); it != slices.end();
+                 ++it) {
+                _prefetched.push_back(std::move(*it));
+            }
+            return first;
+        }
+
+        ss::foreign_ptr<std::unique_ptr<record_batch_reader::impl>> _ptr;
+        size_t _prefetch_bytes;
+        // slices already transferred to this core, served without a hop
+        ss::circular_buffer<storage_t> _prefetched;
+    };
+    auto p = std::make_unique<prefetching_foreign_reader>(
+      std::move(r).release(), prefetch_bytes);
+    return record_batch_reader(std::move(p));
+}
+
 record_batch_reader make_memory_record_batch_reader(storage_t batches) {
     class reader final : public record_batch_reader::impl {
     public:
@@ -293,6 +293,14 @@ ss::future<record_batch_reader::data_t> consume_reader_to_memory(
 
 /// \brief wraps a reader into a foreign_ptr<unique_ptr>
 record_batch_reader make_foreign_record_batch_reader(record_batch_reader&&);
+
+/// \brief wraps a reader into a foreign_ptr<unique_ptr>; unlike the plain
+/// foreign reader, which pays one cross-core hop per slice, every hop pulls
+/// slices from the owner shard until prefetch_bytes of batches are buffered
+/// and streams the rest from local memory. the default budget covers 8
+/// disk-read windows (log_segment_batch_reader::max_buffer_size)
+record_batch_reader make_prefetching_foreign_record_batch_reader(
+  record_batch_reader&&, size_t prefetch_bytes = 8 * 32 * 1024);
 std::ostream& operator<<(std::ostream& os, const record_batch_reader& r);
 
 } // namespace model
@@ -10,21 +10,38 @@
 #include "model/record_utils.h"
 
 #include "bytes/utils.h"
+#include "likely.h"
 #include "model/record.h"
 #include "reflection/adl.h"
 #include "utils/vint.h"
 
-namespace model {
+#include <fmt/format.h>
 
-template<typename T, typename = std::enable_if_t<std::is_integral_v<T>, T>>
-void crc_extend_cpu_to_le(crc32& crc, T i) {
-    auto j = ss::cpu_to_le(i);
-    crc.extend(j);
-}
+#include <array>
+#include <cstring>
+#include <stdexcept>
 
+namespace model {
+
+/*
+ * fixed-width header fields are staged into one stack buffer and hashed
+ * with a single crc32c call. the library pays an alignment prologue and
+ * dispatch per call, which dominates when each call covers 2-8 bytes;
+ * one call over the packed fields runs at full hardware stride. the byte
+ * sequence is identical to hashing the fields one by one.
+ */
 template<typename... T>
 void crc_extend_all_cpu_to_le(crc32& crc, T... t) {
-    ((crc_extend_cpu_to_le(crc, t)), ...);
+    static_assert((std::is_integral_v<T> && ...));
+    std::array<uint8_t, (sizeof(T) + ...)> buf;
+    size_t pos = 0;
+    auto put = [&buf, &pos](auto i) {
+        auto j = ss::cpu_to_le(i);
+        std::memcpy(buf.data() + pos, &j, sizeof(j));
+        pos += sizeof(j);
+    };
+    ((put(t)), ...);
+    crc.extend(buf.data(), buf.size());
 }
 
 /// \brief uint32_t because that's what crc32c uses
@@ -52,15 +69,19 @@ uint32_t internal_header_only_crc(const record_batch_header& header) {
     return c.value();
 }
 
-template<typename T, typename = std::enable_if_t<std::is_integral_v<T>, T>>
-void crc_extend_cpu_to_be(crc32& crc, T i) {
-    auto j = ss::cpu_to_be(i);
-    crc.extend(j);
-}
-
+/// see crc_extend_all_cpu_to_le; one crc32c call over the packed fields
 template<typename... T>
 void crc_extend_all_cpu_to_be(crc32& crc, T... t) {
-    ((crc_extend_cpu_to_be(crc, t)), ...);
+    static_assert((std::is_integral_v<T> && ...));
+    std::array<uint8_t, (sizeof(T) + ...)> buf;
+    size_t pos = 0;
+    auto put = [&buf, &pos](auto i) {
+        auto j = ss::cpu_to_be(i);
+        std::memcpy(buf.data() + pos, &j, sizeof(j));
+        pos += sizeof(j);
+    };
+    ((put(t)), ...);
+    crc.extend(buf.data(), buf.size());
 }
 
 void crc_record_batch_header(crc32& crc, const record_batch_header& header) {
@@ -172,24 +193,92 @@ model::record parse_one_record_copy_from_buffer(iobuf_const_parser& parser) {
       });
 }
 
-static inline void append_vint_to_iobuf(iobuf& b, int64_t v) {
-    auto vb = vint::to_bytes(v);
-    b.append(vb.data(), vb.size());
+/*
+ * walk one record's framing: every variable length field is decoded and
+ * payloads are skipped in place, nothing is copied or materialized
+ */
+static void skip_one_record_from_buffer(iobuf_const_parser& parser) {
+    auto [record_size, rv] = parser.read_varlong();
+    if (unlikely(record_size <= 0)) {
+        throw std::runtime_error(
+          fmt::format("Invalid record size: {}", record_size));
+    }
+    const auto start = parser.bytes_consumed();
+    parser.skip(sizeof(model::record_attributes::type));
+    parser.read_varlong(); // timestamp delta
+    parser.read_varlong(); // offset delta
+    auto [key_length, kv] = parser.read_varlong();
+    if (key_length > 0) {
+        parser.skip(key_length);
+    }
+    auto [value_length, vv] = parser.read_varlong();
+    if (value_length > 0) {
+        parser.skip(value_length);
+    }
+    auto [header_count, hv] = parser.read_varlong();
+    if (unlikely(header_count < 0)) {
+        throw std::runtime_error(
+          fmt::format("Invalid record header count: {}", header_count));
+    }
+    for (int64_t i = 0; i < header_count; ++i) {
+        auto [hkey_length, hkv] = parser.read_varlong();
+        if (hkey_length > 0) {
+            parser.skip(hkey_length);
+        }
+        auto [hvalue_length, hvv] = parser.read_varlong();
+        if (hvalue_length > 0) {
+            parser.skip(hvalue_length);
+        }
+    }
+    const auto consumed = parser.bytes_consumed() - start;
+    if (unlikely(consumed != static_cast<size_t>(record_size))) {
+        throw std::runtime_error(fmt::format(
+          "Record size mismatch. Declared: {}, consumed: {}",
+          record_size,
+          consumed));
+    }
 }
 
-void append_record_to_buffer(iobuf& a, const model::record& r) {
-    a.reserve_memory(vint::max_length * 6);
-    append_vint_to_iobuf(a, r.size_bytes());
+void verify_records_structure(const iobuf& records, int32_t record_count) {
+    iobuf_const_parser parser(records);
+    for (int32_t i = 0; i < record_count; ++i) {
+        skip_one_record_from_buffer(parser);
+    }
+    if (unlikely(parser.bytes_left())) {
+        throw std::runtime_error(fmt::format(
+          "Record validation stopped with {} bytes remaining",
+          parser.bytes_left()));
+    }
+}
 
-    const auto attrs = ss::cpu_to_be(r.attributes().value());
+static inline void append_vint_to_iobuf(iobuf& b, int64_t v) {
+    std::array<uint8_t, vint::max_length> staging{};
+    auto sz = vint::serialize(v, staging.data());
     // NOLINTNEXTLINE
-    a.append(reinterpret_cast<const char*>(&attrs), sizeof(attrs));
+    b.append(reinterpret_cast<const char*>(staging.data()), sz);
+}
 
-    append_vint_to_iobuf(a, r.timestamp_delta());
-    append_vint_to_iobuf(a, r.offset_delta());
+void append_record_to_buffer(iobuf& a, const model::record& r) {
+    /*
+     * the record prefix is a run of small vints around the one byte
+     * attributes field; the whole run is transcoded into a single stack
+     * buffer and appended once instead of once per field
+     */
+    static_assert(
+      sizeof(model::record_attributes::type) == 1,
+      "model attributes expected to be one byte");
+    std::array<uint8_t, 4 * vint::max_length + 1> staging{};
+    auto idx = vint::serialize(r.size_bytes(), staging.data());
+    staging[idx++] = static_cast<uint8_t>(r.attributes().value());
+    idx += vint::serialize_batch(
+      staging.data() + idx,
+      r.timestamp_delta(),
+      r.offset_delta(),
+      r.key_size());
+    // NOLINTNEXTLINE
+    a.append(reinterpret_cast<const char*>(staging.data()), idx);
 
     a.reserve_memory(r.key_size() + r.value_size());
-    append_vint_to_iobuf(a, r.key_size());
     if (r.key_size() > 0) {
         for (auto& f : r.key()) {
             a.append(f.get(), f.size());
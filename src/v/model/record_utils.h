@@ -34,4 +34,9 @@ model::record parse_one_record_from_buffer(iobuf_parser& parser);
 model::record parse_one_record_copy_from_buffer(iobuf_const_parser& parser);
 void append_record_to_buffer(iobuf& a, const model::record& r);
 
+/// \brief validate that the buffer contains exactly record_count well formed
+/// records. walks the record framing and skips over payload bytes without
+/// materializing records, throws std::runtime_error on malformed input
+void verify_records_structure(const iobuf& records, int32_t record_count);
+
 } // namespace model
@@ -155,6 +155,72 @@ SEASTAR_THREAD_TEST_CASE(test_interrupt_consume_multiple_slices) {
     do_test_interrupt_consume(make_generating_reader(
       make_batches(offset(1), offset(2), offset(3), offset(4), offset(5))));
 }
+// generator that hands out one batch per slice and counts invocations, so
+// tests can observe how many loads a wrapping reader issued
+record_batch_reader make_counting_reader(
+  ss::circular_buffer<record_batch> batches, size_t& loads) {
+    return make_generating_record_batch_reader(
+      [batches = std::move(batches), &loads]() mutable {
+          ++loads;
+          record_batch_reader::data_t slice;
+          if (!batches.empty()) {
+              slice.push_back(std::move(batches.front()));
+              batches.pop_front();
+          }
+          return ss::make_ready_future<record_batch_reader::data_t>(
+            std::move(slice));
+      });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_prefetching_foreign_consume) {
+    do_test_consume(make_prefetching_foreign_record_batch_reader(
+      make_generating_reader(
+        make_batches(offset(1), offset(2), offset(3), offset(4)))));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_prefetching_foreign_interrupt_consume) {
+    do_test_interrupt_consume(make_prefetching_foreign_record_batch_reader(
+      make_generating_reader(make_batches(
+        offset(1), offset(2), offset(3), offset(4), offset(5)))));
+}
+
+SEASTAR_THREAD_TEST_CASE(prefetching_reader_pulls_slices_eagerly) {
+    size_t loads = 0;
+    auto reader = make_prefetching_foreign_record_batch_reader(
+      make_counting_reader(
+        make_batches(offset(1), offset(2), offset(3), offset(4), offset(5)),
+        loads),
+      1 << 20);
+    auto first = reader.consume(consumer(1), no_timeout).get0();
+    BOOST_CHECK_EQUAL(first.size(), 1);
+    // the whole stream fits the budget: five slices plus the terminating
+    // empty one are pulled on the first load, the rest are served locally
+    BOOST_CHECK_EQUAL(loads, 6);
+    auto rest = reader.consume(consumer(4), no_timeout).get0();
+    BOOST_CHECK_EQUAL(rest.size(), 4);
+    BOOST_CHECK_EQUAL(loads, 6);
+}
+
+SEASTAR_THREAD_TEST_CASE(prefetching_reader_respects_byte_budget) {
+    size_t loads = 0;
+    auto reader = make_prefetching_foreign_record_batch_reader(
+      make_counting_reader(
+        make_batches(offset(1), offset(2), offset(3), offset(4), offset(5)),
+        loads),
+      1);
+    auto first = reader.consume(consumer(1), no_timeout).get0();
+    BOOST_CHECK_EQUAL(first.size(), 1);
+    // a one byte budget is spent by the first slice of every pull
+    BOOST_CHECK_EQUAL(loads, 1);
+    auto rest = reader.consume(consumer(4), no_timeout).get0();
+    BOOST_CHECK_EQUAL(rest.size(), 4);
+    auto o = offset(2);
+    for (auto& batch : rest) {
+        BOOST_CHECK_EQUAL(batch.base_offset(), o);
+        o += 1;
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(record_batch_sharing) {
     auto v1 = make_batches(
       offset(1), offset(2), offset(3), offset(4), offset(5));
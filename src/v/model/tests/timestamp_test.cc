@@ -0,0 +1,23 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "model/timestamp.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+SEASTAR_THREAD_TEST_CASE(coarse_timestamp_tracks_wall_clock) {
+    auto exact = model::timestamp::now();
+    auto coarse = model::timestamp::now_coarse();
+
+    BOOST_REQUIRE(coarse != model::timestamp::missing());
+    // the coarse clock lags by at most a task quota; anything beyond a
+    // second apart means it is not reading the wall clock at all
+    const auto delta = std::abs(exact.value() - coarse.value());
+    BOOST_REQUIRE_LT(delta, 1000);
+}
@@ -63,6 +63,14 @@ public:
 
     static timestamp now();
 
+    /// Coarse wall-clock read for hot paths. Serves the reactor's cached
+    /// clock instead of issuing a clock_gettime per call, at the cost of
+    /// task-quota granularity (single digit milliseconds). Timestamps are
+    /// millisecond-resolution anyway, so paths invoked per record batch -
+    /// append-time stamping, internal batch building - should prefer this;
+    /// use now() where an exact reading matters.
+    static timestamp now_coarse();
+
 private:
     type _v = missing().value();
 };
@@ -77,5 +85,13 @@ inline timestamp new_timestamp() {
                        .count());
 }
 
+inline timestamp new_coarse_timestamp() {
+    return timestamp(std::chrono::duration_cast<std::chrono::milliseconds>(
+                       ss::lowres_system_clock::now().time_since_epoch())
+                       .count());
+}
+
 inline timestamp timestamp::now() { return new_timestamp(); }
+
+inline timestamp timestamp::now_coarse() { return new_coarse_timestamp(); }
 } // namespace model
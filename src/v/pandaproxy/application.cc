@@ -9,8 +9,10 @@
 
 #include "pandaproxy/application.h"
 
+#include "json/iobuf_buffer.h"
 #include "kafka/client/configuration.h"
 #include "pandaproxy/configuration.h"
+#include "pandaproxy/reply.h"
 #include "platform/stop_signal.h"
 #include "ssx/future-util.h"
 #include "syschecks/syschecks.h"
@@ -170,10 +172,13 @@ void application::configure_admin_server() {
               rb->register_api_file(server._routes, "config");
               ss::httpd::config_json::get_config.set(
                 server._routes, [](ss::const_req) {
-                    rapidjson::StringBuffer buf;
-                    rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+                    iobuf body;
+                    json::iobuf_buffer buf(body);
+                    rapidjson::Writer<json::iobuf_buffer> writer(buf);
                     shard_local_cfg().to_json(writer);
-                    return ss::json::json_return_type(buf.GetString());
+                    buf.Flush();
+                    return ss::json::json_return_type(
+                      as_body_writer(std::move(body)));
                 });
           })
           .get();
@@ -9,6 +9,8 @@
 
 #include "handlers.h"
 
+#include "json/iobuf_buffer.h"
+#include "kafka/errors.h"
 #include "kafka/requests/fetch_request.h"
 #include "model/fundamental.h"
 #include "pandaproxy/json/requests/fetch.h"
@@ -46,6 +48,12 @@ ppj::serialization_format parse_serialization_format(std::string_view accept) {
         return ppj::serialization_format::binary_v2;
     }
 
+    if (std::any_of(results.begin(), results.end(), [](std::string_view v) {
+            return v == "application/vnd.kafka.binary.v2+binary";
+        })) {
+        return ppj::serialization_format::binary_v2_raw;
+    }
+
     if (std::any_of(
           results.begin(), results.end(), [&none](std::string_view lhs) {
               return std::any_of(
@@ -79,8 +87,8 @@ get_topics_names(server::request_t rq, server::reply_t rp) {
                 return model::topic_view(e.name);
             });
 
-          auto json_rslt = ppj::rjson_serialize(names);
-          rp.rep->write_body("json", json_rslt);
+          auto json_rslt = ppj::rjson_serialize_iobuf(names);
+          rp.rep->write_body("json", as_body_writer(std::move(json_rslt)));
           return std::move(rp);
       });
 }
@@ -109,14 +117,77 @@ get_topics_records(server::request_t rq, server::reply_t rp) {
     return rq.ctx.client
       .fetch_partition(std::move(tp), offset, max_bytes, timeout)
       .then([fmt, rp = std::move(rp)](kafka::fetch_response res) mutable {
-          rapidjson::StringBuffer str_buf;
-          rapidjson::Writer<rapidjson::StringBuffer> w(str_buf);
+          if (fmt == ppj::serialization_format::binary_v2_raw) {
+              for (auto& v : res) {
+                  if (v.partition_response->has_error()) {
+                      ppj::error_body e{
+                        .error_code = ss::httpd::reply::status_type::not_found,
+                        .message{ss::sstring{kafka::error_code_to_str(
+                          v.partition_response->error)}}};
+                      auto json_rslt = ppj::rjson_serialize_iobuf(e);
+                      rp.rep->write_body(
+                        "json", as_body_writer(std::move(json_rslt)));
+                      return std::move(rp);
+                  }
+              }
+              /// Raw mode: hand the kafka batches to the consumer as-is,
+              /// no re-encoding on the proxy
+              iobuf body;
+              for (auto& v : res) {
+                  auto& pr = *v.partition_response;
+                  if (pr.record_set) {
+                      body.append(std::move(*pr.record_set));
+                  }
+              }
+              rp.mime_type = "application/vnd.kafka.binary.v2+binary";
+              rp.rep->write_body("bin", as_body_writer(std::move(body)));
+              return std::move(rp);
+          }
+
+          iobuf json_rslt;
+          ::json::iobuf_buffer buf(json_rslt);
+          rapidjson::Writer<::json::iobuf_buffer> w(buf);
 
           ppj::rjson_serialize_fmt(fmt)(w, std::move(res));
+          buf.Flush();
 
-          // TODO Ben: Prevent this linearization
-          ss::sstring json_rslt = str_buf.GetString();
-          rp.rep->write_body("json", json_rslt);
+          rp.rep->write_body("json", as_body_writer(std::move(json_rslt)));
+          return std::move(rp);
+      });
+}
+
+/// Raw passthrough produce: the body is a single record value, no JSON
+/// or base64 decode on the proxy. The target partition is given by the
+/// 'partition' query parameter and defaults to 0.
+static ss::future<server::reply_t>
+post_topics_name_raw(server::request_t rq, server::reply_t rp) {
+    auto topic = model::topic(rq.req->param["topic_name"]);
+    model::partition_id partition{0};
+    if (auto p = rq.req->get_query_param("partition"); !p.empty()) {
+        partition = model::partition_id{
+          boost::lexical_cast<model::partition_id::type>(p)};
+    }
+
+    iobuf value;
+    value.append(rq.req->content.data(), rq.req->content.size());
+    rq.req.reset();
+
+    storage::record_batch_builder builder(
+      raft::data_batch_type, model::offset(0));
+    builder.add_raw_kv(iobuf{}, std::move(value));
+
+    return rq.ctx.client
+      .produce_record_batch(
+        model::topic_partition(topic, partition), std::move(builder).build())
+      .then([topic, rp{std::move(rp)}](
+              kafka::produce_response::partition res) mutable {
+          std::vector<kafka::produce_response::partition> partitions;
+          partitions.push_back(std::move(res));
+          auto topic_res = kafka::produce_response::topic{
+            .name{std::move(topic)}, .partitions{std::move(partitions)}};
+
+          auto json_rslt = ppj::rjson_serialize_iobuf(topic_res);
+          rp.rep->write_body("json", as_body_writer(std::move(json_rslt)));
           return std::move(rp);
       });
 }
@@ -129,6 +200,12 @@ post_topics_name(server::request_t rq, server::reply_t rp) {
         return ss::make_ready_future<server::reply_t>(std::move(rp));
     }
 
+    if (
+      parse_serialization_format(rq.req->get_header("Content-Type"))
+      == ppj::serialization_format::binary_v2_raw) {
+        return post_topics_name_raw(std::move(rq), std::move(rp));
+    }
+
     auto raw_records = ppj::rjson_parse(
       rq.req->content.data(), ppj::produce_request_handler(fmt));
 
@@ -174,8 +251,8 @@ post_topics_name(server::request_t rq, server::reply_t rp) {
             .topics{std::move(topics)},
             .throttle{std::chrono::milliseconds{0}}};
 
-          auto json_rslt = ppj::rjson_serialize(res.topics[0]);
-          rp.rep->write_body("json", json_rslt);
+          auto json_rslt = ppj::rjson_serialize_iobuf(res.topics[0]);
+          rp.rep->write_body("json", as_body_writer(std::move(json_rslt)));
           return std::move(rp);
       });
 }
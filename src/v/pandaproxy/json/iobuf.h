@@ -62,7 +62,8 @@ public:
     explicit rjson_serialize_impl(serialization_format fmt)
       : _fmt(fmt) {}
 
-    bool operator()(rapidjson::Writer<rapidjson::StringBuffer>& w, iobuf buf) {
+    template<typename Buffer>
+    bool operator()(rapidjson::Writer<Buffer>& w, iobuf buf) {
         switch (_fmt) {
         case serialization_format::none:
             [[fallthrough]];
@@ -75,8 +76,8 @@ public:
         }
     }
 
-    bool
-    encode_base64(rapidjson::Writer<rapidjson::StringBuffer>& w, iobuf buf) {
+    template<typename Buffer>
+    bool encode_base64(rapidjson::Writer<Buffer>& w, iobuf buf) {
         if (buf.empty()) {
             return w.String("", 0);
         }
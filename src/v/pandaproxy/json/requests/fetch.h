@@ -45,8 +45,8 @@ public:
       , _tpv(tpv)
       , _base_offset(base_offset) {}
 
-    void operator()(
-      rapidjson::Writer<rapidjson::StringBuffer>& w, model::record record) {
+    template<typename Buffer>
+    void operator()(rapidjson::Writer<Buffer>& w, model::record record) {
         w.StartObject();
         w.Key("topic");
         ::json::rjson_serialize(w, _tpv.topic);
@@ -73,9 +73,8 @@ public:
     explicit rjson_serialize_impl(serialization_format fmt)
       : _fmt(fmt) {}
 
-    void operator()(
-      rapidjson::Writer<rapidjson::StringBuffer>& w,
-      kafka::fetch_response&& res) {
+    template<typename Buffer>
+    void operator()(rapidjson::Writer<Buffer>& w, kafka::fetch_response&& res) {
         // Eager check for errors
         for (auto& v : res) {
             if (v.partition_response->has_error()) {
@@ -15,8 +15,12 @@
 #include "pandaproxy/json/rjson_util.h"
 #include "seastarx.h"
 
+#include <seastar/core/temporary_buffer.hh>
 #include <seastar/testing/thread_test_case.hh>
 
+#include <algorithm>
+#include <string_view>
+
 namespace ppj = pandaproxy::json;
 
 auto make_binary_v2_handler() {
@@ -53,6 +57,47 @@ SEASTAR_THREAD_TEST_CASE(test_produce_request) {
     BOOST_TEST(records[1].id == model::partition_id(1));
 }
 
+SEASTAR_THREAD_TEST_CASE(test_produce_request_from_iobuf) {
+    auto input = R"(
+      {
+        "records": [
+          {
+            "value": "dmVjdG9yaXplZA==",
+            "partition": 0
+          },
+          {
+            "value": "cGFuZGFwcm94eQ==",
+            "partition": 1
+          }
+        ]
+      })";
+
+    /// Feed the document in small fragments to exercise the reader
+    /// pulling bytes across iobuf fragment boundaries
+    iobuf buf;
+    auto remaining = std::string_view(input);
+    while (!remaining.empty()) {
+        auto len = std::min(remaining.size(), size_t(7));
+        ss::temporary_buffer<char> frag(remaining.data(), len);
+        buf.append(std::move(frag));
+        remaining.remove_prefix(len);
+    }
+
+    auto records = ppj::rjson_parse(std::move(buf), make_binary_v2_handler());
+    BOOST_TEST(records.size() == 2);
+    BOOST_TEST(!!records[0].value);
+
+    auto parser = iobuf_parser(std::move(*records[0].value));
+    auto value = parser.read_string(parser.bytes_left());
+    BOOST_TEST(value == "vectorized");
+    BOOST_TEST(records[0].id == model::partition_id(0));
+
+    parser = iobuf_parser(std::move(*records[1].value));
+    value = parser.read_string(parser.bytes_left());
+    BOOST_TEST(value == "pandaproxy");
+    BOOST_TEST(records[1].id == model::partition_id(1));
+}
+
 SEASTAR_THREAD_TEST_CASE(test_produce_request_empty) {
     auto input = R"(
       {
@@ -11,17 +11,22 @@
 
 #pragma once
 
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_istreambuf.h"
+#include "json/iobuf_buffer.h"
 #include "json/json.h"
 #include "pandaproxy/json/types.h"
 #include "utils/concepts-enabled.h"
 
 #include <seastar/core/sstring.hh>
 
+#include <rapidjson/istreamwrapper.h>
 #include <rapidjson/reader.h>
 #include <rapidjson/stream.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <istream>
 #include <stdexcept>
 
 namespace pandaproxy::json {
@@ -48,6 +53,23 @@ ss::sstring rjson_serialize(const T& v) {
     return ss::sstring(str_buf.GetString(), str_buf.GetSize());
 }
 
+/// Serialize into an iobuf rather than a contiguous string. The writer
+/// streams through a small staging buffer, so memory per request stays
+/// constant regardless of the size of the serialized value.
+template<typename T>
+iobuf rjson_serialize_iobuf(const T& v) {
+    iobuf buf;
+    ::json::iobuf_buffer out(buf);
+    rapidjson::Writer<::json::iobuf_buffer> wrt(out);
+
+    using ::json::rjson_serialize;
+    using ::pandaproxy::json::rjson_serialize;
+    rjson_serialize(wrt, v);
+    out.Flush();
+
+    return buf;
+}
+
 struct rjson_serialize_fmt_impl {
     explicit rjson_serialize_fmt_impl(serialization_format fmt)
       : fmt{fmt} {}
@@ -58,8 +80,8 @@ struct rjson_serialize_fmt_impl {
         rjson_serialize_impl<std::remove_reference_t<T>>{fmt}(
           std::forward<T>(t));
     }
-    template<typename T>
-    void operator()(rapidjson::Writer<rapidjson::StringBuffer>& w, T&& t) {
+    template<typename Buffer, typename T>
+    void operator()(rapidjson::Writer<Buffer>& w, T&& t) {
         rjson_serialize_impl<std::remove_reference_t<T>>{fmt}(
           w, std::forward<T>(t));
     }
@@ -83,4 +105,23 @@ typename Handler::rjson_parse_result
     return std::move(handler.result);
 }
 
+/// SAX parse directly from iobuf fragments. The reader pulls bytes out of
+/// the fragments through iobuf_istreambuf, so the document is never
+/// materialized as a contiguous string.
+template<typename Handler>
+CONCEPT(requires std::is_same_v<
+        decltype(std::declval<Handler>().result),
+        typename Handler::rjson_parse_result>)
+typename Handler::rjson_parse_result
+  rjson_parse(iobuf buf, Handler&& handler) {
+    iobuf_istreambuf ibuf(buf);
+    std::istream stream(&ibuf);
+    rapidjson::IStreamWrapper wrapper(stream);
+    rapidjson::Reader reader;
+    if (!reader.Parse(wrapper, handler)) {
+        throw parse_error(reader.GetErrorOffset());
+    }
+    return std::move(handler.result);
+}
+
 } // namespace pandaproxy::json
@@ -10,6 +10,7 @@
 #include "pandaproxy/json/iobuf.h"
 
 #include "bytes/iobuf_parser.h"
+#include "json/iobuf_buffer.h"
 #include "json/json.h"
 #include "pandaproxy/json/rjson_util.h"
 
@@ -48,3 +49,20 @@ SEASTAR_THREAD_TEST_CASE(test_iobuf_serialize_binary) {
 
     BOOST_REQUIRE_EQUAL(output, expected);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_iobuf_serialize_binary_to_iobuf) {
+    iobuf in_buf;
+    auto input = ss::sstring("pandaproxy");
+    auto expected = ss::sstring("\"cGFuZGFwcm94eQ==\"");
+    in_buf.append(input.data(), input.size());
+
+    iobuf out_buf;
+    json::iobuf_buffer buffer(out_buf);
+    rapidjson::Writer<json::iobuf_buffer> w(buffer);
+    ppj::rjson_serialize_fmt(ppj::serialization_format::binary_v2)(
+      w, std::move(in_buf));
+    buffer.Flush();
+
+    iobuf_parser p(std::move(out_buf));
+    BOOST_REQUIRE_EQUAL(p.read_string(p.bytes_left()), expected);
+}
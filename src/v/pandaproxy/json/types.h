@@ -15,7 +15,14 @@
 
 namespace pandaproxy::json {
 
-enum class serialization_format : uint8_t { none = 0, binary_v2, unsupported };
+enum class serialization_format : uint8_t {
+    none = 0,
+    binary_v2,
+    /// Raw passthrough: the HTTP body is the record payload, no JSON or
+    /// base64 involved.
+    binary_v2_raw,
+    unsupported
+};
 
 template<typename T>
 class rjson_parse_impl;
@@ -11,17 +11,33 @@
 
 #pragma once
 
+#include "bytes/iobuf.h"
 #include "pandaproxy/json/requests/error_reply.h"
 #include "pandaproxy/json/rjson_util.h"
 #include "pandaproxy/logger.h"
 #include "seastarx.h"
 
 #include <seastar/core/gate.hh>
+#include <seastar/core/iostream.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/http/reply.hh>
 
 namespace pandaproxy {
 
+/// Stream an iobuf as a reply body, fragment by fragment, without
+/// linearizing it into a contiguous string first.
+inline auto as_body_writer(iobuf buf) {
+    return [buf{std::move(buf)}](ss::output_stream<char>&& out) mutable {
+        return ss::do_with(
+          std::move(buf),
+          std::move(out),
+          [](iobuf& buf, ss::output_stream<char>& out) {
+              return write_iobuf_to_output_stream(std::move(buf), out)
+                .finally([&out] { return out.close(); });
+          });
+    };
+}
+
 inline ss::httpd::reply& set_reply_unavailable(ss::httpd::reply& rep) {
     return rep.set_status(ss::httpd::reply::status_type::service_unavailable)
       .add_header("Retry-After", "0");
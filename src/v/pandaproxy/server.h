@@ -46,6 +46,7 @@ public:
 
     struct reply_t {
         std::unique_ptr<ss::httpd::reply> rep;
+        ss::sstring mime_type{"application/vnd.kafka.binary.v2+json"};
         // will contains other extensions passed to user specific handler.
     };
 
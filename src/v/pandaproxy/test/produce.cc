@@ -97,3 +97,59 @@ FIXTURE_TEST(pandaproxy_produce, pandaproxy_test_fixture) {
           res.body, R"({"offsets":[{"partition":0,"offset":4}]})");
     }
 }
+
+FIXTURE_TEST(pandaproxy_produce_raw, pandaproxy_test_fixture) {
+    using namespace std::chrono_literals;
+
+    kc::shard_local_cfg().retry_base_backoff.set_value(10ms);
+    kc::shard_local_cfg().produce_batch_delay.set_value(0ms);
+
+    info("Waiting for leadership");
+    wait_for_controller_leadership().get();
+
+    info("Connecting client");
+    auto client = make_client();
+
+    info("Adding known topic");
+    auto tp = model::topic_partition(model::topic("t"), model::partition_id(0));
+    auto ntp = make_default_ntp(tp.topic, tp.partition);
+    add_topic(model::topic_namespace_view(ntp)).get();
+
+    {
+        info("Produce raw body to known topic");
+        // Will require a metadata update
+        kc::shard_local_cfg().retries.set_value(size_t(5));
+        const ss::sstring raw_body("vectorized");
+        auto body = iobuf();
+        body.append(raw_body.data(), raw_body.size());
+        auto res = http_request(
+          client,
+          "/topics/t?partition=0",
+          std::move(body),
+          boost::beast::http::verb::post,
+          "application/vnd.kafka.binary.v2+binary");
+
+        BOOST_REQUIRE_EQUAL(
+          res.headers.result(), boost::beast::http::status::ok);
+        BOOST_REQUIRE_EQUAL(
+          res.headers.at(boost::beast::http::field::content_type),
+          "application/vnd.kafka.binary.v2+json");
+        BOOST_REQUIRE_EQUAL(
+          res.body, R"({"offsets":[{"partition":0,"offset":1}]})");
+    }
+
+    {
+        info("Fetch offset 1 - expect the raw produced value");
+        kc::shard_local_cfg().retries.set_value(size_t(0));
+        auto res = http_request(
+          client,
+          "/topics/t/partitions/0/"
+          "records?offset=1&max_bytes=1024&timeout=5000");
+
+        BOOST_REQUIRE_EQUAL(
+          res.headers.result(), boost::beast::http::status::ok);
+        BOOST_REQUIRE_EQUAL(
+          res.body,
+          R"([{"topic":"t","key":"","value":"dmVjdG9yaXplZA==","partition":0,"offset":1}])");
+    }
+}
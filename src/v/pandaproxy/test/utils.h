@@ -32,16 +32,16 @@ inline ss::sstring consume_body(http::client::response_stream& res) {
 inline http::client::request_header make_header(
   boost::beast::http::verb method,
   boost::beast::string_view target,
-  iobuf const& body) {
+  iobuf const& body,
+  boost::beast::string_view content_type
+  = "application/vnd.kafka.binary.v2+json") {
     http::client::request_header hdr;
     hdr.method(method);
     hdr.target(target);
     hdr.insert(
       boost::beast::http::field::content_length,
       boost::beast::to_static_string(body.size_bytes()));
-    hdr.insert(
-      boost::beast::http::field::content_type,
-      "application/vnd.kafka.binary.v2+json");
+    hdr.insert(boost::beast::http::field::content_type, content_type);
     return hdr;
 }
 
@@ -49,8 +49,10 @@ inline consumed_response do_request(
   http::client& client,
   boost::beast::http::verb method,
   boost::beast::string_view target,
-  iobuf&& body) {
-    auto hdr = make_header(method, target, body);
+  iobuf&& body,
+  boost::beast::string_view content_type
+  = "application/vnd.kafka.binary.v2+json") {
+    auto hdr = make_header(method, target, body, content_type);
     auto [req, res] = client.make_request(std::move(hdr)).get();
     req->send_some(std::move(body)).get();
     req->send_eof().get();
@@ -70,6 +72,8 @@ inline consumed_response http_request(
   http::client& client,
   boost::beast::string_view target,
   iobuf&& body,
-  boost::beast::http::verb method = boost::beast::http::verb::post) {
-    return do_request(client, method, target, std::move(body));
+  boost::beast::http::verb method = boost::beast::http::verb::post,
+  boost::beast::string_view content_type
+  = "application/vnd.kafka.binary.v2+json") {
+    return do_request(client, method, target, std::move(body), content_type);
 }
@@ -15,10 +15,20 @@
 
 #include <seastar/core/sstring.hh>
 
+#include <absl/container/flat_hash_map.h>
+
 #include <algorithm>
 
 struct prometheus_sanitize {
+    /// Sanitized names are cached per shard: every partition probe
+    /// re-registers the same handful of metric names, so after warm-up
+    /// this is a lookup instead of a string rewrite per registration.
     static ss::sstring metrics_name(const ss::sstring& n) {
+        static thread_local absl::flat_hash_map<ss::sstring, ss::sstring>
+          cache;
+        if (auto it = cache.find(n); it != cache.end()) {
+            return it->second;
+        }
         auto copy = n;
         constexpr char value = '_';
         std::replace_if(
@@ -26,6 +36,7 @@ struct prometheus_sanitize {
           copy.end(),
           [](auto c) { return !std::isalnum(c); },
           value);
+        cache.emplace(n, copy);
         return copy;
     }
 };
@@ -31,9 +31,15 @@ append_entries_buffer::enqueue(append_entries_request&& r) {
           .then([this, r = std::move(r)]() mutable {
               ss::promise<append_entries_reply> p;
               auto f = p.get_future();
+              // edge triggered: the dispatch loop drains the whole queue in
+              // one exchange, so only the empty->non-empty transition has a
+              // sleeping consumer to wake
+              const bool was_empty = _requests.empty();
               _requests.push_back(std::move(r));
               _responses.push_back(std::move(p));
-              _enqueued.signal();
+              if (was_empty) {
+                  _enqueued.signal();
+              }
               return f;
           });
     });
@@ -64,16 +70,18 @@ ss::future<> append_entries_buffer::flush() {
     auto requests = std::exchange(_requests, {});
     auto response_promises = std::exchange(_responses, {});
 
-    return _consensus._op_lock.with(
+    return _consensus._op_lock.get_units().then(
       [this,
        requests = std::move(requests),
-       response_promises = std::move(response_promises)]() mutable {
-          return do_flush(std::move(requests), std::move(response_promises));
+       response_promises = std::move(response_promises)](
+        ss::semaphore_units<> u) mutable {
+          return do_flush(
+            std::move(requests), std::move(response_promises), std::move(u));
       });
 }
 
 ss::future<> append_entries_buffer::do_flush(
-  request_t requests, response_t response_promises) {
+  request_t requests, response_t response_promises, ss::semaphore_units<> u) {
     bool needs_flush = false;
     std::vector<reply_t> replies;
     replies.reserve(requests.size());
@@ -89,12 +97,57 @@ ss::future<> append_entries_buffer::do_flush(
             replies.emplace_back(std::current_exception());
         }
     }
-    if (needs_flush) {
-        co_await _consensus.flush_log();
+    /*
+     * the appends are done and the flush does not need the op mutex, so
+     * finish in the background and let the mutex go when this coroutine
+     * returns. the next buffered batch then appends to the log while this
+     * one is being fsynced - follower side group commit - and flush_log
+     * coalesces the overlapping flushes into shared rounds.
+     */
+    if (_gate.is_closed()) {
+        // shutting down, finish inline instead of racing with gate close
+        std::exception_ptr ex;
+        if (needs_flush) {
+            try {
+                co_await _consensus.flush_log();
+            } catch (...) {
+                ex = std::current_exception();
+            }
+        }
+        if (ex) {
+            for (auto& p : response_promises) {
+                p.set_exception(ex);
+            }
+        } else {
+            propagate_results(std::move(replies), std::move(response_promises));
+        }
+        co_return;
     }
-
-    propagate_results(std::move(replies), std::move(response_promises));
-    _flushed.broadcast();
+    (void)ss::with_gate(
+      _gate,
+      [this,
+       needs_flush,
+       replies = std::move(replies),
+       response_promises = std::move(response_promises)]() mutable {
+          auto f = needs_flush ? _consensus.flush_log()
+                               : ss::make_ready_future<>();
+          return std::move(f).then_wrapped(
+            [this,
+             replies = std::move(replies),
+             response_promises = std::move(response_promises)](
+              ss::future<> flushed) mutable {
+                if (flushed.failed()) {
+                    auto ex = flushed.get_exception();
+                    for (auto& p : response_promises) {
+                        p.set_exception(ex);
+                    }
+                } else {
+                    propagate_results(
+                      std::move(replies), std::move(response_promises));
+                }
+                _flushed.broadcast();
+            });
+      });
     co_return;
 }
 
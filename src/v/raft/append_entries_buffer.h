@@ -2,8 +2,10 @@
 
 #include "raft/types.h"
 
+#include <seastar/core/chunked_fifo.hh>
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
 
 namespace raft {
 
@@ -131,12 +133,14 @@ public:
     ss::future<> stop();
 
 private:
-    using request_t = std::vector<append_entries_request>;
-    using response_t = std::vector<ss::promise<append_entries_reply>>;
+    // chunked fifos keep enqueue allocation-free within a chunk and never
+    // relocate buffered requests the way a growing vector would
+    using request_t = ss::chunked_fifo<append_entries_request>;
+    using response_t = ss::chunked_fifo<ss::promise<append_entries_reply>>;
     using reply_t = std::variant<append_entries_reply, std::exception_ptr>;
 
     ss::future<> flush();
-    ss::future<> do_flush(request_t, response_t);
+    ss::future<> do_flush(request_t, response_t, ss::semaphore_units<>);
 
     void propagate_results(std::vector<reply_t>, response_t);
 
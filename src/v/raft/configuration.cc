@@ -461,4 +461,16 @@ raft::vnode adl<raft::vnode>::from(iobuf_parser& p) {
     return raft::vnode(id, rev);
 }
 
+void flat_codec<raft::vnode>::encode(char* dst, const raft::vnode& id) {
+    flat_codec<model::node_id>::encode(dst, id.id());
+    flat_codec<model::revision_id>::encode(
+      dst + flat_codec<model::node_id>::size, id.revision());
+}
+
+raft::vnode flat_codec<raft::vnode>::decode(iobuf_parser& p) {
+    auto id = flat_codec<model::node_id>::decode(p);
+    auto rev = flat_codec<model::revision_id>::decode(p);
+    return raft::vnode(id, rev);
+}
+
 } // namespace reflection
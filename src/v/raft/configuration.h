@@ -12,6 +12,7 @@
 #pragma once
 #include "model/metadata.h"
 #include "reflection/adl.h"
+#include "reflection/flat_adl.h"
 #include "utils/concepts-enabled.h"
 
 #include <boost/range/join.hpp>
@@ -311,4 +312,14 @@ struct adl<raft::group_configuration> {
     void to(iobuf&, raft::group_configuration);
     raft::group_configuration from(iobuf_parser&);
 };
+// vnode keeps its members private so a flat_layout<> cannot name them; a
+// hand written codec lets the flat encoders for the raft control types embed
+// it. wire format matches adl<raft::vnode>
+template<>
+struct flat_codec<raft::vnode> {
+    static constexpr size_t size = flat_codec<model::node_id>::size
+                                   + flat_codec<model::revision_id>::size;
+    static void encode(char*, const raft::vnode&);
+    static raft::vnode decode(iobuf_parser&);
+};
 } // namespace reflection
@@ -28,12 +28,22 @@ configuration_manager::configuration_manager(
   storage::api& storage,
   ctx_log& log)
   : _group(group)
+  , _latest_cfg(initial_cfg)
   , _storage(storage)
   , _ctxlog(log) {
     vlog(_ctxlog.trace, "Initial configuration: {}", initial_cfg);
     _configurations.emplace(model::offset{}, std::move(initial_cfg));
 }
 
+void configuration_manager::refresh_latest_cache() {
+    vassert(
+      !_configurations.empty(),
+      "Configuration manager should always have at least one configuration");
+    auto it = _configurations.rbegin();
+    _latest_cfg = it->second;
+    _latest_offset = it->first;
+}
+
 ss::future<> configuration_manager::truncate(model::offset offset) {
     vlog(_ctxlog.trace, "Truncating configurations at {}", offset);
     if (unlikely(offset <= _configurations.begin()->first)) {
@@ -46,6 +56,7 @@ ss::future<> configuration_manager::truncate(model::offset offset) {
     return _lock.with([this, offset] {
         auto it = _configurations.lower_bound(offset);
         _configurations.erase(it, _configurations.end());
+        refresh_latest_cache();
 
         _highest_known_offset = std::min(offset, _highest_known_offset);
         return store_highest_known_offset().then(
@@ -82,6 +93,7 @@ void configuration_manager::add_configuration(
           "already exists",
           offset));
     }
+    refresh_latest_cache();
 }
 
 ss::future<>
@@ -126,14 +138,14 @@ const group_configuration& configuration_manager::get_latest() const {
     vassert(
       !_configurations.empty(),
       "Configuration manager should always have at least one configuration");
-    return _configurations.rbegin()->second;
+    return _latest_cfg;
 }
 
 model::offset configuration_manager::get_latest_offset() const {
     vassert(
       !_configurations.empty(),
       "Configuration manager should always have at least one configuration");
-    return _configurations.rbegin()->first;
+    return _latest_offset;
 }
 
 std::optional<group_configuration>
@@ -251,6 +263,7 @@ ss::future<> configuration_manager::start(bool reset) {
                   .then([this](underlying_t cfgs) {
                       _configurations = std::move(cfgs);
                       if (!_configurations.empty()) {
+                          refresh_latest_cache();
                           _highest_known_offset
                             = _configurations.rbegin()->first;
                       }
@@ -331,7 +344,7 @@ model::revision_id configuration_manager::get_latest_revision() const {
       !_configurations.empty(),
       "Configuration manager should always have at least one "
       "configuration");
-    return _configurations.rbegin()->second.revision_id();
+    return _latest_cfg.revision_id();
 }
 
 std::ostream& operator<<(std::ostream& o, const configuration_manager& m) {
@@ -148,9 +148,18 @@ private:
     bytes highest_known_offset_key();
 
     void add_configuration(model::offset, group_configuration);
+    void refresh_latest_cache();
 
     raft::group_id _group;
     underlying_t _configurations;
+    /**
+     * Cached copy of the most recent configuration together with its offset.
+     * Refreshed on every mutation of _configurations so that the
+     * get_latest*() accessors, called on every append, are O(1) and do not
+     * walk the map.
+     */
+    group_configuration _latest_cfg;
+    model::offset _latest_offset;
     /**
      * The highest know offset is latest offset for which configuration manager
      * has all configurations. In other words, some configuration may be in the
@@ -159,7 +168,7 @@ private:
     model::offset _highest_known_offset;
     storage::api& _storage;
     ss::condition_variable _config_changed;
-    mutex _lock;
+    mutex _lock{"raft::configuration_manager"};
     /**
      * We will persist highest known offset every 64MB, given this during
      * bootstrap redpanda will have to read up to 64MB per raft group.
@@ -12,6 +12,7 @@
 #include "config/configuration.h"
 #include "likely.h"
 #include "model/metadata.h"
+#include "model/namespace.h"
 #include "prometheus/prometheus_sanitize.h"
 #include "raft/configuration.h"
 #include "raft/consensus_client_protocol.h"
@@ -24,18 +25,27 @@
 #include "raft/types.h"
 #include "raft/vote_stm.h"
 #include "reflection/adl.h"
+#include "resource_mgmt/io_priority.h"
+#include "utils/lazy_message.h"
 #include "utils/state_crc_file.h"
 #include "utils/state_crc_file_errc.h"
 #include "vlog.h"
 
 #include <seastar/core/fstream.hh>
+#include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/semaphore.hh>
 
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <iterator>
 
 namespace raft {
+
+// upper bound on log fdatasyncs in flight across all groups on a shard
+static constexpr size_t max_concurrent_log_flushes = 16;
+
 consensus::consensus(
   model::node_id nid,
   group_id group,
@@ -57,6 +67,7 @@ consensus::consensus(
   , _leader_notification(std::move(cb))
   , _fstats(_self)
   , _batcher(this, config::shard_local_cfg().raft_replicate_batch_window_size())
+  , _relaxed_flush_delay(config::shard_local_cfg().raft_relaxed_flush_delay_ms())
   , _event_manager(this)
   , _ctxlog(group, _log.config().ntp())
   , _replicate_append_timeout(
@@ -64,8 +75,11 @@ consensus::consensus(
   , _recovery_append_timeout(
       config::shard_local_cfg().recovery_append_timeout_ms())
   , _storage(storage)
+  // snapshot persistence gets its own io lane so writing a large
+  // snapshot cannot starve this group's append path
   , _snapshot_mgr(
-      std::filesystem::path(_log.config().work_directory()), _io_priority)
+      std::filesystem::path(_log.config().work_directory()),
+      raft_snapshot_priority())
   , _configuration_manager(std::move(initial_cfg), _group, _storage, _ctxlog)
   , _append_requests_buffer(*this, 256) {
     setup_metrics();
@@ -74,6 +88,7 @@ consensus::consensus(
         maybe_step_down();
         dispatch_vote(false);
     });
+    _relaxed_flush_timer.set_callback([this] { dispatch_flush_with_lock(); });
 }
 
 void consensus::setup_metrics() {
@@ -129,9 +144,36 @@ void consensus::maybe_step_down() {
     });
 }
 
+bool consensus::has_leader_lease() const {
+    if (!is_leader() || unlikely(_transferring_leadership)) {
+        // during a transfer the target may win an election and commit
+        // before our timers notice; the lease math below no longer holds
+        return false;
+    }
+    auto quorum_ack = config().quorum_match([this](vnode rni) {
+        if (rni == _self) {
+            return clock_type::now();
+        }
+        if (auto it = _fstats.find(rni); it != _fstats.end()) {
+            return it->second.last_acked_request_timestamp;
+        }
+        // never acknowledged anything, does not extend the lease
+        return clock_type::time_point::min();
+    });
+    /**
+     * A majority reset their election timers no earlier than quorum_ack,
+     * so no candidate can win an election before quorum_ack plus the
+     * election timeout base (jitter only extends it). Half of the base is
+     * kept as safety margin: monotonic clocks can not jump but their
+     * rates drift between nodes.
+     */
+    return clock_type::now() < quorum_ack + _jit.base_duration() / 2;
+}
+
 ss::future<> consensus::stop() {
     vlog(_ctxlog.info, "Stopping");
     _vote_timeout.cancel();
+    _relaxed_flush_timer.cancel();
     _as.request_abort();
     _commit_index_updated.broken();
     _disk_append.broken();
@@ -165,7 +207,7 @@ consensus::success_reply consensus::update_follower_index(
           _ctxlog.trace,
           "Error append entries response from {}, {}",
           physical_node,
-          r.error().message());
+          lazy::msg(r.error()));
         // add stats to group
         return success_reply::no;
     }
@@ -269,6 +311,17 @@ consensus::success_reply consensus::update_follower_index(
     }
 
     if (reply.result == append_entries_reply::status::success) {
+        // lease accounting: when no newer request was dispatched to this
+        // follower the recorded send timestamp still belongs to the
+        // request being acknowledged, so the follower's election timer
+        // was reset no earlier than it. replies to superseded requests
+        // are skipped - the newer in-flight request will refresh the
+        // lease instead
+        if (seq() + 1 == idx.last_sent_seq()) {
+            idx.last_acked_request_timestamp = std::max(
+              idx.last_acked_request_timestamp,
+              idx.last_sent_request_timestamp);
+        }
         successfull_append_entries_reply(idx, std::move(reply));
         return success_reply::yes;
     }
@@ -338,7 +391,10 @@ void consensus::maybe_promote_to_voter(vnode id) {
           })
           .then([this, id](std::error_code ec) {
               vlog(
-                _ctxlog.trace, "node {} promotion result {}", id, ec.message());
+                _ctxlog.trace,
+                "node {} promotion result {}",
+                id,
+                lazy::msg(ec));
           });
     }).handle_exception_type([](const ss::gate_closed_exception&) {});
 }
@@ -462,6 +518,14 @@ ss::future<result<replicate_result>> consensus::do_replicate(
                                details::term_assigning_reader>(
                                std::move(rdr), model::term_id(_term)))
             .then([this](storage::append_result res) {
+                /*
+                 * respond as soon as the leader's OS buffer has the data;
+                 * the timer syncs it to disk in the background, coalescing
+                 * every append accepted until it fires into a single flush
+                 */
+                if (!_relaxed_flush_timer.armed()) {
+                    _relaxed_flush_timer.arm(_relaxed_flush_delay);
+                }
                 // only update visibility upper bound if all quorum replicated
                 // entries are committed already
                 if (_commit_index >= _last_quorum_replicated_index) {
@@ -498,6 +562,18 @@ model::offset consensus::last_stable_offset() const {
     return _majority_replicated_index;
 }
 
+int64_t consensus::max_follower_lag() const {
+    if (!is_leader() || _fstats.size() == 0) {
+        return 0;
+    }
+    auto dirty = _log.offsets().dirty_offset;
+    int64_t max_lag = 0;
+    for (const auto& [node, idx] : _fstats) {
+        max_lag = std::max<int64_t>(max_lag, dirty - idx.match_index);
+    }
+    return max_lag;
+}
+
 ss::future<model::record_batch_reader>
 consensus::do_make_reader(storage::log_reader_config config) {
     // limit to last visible index
@@ -565,6 +641,20 @@ ss::future<bool> consensus::dispatch_prevote(bool leadership_transfer) {
       });
 }
 
+/*
+ * elections on a shard dispatch through a shared token bucket so that a
+ * full-cluster restart does not turn every armed vote timer into a
+ * simultaneous prevote/vote rpc storm. tokens are returned when a round
+ * finishes, so the bucket paces the herd without limiting steady state
+ * where elections are rare.
+ */
+static constexpr size_t max_concurrent_elections = 16;
+
+static ss::semaphore& election_pacing_sem() {
+    static thread_local ss::semaphore sem{max_concurrent_elections};
+    return sem;
+}
+
 /// performs no raft-state mutation other than resetting the timer
 void consensus::dispatch_vote(bool leadership_transfer) {
     // 5.2.1.4 - prepare next timeout
@@ -597,40 +687,59 @@ void consensus::dispatch_vote(bool leadership_transfer) {
     }
     // background, acquire lock, transition state
     (void)with_gate(_bg, [this, leadership_transfer] {
-        return dispatch_prevote(leadership_transfer)
-          .then([this, leadership_transfer](bool ready) mutable {
-              if (!ready) {
+        // internal groups carry the cluster metadata that unblocks
+        // everything else, and explicit leadership transfers are targeted;
+        // neither waits in the election queue
+        const bool paced = !leadership_transfer
+                           && ntp().ns != model::redpanda_ns;
+        auto throttle = paced ? ss::get_units(election_pacing_sem(), 1)
+                              : ss::make_ready_future<ss::semaphore_units<>>(
+                                ss::semaphore_units<>());
+        return std::move(throttle)
+          .then([this, leadership_transfer](ss::semaphore_units<> u) {
+              // state may have moved while queued, e.g. a leader emerged
+              if (should_skip_vote(leadership_transfer)) {
                   return ss::make_ready_future<>();
               }
-              auto vstm = std::make_unique<vote_stm>(this);
-              auto p = vstm.get();
-
-              // CRITICAL: vote performs locking on behalf of consensus
-              return p->vote(leadership_transfer)
-                .then_wrapped([this, p, vstm = std::move(vstm)](
-                                ss::future<> vote_f) mutable {
-                    try {
-                        vote_f.get();
-                    } catch (...) {
-                        vlog(
-                          _ctxlog.warn,
-                          "Error returned from voting process {}",
-                          std::current_exception());
-                    }
-                    auto f = p->wait().finally([vstm = std::move(vstm)] {});
-                    // make sure we wait for all futures when gate is closed
-                    if (_bg.is_closed()) {
-                        return f;
+              return dispatch_prevote(leadership_transfer)
+                .then([this, leadership_transfer](bool ready) mutable {
+                    if (!ready) {
+                        return ss::make_ready_future<>();
                     }
-                    // background
-                    (void)with_gate(
-                      _bg,
-                      [vstm = std::move(vstm), f = std::move(f)]() mutable {
-                          return std::move(f);
+                    auto vstm = std::make_unique<vote_stm>(this);
+                    auto p = vstm.get();
+
+                    // CRITICAL: vote performs locking on behalf of consensus
+                    return p->vote(leadership_transfer)
+                      .then_wrapped([this, p, vstm = std::move(vstm)](
+                                      ss::future<> vote_f) mutable {
+                          try {
+                              vote_f.get();
+                          } catch (...) {
+                              vlog(
+                                _ctxlog.warn,
+                                "Error returned from voting process {}",
+                                std::current_exception());
+                          }
+                          auto f = p->wait().finally(
+                            [vstm = std::move(vstm)] {});
+                          // make sure we wait for all futures when gate is
+                          // closed
+                          if (_bg.is_closed()) {
+                              return f;
+                          }
+                          // background
+                          (void)with_gate(
+                            _bg,
+                            [vstm = std::move(vstm),
+                             f = std::move(f)]() mutable {
+                                return std::move(f);
+                            });
+
+                          return ss::make_ready_future<>();
                       });
-
-                    return ss::make_ready_future<>();
-                });
+                })
+                .finally([u = std::move(u)] {});
           })
           .handle_exception([this](const std::exception_ptr& e) {
               vlog(_ctxlog.warn, "Exception thrown while voting - {}", e);
@@ -1060,9 +1169,13 @@ ss::future<vote_reply> consensus::do_vote(vote_request&& r) {
     // timeout duration When the vote was requested because of leadership
     // transfer grant the vote immediately.
     auto prev_election = clock_type::now() - _jit.base_duration();
-    if (
-      _hbeat > prev_election && !r.leadership_transfer
-      && r.node_id != _voted_for) {
+    // only a retry of the vote we already granted in this term may bypass
+    // the stickiness check. letting _voted_for through for higher terms
+    // would allow a split-vote loser to be elected while the current
+    // leader still holds a lease anchored on our fresh _hbeat, breaking
+    // the has_leader_lease safety argument.
+    const bool vote_retry = r.term == _term && r.node_id == _voted_for;
+    if (_hbeat > prev_election && !r.leadership_transfer && !vote_retry) {
         vlog(
           _ctxlog.trace,
           "Already heard from the leader, not granting vote to node {}",
@@ -1365,6 +1478,35 @@ ss::future<> consensus::hydrate_snapshot() {
       });
 }
 
+ss::future<std::optional<iobuf>> consensus::read_snapshot_data() {
+    using ret_t = std::optional<iobuf>;
+    return _snapshot_mgr.open_snapshot().then(
+      [](std::optional<storage::snapshot_reader> reader) {
+          if (!reader) {
+              return ss::make_ready_future<ret_t>(std::nullopt);
+          }
+          return ss::do_with(
+            std::move(*reader), [](storage::snapshot_reader& reader) {
+                return reader.read_metadata()
+                  .then([&reader](iobuf md_buf) {
+                      return reader.get_snapshot_size().then(
+                        [&reader,
+                         md_size = md_buf.size_bytes()](size_t file_size) {
+                            // the data follows the header and the metadata
+                            auto data_size
+                              = file_size
+                                - storage::snapshot_header::ondisk_size
+                                - md_size;
+                            return read_iobuf_exactly(
+                              reader.input(), data_size);
+                        });
+                  })
+                  .then([](iobuf data) { return ret_t(std::move(data)); })
+                  .finally([&reader] { return reader.close(); });
+            });
+      });
+}
+
 ss::future<> consensus::truncate_to_latest_snapshot() {
     auto lstats = _log.offsets();
     if (lstats.start_offset > _last_snapshot_index) {
@@ -1630,7 +1772,63 @@ append_entries_reply consensus::make_append_entries_reply(
 
 ss::future<> consensus::flush_log() {
     _probe.log_flushed();
-    return _log.flush().then([this] { _has_pending_flushes = false; });
+    /*
+     * group commit. every caller parks on the promise of the round that
+     * will cover its appends; callers arriving while a round's fdatasync
+     * is on disk may have appended after it was issued, so they share the
+     * next round instead of issuing their own. the driver loop resolves
+     * each round's waiters as soon as that round's sync returns - no
+     * caller ever depends on rounds started after its own.
+     */
+    if (!_next_flush) {
+        _next_flush.emplace();
+    }
+    auto flushed = _next_flush->get_shared_future();
+    if (!_flush_in_progress) {
+        _flush_in_progress = true;
+        // failures are propagated through the round promises
+        (void)do_flush_log_rounds().finally(
+          [this] { _flush_in_progress = false; });
+    }
+    return flushed;
+}
+
+ss::future<> consensus::do_flush_log_rounds() {
+    /*
+     * shared by all groups on the shard. at high partition density every
+     * group fsyncs its own segment, so the disk sees one stream per group;
+     * bounding the number of fdatasyncs in flight makes queued groups
+     * accumulate callers into _next_flush and each sync cover more appends
+     * instead of adding iops.
+     */
+    static thread_local ss::semaphore fsync_sem{max_concurrent_log_flushes};
+    return ss::repeat([this] {
+        // claim this round's waiters before the sync starts; anyone who
+        // arrives later parks on a fresh promise for the next round
+        auto waiters = std::exchange(_next_flush, std::nullopt);
+        return ss::with_semaphore(fsync_sem, 1, [this] { return _log.flush(); })
+          .then_wrapped([this, waiters = std::move(waiters)](
+                          ss::future<> f) mutable {
+              if (f.failed()) {
+                  auto ex = f.get_exception();
+                  if (waiters) {
+                      waiters->set_exception(ex);
+                  }
+                  // callers already parked for the next round would hang
+                  // if no further flush ever came; fail them too
+                  if (auto next = std::exchange(_next_flush, std::nullopt)) {
+                      next->set_exception(ex);
+                  }
+                  return ss::stop_iteration::yes;
+              }
+              _has_pending_flushes = false;
+              if (waiters) {
+                  waiters->set_value();
+              }
+              return _next_flush ? ss::stop_iteration::no
+                                 : ss::stop_iteration::yes;
+          });
+    });
 }
 
 ss::future<storage::append_result>
@@ -1706,6 +1904,10 @@ void consensus::update_node_hbeat_timestamp(vnode id) {
 
 follower_req_seq consensus::next_follower_sequence(vnode id) {
     if (auto it = _fstats.find(id); it != _fstats.end()) {
+        // requests are dispatched right after the sequence is drawn, so
+        // this timestamp conservatively predates the follower receiving
+        // the request; acknowledgements promote it into the leader lease
+        it->second.last_sent_request_timestamp = clock_type::now();
         return it->second.last_sent_seq++;
     }
 
@@ -36,6 +36,7 @@
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/util/bool_class.hh>
 
 #include <optional>
@@ -118,6 +119,18 @@ public:
 
     bool is_leader() const { return _vstate == vote_state::leader; }
     bool is_candidate() const { return _vstate == vote_state::candidate; }
+    /**
+     * \brief True while this leader holds a clock based lease over the
+     * quorum.
+     *
+     * A majority of voters acknowledged a request dispatched within the
+     * last election timeout, so none of them can have granted a vote to
+     * another candidate yet and no other leader can have committed
+     * anything. While the lease holds, reads served from local state are
+     * linearizable without any quorum communication. The lease is kept
+     * alive by the regular heartbeat traffic - checking it is free.
+     */
+    bool has_leader_lease() const;
     std::optional<model::node_id> get_leader_id() const {
         return _leader_id ? std::make_optional(_leader_id->id()) : std::nullopt;
     }
@@ -149,6 +162,15 @@ public:
      */
     ss::future<> write_snapshot(write_snapshot_cfg);
 
+    /**
+     * \brief Read the state machine data from the latest local snapshot
+     *
+     * Returns the data that was passed to write_snapshot, or std::nullopt
+     * when no snapshot was taken yet. Used by state machines to hydrate
+     * their state before replaying the log suffix.
+     */
+    ss::future<std::optional<iobuf>> read_snapshot_data();
+
     /// Increment and returns next append_entries order tracking sequence for
     /// follower with given node id
     follower_req_seq next_follower_sequence(vnode);
@@ -197,6 +219,13 @@ public:
     model::offset committed_offset() const { return _commit_index; }
     model::offset last_stable_offset() const;
 
+    /**
+     * Number of offsets the slowest follower is behind the leader's dirty
+     * offset. Returns 0 when this node is not the leader or the group has
+     * no followers.
+     */
+    int64_t max_follower_lag() const;
+
     /**
      * Last visible index is an offset that is safe to be fetched by the
      * consumers. This is similar to Kafka's HighWatermark. Last visible
@@ -363,6 +392,8 @@ private:
 
     /// \brief _does not_ hold the lock.
     ss::future<> flush_log();
+    /// \brief chain of group-commit fsync rounds, see flush_log()
+    ss::future<> do_flush_log_rounds();
     /// \brief called by the vote timer, to dispatch a write under
     /// the ops semaphore
     void dispatch_flush_with_lock();
@@ -474,13 +505,22 @@ private:
 
     replicate_batcher _batcher;
     bool _has_pending_flushes{false};
+    /// group commit state: while a flush round is on disk, later callers of
+    /// flush_log() park here and share the next round's fdatasync
+    bool _flush_in_progress{false};
+    std::optional<ss::shared_promise<>> _next_flush;
+    /// coalesces background syncs of relaxed consistency appends: armed by
+    /// the first unflushed append, every append until it fires shares one
+    /// flush round
+    timer_type _relaxed_flush_timer;
+    std::chrono::milliseconds _relaxed_flush_delay;
 
     /// used to wait for background ops before shutting down
     ss::gate _bg;
 
     /// all raft operations must happen exclusively since the common case
     /// is for the operation to touch the disk
-    mutex _op_lock;
+    mutex _op_lock{"raft::op_lock"};
     /// used for notifying when commits happened to log
     event_manager _event_manager;
     probe _probe;
@@ -163,7 +163,7 @@ model::record_batch_reader serialize_configuration(group_configuration cfg) {
 model::record_batch make_ghost_batch(
   model::offset start_offset, model::offset end_offset, model::term_id term) {
     auto delta = end_offset - start_offset;
-    auto now = model::timestamp::now();
+    auto now = model::timestamp::now_coarse();
     model::record_batch_header header = {
       .size_bytes = model::packed_record_batch_header_size,
       .base_offset = start_offset,
@@ -11,26 +11,64 @@
 
 #include "raft/consensus.h"
 
+#include <seastar/util/later.hh>
+
+#include <algorithm>
+
 namespace raft {
 
-ss::future<> event_manager::start() {
-    (void)ss::with_gate(_gate, [this] {
-        return ss::do_until(
-          [this] { return _gate.is_closed(); },
-          [this] {
-              // we won't miss an update because notify is synrhonous. if there
-              // is a new commit index getting ready to be set, it won't signal
-              // until after we've waited.
-              _commit_index.notify(_consensus->committed_offset());
-              return _cond.wait();
-          });
-    });
-    return ss::now();
+/**
+ * Shard wide coalescing of commit index notifications. Under a produce
+ * burst many groups advance their commit index within a single reactor
+ * poll, and waking a fiber per advance schedules thousands of tiny
+ * tasks. Advanced groups enqueue themselves here instead and a single
+ * deferred task fans out to all of them once per poll.
+ */
+class event_manager_queue {
+public:
+    void enqueue(event_manager* mgr) {
+        _pending.push_back(mgr);
+        if (!_scheduled) {
+            _scheduled = true;
+            (void)ss::later().then([this] { drain(); });
+        }
+    }
+
+    /// a stopping group may still be queued; null its entry so the fan
+    /// out never touches a dead manager
+    void remove(event_manager* mgr) {
+        std::replace(
+          _pending.begin(),
+          _pending.end(),
+          mgr,
+          static_cast<event_manager*>(nullptr));
+    }
+
+private:
+    void drain() {
+        _scheduled = false;
+        auto pending = std::exchange(_pending, {});
+        for (auto* mgr : pending) {
+            if (mgr) {
+                mgr->fan_out();
+            }
+        }
+    }
+
+    std::vector<event_manager*> _pending;
+    bool _scheduled{false};
+};
+
+static event_manager_queue& notification_queue() {
+    static thread_local event_manager_queue queue;
+    return queue;
 }
 
+ss::future<> event_manager::start() { return ss::now(); }
+
 ss::future<> event_manager::stop() {
     auto f = _gate.close();
-    _cond.signal();
+    notification_queue().remove(this);
     _commit_index.stop();
     return f;
 }
@@ -42,6 +80,22 @@ ss::future<> event_manager::wait(
     return _commit_index.wait(offset, timeout, as);
 }
 
-void event_manager::notify_commit_index(model::offset) { _cond.signal(); }
+void event_manager::notify_commit_index(model::offset) {
+    // we won't miss an update: the fan out reads the commit index when it
+    // runs, so every advance that lands before the deferred task fires is
+    // folded into the one queued notification
+    if (!_queued && !_gate.is_closed()) {
+        _queued = true;
+        notification_queue().enqueue(this);
+    }
+}
+
+void event_manager::fan_out() {
+    _queued = false;
+    if (_gate.is_closed()) {
+        return;
+    }
+    _commit_index.notify(_consensus->committed_offset());
+}
 
 } // namespace raft
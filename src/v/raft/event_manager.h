@@ -15,7 +15,6 @@
 #include "seastarx.h"
 
 #include <seastar/core/abort_source.hh>
-#include <seastar/core/condition-variable.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
 
@@ -24,6 +23,7 @@
 namespace raft {
 
 class consensus;
+class event_manager_queue;
 
 /**
  * Raft event notification manager.
@@ -35,6 +35,12 @@ class consensus;
  * avoid introducing additional latency into raft as the number of subscribers
  * inreases, this manager receives direct notifications from raft where they
  * are then delivered asynchronously.
+ *
+ * Delivery is coalesced per reactor poll: a group whose commit index
+ * advances queues itself on a shard wide notification queue and all
+ * queued groups are fanned out by one deferred task, so a produce burst
+ * advancing many groups (or one group many times) costs a single task
+ * instead of one per advance.
  */
 class event_manager {
 public:
@@ -54,10 +60,18 @@ public:
     void notify_commit_index(model::offset);
 
 private:
+    friend class event_manager_queue;
+
+    /// deliver the current commit index to waiters; called by the shard
+    /// notification queue once per reactor poll
+    void fan_out();
+
     consensus* _consensus;
     ss::gate _gate;
-    ss::condition_variable _cond;
     offset_monitor _commit_index;
+    // true while this group sits on the notification queue awaiting the
+    // next fan out
+    bool _queued{false};
 };
 
 } // namespace raft
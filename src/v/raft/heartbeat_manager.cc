@@ -20,6 +20,7 @@
 #include "raft/types.h"
 #include "rpc/reconnect_transport.h"
 #include "rpc/types.h"
+#include "utils/lazy_message.h"
 #include "vlog.h"
 
 #include <seastar/core/future-util.hh>
@@ -197,7 +198,7 @@ void heartbeat_manager::process_reply(
           "Could not send hearbeats to node:{}, reason:{}, message:{}",
           n,
           r,
-          r.error().message());
+          lazy::msg(r.error()));
         for (auto& [g, req_meta] : groups) {
             auto it = _consensus_groups.find(g);
             if (it == _consensus_groups.end()) {
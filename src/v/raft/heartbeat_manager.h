@@ -146,7 +146,7 @@ private:
 
     // private members
 
-    mutex _lock;
+    mutex _lock{"raft::heartbeat_manager"};
     clock_type::time_point _hbeat = clock_type::now();
     duration_type _heartbeat_interval;
     timer_type _heartbeat_timer;
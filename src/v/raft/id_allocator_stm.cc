@@ -16,6 +16,8 @@
 
 #include <seastar/core/future.hh>
 
+#include <algorithm>
+
 namespace raft {
 
 template<typename T>
@@ -39,16 +41,26 @@ id_allocator_stm::id_allocator_stm(
 ss::future<id_allocator_stm::stm_allocation_result>
 id_allocator_stm::allocate_id_and_wait(
   model::timeout_clock::time_point timeout) {
+    return allocate_range_and_wait(1, timeout)
+      .then([](stm_range_allocation_result r) {
+          return stm_allocation_result{r.base, r.raft_status};
+      });
+}
+
+ss::future<id_allocator_stm::stm_range_allocation_result>
+id_allocator_stm::allocate_range_and_wait(
+  int64_t count, model::timeout_clock::time_point timeout) {
     auto prelude = ss::now();
-    auto range = _config.id_allocator_batch_size.value();
+    auto range = std::max<int64_t>(
+      _config.id_allocator_batch_size.value(), count);
 
-    if (_last_allocated_range > 0) {
-        auto allocated_id = _last_allocated_base;
-        _last_allocated_range -= 1;
-        _last_allocated_base += 1;
+    if (_last_allocated_range >= count) {
+        auto base = _last_allocated_base;
+        _last_allocated_range -= count;
+        _last_allocated_base += count;
 
-        return ss::make_ready_future<stm_allocation_result>(
-          stm_allocation_result{allocated_id, raft::errc::success});
+        return ss::make_ready_future<stm_range_allocation_result>(
+          stm_range_allocation_result{base, count, raft::errc::success});
     }
 
     if (_processed > _config.id_allocator_log_capacity.value()) {
@@ -85,15 +97,20 @@ id_allocator_stm::allocate_id_and_wait(
         }
     }
 
-    return prelude.then([this, timeout, range] {
+    return prelude.then([this, timeout, range, count] {
         sequence_id seq = sequence_id{
           _run_id.value(), _c->self(), ++_last_seq_tick};
 
         return replicate_and_wait(allocation_cmd{seq, range}, timeout, seq)
-          .then([this](log_allocation_result r) {
-              _last_allocated_base = r.base + 1;
-              _last_allocated_range = r.range - 1;
-              return stm_allocation_result{r.base, r.raft_status};
+          .then([this, count](log_allocation_result r) {
+              if (r.raft_status != raft::errc::success) {
+                  return stm_range_allocation_result{0, 0, r.raft_status};
+              }
+              // any short remainder of the previous batch is discarded
+              _last_allocated_base = r.base + count;
+              _last_allocated_range = r.range - count;
+              return stm_range_allocation_result{
+                r.base, count, r.raft_status};
           });
     });
 }
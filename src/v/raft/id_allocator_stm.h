@@ -81,6 +81,13 @@ public:
         raft::errc raft_status{raft::errc::success};
     };
 
+    // a leased range of consecutive ids [base, base + range)
+    struct stm_range_allocation_result {
+        int64_t base;
+        int64_t range;
+        raft::errc raft_status{raft::errc::success};
+    };
+
     explicit id_allocator_stm(
       ss::logger&, raft::consensus*, config::configuration&);
 
@@ -89,6 +96,13 @@ public:
     ss::future<stm_allocation_result>
     allocate_id_and_wait(model::timeout_clock::time_point timeout);
 
+    // Leases `count` consecutive ids in one go. The ids are served from the
+    // in-memory batch when possible; when the batch has fewer than `count`
+    // ids left a new batch of at least `count` ids is replicated and the
+    // short remainder is discarded (ids are unique, not dense).
+    ss::future<stm_range_allocation_result> allocate_range_and_wait(
+      int64_t count, model::timeout_clock::time_point timeout);
+
 private:
     struct sequence_id {
         model::run_id run_id;
@@ -62,11 +62,49 @@ ss::future<kvrsm::cmd_result> kvrsm::cas_and_wait(
 
 ss::future<kvrsm::cmd_result>
 kvrsm::get_and_wait(ss::sstring key, model::timeout_clock::time_point timeout) {
+    // leader lease fast path: while the lease holds no other leader can
+    // commit, so applying everything committed so far and reading local
+    // state is linearizable without a replication round trip. the commit
+    // index is only trustworthy once this leader committed an entry in
+    // its own term (a fresh leader may not have learned the previous
+    // leader's full commit index yet), so until then reads still go
+    // through replication
+    if (
+      _c->has_leader_lease()
+      && _c->get_term(_c->committed_offset()) == _c->term()) {
+        return local_get(std::move(key), timeout);
+    }
     sequence_id seq = ++_last_generated_seq;
     return replicate_and_wait(
       serialize_cmd(get_cmd{seq, key}, kvrsm_batch_type), timeout, seq);
 }
 
+ss::future<kvrsm::cmd_result>
+kvrsm::local_get(ss::sstring key, model::timeout_clock::time_point timeout) {
+    auto started = std::chrono::steady_clock::now();
+    auto committed = _c->committed_offset();
+    return wait(committed, timeout)
+      .then([this, key = std::move(key), committed, started] {
+          auto elapsed_us
+            = std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - started);
+          kvrsm::cmd_result result = [&] {
+              if (auto it = kv_map.find(key); it != kv_map.end()) {
+                  return kvrsm::cmd_result(
+                    sequence_id(0), it->second.write_id, it->second.value);
+              }
+              return kvrsm::cmd_result(
+                sequence_id(0),
+                raft::kvelldb::errc::not_found,
+                raft::errc::success);
+          }();
+          result.offset = committed;
+          result.replicated_us = elapsed_us;
+          result.executed_us = elapsed_us;
+          return result;
+      });
+}
+
 ss::future<> kvrsm::apply(model::record_batch b) {
     if (b.header().type == kvrsm::kvrsm_batch_type) {
         auto last_offset = b.last_offset();
@@ -91,6 +91,11 @@ public:
     get_and_wait(ss::sstring key, model::timeout_clock::time_point timeout);
 
 private:
+    /// serve a read from local state under the leader lease, after
+    /// waiting for everything committed so far to be applied
+    ss::future<cmd_result>
+    local_get(ss::sstring key, model::timeout_clock::time_point timeout);
+
     struct record {
         ss::sstring value;
         ss::sstring write_id;
@@ -3,6 +3,7 @@
 #include "ssx/future-util.h"
 #include "utils/mutex.h"
 
+#include <seastar/core/chunked_fifo.hh>
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/do_with.hh>
 #include <seastar/core/future.hh>
@@ -36,9 +37,14 @@ public:
               }
               ss::promise<Response> p;
               auto f = p.get_future();
+              // the dispatch loop drains the whole queue in one exchange,
+              // only the empty->non-empty transition needs a wake up
+              const bool was_empty = _requests.empty();
               _requests.push_back(std::move(r));
               _responsens.push_back(std::move(p));
-              _enequeued.signal();
+              if (was_empty) {
+                  _enequeued.signal();
+              }
               return f;
           });
     }
@@ -63,8 +69,10 @@ public:
     }
 
 private:
-    using request_t = std::vector<Request>;
-    using response_t = std::vector<ss::promise<Response>>;
+    // chunked fifos keep enqueue allocation-free within a chunk and never
+    // relocate buffered entries the way a growing vector would
+    using request_t = ss::chunked_fifo<Request>;
+    using response_t = ss::chunked_fifo<ss::promise<Response>>;
     template<typename Func>
     ss::future<> flush(Func&& f);
     template<typename Func>
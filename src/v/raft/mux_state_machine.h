@@ -22,6 +22,8 @@
 #include "utils/expiring_promise.h"
 #include "vassert.h"
 
+#include <seastar/core/do_with.hh>
+#include <seastar/core/future-util.hh>
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/util/bool_class.hh>
@@ -31,7 +33,10 @@
 
 #include <optional>
 #include <system_error>
+#include <type_traits>
+#include <utility>
 #include <variant>
+#include <vector>
 
 namespace raft {
 
@@ -50,6 +55,21 @@ CONCEPT(
 using persistent_last_applied
   = ss::bool_class<struct persistent_last_applied_tag>;
 
+// detects states implementing the optional batched apply interface:
+//
+//   ss::future<std::vector<std::error_code>>
+//   apply_updates(std::vector<model::record_batch>);
+//
+// returning one error code per batch, in order
+template<typename State, typename = void>
+struct state_has_batch_apply : std::false_type {};
+
+template<typename State>
+struct state_has_batch_apply<
+  State,
+  std::void_t<decltype(std::declval<State&>().apply_updates(
+    std::declval<std::vector<model::record_batch>>()))>> : std::true_type {};
+
 // The multiplexing STM allows building multiple state machines on top of
 // single consensus instance. The mux_stm dispatches state
 // applications to correct state implementations using
@@ -66,6 +86,16 @@ using persistent_last_applied
 // when batch is applicable for one state is has to be not applicable for
 // another
 //
+// Batches are not applied one at a time. The mux_stm buffers all batches
+// handed to it within a single log poll and applies them in one pass when
+// the poll finishes: states implementing the optional `apply_updates`
+// interface receive each consecutive run of their batches as a single
+// span, and the replicate_and_wait promises together with the last
+// applied offset are flushed once per poll instead of once per batch.
+// During command storms (e.g. controller topic churn) this turns
+// thousands of mutex acquisitions and last-applied writes into one of
+// each per poll.
+//
 // +---------+               +---------+      +-------+ +---------+
 // | caller  |               | mux_stm |      | raft  | | state_1 |
 // +---------+               +---------+      +-------+ +---------+
@@ -118,9 +148,25 @@ private:
     using container_t
       = absl::flat_hash_map<model::offset, expiring_promise<std::error_code>>;
 
+    using state_variant_t = std::variant<T*...>;
+    // consecutive run of batches buffered for a single state within one
+    // log poll, applied as a span from on_batches_applied
+    struct pending_run {
+        state_variant_t state;
+        std::vector<model::offset> offsets;
+        std::vector<model::record_batch> batches;
+    };
+    // (last batch offset, apply result) pairs collected while applying a
+    // poll worth of buffered batches
+    using applied_t = std::vector<std::pair<model::offset, std::error_code>>;
+
     ss::future<> apply(model::record_batch b) final;
+    ss::future<> on_batches_applied() final;
+    ss::future<> apply_run(pending_run&, applied_t&);
+    ss::future<> complete_applies(applied_t&);
 
     container_t _promises;
+    std::vector<pending_run> _pending;
 
     /*
      * Here the _mutex is used to make sure that promise was inserted into
@@ -256,25 +302,89 @@ ss::future<> mux_state_machine<T...>::apply(model::record_batch b) {
         return ss::now();
     }
 
-    auto last_offset = b.last_offset();
-    // apply update
-    auto result_f = std::visit(
-      [b = std::move(b)](auto& state) mutable {
-          return state->apply_update(std::move(b));
+    // buffer the batch, the whole poll worth of batches is applied in
+    // on_batches_applied with a single promise and last applied flush
+    if (_pending.empty() || _pending.back().state != *state) {
+        _pending.push_back(pending_run{.state = *state});
+    }
+    _pending.back().offsets.push_back(b.last_offset());
+    _pending.back().batches.push_back(std::move(b));
+    return ss::now();
+}
+
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+ss::future<> mux_state_machine<T...>::on_batches_applied() {
+    if (_pending.empty()) {
+        return ss::now();
+    }
+    return ss::do_with(
+      std::exchange(_pending, {}),
+      applied_t{},
+      [this](std::vector<pending_run>& runs, applied_t& applied) {
+          return ss::do_for_each(
+                   runs,
+                   [this, &applied](pending_run& run) {
+                       return apply_run(run, applied);
+                   })
+            .then([this, &applied] { return complete_applies(applied); });
+      });
+}
+
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+ss::future<> mux_state_machine<T...>::apply_run(
+  pending_run& run, applied_t& applied) {
+    return std::visit(
+      [&run, &applied](auto* state) {
+          using state_t = std::remove_pointer_t<decltype(state)>;
+          if constexpr (state_has_batch_apply<state_t>::value) {
+              // hand the whole run to the state in one call
+              return state->apply_updates(std::move(run.batches))
+                .then([&run, &applied](std::vector<std::error_code> results) {
+                    vassert(
+                      results.size() == run.offsets.size(),
+                      "State returned {} results for {} applied batches",
+                      results.size(),
+                      run.offsets.size());
+                    for (size_t i = 0; i < results.size(); ++i) {
+                        applied.emplace_back(run.offsets[i], results[i]);
+                    }
+                });
+          } else {
+              return ss::do_with(
+                size_t{0}, [state, &run, &applied](size_t& i) {
+                    return ss::do_until(
+                      [&run, &i] { return i == run.batches.size(); },
+                      [state, &run, &applied, &i] {
+                          return state->apply_update(std::move(run.batches[i]))
+                            .then([&run, &applied, &i](std::error_code ec) {
+                                applied.emplace_back(run.offsets[i], ec);
+                                ++i;
+                            });
+                      });
+                });
+          }
       },
-      *state);
+      run.state);
+}
 
-    return result_f.then([this, last_offset](std::error_code ec) {
-        auto f = _mutex.with([this, last_offset, ec] {
-            if (auto it = _promises.find(last_offset); it != _promises.end()) {
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+ss::future<>
+mux_state_machine<T...>::complete_applies(applied_t& applied) {
+    auto f = _mutex.with([this, &applied] {
+        for (auto& [offset, ec] : applied) {
+            if (auto it = _promises.find(offset); it != _promises.end()) {
                 it->second.set_value(ec);
             }
-        });
-        if (!_persist_last_applied) {
-            return f;
         }
-        return f.then(
-          [this, last_offset] { return write_last_applied(last_offset); });
+    });
+    if (!_persist_last_applied || applied.empty()) {
+        return f;
+    }
+    return f.then([this, last = applied.back().first] {
+        return write_last_applied(last);
     });
 }
 
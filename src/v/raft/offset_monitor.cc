@@ -16,8 +16,10 @@
 namespace raft {
 
 void offset_monitor::stop() {
-    for (auto& waiter : _waiters) {
-        waiter.second->done.set_exception(wait_aborted());
+    for (auto& bucket : _waiters) {
+        for (auto& waiter : bucket.second) {
+            waiter->done.set_exception(wait_aborted());
+        }
     }
     _waiters.clear();
 }
@@ -30,12 +32,12 @@ ss::future<> offset_monitor::wait(
     if (offset <= _last_applied) {
         return ss::now();
     }
-    auto w = std::make_unique<waiter>(this, timeout, as);
+    auto w = std::make_unique<waiter>(this, offset, timeout, as);
     auto f = w->done.get_future();
     if (!f.available()) {
         // the future may already be available, for example if an abort had
         // already be requested. in that case, skip adding as a waiter.
-        _waiters.emplace(offset, std::move(w));
+        _waiters[offset].push_back(std::move(w));
     }
     return f;
 }
@@ -48,18 +50,23 @@ void offset_monitor::notify(model::offset offset) {
         if (it == _waiters.end() || offset < it->first) {
             return;
         }
-        it->second->done.set_value();
-        // when the waiter is destroyed here by erase, then if they are active,
-        // the timer is cancelled and the abort source subscription is removed.
+        // complete the whole bucket with a single tree erase. when the
+        // waiters are destroyed here, then if they are active, the timer is
+        // cancelled and the abort source subscription is removed.
+        for (auto& w : it->second) {
+            w->done.set_value();
+        }
         _waiters.erase(it);
     }
 }
 
 offset_monitor::waiter::waiter(
   offset_monitor* mon,
+  model::offset offset,
   model::timeout_clock::time_point timeout,
   std::optional<std::reference_wrapper<ss::abort_source>> as)
-  : mon(mon) {
+  : mon(mon)
+  , offset(offset) {
     if (as) {
         auto opt_sub = as->get().subscribe(
           [this]() noexcept { handle_abort(); });
@@ -78,16 +85,21 @@ offset_monitor::waiter::waiter(
 
 void offset_monitor::waiter::handle_abort() {
     done.set_exception(wait_aborted());
+    // only the bucket of this waiter has to be searched, not all waiters
+    auto b_it = mon->_waiters.find(offset);
+    vassert(b_it != mon->_waiters.end(), "waiter bucket not found");
+    auto& bucket = b_it->second;
     auto it = std::find_if(
-      mon->_waiters.begin(),
-      mon->_waiters.end(),
-      [this](const waiters_type::value_type& w) {
-          return w.second.get() == this;
+      bucket.begin(), bucket.end(), [this](const std::unique_ptr<waiter>& w) {
+          return w.get() == this;
       });
-    vassert(it != mon->_waiters.end(), "waiter not found");
+    vassert(it != bucket.end(), "waiter not found");
     // when the waiter is destroyed here by erase, then if they are active,
     // the timer is cancelled and the abort source subscription is removed.
-    mon->_waiters.erase(it); // *this is no longer valid after erase
+    bucket.erase(it); // *this is no longer valid after erase
+    if (bucket.empty()) {
+        mon->_waiters.erase(b_it);
+    }
 }
 
 } // namespace raft
@@ -20,6 +20,8 @@
 
 #include <absl/container/btree_map.h>
 
+#include <vector>
+
 namespace raft {
 
 /**
@@ -69,12 +71,14 @@ public:
 private:
     struct waiter {
         offset_monitor* mon;
+        model::offset offset;
         ss::promise<> done;
         ss::timer<model::timeout_clock> timer;
         ss::abort_source::subscription sub;
 
         waiter(
           offset_monitor*,
+          model::offset,
           model::timeout_clock::time_point,
           std::optional<std::reference_wrapper<ss::abort_source>>);
 
@@ -83,8 +87,12 @@ private:
 
     friend waiter;
 
-    using waiters_type
-      = absl::btree_multimap<model::offset, std::unique_ptr<waiter>>;
+    // waiters are bucketed per offset. notify pops whole buckets from the
+    // front of the map, one tree operation per distinct offset instead of
+    // one per waiter, and aborts only scan the bucket of the aborting
+    // waiter instead of all waiters
+    using bucket_type = std::vector<std::unique_ptr<waiter>>;
+    using waiters_type = absl::btree_map<model::offset, bucket_type>;
 
     waiters_type _waiters;
     model::offset _last_applied;
@@ -16,6 +16,7 @@
 #include "raft/logger.h"
 #include "raft/raftgen_service.h"
 #include "raft/types.h"
+#include "utils/lazy_message.h"
 
 #include <seastar/util/bool_class.hh>
 
@@ -85,7 +86,7 @@ prevote_stm::process_reply(vnode n, ss::future<result<vote_reply>> f) {
                   _ctxlog.trace,
                   "prevote ack from {} doesn't have value, error: {}",
                   n,
-                  r.error().message());
+                  lazy::msg(r.error()));
                 voter_reply->second._is_failed = true;
                 voter_reply->second._is_pending = false;
             }
@@ -103,6 +103,11 @@ void probe::setup_metrics(const model::ntp& ntp) {
          "recovery_requests_errors",
          [this] { return _recovery_request_error; },
          sm::description("Number of failed recovery requests"),
+         labels),
+       sm::make_gauge(
+         "replicate_batch_window_bytes",
+         [this] { return _replicate_batch_window; },
+         sm::description("Current adaptive replicate batcher flush window"),
          labels)});
 }
 
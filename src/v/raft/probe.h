@@ -32,6 +32,9 @@ public:
     void log_flushed() { ++_log_flushes; }
 
     void replicate_batch_flushed() { ++_replicate_batch_flushed; }
+    void replicate_batch_window(size_t window) {
+        _replicate_batch_window = window;
+    }
     void recovery_append_request() { ++_recovery_requests; }
     void configuration_update() { ++_configuration_updates; }
 
@@ -56,6 +59,7 @@ private:
     uint64_t _replicate_requests_done = 0;
     uint64_t _log_flushes = 0;
     uint64_t _replicate_batch_flushed = 0;
+    size_t _replicate_batch_window = 0;
     uint32_t _log_truncations = 0;
     uint32_t _configuration_updates = 0;
     uint64_t _recovery_requests = 0;
@@ -16,8 +16,11 @@
 #include "raft/errc.h"
 #include "raft/logger.h"
 #include "raft/raftgen_service.h"
+#include "resource_mgmt/throttle.h"
+#include "utils/lazy_message.h"
 
 #include <seastar/core/future-util.hh>
+#include <seastar/core/when_all.hh>
 
 #include <chrono>
 
@@ -98,7 +101,7 @@ ss::future<> recovery_stm::do_recover() {
     // read & replicate log entries
     return f
       .then([this, follower_next_offset] {
-          return read_range_for_recovery(
+          return recover_range(
             follower_next_offset, _ptr->_log.offsets().dirty_offset);
       })
       .then([this] {
@@ -128,11 +131,39 @@ bool recovery_stm::state_changed() {
            > meta.value()->last_dirty_log_index;
 }
 
-ss::future<> recovery_stm::read_range_for_recovery(
-  model::offset start_offset, model::offset end_offset) {
+ss::future<>
+recovery_stm::recover_range(model::offset start_offset, model::offset end) {
+    _next_read_offset = start_offset;
+    _inflight.clear();
+
+    vlog(
+      _ctxlog.trace,
+      "Reading batches in range [{},{}] for node {} recovery",
+      start_offset,
+      end,
+      _node_id);
+
+    /*
+     * pipelined recovery: keep dispatching read windows while earlier
+     * append_entries requests are still in flight, bounded by the byte
+     * budget. the read cursor advances optimistically as windows are sent;
+     * a failed or reordered reply requests a stop and the outer recovery
+     * loop restarts from the follower's acknowledged next_index.
+     */
+    return ss::do_until(
+             [this, end] { return _stop_requested || _next_read_offset > end; },
+             [this, end] { return read_next_window(end); })
+      .then([this] {
+          return ss::when_all_succeed(_inflight.begin(), _inflight.end());
+      })
+      .finally([this] { _inflight.clear(); });
+}
+
+ss::future<> recovery_stm::read_next_window(model::offset end) {
+    const auto start_offset = _next_read_offset;
     storage::log_reader_config cfg(
       start_offset,
-      end_offset,
+      end,
       1,
       // 32KB is a modest estimate. It has good batching and it also prevents an
       // OOM situation where we have a lot of raft groups recovering at the same
@@ -144,13 +175,6 @@ ss::future<> recovery_stm::read_range_for_recovery(
       std::nullopt,
       _ptr->_as);
 
-    vlog(
-      _ctxlog.trace,
-      "Reading batches in range [{},{}] for node {} recovery",
-      start_offset,
-      end_offset,
-      _node_id);
-
     // TODO: add timeout of maybe 1minute?
     return _ptr->_log.make_reader(cfg)
       .then([](model::record_batch_reader reader) {
@@ -169,10 +193,14 @@ ss::future<> recovery_stm::read_range_for_recovery(
                 _stop_requested = true;
                 return ss::make_ready_future<>();
             }
+            size_t window_bytes = 0;
+            for (const auto& b : batches) {
+                window_bytes += b.size_bytes();
+            }
             auto gap_filled_batches = details::make_ghost_batches_in_gaps(
               start_offset, std::move(batches));
-            _base_batch_offset = gap_filled_batches.begin()->base_offset();
-            _last_batch_offset = gap_filled_batches.back().last_offset();
+            const auto base = gap_filled_batches.begin()->base_offset();
+            const auto last = gap_filled_batches.back().last_offset();
 
             auto f_reader = model::make_foreign_memory_record_batch_reader(
               std::move(gap_filled_batches));
@@ -183,10 +211,40 @@ ss::future<> recovery_stm::read_range_for_recovery(
              * be fully caught up.
              */
             auto should_flush = append_entries_request::flush_after_append(
-              _last_batch_offset == lstats.dirty_offset
+              last == lstats.dirty_offset
               && (_ptr->last_visible_index() <= _ptr->committed_offset()));
 
-            return replicate(std::move(f_reader), should_flush);
+            _next_read_offset = details::next_offset(last);
+
+            // pace recovery against the shared background throttle so a
+            // node catching up cannot starve foreground traffic of disk
+            // and network bandwidth
+            return background_throttle::shard_local()
+              .recovery()
+              .acquire(window_bytes)
+              .then([this,
+                     base,
+                     last,
+                     should_flush,
+                     window_bytes,
+                     f_reader = std::move(f_reader)]() mutable {
+                  // a window larger than the whole budget degenerates to
+                  // one request in flight rather than deadlocking
+                  return ss::get_units(
+                           _pipeline_sem,
+                           std::min(window_bytes, pipeline_byte_budget))
+                    .then([this,
+                           base,
+                           last,
+                           should_flush,
+                           f_reader = std::move(f_reader)](
+                            ss::semaphore_units<> u) mutable {
+                        _inflight.push_back(
+                          replicate(
+                            base, last, std::move(f_reader), should_flush)
+                            .finally([u = std::move(u)] {}));
+                    });
+              });
         });
 }
 
@@ -203,11 +261,27 @@ ss::future<> recovery_stm::open_snapshot_reader() {
       });
 }
 
+ss::future<iobuf> recovery_stm::read_snapshot_chunk() {
+    if (_next_chunk) {
+        auto f = std::move(*_next_chunk);
+        _next_chunk.reset();
+        return f;
+    }
+    return read_iobuf_exactly(_snapshot_reader->input(), snapshot_chunk_size);
+}
+
 ss::future<> recovery_stm::send_install_snapshot_request() {
-    // send 32KB at a time
-    return read_iobuf_exactly(_snapshot_reader->input(), 32_KiB)
+    return read_snapshot_chunk()
       .then([this](iobuf chunk) mutable {
           auto chunk_size = chunk.size_bytes();
+          const bool done = (_sent_snapshot_bytes + chunk_size)
+                            == _snapshot_size;
+          if (!done) {
+              // overlap the next chunk's disk read with this chunk's round
+              // trip; the stream position already points at it
+              _next_chunk = read_iobuf_exactly(
+                _snapshot_reader->input(), snapshot_chunk_size);
+          }
           install_snapshot_request req{
             .target_node_id = _node_id,
             .term = _ptr->term(),
@@ -216,7 +290,7 @@ ss::future<> recovery_stm::send_install_snapshot_request() {
             .last_included_index = _ptr->_last_snapshot_index,
             .file_offset = _sent_snapshot_bytes,
             .chunk = std::move(chunk),
-            .done = (_sent_snapshot_bytes + chunk_size) == _snapshot_size};
+            .done = done};
 
           vlog(
             _ctxlog.trace,
@@ -237,7 +311,18 @@ ss::future<> recovery_stm::send_install_snapshot_request() {
 }
 
 ss::future<> recovery_stm::close_snapshot_reader() {
-    return _snapshot_reader->close().then([this] {
+    // drain the prefetched chunk before closing the underlying stream
+    auto f = ss::now();
+    if (_next_chunk) {
+        f = std::move(*_next_chunk).then_wrapped([](ss::future<iobuf> chunk) {
+            try {
+                chunk.get0();
+            } catch (...) {
+            }
+        });
+        _next_chunk.reset();
+    }
+    return f.then([this] { return _snapshot_reader->close(); }).then([this] {
         _snapshot_reader.reset();
         _snapshot_size = 0;
         _sent_snapshot_bytes = 0;
@@ -291,12 +376,14 @@ ss::future<> recovery_stm::install_snapshot() {
 }
 
 ss::future<> recovery_stm::replicate(
+  model::offset base_batch_offset,
+  model::offset last_batch_offset,
   model::record_batch_reader&& reader,
   append_entries_request::flush_after_append flush) {
     // collect metadata for append entries request
     // last persisted offset is last_offset of batch before the first one in the
     // reader
-    auto prev_log_idx = details::prev_offset(_base_batch_offset);
+    auto prev_log_idx = details::prev_offset(base_batch_offset);
     model::term_id prev_log_term;
     auto lstats = _ptr->_log.offsets();
 
@@ -313,9 +400,9 @@ ss::future<> recovery_stm::replicate(
     }
 
     // calculate commit index for follower to update immediately
-    auto commit_idx = std::min(_last_batch_offset, _committed_offset);
+    auto commit_idx = std::min(last_batch_offset, _committed_offset);
     auto last_visible_idx = std::min(
-      _last_batch_offset, _ptr->last_visible_index());
+      last_batch_offset, _ptr->last_visible_index());
     // build request
     append_entries_request r(
       _ptr->self(),
@@ -336,13 +423,16 @@ ss::future<> recovery_stm::replicate(
     _ptr->suppress_heartbeats(_node_id, seq, true);
     return dispatch_append_entries(std::move(r))
       .finally([this, seq] { _ptr->suppress_heartbeats(_node_id, seq, false); })
-      .then([this, seq, dirty_offset = lstats.dirty_offset](auto r) {
+      .then([this,
+             seq,
+             base_batch_offset,
+             dirty_offset = lstats.dirty_offset](auto r) {
           if (!r) {
               vlog(
                 _ctxlog.error,
                 "recovery_stm: not replicate entry: {} - {}",
                 r,
-                r.error().message());
+                lazy::msg(r.error()));
               _stop_requested = true;
               _ptr->get_probe().recovery_request_error();
           }
@@ -374,7 +464,7 @@ ss::future<> recovery_stm::replicate(
                   return;
               }
               meta.value()->next_index = std::max(
-                model::offset(0), details::prev_offset(_base_batch_offset));
+                model::offset(0), details::prev_offset(base_batch_offset));
               vlog(
                 _ctxlog.trace,
                 "Move node {} next index {} backward",
@@ -14,19 +14,35 @@
 #include "model/metadata.h"
 #include "raft/consensus.h"
 #include "raft/types.h"
+#include "units.h"
 
 namespace raft {
 
 class recovery_stm {
 public:
+    // bounds the bytes kept in flight towards a recovering follower. with
+    // 32KiB read windows this lets a handful of append_entries requests
+    // overlap the network round trip so recovery saturates the slower of
+    // disk and network instead of paying a full RTT per window
+    static constexpr size_t pipeline_byte_budget = 256_KiB;
+
+    // snapshots are streamed in large chunks, and while one chunk is on the
+    // wire the next is already being read from disk, so snapshot delivery
+    // is bounded by the slower of disk and network rather than the RTT
+    static constexpr size_t snapshot_chunk_size = 1_MiB;
+
     recovery_stm(consensus*, vnode, ss::io_priority_class);
     ss::future<> apply();
 
 private:
     ss::future<> do_recover();
-    ss::future<> read_range_for_recovery(model::offset, model::offset);
+    ss::future<> recover_range(model::offset, model::offset);
+    ss::future<> read_next_window(model::offset);
     ss::future<> replicate(
-      model::record_batch_reader&&, append_entries_request::flush_after_append);
+      model::offset,
+      model::offset,
+      model::record_batch_reader&&,
+      append_entries_request::flush_after_append);
     ss::future<result<append_entries_reply>>
     dispatch_append_entries(append_entries_request&&);
     std::optional<follower_index_metadata*> get_follower_meta();
@@ -34,6 +50,7 @@ private:
 
     ss::future<> install_snapshot();
     ss::future<> send_install_snapshot_request();
+    ss::future<iobuf> read_snapshot_chunk();
     ss::future<> handle_install_snapshot_reply(result<install_snapshot_reply>);
     ss::future<> open_snapshot_reader();
     ss::future<> close_snapshot_reader();
@@ -42,16 +59,22 @@ private:
 
     consensus* _ptr;
     vnode _node_id;
-    model::offset _base_batch_offset;
-    model::offset _last_batch_offset;
     model::offset _committed_offset;
     model::term_id _term;
+    // pipelined recovery state: read cursor advanced optimistically as
+    // windows are dispatched, requests awaiting replies, and the byte
+    // budget that bounds them
+    model::offset _next_read_offset;
+    std::vector<ss::future<>> _inflight;
+    ss::semaphore _pipeline_sem{pipeline_byte_budget};
     ss::io_priority_class _prio;
     ctx_log _ctxlog;
     // tracking follower snapshot delivery
     std::unique_ptr<storage::snapshot_reader> _snapshot_reader;
     size_t _sent_snapshot_bytes = 0;
     size_t _snapshot_size = 0;
+    // chunk prefetched while the previous one is in flight
+    std::optional<ss::future<iobuf>> _next_chunk;
     // needed to early exit. (node down)
     bool _stop_requested = false;
 };
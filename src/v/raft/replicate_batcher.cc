@@ -30,7 +30,9 @@ namespace raft {
 using namespace std::chrono_literals; // NOLINT
 replicate_batcher::replicate_batcher(consensus* ptr, size_t cache_size)
   : _ptr(ptr)
-  , _max_batch_size_sem(cache_size) {}
+  , _max_batch_size_sem(cache_size)
+  , _max_flush_window(std::max(cache_size, min_flush_window))
+  , _flush_window(std::max(cache_size / 4, min_flush_window)) {}
 
 ss::future<result<replicate_result>> replicate_batcher::replicate(
   std::optional<model::term_id> expected_term, model::record_batch_reader&& r) {
@@ -78,7 +80,7 @@ replicate_batcher::do_cache_with_backpressure(
   ss::circular_buffer<model::record_batch> batches,
   size_t bytes) {
     return ss::get_units(_max_batch_size_sem, bytes)
-      .then([this, expected_term, batches = std::move(batches)](
+      .then([this, expected_term, bytes, batches = std::move(batches)](
 
               ss::semaphore_units<> u) mutable {
           size_t record_count = 0;
@@ -93,13 +95,23 @@ replicate_batcher::do_cache_with_backpressure(
           }
           i->expected_term = expected_term;
           i->record_count = record_count;
+          i->bytes = bytes;
           i->units = std::move(u);
+          i->trace = tracing::stage_tracer::shard_local().maybe_sample(
+            "raft_replicate");
+          i->trace.stage("cached");
           _item_cache.emplace_back(i);
           return i;
       });
 }
 
 ss::future<> replicate_batcher::flush() {
+    if (_inflight_bytes >= _flush_window) {
+        // the pipe to the followers is full. leave the items cached so the
+        // completion of an in-flight round flushes them as one larger
+        // request instead of adding another round trip
+        return ss::now();
+    }
     auto item_cache = std::exchange(_item_cache, {});
     if (item_cache.empty()) {
         return ss::now();
@@ -135,6 +147,7 @@ ss::future<> replicate_batcher::flush() {
                             b.set_term(term);
                             data.push_back(std::move(b));
                         }
+                        n->trace.stage("flush_start");
                         notifications.push_back(std::move(n));
                     } else {
                         n->_promise.set_value(errc::not_leader);
@@ -167,6 +180,7 @@ static void propagate_result(
         auto last_offset = r.value().last_offset;
         for (auto it = notifications.rbegin(); it != notifications.rend();
              ++it) {
+            (*it)->trace.stage("replicated");
             (*it)->_promise.set_value(replicate_result{last_offset});
             last_offset = last_offset - model::offset((*it)->record_count);
         }
@@ -193,17 +207,36 @@ ss::future<> replicate_batcher::do_flush(
   ss::semaphore_units<> u,
   absl::flat_hash_map<vnode, follower_req_seq> seqs) {
     _ptr->_probe.replicate_batch_flushed();
+    const size_t round_bytes = std::accumulate(
+      notifications.cbegin(),
+      notifications.cend(),
+      size_t{0},
+      [](size_t sum, const item_ptr& i) { return sum + i->bytes; });
+    _inflight_bytes += round_bytes;
+    const auto round_start = clock_type::now();
     auto stm = ss::make_lw_shared<replicate_entries_stm>(
       _ptr, std::move(req), std::move(seqs));
     return stm->apply(std::move(u))
-      .then_wrapped([this, stm, notifications = std::move(notifications)](
+      .then_wrapped([this,
+                     stm,
+                     round_bytes,
+                     round_start,
+                     notifications = std::move(notifications)](
                       ss::future<result<replicate_result>> fut) mutable {
+          _inflight_bytes -= round_bytes;
+          update_flush_window(clock_type::now() - round_start);
           try {
               auto ret = fut.get0();
               propagate_result(ret, notifications);
           } catch (...) {
               propagate_current_exception(notifications);
           }
+          // flush items that accumulated while this round was in flight
+          if (!_ptr->_bg.is_closed() && !_item_cache.empty()) {
+              (void)ss::with_gate(_ptr->_bg, [this] {
+                  return _lock.with([this] { return flush(); });
+              });
+          }
           auto f = stm->wait().finally([stm] {});
           // if gate is closed wait for all futures
           if (_ptr->_bg.is_closed()) {
@@ -222,4 +255,27 @@ ss::future<> replicate_batcher::do_flush(
           return ss::make_ready_future<>();
       });
 }
+
+void replicate_batcher::update_flush_window(clock_type::duration rtt) {
+    /*
+     * additive increase / multiplicative decrease on the observed
+     * append_entries round time. a round completing close to the best
+     * recently observed RTT means the pipe has headroom, so admit more
+     * bytes per round; an inflated round means requests are queueing
+     * somewhere, so back off and let the cache coalesce instead.
+     */
+    if (++_rounds_since_rtt_reset >= rtt_history_rounds) {
+        _rounds_since_rtt_reset = 0;
+        _min_rtt = rtt;
+    } else {
+        _min_rtt = std::min(_min_rtt, rtt);
+    }
+    if (rtt <= _min_rtt + _min_rtt / 4) {
+        _flush_window = std::min(
+          _flush_window + min_flush_window, _max_flush_window);
+    } else {
+        _flush_window = std::max(_flush_window / 2, min_flush_window);
+    }
+    _ptr->_probe.replicate_batch_window(_flush_window);
+}
 } // namespace raft
@@ -16,6 +16,7 @@
 #include "raft/types.h"
 #include "units.h"
 #include "utils/mutex.h"
+#include "utils/stage_tracer.h"
 
 #include <seastar/core/semaphore.hh>
 
@@ -25,10 +26,18 @@ class consensus;
 
 class replicate_batcher {
 public:
+    // smallest and largest flush window the controller may converge to; the
+    // upper bound is the configured cache size passed at construction
+    static constexpr size_t min_flush_window = 32_KiB;
+    // rounds after which the best observed RTT is forgotten, so the
+    // baseline tracks changing link conditions
+    static constexpr size_t rtt_history_rounds = 64;
+
     struct item {
         ss::promise<result<replicate_result>> _promise;
         replicate_result ret;
         size_t record_count;
+        size_t bytes{0};
         std::vector<model::record_batch> data;
         std::optional<model::term_id> expected_term;
         /**
@@ -36,6 +45,11 @@ public:
          * processing the request.
          */
         ss::semaphore_units<> units;
+        /**
+         * Sampled latency trace for this request; inactive for the vast
+         * majority of items. Committed when the item is destroyed.
+         */
+        tracing::stage_tracer::token trace;
     };
     using item_ptr = ss::lw_shared_ptr<item>;
     explicit replicate_batcher(consensus* ptr, size_t cache_size);
@@ -66,12 +80,24 @@ private:
       std::optional<model::term_id>,
       ss::circular_buffer<model::record_batch>,
       size_t);
+    void update_flush_window(clock_type::duration);
 
     consensus* _ptr;
     ss::semaphore _max_batch_size_sem;
 
     std::vector<item_ptr> _item_cache;
-    mutex _lock;
+    mutex _lock{"raft::replicate_batcher"};
+    /*
+     * adaptive flush window. while at least _flush_window bytes are in
+     * flight to the followers, further items stay in the cache and ride
+     * the next round as a single request. the window is adjusted AIMD
+     * style from observed append_entries round trip times.
+     */
+    size_t _max_flush_window;
+    size_t _flush_window;
+    size_t _inflight_bytes{0};
+    clock_type::duration _min_rtt = clock_type::duration::max();
+    size_t _rounds_since_rtt_reset{0};
 };
 
 } // namespace raft
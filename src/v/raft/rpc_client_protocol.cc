@@ -9,6 +9,7 @@
 
 #include "raft/rpc_client_protocol.h"
 
+#include "config/configuration.h"
 #include "outcome_future_utils.h"
 #include "raft/raftgen_service.h"
 #include "rpc/connection_cache.h"
@@ -18,12 +19,26 @@
 
 namespace raft {
 
+/**
+ * Append entries batches and snapshot chunks dominate inter-node traffic
+ * and compress well, votes and heartbeats are small and latency critical
+ * so they are always sent uncompressed. The wire header carries the codec
+ * per message and every receiver handles zstd, so no handshake is needed.
+ */
+static void maybe_compress(rpc::client_opts& opts) {
+    if (config::shard_local_cfg().raft_transport_compression()) {
+        opts.compression = rpc::compression_type::zstd;
+    }
+}
+
 ss::future<result<vote_reply>> rpc_client_protocol::vote(
   model::node_id n, vote_request&& r, rpc::client_opts opts) {
+    const auto lane_hint = size_t(r.group());
     return _connection_cache.local().with_node_client<raftgen_client_protocol>(
       _self,
       ss::this_shard_id(),
       n,
+      lane_hint,
       [r = std::move(r),
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.vote(std::move(r), std::move(opts))
@@ -33,10 +48,13 @@ ss::future<result<vote_reply>> rpc_client_protocol::vote(
 
 ss::future<result<append_entries_reply>> rpc_client_protocol::append_entries(
   model::node_id n, append_entries_request&& r, rpc::client_opts opts) {
+    maybe_compress(opts);
+    const auto lane_hint = size_t(r.meta.group());
     return _connection_cache.local().with_node_client<raftgen_client_protocol>(
       _self,
       ss::this_shard_id(),
       n,
+      lane_hint,
       [r = std::move(r),
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.append_entries(std::move(r), std::move(opts))
@@ -46,6 +64,8 @@ ss::future<result<append_entries_reply>> rpc_client_protocol::append_entries(
 
 ss::future<result<heartbeat_reply>> rpc_client_protocol::heartbeat(
   model::node_id n, heartbeat_request&& r, rpc::client_opts opts) {
+    // heartbeats for all groups led on this shard are consolidated into a
+    // single request, there is no group to pin them to
     return _connection_cache.local().with_node_client<raftgen_client_protocol>(
       _self,
       ss::this_shard_id(),
@@ -60,10 +80,13 @@ ss::future<result<heartbeat_reply>> rpc_client_protocol::heartbeat(
 ss::future<result<install_snapshot_reply>>
 rpc_client_protocol::install_snapshot(
   model::node_id n, install_snapshot_request&& r, rpc::client_opts opts) {
+    maybe_compress(opts);
+    const auto lane_hint = size_t(r.group());
     return _connection_cache.local().with_node_client<raftgen_client_protocol>(
       _self,
       ss::this_shard_id(),
       n,
+      lane_hint,
       [r = std::move(r),
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.install_snapshot(std::move(r), std::move(opts))
@@ -73,10 +96,12 @@ rpc_client_protocol::install_snapshot(
 
 ss::future<result<timeout_now_reply>> rpc_client_protocol::timeout_now(
   model::node_id n, timeout_now_request&& r, rpc::client_opts opts) {
+    const auto lane_hint = size_t(r.group());
     return _connection_cache.local().with_node_client<raftgen_client_protocol>(
       _self,
       ss::this_shard_id(),
       n,
+      lane_hint,
       [r = std::move(r),
        opts = std::move(opts)](raftgen_client_protocol client) mutable {
           return client.timeout_now(std::move(r), std::move(opts))
@@ -66,11 +66,12 @@ state_machine::batch_applicator::operator()(model::record_batch batch) {
     auto last_offset = batch.last_offset();
     return _machine->apply(std::move(batch)).then([this, last_offset] {
         _last_applied = last_offset;
-        _machine->_waiters.notify(_last_applied);
         return ss::stop_iteration::no;
     });
 }
 
+ss::future<> state_machine::on_batches_applied() { return ss::now(); }
+
 bool state_machine::stop_batch_applicator() { return _gate.is_closed(); }
 
 model::record_batch_reader make_checkpoint() {
@@ -115,9 +116,15 @@ ss::future<> state_machine::apply() {
           return std::move(reader)
             .consume(batch_applicator(this), model::no_timeout)
             .then([this](model::offset last_applied) {
-                if (last_applied >= model::offset(0)) {
-                    _next = last_applied + model::offset(1);
+                if (last_applied < model::offset(0)) {
+                    return ss::now();
                 }
+                // let the implementation flush work it batched across this
+                // poll before the new offsets become visible to waiters
+                return on_batches_applied().then([this, last_applied] {
+                    _next = last_applied + model::offset(1);
+                    _waiters.notify(last_applied);
+                });
             });
       })
       .handle_exception([this](const std::exception_ptr& e) {
@@ -92,6 +92,16 @@ public:
 
 protected:
     void set_next(model::offset offset);
+
+    /**
+     * Called once after every poll of the log, i.e. after the whole run of
+     * contiguous committed batches handed to apply has been consumed. An
+     * implementation buffering per batch work inside apply can flush it
+     * here in a single pass. Waiters registered through `wait` are only
+     * notified after this hook resolves.
+     */
+    virtual ss::future<> on_batches_applied();
+
     ss::gate _gate;
 
 private:
@@ -64,6 +64,37 @@ FIXTURE_TEST(stm_monotonicity_test, mux_state_machine_fixture) {
     }
 }
 
+FIXTURE_TEST(stm_allocate_range_test, mux_state_machine_fixture) {
+    start_raft();
+
+    config::configuration cfg;
+    cfg.id_allocator_batch_size.set_value(int16_t(4));
+    cfg.id_allocator_log_capacity.set_value(int16_t(2));
+
+    raft::id_allocator_stm stm(idstmlog, _raft.get(), cfg);
+
+    stm.start().get0();
+    auto stop = ss::defer([&stm] { stm.stop().get0(); });
+
+    wait_for_leader();
+
+    int64_t next_free = -1;
+
+    for (int i = 0; i < 5; i++) {
+        auto result
+          = stm.allocate_range_and_wait(3, model::timeout_clock::now() + 1s)
+              .get0();
+
+        BOOST_REQUIRE_EQUAL(raft::errc::success, result.raft_status);
+        BOOST_REQUIRE_EQUAL(3, result.range);
+        // ranges never overlap; short remainders may be discarded so the
+        // next base is allowed to jump forward
+        BOOST_REQUIRE_LT(next_free, result.base);
+
+        next_free = result.base + result.range;
+    }
+}
+
 FIXTURE_TEST(stm_restart_test, mux_state_machine_fixture) {
     start_raft();
 
@@ -165,6 +165,34 @@ struct simple_kv {
     }
 };
 
+// same kv state, but implementing the optional batched apply interface
+template<int8_t bt>
+struct batched_kv : simple_kv<bt> {
+    size_t batch_apply_calls = 0;
+
+    ss::future<std::vector<std::error_code>>
+    apply_updates(std::vector<model::record_batch> batches) {
+        ++batch_apply_calls;
+        return ss::do_with(
+          std::move(batches),
+          std::vector<std::error_code>{},
+          [this](
+            std::vector<model::record_batch>& batches,
+            std::vector<std::error_code>& results) {
+              results.reserve(batches.size());
+              return ss::do_for_each(
+                       batches,
+                       [this, &results](model::record_batch& b) {
+                           return this->do_apply_update(std::move(b))
+                             .then([&results](std::error_code ec) {
+                                 results.push_back(ec);
+                             });
+                       })
+                .then([&results] { return std::move(results); });
+          });
+    }
+};
+
 ss::logger kvlog{"kv-test"};
 
 template<typename T>
@@ -428,6 +456,45 @@ FIXTURE_TEST(test_mulitple_states, mux_state_machine_fixture) {
     BOOST_REQUIRE_EQUAL(state_2.kv_map.find("test")->second, 20);
 }
 
+FIXTURE_TEST(test_batched_state_apply, mux_state_machine_fixture) {
+    start_raft();
+    batched_kv<batch_type_1> state;
+    raft::mux_state_machine stm(
+      kvlog, _raft.get(), raft::persistent_last_applied::yes, state);
+    stm.start().get0();
+    auto stop = ss::defer([&stm] { stm.stop().get0(); });
+    wait_for_leader();
+    ss::abort_source as;
+
+    auto res = stm
+                 .replicate_and_wait(
+                   serialize_cmd(set_cmd{"batched", 1}, batch_type_1),
+                   model::timeout_clock::now() + 2s,
+                   as)
+                 .get0();
+    BOOST_REQUIRE_EQUAL(res, errc::success);
+
+    res = stm
+            .replicate_and_wait(
+              serialize_cmd(cas_cmd{"batched", 1, 2}, batch_type_1),
+              model::timeout_clock::now() + 2s,
+              as)
+            .get0();
+    BOOST_REQUIRE_EQUAL(res, errc::success);
+
+    res = stm
+            .replicate_and_wait(
+              serialize_cmd(set_cmd{"batched", 3}, batch_type_1),
+              model::timeout_clock::now() + 2s,
+              as)
+            .get0();
+    BOOST_REQUIRE_EQUAL(res, errc::key_already_exists);
+
+    BOOST_REQUIRE_EQUAL(state.kv_map.find("batched")->second, 2);
+    // every apply has to be routed through the span interface
+    BOOST_REQUIRE_GE(state.batch_apply_calls, 1);
+}
+
 FIXTURE_TEST(timeout_test, mux_state_machine_fixture) {
     start_raft();
     simple_kv<batch_type_1> state_1;
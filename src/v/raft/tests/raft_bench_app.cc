@@ -0,0 +1,210 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+//
+// raft_bench: replication and recovery benchmark over in-process raft
+// groups. Each group runs real consensus instances with real storage
+// backends talking over loopback rpc (the same plumbing the correctness
+// tests use). Sweeps group count and consistency level for replicate()
+// and measures how long a restarted follower takes to catch up, emitting
+// one JSON line per matrix cell so raft changes can be compared by
+// numbers instead of only by passing tests.
+
+#include "raft/tests/raft_group_fixture.h"
+#include "utils/hdr_hist.h"
+#include "vassert.h"
+#include "vlog.h"
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/thread.hh>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+static ss::logger rblgr{"raft_bench"};
+
+void cli_opts(boost::program_options::options_description_easy_init o) {
+    namespace po = boost::program_options;
+    o("max-groups",
+      po::value<std::size_t>()->default_value(4),
+      "sweep concurrent raft groups in powers of two up to this");
+    o("nodes", po::value<int>()->default_value(3), "replicas per group");
+    o("replicates",
+      po::value<std::size_t>()->default_value(200),
+      "replicate() calls per group per matrix cell");
+    o("batches",
+      po::value<std::size_t>()->default_value(10),
+      "record batches handed to each replicate() call");
+    o("recovery-batches",
+      po::value<std::size_t>()->default_value(500),
+      "batches replicated while the follower is down in the recovery bench");
+}
+
+namespace {
+
+constexpr std::array<raft::consistency_level, 3> consistency_levels = {
+  raft::consistency_level::no_ack,
+  raft::consistency_level::leader_ack,
+  raft::consistency_level::quorum_ack,
+};
+
+const char* consistency_name(raft::consistency_level l) {
+    switch (l) {
+    case raft::consistency_level::quorum_ack:
+        return "quorum_ack";
+    case raft::consistency_level::leader_ack:
+        return "leader_ack";
+    case raft::consistency_level::no_ack:
+        return "no_ack";
+    }
+    return "unknown";
+}
+
+// groups need disjoint port ranges since every node runs an rpc server
+uint16_t group_base_port(std::size_t idx) {
+    return static_cast<uint16_t>(35000 + idx * 100);
+}
+
+void bench_replication(
+  std::vector<std::unique_ptr<raft_group>>& groups,
+  raft::consistency_level lvl,
+  std::size_t replicates,
+  std::size_t batches) {
+    hdr_hist hist;
+    const auto start = std::chrono::steady_clock::now();
+    ss::parallel_for_each(
+      groups.begin(),
+      groups.end(),
+      [&](std::unique_ptr<raft_group>& gr) {
+          return ss::async([&, g = gr.get()] {
+              auto leader_id = g->wait_for_leader().get0();
+              for (std::size_t i = 0; i < replicates; ++i) {
+                  auto& leader = g->get_member(leader_id);
+                  auto m = hist.auto_measure();
+                  auto res = leader.consensus
+                               ->replicate(
+                                 random_batches_reader(
+                                   static_cast<int>(batches)),
+                                 raft::replicate_options(lvl))
+                               .get0();
+                  if (!res) {
+                      // leadership moved; chase it and keep going, the
+                      // point is throughput under realistic conditions
+                      m->set_trace(false);
+                      leader_id = g->wait_for_leader().get0();
+                  }
+              }
+          });
+      })
+      .get();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+
+    const auto total = replicates * groups.size();
+    fmt::print(
+      "{{\"bench\": \"replicate\", \"groups\": {}, \"consistency\": \"{}\", "
+      "\"replicates\": {}, \"batches_per_replicate\": {}, \"p50_us\": {}, "
+      "\"p95_us\": {}, \"p99_us\": {}, \"mean_us\": {:.1f}, "
+      "\"replicates_per_sec\": {:.1f}}}\n",
+      groups.size(),
+      consistency_name(lvl),
+      total,
+      batches,
+      hist.get_value_at(50.0),
+      hist.get_value_at(95.0),
+      hist.get_value_at(99.0),
+      hist.mean(),
+      static_cast<double>(total)
+        / (static_cast<double>(std::max<int64_t>(elapsed, 1)) / 1'000'000.0));
+}
+
+void bench_recovery(raft_group& gr, std::size_t batches) {
+    auto leader_id = gr.wait_for_leader().get0();
+    std::optional<model::node_id> victim;
+    for (auto& [id, _] : gr.get_members()) {
+        if (id != leader_id) {
+            victim = id;
+            break;
+        }
+    }
+    vassert(victim, "recovery bench needs at least two nodes");
+
+    gr.disable_node(*victim);
+    gr.wait_for_leader().get0();
+    auto replicated
+      = replicate_random_batches(
+          gr, static_cast<int>(batches), raft::consistency_level::quorum_ack)
+          .get0();
+    vassert(replicated, "could not replicate recovery workload");
+
+    const auto start = std::chrono::steady_clock::now();
+    gr.enable_node(*victim);
+    while (!are_logs_the_same_length(gr.read_all_logs())) {
+        if (std::chrono::steady_clock::now() - start > std::chrono::minutes(1)) {
+            throw std::runtime_error("recovery did not converge within 1min");
+        }
+        ss::sleep(std::chrono::milliseconds(50)).get();
+    }
+    const auto recovery_ms
+      = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+
+    fmt::print(
+      "{{\"bench\": \"recovery\", \"batches_behind\": {}, "
+      "\"recovery_ms\": {}}}\n",
+      batches,
+      recovery_ms);
+}
+
+} // namespace
+
+int main(int args, char** argv, char** env) {
+    ss::app_template app;
+    cli_opts(app.add_options());
+    return app.run(args, argv, [&app] {
+        return ss::async([&app] {
+            auto& opts = app.configuration();
+            const auto max_groups = opts["max-groups"].as<std::size_t>();
+            const auto nodes = opts["nodes"].as<int>();
+            const auto replicates = opts["replicates"].as<std::size_t>();
+            const auto batches = opts["batches"].as<std::size_t>();
+            const auto recovery_batches
+              = opts["recovery-batches"].as<std::size_t>();
+
+            for (std::size_t n_groups = 1; n_groups <= max_groups;
+                 n_groups *= 2) {
+                vlog(rblgr.info, "standing up {} groups", n_groups);
+                std::vector<std::unique_ptr<raft_group>> groups;
+                groups.reserve(n_groups);
+                for (std::size_t i = 0; i < n_groups; ++i) {
+                    groups.push_back(std::make_unique<raft_group>(
+                      raft::group_id(static_cast<int64_t>(i)),
+                      nodes,
+                      storage::log_config::storage_type::disk,
+                      model::cleanup_policy_bitflags::deletion,
+                      100_MiB,
+                      group_base_port(i)));
+                    groups.back()->enable_all();
+                }
+                for (auto lvl : consistency_levels) {
+                    bench_replication(groups, lvl, replicates, batches);
+                }
+                groups.clear();
+            }
+
+            vlog(rblgr.info, "recovery benchmark");
+            raft_group gr(raft::group_id(0), nodes);
+            gr.enable_all();
+            bench_recovery(gr, recovery_batches);
+            return 0;
+        });
+    });
+}
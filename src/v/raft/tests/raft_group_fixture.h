@@ -310,8 +310,12 @@ struct raft_group {
       = storage::log_config::storage_type::disk,
       model::cleanup_policy_bitflags cleanup_policy
       = model::cleanup_policy_bitflags::deletion,
-      size_t segment_size = 100_MiB)
-      : _id(id)
+      size_t segment_size = 100_MiB,
+      // benchmarks stand up many groups at once; give each its own
+      // port range so the per-node rpc servers do not collide
+      uint16_t base_port = 35000)
+      : base_port(base_port)
+      , _id(id)
       , _storage_type(storage_type)
       , _storage_dir("test.raft." + random_generators::gen_alphanum_string(6))
       , _cleanup_policy(cleanup_policy)
@@ -464,7 +468,7 @@ struct raft_group {
     const ss::sstring& get_data_dir() const { return _storage_dir; }
 
 private:
-    uint16_t base_port = 35000;
+    uint16_t base_port;
     raft::group_id _id;
     members_t _members;
     std::vector<model::broker> _initial_brokers;
@@ -284,3 +284,68 @@ SEASTAR_THREAD_TEST_CASE(snapshot_metadata_roundtrip) {
     BOOST_REQUIRE(d.cluster_time == ct);
     BOOST_REQUIRE_EQUAL(d.latest_configuration, cfg);
 }
+
+SEASTAR_THREAD_TEST_CASE(vote_request_roundtrip) {
+    raft::vote_request req{
+      .node_id = raft::vnode(model::node_id(1), model::revision_id(10)),
+      .target_node_id = raft::vnode(model::node_id(2), model::revision_id(20)),
+      .group = raft::group_id(42),
+      .term = model::term_id(3),
+      .prev_log_index = model::offset(199),
+      .prev_log_term = model::term_id(-1),
+      .leadership_transfer = true};
+
+    auto d = serialize_roundtrip_rpc(std::move(req));
+
+    BOOST_REQUIRE_EQUAL(
+      d.node_id, raft::vnode(model::node_id(1), model::revision_id(10)));
+    BOOST_REQUIRE_EQUAL(
+      d.target_node_id, raft::vnode(model::node_id(2), model::revision_id(20)));
+    BOOST_REQUIRE_EQUAL(d.group, raft::group_id(42));
+    BOOST_REQUIRE_EQUAL(d.term, model::term_id(3));
+    BOOST_REQUIRE_EQUAL(d.prev_log_index, model::offset(199));
+    BOOST_REQUIRE_EQUAL(d.prev_log_term, model::term_id(-1));
+    BOOST_REQUIRE_EQUAL(d.leadership_transfer, true);
+}
+
+SEASTAR_THREAD_TEST_CASE(vote_reply_roundtrip) {
+    raft::vote_reply reply{
+      .target_node_id = raft::vnode(model::node_id(3), model::revision_id(7)),
+      .term = model::term_id(11),
+      .granted = true,
+      .log_ok = false};
+
+    auto d = serialize_roundtrip_rpc(std::move(reply));
+
+    BOOST_REQUIRE_EQUAL(
+      d.target_node_id, raft::vnode(model::node_id(3), model::revision_id(7)));
+    BOOST_REQUIRE_EQUAL(d.term, model::term_id(11));
+    BOOST_REQUIRE_EQUAL(d.granted, true);
+    BOOST_REQUIRE_EQUAL(d.log_ok, false);
+}
+
+SEASTAR_THREAD_TEST_CASE(append_entries_reply_roundtrip) {
+    raft::append_entries_reply reply{
+      .target_node_id = raft::vnode(model::node_id(2), model::revision_id(1)),
+      .node_id = raft::vnode(model::node_id(1), model::revision_id(1)),
+      .group = raft::group_id(88),
+      .term = model::term_id(9),
+      .last_committed_log_index = model::offset(1000),
+      .last_dirty_log_index = model::offset(1010),
+      .last_term_base_offset = model::offset(900),
+      .result = raft::append_entries_reply::status::group_unavailable};
+
+    auto d = serialize_roundtrip_rpc(std::move(reply));
+
+    BOOST_REQUIRE_EQUAL(
+      d.target_node_id, raft::vnode(model::node_id(2), model::revision_id(1)));
+    BOOST_REQUIRE_EQUAL(
+      d.node_id, raft::vnode(model::node_id(1), model::revision_id(1)));
+    BOOST_REQUIRE_EQUAL(d.group, raft::group_id(88));
+    BOOST_REQUIRE_EQUAL(d.term, model::term_id(9));
+    BOOST_REQUIRE_EQUAL(d.last_committed_log_index, model::offset(1000));
+    BOOST_REQUIRE_EQUAL(d.last_dirty_log_index, model::offset(1010));
+    BOOST_REQUIRE_EQUAL(d.last_term_base_offset, model::offset(900));
+    BOOST_REQUIRE_EQUAL(
+      d.result, raft::append_entries_reply::status::group_unavailable);
+}
@@ -152,15 +152,11 @@ struct rpc_model_reader_consumer {
       : ref(oref) {}
     ss::future<ss::stop_iteration> operator()(model::record_batch batch) {
         reflection::serialize(ref, batch.header());
-        if (!batch.compressed()) {
-            reflection::serialize<int8_t>(ref, 0);
-            batch.for_each_record([this](model::record r) {
-                reflection::serialize(ref, std::move(r));
-            });
-        } else {
-            reflection::serialize<int8_t>(ref, 1);
-            reflection::serialize(ref, std::move(batch).release_data());
-        }
+        reflection::serialize<int8_t>(ref, batch.compressed() ? 1 : 0);
+        // the records iobuf is the exact representation the leader appended
+        // to its own log; sharing it serializes the payload once instead of
+        // re-encoding every record for every follower
+        reflection::serialize(ref, std::move(batch).release_data());
         return ss::make_ready_future<ss::stop_iteration>(
           ss::stop_iteration::no);
     }
@@ -319,6 +315,25 @@ T read_one_varint_delta(iobuf_parser& in, const T& prev) {
     auto dst = varlong_reader<T>(in);
     return prev + dst;
 }
+
+/*
+ * encode each element relative to the same-index element of a reference
+ * array instead of relative to its predecessor. used for fields that track
+ * another field of the same entry in the steady state (e.g. prev_log_index
+ * tracks commit_index for a caught-up group), where the per-entry delta is
+ * a run of single byte zeros regardless of how the entries are sorted.
+ */
+template<typename T>
+void encode_one_relative_array(
+  iobuf& o, const std::vector<T>& v, const std::vector<T>& base) {
+    if (v.empty()) {
+        return;
+    }
+    const size_t max = v.size();
+    for (size_t i = 0; i < max; ++i) {
+        encode_varint_delta(o, base[i], v[i]);
+    }
+}
 } // namespace internal
 
 ss::future<> async_adl<raft::heartbeat_request>::to(
@@ -378,12 +393,16 @@ ss::future<> async_adl<raft::heartbeat_request>::to(
           internal::encode_one_delta_array<model::offset>(
             out, encodee.commit_indices);
           internal::encode_one_delta_array<model::term_id>(out, encodee.terms);
-          internal::encode_one_delta_array<model::offset>(
-            out, encodee.prev_log_indices);
-          internal::encode_one_delta_array<model::term_id>(
-            out, encodee.prev_log_terms);
-          internal::encode_one_delta_array<model::offset>(
-            out, encodee.last_visible_indices);
+          // for a healthy, caught-up group the remaining offsets equal the
+          // commit index and the prev log term equals the current term, so
+          // a steady state heartbeat is group/commit/term deltas followed
+          // by zeros
+          internal::encode_one_relative_array<model::offset>(
+            out, encodee.prev_log_indices, encodee.commit_indices);
+          internal::encode_one_relative_array<model::term_id>(
+            out, encodee.prev_log_terms, encodee.terms);
+          internal::encode_one_relative_array<model::offset>(
+            out, encodee.last_visible_indices, encodee.commit_indices);
           internal::encode_one_delta_array<model::revision_id>(
             out, encodee.revisions);
           internal::encode_one_delta_array<model::revision_id>(
@@ -425,24 +444,22 @@ async_adl<raft::heartbeat_request>::from(iobuf_parser& in) {
           = internal::read_one_varint_delta<model::term_id>(
             in, req.heartbeats[i - 1].meta.term);
     }
-    req.heartbeats[0].meta.prev_log_index = varlong_reader<model::offset>(in);
-    for (size_t i = 1; i < max; ++i) {
+    // encoded relative to the same entry's commit index / term, see
+    // encode_one_relative_array
+    for (size_t i = 0; i < max; ++i) {
         req.heartbeats[i].meta.prev_log_index
           = internal::read_one_varint_delta<model::offset>(
-            in, req.heartbeats[i - 1].meta.prev_log_index);
+            in, req.heartbeats[i].meta.commit_index);
     }
-    req.heartbeats[0].meta.prev_log_term = varlong_reader<model::term_id>(in);
-    for (size_t i = 1; i < max; ++i) {
+    for (size_t i = 0; i < max; ++i) {
         req.heartbeats[i].meta.prev_log_term
           = internal::read_one_varint_delta<model::term_id>(
-            in, req.heartbeats[i - 1].meta.prev_log_term);
+            in, req.heartbeats[i].meta.term);
     }
-    req.heartbeats[0].meta.last_visible_index = varlong_reader<model::offset>(
-      in);
-    for (size_t i = 1; i < max; ++i) {
+    for (size_t i = 0; i < max; ++i) {
         req.heartbeats[i].meta.last_visible_index
           = internal::read_one_varint_delta<model::offset>(
-            in, req.heartbeats[i - 1].meta.last_visible_index);
+            in, req.heartbeats[i].meta.commit_index);
     }
 
     req.heartbeats[0].node_id = raft::vnode(
@@ -518,8 +535,10 @@ ss::future<> async_adl<raft::heartbeat_reply>::to(
 
     internal::encode_one_delta_array<model::offset>(
       out, encodee.last_committed_log_index);
-    internal::encode_one_delta_array<model::offset>(
-      out, encodee.last_dirty_log_index);
+    // the dirty offset equals the committed offset for a fully flushed
+    // follower, so relative encoding degenerates to a zero per entry
+    internal::encode_one_relative_array<model::offset>(
+      out, encodee.last_dirty_log_index, encodee.last_committed_log_index);
     internal::encode_one_delta_array<model::offset>(
       out, encodee.last_term_base_offset);
     internal::encode_one_delta_array<model::revision_id>(
@@ -565,11 +584,10 @@ async_adl<raft::heartbeat_reply>::from(iobuf_parser& in) {
             in, reply.meta[i - 1].last_committed_log_index);
     }
 
-    reply.meta[0].last_dirty_log_index = varlong_reader<model::offset>(in);
-    for (size_t i = 1; i < size; ++i) {
+    for (size_t i = 0; i < size; ++i) {
         reply.meta[i].last_dirty_log_index
           = internal::read_one_varint_delta<model::offset>(
-            in, reply.meta[i - 1].last_dirty_log_index);
+            in, reply.meta[i].last_committed_log_index);
     }
 
     reply.meta[0].last_term_base_offset = varlong_reader<model::offset>(in);
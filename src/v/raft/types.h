@@ -80,6 +80,13 @@ struct follower_index_metadata {
     // timestamp of last append_entries_rpc call
     clock_type::time_point last_append_timestamp;
     clock_type::time_point last_hbeat_timestamp;
+    // creation timestamp of the most recently dispatched request to this
+    // follower. if the follower acknowledges that request its election
+    // timer was reset no earlier than this instant, which is what the
+    // leader lease computation relies on
+    clock_type::time_point last_sent_request_timestamp;
+    // dispatch timestamp of the newest request this follower acknowledged
+    clock_type::time_point last_acked_request_timestamp;
     uint64_t failed_appends{0};
     // The pair of sequences used to track append entries requests sent and
     // received by the follower. Every time append entries request is created
@@ -199,7 +206,10 @@ struct append_entries_request {
           req.node_id,
           req.target_node_id,
           std::move(req.meta),
-          model::make_foreign_record_batch_reader(std::move(req.batches)),
+          // batches are consumed wholesale on the target shard; prefetch
+          // them per hop instead of paying a core hop per slice
+          model::make_prefetching_foreign_record_batch_reader(
+            std::move(req.batches)),
           req.flush);
     }
 };
@@ -488,4 +498,50 @@ struct adl<raft::snapshot_metadata> {
     raft::snapshot_metadata from(iobuf_parser& in);
 };
 
+// the remaining raft control types are a fixed handful of integers, encode
+// them through flat_adl in a single buffer append instead of letting the
+// generic to_tuple based encoder emit one append per field. the field lists
+// mirror the struct definitions and are checked against reflection::arity,
+// so adding a member without updating the list will not compile
+template<>
+struct flat_layout<raft::append_entries_reply> {
+    using fields = field_list<
+      &raft::append_entries_reply::target_node_id,
+      &raft::append_entries_reply::node_id,
+      &raft::append_entries_reply::group,
+      &raft::append_entries_reply::term,
+      &raft::append_entries_reply::last_committed_log_index,
+      &raft::append_entries_reply::last_dirty_log_index,
+      &raft::append_entries_reply::last_term_base_offset,
+      &raft::append_entries_reply::result>;
+};
+template<>
+struct adl<raft::append_entries_reply>
+  : flat_adl<raft::append_entries_reply> {};
+
+template<>
+struct flat_layout<raft::vote_request> {
+    using fields = field_list<
+      &raft::vote_request::node_id,
+      &raft::vote_request::target_node_id,
+      &raft::vote_request::group,
+      &raft::vote_request::term,
+      &raft::vote_request::prev_log_index,
+      &raft::vote_request::prev_log_term,
+      &raft::vote_request::leadership_transfer>;
+};
+template<>
+struct adl<raft::vote_request> : flat_adl<raft::vote_request> {};
+
+template<>
+struct flat_layout<raft::vote_reply> {
+    using fields = field_list<
+      &raft::vote_reply::target_node_id,
+      &raft::vote_reply::term,
+      &raft::vote_reply::granted,
+      &raft::vote_reply::log_ok>;
+};
+template<>
+struct adl<raft::vote_reply> : flat_adl<raft::vote_reply> {};
+
 } // namespace reflection
@@ -9,6 +9,7 @@
 
 #include "redpanda/application.h"
 
+#include "bytes/iobuf.h"
 #include "cluster/id_allocator.h"
 #include "cluster/id_allocator_frontend.h"
 #include "cluster/metadata_dissemination_handler.h"
@@ -16,31 +17,46 @@
 #include "cluster/service.h"
 #include "config/configuration.h"
 #include "config/seed_server.h"
+#include "json/iobuf_buffer.h"
 #include "kafka/protocol.h"
 #include "model/metadata.h"
 #include "platform/stop_signal.h"
 #include "raft/service.h"
 #include "redpanda/admin/api-doc/config.json.h"
 #include "redpanda/admin/api-doc/kafka.json.h"
+#include "redpanda/admin/api-doc/debug.json.h"
 #include "redpanda/admin/api-doc/raft.json.h"
+#include "redpanda/admin/api-doc/storage.json.h"
+#include "resource_mgmt/memory_arbiter.h"
+#include "resource_mgmt/throttle.h"
 #include "rpc/simple_protocol.h"
 #include "storage/chunk_cache.h"
 #include "storage/directories.h"
+#include "storage/parser_utils.h"
+#include "storage/shard_assignment.h"
 #include "syschecks/syschecks.h"
 #include "test_utils/logs.h"
+#include "utils/async_log.h"
+#include "utils/cpu_profiler.h"
 #include "utils/file_io.h"
+#include "utils/mutex_stats.h"
+#include "utils/stage_tracer.h"
 #include "version.h"
 #include "vlog.h"
 
 #include <seastar/core/metrics.hh>
 #include <seastar/core/prometheus.hh>
 #include <seastar/core/thread.hh>
+#include <seastar/net/socket_defs.hh>
 #include <seastar/http/api_docs.hh>
 #include <seastar/http/exception.hh>
 #include <seastar/http/file_handler.hh>
 #include <seastar/json/json_elements.hh>
 #include <seastar/util/defer.hh>
 
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/range/irange.hpp>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <sys/utsname.h>
@@ -75,13 +91,19 @@ int application::run(int ac, char** av) {
                     }
                 });
                 // must initialize configuration before services
-                hydrate_config(cfg);
-                initialize();
-                check_environment();
-                setup_metrics();
-                configure_admin_server();
-                wire_up_services();
-                start();
+                run_phase("hydrate_config", [&] { hydrate_config(cfg); });
+                run_phase("initialize", [&] { initialize(); });
+                run_phase("check_environment", [&] { check_environment(); });
+                run_phase("setup_metrics", [&] { setup_metrics(); });
+                run_phase(
+                  "configure_admin_server", [&] { configure_admin_server(); });
+                run_phase("wire_up_services", [&] { wire_up_services(); });
+                run_phase("start", [&] { start(); });
+                if (config::shard_local_cfg().lazy_startup()) {
+                    run_phase(
+                      "deferred_services", [&] { start_deferred_services(); });
+                }
+                log_boot_phase_summary();
                 app_signal.wait().get();
                 vlog(_log.info, "Stopping...");
             } catch (...) {
@@ -103,6 +125,14 @@ void application::initialize() {
     _scheduling_groups.create_groups().get();
     _deferred.emplace_back(
       [this] { _scheduling_groups.destroy_groups().get(); });
+    // batch codec work is isolated from the request scheduling groups
+    ss::smp::invoke_on_all([sg = _scheduling_groups.compression_sg()] {
+        storage::internal::set_compression_scheduling_group(sg);
+    }).get();
+    // deferred log formatting runs off the request scheduling groups
+    ss::smp::invoke_on_all([sg = _scheduling_groups.log_sg()] {
+        async_log_queue::instance().set_scheduling_group(sg);
+    }).get();
     smp_service_groups.create_groups().get();
     _deferred.emplace_back(
       [this] { smp_service_groups.destroy_groups().get(); });
@@ -262,15 +292,36 @@ void application::configure_admin_server() {
               rb->register_api_file(server._routes, "raft");
               rb->register_function(server._routes, insert_comma);
               rb->register_api_file(server._routes, "kafka");
+              rb->register_function(server._routes, insert_comma);
+              rb->register_api_file(server._routes, "storage");
+              rb->register_function(server._routes, insert_comma);
+              rb->register_api_file(server._routes, "debug");
               ss::httpd::config_json::get_config.set(
                 server._routes, []([[maybe_unused]] ss::const_req req) {
-                    rapidjson::StringBuffer buf;
-                    rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+                    iobuf body;
+                    json::iobuf_buffer buf(body);
+                    rapidjson::Writer<json::iobuf_buffer> writer(buf);
                     config::shard_local_cfg().to_json(writer);
-                    return ss::json::json_return_type(buf.GetString());
+                    buf.Flush();
+                    // stream the dump fragment by fragment instead of
+                    // materializing a contiguous string
+                    return ss::json::json_return_type(
+                      [body = std::move(body)](
+                        ss::output_stream<char>&& out) mutable {
+                          return ss::do_with(
+                            std::move(body),
+                            std::move(out),
+                            [](iobuf& body, ss::output_stream<char>& out) {
+                                return write_iobuf_to_output_stream(
+                                         std::move(body), out)
+                                  .finally([&out] { return out.close(); });
+                            });
+                      });
                 });
               admin_register_raft_routes(server);
               admin_register_kafka_routes(server);
+              admin_register_storage_routes(server);
+              admin_register_debug_routes(server);
           })
           .get();
     }
@@ -310,7 +361,7 @@ static storage::kvstore_config kvstore_config_from_global_config() {
 }
 
 static storage::log_config manager_config_from_global_config() {
-    return storage::log_config(
+    auto cfg = storage::log_config(
       storage::log_config::storage_type::disk,
       config::shard_local_cfg().data_directory().as_sstring(),
       config::shard_local_cfg().log_segment_size(),
@@ -327,17 +378,44 @@ static storage::log_config manager_config_from_global_config() {
         .min_size = config::shard_local_cfg().reclaim_min_size(),
         .max_size = config::shard_local_cfg().reclaim_max_size(),
       });
+    if (config::shard_local_cfg().archival_storage_enabled()) {
+        cfg.archival_cache_dir
+          = config::shard_local_cfg().archival_storage_cache_directory().value_or(
+            ss::format(
+              "{}/archival_cache",
+              config::shard_local_cfg().data_directory().as_sstring()));
+        cfg.archival_cache_max_bytes
+          = config::shard_local_cfg().archival_storage_cache_max_bytes();
+    }
+    return cfg;
 }
 
 // add additional services in here
 void application::wire_up_services() {
     ss::smp::invoke_on_all([] {
+        tracing::stage_tracer::shard_local().set_sampling_rate(
+          config::shard_local_cfg().latency_trace_sampling_rate());
+        mutex_stats::shard_local().set_sampling_rate(
+          config::shard_local_cfg().mutex_contention_sampling_rate());
+        const auto& cfg = config::shard_local_cfg();
+        background_throttle::shard_local().start({
+          .total = background_throttle::per_shard(cfg.background_bandwidth()),
+          .recovery = background_throttle::per_shard(
+            cfg.raft_recovery_bandwidth()),
+          .compaction = background_throttle::per_shard(
+            cfg.compaction_bandwidth()),
+          .archival_fetch = background_throttle::per_shard(
+            cfg.archival_fetch_bandwidth()),
+        });
         return storage::internal::chunks().start();
     }).get();
 
     // cluster
     syschecks::systemd_message("Adding raft client cache").get();
-    construct_service(_raft_connection_cache).get();
+    construct_service(
+      _raft_connection_cache,
+      config::shard_local_cfg().rpc_client_connections_per_peer())
+      .get();
     syschecks::systemd_message("Building shard-lookup tables").get();
     construct_service(shard_table).get();
 
@@ -348,15 +426,12 @@ void application::wire_up_services() {
       manager_config_from_global_config())
       .get();
 
-    if (coproc_enabled()) {
-        auto coproc_supervisor_server_addr = config::shard_local_cfg()
-                                               .coproc_supervisor_server()
-                                               .resolve()
-                                               .get0();
-        syschecks::systemd_message("Building coproc pacemaker").get();
-        construct_service(
-          pacemaker, coproc_supervisor_server_addr, std::ref(storage))
-          .get();
+    if (!config::shard_local_cfg().lazy_startup()) {
+        wire_up_archival();
+    }
+
+    if (coproc_enabled() && !config::shard_local_cfg().lazy_startup()) {
+        wire_up_coproc();
     }
 
     syschecks::systemd_message("Intializing raft group manager").get();
@@ -459,23 +534,6 @@ void application::wire_up_services() {
     syschecks::systemd_message("Starting internal RPC {}", rpc_cfg).get();
     construct_service(_rpc, rpc_cfg).get();
 
-    // coproc rpc
-    if (coproc_enabled()) {
-        auto coproc_script_manager_server_addr
-          = config::shard_local_cfg()
-              .coproc_script_manager_server()
-              .resolve()
-              .get0();
-        rpc::server_configuration cp_rpc_cfg("coproc_rpc");
-        cp_rpc_cfg.max_service_memory_per_core
-          = memory_groups::rpc_total_memory();
-        cp_rpc_cfg.addrs.emplace_back(coproc_script_manager_server_addr);
-        syschecks::systemd_message(
-          "Starting coprocessor internal RPC {}", cp_rpc_cfg)
-          .get();
-        construct_service(_coproc_rpc, cp_rpc_cfg).get();
-    }
-
     syschecks::systemd_message("Creating id allocator frontend").get();
     construct_service(
       id_allocator_frontend,
@@ -517,6 +575,110 @@ void application::wire_up_services() {
       .get();
 }
 
+void application::wire_up_archival() {
+    if (!config::shard_local_cfg().archival_storage_enabled()) {
+        return;
+    }
+    syschecks::systemd_message("Starting archival segment fetcher").get();
+    const auto& arch_cfg = config::shard_local_cfg();
+    auto s3_conf = s3::configuration::make_configuration(
+                     s3::public_key_str(
+                       arch_cfg.archival_storage_s3_access_key().value()),
+                     s3::private_key_str(
+                       arch_cfg.archival_storage_s3_secret_key().value()),
+                     s3::aws_region_name(
+                       arch_cfg.archival_storage_s3_region().value()))
+                     .get0();
+    construct_service(
+      _archival_fetcher,
+      s3_conf,
+      s3::bucket_name(arch_cfg.archival_storage_s3_bucket().value()))
+      .get();
+    // reads below the local log start now hydrate from the bucket,
+    // through the shard-local hydrated segment cache
+    _archival_fetcher
+      .invoke_on_all([this](archival::remote_segment_fetcher& fetcher) {
+          fetcher.set_cache(storage.local().log_mgr().hydrated_cache());
+          storage.local().log_mgr().set_remote_fetch_hook(&fetcher);
+      })
+      .get();
+}
+
+void application::wire_up_coproc() {
+    // a same-host engine is reached over a unix domain socket when
+    // one is configured, skipping the TCP stack entirely
+    const auto& uds_path
+      = config::shard_local_cfg().coproc_supervisor_unix_socket();
+    auto coproc_supervisor_server_addr
+      = !uds_path.empty()
+          ? ss::socket_address{ss::unix_domain_addr{uds_path}}
+          : config::shard_local_cfg()
+              .coproc_supervisor_server()
+              .resolve()
+              .get0();
+    syschecks::systemd_message("Building coproc pacemaker").get();
+    construct_service(
+      pacemaker, coproc_supervisor_server_addr, std::ref(storage))
+      .get();
+
+    auto coproc_script_manager_server_addr = config::shard_local_cfg()
+                                               .coproc_script_manager_server()
+                                               .resolve()
+                                               .get0();
+    rpc::server_configuration cp_rpc_cfg("coproc_rpc");
+    cp_rpc_cfg.max_service_memory_per_core = memory_groups::rpc_total_memory();
+    cp_rpc_cfg.addrs.emplace_back(coproc_script_manager_server_addr);
+    syschecks::systemd_message(
+      "Starting coprocessor internal RPC {}", cp_rpc_cfg)
+      .get();
+    construct_service(_coproc_rpc, cp_rpc_cfg).get();
+}
+
+void application::start_coproc() {
+    syschecks::systemd_message("Starting coproc RPC").get();
+    _coproc_rpc
+      .invoke_on_all([this](rpc::server& s) {
+          auto proto = std::make_unique<rpc::simple_protocol>();
+          proto->register_service<coproc::service>(
+            _scheduling_groups.coproc_sg(),
+            smp_service_groups.coproc_smp_sg(),
+            std::ref(pacemaker));
+          s.set_protocol(std::move(proto));
+      })
+      .get();
+    _coproc_rpc.invoke_on_all(&rpc::server::start).get();
+    vlog(
+      _log.info,
+      "Started coproc RPC server listening at {}",
+      config::shard_local_cfg().coproc_script_manager_server());
+}
+
+/*
+ * everything the Kafka listener does not need to accept its first request.
+ * in lazy mode these run after the listener is live so a rolling restart
+ * is unreachable only for the essential phases.
+ */
+void application::start_deferred_services() {
+    wire_up_archival();
+    if (coproc_enabled()) {
+        wire_up_coproc();
+        start_coproc();
+    }
+}
+
+void application::log_boot_phase_summary() {
+    ss::sstring summary;
+    std::chrono::milliseconds total{0};
+    for (const auto& phase : _boot_phases) {
+        if (!summary.empty()) {
+            summary += ", ";
+        }
+        summary += fmt::format("{}={}ms", phase.name, phase.duration.count());
+        total += phase.duration;
+    }
+    vlog(_log.info, "Boot took {}ms ({})", total.count(), summary);
+}
+
 void application::start() {
     syschecks::systemd_message("Staring storage services").get();
     storage.invoke_on_all(&storage::api::start).get();
@@ -571,23 +733,8 @@ void application::start() {
     _rpc.invoke_on_all(&rpc::server::start).get();
     vlog(_log.info, "Started RPC server listening at {}", conf.rpc_server());
 
-    if (coproc_enabled()) {
-        syschecks::systemd_message("Starting coproc RPC").get();
-        _coproc_rpc
-          .invoke_on_all([this](rpc::server& s) {
-              auto proto = std::make_unique<rpc::simple_protocol>();
-              proto->register_service<coproc::service>(
-                _scheduling_groups.coproc_sg(),
-                smp_service_groups.coproc_smp_sg(),
-                std::ref(pacemaker));
-              s.set_protocol(std::move(proto));
-          })
-          .get();
-        _coproc_rpc.invoke_on_all(&rpc::server::start).get();
-        vlog(
-          _log.info,
-          "Started coproc RPC server listening at {}",
-          conf.coproc_script_manager_server());
+    if (coproc_enabled() && !conf.lazy_startup()) {
+        start_coproc();
     }
 
     quota_mgr.invoke_on_all(&kafka::quota_manager::start).get();
@@ -613,6 +760,67 @@ void application::start() {
     vlog(
       _log.info, "Started Kafka API server listening at {}", conf.kafka_api());
 
+    // with every consumer of a boot-time memory carving running, hand
+    // the grants over to the per-shard arbiter so pressure can move
+    // memory between the groups at runtime
+    syschecks::systemd_message("Starting memory arbiter").get();
+    auto register_server_group =
+      [](const ss::sstring& name, size_t boot_grant) {
+          return [name, boot_grant](rpc::server& s) {
+              memory_arbiter::shard_local().register_group({
+                .name = name,
+                .floor = boot_grant / 2,
+                .ceiling = boot_grant * 2,
+                .granted = s.service_memory(),
+                .pressure =
+                  [&s] {
+                      return uint64_t(s.probe().requests_blocked_memory());
+                  },
+                .used = [&s] { return s.consumed_service_memory(); },
+                .resize = [&s](size_t grant) { s.set_service_memory(grant); },
+              });
+          };
+      };
+    _kafka_server
+      .invoke_on_all(register_server_group(
+        "kafka", memory_groups::kafka_total_memory()))
+      .get();
+    _rpc
+      .invoke_on_all(register_server_group(
+        "internal_rpc", memory_groups::rpc_total_memory()))
+      .get();
+    ss::smp::invoke_on_all([] {
+        auto& cache = storage::internal::chunks();
+        memory_arbiter::shard_local().register_group({
+          .name = "chunk_cache",
+          .floor = memory_groups::chunk_cache_min_memory() / 2,
+          .ceiling = memory_groups::chunk_cache_max_memory(),
+          .granted = cache.size_target(),
+          .pressure = [&cache] { return cache.waits(); },
+          .used = [&cache] { return cache.size_total(); },
+          .resize = [&cache](size_t grant) {
+              cache.set_memory_target(grant);
+          },
+        });
+        memory_arbiter::shard_local().start();
+    }).get();
+    _deferred.emplace_back([] {
+        // callbacks point into the services, stop the arbiter before
+        // any of them goes away
+        ss::smp::invoke_on_all([] {
+            memory_arbiter::shard_local().stop();
+        }).get();
+    });
+
+    // runs first at shutdown: hand leaders off while raft RPC is still up
+    // so a rolling restart does not leave followers waiting out election
+    // timeouts for every led partition
+    _deferred.emplace_back([this] {
+        partition_manager
+          .invoke_on_all(&cluster::partition_manager::drain_leadership)
+          .get();
+    });
+
     vlog(_log.info, "Successfully started Redpanda!");
     syschecks::systemd_notify_ready().get();
 }
@@ -747,4 +955,365 @@ void application::admin_register_kafka_routes(ss::http_server& server) {
                   });
             });
       });
+
+    ss::httpd::kafka_json::kafka_move_partition_replicas.set(
+      server._routes, [this](std::unique_ptr<ss::httpd::request> req) {
+          auto topic = model::topic(req->param["topic"]);
+
+          model::partition_id partition;
+          try {
+              partition = model::partition_id(
+                std::stoll(req->param["partition"]));
+          } catch (...) {
+              throw ss::httpd::bad_param_exception(fmt::format(
+                "Partition id must be an integer: {}",
+                req->param["partition"]));
+          }
+
+          if (partition() < 0) {
+              throw ss::httpd::bad_param_exception(
+                fmt::format("Invalid partition id {}", partition));
+          }
+
+          auto targets = req->get_query_param("targets");
+          if (targets.empty()) {
+              throw ss::httpd::bad_param_exception(
+                "Target node list must not be empty");
+          }
+
+          model::ntp ntp(model::kafka_namespace, topic, partition);
+
+          std::vector<std::string> nodes;
+          boost::split(nodes, targets, boost::is_any_of(","));
+          std::vector<model::broker_shard> replicas;
+          replicas.reserve(nodes.size());
+          for (const auto& node : nodes) {
+              model::node_id id;
+              try {
+                  id = model::node_id(std::stoi(node));
+              } catch (...) {
+                  throw ss::httpd::bad_param_exception(fmt::format(
+                    "Target node id must be an integer: {}", node));
+              }
+              auto broker
+                = controller->get_members_table().local().get_broker(id);
+              if (!broker) {
+                  throw ss::httpd::not_found_exception(
+                    fmt::format("Node {} is not a cluster member", id));
+              }
+              // evaluate the shard placement hash with the target node's
+              // core count since the replica lands on that node
+              replicas.push_back(model::broker_shard{
+                .node_id = id,
+                .shard = storage::shard_of(
+                  ntp, (*broker)->properties().cores)});
+          }
+
+          vlog(
+            _log.info,
+            "Replica move request for topic-partition {}:{} to nodes {}",
+            topic,
+            partition,
+            targets);
+
+          return controller->get_topics_frontend()
+            .local()
+            .move_partition_replicas(
+              std::move(ntp),
+              std::move(replicas),
+              model::timeout_clock::now() + std::chrono::seconds(10))
+            .then([](std::error_code ec) {
+                if (ec) {
+                    throw ss::httpd::server_error_exception(
+                      fmt::format("Replica move failed: {}", ec.message()));
+                }
+                return ss::json::json_return_type(ss::json::json_void());
+            });
+      });
+}
+
+void application::admin_register_storage_routes(ss::http_server& server) {
+    ss::httpd::storage_json::storage_attribution.set(
+      server._routes,
+      [this]([[maybe_unused]] std::unique_ptr<ss::httpd::request> req) {
+          // samples are recorded shard-locally; render each shard's
+          // partitions to a json fragment there and stitch the fragments
+          // together on the handler shard
+          return storage
+            .map([](storage::api& api) {
+                rapidjson::StringBuffer buf;
+                rapidjson::Writer<rapidjson::StringBuffer> w(buf);
+                w.StartObject();
+                w.Key("shard");
+                w.Uint(ss::this_shard_id());
+                w.Key("partitions");
+                w.StartArray();
+                api.log_mgr().for_each_log(
+                  [&w](const model::ntp& ntp, const storage::log& log) {
+                      auto samples = log.attribution_samples();
+                      if (samples.empty()) {
+                          return;
+                      }
+                      w.StartObject();
+                      w.Key("ntp");
+                      auto path = ntp.path();
+                      w.String(path.c_str());
+                      w.Key("samples");
+                      w.StartArray();
+                      for (const auto& s : samples) {
+                          w.StartObject();
+                          w.Key("ts_ms");
+                          w.Int64(std::chrono::duration_cast<
+                                    std::chrono::milliseconds>(
+                                    s.when.time_since_epoch())
+                                    .count());
+                          w.Key("bytes_written");
+                          w.Uint64(s.bytes_written);
+                          w.Key("bytes_read");
+                          w.Uint64(s.bytes_read);
+                          w.Key("batches_written");
+                          w.Uint64(s.batches_written);
+                          w.Key("append_latency_us");
+                          w.Uint64(s.append_latency_us);
+                          w.EndObject();
+                      }
+                      w.EndArray();
+                      w.EndObject();
+                  });
+                w.EndArray();
+                w.EndObject();
+                return ss::sstring(buf.GetString());
+            })
+            .then([](std::vector<ss::sstring> shards) {
+                ss::sstring body = "[";
+                for (size_t i = 0; i < shards.size(); ++i) {
+                    if (i > 0) {
+                        body += ",";
+                    }
+                    body += shards[i];
+                }
+                body += "]";
+                return ss::json::json_return_type(std::move(body));
+            });
+      });
+}
+
+static ss::sstring render_shard_traces() {
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> w(buf);
+    w.StartObject();
+    w.Key("shard");
+    w.Uint(ss::this_shard_id());
+    w.Key("traces");
+    w.StartArray();
+    for (const auto& t : tracing::stage_tracer::shard_local().dump()) {
+        w.StartObject();
+        w.Key("op");
+        w.String(t.op);
+        w.Key("start_ms");
+        w.Int64(std::chrono::duration_cast<std::chrono::milliseconds>(
+                  t.started_at.time_since_epoch())
+                  .count());
+        w.Key("total_us");
+        w.Int64(t.total.count());
+        w.Key("stages");
+        w.StartArray();
+        for (size_t i = 0; i < t.stage_count; ++i) {
+            w.StartObject();
+            w.Key("name");
+            w.String(t.stages[i].name);
+            w.Key("us");
+            w.Int64(t.stages[i].elapsed.count());
+            w.EndObject();
+        }
+        w.EndArray();
+        w.EndObject();
+    }
+    w.EndArray();
+    w.EndObject();
+    return ss::sstring(buf.GetString());
+}
+
+static ss::sstring render_shard_mutex_report() {
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> w(buf);
+    w.StartObject();
+    w.Key("shard");
+    w.Uint(ss::this_shard_id());
+    w.Key("mutexes");
+    w.StartArray();
+    for (const auto* e : mutex_stats::shard_local().ranked()) {
+        w.StartObject();
+        w.Key("name");
+        w.String(e->name);
+        w.Key("acquisitions");
+        w.Uint64(e->acquisitions);
+        w.Key("sampled_waits");
+        w.Uint64(e->sampled_waits);
+        w.Key("total_wait_us");
+        w.Uint64(e->total_wait_us);
+        w.Key("max_wait_us");
+        w.Uint64(e->max_wait_us);
+        w.Key("waiting");
+        w.Int64(e->waiting);
+        w.EndObject();
+    }
+    w.EndArray();
+    w.EndObject();
+    return ss::sstring(buf.GetString());
+}
+
+static ss::sstring render_shard_profile() {
+    auto& profiler = profiling::cpu_profiler::shard_local();
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> w(buf);
+    w.StartObject();
+    w.Key("shard");
+    w.Uint(ss::this_shard_id());
+    w.Key("running");
+    w.Bool(profiler.running());
+    w.Key("samples");
+    w.Uint64(profiler.samples_taken());
+    w.Key("folded");
+    auto folded = profiler.folded_stacks();
+    w.String(folded.c_str(), static_cast<rapidjson::SizeType>(folded.size()));
+    w.EndObject();
+    return ss::sstring(buf.GetString());
+}
+
+void application::admin_register_debug_routes(ss::http_server& server) {
+    ss::httpd::debug_json::get_boot_phases.set(
+      server._routes,
+      [this]([[maybe_unused]] std::unique_ptr<ss::httpd::request> req) {
+          // _boot_phases is written on shard 0 during boot and immutable
+          // once startup completes, so reading it here is safe on any shard
+          ss::sstring body = "[";
+          for (const auto& phase : _boot_phases) {
+              if (body.size() > 1) {
+                  body += ",";
+              }
+              body += fmt::format(
+                "{{\"name\":\"{}\",\"duration_ms\":{}}}",
+                phase.name,
+                phase.duration.count());
+          }
+          body += "]";
+          return ss::json::json_return_type(std::move(body));
+      });
+
+    ss::httpd::debug_json::start_cpu_profiler.set(
+      server._routes, [](std::unique_ptr<ss::httpd::request> req) {
+          auto period = profiling::cpu_profiler::default_period;
+          if (auto p = req->get_query_param("period_ms"); !p.empty()) {
+              int64_t ms = 0;
+              try {
+                  ms = std::stoll(p);
+              } catch (...) {
+                  throw ss::httpd::bad_param_exception(
+                    fmt::format("Sample period must be an integer: {}", p));
+              }
+              // bound the sampling overhead; anything finer than 1ms is
+              // perf territory
+              if (ms < 1 || ms > 1000) {
+                  throw ss::httpd::bad_param_exception(fmt::format(
+                    "Sample period must be within [1, 1000] ms: {}", ms));
+              }
+              period = std::chrono::milliseconds(ms);
+          }
+          return ss::smp::invoke_on_all([period] {
+                     profiling::cpu_profiler::shard_local().start(period);
+                 })
+            .then([] {
+                return ss::json::json_return_type(ss::json::json_void());
+            });
+      });
+
+    ss::httpd::debug_json::stop_cpu_profiler.set(
+      server._routes,
+      []([[maybe_unused]] std::unique_ptr<ss::httpd::request> req) {
+          return ss::smp::invoke_on_all([] {
+                     profiling::cpu_profiler::shard_local().stop();
+                 })
+            .then([] {
+                return ss::json::json_return_type(ss::json::json_void());
+            });
+      });
+
+    ss::httpd::debug_json::get_cpu_profile.set(
+      server._routes,
+      []([[maybe_unused]] std::unique_ptr<ss::httpd::request> req) {
+          // symbolization and folding happen on the owning shard; only
+          // the rendered fragments travel back to the handler shard
+          return ss::do_with(ss::sstring("["), [](ss::sstring& body) {
+              return ss::do_for_each(
+                       boost::irange<unsigned>(0, ss::smp::count),
+                       [&body](unsigned shard) {
+                           return ss::smp::submit_to(
+                                    shard,
+                                    [] { return render_shard_profile(); })
+                             .then([&body, shard](ss::sstring frag) {
+                                 if (shard > 0) {
+                                     body += ",";
+                                 }
+                                 body += std::move(frag);
+                             });
+                       })
+                .then([&body] {
+                    body += "]";
+                    return ss::json::json_return_type(std::move(body));
+                });
+          });
+      });
+
+
+    ss::httpd::debug_json::get_mutex_contention.set(
+      server._routes,
+      []([[maybe_unused]] std::unique_ptr<ss::httpd::request> req) {
+          // contention entries are shard-local; render on each shard in
+          // turn, worst mutex first, and stitch the fragments together
+          return ss::do_with(ss::sstring("["), [](ss::sstring& body) {
+              return ss::do_for_each(
+                       boost::irange<unsigned>(0, ss::smp::count),
+                       [&body](unsigned shard) {
+                           return ss::smp::submit_to(
+                                    shard,
+                                    [] { return render_shard_mutex_report(); })
+                             .then([&body, shard](ss::sstring frag) {
+                                 if (shard > 0) {
+                                     body += ",";
+                                 }
+                                 body += std::move(frag);
+                             });
+                       })
+                .then([&body] {
+                    body += "]";
+                    return ss::json::json_return_type(std::move(body));
+                });
+          });
+      });
+
+    ss::httpd::debug_json::get_latency_traces.set(
+      server._routes,
+      []([[maybe_unused]] std::unique_ptr<ss::httpd::request> req) {
+          // trace rings are shard-local plain state; hop to each shard in
+          // turn and stitch the rendered fragments together
+          return ss::do_with(ss::sstring("["), [](ss::sstring& body) {
+              return ss::do_for_each(
+                       boost::irange<unsigned>(0, ss::smp::count),
+                       [&body](unsigned shard) {
+                           return ss::smp::submit_to(
+                                    shard, [] { return render_shard_traces(); })
+                             .then([&body, shard](ss::sstring frag) {
+                                 if (shard > 0) {
+                                     body += ",";
+                                 }
+                                 body += std::move(frag);
+                             });
+                       })
+                .then([&body] {
+                    body += "]";
+                    return ss::json::json_return_type(std::move(body));
+                });
+          });
+      });
 }
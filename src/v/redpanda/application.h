@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "archival/remote_segment_fetcher.h"
 #include "cluster/controller.h"
 #include "cluster/id_allocator_frontend.h"
 #include "cluster/metadata_cache.h"
@@ -37,6 +38,8 @@
 #include <seastar/http/httpd.hh>
 #include <seastar/util/defer.hh>
 
+#include <chrono>
+
 namespace po = boost::program_options; // NOLINT
 
 class application {
@@ -48,6 +51,15 @@ public:
     void configure_admin_server();
     void wire_up_services();
     void start();
+    void start_deferred_services();
+
+    /// wall time spent in one named step of the boot sequence. recorded on
+    /// shard 0 while booting and immutable afterwards, so the admin handler
+    /// may read it from any shard
+    struct boot_phase {
+        ss::sstring name;
+        std::chrono::milliseconds duration;
+    };
 
     void shutdown() {
         while (!_deferred.empty()) {
@@ -81,8 +93,25 @@ private:
     void validate_arguments(const po::variables_map&);
     void hydrate_config(const po::variables_map&);
 
+    template<typename Func>
+    void run_phase(const char* name, Func&& f) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        _boot_phases.push_back(boot_phase{
+          .name = name,
+          .duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start)});
+    }
+    void log_boot_phase_summary();
+
+    void wire_up_archival();
+    void wire_up_coproc();
+    void start_coproc();
+
     void admin_register_raft_routes(ss::http_server& server);
     void admin_register_kafka_routes(ss::http_server& server);
+    void admin_register_storage_routes(ss::http_server& server);
+    void admin_register_debug_routes(ss::http_server& server);
 
     bool coproc_enabled() {
         const auto& cfg = config::shard_local_cfg();
@@ -106,6 +135,7 @@ private:
     scheduling_groups _scheduling_groups;
     ss::logger _log{"redpanda::main"};
 
+    ss::sharded<archival::remote_segment_fetcher> _archival_fetcher;
     ss::sharded<rpc::server> _coproc_rpc;
     ss::sharded<rpc::connection_cache> _raft_connection_cache;
     ss::sharded<kafka::group_manager> _group_manager;
@@ -113,6 +143,7 @@ private:
     ss::sharded<ss::http_server> _admin;
     ss::sharded<rpc::server> _kafka_server;
     ss::metrics::metric_groups _metrics;
+    std::vector<boot_phase> _boot_phases;
     // run these first on destruction
     deferred_actions _deferred;
 };
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_parser.h"
+#include "reflection/arity.h"
+#include "seastarx.h"
+#include "utils/named_type.h"
+
+#include <seastar/core/byteorder.hh>
+
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+namespace reflection {
+
+/**
+ * Single pass encoders for fixed size types.
+ *
+ * The generic adl<> encoder walks a struct with reflection::to_tuple and
+ * emits one iobuf::append per field, producing a deep call chain for types
+ * that are nothing more than a handful of integers. flat_adl<> instead takes
+ * an explicit field list, computes the encoded size at compile time, fills a
+ * stack buffer and appends it in one call. The wire format is byte for byte
+ * identical to the field-by-field adl<> encoding, so switching a type to
+ * flat_adl<> is invisible on the wire.
+ *
+ * Usage - describe the type, then alias its adl to the flat encoder:
+ *
+ *   template<>
+ *   struct reflection::flat_layout<my_type> {
+ *       using fields = field_list<&my_type::a, &my_type::b>;
+ *   };
+ *   template<>
+ *   struct reflection::adl<my_type> : flat_adl<my_type> {};
+ *
+ * The field list must name every member in declaration order; the list
+ * length is checked against reflection::arity so adding a member without
+ * updating the list is a compile error.
+ */
+template<typename T>
+struct flat_layout; // specialize with: using fields = field_list<&T::a, ...>;
+
+template<auto... Fields>
+struct field_list {};
+
+template<typename T, typename Fields = typename flat_layout<T>::fields>
+struct flat_adl;
+
+/// Per-field codec with a compile time encoded size. Specializations are
+/// provided for the fixed width primitives the adl<> layer understands;
+/// types with private members (so a flat_layout<> cannot name them) may
+/// specialize it by hand, matching their adl<> wire format.
+template<typename F, typename = void>
+struct flat_codec;
+
+template<typename F>
+struct flat_codec<F, std::enable_if_t<std::is_integral_v<F>>> {
+    // bool has an implementation defined size; pin it to one byte exactly
+    // like adl<> does for the optional flag
+    using rep = std::conditional_t<std::is_same_v<F, bool>, int8_t, F>;
+    static constexpr size_t size = sizeof(rep);
+    static void encode(char* dst, F f) {
+        rep le = ss::cpu_to_le(static_cast<rep>(f));
+        std::memcpy(dst, &le, sizeof(rep));
+    }
+    static F decode(iobuf_parser& in) {
+        return static_cast<F>(ss::le_to_cpu(in.consume_type<rep>()));
+    }
+};
+
+template<typename F>
+struct flat_codec<F, std::enable_if_t<std::is_enum_v<F>>> {
+    using rep = std::underlying_type_t<F>;
+    static constexpr size_t size = flat_codec<rep>::size;
+    static void encode(char* dst, F f) {
+        flat_codec<rep>::encode(dst, static_cast<rep>(f));
+    }
+    static F decode(iobuf_parser& in) {
+        return static_cast<F>(flat_codec<rep>::decode(in));
+    }
+};
+
+template<typename U, typename Tag>
+struct flat_codec<named_type<U, Tag>, std::enable_if_t<std::is_integral_v<U>>> {
+    static constexpr size_t size = flat_codec<U>::size;
+    static void encode(char* dst, const named_type<U, Tag>& f) {
+        flat_codec<U>::encode(dst, f());
+    }
+    static named_type<U, Tag> decode(iobuf_parser& in) {
+        return named_type<U, Tag>(flat_codec<U>::decode(in));
+    }
+};
+
+template<typename Tag>
+struct flat_codec<ss::bool_class<Tag>> {
+    static constexpr size_t size = flat_codec<int8_t>::size;
+    static void encode(char* dst, ss::bool_class<Tag> f) {
+        flat_codec<int8_t>::encode(dst, static_cast<int8_t>(bool(f)));
+    }
+    static ss::bool_class<Tag> decode(iobuf_parser& in) {
+        return ss::bool_class<Tag>(flat_codec<int8_t>::decode(in));
+    }
+};
+
+// a flat type may embed another flat type
+template<typename F>
+struct flat_codec<F, std::void_t<typename flat_layout<F>::fields>> {
+    static constexpr size_t size = flat_adl<F>::encoded_size;
+    static void encode(char* dst, const F& f) { flat_adl<F>::encode(dst, f); }
+    static F decode(iobuf_parser& in) { return flat_adl<F>::decode(in); }
+};
+
+namespace detail {
+template<typename>
+struct member_pointer;
+template<typename C, typename M>
+struct member_pointer<M C::*> {
+    using class_type = C;
+    using member_type = M;
+};
+template<auto Ptr>
+using member_t =
+  typename member_pointer<std::decay_t<decltype(Ptr)>>::member_type;
+template<auto Ptr>
+using class_t =
+  typename member_pointer<std::decay_t<decltype(Ptr)>>::class_type;
+} // namespace detail
+
+template<typename T, auto... Fields>
+struct flat_adl<T, field_list<Fields...>> {
+    static_assert(std::is_standard_layout_v<T>);
+    static_assert(
+      (std::is_same_v<T, detail::class_t<Fields>> && ...),
+      "flat_layout<> field list names a member of a different type");
+    static_assert(
+      sizeof...(Fields) == arity<T>(),
+      "flat_layout<> field list does not cover every member of the type; "
+      "update the list after changing the struct definition");
+
+    static constexpr size_t encoded_size
+      = (0 + ... + flat_codec<detail::member_t<Fields>>::size);
+
+    static void encode(char* dst, const T& t) {
+        ((flat_codec<detail::member_t<Fields>>::encode(dst, t.*Fields),
+          dst += flat_codec<detail::member_t<Fields>>::size),
+         ...);
+    }
+
+    static T decode(iobuf_parser& in) {
+        // braced init evaluates left to right, in field declaration order
+        return T{flat_codec<detail::member_t<Fields>>::decode(in)...};
+    }
+
+    void to(iobuf& out, T t) {
+        std::array<char, encoded_size> staging;
+        encode(staging.data(), t);
+        out.append(staging.data(), staging.size());
+    }
+
+    T from(iobuf_parser& in) { return decode(in); }
+};
+
+} // namespace reflection
@@ -0,0 +1,110 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_parser.h"
+#include "reflection/adl.h"
+#include "reflection/flat_adl.h"
+#include "utils/named_type.h"
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/bool_class.hh>
+
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+
+using counter = named_type<int64_t, struct counter_tag>;
+using flag = ss::bool_class<struct flag_tag>;
+enum class color : uint8_t { red, green, blue };
+
+struct fixed_point {
+    counter a;
+    int32_t b;
+    color c;
+    bool d;
+    flag e;
+};
+
+struct fixed_pair {
+    fixed_point inner;
+    int16_t tail;
+};
+
+namespace reflection {
+template<>
+struct flat_layout<fixed_point> {
+    using fields = field_list<
+      &fixed_point::a,
+      &fixed_point::b,
+      &fixed_point::c,
+      &fixed_point::d,
+      &fixed_point::e>;
+};
+template<>
+struct flat_layout<fixed_pair> {
+    using fields = field_list<&fixed_pair::inner, &fixed_pair::tail>;
+};
+} // namespace reflection
+
+static fixed_point make_value() {
+    return fixed_point{
+      .a = counter(-42),
+      .b = 1234567,
+      .c = color::green,
+      .d = true,
+      .e = flag::yes};
+}
+
+SEASTAR_THREAD_TEST_CASE(flat_adl_roundtrip) {
+    iobuf out;
+    reflection::flat_adl<fixed_point>{}.to(out, make_value());
+    BOOST_REQUIRE_EQUAL(
+      out.size_bytes(), reflection::flat_adl<fixed_point>::encoded_size);
+
+    iobuf_parser in(std::move(out));
+    auto r = reflection::flat_adl<fixed_point>{}.from(in);
+    BOOST_REQUIRE_EQUAL(r.a, counter(-42));
+    BOOST_REQUIRE_EQUAL(r.b, 1234567);
+    BOOST_REQUIRE(r.c == color::green);
+    BOOST_REQUIRE_EQUAL(r.d, true);
+    BOOST_REQUIRE(r.e == flag::yes);
+}
+
+SEASTAR_THREAD_TEST_CASE(flat_adl_matches_generic_encoding) {
+    // the flat encoder must be byte for byte compatible with the generic
+    // field-by-field adl<> encoding, in both directions
+    iobuf flat;
+    reflection::flat_adl<fixed_point>{}.to(flat, make_value());
+    iobuf generic;
+    reflection::adl<fixed_point>{}.to(generic, make_value());
+    BOOST_REQUIRE(flat == generic);
+
+    iobuf_parser flat_in(std::move(generic));
+    auto from_generic = reflection::flat_adl<fixed_point>{}.from(flat_in);
+    BOOST_REQUIRE_EQUAL(from_generic.a, counter(-42));
+
+    iobuf_parser generic_in(std::move(flat));
+    auto from_flat = reflection::adl<fixed_point>{}.from(generic_in);
+    BOOST_REQUIRE_EQUAL(from_flat.b, 1234567);
+}
+
+SEASTAR_THREAD_TEST_CASE(flat_adl_nested) {
+    iobuf flat;
+    reflection::flat_adl<fixed_pair>{}.to(
+      flat, fixed_pair{.inner = make_value(), .tail = 7});
+    iobuf generic;
+    reflection::adl<fixed_pair>{}.to(
+      generic, fixed_pair{.inner = make_value(), .tail = 7});
+    BOOST_REQUIRE(flat == generic);
+
+    iobuf_parser in(std::move(flat));
+    auto r = reflection::flat_adl<fixed_pair>{}.from(in);
+    BOOST_REQUIRE_EQUAL(r.inner.a, counter(-42));
+    BOOST_REQUIRE_EQUAL(r.tail, 7);
+}
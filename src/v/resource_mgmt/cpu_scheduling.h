@@ -31,7 +31,11 @@ public:
           .then([] { return ss::create_scheduling_group("cluster", 300); })
           .then([this](ss::scheduling_group sg) { _cluster = sg; })
           .then([] { return ss::create_scheduling_group("coproc", 100); })
-          .then([this](ss::scheduling_group sg) { _coproc = sg; });
+          .then([this](ss::scheduling_group sg) { _coproc = sg; })
+          .then([] { return ss::create_scheduling_group("compression", 300); })
+          .then([this](ss::scheduling_group sg) { _compression = sg; })
+          .then([] { return ss::create_scheduling_group("log", 100); })
+          .then([this](ss::scheduling_group sg) { _log = sg; });
     }
 
     ss::future<> destroy_groups() {
@@ -39,7 +43,9 @@ public:
           .then([this] { return destroy_scheduling_group(_raft); })
           .then([this] { return destroy_scheduling_group(_kafka); })
           .then([this] { return destroy_scheduling_group(_cluster); })
-          .then([this] { return destroy_scheduling_group(_coproc); });
+          .then([this] { return destroy_scheduling_group(_coproc); })
+          .then([this] { return destroy_scheduling_group(_compression); })
+          .then([this] { return destroy_scheduling_group(_log); });
     }
 
     ss::scheduling_group admin_sg() { return _admin; }
@@ -47,6 +53,8 @@ public:
     ss::scheduling_group kafka_sg() { return _kafka; }
     ss::scheduling_group cluster_sg() { return _cluster; }
     ss::scheduling_group coproc_sg() { return _coproc; }
+    ss::scheduling_group compression_sg() { return _compression; }
+    ss::scheduling_group log_sg() { return _log; }
 
 private:
     ss::scheduling_group _admin;
@@ -54,4 +62,6 @@ private:
     ss::scheduling_group _kafka;
     ss::scheduling_group _cluster;
     ss::scheduling_group _coproc;
+    ss::scheduling_group _compression;
+    ss::scheduling_group _log;
 };
@@ -23,6 +23,10 @@ public:
     ss::io_priority_class controller_priority() { return _controller_priority; }
     ss::io_priority_class kafka_read_priority() { return _kafka_read_priority; }
     ss::io_priority_class compaction_priority() { return _compaction_priority; }
+    ss::io_priority_class kvstore_priority() { return _kvstore_priority; }
+    ss::io_priority_class raft_snapshot_priority() {
+        return _raft_snapshot_priority;
+    }
 
     static priority_manager& local() {
         static thread_local priority_manager pm = priority_manager();
@@ -37,12 +41,22 @@ private:
       , _kafka_read_priority(
           ss::engine().register_one_priority_class("kafka_read", 200))
       , _compaction_priority(
-          ss::engine().register_one_priority_class("compaction", 200)) {}
+          ss::engine().register_one_priority_class("compaction", 200))
+      // kvstore writes sit on the commit path of every consensus vote and
+      // offset update; starve them and everything above stalls
+      , _kvstore_priority(
+          ss::engine().register_one_priority_class("kvstore", 1000))
+      // snapshot persistence is background work; it must not compete with
+      // the append path of the same raft group
+      , _raft_snapshot_priority(
+          ss::engine().register_one_priority_class("raft_snapshot", 200)) {}
 
     ss::io_priority_class _raft_priority;
     ss::io_priority_class _controller_priority;
     ss::io_priority_class _kafka_read_priority;
     ss::io_priority_class _compaction_priority;
+    ss::io_priority_class _kvstore_priority;
+    ss::io_priority_class _raft_snapshot_priority;
 };
 
 inline ss::io_priority_class raft_priority() {
@@ -60,3 +74,11 @@ inline ss::io_priority_class kafka_read_priority() {
 inline ss::io_priority_class compaction_priority() {
     return priority_manager::local().compaction_priority();
 }
+
+inline ss::io_priority_class kvstore_priority() {
+    return priority_manager::local().kvstore_priority();
+}
+
+inline ss::io_priority_class raft_snapshot_priority() {
+    return priority_manager::local().raft_snapshot_priority();
+}
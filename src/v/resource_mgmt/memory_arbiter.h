@@ -0,0 +1,176 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "config/configuration.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "seastarx.h"
+
+#include <seastar/core/memory.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+/**
+ * Shard-local arbiter that migrates memory between the boot-time
+ * memory_groups carvings at runtime.
+ *
+ * Each group registers its grant together with a floor, a ceiling and
+ * three callbacks: a monotonic pressure counter (times the group made
+ * an allocation wait), its current usage, and a resize hook applying a
+ * new grant. A periodic tick moves one step of memory from a group that
+ * saw no pressure and has unused headroom to the group that saw the
+ * most, so a produce-heavy day drains memory out of the fetch path and
+ * a fetch-heavy night takes it back. Transfers are zero-sum, one step
+ * per tick bounds how fast memory migrates, and the no-pressure donor
+ * rule keeps the arbiter from thrashing between two busy groups.
+ *
+ * Register every group before start(); grants are only touched from
+ * the tick, never concurrently with registration.
+ */
+class memory_arbiter {
+public:
+    /// memory moved per tick: 1% of the shard's memory, so a sustained
+    /// imbalance migrates grants over minutes instead of oscillating
+    static size_t step() { return ss::memory::stats().total_memory() / 100; }
+    static constexpr auto tick_period = std::chrono::seconds(10);
+
+    struct group {
+        ss::sstring name;
+        /// grant bounds; the arbiter never resizes past them
+        size_t floor;
+        size_t ceiling;
+        size_t granted;
+        /// monotonic count of times the group made an allocation wait
+        ss::noncopyable_function<uint64_t()> pressure;
+        /// bytes of the grant currently in use
+        ss::noncopyable_function<size_t()> used;
+        /// applies a new grant to the group
+        ss::noncopyable_function<void(size_t)> resize;
+        uint64_t last_pressure{0};
+    };
+
+    void register_group(group g) {
+        _groups.push_back(std::make_unique<group>(std::move(g)));
+    }
+
+    void start() {
+        setup_metrics();
+        // prime the counters so the first tick only sees new pressure
+        for (auto& g : _groups) {
+            g->last_pressure = g->pressure();
+        }
+        _timer.set_callback([this] { rebalance(); });
+        _timer.arm_periodic(tick_period);
+    }
+
+    void stop() {
+        _timer.cancel();
+        _metrics.clear();
+        _groups.clear();
+    }
+
+    /// one rebalancing pass. public so tests can drive it directly
+    /// instead of waiting out the tick period
+    void rebalance() {
+        std::vector<uint64_t> deltas(_groups.size());
+        for (size_t i = 0; i < _groups.size(); ++i) {
+            auto& g = *_groups[i];
+            auto p = g.pressure();
+            deltas[i] = p - g.last_pressure;
+            g.last_pressure = p;
+        }
+        group* needy = nullptr;
+        uint64_t max_delta = 0;
+        for (size_t i = 0; i < _groups.size(); ++i) {
+            auto& g = *_groups[i];
+            if (deltas[i] > max_delta && g.granted + step() <= g.ceiling) {
+                needy = &g;
+                max_delta = deltas[i];
+            }
+        }
+        if (needy == nullptr) {
+            return;
+        }
+        // take from the group that saw no pressure at all this tick and
+        // has the most unused headroom; requiring a full step of slack
+        // means the transfer cannot itself create pressure at the donor
+        group* donor = nullptr;
+        size_t best_headroom = 0;
+        for (size_t i = 0; i < _groups.size(); ++i) {
+            auto& g = *_groups[i];
+            if (&g == needy || deltas[i] != 0) {
+                continue;
+            }
+            if (g.granted < g.floor + step()) {
+                continue;
+            }
+            auto used = g.used();
+            auto headroom = g.granted > used ? g.granted - used : 0;
+            if (headroom >= step() && headroom > best_headroom) {
+                donor = &g;
+                best_headroom = headroom;
+            }
+        }
+        if (donor == nullptr) {
+            return;
+        }
+        donor->granted -= step();
+        needy->granted += step();
+        donor->resize(donor->granted);
+        needy->resize(needy->granted);
+    }
+
+    static memory_arbiter& shard_local() {
+        static thread_local memory_arbiter a;
+        return a;
+    }
+
+private:
+    void setup_metrics() {
+        if (config::shard_local_cfg().disable_metrics()) {
+            return;
+        }
+        namespace sm = ss::metrics;
+        auto group_label = sm::label("group");
+        for (auto& g : _groups) {
+            std::vector<sm::label_instance> labels = {group_label(g->name)};
+            _metrics.add_group(
+              prometheus_sanitize::metrics_name("memory_groups"),
+              {sm::make_current_bytes(
+                 "granted_bytes",
+                 [g = g.get()] { return g->granted; },
+                 sm::description("Memory currently granted to the group"),
+                 labels),
+               sm::make_current_bytes(
+                 "used_bytes",
+                 [g = g.get()] { return g->used(); },
+                 sm::description("Memory the group reports in use"),
+                 labels),
+               sm::make_total_operations(
+                 "pressure_events",
+                 [g = g.get()] { return g->pressure(); },
+                 sm::description("Times the group made an allocation wait"),
+                 labels)});
+        }
+    }
+
+    std::vector<std::unique_ptr<group>> _groups;
+    ss::timer<> _timer;
+    ss::metrics::metric_groups _metrics;
+};
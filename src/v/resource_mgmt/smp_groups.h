@@ -15,16 +15,36 @@
 
 #include <seastar/core/reactor.hh>
 
+#include <algorithm>
+
 // manage SMP scheduling groups. These scheduling groups are global, so one
 // instance of this class can be created at the top level and passed down into
 // any server and any shard that needs to schedule continuations into a given
 // group.
 class smp_groups {
 public:
+    /*
+     * Cross-shard admission budget per source shard. Seastar sizes an
+     * smp service group per destination: all source shards share one
+     * max_nonlocal_requests pool at each destination, so a fixed total
+     * that is comfortable on an 8 core box quietly shrinks the
+     * per-source share below a hundred requests on 64 cores and hot
+     * shards start rejecting cross-shard work while the machine is
+     * mostly idle. Scaling the total with the number of source shards
+     * keeps the per-pair budget constant as machines grow; the old
+     * fixed total is kept as the floor for small core counts.
+     */
+    static constexpr unsigned requests_per_source_shard = 700;
+
+    static unsigned max_nonlocal_requests() {
+        return std::max<unsigned>(
+          5000, requests_per_source_shard * (ss::smp::count - 1));
+    }
+
     smp_groups() = default;
     ss::future<> create_groups() {
         ss::smp_service_group_config smp_sg_config;
-        smp_sg_config.max_nonlocal_requests = 5000;
+        smp_sg_config.max_nonlocal_requests = max_nonlocal_requests();
 
         return create_smp_service_group(smp_sg_config)
           .then([this](ss::smp_service_group sg) {
@@ -0,0 +1,242 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "config/configuration.h"
+#include "likely.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/core/sstring.hh>
+
+#include <algorithm>
+#include <chrono>
+
+/**
+ * Hierarchical token bucket.
+ *
+ * Buckets form a tree through the parent pointer: an acquisition must
+ * find tokens at every level of its chain, so per-entity buckets can
+ * hang off a subsystem bucket which in turn draws from a shared root.
+ * try_acquire is a handful of integer operations against the cached
+ * lowres clock and consumes nothing on failure; acquire sleeps out the
+ * worst deficit along the chain and retries.
+ *
+ * A rate of zero disables a level: it grants everything and consumes
+ * nothing, so a throttle can sit permanently in a hot path and cost
+ * two compares while unconfigured. The burst is one second of rate,
+ * which absorbs scheduling jitter without banking unbounded credit
+ * across idle periods.
+ */
+class token_bucket {
+public:
+    using clock = ss::lowres_clock;
+
+    explicit token_bucket(
+      ss::sstring name, size_t rate, token_bucket* parent = nullptr) noexcept
+      : _name(std::move(name))
+      , _parent(parent)
+      , _last_refill(clock::now()) {
+        set_rate(rate);
+    }
+
+    const ss::sstring& name() const { return _name; }
+    size_t rate() const { return _rate; }
+    /// tokens consumed through this bucket since construction
+    uint64_t acquired() const { return _acquired; }
+    /// times an acquire had to wait at this bucket's chain
+    uint64_t waits() const { return _waits; }
+
+    /// bytes per second; 0 disables this level entirely
+    void set_rate(size_t rate) noexcept {
+        if (_rate == 0) {
+            // was disabled: start over with a full bucket
+            _tokens = rate;
+        }
+        _rate = rate;
+        _burst = rate;
+        _tokens = std::min(_tokens, _burst);
+    }
+
+    /// non-blocking acquisition along the whole parent chain; consumes
+    /// nothing when any level comes up short
+    bool try_acquire(size_t tokens) noexcept {
+        for (auto* b = this; b != nullptr; b = b->_parent) {
+            b->refill();
+            if (b->_rate != 0 && b->_tokens < tokens) {
+                return false;
+            }
+        }
+        for (auto* b = this; b != nullptr; b = b->_parent) {
+            if (b->_rate != 0) {
+                b->_tokens -= tokens;
+            }
+        }
+        _acquired += tokens;
+        return true;
+    }
+
+    /// waits until the requested tokens are available at every level.
+    /// requests larger than a level's burst are clamped so they stay
+    /// admissible, degrading to pacing at the configured rate
+    ss::future<> acquire(size_t tokens) {
+        tokens = max_admissible(tokens);
+        if (likely(try_acquire(tokens))) {
+            return ss::make_ready_future<>();
+        }
+        ++_waits;
+        return ss::repeat([this, tokens] {
+            return ss::sleep(delay_for(tokens)).then([this, tokens] {
+                return try_acquire(tokens) ? ss::stop_iteration::yes
+                                           : ss::stop_iteration::no;
+            });
+        });
+    }
+
+private:
+    size_t max_admissible(size_t tokens) const noexcept {
+        for (const auto* b = this; b != nullptr; b = b->_parent) {
+            if (b->_rate != 0) {
+                tokens = std::min(tokens, b->_burst);
+            }
+        }
+        return tokens;
+    }
+
+    /// sleep long enough for the worst deficit on the chain to refill,
+    /// floored at the lowres clock granularity
+    clock::duration delay_for(size_t tokens) const noexcept {
+        std::chrono::microseconds d{1000};
+        for (const auto* b = this; b != nullptr; b = b->_parent) {
+            if (b->_rate == 0 || b->_tokens >= tokens) {
+                continue;
+            }
+            uint64_t deficit = tokens - b->_tokens;
+            d = std::max(
+              d, std::chrono::microseconds(deficit * 1'000'000 / b->_rate));
+        }
+        return std::chrono::duration_cast<clock::duration>(d);
+    }
+
+    void refill() noexcept {
+        if (_rate == 0) {
+            return;
+        }
+        auto now = clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+          now - _last_refill);
+        uint64_t add = uint64_t(_rate) * elapsed.count() / 1'000'000;
+        if (add == 0) {
+            // keep _last_refill so sub-token intervals accrue
+            return;
+        }
+        _tokens = std::min(_burst, _tokens + add);
+        _last_refill = now;
+    }
+
+    ss::sstring _name;
+    token_bucket* _parent;
+    size_t _rate{0};
+    size_t _burst{0};
+    size_t _tokens{0};
+    clock::time_point _last_refill;
+    uint64_t _acquired{0};
+    uint64_t _waits{0};
+};
+
+/**
+ * Shard-local bucket tree for background work: one root carved from
+ * the node budget with a child per subsystem, so background I/O as a
+ * whole is capped even when individual subsystem limits allow more.
+ *
+ * Node-wide rates are split evenly across shards, keeping the fast
+ * path free of cross-shard coordination. All rates default to zero
+ * (disabled) until start() applies the configured values.
+ */
+class background_throttle {
+public:
+    struct rates {
+        size_t total{0};
+        size_t recovery{0};
+        size_t compaction{0};
+        size_t archival_fetch{0};
+    };
+
+    background_throttle()
+      : _root("background", 0)
+      , _recovery("raft_recovery", 0, &_root)
+      , _compaction("compaction", 0, &_root)
+      , _archival_fetch("archival_fetch", 0, &_root) {}
+
+    void start(rates r) {
+        _root.set_rate(r.total);
+        _recovery.set_rate(r.recovery);
+        _compaction.set_rate(r.compaction);
+        _archival_fetch.set_rate(r.archival_fetch);
+        setup_metrics();
+    }
+
+    token_bucket& recovery() { return _recovery; }
+    token_bucket& compaction() { return _compaction; }
+    token_bucket& archival_fetch() { return _archival_fetch; }
+
+    /// node-wide rate divided across shards; zero stays unlimited
+    static size_t per_shard(size_t node_rate) {
+        return node_rate == 0
+                 ? 0
+                 : std::max<size_t>(1, node_rate / ss::smp::count);
+    }
+
+    static background_throttle& shard_local() {
+        static thread_local background_throttle t;
+        return t;
+    }
+
+private:
+    void setup_metrics() {
+        if (config::shard_local_cfg().disable_metrics()) {
+            return;
+        }
+        namespace sm = ss::metrics;
+        auto subsystem_label = sm::label("subsystem");
+        for (auto* b :
+             {&_root, &_recovery, &_compaction, &_archival_fetch}) {
+            std::vector<sm::label_instance> labels = {
+              subsystem_label(b->name())};
+            _metrics.add_group(
+              prometheus_sanitize::metrics_name("throttle"),
+              {sm::make_total_bytes(
+                 "acquired_bytes",
+                 [b] { return b->acquired(); },
+                 sm::description("Bytes admitted through the throttle"),
+                 labels),
+               sm::make_total_operations(
+                 "waits",
+                 [b] { return b->waits(); },
+                 sm::description("Times an acquisition had to wait"),
+                 labels)});
+        }
+    }
+
+    token_bucket _root;
+    token_bucket _recovery;
+    token_bucket _compaction;
+    token_bucket _archival_fetch;
+    ss::metrics::metric_groups _metrics;
+};
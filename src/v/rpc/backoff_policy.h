@@ -31,12 +31,27 @@ public:
 
         virtual void reset() = 0;
 
+        /// deep copy, allows one policy to seed a pool of connections
+        virtual std::unique_ptr<impl> clone() const = 0;
+
         virtual ~impl() noexcept = default;
     };
 
     explicit backoff_policy(std::unique_ptr<impl> i)
       : _impl(std::move(i)) {}
 
+    backoff_policy(const backoff_policy& o)
+      : _impl(o._impl->clone()) {}
+    backoff_policy& operator=(const backoff_policy& o) {
+        if (this != &o) {
+            _impl = o._impl->clone();
+        }
+        return *this;
+    }
+    backoff_policy(backoff_policy&&) noexcept = default;
+    backoff_policy& operator=(backoff_policy&&) noexcept = default;
+    ~backoff_policy() noexcept = default;
+
     void next_backoff() { _impl->next_backoff(); }
 
     std::chrono::milliseconds current_backoff_duration() {
@@ -77,6 +92,10 @@ backoff_policy make_exponential_backoff_policy(
 
         void reset() final { _current = 0; }
 
+        std::unique_ptr<backoff_policy::impl> clone() const final {
+            return std::make_unique<policy>(*this);
+        }
+
     private:
         DurationType _base_duration;
         DurationType _max_backoff;
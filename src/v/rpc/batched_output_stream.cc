@@ -18,10 +18,13 @@
 
 namespace rpc {
 batched_output_stream::batched_output_stream(
-  ss::output_stream<char> o, size_t cache)
+  ss::output_stream<char> o, size_t cache, std::chrono::microseconds delay)
   : _out(std::move(o))
   , _cache_size(cache)
-  , _write_sem(std::make_unique<ss::semaphore>(1)) {}
+  , _flush_delay(delay)
+  , _write_sem(std::make_unique<ss::semaphore>(1)) {
+    _flush_timer.set_callback([this] { background_flush(); });
+}
 
 [[gnu::cold]] static ss::future<>
 already_closed_error(ss::scattered_message<char>& msg) {
@@ -42,21 +45,37 @@ ss::future<> batched_output_stream::write(ss::scattered_message<char> msg) {
           const size_t vbytes = v.size();
           return _out.write(std::move(v)).then([this, vbytes] {
               _unflushed_bytes += vbytes;
-              if (
-                _write_sem->waiters() == 0 || _unflushed_bytes >= _cache_size) {
+              if (_unflushed_bytes >= _cache_size) {
                   return do_flush();
               }
+              if (_write_sem->waiters() == 0) {
+                  if (_flush_delay == std::chrono::microseconds(0)) {
+                      return do_flush();
+                  }
+                  // the stream is idle; hold the flush for up to
+                  // _flush_delay so closely spaced writes ride in the
+                  // same packet
+                  if (!_flush_timer.armed()) {
+                      _flush_timer.arm(_flush_delay);
+                  }
+              }
               return ss::make_ready_future<>();
           });
       });
 }
 ss::future<> batched_output_stream::do_flush() {
+    _flush_timer.cancel();
     if (_unflushed_bytes == 0) {
         return ss::make_ready_future<>();
     }
     _unflushed_bytes = 0;
     return _out.flush();
 }
+void batched_output_stream::background_flush() {
+    // harmless after stop(): writes are rejected once closed, so
+    // _unflushed_bytes is zero and do_flush is a no-op
+    (void)ss::with_semaphore(*_write_sem, 1, [this] { return do_flush(); });
+}
 ss::future<> batched_output_stream::flush() {
     return ss::with_semaphore(*_write_sem, 1, [this] { return do_flush(); });
 }
@@ -65,6 +84,7 @@ ss::future<> batched_output_stream::stop() {
         return ss::make_ready_future<>();
     }
     _closed = true;
+    _flush_timer.cancel();
     return ss::with_semaphore(*_write_sem, 1, [this] {
         return do_flush().then([this] { return _out.close(); });
     });
@@ -15,7 +15,9 @@
 
 #include <seastar/core/iostream.hh>
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/timer.hh>
 
+#include <chrono>
 #include <cstdint>
 
 namespace rpc {
@@ -27,15 +29,23 @@ public:
 
     batched_output_stream() = default;
     explicit batched_output_stream(
-      ss::output_stream<char>, size_t cache = default_max_unflushed_bytes);
+      ss::output_stream<char>,
+      size_t cache = default_max_unflushed_bytes,
+      std::chrono::microseconds flush_delay = std::chrono::microseconds(0));
     ~batched_output_stream() noexcept = default;
     // NOTE: explicitly defined for a gcc
     batched_output_stream(batched_output_stream&& o) noexcept
       : _out(std::move(o._out))
       , _cache_size(o._cache_size)
+      , _flush_delay(o._flush_delay)
       , _write_sem(std::move(o._write_sem))
       , _unflushed_bytes(o._unflushed_bytes)
-      , _closed(o._closed) {}
+      , _closed(o._closed) {
+        // the timer callback captures this, it cannot be moved. a flush
+        // held by the source stream happens on the next write or flush
+        o._flush_timer.cancel();
+        _flush_timer.set_callback([this] { background_flush(); });
+    }
     batched_output_stream& operator=(batched_output_stream&& o) noexcept {
         if (this != &o) {
             this->~batched_output_stream();
@@ -55,11 +65,17 @@ public:
 
 private:
     ss::future<> do_flush();
+    void background_flush();
 
     ss::output_stream<char> _out;
     size_t _cache_size{0};
+    // writes are held for up to this long while the stream is idle so
+    // that closely spaced writes coalesce into fewer packets, zero
+    // flushes as soon as there is no concurrent writer
+    std::chrono::microseconds _flush_delay{0};
     std::unique_ptr<ss::semaphore> _write_sem;
     size_t _unflushed_bytes{0};
     bool _closed = false;
+    ss::timer<> _flush_timer;
 };
 } // namespace rpc
@@ -31,7 +31,11 @@ class connection_cache final
   : public ss::peering_sharded_service<connection_cache> {
 public:
     using transport_ptr = ss::lw_shared_ptr<rpc::reconnect_transport>;
-    using underlying = std::unordered_map<model::node_id, transport_ptr>;
+    // lanes to one peer, consistent-hash selected so that a raft group
+    // always replicates over the same connection but different groups do
+    // not serialize behind each other
+    using connection_pool = std::vector<transport_ptr>;
+    using underlying = std::unordered_map<model::node_id, connection_pool>;
     using iterator = typename underlying::iterator;
 
     static inline ss::shard_id shard_for(
@@ -40,11 +44,15 @@ public:
       model::node_id node,
       ss::shard_id max_shards = ss::smp::count);
 
-    connection_cache() = default;
+    explicit connection_cache(size_t connections_per_peer = 1)
+      : _connections_per_peer(std::max<size_t>(1, connections_per_peer)) {}
     bool contains(model::node_id n) const {
         return _cache.find(n) != _cache.end();
     }
-    transport_ptr get(model::node_id n) const { return _cache.find(n)->second; }
+    transport_ptr get(model::node_id n, size_t lane_hint = 0) const {
+        const auto& pool = _cache.find(n)->second;
+        return pool[jump_consistent_hash(lane_hint, pool.size())];
+    }
 
     /// \brief needs to be a future, because mutations may come from different
     /// fibers and they need to be synchronized
@@ -68,21 +76,41 @@ public:
         ss::shard_id src_shard,
         model::node_id node_id,
         Func&& f) {
+        return with_node_client<Protocol>(
+          self, src_shard, node_id, 0, std::forward<Func>(f));
+    }
+
+    /// \brief variant with an explicit lane hint - callers that know which
+    /// raft group a request belongs to pass the group id so the group
+    /// always uses the same connection of the peer's pool
+    template<typename Protocol, typename Func>
+    // clang-format off
+    CONCEPT(requires requires(Func&& f, Protocol proto) {
+        f(proto);
+    })
+      // clang-format on
+      auto with_node_client(
+        model::node_id self,
+        ss::shard_id src_shard,
+        model::node_id node_id,
+        size_t lane_hint,
+        Func&& f) {
         using ret_t = result_wrap_t<std::invoke_result_t<Func, Protocol>>;
         auto shard = rpc::connection_cache::shard_for(self, src_shard, node_id);
 
         return container().invoke_on(
           shard,
-          [node_id,
-           f = std::forward<Func>(f)](rpc::connection_cache& cache) mutable {
+          [node_id, lane_hint, f = std::forward<Func>(f)](
+            rpc::connection_cache& cache) mutable {
               if (!cache.contains(node_id)) {
                   // No client available
                   return ss::futurize<ret_t>::convert(
                     rpc::make_error_code(errc::missing_node_rpc_client));
               }
-              return cache.get(node_id)->get_connected().then(
-                [f = std::forward<Func>(f)](
-                  result<rpc::transport*> transport) mutable {
+              return cache.get(node_id, lane_hint)
+                ->get_connected()
+                .then([f = std::forward<Func>(f)](
+                        result<rpc::transport*> transport) mutable {
                     if (!transport) {
                         // Connection error
                         return ss::futurize<ret_t>::convert(transport.error());
@@ -95,6 +123,7 @@ public:
 
 private:
     ss::semaphore _sem{1}; // to add/remove nodes
+    size_t _connections_per_peer;
     underlying _cache;
 };
 inline ss::shard_id connection_cache::shard_for(
@@ -41,9 +41,24 @@ static inline void check_out_of_range(size_t got, size_t expected) {
 }
 } // namespace detail
 
+/// Reads a frame payload whose size is already known from the header into
+/// a single right-sized buffer. read_iobuf_exactly accumulates whatever
+/// chunk sizes the connection buffer produces and packs small ones into
+/// growing fragments; here the stream fills one allocation and the
+/// checksum and parser then run over contiguous memory
+inline ss::future<iobuf>
+read_frame_payload(ss::input_stream<char>& in, size_t payload_size) {
+    return in.read_exactly(payload_size)
+      .then([](ss::temporary_buffer<char> buf) {
+          iobuf io;
+          io.append(std::move(buf));
+          return io;
+      });
+}
+
 inline ss::future<std::optional<header>>
 parse_header(ss::input_stream<char>& in) {
-    return read_iobuf_exactly(in, size_of_rpc_header).then([](iobuf b) {
+    return read_frame_payload(in, size_of_rpc_header).then([](iobuf b) {
         if (b.size_bytes() != size_of_rpc_header) {
             return ss::make_ready_future<std::optional<header>>();
         }
@@ -92,7 +107,7 @@ ss::future<T> parse_type_wihout_compression(iobuf io) {
 
 template<typename T>
 ss::future<T> parse_type(ss::input_stream<char>& in, const header& h) {
-    return read_iobuf_exactly(in, h.payload_size).then([h](iobuf io) {
+    return read_frame_payload(in, h.payload_size).then([h](iobuf io) {
         validate_payload_and_header(io, h);
         if (h.compression == compression_type::none) {
             return rpc::parse_type_wihout_compression<T>(std::move(io));
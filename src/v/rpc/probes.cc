@@ -71,6 +71,13 @@ void server_probe::setup_metrics(
           [this] { return _requests_blocked_memory; },
           sm::description(fmt::format(
             "{}: Number of requests blocked in memory backpressure", proto))),
+        sm::make_derive(
+          "requests_blocked_connection_memory",
+          [this] { return _requests_blocked_conn_memory; },
+          sm::description(fmt::format(
+            "{}: Number of requests blocked on the per-connection in flight "
+            "byte budget",
+            proto))),
         sm::make_gauge(
           "requests_pending",
           [this] { return _requests_received - _requests_completed; },
@@ -89,7 +96,9 @@ std::ostream& operator<<(std::ostream& o, const server_probe& p) {
       << "sent bytes: " << p._out_bytes << ", "
       << "corrupted headers: " << p._corrupted_headers << ", "
       << "method not found errors: " << p._method_not_found_errors << ", "
-      << "requests blocked by memory: " << p._requests_blocked_memory << "}";
+      << "requests blocked by memory: " << p._requests_blocked_memory << ", "
+      << "requests blocked by connection memory: "
+      << p._requests_blocked_conn_memory << "}";
     return o;
 }
 
@@ -15,6 +15,7 @@
 #include "rpc/exceptions.h"
 #include "rpc/types.h"
 #include "utils/concepts-enabled.h"
+#include "utils/timing_wheel.h"
 
 #include <seastar/core/future.hh>
 
@@ -24,7 +25,6 @@ class response_handler {
 public:
     using response_ptr = result<std::unique_ptr<streaming_context>>;
     using promise_t = ss::promise<response_ptr>;
-    using timer_ptr = std::unique_ptr<rpc::timer_type>;
 
     response_handler() noexcept = default;
     ~response_handler() noexcept = default;
@@ -41,11 +41,14 @@ public:
     // clang-format on
     void with_timeout(
       rpc::clock_type::time_point timeout, Func&& timeout_action) {
-        _timeout_timer = std::make_unique<rpc::timer_type>(
+        _timeout_entry.set_callback(
           [this, f = std::forward<Func>(timeout_action)]() mutable {
               complete_with_timeout(std::forward<Func>(f));
           });
-        _timeout_timer->arm(timeout);
+        // every in-flight request on this shard shares one timing wheel;
+        // arming and cancelling are list links, not timer-heap updates
+        timing_wheel<rpc::clock_type>::shard_local().arm(
+          _timeout_entry, timeout);
     }
 
     ss::future<response_ptr> get_future() { return _promise.get_future(); }
@@ -67,13 +70,9 @@ private:
         _promise.set_value(response_ptr(rpc::errc::client_request_timeout));
         timeout_action();
     }
-    void maybe_cancel_timer() {
-        if (_timeout_timer && _timeout_timer->armed()) {
-            _timeout_timer->cancel();
-        }
-    }
+    void maybe_cancel_timer() { _timeout_entry.cancel(); }
     promise_t _promise;
-    timer_ptr _timeout_timer;
+    timing_wheel<rpc::clock_type>::entry _timeout_entry;
 };
 } // namespace internal
 } // namespace rpc
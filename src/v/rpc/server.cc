@@ -29,8 +29,20 @@ namespace rpc {
 server::server(server_configuration c)
   : cfg(std::move(c))
   , _memory(cfg.max_service_memory_per_core)
+  , _service_memory(cfg.max_service_memory_per_core)
   , _creds(cfg.credentials) {}
 
+void server::set_service_memory(size_t grant) {
+    if (grant > _service_memory) {
+        _memory.signal(grant - _service_memory);
+    } else if (grant < _service_memory) {
+        // consume may drive the semaphore negative; admission resumes
+        // once in-flight requests release enough units
+        _memory.consume(_service_memory - grant);
+    }
+    _service_memory = grant;
+}
+
 server::~server() = default;
 
 void server::start() {
@@ -61,10 +73,23 @@ void server::start() {
         }
         auto& b = _listeners.emplace_back(
           std::make_unique<listener>(endpoint.name, std::move(ss)));
+        _listener_hists.emplace(endpoint.name, std::make_unique<hdr_hist>());
         listener& ref = *b;
         // background
         (void)with_gate(_conn_gate, [this, &ref] { return accept(ref); });
     }
+    if (!cfg.disable_metrics) {
+        setup_listener_metrics();
+    }
+}
+
+hdr_hist& server::hist_for(const ss::sstring& listener_name) {
+    auto it = _listener_hists.find(listener_name);
+    vassert(
+      it != _listener_hists.end(),
+      "no histogram for listener \"{}\"",
+      listener_name);
+    return *it->second;
 }
 
 // inline to get more context
@@ -164,17 +189,40 @@ void server::setup_metrics() {
       prometheus_sanitize::metrics_name(cfg.name),
       {sm::make_total_bytes(
          "max_service_mem_bytes",
-         [this] { return cfg.max_service_memory_per_core; },
+         [this] { return _service_memory; },
          sm::description(
            fmt::format("{}: Maximum memory allowed for RPC", cfg.name))),
        sm::make_total_bytes(
          "consumed_mem_bytes",
-         [this] { return cfg.max_service_memory_per_core - _memory.current(); },
+         [this] { return consumed_service_memory(); },
          sm::description(
            fmt::format("{}: Memory consumed by request processing", cfg.name))),
        sm::make_histogram(
          "dispatch_handler_latency",
          [this] { return _hist.seastar_histogram_logform(); },
-         sm::description(fmt::format("{}: Latency ", cfg.name)))});
+         sm::description(fmt::format("{}: Latency ", cfg.name))),
+       sm::make_histogram(
+         "request_queue_latency",
+         [this] { return _queue_hist.seastar_histogram_logform(); },
+         sm::description(fmt::format(
+           "{}: Time requests wait for memory admission before processing",
+           cfg.name)))});
+}
+
+void server::setup_listener_metrics() {
+    namespace sm = ss::metrics;
+    auto listener_label = sm::label("listener");
+    for (auto& [name, hist] : _listener_hists) {
+        std::vector<sm::label_instance> labels = {listener_label(name)};
+        _metrics.add_group(
+          prometheus_sanitize::metrics_name(cfg.name),
+          {sm::make_histogram(
+            "listener_dispatch_latency",
+            [h = hist.get()] { return h->seastar_histogram_logform(); },
+            sm::description(fmt::format(
+              "{}: Dispatch latency of a single listener endpoint",
+              cfg.name)),
+            labels)});
+    }
 }
 } // namespace rpc
@@ -14,12 +14,14 @@
 #include "rpc/connection.h"
 #include "rpc/types.h"
 #include "utils/hdr_hist.h"
+#include "utils/log_hist.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/semaphore.hh>
 
+#include <absl/container/flat_hash_map.h>
 #include <boost/intrusive/list.hpp>
 
 #include <list>
@@ -43,6 +45,11 @@ public:
         server_probe& probe() { return _s->_probe; }
         ss::semaphore& memory() { return _s->_memory; }
         hdr_hist& hist() { return _s->_hist; }
+        /// latency histogram of the listener this connection arrived on,
+        /// so tail latency is visible per endpoint instead of only as a
+        /// server-wide blend
+        hdr_hist& listener_hist() { return _s->hist_for(conn->name()); }
+        log_hist& queue_hist() { return _s->_queue_hist; }
         ss::gate& conn_gate() { return _s->_conn_gate; }
         ss::abort_source& abort_source() { return _s->_as; }
         bool abort_requested() const { return _s->_as.abort_requested(); }
@@ -79,6 +86,21 @@ public:
 
     const server_configuration cfg; // NOLINT
     const hdr_hist& histogram() const { return _hist; }
+    const server_probe& probe() const { return _probe; }
+
+    /// current service memory grant. starts at the configured per-core
+    /// maximum and moves when the memory arbiter resizes this server
+    size_t service_memory() const { return _service_memory; }
+    /// bytes of the grant currently held by in-flight requests
+    size_t consumed_service_memory() const {
+        auto available = _memory.current();
+        return available >= _service_memory ? 0
+                                            : _service_memory - available;
+    }
+    /// apply a new service memory grant. shrinking consumes semaphore
+    /// units immediately, pushing admission back until usage drains
+    /// below the new grant
+    void set_service_memory(size_t grant);
 
 private:
     struct listener {
@@ -93,14 +115,25 @@ private:
     friend resources;
     ss::future<> accept(listener&);
     void setup_metrics();
+    void setup_listener_metrics();
+    hdr_hist& hist_for(const ss::sstring& listener_name);
 
     std::unique_ptr<protocol> _proto;
     ss::semaphore _memory;
+    size_t _service_memory;
     std::vector<std::unique_ptr<listener>> _listeners;
     boost::intrusive::list<connection> _connections;
     ss::abort_source _as;
     ss::gate _conn_gate;
     hdr_hist _hist;
+    // dispatch latency broken out by listener endpoint; keyed by the
+    // listener name handed to each accepted connection
+    absl::flat_hash_map<ss::sstring, std::unique_ptr<hdr_hist>>
+      _listener_hists;
+    // time requests spend queued on the memory semaphore before their
+    // handler may run - the server's admission queue under overload.
+    // recorded per request, hence the cheap fixed-bucket histogram
+    log_hist _queue_hist;
     server_probe _probe;
     ss::metrics::metric_groups _metrics;
     ss::shared_ptr<ss::tls::server_credentials> _creds;
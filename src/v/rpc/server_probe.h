@@ -46,6 +46,12 @@ public:
 
     void waiting_for_available_memory() { ++_requests_blocked_memory; }
 
+    uint32_t requests_blocked_memory() const {
+        return _requests_blocked_memory;
+    }
+
+    void waiting_for_connection_memory() { ++_requests_blocked_conn_memory; }
+
     void setup_metrics(ss::metrics::metric_groups& mgs, const char* name);
 
 private:
@@ -60,6 +66,7 @@ private:
     uint32_t _corrupted_headers = 0;
     uint32_t _method_not_found_errors = 0;
     uint32_t _requests_blocked_memory = 0;
+    uint32_t _requests_blocked_conn_memory = 0;
     friend std::ostream& operator<<(std::ostream& o, const server_probe& p);
 };
 
@@ -21,6 +21,7 @@
 #include <seastar/core/scheduling.hh>
 
 #include <cstdint>
+#include <vector>
 
 namespace rpc {
 
@@ -35,6 +36,10 @@ struct service {
     virtual ss::smp_service_group& get_smp_service_group() = 0;
     /// \brief return nullptr when method not found
     virtual method* method_from_id(uint32_t) = 0;
+    /// \brief every method id this service serves. used by the protocol to
+    /// index handlers once at registration instead of probing each service
+    /// per request
+    virtual std::vector<uint32_t> method_ids() const = 0;
 };
 
 class rpc_internal_body_parsing_exception : public std::exception {
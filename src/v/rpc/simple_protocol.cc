@@ -22,7 +22,8 @@ struct server_context_impl final : streaming_context {
       : res(std::move(s))
       , hdr(h) {}
     ss::future<ss::semaphore_units<>> reserve_memory(size_t ask) final {
-        auto fut = get_units(res.memory(), ask);
+        auto fut = get_units(res.memory(), ask)
+                     .finally([m = res.queue_hist().auto_measure()] {});
         if (res.memory().waiters()) {
             res.probe().waiting_for_available_memory();
         }
@@ -90,13 +91,8 @@ simple_protocol::dispatch_method_once(header h, server::resources rs) {
 
     // background!
     (void)with_gate(rs.conn_gate(), [this, method_id, rs, ctx]() mutable {
-        auto it = std::find_if(
-          _services.begin(),
-          _services.end(),
-          [method_id](std::unique_ptr<service>& srvc) {
-              return srvc->method_from_id(method_id) != nullptr;
-          });
-        if (unlikely(it == _services.end())) {
+        method* m = lookup_method(method_id);
+        if (unlikely(m == nullptr)) {
             rs.probe().method_not_found();
             netbuf reply_buf;
             reply_buf.set_status(rpc::status::method_not_found);
@@ -105,11 +101,12 @@ simple_protocol::dispatch_method_once(header h, server::resources rs) {
             });
         }
 
-        method* m = it->get()->method_from_id(method_id);
-
         return (*m)(ctx->res.conn->input(), *ctx)
-          .then_wrapped([ctx, m = ctx->res.hist().auto_measure(), rs](
-                          ss::future<netbuf> fut) mutable {
+          .then_wrapped([ctx,
+                         m = ctx->res.hist().auto_measure(),
+                         lm = hdr_hist::measurement(
+                           ctx->res.listener_hist()),
+                         rs](ss::future<netbuf> fut) mutable {
               netbuf reply_buf;
               try {
                   reply_buf = fut.get0();
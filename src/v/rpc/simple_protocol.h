@@ -13,13 +13,24 @@
 #include "rpc/netbuf.h"
 #include "rpc/server.h"
 #include "rpc/service.h"
+#include "vassert.h"
+
+#include <absl/container/flat_hash_map.h>
+
 namespace rpc {
 class simple_protocol final : public server::protocol {
 public:
     template<typename T, typename... Args>
     void register_service(Args&&... args) {
         static_assert(std::is_base_of_v<service, T>, "must extend service.h");
-        _services.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+        auto svc = std::make_unique<T>(std::forward<Args>(args)...);
+        // index every handler up front so dispatch is a single lookup
+        // instead of a per-request probe of each registered service
+        for (auto id : svc->method_ids()) {
+            auto [_, success] = _methods.emplace(id, svc->method_from_id(id));
+            vassert(success, "rpc method id collision: {}", id);
+        }
+        _services.push_back(std::move(svc));
     }
 
     const char* name() const final {
@@ -30,7 +41,17 @@ public:
 private:
     ss::future<> dispatch_method_once(header, server::resources);
 
+    /// \brief return nullptr when method not found
+    method* lookup_method(uint32_t id) const {
+        auto it = _methods.find(id);
+        return it == _methods.end() ? nullptr : it->second;
+    }
+
     std::vector<std::unique_ptr<service>> _services;
+    // method id -> handler. the ids are crc32-derived, so a dense array
+    // indexed by id is not an option, but the flat map keeps the lookup
+    // O(1) regardless of how many services are registered
+    absl::flat_hash_map<uint32_t, method*> _methods;
 };
 
 } // namespace rpc
@@ -0,0 +1,74 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "rpc/stream_pipe.h"
+
+#include "vassert.h"
+
+#include <seastar/core/future.hh>
+
+namespace rpc {
+
+ss::future<> stream_pipe::write(iobuf b) {
+    vassert(!_closed, "write on closed stream_pipe");
+    // clamp so a chunk larger than the whole budget is admitted alone
+    // instead of deadlocking on capacity it can never acquire
+    const size_t units = std::min(b.size_bytes(), _max_buffered);
+    return _capacity.wait(units).then(
+      [this, b = std::move(b), units]() mutable {
+          size_t u = units;
+          while (b.begin() != b.end()) {
+              auto data = b.begin()->share();
+              b.pop_front();
+              _chunks.push_back(chunk{std::move(data), std::exchange(u, 0)});
+          }
+          if (_reader) {
+              _reader->set_value();
+              _reader.reset();
+          }
+      });
+}
+
+void stream_pipe::close() {
+    _closed = true;
+    if (_reader) {
+        _reader->set_value();
+        _reader.reset();
+    }
+}
+
+ss::future<ss::temporary_buffer<char>> stream_pipe::pop() {
+    if (!_chunks.empty()) {
+        auto c = std::move(_chunks.front());
+        _chunks.pop_front();
+        _capacity.signal(c.units);
+        return ss::make_ready_future<ss::temporary_buffer<char>>(
+          std::move(c.data));
+    }
+    if (_closed) {
+        // empty buffer signals end of stream
+        return ss::make_ready_future<ss::temporary_buffer<char>>();
+    }
+    _reader.emplace();
+    return _reader->get_future().then([this] { return pop(); });
+}
+
+struct stream_pipe::pipe_source final : ss::data_source_impl {
+    explicit pipe_source(stream_pipe* p)
+      : pipe(p) {}
+    ss::future<ss::temporary_buffer<char>> get() final { return pipe->pop(); }
+    stream_pipe* pipe;
+};
+
+ss::input_stream<char> stream_pipe::as_input_stream() {
+    return ss::input_stream<char>(
+      ss::data_source(std::make_unique<pipe_source>(this)));
+}
+
+} // namespace rpc
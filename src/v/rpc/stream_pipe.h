@@ -0,0 +1,77 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "seastarx.h"
+
+#include <seastar/core/iostream.hh>
+#include <seastar/core/semaphore.hh>
+
+#include <deque>
+#include <optional>
+
+namespace rpc {
+
+/// \brief single producer, single consumer byte pipe with bounded
+/// buffering. building block for chunked transfers - recovery, snapshot
+/// transfer - that must not materialize the full payload in memory.
+///
+/// the producer pushes iobuf chunks with write() and is suspended once
+/// max_buffered_bytes are in flight, resuming as the consumer drains. the
+/// consumer side is surfaced as a regular ss::input_stream so existing
+/// parsers work unchanged. chunks are moved fragment by fragment, never
+/// copied. the pipe must outlive the input_stream handed out by
+/// as_input_stream().
+class stream_pipe {
+public:
+    static constexpr size_t default_max_buffered_bytes = 128 * 1024;
+
+    explicit stream_pipe(size_t max_buffered = default_max_buffered_bytes)
+      : _max_buffered(max_buffered)
+      , _capacity(max_buffered) {}
+    stream_pipe(stream_pipe&&) = delete;
+    stream_pipe& operator=(stream_pipe&&) = delete;
+    stream_pipe(const stream_pipe&) = delete;
+    stream_pipe& operator=(const stream_pipe&) = delete;
+
+    /// \brief push one chunk; resolves once the chunk fits in the buffer
+    /// budget. a chunk larger than the budget is admitted alone so it
+    /// still makes progress
+    ss::future<> write(iobuf);
+
+    /// \brief no more writes; the reader sees end of stream after
+    /// draining buffered chunks
+    void close();
+
+    /// \brief consumer side of the pipe. call at most once
+    ss::input_stream<char> as_input_stream();
+
+private:
+    struct chunk {
+        ss::temporary_buffer<char> data;
+        // capacity units released when this chunk is consumed; a
+        // multi-fragment write charges its first chunk
+        size_t units;
+    };
+    struct pipe_source;
+
+    ss::future<ss::temporary_buffer<char>> pop();
+
+    size_t _max_buffered;
+    ss::semaphore _capacity;
+    std::deque<chunk> _chunks;
+    std::optional<ss::promise<>> _reader;
+    bool _closed{false};
+};
+
+} // namespace rpc
@@ -0,0 +1,196 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+//
+// rpc_bench: loopback echo benchmark over the real rpc::transport /
+// rpc::server stack. Sweeps payload sizes and connection counts -
+// optionally twice, plaintext and TLS - and emits one JSON line per
+// matrix cell so results can be diffed across networking changes.
+
+#include "rpc/test/rpc_integration_fixture.h"
+#include "utils/hdr_hist.h"
+#include "vlog.h"
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/defer.hh>
+
+#include <boost/range/irange.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+static ss::logger blgr{"rpc_bench"};
+
+void cli_opts(boost::program_options::options_description_easy_init o) {
+    namespace po = boost::program_options;
+    o("port", po::value<uint16_t>()->default_value(32148), "loopback port");
+    o("requests",
+      po::value<std::size_t>()->default_value(2000),
+      "requests per matrix cell");
+    o("concurrency",
+      po::value<std::size_t>()->default_value(32),
+      "in-flight requests per connection");
+    o("max-connections",
+      po::value<std::size_t>()->default_value(4),
+      "sweep connection counts in powers of two up to this");
+    o("cert",
+      po::value<std::string>()->default_value(""),
+      "server certificate; providing cert, key and ca-cert adds a TLS pass");
+    o("key", po::value<std::string>()->default_value(""), "server key");
+    o("ca-cert",
+      po::value<std::string>()->default_value(""),
+      "certificate authority the client trusts");
+}
+
+namespace {
+
+// the classic short-request/streaming-payload spread
+constexpr std::array<std::size_t, 5> payload_sizes
+  = {64, 4096, 131072, 1 << 20, 4 << 20};
+
+struct bench_cfg {
+    std::size_t requests;
+    std::size_t concurrency;
+    std::size_t max_connections;
+    bool tls{false};
+};
+
+using client_t = rpc::client<echo::echo_client_protocol>;
+
+void run_cell(
+  rpc_simple_integration_fixture& fixture,
+  const std::optional<ss::tls::credentials_builder>& client_creds,
+  const bench_cfg& cfg,
+  std::size_t payload_size,
+  std::size_t connections) {
+    std::vector<std::unique_ptr<client_t>> clients;
+    clients.reserve(connections);
+    for (std::size_t i = 0; i < connections; ++i) {
+        clients.push_back(
+          std::make_unique<client_t>(fixture.client_config(client_creds)));
+    }
+    for (auto& c : clients) {
+        c->connect().get();
+    }
+    auto stop_clients = ss::defer([&clients] {
+        for (auto& c : clients) {
+            c->stop().get();
+        }
+    });
+
+    const auto per_fiber = std::max<std::size_t>(
+      cfg.requests / (connections * cfg.concurrency), 1);
+    const auto total = per_fiber * connections * cfg.concurrency;
+    const ss::sstring payload(payload_size, 'x');
+
+    hdr_hist hist;
+    const auto start = std::chrono::steady_clock::now();
+    ss::parallel_for_each(
+      clients.begin(),
+      clients.end(),
+      [&](std::unique_ptr<client_t>& c) {
+          return ss::parallel_for_each(
+            boost::irange(std::size_t(0), cfg.concurrency),
+            [&, cli = c.get()](std::size_t) {
+                return ss::do_for_each(
+                  boost::irange(std::size_t(0), per_fiber), [&, cli](size_t) {
+                      return cli
+                        ->echo(
+                          echo::echo_req{.str = payload},
+                          rpc::client_opts(rpc::no_timeout))
+                        .then([m = hist.auto_measure()](auto r) {
+                            if (!r) {
+                                throw std::runtime_error(fmt::format(
+                                  "echo failed: {}", r.error().message()));
+                            }
+                        });
+                  });
+            });
+      })
+      .get();
+    const auto elapsed
+      = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+
+    // one self-describing JSON object per line; echo moves the payload
+    // both ways, hence the factor of two in throughput
+    fmt::print(
+      "{{\"payload_bytes\": {}, \"connections\": {}, \"concurrency\": {}, "
+      "\"tls\": {}, \"requests\": {}, \"p50_us\": {}, \"p95_us\": {}, "
+      "\"p99_us\": {}, \"max_us\": {}, \"mean_us\": {:.1f}, "
+      "\"throughput_mb_per_sec\": {:.2f}}}\n",
+      payload_size,
+      connections,
+      cfg.concurrency,
+      cfg.tls,
+      total,
+      hist.get_value_at(50.0),
+      hist.get_value_at(95.0),
+      hist.get_value_at(99.0),
+      hist.get_value_at(100.0),
+      hist.mean(),
+      2.0 * static_cast<double>(total * payload_size)
+        / (1024.0 * 1024.0)
+        / (static_cast<double>(std::max<int64_t>(elapsed, 1)) / 1'000'000.0));
+}
+
+void run_matrix(
+  uint16_t port,
+  const bench_cfg& cfg,
+  const std::optional<ss::tls::credentials_builder>& creds) {
+    rpc_simple_integration_fixture fixture(port);
+    fixture.configure_server(creds);
+    fixture.register_service<echo_impl>();
+    fixture.start_server();
+    auto stop = ss::defer([&fixture] { fixture.stop_server(); });
+
+    for (auto payload_size : payload_sizes) {
+        for (std::size_t conns = 1; conns <= cfg.max_connections; conns *= 2) {
+            run_cell(fixture, creds, cfg, payload_size, conns);
+        }
+    }
+}
+
+} // namespace
+
+int main(int args, char** argv, char** env) {
+    ss::app_template app;
+    cli_opts(app.add_options());
+    return app.run(args, argv, [&app] {
+        return ss::async([&app] {
+            auto& opts = app.configuration();
+            const auto port = opts["port"].as<uint16_t>();
+            bench_cfg cfg{
+              .requests = opts["requests"].as<std::size_t>(),
+              .concurrency = opts["concurrency"].as<std::size_t>(),
+              .max_connections = opts["max-connections"].as<std::size_t>(),
+            };
+
+            vlog(blgr.info, "plaintext pass");
+            run_matrix(port, cfg, std::nullopt);
+
+            const auto cert = opts["cert"].as<std::string>();
+            const auto key = opts["key"].as<std::string>();
+            const auto ca = opts["ca-cert"].as<std::string>();
+            if (!cert.empty() && !key.empty() && !ca.empty()) {
+                vlog(blgr.info, "tls pass");
+                auto creds = config::tls_config(
+                               true, config::key_cert{key, cert}, ca, false)
+                               .get_credentials_builder()
+                               .get0();
+                cfg.tls = true;
+                run_matrix(port, cfg, creds);
+            }
+            return 0;
+        });
+    });
+}
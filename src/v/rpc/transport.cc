@@ -18,6 +18,7 @@
 #include "vlog.h"
 
 #include <seastar/core/reactor.hh>
+#include <seastar/net/socket_defs.hh>
 
 #include <memory>
 #include <type_traits>
@@ -44,7 +45,8 @@ struct client_context_impl final : streaming_context {
 base_transport::base_transport(configuration c)
   : _server_addr(c.server_addr)
   , _creds(c.credentials)
-  , _tls_sni_hostname(c.tls_sni_hostname) {}
+  , _tls_sni_hostname(c.tls_sni_hostname)
+  , _flush_delay(c.flush_delay) {}
 
 transport::transport(
   transport_configuration c,
@@ -52,6 +54,7 @@ transport::transport(
   : base_transport(base_transport::configuration{
     .server_addr = std::move(c.server_addr),
     .credentials = std::move(c.credentials),
+    .flush_delay = c.flush_delay,
   })
   , _memory(c.max_queued_bytes) {
     if (!c.disable_metrics) {
@@ -67,12 +70,15 @@ ss::future<> base_transport::do_connect() {
           "cannot do_connect with a valid connection. remote:{}",
           server_address())));
     }
+    // unix domain sockets (used e.g. for the same-host coproc engine)
+    // need an AF_UNIX local address, everything else binds any v4 port
+    auto local_addr = server_address().u.sa.sa_family == AF_UNIX
+                        ? ss::socket_address{ss::unix_domain_addr{""}}
+                        : ss::socket_address(
+                          sockaddr_in{AF_INET, INADDR_ANY, {0}});
     return ss::engine()
       .net()
-      .connect(
-        server_address(),
-        ss::socket_address(sockaddr_in{AF_INET, INADDR_ANY, {0}}),
-        ss::transport::TCP)
+      .connect(server_address(), local_addr, ss::transport::TCP)
       .then([this](ss::connected_socket fd) mutable {
           if (_creds) {
               return ss::tls::wrap_client(
@@ -92,7 +98,10 @@ ss::future<> base_transport::do_connect() {
           }
           _probe.connection_established();
           _in = _fd->input();
-          _out = batched_output_stream(_fd->output());
+          _out = batched_output_stream(
+            _fd->output(),
+            batched_output_stream::default_max_unflushed_bytes,
+            _flush_delay);
       });
 }
 ss::future<> base_transport::connect() {
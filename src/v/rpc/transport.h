@@ -50,6 +50,7 @@ public:
         rpc::metrics_disabled disable_metrics = rpc::metrics_disabled::no;
         /// Optional server name indication (SNI) for TLS connection
         std::optional<ss::sstring> tls_sni_hostname;
+        std::chrono::microseconds flush_delay = std::chrono::microseconds(0);
     };
 
     explicit base_transport(configuration c);
@@ -82,6 +83,7 @@ private:
     ss::socket_address _server_addr;
     ss::shared_ptr<ss::tls::certificate_credentials> _creds;
     std::optional<ss::sstring> _tls_sni_hostname;
+    std::chrono::microseconds _flush_delay;
 };
 
 class transport final : public base_transport {
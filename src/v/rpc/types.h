@@ -212,6 +212,10 @@ struct transport_configuration {
     uint32_t max_queued_bytes = std::numeric_limits<uint32_t>::max();
     ss::shared_ptr<ss::tls::certificate_credentials> credentials;
     metrics_disabled disable_metrics = metrics_disabled::no;
+    /// \brief hold outgoing writes for up to this long while the stream
+    /// is idle so closely spaced requests coalesce into fewer packets.
+    /// zero (the default) flushes as soon as there is no concurrent writer
+    std::chrono::microseconds flush_delay = std::chrono::microseconds(0);
 };
 
 std::ostream& operator<<(std::ostream&, const header&);
@@ -16,9 +16,13 @@
 #include "s3/error.h"
 #include "s3/logger.h"
 #include "s3/signature.h"
+#include "utils/retry.h"
+#include "vassert.h"
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/iostream.hh>
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/net/dns.hh>
@@ -32,6 +36,8 @@
 #include <gnutls/crypto.h>
 
 #include <exception>
+#include <optional>
+#include <string_view>
 
 namespace s3 {
 
@@ -145,6 +151,128 @@ request_creator::make_unsigned_put_object_request(
     return header;
 }
 
+result<http::client::request_header>
+request_creator::make_create_multipart_upload_request(
+  bucket_name const& name, object_key const& key) {
+    http::client::request_header header{};
+    // POST /{object-id}?uploads HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // x-amz-date:{req-datetime}
+    // Authorization:{signature}
+    // x-amz-content-sha256:e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}?uploads", key());
+    std::string emptysig
+      = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+    header.method(boost::beast::http::verb::post);
+    header.target(target);
+    header.insert(
+      boost::beast::http::field::user_agent, aws_header_values::user_agent);
+    header.insert(boost::beast::http::field::host, host);
+    header.insert(boost::beast::http::field::content_length, "0");
+    header.insert(aws_header_names::x_amz_content_sha256, emptysig);
+    auto ec = _sign.sign_header(header, emptysig);
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_unsigned_upload_part_request(
+  bucket_name const& name,
+  object_key const& key,
+  upload_id const& id,
+  size_t part_number,
+  size_t payload_size_bytes) {
+    // PUT /{object-id}?partNumber={num}&uploadId={id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // x-amz-date:{req-datetime}
+    // Authorization:{signature}
+    // Content-Length: {payload-size}
+    // x-amz-content-sha256:UNSIGNED-PAYLOAD
+    // [{payload-size} bytes of part data]
+    http::client::request_header header{};
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format(
+      "/{}?partNumber={}&uploadId={}", key(), part_number, id());
+    std::string sig = "UNSIGNED-PAYLOAD";
+    header.method(boost::beast::http::verb::put);
+    header.target(target);
+    header.insert(
+      boost::beast::http::field::user_agent, aws_header_values::user_agent);
+    header.insert(boost::beast::http::field::host, host);
+    header.insert(
+      boost::beast::http::field::content_length,
+      std::to_string(payload_size_bytes));
+    header.insert(aws_header_names::x_amz_content_sha256, sig);
+    auto ec = _sign.sign_header(header, sig);
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_unsigned_complete_multipart_upload_request(
+  bucket_name const& name,
+  object_key const& key,
+  upload_id const& id,
+  size_t payload_size_bytes) {
+    // POST /{object-id}?uploadId={id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // x-amz-date:{req-datetime}
+    // Authorization:{signature}
+    // Content-Length: {payload-size}
+    // x-amz-content-sha256:UNSIGNED-PAYLOAD
+    // [xml listing the uploaded parts]
+    http::client::request_header header{};
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}?uploadId={}", key(), id());
+    std::string sig = "UNSIGNED-PAYLOAD";
+    header.method(boost::beast::http::verb::post);
+    header.target(target);
+    header.insert(
+      boost::beast::http::field::user_agent, aws_header_values::user_agent);
+    header.insert(boost::beast::http::field::host, host);
+    header.insert(
+      boost::beast::http::field::content_length,
+      std::to_string(payload_size_bytes));
+    header.insert(aws_header_names::x_amz_content_sha256, sig);
+    auto ec = _sign.sign_header(header, sig);
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_abort_multipart_upload_request(
+  bucket_name const& name, object_key const& key, upload_id const& id) {
+    http::client::request_header header{};
+    // DELETE /{object-id}?uploadId={id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // x-amz-date:{req-datetime}
+    // Authorization:{signature}
+    // x-amz-content-sha256:e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}?uploadId={}", key(), id());
+    std::string emptysig
+      = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+    header.method(boost::beast::http::verb::delete_);
+    header.target(target);
+    header.insert(
+      boost::beast::http::field::user_agent, aws_header_values::user_agent);
+    header.insert(boost::beast::http::field::host, host);
+    header.insert(boost::beast::http::field::content_length, "0");
+    header.insert(aws_header_names::x_amz_content_sha256, emptysig);
+    auto ec = _sign.sign_header(header, emptysig);
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
 result<http::client::request_header>
 request_creator::make_list_objects_v2_request(
   const bucket_name& name,
@@ -244,6 +372,23 @@ parse_timestamp(std::string_view sv) {
     return std::chrono::system_clock::from_time_t(timegm(&tm));
 }
 
+/// Extract a single listed object from a 'Contents' element
+static client::list_bucket_item
+parse_list_bucket_item(const boost::property_tree::ptree& value) {
+    client::list_bucket_item item;
+    for (const auto& [item_tag, item_value] : value) {
+        if (item_tag == "Key") {
+            item.key = item_value.get_value<ss::sstring>();
+        } else if (item_tag == "Size") {
+            item.size_bytes = item_value.get_value<size_t>();
+        } else if (item_tag == "LastModified") {
+            item.last_modified = parse_timestamp(
+              item_value.get_value<ss::sstring>());
+        }
+    }
+    return item;
+}
+
 static client::list_bucket_result iobuf_to_list_bucket_result(iobuf&& buf) {
     try {
         for (auto& frag : buf) {
@@ -256,18 +401,7 @@ static client::list_bucket_result iobuf_to_list_bucket_result(iobuf&& buf) {
         auto root = iobuf_to_ptree(std::move(buf));
         for (const auto& [tag, value] : root.get_child("ListBucketResult")) {
             if (tag == "Contents") {
-                client::list_bucket_item item;
-                for (const auto& [item_tag, item_value] : value) {
-                    if (item_tag == "Key") {
-                        item.key = item_value.get_value<ss::sstring>();
-                    } else if (item_tag == "Size") {
-                        item.size_bytes = item_value.get_value<size_t>();
-                    } else if (item_tag == "LastModified") {
-                        item.last_modified = parse_timestamp(
-                          item_value.get_value<ss::sstring>());
-                    }
-                }
-                result.contents.push_back(std::move(item));
+                result.contents.push_back(parse_list_bucket_item(value));
             } else if (tag == "IsTruncated") {
                 // read value as bool
                 result.is_truncated = value.get_value<bool>();
@@ -318,9 +452,13 @@ drain_response_stream(http::client::response_stream_ref resp) {
 
 client::client(const configuration& conf)
   : _requestor(conf)
-  , _client(conf) {}
+  , _client(conf)
+  , _pool(conf) {}
 
-ss::future<> client::shutdown() { return _client.shutdown(); }
+ss::future<> client::shutdown() {
+    co_await _client.shutdown();
+    co_await _pool.stop();
+}
 ss::future<http::client::response_stream_ref>
 client::get_object(bucket_name const& name, object_key const& key) {
     auto header = _requestor.make_get_object_request(name, key);
@@ -379,6 +517,212 @@ ss::future<> client::put_object(
       });
 }
 
+/// Extract the upload id from a 'CreateMultipartUpload' response
+static upload_id iobuf_to_upload_id(iobuf&& buf) {
+    auto root = iobuf_to_ptree(std::move(buf));
+    auto id = root.get<ss::sstring>(
+      "InitiateMultipartUploadResult.UploadId", "");
+    if (id.empty()) {
+        throw std::runtime_error(
+          "CreateMultipartUpload response has no UploadId");
+    }
+    return upload_id(id);
+}
+
+ss::future<client::upload_part_result> client::upload_part(
+  bucket_name const& name,
+  object_key const& key,
+  upload_id const& id,
+  size_t part_number,
+  iobuf part,
+  int retries) {
+    auto etag = co_await retry_with_backoff(
+      retries,
+      [this, &name, &key, &id, part_number, &part] {
+          // the header has to be re-created on every attempt since the
+          // signature includes a timestamp
+          auto header = _requestor.make_unsigned_upload_part_request(
+            name, key, id, part_number, part.size_bytes());
+          if (!header) {
+              return ss::make_exception_future<ss::sstring>(
+                std::system_error(header.error()));
+          }
+          vlog(s3_log.trace, "send https request:\n{}", header);
+          return ss::do_with(
+            _pool.acquire(),
+            make_iobuf_input_stream(part.share(0, part.size_bytes())),
+            [header = std::move(header)](
+              http::client_pool::connection& conn,
+              ss::input_stream<char>& body) mutable {
+                return conn->request(std::move(header.value()), body)
+                  .then([](const http::client::response_stream_ref& ref) {
+                      return drain_response_stream(ref).then([ref](
+                                                               iobuf&& res) {
+                          auto status = ref->get_headers().result();
+                          if (status != boost::beast::http::status::ok) {
+                              return parse_rest_error_response<ss::sstring>(
+                                std::move(res));
+                          }
+                          auto etag = ref->get_headers()
+                                        [boost::beast::http::field::etag];
+                          return ss::make_ready_future<ss::sstring>(
+                            ss::sstring(etag.data(), etag.size()));
+                      });
+                  })
+                  .then_wrapped([&conn](ss::future<ss::sstring> f) {
+                      if (f.failed()) {
+                          // the connection may hold a partially sent
+                          // request, don't reuse it
+                          conn.mark_failed();
+                      }
+                      return f;
+                  });
+            });
+      },
+      std::chrono::milliseconds(100));
+    co_return upload_part_result{
+      .part_number = part_number, .etag = std::move(etag)};
+}
+
+ss::future<> client::abort_multipart_upload(
+  bucket_name const& name, object_key const& key, upload_id const& id) {
+    auto header = _requestor.make_abort_multipart_upload_request(name, key, id);
+    if (!header) {
+        return ss::make_exception_future<>(std::system_error(header.error()));
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header);
+    return _client.request(std::move(header.value()))
+      .then([](const http::client::response_stream_ref& ref) {
+          return drain_response_stream(ref).then([ref](iobuf&& res) {
+              if (
+                ref->get_headers().result()
+                != boost::beast::http::status::ok) { // expect 204
+                  return parse_rest_error_response<>(std::move(res));
+              }
+              return ss::now();
+          });
+      });
+}
+
+ss::future<> client::put_object_multipart(
+  bucket_name const& name,
+  object_key const& key,
+  size_t payload_size,
+  ss::input_stream<char>&& body,
+  size_t part_size,
+  size_t concurrency,
+  int retries_per_part) {
+    vassert(
+      part_size > 0 && concurrency > 0,
+      "invalid multipart parameters: part_size {}, concurrency {}",
+      part_size,
+      concurrency);
+    auto stream = std::move(body);
+    if (payload_size <= part_size) {
+        // a single part gains nothing over a plain 'PutObject'
+        co_return co_await put_object(
+          name, key, payload_size, std::move(stream));
+    }
+    // initiate the upload over the main connection
+    auto header = _requestor.make_create_multipart_upload_request(name, key);
+    if (!header) {
+        throw std::system_error(header.error());
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header);
+    auto resp = co_await _client.request(std::move(header.value()));
+    auto outbuf = co_await drain_response_stream(resp);
+    if (resp->get_headers().result() != boost::beast::http::status::ok) {
+        co_await parse_rest_error_response<>(std::move(outbuf));
+    }
+    auto id = iobuf_to_upload_id(std::move(outbuf));
+    // read the body sequentially, keeping up to 'concurrency' part
+    // uploads in flight, each over its own pooled connection
+    ss::semaphore limit(concurrency);
+    std::vector<ss::future<upload_part_result>> parts;
+    std::exception_ptr eptr;
+    size_t consumed = 0;
+    size_t part_number = 1;
+    try {
+        while (consumed < payload_size) {
+            auto units = co_await ss::get_units(limit, 1);
+            auto len = std::min(part_size, payload_size - consumed);
+            auto part = co_await read_iobuf_exactly(stream, len);
+            if (part.size_bytes() == 0) {
+                // input ended before payload_size bytes were read
+                break;
+            }
+            consumed += part.size_bytes();
+            parts.push_back(
+              upload_part(
+                name, key, id, part_number++, std::move(part), retries_per_part)
+                .finally([u = std::move(units)] {}));
+        }
+    } catch (...) {
+        eptr = std::current_exception();
+    }
+    // in-flight parts have to be waited for even on failure
+    auto results = co_await ss::when_all(parts.begin(), parts.end());
+    std::vector<upload_part_result> uploaded;
+    uploaded.reserve(results.size());
+    for (auto& f : results) {
+        if (f.failed()) {
+            if (!eptr) {
+                eptr = f.get_exception();
+            }
+        } else {
+            uploaded.push_back(f.get0());
+        }
+    }
+    if (!eptr && consumed != payload_size) {
+        eptr = std::make_exception_ptr(std::runtime_error(fmt::format(
+          "truncated multipart upload body: expected {} bytes, read {}",
+          payload_size,
+          consumed)));
+    }
+    if (eptr) {
+        vlog(s3_log.warn, "aborting multipart upload of {}", key());
+        try {
+            co_await abort_multipart_upload(name, key, id);
+        } catch (...) {
+            vlog(
+              s3_log.warn,
+              "failed to abort multipart upload {}: {}",
+              id(),
+              std::current_exception());
+        }
+        std::rethrow_exception(eptr);
+    }
+    // complete the upload; parts are already ordered by part number
+    iobuf complete_body;
+    static constexpr std::string_view open_tag = "<CompleteMultipartUpload>";
+    static constexpr std::string_view close_tag = "</CompleteMultipartUpload>";
+    complete_body.append(open_tag.data(), open_tag.size());
+    for (const auto& p : uploaded) {
+        auto part_xml = fmt::format(
+          "<Part><PartNumber>{}</PartNumber><ETag>{}</ETag></Part>",
+          p.part_number,
+          p.etag);
+        complete_body.append(part_xml.data(), part_xml.size());
+    }
+    complete_body.append(close_tag.data(), close_tag.size());
+    auto complete_header
+      = _requestor.make_unsigned_complete_multipart_upload_request(
+        name, key, id, complete_body.size_bytes());
+    if (!complete_header) {
+        throw std::system_error(complete_header.error());
+    }
+    vlog(s3_log.trace, "send https request:\n{}", complete_header);
+    auto complete_stream = make_iobuf_input_stream(std::move(complete_body));
+    auto complete_resp = co_await _client.request(
+      std::move(complete_header.value()), complete_stream);
+    auto complete_buf = co_await drain_response_stream(complete_resp);
+    if (
+      complete_resp->get_headers().result()
+      != boost::beast::http::status::ok) {
+        co_await parse_rest_error_response<>(std::move(complete_buf));
+    }
+}
+
 ss::future<client::list_bucket_result> client::list_objects_v2(
   const bucket_name& name,
   std::optional<object_key> prefix,
@@ -423,6 +767,177 @@ ss::future<client::list_bucket_result> client::list_objects_v2(
       });
 }
 
+// streaming list //
+
+std::vector<client::list_bucket_item>
+list_objects_streaming_parser::feed(iobuf&& chunk) {
+    for (auto& frag : chunk) {
+        _buf.append(frag.get(), frag.size());
+    }
+    std::vector<client::list_bucket_item> out;
+    static constexpr std::string_view open_tag = "<Contents>";
+    static constexpr std::string_view close_tag = "</Contents>";
+    while (true) {
+        auto open = _buf.find(open_tag.data(), 0, open_tag.size());
+        if (open == std::string::npos) {
+            break;
+        }
+        auto close = _buf.find(close_tag.data(), open, close_tag.size());
+        if (close == std::string::npos) {
+            // element still incomplete, drop everything in front of it
+            scan_metadata();
+            _buf.erase(0, open);
+            return out;
+        }
+        auto end = close + close_tag.size();
+        // a single 'Contents' element is a self contained xml document
+        iobuf element;
+        element.append(_buf.data() + open, end - open);
+        auto root = iobuf_to_ptree(std::move(element));
+        out.push_back(parse_list_bucket_item(root.get_child("Contents")));
+        scan_metadata();
+        _buf.erase(0, end);
+    }
+    // no element in progress, keep a small tail so tags split across
+    // chunk boundaries aren't lost
+    if (_buf.size() > retained_tail_bytes) {
+        scan_metadata();
+        _buf.erase(0, _buf.size() - retained_tail_bytes);
+    }
+    return out;
+}
+
+client::list_bucket_result list_objects_streaming_parser::finish() {
+    scan_metadata();
+    _buf.clear();
+    _buf.shrink_to_fit();
+    client::list_bucket_result result;
+    result.is_truncated = _is_truncated;
+    result.prefix = _prefix;
+    return result;
+}
+
+void list_objects_streaming_parser::scan_metadata() {
+    auto find_tag =
+      [this](
+        std::string_view open,
+        std::string_view close) -> std::optional<ss::sstring> {
+        auto o = _buf.find(open.data(), 0, open.size());
+        if (o == std::string::npos) {
+            return std::nullopt;
+        }
+        auto value_start = o + open.size();
+        auto c = _buf.find(close.data(), value_start, close.size());
+        if (c == std::string::npos) {
+            return std::nullopt;
+        }
+        return ss::sstring(_buf.data() + value_start, c - value_start);
+    };
+    if (auto truncated = find_tag("<IsTruncated>", "</IsTruncated>")) {
+        _is_truncated = *truncated == "true";
+    }
+    // only the first occurrence is the top level prefix; later ones
+    // belong to 'CommonPrefixes' elements
+    if (!_prefix_seen) {
+        if (auto prefix = find_tag("<Prefix>", "</Prefix>")) {
+            _prefix = *prefix;
+            _prefix_seen = true;
+        }
+    }
+}
+
+ss::future<client::list_bucket_result> client::list_streaming_on(
+  http::client& conn,
+  http::client::request_header header,
+  list_item_consumer& consumer) {
+    vlog(s3_log.trace, "send https request:\n{}", header);
+    auto resp = co_await conn.request(std::move(header));
+    co_await resp->prefetch_headers();
+    if (resp->get_headers().result() != boost::beast::http::status::ok) {
+        // error responses are small, buffering them is fine
+        auto res = co_await drain_response_stream(resp);
+        co_await parse_rest_error_response<>(std::move(res));
+    }
+    auto body = resp->as_input_stream();
+    list_objects_streaming_parser parser;
+    while (!body.eof()) {
+        auto tmp = co_await body.read();
+        if (tmp.empty()) {
+            break;
+        }
+        iobuf chunk;
+        chunk.append(std::move(tmp));
+        auto items = parser.feed(std::move(chunk));
+        for (auto& item : items) {
+            co_await consumer(std::move(item));
+        }
+    }
+    co_return parser.finish();
+}
+
+ss::future<client::list_bucket_result> client::list_objects_v2_streaming(
+  const bucket_name& name,
+  list_item_consumer consumer,
+  std::optional<object_key> prefix,
+  std::optional<object_key> start_after,
+  std::optional<size_t> max_keys) {
+    auto header = _requestor.make_list_objects_v2_request(
+      name, std::move(prefix), std::move(start_after), max_keys);
+    if (!header) {
+        throw std::system_error(header.error());
+    }
+    co_return co_await list_streaming_on(
+      _client, std::move(header.value()), consumer);
+}
+
+ss::future<> client::list_prefix_shard(
+  const bucket_name& name,
+  const object_key& prefix,
+  list_item_consumer& consumer) {
+    auto header = _requestor.make_list_objects_v2_request(
+      name, prefix, std::nullopt, std::nullopt);
+    if (!header) {
+        throw std::system_error(header.error());
+    }
+    auto conn = _pool.acquire();
+    try {
+        co_await list_streaming_on(*conn, std::move(header.value()), consumer);
+    } catch (...) {
+        conn.mark_failed();
+        throw;
+    }
+}
+
+ss::future<> client::list_objects_v2_sharded(
+  const bucket_name& name,
+  std::vector<object_key> prefixes,
+  list_item_consumer consumer,
+  size_t concurrency) {
+    vassert(concurrency > 0, "invalid listing concurrency");
+    ss::semaphore limit(concurrency);
+    std::vector<ss::future<>> shards;
+    shards.reserve(prefixes.size());
+    for (const auto& prefix : prefixes) {
+        auto units = co_await ss::get_units(limit, 1);
+        shards.push_back(list_prefix_shard(name, prefix, consumer)
+                           .finally([u = std::move(units)] {}));
+    }
+    auto results = co_await ss::when_all(shards.begin(), shards.end());
+    std::exception_ptr eptr;
+    for (auto& f : results) {
+        if (f.failed()) {
+            if (!eptr) {
+                eptr = f.get_exception();
+            } else {
+                f.ignore_ready_future();
+            }
+        }
+    }
+    if (eptr) {
+        std::rethrow_exception(eptr);
+    }
+}
+
 ss::future<>
 client::delete_object(const bucket_name& bucket, const object_key& key) {
     auto header = _requestor.make_delete_object_request(bucket, key);
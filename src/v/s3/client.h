@@ -10,21 +10,28 @@
 
 #pragma once
 
+#include "bytes/iobuf.h"
 #include "http/client.h"
+#include "http/client_pool.h"
 #include "rpc/transport.h"
 #include "s3/signature.h"
 
+#include <seastar/util/noncopyable_function.hh>
+
 #include <boost/property_tree/ptree_fwd.hpp>
 
 #include <chrono>
 #include <initializer_list>
 #include <limits>
+#include <memory>
+#include <vector>
 
 namespace s3 {
 
 using access_point_uri = named_type<ss::sstring, struct s3_access_point_uri>;
 using bucket_name = named_type<ss::sstring, struct s3_bucket_name>;
 using object_key = named_type<ss::sstring, struct s3_object_key>;
+using upload_id = named_type<ss::sstring, struct s3_upload_id>;
 
 /// S3 client configuration
 struct configuration : rpc::base_transport::configuration {
@@ -87,6 +94,54 @@ public:
     result<http::client::request_header>
     make_delete_object_request(bucket_name const& name, object_key const& key);
 
+    /// \brief Create a 'CreateMultipartUpload' request header
+    ///
+    /// \param name is a bucket that should be used to store new object
+    /// \param key is an object name
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_create_multipart_upload_request(
+      bucket_name const& name, object_key const& key);
+
+    /// \brief Create unsigned 'UploadPart' request header
+    /// Same as 'PutObject' the payload is unsigned so we don't have to
+    /// hash multi-megabyte parts.
+    ///
+    /// \param name is a bucket that should be used to store new object
+    /// \param key is an object name
+    /// \param id is an upload id returned by 'CreateMultipartUpload'
+    /// \param part_number is a 1-based index of the part
+    /// \param payload_size_bytes is a size of the part in bytes
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_unsigned_upload_part_request(
+      bucket_name const& name,
+      object_key const& key,
+      upload_id const& id,
+      size_t part_number,
+      size_t payload_size_bytes);
+
+    /// \brief Create unsigned 'CompleteMultipartUpload' request header
+    ///
+    /// \param name is a bucket that should be used to store new object
+    /// \param key is an object name
+    /// \param id is an upload id returned by 'CreateMultipartUpload'
+    /// \param payload_size_bytes is a size of the xml body in bytes
+    /// \return initialized and signed http header or error
+    result<http::client::request_header>
+    make_unsigned_complete_multipart_upload_request(
+      bucket_name const& name,
+      object_key const& key,
+      upload_id const& id,
+      size_t payload_size_bytes);
+
+    /// \brief Create an 'AbortMultipartUpload' request header
+    ///
+    /// \param name is a bucket that should be used to store new object
+    /// \param key is an object name
+    /// \param id is an upload id returned by 'CreateMultipartUpload'
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_abort_multipart_upload_request(
+      bucket_name const& name, object_key const& key, upload_id const& id);
+
     /// \brief Initialize http header for 'ListObjectsV2' request
     ///
     /// \param name of the bucket
@@ -133,6 +188,39 @@ public:
       size_t payload_size,
       ss::input_stream<char>&& body);
 
+    /// default size of a single part of a multipart upload (AWS requires
+    /// at least 5MiB for every part except the last one)
+    static constexpr size_t default_part_size = 8 << 20;
+    /// default number of parts uploaded in parallel
+    static constexpr size_t default_part_concurrency = 4;
+    /// default number of upload attempts per part
+    static constexpr int default_part_retries = 3;
+
+    /// Put large object to S3 bucket using a multipart upload.
+    /// The body is read sequentially and split into parts of 'part_size'
+    /// bytes; up to 'concurrency' parts are uploaded in parallel, each
+    /// over its own pooled http connection. A part that fails is retried
+    /// individually with backoff up to 'retries_per_part' times. If the
+    /// upload can't be completed it's aborted (best effort) and the
+    /// error is propagated.
+    ///
+    /// \param name is a bucket name
+    /// \param key is an id of the object
+    /// \param payload_size is a size of the object in bytes
+    /// \param body is an input_stream that can be used to read body
+    /// \param part_size is a size of a single uploaded part
+    /// \param concurrency is a max number of parts uploaded in parallel
+    /// \param retries_per_part is a number of upload attempts per part
+    /// \return future that becomes ready when the upload is completed
+    ss::future<> put_object_multipart(
+      bucket_name const& name,
+      object_key const& key,
+      size_t payload_size,
+      ss::input_stream<char>&& body,
+      size_t part_size = default_part_size,
+      size_t concurrency = default_part_concurrency,
+      int retries_per_part = default_part_retries);
+
     struct list_bucket_item {
         ss::sstring key;
         std::chrono::system_clock::time_point last_modified;
@@ -149,12 +237,121 @@ public:
       std::optional<object_key> start_after = std::nullopt,
       std::optional<size_t> max_keys = std::nullopt);
 
+    using list_item_consumer
+      = ss::noncopyable_function<ss::future<>(list_bucket_item)>;
+
+    /// default number of prefixes listed in parallel by
+    /// list_objects_v2_sharded
+    static constexpr size_t default_list_concurrency = 4;
+
+    /// Stream a listing, invoking the consumer for every object as the
+    /// response chunks arrive. Unlike list_objects_v2 the response is
+    /// never materialized, so memory stays bounded no matter how many
+    /// objects the bucket holds.
+    ///
+    /// \param name of the bucket
+    /// \param consumer is invoked once per listed object, in order
+    /// \param prefix limits the listing to matching keys
+    /// \param start_after is an offset of the first returned object
+    /// \param max_keys is a max number of returned objects
+    /// \return listing metadata (contents are left empty)
+    ss::future<list_bucket_result> list_objects_v2_streaming(
+      const bucket_name& name,
+      list_item_consumer consumer,
+      std::optional<object_key> prefix = std::nullopt,
+      std::optional<object_key> start_after = std::nullopt,
+      std::optional<size_t> max_keys = std::nullopt);
+
+    /// List several prefixes in parallel, each streamed over its own
+    /// pooled connection; used for fast recovery scans over buckets
+    /// sharded by prefix. The consumer may be invoked concurrently
+    /// from different prefix listings.
+    ///
+    /// \param name of the bucket
+    /// \param prefixes to list, one listing per prefix
+    /// \param consumer is invoked once per listed object
+    /// \param concurrency is a max number of listings in flight
+    ss::future<> list_objects_v2_sharded(
+      const bucket_name& name,
+      std::vector<object_key> prefixes,
+      list_item_consumer consumer,
+      size_t concurrency = default_list_concurrency);
+
     ss::future<>
     delete_object(const bucket_name& bucket, const object_key& key);
 
 private:
+    struct upload_part_result {
+        size_t part_number;
+        ss::sstring etag;
+    };
+
+    /// Upload a single part over a pooled connection, retrying failed
+    /// attempts with backoff
+    ss::future<upload_part_result> upload_part(
+      bucket_name const& name,
+      object_key const& key,
+      upload_id const& id,
+      size_t part_number,
+      iobuf part,
+      int retries);
+
+    ss::future<> abort_multipart_upload(
+      bucket_name const& name, object_key const& key, upload_id const& id);
+
+    /// Stream one listing over the given connection, feeding body
+    /// chunks through the incremental parser
+    ss::future<list_bucket_result> list_streaming_on(
+      http::client& conn,
+      http::client::request_header header,
+      list_item_consumer& consumer);
+
+    /// Stream a single prefix of a sharded listing over a pooled
+    /// connection
+    ss::future<> list_prefix_shard(
+      const bucket_name& name,
+      const object_key& prefix,
+      list_item_consumer& consumer);
+
     request_creator _requestor;
     http::client _client;
+    /// keep-alive connections used by multipart part uploads and
+    /// sharded listings
+    http::client_pool _pool;
+};
+
+/// \brief Incremental parser for 'ListObjectsV2' xml payloads.
+///
+/// Feed response chunks as they arrive; every complete '<Contents>'
+/// element is parsed and returned right away, so only an incomplete
+/// trailing element plus a small tail is ever buffered and memory
+/// stays bounded regardless of the listing size. Top level metadata
+/// tags (IsTruncated, Prefix) are picked up along the way.
+class list_objects_streaming_parser {
+public:
+    /// Feed the next chunk of the response body
+    /// \return objects completed by this chunk, in listing order
+    std::vector<client::list_bucket_item> feed(iobuf&& chunk);
+
+    /// Has to be called after the last chunk
+    /// \return the listing metadata (contents are left empty)
+    client::list_bucket_result finish();
+
+    /// bytes currently buffered
+    size_t buffered_bytes() const { return _buf.size(); }
+
+private:
+    /// Pick up complete top level metadata tags from the buffer
+    void scan_metadata();
+
+    /// bytes retained when no element is in progress, so tags split
+    /// across chunk boundaries survive
+    static constexpr size_t retained_tail_bytes = 512;
+
+    std::string _buf;
+    bool _is_truncated{false};
+    bool _prefix_seen{false};
+    ss::sstring _prefix;
 };
 
 } // namespace s3
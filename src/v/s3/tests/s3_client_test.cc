@@ -34,9 +34,12 @@
 #include <boost/beast/http/field.hpp>
 #include <boost/test/tools/old/interface.hpp>
 #include <boost/test/unit_test.hpp>
+#include <fmt/format.h>
 
 #include <chrono>
 #include <exception>
+#include <map>
+#include <string_view>
 
 static const uint16_t httpd_port_number = 4434;
 static constexpr const char* httpd_host_name = "127.0.0.1";
@@ -77,6 +80,15 @@ static constexpr const char* list_objects_payload = R"xml(
     <Prefix>test-prefix</Prefix>
   </CommonPrefixes>
 </ListBucketResult>)xml";
+static constexpr const char* initiate_upload_payload = R"xml(
+<InitiateMultipartUploadResult>
+  <Bucket>test-bucket</Bucket>
+  <Key>test-multipart</Key>
+  <UploadId>test-upload-id</UploadId>
+</InitiateMultipartUploadResult>)xml";
+
+/// parts received by the fake 'UploadPart' handler, keyed by part number
+static std::map<int, ss::sstring> received_parts; // NOLINT
 
 void set_routes(ss::httpd::routes& r) {
     using namespace ss::httpd;
@@ -132,7 +144,36 @@ void set_routes(ss::httpd::routes& r) {
           return "";
       },
       "txt");
+    auto multipart_response = new function_handler(
+      [](const_req req, [[maybe_unused]] reply& reply) -> ss::sstring {
+          BOOST_REQUIRE(!req.get_header("x-amz-content-sha256").empty());
+          if (req.get_query_param("uploadId").empty()) {
+              // CreateMultipartUpload
+              return initiate_upload_payload;
+          }
+          // CompleteMultipartUpload, the body has to list every part
+          BOOST_REQUIRE_EQUAL(req.get_query_param("uploadId"), "test-upload-id");
+          for (const auto& [num, content] : received_parts) {
+              auto tag = fmt::format("<PartNumber>{}</PartNumber>", num);
+              BOOST_REQUIRE(req.content.find(tag) != ss::sstring::npos);
+          }
+          return "<CompleteMultipartUploadResult></"
+                 "CompleteMultipartUploadResult>";
+      },
+      "txt");
+    auto upload_part_response = new function_handler(
+      [](const_req req, reply& reply) -> ss::sstring {
+          auto num = req.get_query_param("partNumber");
+          BOOST_REQUIRE(!num.empty());
+          BOOST_REQUIRE_EQUAL(req.get_query_param("uploadId"), "test-upload-id");
+          received_parts[std::stoi(num)] = req.content;
+          reply.add_header("ETag", fmt::format("\"etag-{}\"", num));
+          return "";
+      },
+      "txt");
     r.add(operation_type::PUT, url("/test"), empty_put_response);
+    r.add(operation_type::POST, url("/test-multipart"), multipart_response);
+    r.add(operation_type::PUT, url("/test-multipart"), upload_part_response);
     r.add(operation_type::PUT, url("/test-error"), erroneous_put_response);
     r.add(operation_type::GET, url("/test"), get_response);
     r.add(operation_type::GET, url("/test-error"), erroneous_get_response);
@@ -303,6 +344,41 @@ SEASTAR_TEST_CASE(test_delete_object_failure) {
     });
 }
 
+SEASTAR_TEST_CASE(test_put_object_multipart_success) {
+    return ss::async([] {
+        received_parts.clear();
+        auto conf = transport_configuration();
+        auto [server, client] = started_client_and_server(conf);
+        iobuf payload;
+        payload.append(expected_payload, expected_payload_size);
+        auto payload_stream = make_iobuf_input_stream(std::move(payload));
+        constexpr size_t part_size = 64;
+        constexpr size_t concurrency = 2;
+        client
+          ->put_object_multipart(
+            s3::bucket_name("test-bucket"),
+            s3::object_key("test-multipart"),
+            expected_payload_size,
+            std::move(payload_stream),
+            part_size,
+            concurrency)
+          .get();
+        // every part made it to the server and they reassemble into the
+        // original payload
+        BOOST_REQUIRE_EQUAL(
+          received_parts.size(),
+          expected_payload_size / part_size
+            + (expected_payload_size % part_size == 0 ? 0 : 1));
+        ss::sstring reassembled;
+        for (const auto& [num, content] : received_parts) {
+            reassembled += content;
+        }
+        BOOST_REQUIRE_EQUAL(reassembled, expected_payload);
+        client->shutdown().get();
+        server->stop().get();
+    });
+}
+
 static ss::sstring strtime(const std::chrono::system_clock::time_point& ts) {
     auto tt = std::chrono::system_clock::to_time_t(ts);
     auto tm = *std::gmtime(&tt);
@@ -311,6 +387,82 @@ static ss::sstring strtime(const std::chrono::system_clock::time_point& ts) {
     return s.str();
 }
 
+SEASTAR_TEST_CASE(test_list_objects_streaming_parser) {
+    return ss::async([] {
+        // feed the response in tiny chunks; items have to come out as
+        // their elements complete and memory has to stay bounded
+        s3::list_objects_streaming_parser parser;
+        std::vector<s3::client::list_bucket_item> items;
+        std::string_view payload(list_objects_payload);
+        constexpr size_t chunk_size = 7;
+        for (size_t ix = 0; ix < payload.size(); ix += chunk_size) {
+            iobuf chunk;
+            auto len = std::min(chunk_size, payload.size() - ix);
+            chunk.append(payload.data() + ix, len);
+            for (auto& item : parser.feed(std::move(chunk))) {
+                items.push_back(std::move(item));
+            }
+            BOOST_REQUIRE_LT(parser.buffered_bytes(), 1024);
+        }
+        auto meta = parser.finish();
+        BOOST_REQUIRE_EQUAL(items.size(), 2);
+        BOOST_REQUIRE_EQUAL(items[0].key, "test-key1");
+        BOOST_REQUIRE_EQUAL(items[0].size_bytes, 111);
+        BOOST_REQUIRE_EQUAL(
+          strtime(items[0].last_modified), "2021-01-10T01:00:00.000Z");
+        BOOST_REQUIRE_EQUAL(items[1].key, "test-key2");
+        BOOST_REQUIRE_EQUAL(items[1].size_bytes, 222);
+        BOOST_REQUIRE_EQUAL(meta.is_truncated, false);
+        BOOST_REQUIRE_EQUAL(meta.prefix, "test-prefix");
+    });
+}
+
+SEASTAR_TEST_CASE(test_list_objects_streaming_success) {
+    return ss::async([] {
+        auto conf = transport_configuration();
+        auto [server, client] = started_client_and_server(conf);
+        std::vector<ss::sstring> keys;
+        auto meta = client
+                      ->list_objects_v2_streaming(
+                        s3::bucket_name("test-bucket"),
+                        [&keys](s3::client::list_bucket_item item) {
+                            keys.push_back(std::move(item.key));
+                            return ss::now();
+                        },
+                        s3::object_key("test"))
+                      .get0();
+        BOOST_REQUIRE_EQUAL(keys.size(), 2);
+        BOOST_REQUIRE_EQUAL(keys[0], "test-key1");
+        BOOST_REQUIRE_EQUAL(keys[1], "test-key2");
+        BOOST_REQUIRE_EQUAL(meta.is_truncated, false);
+        BOOST_REQUIRE_EQUAL(meta.prefix, "test-prefix");
+        client->shutdown().get();
+        server->stop().get();
+    });
+}
+
+SEASTAR_TEST_CASE(test_list_objects_sharded_success) {
+    return ss::async([] {
+        auto conf = transport_configuration();
+        auto [server, client] = started_client_and_server(conf);
+        size_t listed = 0;
+        client
+          ->list_objects_v2_sharded(
+            s3::bucket_name("test-bucket"),
+            {s3::object_key("test"), s3::object_key("test")},
+            [&listed](s3::client::list_bucket_item) {
+                listed++;
+                return ss::now();
+            },
+            2)
+          .get();
+        // two prefixes, two objects each
+        BOOST_REQUIRE_EQUAL(listed, 4);
+        client->shutdown().get();
+        server->stop().get();
+    });
+}
+
 SEASTAR_TEST_CASE(test_list_objects_success) {
     return ss::async([] {
         auto conf = transport_configuration();
@@ -15,10 +15,12 @@
 
 #include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/scheduling.hh>
 #include <seastar/core/when_all.hh>
 
 #include <algorithm>
 #include <iterator>
+#include <vector>
 
 namespace ssx {
 
@@ -50,6 +52,22 @@ async_transform(Iterator begin, Iterator end, Func&& func) {
       });
 }
 
+/// Launches every element of [\c begin, \c end) through \c func at once and
+/// waits for all of them. Building block for the chunked algorithms below;
+/// callers are expected to have sized the chunk already.
+template<typename Iterator, typename Func>
+inline auto run_chunk(Iterator begin, Iterator end, Func& func) {
+    using future = decltype(seastar::futurize_invoke(func, *begin));
+    std::vector<future> futs;
+    futs.reserve(std::distance(begin, end));
+    for (auto it = begin; it != end; ++it) {
+        futs.push_back(seastar::futurize_invoke(func, *it));
+    }
+    return seastar::when_all_succeed(
+      std::make_move_iterator(futs.begin()),
+      std::make_move_iterator(futs.end()));
+}
+
 } // namespace detail
 
 /// \brief Run tasks synchronously in order and wait for completion only
@@ -258,6 +276,120 @@ inline auto parallel_transform(Rng rng, Func func) {
       });
 }
 
+/// \brief Run tasks with bounded parallelism and wait for completion,
+/// preserving order of the results.
+///
+/// Given a range [\c begin, \c end) of objects, run \c func on each \c *i in
+/// the range with at most \c max_concurrent invocations in flight, and return
+/// a \c future<> containing a \c std::vector<> of values in input order. The
+/// range is processed in chunks of \c max_concurrent elements; a chunk is
+/// launched only after the whole previous chunk resolved, so the chunk
+/// boundary is a natural preemption point. This sits between async_transform
+/// (fully sequential) and parallel_transform (everything in flight at once):
+/// arbitrarily large ranges neither stall the reactor while materializing
+/// one continuation per element nor serialize. Every chunk is invoked under
+/// \c sg so bulk background work can be tagged with its scheduling group in
+/// one place.
+///
+/// \param begin an \c InputIterator designating the beginning of the range
+/// \param end an \c InputIterator designating the end of the range
+/// \param func Function to invoke with each element in the range (will be
+/// futurized if it doesn't return a \c future<>)
+/// \param max_concurrent maximum number of in-flight invocations, must be > 0
+/// \param sg scheduling group the chunks are invoked under
+/// \return a \c future<> containing a \c std::vector<> of the results of the
+/// function invocations in input order. If one or more invocations fail, the
+/// return value contains one of the exceptions.
+// clang-format off
+template<typename Iterator, typename Func>
+CONCEPT(requires requires(Func f, Iterator i) {
+    *i++;
+    { i != i } -> std::convertible_to<bool>;
+    seastar::futurize_invoke(f, *i).get0();
+})
+// clang-format on
+inline auto concurrent_transform(
+  Iterator begin,
+  Iterator end,
+  Func func,
+  size_t max_concurrent,
+  seastar::scheduling_group sg = seastar::current_scheduling_group()) {
+    using result_type = decltype(seastar::futurize_invoke(func, *begin).get0());
+    std::vector<result_type> res;
+    res.reserve(std::distance(begin, end));
+    return seastar::do_with(
+      std::move(res),
+      std::move(begin),
+      std::move(end),
+      std::move(func),
+      [max_concurrent, sg](
+        std::vector<result_type>& res, Iterator& it, Iterator& end,
+        Func& func) {
+          return seastar::do_until(
+                   [&it, &end] { return it == end; },
+                   [&res, &it, &end, &func, max_concurrent, sg] {
+                       auto chunk_begin = it;
+                       for (size_t i = 0; i < max_concurrent && it != end;
+                            ++i) {
+                           ++it;
+                       }
+                       return seastar::with_scheduling_group(
+                                sg,
+                                [&func, chunk_begin, chunk_end = it] {
+                                    return detail::run_chunk(
+                                      chunk_begin, chunk_end, func);
+                                })
+                         .then([&res](std::vector<result_type> chunk) {
+                             std::move(
+                               chunk.begin(),
+                               chunk.end(),
+                               std::back_inserter(res));
+                         });
+                   })
+            .then([&res] { return std::move(res); });
+      });
+}
+
+/// \brief Run tasks with bounded parallelism and wait for completion
+/// discarding the results.
+///
+/// Identical to ssx::concurrent_transform except that \c func returns no
+/// value: the range is walked in chunks of at most \c max_concurrent
+/// parallel invocations with a preemption point at every chunk boundary.
+// clang-format off
+template<typename Iterator, typename Func>
+CONCEPT(requires requires(Func f, Iterator i) {
+    *i++;
+    { i != i } -> std::convertible_to<bool>;
+    { seastar::futurize_invoke(f, *i) } -> std::same_as<ss::future<>>;
+})
+// clang-format on
+inline seastar::future<> concurrent_for_each(
+  Iterator begin,
+  Iterator end,
+  Func func,
+  size_t max_concurrent,
+  seastar::scheduling_group sg = seastar::current_scheduling_group()) {
+    return seastar::do_with(
+      std::move(begin),
+      std::move(end),
+      std::move(func),
+      [max_concurrent, sg](Iterator& it, Iterator& end, Func& func) {
+          return seastar::do_until(
+            [&it, &end] { return it == end; },
+            [&it, &end, &func, max_concurrent, sg] {
+                auto chunk_begin = it;
+                for (size_t i = 0; i < max_concurrent && it != end; ++i) {
+                    ++it;
+                }
+                return seastar::with_scheduling_group(
+                  sg, [&func, chunk_begin, chunk_end = it] {
+                      return detail::run_chunk(chunk_begin, chunk_end, func);
+                  });
+            });
+      });
+}
+
 /// \brief Specialization of the ssx::async_transform method. Specifically this
 /// method expects a Mapper to return a bool. After calling async_transform and
 /// recieving a std::vector<bool> this method returns true if all futures
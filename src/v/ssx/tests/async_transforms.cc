@@ -133,3 +133,61 @@ SEASTAR_THREAD_TEST_CASE(parallel_transform_range_test) {
     BOOST_TEST(std::equal(
       out_range.begin(), out_range.end(), expected.begin(), expected.end()));
 }
+
+SEASTAR_THREAD_TEST_CASE(concurrent_transform_test) {
+    std::vector<int> input(25);
+    std::iota(input.begin(), input.end(), 0);
+
+    std::vector<int> expected(25);
+    std::iota(expected.begin(), expected.end(), 2);
+
+    // chunk size deliberately not a divisor of the input size to cover the
+    // short trailing chunk
+    std::vector<int> out = ssx::concurrent_transform(
+                             input.begin(), input.end(), plus(2), 4)
+                             .get0();
+    BOOST_TEST(
+      std::equal(out.begin(), out.end(), expected.begin(), expected.end()));
+}
+
+SEASTAR_THREAD_TEST_CASE(concurrent_transform_bound_test) {
+    std::vector<int> input(20);
+    std::iota(input.begin(), input.end(), 0);
+
+    int in_flight = 0;
+    int max_in_flight = 0;
+    auto out = ssx::concurrent_transform(
+                 input.begin(),
+                 input.end(),
+                 [&in_flight, &max_in_flight](int val) {
+                     ++in_flight;
+                     max_in_flight = std::max(max_in_flight, in_flight);
+                     return ss::later().then([&in_flight, val] {
+                         --in_flight;
+                         return val;
+                     });
+                 },
+                 3)
+                 .get0();
+    BOOST_TEST(out.size() == input.size());
+    BOOST_TEST(max_in_flight <= 3);
+    // it is a parallel primitive: the chunk does run concurrently
+    BOOST_TEST(max_in_flight > 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(concurrent_for_each_test) {
+    std::vector<int> input(10);
+    std::iota(input.begin(), input.end(), 0);
+
+    int sum = 0;
+    ssx::concurrent_for_each(
+      input.begin(),
+      input.end(),
+      [&sum](int val) {
+          sum += val;
+          return ss::now();
+      },
+      4)
+      .get0();
+    BOOST_TEST(sum == 45);
+}
@@ -12,8 +12,11 @@
 #pragma once
 
 #include "seastarx.h"
+#include "storage/io_calibration.h"
 #include "storage/kvstore.h"
 #include "storage/log_manager.h"
+#include "storage/logger.h"
+#include "vlog.h"
 
 namespace storage {
 
@@ -25,9 +28,11 @@ public:
 
     ss::future<> start() {
         _kvstore = std::make_unique<kvstore>(_kv_conf);
-        return _kvstore->start().then([this] {
-            _log_mgr = std::make_unique<log_manager>(_log_conf, kvs());
-        });
+        return _kvstore->start()
+          .then([this] { return calibrate(); })
+          .then([this] {
+              _log_mgr = std::make_unique<log_manager>(_log_conf, kvs());
+          });
     }
 
     ss::future<> stop() {
@@ -45,6 +50,28 @@ public:
     log_manager& log_mgr() { return *_log_mgr; }
 
 private:
+    /**
+     * seed the feedback-free storage knobs from the device profile. a
+     * failed probe is not fatal: the node starts with the static defaults.
+     */
+    ss::future<> calibrate() {
+        if (_log_conf.stype != log_config::storage_type::disk) {
+            return ss::now();
+        }
+        return io_calibration::load_or_calibrate(*_kvstore, _log_conf.base_dir)
+          .then([this](io_profile profile) {
+              _log_conf.initial_fallocation_step
+                = profile.initial_falloc_step();
+              _log_conf.segment_appender_chunks = profile.appender_chunks();
+          })
+          .handle_exception([](const std::exception_ptr& e) {
+              vlog(
+                stlog.warn,
+                "io calibration failed, keeping static defaults: {}",
+                e);
+          });
+    }
+
     kvstore_config _kv_conf;
     log_config _log_conf;
 
@@ -15,29 +15,52 @@ namespace storage {
 
 batch_cache::entry_ptr
 batch_cache::put(batch_cache_index& index, const model::record_batch& input) {
+    // we must copy memory to prevent holding onto bigger memory from
+    // temporary buffers
+    return do_put(index, input.copy());
+}
+
+batch_cache::entry_ptr
+batch_cache::put(batch_cache_index& index, model::record_batch&& input) {
+    // zero-copy admission: the entry keeps the batch's refcounted iobuf
+    // fragments alive instead of copying the payload
+    return do_put(index, std::move(input));
+}
+
+batch_cache::entry_ptr
+batch_cache::do_put(batch_cache_index& index, model::record_batch batch) {
 #ifdef SEASTAR_DEFAULT_ALLOCATOR
     static const size_t threshold = ss::memory::stats().total_memory() * .2;
     while (_size_bytes > threshold) {
         reclaim(1);
     }
 #endif
-    // we must copy memory to prevent holding onto bigger memory from
-    // temporary buffers
-    auto batch = input.copy();
+    /*
+     * zero-copy admission can hand over payloads split across many small
+     * shared fragments; resident batches pay the per-fragment overhead for
+     * as long as they stay cached. small payloads are re-packed here while
+     * the copy is cheap, larger ones are left for defragment()
+     */
+    if (
+      static_cast<size_t>(batch.size_bytes()) <= max_inline_compact_bytes
+      && batch.data().should_compact()) {
+        batch.compact_data();
+    }
     _size_bytes += batch.memory_usage();
     auto e = new entry(index, std::move(batch));
 
     // if weak_from_this were to cause an allocation--which it shouldn't--`e`
     // wouldn't be visible to the reclaimer since it isn't on a lru/pool list.
     auto p = e->weak_from_this();
-    _lru.push_back(*e);
+    // all new batches are admitted on probation; a later touch promotes
+    _probationary.push_back(*e);
     return p;
 }
 
 batch_cache::~batch_cache() noexcept {
     clear();
     vassert(
-      _size_bytes == 0 && _lru.empty(),
+      _size_bytes == 0 && _probationary.empty() && _protected.empty(),
       "Detected incorrect batch_cache accounting. {}",
       *this);
 }
@@ -49,8 +72,13 @@ void batch_cache::evict(entry_ptr&& e) {
         // r-value reference `e` wouldn't do that.
         auto p = std::exchange(e, {});
         _size_bytes -= p->_batch.memory_usage();
-        _lru.erase_and_dispose(
-          _lru.iterator_to(*p), [](entry* e) { delete e; });
+        if (p->_in_protected) {
+            _protected_bytes -= p->_batch.memory_usage();
+        }
+        auto& list = p->_in_protected ? _protected : _probationary;
+        list.erase_and_dispose(list.iterator_to(*p), [](entry* e) {
+            delete e; // NOLINT
+        });
     }
 }
 
@@ -89,8 +117,76 @@ size_t batch_cache::reclaim(size_t size) {
     size_t reclaimed = 0;
     intrusive_list<entry, &entry::_hook> reclaimed_entries;
 
-    for (auto it = _lru.begin(); it != _lru.end();) {
-        if (reclaimed >= _reclaim_size) {
+    /*
+     * drain the probationary segment first so one-shot scans pay for
+     * themselves; only touch the protected working set if that was not
+     * enough to satisfy the request.
+     */
+    reclaimed = reclaim_from(
+      _probationary, _reclaim_size, reclaimed, reclaimed_entries);
+    reclaimed = reclaim_from(
+      _protected, _reclaim_size, reclaimed, reclaimed_entries);
+
+    /*
+     * final removal from the index is deferred because there is some chance
+     * that removal allocates, so waiting until the bulk of the reclaims have
+     * occurred reduces the probability of an allocation failure.
+     */
+    reclaimed_entries.clear_and_dispose([](entry* e) {
+        auto offset = e->_batch.base_offset();
+        auto* index = &e->_index;
+        delete e; // NOLINT
+
+        /*
+         * since reclaim may be invoked at any moment and removals may be
+         * deferred if an index is locked, one can imagine races in which a
+         * batch is removed by offset here which is not the same batch that was
+         * reclaimed in a prior pass. at worst this would raise the miss ratio,
+         * but is still generally safe since all batch cache users are prepared
+         * to handle a miss.
+         */
+        index->remove(offset);
+    });
+
+    _last_reclaim = ss::lowres_clock::now();
+    _size_bytes -= reclaimed;
+    return reclaimed;
+}
+
+size_t batch_cache::defragment(size_t max_scan) {
+    size_t compacted = 0;
+    auto scan = [&max_scan, &compacted](entry_list& list) {
+        for (auto& e : list) {
+            if (max_scan == 0) {
+                break;
+            }
+            --max_scan;
+            if (!e.valid() || e.pinned()) {
+                continue;
+            }
+            if (e._batch.data().should_compact()) {
+                /*
+                 * the compacting copy allocates and may trigger the sync
+                 * reclaimer; pinning keeps this entry off the reclaim list
+                 * while its payload is rebuilt. neighbours may be reclaimed
+                 * but unlinking them does not invalidate this iterator.
+                 */
+                entry::lock_guard g(e);
+                e._batch.compact_data();
+                ++compacted;
+            }
+        }
+    };
+    // LRU first: the longest-resident batches have paid the overhead longest
+    scan(_probationary);
+    scan(_protected);
+    return compacted;
+}
+
+size_t batch_cache::reclaim_from(
+  entry_list& list, size_t target, size_t reclaimed, entry_list& disposed) {
+    for (auto it = list.begin(); it != list.end();) {
+        if (reclaimed >= target) {
             break;
         }
 
@@ -101,7 +197,8 @@ size_t batch_cache::reclaim(size_t size) {
         }
 
         // reclaim the batch's record data
-        reclaimed += it->_batch.memory_usage();
+        const auto usage = it->_batch.memory_usage();
+        reclaimed += usage;
         it->_batch.clear_data();
 
         /*
@@ -111,40 +208,22 @@ size_t batch_cache::reclaim(size_t size) {
          */
         if (unlikely(it->_index.locked())) {
             reclaimed -= it->_batch.memory_usage();
+            if (it->_in_protected) {
+                _protected_bytes -= usage - it->_batch.memory_usage();
+            }
             it->invalidate();
             ++it;
             continue;
         }
 
+        if (it->_in_protected) {
+            _protected_bytes -= usage;
+        }
+
         // collect the entries that will be fully removed
-        it = _lru.erase_and_dispose(it, [&reclaimed_entries](entry* e) {
-            reclaimed_entries.push_back(*e);
-        });
+        it = list.erase_and_dispose(
+          it, [&disposed](entry* e) { disposed.push_back(*e); });
     }
-
-    /*
-     * final removal from the index is deferred because there is some chance
-     * that removal allocates, so waiting until the bulk of the reclaims have
-     * occurred reduces the probability of an allocation failure.
-     */
-    reclaimed_entries.clear_and_dispose([](entry* e) {
-        auto offset = e->_batch.base_offset();
-        auto* index = &e->_index;
-        delete e; // NOLINT
-
-        /*
-         * since reclaim may be invoked at any moment and removals may be
-         * deferred if an index is locked, one can imagine races in which a
-         * batch is removed by offset here which is not the same batch that was
-         * reclaimed in a prior pass. at worst this would raise the miss ratio,
-         * but is still generally safe since all batch cache users are prepared
-         * to handle a miss.
-         */
-        index->remove(offset);
-    });
-
-    _last_reclaim = ss::lowres_clock::now();
-    _size_bytes -= reclaimed;
     return reclaimed;
 }
 
@@ -155,8 +234,10 @@ batch_cache_index::get(model::offset offset) {
         batch_cache::entry::lock_guard g(*it->second);
         _cache->touch(it->second);
         auto ret = it->second->batch().share();
+        ++_hits;
         return ret;
     }
+    ++_misses;
     return std::nullopt;
 }
 
@@ -225,6 +306,11 @@ batch_cache_index::read_result batch_cache_index::read(
         }
     }
     ret.next_batch = offset;
+    if (ret.batches.empty()) {
+        ++_misses;
+    } else {
+        ++_hits;
+    }
     return ret;
 }
 
@@ -249,7 +335,9 @@ std::ostream& operator<<(std::ostream& o, const batch_cache& b) {
     // Do _not_ print size of _lru
     return o << "{is_reclaiming:" << b.is_memory_reclaiming()
              << ", size_bytes: " << b._size_bytes
-             << ", lru_empty:" << b._lru.empty() << "}";
+             << ", protected_bytes: " << b._protected_bytes
+             << ", probationary_empty:" << b._probationary.empty()
+             << ", protected_empty:" << b._protected.empty() << "}";
 }
 std::ostream&
 operator<<(std::ostream& o, const batch_cache_index::read_result& c) {
@@ -20,11 +20,11 @@
 #include <seastar/core/memory.hh>
 #include <seastar/core/weak_ptr.hh>
 
-#include <absl/container/btree_map.h>
-#include <absl/container/flat_hash_map.h>
-
+#include <algorithm>
 #include <limits>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace storage {
 
@@ -51,6 +51,13 @@ class batch_cache_index;
  * example, a batch cache index is created for each log segment, all of which
  * share the same LRU cache.
  *
+ * Eviction is scan resistant. The cache is segmented into a probationary
+ * list that receives all newly inserted batches and a protected list that
+ * batches are promoted into on their first re-reference. Reclaim drains the
+ * probationary list before touching the protected list, so a single
+ * partition performing a historical scan churns through probationary
+ * entries without flushing the tail-read working set of hot partitions.
+ *
  * The LRU cache serves as an entry point for the Seastar memory reclaimer.
  * During a low-memory event Seastar may make an upcall to the LRU cache to free
  * memory. When memory is reclaimed cache entries are invalidated. Since this
@@ -95,6 +102,13 @@ class batch_cache {
     /// Minimum size reclaimed in low-memory situations.
     static constexpr size_t min_reclaim_size = 128 << 10;
 
+    /// payloads up to this size are re-packed inline at admission; larger
+    /// ones are deferred to defragment() so the copy stays off the hot path
+    static constexpr size_t max_inline_compact_bytes = 32 << 10;
+
+    /// entries examined by one defragment() pass by default
+    static constexpr size_t default_defrag_scan = 1024;
+
     using reclaimer = ss::memory::reclaimer;
     using reclaim_scope = ss::memory::reclaimer_scope;
     using reclaim_result = ss::memory::reclaiming_result;
@@ -165,6 +179,8 @@ public:
         model::record_batch _batch;
 
         bool _pinned{false};
+        // set when the entry has been promoted into the protected segment
+        bool _in_protected{false};
         intrusive_list_hook _hook;
         batch_cache_index& _index;
     };
@@ -189,21 +205,24 @@ public:
      * and the moved from reclaimer will deregister itself properly.
      */
     batch_cache(batch_cache&& o) noexcept
-      : _lru(std::move(o._lru))
+      : _probationary(std::move(o._probationary))
+      , _protected(std::move(o._protected))
       , _reclaimer(
           [this](reclaimer::request r) { return reclaim(r); },
           reclaim_scope::sync)
       , _is_reclaiming(o._is_reclaiming)
       , _size_bytes(o._size_bytes)
+      , _protected_bytes(o._protected_bytes)
       , _reclaim_opts(o._reclaim_opts) {
         o._size_bytes = 0;
+        o._protected_bytes = 0;
         o._is_reclaiming = false;
     }
 
     ~batch_cache() noexcept;
 
     /// Returns true if the cache is empty, and false otherwise.
-    bool empty() const { return _lru.empty(); }
+    bool empty() const { return _probationary.empty() && _protected.empty(); }
 
     /// Removes all entries from the cache and entry pool.
     void clear() { reclaim(std::numeric_limits<size_t>::max()); }
@@ -217,6 +236,15 @@ public:
      */
     entry_ptr put(batch_cache_index&, const model::record_batch&);
 
+    /**
+     * Zero-copy admission. The entry takes ownership of the batch and with
+     * it the batch's refcounted iobuf fragments, so neither admission nor a
+     * later cached read pays a payload memcpy. Only move in batches whose
+     * fragments are tightly sized for the batch -- sharing a slice of a
+     * large temporary buffer would pin the whole buffer in the cache.
+     */
+    entry_ptr put(batch_cache_index&, model::record_batch&&);
+
     /**
      * \brief Remove a batch from the cache.
      *
@@ -234,16 +262,37 @@ public:
     void evict(entry_ptr&& e);
 
     /**
-     * Notify the cache that the specified entry was recently used.
+     * Notify the cache that the specified entry was recently used. A first
+     * re-reference promotes the entry from the probationary into the
+     * protected segment; later touches refresh its protected position.
      */
     void touch(entry_ptr& e) {
         if (e) {
             auto p = e.get();
             p->_hook.unlink();
-            _lru.push_back(*p);
+            if (!p->_in_protected) {
+                p->_in_protected = true;
+                _protected_bytes += p->_batch.memory_usage();
+            }
+            _protected.push_back(*p);
+            maybe_demote();
         }
     }
 
+    /**
+     * \brief Re-pack fragmented payloads of cache residents.
+     *
+     * Batches admitted through the zero-copy path can carry many small
+     * fragments whose list-node and allocation-slack overhead is paid for
+     * as long as the batch stays cached. Admission re-packs small payloads
+     * inline; payloads above max_inline_compact_bytes are left for this
+     * bounded pass, which is meant to run from idle-time housekeeping.
+     *
+     * Scans at most max_scan entries, LRU first, and returns the number of
+     * batches compacted.
+     */
+    size_t defragment(size_t max_scan = default_defrag_scan);
+
     /**
      * \brief Evict batches up to the accumulated size specified.
      *
@@ -291,10 +340,41 @@ private:
                               : reclaim_result::reclaimed_nothing;
     }
 
-    intrusive_list<entry, &entry::_hook> _lru;
+    using entry_list = intrusive_list<entry, &entry::_hook>;
+
+    /*
+     * the protected segment is capped at a fraction of the cache so a burst
+     * of promotions cannot starve admission of new batches. overflow is
+     * demoted to the probationary tail, making it the next reclaim victim
+     * unless it is referenced again.
+     */
+    static constexpr size_t max_protected_numerator = 2;
+    static constexpr size_t max_protected_denominator = 3;
+
+    void maybe_demote() {
+        while (!_protected.empty()
+               && _protected_bytes * max_protected_denominator
+                    > _size_bytes * max_protected_numerator) {
+            auto& e = _protected.front();
+            e._hook.unlink();
+            e._in_protected = false;
+            _protected_bytes -= e._batch.memory_usage();
+            _probationary.push_back(e);
+        }
+    }
+
+    entry_ptr do_put(batch_cache_index&, model::record_batch);
+
+    /// reclaim entries from one segment; see reclaim(size_t)
+    size_t reclaim_from(
+      entry_list& list, size_t target, size_t reclaimed, entry_list& disposed);
+
+    entry_list _probationary;
+    entry_list _protected;
     reclaimer _reclaimer;
     bool _is_reclaiming{false};
     size_t _size_bytes{0};
+    size_t _protected_bytes{0};
 
     reclaim_options _reclaim_opts;
     ss::lowres_clock::time_point _last_reclaim;
@@ -304,7 +384,17 @@ private:
 };
 
 class batch_cache_index {
-    using index_type = absl::btree_map<model::offset, batch_cache::entry_ptr>;
+    /*
+     * Batch base offsets arrive in strictly increasing order and truncation
+     * removes a suffix, so the index is kept as a flat sorted array rather
+     * than a btree: admission is an amortized O(1) push_back, point lookup
+     * is a binary search over one contiguous allocation instead of a walk
+     * through btree nodes, and range reads and truncation stream linearly.
+     * The only middle removals come from the memory reclaimer and cost a
+     * contiguous shift, which is cheap at per-segment index sizes.
+     */
+    using index_type
+      = std::vector<std::pair<model::offset, batch_cache::entry_ptr>>;
 
 public:
     struct read_result {
@@ -332,10 +422,22 @@ public:
 
     bool empty() const { return _index.empty(); }
 
+    /// lifetime lookup counters for this index. a lookup that returns at
+    /// least one cached batch counts as a hit, anything else as a miss.
+    uint64_t cache_hits() const { return _hits; }
+    uint64_t cache_misses() const { return _misses; }
+    double hit_rate() const {
+        const auto total = _hits + _misses;
+        return total == 0 ? 0.0 : static_cast<double>(_hits) / total;
+    }
+
     void put(const model::record_batch& batch) {
         lock_guard lk(*this);
         auto offset = batch.header().base_offset;
-        if (likely(!_index.contains(offset))) {
+        // appends insert at the tail, so the lower bound is almost always
+        // end() and the insert degenerates into a push_back
+        auto it = index_lower_bound(offset);
+        if (likely(it == _index.end() || it->first != offset)) {
             /*
              * do not allow initial cache entries to be dangling. if the index
              * is destroyed the cache will contain invalid index reference. once
@@ -343,7 +445,18 @@ public:
              * correctly on either side.
              */
             auto p = _cache->put(*this, batch);
-            _index.emplace(offset, std::move(p));
+            _index.emplace(it, offset, std::move(p));
+        }
+    }
+
+    /// zero-copy admission; see batch_cache::put(.., model::record_batch&&)
+    void put(model::record_batch&& batch) {
+        lock_guard lk(*this);
+        auto offset = batch.header().base_offset;
+        auto it = index_lower_bound(offset);
+        if (likely(it == _index.end() || it->first != offset)) {
+            auto p = _cache->put(*this, std::move(batch));
+            _index.emplace(it, offset, std::move(p));
         }
     }
 
@@ -390,7 +503,7 @@ public:
      * be specified in terms of the batch's base offset.
      */
     void testing_evict_from_cache(model::offset offset) {
-        if (auto it = _index.find(offset); it != _index.end()) {
+        if (auto it = index_find(offset); it != _index.end()) {
             _cache->evict(std::move(it->second));
         }
     }
@@ -400,7 +513,7 @@ public:
      * associated batch has been evicted from the cache.
      */
     bool testing_exists_in_index(model::offset offset) {
-        return _index.find(offset) != _index.end();
+        return index_find(offset) != _index.end();
     }
 
 private:
@@ -440,7 +553,31 @@ private:
      */
     bool remove(model::offset offset) {
         vassert(!locked(), "attempt to erase from locked index");
-        return _index.erase(offset) == 1;
+        if (auto it = index_find(offset); it != _index.end()) {
+            _index.erase(it);
+            return true;
+        }
+        return false;
+    }
+
+    /// first entry whose base offset is not less than the given offset
+    index_type::iterator index_lower_bound(model::offset offset) {
+        return std::lower_bound(
+          _index.begin(),
+          _index.end(),
+          offset,
+          [](const index_type::value_type& e, model::offset o) {
+              return e.first < o;
+          });
+    }
+
+    /// entry with exactly the given base offset, or end()
+    index_type::iterator index_find(model::offset offset) {
+        auto it = index_lower_bound(offset);
+        if (it != _index.end() && it->first == offset) {
+            return it;
+        }
+        return _index.end();
     }
 
     /*
@@ -452,9 +589,13 @@ private:
         if (_index.empty()) {
             return _index.end();
         }
-        auto it = _index.upper_bound(offset);
-        if (it != _index.begin()) {
-            --it;
+        auto it = index_lower_bound(offset);
+        if (it == _index.end() || it->first != offset) {
+            // no exact match, step back to the batch that may cover the
+            // offset from below
+            if (it != _index.begin()) {
+                --it;
+            }
         }
         return it;
     }
@@ -477,6 +618,8 @@ private:
     bool _locked{false};
     batch_cache* _cache;
     index_type _index;
+    uint64_t _hits{0};
+    uint64_t _misses{0};
 
     friend std::ostream& operator<<(std::ostream&, const batch_cache_index&);
 };
@@ -1,4 +1,6 @@
 #pragma once
+#include "config/configuration.h"
+#include "prometheus/prometheus_sanitize.h"
 #include "resource_mgmt/memory_groups.h"
 #include "seastarx.h"
 #include "storage/logger.h"
@@ -9,11 +11,15 @@
 #include <seastar/core/chunked_fifo.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/loop.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/metrics_registration.hh>
 #include <seastar/core/semaphore.hh>
 #include <seastar/util/later.hh>
 
 #include <boost/iterator/counting_iterator.hpp>
 
+#include <algorithm>
+
 namespace storage::internal {
 
 class chunk_cache {
@@ -32,7 +38,8 @@ public:
 
     chunk_cache() noexcept
       : _size_target(memory_groups::chunk_cache_min_memory())
-      , _size_limit(memory_groups::chunk_cache_max_memory()) {}
+      , _size_limit(memory_groups::chunk_cache_max_memory())
+      , _low_watermark(_size_target / 4) {}
 
     chunk_cache(chunk_cache&&) = delete;
     chunk_cache& operator=(chunk_cache&&) = delete;
@@ -41,6 +48,7 @@ public:
     ~chunk_cache() noexcept = default;
 
     ss::future<> start() {
+        setup_metrics();
         const auto num_chunks = memory_groups::chunk_cache_min_memory()
                                 / chunk::chunk_size;
         return ss::do_for_each(
@@ -70,15 +78,41 @@ public:
         if (!_sem.waiters()) {
             return do_get();
         }
+        ++_waits;
         return ss::get_units(_sem, 1).then(
           [this](ss::semaphore_units<>) { return do_get(); });
     }
 
+    /// current soft target grant
+    size_t size_target() const { return _size_target; }
+    /// total bytes allocated by the cache, free list included
+    size_t size_total() const { return _size_total; }
+    /// times a chunk acquisition had to wait for a free chunk
+    uint64_t waits() const { return _waits; }
+
+    /**
+     * Apply a new cache grant. The soft target and its low watermark
+     * follow the grant and the free list is trimmed eagerly on shrink;
+     * the hard limit never drops below its boot value, so inflight
+     * writes above the target keep working while the cache drains.
+     */
+    void set_memory_target(size_t target) {
+        _size_target = target;
+        _size_limit = std::max(_size_limit, target);
+        _low_watermark = _size_target / 4;
+        while (_size_available > _size_target && !_chunks.empty()) {
+            _chunks.pop_front();
+            _size_available -= chunk::chunk_size;
+            _size_total -= chunk::chunk_size;
+        }
+    }
+
 private:
     ss::future<chunk_ptr> do_get() {
         if (auto c = pop_or_allocate(); c) {
             return ss::make_ready_future<chunk_ptr>(c);
         }
+        ++_waits;
         return ss::get_units(_sem, 1).then(
           [this](ss::semaphore_units<>) { return do_get(); });
     }
@@ -89,10 +123,14 @@ private:
             _chunks.pop_front();
             _size_available -= chunk::chunk_size;
             c->reset();
+            // top the free list back up off the hot path so the next
+            // acquisitions find a preallocated chunk
+            maybe_background_refill();
             return c;
         }
         if (_size_total < _size_limit) {
             try {
+                ++_hot_path_allocations;
                 auto c = ss::make_lw_shared<chunk>(alignment);
                 _size_total += chunk::chunk_size;
                 return c;
@@ -103,14 +141,88 @@ private:
         return nullptr;
     }
 
+    /*
+     * when the free list drains below the low watermark a background fiber
+     * allocates it back up to the target, one chunk per reactor poll, so
+     * appenders stop paying for 16KB aligned allocations inline
+     */
+    void maybe_background_refill() {
+        if (
+          _refilling || _size_available >= _low_watermark
+          || _size_total + chunk::chunk_size > _size_limit) {
+            return;
+        }
+        _refilling = true;
+        (void)ss::do_until(
+          [this] {
+              return _size_available >= _size_target
+                     || _size_total + chunk::chunk_size > _size_limit;
+          },
+          [this] {
+              try {
+                  auto c = ss::make_lw_shared<chunk>(alignment);
+                  _size_total += chunk::chunk_size;
+                  add(c);
+              } catch (const std::bad_alloc&) {
+                  return ss::make_exception_future<>(std::current_exception());
+              }
+              return ss::later();
+          })
+          .handle_exception([](const std::exception_ptr& e) {
+              // the hot path falls back to allocating inline
+              vlog(stlog.debug, "chunk cache refill stopped: {}", e);
+          })
+          .finally([this] { _refilling = false; });
+    }
+
+    void setup_metrics() {
+        if (config::shard_local_cfg().disable_metrics()) {
+            return;
+        }
+        namespace sm = ss::metrics;
+        _metrics.add_group(
+          prometheus_sanitize::metrics_name("storage:chunk_cache"),
+          {
+            sm::make_current_bytes(
+              "available_bytes",
+              [this] { return _size_available; },
+              sm::description("Bytes sitting in the chunk free list")),
+            sm::make_current_bytes(
+              "total_bytes",
+              [this] { return _size_total; },
+              sm::description("Total bytes allocated by the chunk cache")),
+            sm::make_total_operations(
+              "hot_path_allocations",
+              [this] { return _hot_path_allocations; },
+              sm::description(
+                "Chunk allocations performed inline on the append path")),
+            sm::make_total_operations(
+              "waits",
+              [this] { return _waits; },
+              sm::description(
+                "Times a chunk acquisition had to wait for a free chunk")),
+          });
+    }
+
     ss::chunked_fifo<chunk_ptr> _chunks;
     ss::semaphore _sem{0};
     size_t _size_available{0};
     size_t _size_total{0};
-    const size_t _size_target;
-    const size_t _size_limit;
+    size_t _size_target;
+    size_t _size_limit;
+    size_t _low_watermark;
+    bool _refilling{false};
+    uint64_t _hot_path_allocations{0};
+    uint64_t _waits{0};
+    ss::metrics::metric_groups _metrics;
 };
 
+/*
+ * the cache is thread local, so chunks are allocated from (and returned to)
+ * the owning shard's memory. seastar binds each shard's allocator to the
+ * NUMA node its cpu lives on, which keeps the append path free of
+ * cross-node chunk traffic on multi-socket machines.
+ */
 inline chunk_cache& chunks() {
     static thread_local chunk_cache cache;
     return cache;
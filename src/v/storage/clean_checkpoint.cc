@@ -0,0 +1,129 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/clean_checkpoint.h"
+
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_parser.h"
+#include "hashing/xx.h"
+#include "reflection/adl.h"
+#include "storage/logger.h"
+#include "vlog.h"
+
+#include <seastar/core/file.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+
+namespace storage {
+
+std::filesystem::path
+clean_checkpoint_path(const ss::sstring& segment_filename) {
+    return std::filesystem::path(segment_filename + ".clean");
+}
+
+static uint64_t clean_checkpoint_checksum(const clean_checkpoint& c) {
+    auto xx = incremental_xxhash64{};
+    xx.update_all(c.last_offset(), c.file_pos);
+    return xx.digest();
+}
+
+ss::future<> write_clean_checkpoint(
+  const ss::sstring& segment_filename, clean_checkpoint c) {
+    auto path = clean_checkpoint_path(segment_filename);
+    return ss::open_file_dma(
+             path.string(),
+             ss::open_flags::create | ss::open_flags::truncate
+               | ss::open_flags::rw)
+      .then([c](ss::file f) {
+          return ss::make_file_output_stream(std::move(f))
+            .then([c](ss::output_stream<char> out) {
+                iobuf b;
+                reflection::serialize(
+                  b,
+                  clean_checkpoint::ondisk_version,
+                  clean_checkpoint_checksum(c),
+                  c.last_offset(),
+                  c.file_pos);
+                return ss::do_with(
+                  std::move(b),
+                  std::move(out),
+                  [](iobuf& buff, ss::output_stream<char>& out) {
+                      return ss::do_for_each(
+                               buff,
+                               [&out](const iobuf::fragment& f) {
+                                   return out.write(f.get(), f.size());
+                               })
+                        .then([&out] { return out.flush(); })
+                        .then([&out] { return out.close(); });
+                  });
+            });
+      });
+}
+
+static std::optional<clean_checkpoint> parse_clean_checkpoint(iobuf b) {
+    iobuf_parser parser(std::move(b));
+    auto version = reflection::adl<int8_t>{}.from(parser);
+    if (version != clean_checkpoint::ondisk_version) {
+        return std::nullopt;
+    }
+    auto checksum = reflection::adl<uint64_t>{}.from(parser);
+    clean_checkpoint retval;
+    retval.last_offset = model::offset(
+      reflection::adl<model::offset::type>{}.from(parser));
+    retval.file_pos = reflection::adl<uint64_t>{}.from(parser);
+    if (unlikely(checksum != clean_checkpoint_checksum(retval))) {
+        return std::nullopt;
+    }
+    return retval;
+}
+
+ss::future<std::optional<clean_checkpoint>>
+read_clean_checkpoint(const ss::sstring& segment_filename) {
+    auto path = clean_checkpoint_path(segment_filename).string();
+    return ss::file_exists(path)
+      .then([path](bool exists) {
+          if (!exists) {
+              return ss::make_ready_future<std::optional<clean_checkpoint>>(
+                std::nullopt);
+          }
+          return ss::open_file_dma(path, ss::open_flags::ro)
+            .then([](ss::file f) {
+                return f.size()
+                  .then([f](uint64_t size) mutable {
+                      return f.dma_read_bulk<char>(0, size);
+                  })
+                  .then([f](ss::temporary_buffer<char> buf) mutable {
+                      return f.close().then([buf = std::move(buf)]() mutable {
+                          iobuf b;
+                          b.append(std::move(buf));
+                          return parse_clean_checkpoint(std::move(b));
+                      });
+                  });
+            });
+      })
+      .handle_exception([path](const std::exception_ptr& e) {
+          vlog(stlog.debug, "error reading clean checkpoint {}: {}", path, e);
+          return std::optional<clean_checkpoint>(std::nullopt);
+      });
+}
+
+ss::future<> remove_clean_checkpoint(const ss::sstring& segment_filename) {
+    auto path = clean_checkpoint_path(segment_filename).string();
+    return ss::remove_file(path).handle_exception(
+      [](const std::exception_ptr&) {
+          // checkpoints are optional; missing files are expected
+      });
+}
+
+std::ostream& operator<<(std::ostream& o, const clean_checkpoint& c) {
+    return o << "{last_offset:" << c.last_offset
+             << ", file_pos:" << c.file_pos << "}";
+}
+
+} // namespace storage
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/sstring.hh>
+
+#include <filesystem>
+#include <optional>
+
+namespace storage {
+
+/**
+ * Sidecar checkpoint describing a prefix of a segment that has been fully
+ * written and fsync'ed. It is persisted next to the segment as
+ * `<segment>.clean` periodically by the append path and when a segment is
+ * sealed. Recovery compares the recorded file position against the actual
+ * segment size: on an exact match the segment is known clean and replay of
+ * the whole file through storage::parser can be skipped; any mismatch
+ * (crash mid-append, truncation) simply falls back to a full replay.
+ */
+struct clean_checkpoint {
+    static constexpr int8_t ondisk_version = 0;
+
+    // last batch offset contained in the clean prefix
+    model::offset last_offset;
+    // segment file size the checkpoint covers
+    uint64_t file_pos{0};
+
+    friend std::ostream& operator<<(std::ostream&, const clean_checkpoint&);
+};
+
+/// `<segment filename>.clean`
+std::filesystem::path
+clean_checkpoint_path(const ss::sstring& segment_filename);
+
+ss::future<>
+write_clean_checkpoint(const ss::sstring& segment_filename, clean_checkpoint);
+
+/// returns nullopt when missing, unparseable or failing its checksum
+ss::future<std::optional<clean_checkpoint>>
+read_clean_checkpoint(const ss::sstring& segment_filename);
+
+/// best effort; a missing file is not an error
+ss::future<> remove_clean_checkpoint(const ss::sstring& segment_filename);
+
+} // namespace storage
@@ -67,11 +67,14 @@ footer_from_stream(ss::input_stream<char>& in) {
 ss::future<> compacted_index_chunk_reader::verify_integrity() {
     reset();
     return load_footer().then([this](compacted_index::footer) {
-        // NOTE: these are *different* options from other methods in this class
+        // NOTE: these are *different* options from other methods in this class.
+        // the crc pass is a pure sequential scan with no entry
+        // materialization, so spend the chunk budget on the stream window
+        // and keep the next windows in flight instead of sipping 4KiB reads
         ss::file_input_stream_options options;
-        options.buffer_size = 4096;
+        options.buffer_size = _max_chunk_memory;
         options.io_priority_class = _iopc;
-        options.read_ahead = 1;
+        options.read_ahead = 4;
         return ss::do_with(
                  int32_t(_footer->size),
                  crc32{},
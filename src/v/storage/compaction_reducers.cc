@@ -13,6 +13,7 @@
 #include "model/record.h"
 #include "model/record_utils.h"
 #include "random/generators.h"
+#include "resource_mgmt/throttle.h"
 #include "storage/index_state.h"
 #include "storage/logger.h"
 #include "storage/parser_utils.h"
@@ -88,6 +89,15 @@ Roaring compaction_key_reducer::end_of_stream() {
     return std::move(_inverted);
 }
 
+ss::future<ss::stop_iteration>
+index_copy_reducer::operator()(compacted_index::entry&& e) {
+    using stop_t = ss::stop_iteration;
+    bytes_view bv = e.key;
+    return _writer->index(bv, e.offset, e.delta).then([k = std::move(e.key)] {
+        return ss::make_ready_future<stop_t>(stop_t::no);
+    });
+}
+
 ss::future<ss::stop_iteration>
 index_filtered_copy_reducer::operator()(compacted_index::entry&& e) {
     using stop_t = ss::stop_iteration;
@@ -103,6 +113,18 @@ index_filtered_copy_reducer::operator()(compacted_index::entry&& e) {
     return ss::make_ready_future<stop_t>(stop_t::no);
 }
 
+ss::future<ss::stop_iteration>
+index_filtered_offset_list_reducer::operator()(compacted_index::entry&& e) {
+    using stop_t = ss::stop_iteration;
+    const bool should_add = _bm.contains(_natural_index);
+    ++_natural_index;
+    if (should_add) {
+        const model::offset o = e.offset + model::offset(e.delta);
+        _list.add(o);
+    }
+    return ss::make_ready_future<stop_t>(stop_t::no);
+}
+
 ss::future<ss::stop_iteration>
 compacted_offset_list_reducer::operator()(compacted_index::entry&& e) {
     using stop_t = ss::stop_iteration;
@@ -218,6 +240,38 @@ copy_data_segment_reducer::filter(model::record_batch&& batch) {
       h, std::move(ret), model::record_batch::tag_ctor_ng{});
     return new_batch;
 }
+ss::future<ss::stop_iteration>
+copy_data_segment_reducer::write_batch(model::record_batch&& b) {
+    using stop_t = ss::stop_iteration;
+    return ss::do_with(
+             std::move(b),
+             [this](model::record_batch& batch) {
+                 auto const start_offset = _appender->file_byte_offset();
+                 auto const header_size = batch.header().size_bytes;
+                 _acc += header_size;
+                 if (_idx.maybe_index(
+                       _acc,
+                       32_KiB,
+                       start_offset,
+                       batch.base_offset(),
+                       batch.last_offset(),
+                       batch.header().first_timestamp,
+                       batch.header().max_timestamp)) {
+                     _acc = 0;
+                 }
+                 return storage::write(*_appender, batch)
+                   .then([this, start_offset, header_size] {
+                       vassert(
+                         _appender->file_byte_offset()
+                           == start_offset + header_size,
+                         "Size must be deterministic. Expected:{} == {}",
+                         _appender->file_byte_offset(),
+                         start_offset + header_size);
+                   });
+             })
+      .then([] { return ss::make_ready_future<stop_t>(stop_t::no); });
+}
+
 ss::future<ss::stop_iteration> copy_data_segment_reducer::do_compaction(
   model::compression original, model::record_batch&& b) {
     using stop_t = ss::stop_iteration;
@@ -225,38 +279,68 @@ ss::future<ss::stop_iteration> copy_data_segment_reducer::do_compaction(
     if (to_copy == std::nullopt) {
         return ss::make_ready_future<stop_t>(stop_t::no);
     }
+    /*
+     * the payload of this partition has proven incompressible; write the
+     * filtered batch back uncompressed instead of paying the codec for
+     * nothing. the policy keeps sampling, so a switch to compressible
+     * data re-enables recompression
+     */
+    if (
+      original != model::compression::none
+      && !_compression_policy.worth_compressing()) {
+        return write_batch(std::move(to_copy.value()));
+    }
+    const auto in_bytes = to_copy->data().size_bytes();
     return compress_batch(original, std::move(to_copy.value()))
-      .then([this](model::record_batch&& b) {
-          return ss::do_with(std::move(b), [this](model::record_batch& batch) {
-              auto const start_offset = _appender->file_byte_offset();
-              auto const header_size = batch.header().size_bytes;
-              _acc += header_size;
-              if (_idx.maybe_index(
-                    _acc,
-                    32_KiB,
-                    start_offset,
-                    batch.base_offset(),
-                    batch.last_offset(),
-                    batch.header().first_timestamp,
-                    batch.header().max_timestamp)) {
-                  _acc = 0;
-              }
-              return storage::write(*_appender, batch)
-                .then([this, start_offset, header_size] {
-                    vassert(
-                      _appender->file_byte_offset()
-                        == start_offset + header_size,
-                      "Size must be deterministic. Expected:{} == {}",
-                      _appender->file_byte_offset(),
-                      start_offset + header_size);
-                });
-          });
-      })
-      .then([] { return ss::make_ready_future<stop_t>(stop_t::no); });
+      .then([this, original, in_bytes](model::record_batch&& b) {
+          if (original != model::compression::none) {
+              _compression_policy.record(in_bytes, b.data().size_bytes());
+          }
+          return write_batch(std::move(b));
+      });
+}
+
+/*
+ * decided from offsets alone, before touching the payload. conservative:
+ * a batch with sparse offset deltas may report false and take the filter
+ * path even though every record survives, which only costs the old
+ * behavior.
+ */
+bool copy_data_segment_reducer::should_keep_entire_batch(
+  const model::record_batch& b) const {
+    for (auto o = b.base_offset(); o <= b.last_offset(); ++o) {
+        if (!_list.contains(o)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 ss::future<ss::stop_iteration>
 copy_data_segment_reducer::operator()(model::record_batch&& b) {
+    // compaction reads and rewrites every surviving batch; pace it
+    // against the shared background throttle so housekeeping cannot
+    // monopolize disk bandwidth
+    return background_throttle::shard_local()
+      .compaction()
+      .acquire(b.size_bytes())
+      .then([this, b = std::move(b)]() mutable {
+          return copy_batch(std::move(b));
+      });
+}
+
+ss::future<ss::stop_iteration>
+copy_data_segment_reducer::copy_batch(model::record_batch&& b) {
+    /*
+     * a batch whose every offset survives compaction is copied through
+     * byte-for-byte. compressed batches in particular skip the
+     * decompress/filter/recompress cycle and their original payload lands
+     * in the new segment untouched - only batches that actually lose
+     * records pay for decompression.
+     */
+    if (should_keep_entire_batch(b)) {
+        return write_batch(std::move(b));
+    }
     const auto comp = b.header().attrs.compression();
     if (!b.compressed()) {
         return do_compaction(comp, std::move(b));
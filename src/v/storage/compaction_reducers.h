@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "compression/adaptive_policy.h"
 #include "model/record_batch_reader.h"
 #include "storage/compacted_index.h"
 #include "storage/compacted_index_writer.h"
@@ -61,6 +62,21 @@ private:
     uint32_t _natural_index{0};
 };
 
+/// Copies every entry of the input reader into the writer unchanged. Used
+/// to merge the raw indexes of adjacent segments so their combined
+/// self-compaction can dedup from the indexes instead of re-reading data
+class index_copy_reducer : public compaction_reducer {
+public:
+    explicit index_copy_reducer(compacted_index_writer& w)
+      : _writer(&w) {}
+
+    ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
+    void end_of_stream() {}
+
+private:
+    compacted_index_writer* _writer;
+};
+
 /// This class copies the input reader into the writer consulting the bitmap of
 /// wether ot keep the entry or not
 class index_filtered_copy_reducer : public compaction_reducer {
@@ -78,6 +94,26 @@ private:
     compacted_index_writer* _writer;
 };
 
+/// Builds the compacted offset list directly from the *raw* index,
+/// consulting the natural-index bitmap so the result matches what
+/// index_filtered_copy_reducer writes into the clean index. This lets the
+/// clean-index rewrite and the data copy run off a single key-reduction
+/// pass instead of re-reading the clean index from disk.
+class index_filtered_offset_list_reducer : public compaction_reducer {
+public:
+    index_filtered_offset_list_reducer(Roaring b, model::offset base)
+      : _bm(std::move(b))
+      , _list(base, Roaring{}) {}
+
+    ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
+    compacted_offset_list end_of_stream() { return std::move(_list); }
+
+private:
+    uint32_t _natural_index = 0;
+    Roaring _bm;
+    compacted_offset_list _list;
+};
+
 class compacted_offset_list_reducer : public compaction_reducer {
 public:
     explicit compacted_offset_list_reducer(model::offset base)
@@ -100,19 +136,25 @@ public:
     storage::index_state end_of_stream() { return std::move(_idx); }
 
 private:
+    ss::future<ss::stop_iteration> copy_batch(model::record_batch&&);
     ss::future<ss::stop_iteration>
     do_compaction(model::compression, model::record_batch&&);
+    ss::future<ss::stop_iteration> write_batch(model::record_batch&&);
 
     bool should_keep(model::offset base, int32_t delta) const {
         const auto o = base + model::offset(delta);
         return _list.contains(o);
     }
+    bool should_keep_entire_batch(const model::record_batch&) const;
     std::optional<model::record_batch> filter(model::record_batch&&);
 
     compacted_offset_list _list;
     segment_appender* _appender;
     index_state _idx;
     size_t _acc{0};
+    // one policy per compacted segment: batches of a partition tend to
+    // share a payload shape, so the observed ratio predicts the next batch
+    compression::adaptive_policy _compression_policy;
 };
 
 class index_rebuilder_reducer : public compaction_reducer {
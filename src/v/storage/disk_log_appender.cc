@@ -136,10 +136,14 @@ ss::future<append_result> disk_log_appender::end_of_stream() {
       .byte_size = _byte_size,
       .last_term = _last_term};
     if (_config.should_fsync == storage::log_append_config::fsync::no) {
+        _log.get_probe().add_append_latency(log_clock::now() - _append_time);
         return ss::make_ready_future<append_result>(retval);
     }
     return _log.flush().then([this, retval] {
         release_lock();
+        // measured after the flush so fsynced appends attribute the sync
+        // cost to themselves
+        _log.get_probe().add_append_latency(log_clock::now() - _append_time);
         return retval;
     });
 }
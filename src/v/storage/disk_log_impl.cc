@@ -19,6 +19,7 @@
 #include "storage/logger.h"
 #include "storage/offset_assignment.h"
 #include "storage/offset_to_filepos_consumer.h"
+#include "storage/remote_fetcher.h"
 #include "storage/segment_set.h"
 #include "storage/segment_utils.h"
 #include "storage/types.h"
@@ -35,9 +36,11 @@
 #include <seastar/core/seastar.hh>
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/shared_ptr.hh>
+#include <seastar/core/when_all.hh>
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <iterator>
 
 using namespace std::literals::chrono_literals;
@@ -52,7 +55,9 @@ disk_log_impl::disk_log_impl(
   , _kvstore(kvstore)
   , _start_offset(read_start_offset())
   , _lock_mngr(_segs)
-  , _max_segment_size(internal::jitter_segment_size(max_segment_size())) {
+  , _max_segment_size(internal::jitter_segment_size(max_segment_size()))
+  , _readers_cache(
+      std::make_unique<readers_cache>(this->config().ntp(), _probe)) {
     const bool is_compacted = config().is_compacted();
     for (auto& s : _segs) {
         _probe.add_initial_segment(*s);
@@ -60,6 +65,9 @@ disk_log_impl::disk_log_impl(
             s->mark_as_compacted_segment();
         }
     }
+    if (_manager.config().sampled_attribution) {
+        _probe.enable_attribution();
+    }
     _probe.setup_metrics(this->config().ntp());
 }
 disk_log_impl::~disk_log_impl() {
@@ -69,6 +77,9 @@ disk_log_impl::~disk_log_impl() {
 ss::future<> disk_log_impl::remove() {
     vassert(!_closed, "Invalid double closing of log - {}", *this);
     _closed = true;
+    return _readers_cache->stop().then([this] { return do_remove(); });
+}
+ss::future<> disk_log_impl::do_remove() {
     // gets all the futures started in the background
     std::vector<ss::future<>> permanent_delete;
     permanent_delete.reserve(_segs.size());
@@ -88,6 +99,11 @@ ss::future<> disk_log_impl::remove() {
           return _kvstore.remove(
             kvstore::key_space::storage,
             internal::start_offset_key(config().ntp()));
+      })
+      .then([this] {
+          return _kvstore.remove(
+            kvstore::key_space::storage,
+            internal::segment_manifest_key(config().ntp()));
       });
 }
 ss::future<> disk_log_impl::close() {
@@ -98,9 +114,13 @@ ss::future<> disk_log_impl::close() {
       && !_eviction_monitor->promise.get_future().available()) {
         _eviction_monitor->promise.set_exception(segment_closed_exception());
     }
-    return ss::parallel_for_each(_segs, [](ss::lw_shared_ptr<segment>& h) {
-        return h->close().handle_exception([h](std::exception_ptr e) {
-            vlog(stlog.error, "Error closing segment:{} - {}", e, h);
+    // cached readers hold segment read locks and open handles; release
+    // them before the segments themselves are closed
+    return _readers_cache->stop().then([this] {
+        return ss::parallel_for_each(_segs, [](ss::lw_shared_ptr<segment>& h) {
+            return h->close().handle_exception([h](std::exception_ptr e) {
+                vlog(stlog.error, "Error closing segment:{} - {}", e, h);
+            });
         });
     });
 }
@@ -152,6 +172,25 @@ model::offset disk_log_impl::time_based_gc_max_offset(model::timestamp time) {
     return (*it)->offsets().committed_offset;
 }
 
+std::optional<model::timestamp> disk_log_impl::retention_eligible_at(
+  std::optional<size_t> retention_bytes) const {
+    if (config().is_compacted()) {
+        // compaction work appears whenever a segment rolls; these stay
+        // on the periodic cycle
+        return model::timestamp(0);
+    }
+    if (_segs.size() <= 1) {
+        // gc never touches the active segment
+        return std::nullopt;
+    }
+    if (retention_bytes && _probe.partition_size() > *retention_bytes) {
+        return model::timestamp(0);
+    }
+    // the front segment becomes evictable once its newest batch falls
+    // behind the retention threshold
+    return _segs.front()->index().max_timestamp();
+}
+
 ss::future<model::offset>
 disk_log_impl::monitor_eviction(ss::abort_source& as) {
     if (_eviction_monitor) {
@@ -199,40 +238,55 @@ ss::future<> disk_log_impl::garbage_collect_segments(
 
     max_offset = std::min(max_offset, _max_collectible_offset);
 
-    return ss::do_until(
-      [this, as, max_offset] {
-          return _segs.size() <= 1 || as->abort_requested()
-                 || _segs.front()->offsets().committed_offset > max_offset;
-      },
-      [this, ctx] {
-          auto ptr = _segs.front();
-          // we have to use std::max in here to prevent start_offset from being
-          // `moved backward`. The _kvstore.put calls may be reordered and we do
-          // not want to update kvstore with stall data. We leverage the fact
-          // that start_offsets updates are monotonically increasing.
-          auto start_offset = std::max(
-            ptr->offsets().dirty_offset + model::offset(1),
-            read_start_offset());
-
-          return _kvstore
-            .put(
-              kvstore::key_space::storage,
-              internal::start_offset_key(config().ntp()),
-              reflection::to_iobuf(start_offset))
-            .then([this, ptr, ctx] {
-                if (!is_front_segment(ptr)) {
-                    return ss::now();
-                }
-                _segs.pop_front();
-                return remove_segment_permanently(ptr, ctx);
-            })
-            .then([this] {
-                // we have to update start offset with the most recent offset as
-                // updates to kv store _start_offset may have been reordered (we
-                // execute then independently from `gc` and `prefix_truncate`
-                // apis)
-                _start_offset = read_start_offset();
+    // gather the whole evictable prefix up front so the new start
+    // offset is persisted with a single kvstore write per gc pass
+    // instead of one write per collected segment
+    std::vector<ss::lw_shared_ptr<segment>> victims;
+    for (const auto& ptr : _segs) {
+        if (victims.size() + 1 >= _segs.size()) {
+            break; // never collect the active segment
+        }
+        if (ptr->offsets().committed_offset > max_offset) {
+            break;
+        }
+        victims.push_back(ptr);
+    }
+    if (victims.empty()) {
+        return ss::now();
+    }
+    // we have to use std::max in here to prevent start_offset from being
+    // `moved backward`. The _kvstore.put calls may be reordered and we do
+    // not want to update kvstore with stall data. We leverage the fact
+    // that start_offsets updates are monotonically increasing.
+    auto start_offset = std::max(
+      victims.back()->offsets().dirty_offset + model::offset(1),
+      read_start_offset());
+
+    return _kvstore
+      .put(
+        kvstore::key_space::storage,
+        internal::start_offset_key(config().ntp()),
+        reflection::to_iobuf(start_offset))
+      .then([this, victims = std::move(victims), as, ctx]() mutable {
+          return ss::do_with(
+            std::move(victims),
+            [this, as, ctx](std::vector<ss::lw_shared_ptr<segment>>& victims) {
+                return ss::do_for_each(
+                  victims, [this, as, ctx](ss::lw_shared_ptr<segment>& ptr) {
+                      if (as->abort_requested() || !is_front_segment(ptr)) {
+                          return ss::now();
+                      }
+                      _segs.pop_front();
+                      return remove_segment_permanently(ptr, ctx);
+                  });
             });
+      })
+      .then([this] {
+          // we have to update start offset with the most recent offset as
+          // updates to kv store _start_offset may have been reordered (we
+          // execute then independently from `gc` and `prefix_truncate`
+          // apis)
+          _start_offset = read_start_offset();
       });
 }
 
@@ -368,6 +422,18 @@ ss::future<> disk_log_impl::compact_adjacent_segments(
     auto replacement = co_await storage::internal::make_concatenated_segment(
       staging_path, segments, cfg);
 
+    // merge the source segments' raw compacted indexes into the
+    // replacement's index. when it succeeds self-compaction dedups from
+    // the merged index directly; otherwise the index is missing and gets
+    // rebuilt the expensive way, by re-reading the concatenated data
+    auto merged_index = co_await storage::internal::try_merge_compacted_indexes(
+      internal::compacted_index_path(staging_path), segments, cfg);
+    vlog(
+      stlog.debug,
+      "merged compacted indexes into {}: {}",
+      staging_path,
+      merged_index);
+
     // compact the combined data in the replacement segment. the partition size
     // tracking needs to be adjusted as compaction routines assume the segment
     // size is already contained in the partition size probe
@@ -429,6 +495,13 @@ ss::future<> disk_log_impl::compact_adjacent_segments(
 }
 
 ss::future<> disk_log_impl::compact(compaction_config cfg) {
+    // cached readers pin segment read locks that collection and
+    // compaction take for writing, so release them up front
+    return _readers_cache->evict_all().then(
+      [this, cfg] { return do_compact_and_gc(cfg); });
+}
+
+ss::future<> disk_log_impl::do_compact_and_gc(compaction_config cfg) {
     ss::future<> f = ss::now();
     if (config().is_collectable()) {
         f = gc(cfg);
@@ -546,11 +619,43 @@ offset_stats disk_log_impl::offsets() const {
     };
 }
 
+/*
+ * size the fallocation step from the partition's recent append rate:
+ * reserve roughly enough for the next few seconds of appends. hot
+ * partitions converge toward max_fallocation_step and fallocate rarely,
+ * while idle partitions stop reserving space they will not use (which
+ * inflates used-disk accounting until the final truncate-on-roll). a
+ * partition with no recorded history gets the static default.
+ */
+size_t disk_log_impl::falloc_step_for_new_segment() {
+    // at the 32MiB default this corresponds to a 2MiB/s partition
+    constexpr uint64_t horizon_secs = 16;
+    const uint64_t rate = _probe.append_rate_bps();
+    if (rate == 0) {
+        // calibration-seeded default until the partition shows demand
+        return _manager.config().initial_fallocation_step;
+    }
+    const size_t step = std::clamp<size_t>(
+      rate * horizon_secs,
+      segment_appender::min_fallocation_step,
+      segment_appender::max_fallocation_step);
+    // never reserve past the roll threshold
+    return std::min(step, max_segment_size());
+}
+
 ss::future<> disk_log_impl::new_segment(
   model::offset o, model::term_id t, ss::io_priority_class pc) {
     vassert(
       o() >= 0 && t() >= 0, "offset:{} and term:{} must be initialized", o, t);
-    return _manager.make_log_segment(config(), o, t, pc)
+    return _manager
+      .make_log_segment(
+        config(),
+        o,
+        t,
+        pc,
+        record_version_type::v1,
+        default_segment_readahead_size,
+        falloc_step_for_new_segment())
       .then([this](ss::lw_shared_ptr<segment> handles) mutable {
           return remove_empty_segments().then(
             [this, h = std::move(handles)]() mutable {
@@ -558,8 +663,29 @@ ss::future<> disk_log_impl::new_segment(
                 if (config().is_compacted()) {
                     h->mark_as_compacted_segment();
                 }
+                /*
+                 * reserve the first fallocation step in the background so
+                 * the first append into the fresh segment does not stall
+                 * on file metadata I/O. the shared pointer keeps the
+                 * segment alive for the duration of the call.
+                 */
+                (void)h->appender().prefallocate().handle_exception(
+                  [h](const std::exception_ptr& e) {
+                      vlog(
+                        stlog.warn,
+                        "background prefallocation failed for {}: {}",
+                        *h,
+                        e);
+                  });
                 _segs.add(std::move(h));
                 _probe.segment_created();
+                /*
+                 * record the new file before any append lands in it: a
+                 * crash in between leaves at worst an empty orphan on
+                 * disk, never data missing from the manifest
+                 */
+                return internal::persist_segment_manifest(
+                  _kvstore, config().ntp(), _segs);
             });
       });
 }
@@ -636,9 +762,36 @@ ss::future<> disk_log_impl::force_roll(ss::io_priority_class iopc) {
     if (!ptr->has_appender()) {
         return new_segment(next_offset, t, iopc);
     }
-    return ptr->release_appender().then([this, next_offset, t, iopc] {
-        return new_segment(next_offset, t, iopc);
-    });
+    return roll_segment(ptr, next_offset, t, iopc);
+}
+
+/*
+ * releasing the old appender (flush + close) does not gate creation of the
+ * successor segment, so for a non-empty segment the two run concurrently
+ * and a roll costs max(release, create) instead of the sum. an empty
+ * segment must be released first because new_segment's
+ * remove_empty_segments pass closes and drops it.
+ */
+ss::future<> disk_log_impl::roll_segment(
+  ss::lw_shared_ptr<segment> ptr,
+  model::offset next_offset,
+  model::term_id t,
+  ss::io_priority_class iopc) {
+    if (ptr->empty()) {
+        return ptr->release_appender().then([this, next_offset, t, iopc] {
+            return new_segment(next_offset, t, iopc);
+        });
+    }
+    return ss::when_all(
+             ptr->release_appender(), new_segment(next_offset, t, iopc))
+      .then([](std::tuple<ss::future<>, ss::future<>> fs) {
+          auto& [release, create] = fs;
+          if (release.failed()) {
+              create.ignore_ready_future();
+              return std::move(release);
+          }
+          return std::move(create);
+      });
 }
 
 ss::future<> disk_log_impl::maybe_roll(
@@ -657,9 +810,7 @@ ss::future<> disk_log_impl::maybe_roll(
         size_should_roll = true;
     }
     if (t != term() || size_should_roll) {
-        return ptr->release_appender().then([this, next_offset, t, iopc] {
-            return new_segment(next_offset, t, iopc);
-        });
+        return roll_segment(ptr, next_offset, t, iopc);
     }
     return ss::make_ready_future<>();
 }
@@ -674,17 +825,50 @@ disk_log_impl::make_unchecked_reader(log_reader_config config) {
       });
 }
 
+ss::future<model::record_batch_reader>
+disk_log_impl::make_cached_reader(log_reader_config config) {
+    if (auto cached = _readers_cache->get(config); cached) {
+        return ss::make_ready_future<model::record_batch_reader>(
+          std::move(*cached));
+    }
+    return _lock_mngr.range_lock(config).then(
+      [this, cfg = config](std::unique_ptr<lock_manager::lease> lease) {
+          return _readers_cache->wrap(
+            std::make_unique<log_reader>(std::move(lease), cfg, _probe));
+      });
+}
+
 ss::future<model::record_batch_reader>
 disk_log_impl::make_reader(log_reader_config config) {
     vassert(!_closed, "make_reader on closed log - {}", *this);
     if (config.start_offset < _start_offset) {
+        if (auto* fetcher = _manager.remote_fetch_hook();
+            fetcher != nullptr) {
+            // cap the remote read at the local log start; once the
+            // consumer catches up its next fetch is served locally
+            config.max_offset = std::min(
+              config.max_offset, _start_offset - model::offset(1));
+            return fetcher->fetch(this->config().ntp(), config)
+              .then([this, config](
+                      std::optional<model::record_batch_reader> reader) {
+                  if (reader) {
+                      return ss::make_ready_future<model::record_batch_reader>(
+                        std::move(*reader));
+                  }
+                  return ss::make_exception_future<model::record_batch_reader>(
+                    std::runtime_error(fmt::format(
+                      "Reader cannot read before start of the log {} < {}",
+                      config.start_offset,
+                      _start_offset)));
+              });
+        }
         return ss::make_exception_future<model::record_batch_reader>(
           std::runtime_error(fmt::format(
             "Reader cannot read before start of the log {} < {}",
             config.start_offset,
             _start_offset)));
     }
-    return make_unchecked_reader(config);
+    return make_cached_reader(config);
 }
 
 ss::future<model::record_batch_reader>
@@ -694,9 +878,16 @@ disk_log_impl::make_reader(timequery_config config) {
       [this, cfg = config](std::unique_ptr<lock_manager::lease> lease) {
           auto start_offset = _start_offset;
           if (!lease->range.empty()) {
+              const auto& front = *lease->range.begin();
               // adjust for partial visibility of segment prefix
               start_offset = std::max(
-                start_offset, (*lease->range.begin())->offsets().base_offset);
+                start_offset, front->offsets().base_offset);
+              // skip ahead to the indexed batch nearest to (but not past)
+              // the queried timestamp, so the reader parses at most one
+              // index step worth of batches instead of the whole segment
+              if (auto e = front->index().find_nearest(cfg.time); e) {
+                  start_offset = std::max(start_offset, e->offset);
+              }
           }
           log_reader_config config(
             start_offset,
@@ -763,6 +954,14 @@ ss::future<> disk_log_impl::remove_segment_permanently(
       .handle_exception([s](std::exception_ptr e) {
           vlog(stlog.error, "Cannot close segment: {} - {}", e, s);
       })
+      .then([this] {
+          // during full log removal the manifest key itself is deleted
+          if (_closed) {
+              return ss::now();
+          }
+          return internal::persist_segment_manifest(
+            _kvstore, config().ntp(), _segs);
+      })
       .finally([s] {});
 }
 
@@ -807,13 +1006,16 @@ ss::future<> disk_log_impl::do_truncate_prefix(truncate_prefix_config cfg) {
     }
 
     /*
-     * Persist the desired starting offset
+     * Release cached readers before segments are deleted out from under
+     * them, then persist the desired starting offset
      */
-    return _kvstore
-      .put(
-        kvstore::key_space::storage,
-        internal::start_offset_key(config().ntp()),
-        reflection::to_iobuf(cfg.start_offset))
+    return _readers_cache->evict_all()
+      .then([this, cfg] {
+          return _kvstore.put(
+            kvstore::key_space::storage,
+            internal::start_offset_key(config().ntp()),
+            reflection::to_iobuf(cfg.start_offset));
+      })
       .then([this, cfg] {
           /*
            * Then delete all segments (potentially including the active segment)
@@ -882,6 +1084,12 @@ ss::future<> disk_log_impl::do_truncate(truncate_config cfg) {
     if (_segs.empty()) {
         return ss::make_ready_future<>();
     }
+    // readers parked in the cache hold cursors into segments this
+    // truncation is about to rewrite or delete
+    return _readers_cache->evict_all().then(
+      [this, cfg]() mutable { return do_unchecked_truncate(cfg); });
+}
+ss::future<> disk_log_impl::do_unchecked_truncate(truncate_config cfg) {
     cfg.base_offset = std::max(cfg.base_offset, _start_offset);
     // Note different from the stats variable above because
     // we want to delete even empty segments.
@@ -19,6 +19,7 @@
 #include "storage/log.h"
 #include "storage/log_reader.h"
 #include "storage/probe.h"
+#include "storage/readers_cache.h"
 #include "storage/segment_appender.h"
 #include "storage/segment_reader.h"
 #include "storage/types.h"
@@ -52,6 +53,13 @@ public:
     ss::future<model::offset> monitor_eviction(ss::abort_source&) final;
     void set_collectible_offset(model::offset) final;
 
+    std::vector<attribution_sample> attribution_samples() const final {
+        return _probe.attribution_samples();
+    }
+
+    std::optional<model::timestamp>
+    retention_eligible_at(std::optional<size_t>) const final;
+
     ss::future<model::record_batch_reader> make_reader(log_reader_config) final;
     ss::future<model::record_batch_reader> make_reader(timequery_config);
     // External synchronization: only one append can be performed at a time.
@@ -72,6 +80,7 @@ public:
     ss::future<> force_roll(ss::io_priority_class);
 
     probe& get_probe() { return _probe; }
+    readers_cache& reader_cache() { return *_readers_cache; }
     model::term_id term() const;
     segment_set& segments() { return _segs; }
     const segment_set& segments() const { return _segs; }
@@ -85,8 +94,13 @@ private:
     ss::future<model::record_batch_reader>
       make_unchecked_reader(log_reader_config);
 
+    ss::future<model::record_batch_reader>
+      make_cached_reader(log_reader_config);
+
     model::offset read_start_offset() const;
 
+    ss::future<> do_remove();
+    ss::future<> do_compact_and_gc(compaction_config);
     ss::future<> do_compact(compaction_config);
     ss::future<> compact_adjacent_segments(
       std::pair<segment_set::iterator, segment_set::iterator>,
@@ -106,7 +120,16 @@ private:
       model::term_id term_for_this_segment,
       ss::io_priority_class prio);
 
+    size_t falloc_step_for_new_segment();
+
+    ss::future<> roll_segment(
+      ss::lw_shared_ptr<segment>,
+      model::offset next_offset,
+      model::term_id,
+      ss::io_priority_class);
+
     ss::future<> do_truncate(truncate_config);
+    ss::future<> do_unchecked_truncate(truncate_config);
     ss::future<> remove_full_segments(model::offset o);
 
     ss::future<> do_truncate_prefix(truncate_prefix_config);
@@ -140,6 +163,9 @@ private:
     std::optional<eviction_monitor> _eviction_monitor;
     model::offset _max_collectible_offset;
     size_t _max_segment_size;
+    // unique_ptr so cached readers keep a stable back pointer even if the
+    // log impl is moved
+    std::unique_ptr<readers_cache> _readers_cache;
 };
 
 } // namespace storage
@@ -0,0 +1,175 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/hydrated_segment_cache.h"
+
+#include "storage/logger.h"
+#include "utils/directory_walker.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/smp.hh>
+
+#include <algorithm>
+
+namespace storage {
+
+static constexpr std::string_view partial_suffix = ".part";
+
+hydrated_segment_cache::hydrated_segment_cache(
+  ss::sstring base_dir, size_t max_bytes) noexcept
+  : _dir(ss::format("{}/shard_{}", base_dir, ss::this_shard_id()))
+  , _max_bytes(std::max<size_t>(1, max_bytes / ss::smp::count)) {}
+
+std::filesystem::path
+hydrated_segment_cache::file_path(const ss::sstring& key) const {
+    auto name = key;
+    std::replace(name.begin(), name.end(), '/', '_');
+    return std::filesystem::path(_dir.c_str()) / name.c_str();
+}
+
+void hydrated_segment_cache::index(ss::sstring key, size_t size_bytes) {
+    auto it = _lru.insert(_lru.end(), key);
+    _entries.emplace(
+      std::move(key), entry{.size_bytes = size_bytes, .lru_it = it});
+    _total_bytes += size_bytes;
+}
+
+ss::future<> hydrated_segment_cache::ensure_started() {
+    return _init_lock.with([this] {
+        if (_started) {
+            return ss::make_ready_future<>();
+        }
+        return ss::recursive_touch_directory(_dir)
+          .then([this] {
+              return directory_walker::walk(
+                _dir, [this](ss::directory_entry de) {
+                    auto path = ss::format("{}/{}", _dir, de.name);
+                    if (std::string_view(de.name).ends_with(partial_suffix)) {
+                        // download interrupted by a restart
+                        return ss::remove_file(path);
+                    }
+                    // recovered entries land in arbitrary LRU order; a
+                    // flat name can not be mapped back to its object
+                    // key, so they are indexed under the file name and
+                    // age out normally but never hit. acceptable: the
+                    // budget is enforced either way
+                    return ss::file_size(path).then(
+                      [this, name = de.name](uint64_t size) {
+                          index(name, size);
+                      });
+                });
+          })
+          .then([this] {
+              vlog(
+                stlog.info,
+                "hydrated segment cache at {} recovered {} files, {} bytes",
+                _dir,
+                _entries.size(),
+                _total_bytes);
+              _started = true;
+          });
+    });
+}
+
+ss::future<ss::file>
+hydrated_segment_cache::get(ss::sstring key, hydrate_func fetch) {
+    return ss::with_gate(
+      _gate, [this, key{std::move(key)}, fetch{std::move(fetch)}]() mutable {
+          return ensure_started().then(
+            [this, key{std::move(key)}, fetch{std::move(fetch)}]() mutable {
+                return do_get(std::move(key), std::move(fetch));
+            });
+      });
+}
+
+ss::future<ss::file>
+hydrated_segment_cache::do_get(ss::sstring key, hydrate_func fetch) {
+    if (auto it = _entries.find(key); it != _entries.end()) {
+        _lru.splice(_lru.end(), _lru, it->second.lru_it);
+        return ss::open_file_dma(
+          file_path(key).string(), ss::open_flags::ro);
+    }
+    if (auto it = _inflight.find(key); it != _inflight.end()) {
+        // someone is already downloading this segment; wait for it and
+        // serve the cached copy
+        auto download = it->second;
+        return download->get_shared_future().then(
+          [this, key{std::move(key)}, fetch{std::move(fetch)}]() mutable {
+              return do_get(std::move(key), std::move(fetch));
+          });
+    }
+    auto download = ss::make_lw_shared<ss::shared_promise<>>();
+    _inflight.emplace(key, download);
+    return hydrate(key, std::move(fetch))
+      .then_wrapped([this, key{std::move(key)}, download](ss::future<> f) {
+          _inflight.erase(key);
+          if (f.failed()) {
+              auto e = f.get_exception();
+              download->set_exception(e);
+              return ss::make_exception_future<ss::file>(e);
+          }
+          download->set_value();
+          return ss::open_file_dma(
+            file_path(key).string(), ss::open_flags::ro);
+      });
+}
+
+ss::future<>
+hydrated_segment_cache::hydrate(ss::sstring key, hydrate_func fetch) {
+    auto final_path = file_path(key).string();
+    auto part_path = final_path + ss::sstring(partial_suffix);
+    vlog(stlog.debug, "hydrating {} into {}", key, final_path);
+    auto flags = ss::open_flags::wo | ss::open_flags::create
+                 | ss::open_flags::truncate;
+    auto f = co_await ss::open_file_dma(part_path, flags);
+    auto out = co_await ss::make_file_output_stream(std::move(f));
+    std::exception_ptr eptr;
+    try {
+        co_await fetch(out);
+        co_await out.flush();
+    } catch (...) {
+        eptr = std::current_exception();
+    }
+    co_await out.close();
+    if (eptr) {
+        co_await ss::remove_file(part_path);
+        std::rethrow_exception(eptr);
+    }
+    co_await ss::rename_file(part_path, final_path);
+    auto size = co_await ss::file_size(final_path);
+    index(key, size);
+    co_await maybe_evict(key);
+}
+
+ss::future<>
+hydrated_segment_cache::maybe_evict(const ss::sstring& keep) {
+    return ss::repeat([this, keep] {
+        if (_total_bytes <= _max_bytes || _lru.empty() || _lru.front() == keep) {
+            return ss::make_ready_future<ss::stop_iteration>(
+              ss::stop_iteration::yes);
+        }
+        auto victim = _lru.front();
+        auto it = _entries.find(victim);
+        _total_bytes -= it->second.size_bytes;
+        _lru.pop_front();
+        _entries.erase(it);
+        vlog(stlog.debug, "evicting hydrated segment {}", victim);
+        // open readers keep the unlinked data alive until they close
+        return ss::remove_file(file_path(victim).string()).then([] {
+            return ss::stop_iteration::no;
+        });
+    });
+}
+
+ss::future<> hydrated_segment_cache::stop() { return _gate.close(); }
+
+} // namespace storage
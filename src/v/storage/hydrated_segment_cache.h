@@ -0,0 +1,95 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+#include "utils/mutex.h"
+
+#include <seastar/core/file.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/iostream.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <filesystem>
+#include <list>
+
+namespace storage {
+
+/// \brief Shard-local disk cache of segments hydrated from object
+/// storage.
+///
+/// Each shard manages its own subdirectory ("shard_<n>") under the
+/// configured cache directory with an even share of the disk budget, so
+/// shards never coordinate. Entries are whole segment files keyed by
+/// the archived object key. Eviction is LRU on last access; an evicted
+/// file is simply unlinked, which is safe while a reader still holds it
+/// open - the data lives until the last handle closes.
+///
+/// Concurrent misses on one key share a single download: the first
+/// request hydrates, the rest wait on it and then open the cached copy.
+class hydrated_segment_cache {
+public:
+    /// Streams the remote object body into the supplied stream. The
+    /// cache flushes and closes the stream.
+    using hydrate_func
+      = ss::noncopyable_function<ss::future<>(ss::output_stream<char>&)>;
+
+    hydrated_segment_cache(ss::sstring base_dir, size_t max_bytes) noexcept;
+
+    /// Open the cached copy of \p key for reading, hydrating it with
+    /// \p fetch on a miss.
+    ss::future<ss::file> get(ss::sstring key, hydrate_func fetch);
+
+    ss::future<> stop();
+
+    size_t disk_usage() const { return _total_bytes; }
+    size_t size() const { return _entries.size(); }
+
+private:
+    struct entry {
+        size_t size_bytes;
+        std::list<ss::sstring>::iterator lru_it;
+    };
+
+    /// first use creates the shard directory and indexes files left
+    /// over from a previous run (removing incomplete downloads)
+    ss::future<> ensure_started();
+    ss::future<ss::file> do_get(ss::sstring key, hydrate_func fetch);
+    // takes its own copy of the key: the coroutine can outlive the
+    // caller's frame
+    ss::future<> hydrate(ss::sstring key, hydrate_func fetch);
+    ss::future<> maybe_evict(const ss::sstring& keep);
+    void index(ss::sstring key, size_t size_bytes);
+
+    /// object keys contain '/'; entries are stored flat
+    std::filesystem::path file_path(const ss::sstring& key) const;
+
+    ss::sstring _dir;
+    size_t _max_bytes;
+    bool _started{false};
+    mutex _init_lock;
+    size_t _total_bytes{0};
+    // _lru front is the eviction candidate, back the most recent
+    std::list<ss::sstring> _lru;
+    absl::flat_hash_map<ss::sstring, entry> _entries;
+    absl::flat_hash_map<ss::sstring, ss::lw_shared_ptr<ss::shared_promise<>>>
+      _inflight;
+    ss::gate _gate;
+};
+
+} // namespace storage
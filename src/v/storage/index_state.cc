@@ -72,8 +72,15 @@ bool index_state::maybe_index(
     // offsets ourselves and it would be a bug otherwise - see assert above
     max_offset = batch_max_offset;
     max_timestamp = std::max(max_timestamp, last_timestamp);
+    // densify the time axis for slow producers; see
+    // max_time_between_entries_ms
+    const bool time_stale
+      = !empty()
+        && last_timestamp() - base_timestamp()
+               - int64_t(relative_time_index.back())
+             >= max_time_between_entries_ms;
     // always saving the first batch simplifies a lot of book keeping
-    if (accumulator >= step || retval) {
+    if (accumulator >= step || time_stale || retval) {
         // We know that a segment cannot be > 4GB
         add_entry(
           batch_base_offset() - base_offset(),
@@ -177,6 +184,55 @@ std::optional<index_state> index_state::hydrate_from_buffer(iobuf b) {
     return retval;
 }
 
+std::optional<index_state>
+index_state::hydrate_header_from_buffer(iobuf b, size_t file_size) {
+    iobuf_parser parser(std::move(b));
+    index_state retval;
+
+    size_t expected_size_adjustment = 0;
+    auto version = reflection::adl<int8_t>{}.from(parser);
+    switch (version) {
+    case index_state::ondisk_version:
+        break;
+    case 1:
+        // see hydrate_from_buffer for the version 1 size quirk
+        expected_size_adjustment = 4;
+        break;
+    default:
+        vlog(
+          stlog.debug,
+          "Forcing index rebuild for unknown or unsupported version {}",
+          version);
+        return std::nullopt;
+    }
+
+    retval.size = reflection::adl<uint32_t>{}.from(parser);
+    const auto expected_size = retval.size + expected_size_adjustment;
+    const auto payload_size = file_size - sizeof(int8_t) - sizeof(uint32_t);
+    if (unlikely(payload_size != expected_size)) {
+        vlog(
+          stlog.debug,
+          "Index size does not match header size. Got:{}, expected:{}",
+          payload_size,
+          expected_size);
+        return std::nullopt;
+    }
+
+    retval.checksum = reflection::adl<uint64_t>{}.from(parser);
+    retval.bitflags = reflection::adl<uint32_t>{}.from(parser);
+    retval.base_offset = model::offset(
+      reflection::adl<model::offset::type>{}.from(parser));
+    retval.max_offset = model::offset(
+      reflection::adl<model::offset::type>{}.from(parser));
+    retval.base_timestamp = model::timestamp(
+      reflection::adl<model::timestamp::type>{}.from(parser));
+    retval.max_timestamp = model::timestamp(
+      reflection::adl<model::timestamp::type>{}.from(parser));
+    // entry columns are intentionally not decoded; the checksum covering
+    // them is verified when they are hydrated on first lookup
+    return retval;
+}
+
 iobuf index_state::checksum_and_serialize() {
     iobuf out;
     vassert(
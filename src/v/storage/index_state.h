@@ -14,6 +14,7 @@
 #include "bytes/iobuf.h"
 #include "model/fundamental.h"
 #include "model/timestamp.h"
+#include "storage/compressed_index_column.h"
 
 #include <cstdint>
 #include <optional>
@@ -36,6 +37,12 @@ namespace storage {
 struct index_state {
     static constexpr int8_t ondisk_version = 2;
 
+    /// an entry is also forced when the last indexed timestamp falls this
+    /// far behind the batch being tracked. a cold partition can take
+    /// minutes to accumulate a full byte step, and without a time trigger
+    /// every timestamp lookup would scan that whole gap.
+    static constexpr int64_t max_time_between_entries_ms = 10'000;
+
     index_state() = default;
     index_state(index_state&&) noexcept = default;
     index_state& operator=(index_state&&) noexcept = default;
@@ -58,10 +65,12 @@ struct index_state {
     // the batch's max_timestamp of the last batch
     model::timestamp max_timestamp{0};
 
-    /// breaking indexes into their own has a 6x latency reduction
-    std::vector<uint32_t> relative_offset_index;
-    std::vector<uint32_t> relative_time_index;
-    std::vector<uint32_t> position_index;
+    /// breaking indexes into their own has a 6x latency reduction.
+    /// each column is frame-of-reference delta compressed; see
+    /// compressed_index_column.h. the on-disk format is unchanged.
+    compressed_index_column relative_offset_index;
+    compressed_index_column relative_time_index;
+    compressed_index_column position_index;
 
     bool empty() const { return relative_offset_index.empty(); }
 
@@ -94,6 +103,12 @@ struct index_state {
     friend bool operator==(const index_state&, const index_state&) = default;
 
     static std::optional<index_state> hydrate_from_buffer(iobuf);
+    /// decode only the fixed-layout header prefix, leaving the entry
+    /// columns empty. `file_size` is used in place of decoding the payload
+    /// to sanity check the recorded size. entries are verified against the
+    /// checksum when they are hydrated later.
+    static std::optional<index_state>
+    hydrate_header_from_buffer(iobuf, size_t file_size);
     static uint64_t checksum_state(const index_state&);
     friend std::ostream& operator<<(std::ostream&, const index_state&);
 };
@@ -0,0 +1,165 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/io_calibration.h"
+
+#include "bytes/iobuf_parser.h"
+#include "reflection/adl.h"
+#include "storage/logger.h"
+#include "storage/segment_appender.h"
+#include "storage/segment_utils.h"
+#include "units.h"
+#include "vassert.h"
+#include "vlog.h"
+
+#include <seastar/core/aligned_buffer.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/smp.hh>
+
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace storage {
+
+namespace {
+
+constexpr size_t probe_alignment = 4_KiB;
+// small flushed writes approximate a raft append followed by an fsync
+constexpr size_t latency_write_size = 4_KiB;
+constexpr size_t latency_writes = 64;
+// large sequential writes with a single trailing flush for bandwidth
+constexpr size_t bandwidth_write_size = 1_MiB;
+constexpr size_t bandwidth_writes = 16;
+
+constexpr int8_t io_profile_version = 0;
+
+bytes io_profile_key() {
+    iobuf buf;
+    reflection::serialize(buf, internal::kvstore_key_type::io_profile);
+    return iobuf_to_bytes(buf);
+}
+
+} // namespace
+
+size_t io_profile::initial_falloc_step() const {
+    const auto step = static_cast<size_t>(write_bandwidth / 8);
+    return std::clamp(
+      step,
+      segment_appender::min_fallocation_step,
+      segment_appender::fallocation_step);
+}
+
+size_t io_profile::appender_chunks() const {
+    // bytes the device absorbs while one write completion is outstanding
+    const uint64_t bdp = write_bandwidth * write_latency.count() / 1'000'000;
+    const auto chunks = static_cast<size_t>(
+      bdp / segment_appender::chunk_size + 1);
+    return std::clamp(
+      chunks,
+      segment_appender::chunks_no_buffer,
+      2 * segment_appender::chunks_no_buffer);
+}
+
+std::ostream& operator<<(std::ostream& o, const io_profile& p) {
+    fmt::print(
+      o,
+      "{{write_latency: {}us, write_bandwidth: {}B/s}}",
+      p.write_latency.count(),
+      p.write_bandwidth);
+    return o;
+}
+
+ss::future<io_profile> io_calibration::calibrate(ss::sstring dir) {
+    using clock = std::chrono::steady_clock;
+    // one probe file per shard so concurrent probes do not contend on a
+    // single file's metadata
+    auto path = fmt::format("{}/calibration.{}.probe", dir, ss::this_shard_id());
+    auto f = co_await ss::open_file_dma(
+      path,
+      ss::open_flags::create | ss::open_flags::truncate | ss::open_flags::rw);
+    auto buf = ss::allocate_aligned_buffer<char>(
+      bandwidth_write_size, probe_alignment);
+    std::memset(buf.get(), 'x', bandwidth_write_size);
+
+    io_profile profile;
+    std::exception_ptr eptr;
+    try {
+        uint64_t offset = 0;
+        auto start = clock::now();
+        for (size_t i = 0; i < latency_writes; ++i) {
+            co_await f.dma_write(offset, buf.get(), latency_write_size);
+            co_await f.flush();
+            offset += latency_write_size;
+        }
+        auto elapsed = clock::now() - start;
+        profile.write_latency
+          = std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+            / latency_writes;
+
+        start = clock::now();
+        for (size_t i = 0; i < bandwidth_writes; ++i) {
+            co_await f.dma_write(offset, buf.get(), bandwidth_write_size);
+            offset += bandwidth_write_size;
+        }
+        co_await f.flush();
+        elapsed = clock::now() - start;
+        const auto usecs = std::max<int64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+            .count(),
+          1);
+        profile.write_bandwidth = bandwidth_writes * bandwidth_write_size
+                                  * 1'000'000 / usecs;
+    } catch (...) {
+        eptr = std::current_exception();
+    }
+    co_await f.close();
+    co_await ss::remove_file(path);
+    if (eptr) {
+        std::rethrow_exception(eptr);
+    }
+    co_return profile;
+}
+
+ss::future<io_profile>
+io_calibration::load_or_calibrate(kvstore& kvs, ss::sstring dir) {
+    auto key = io_profile_key();
+    if (auto buf = kvs.get(kvstore::key_space::storage, key); buf) {
+        iobuf_parser parser(std::move(*buf));
+        auto version = reflection::adl<int8_t>{}.from(parser);
+        vassert(
+          version == io_profile_version,
+          "unsupported io profile version {}",
+          version);
+        io_profile profile;
+        profile.write_latency = std::chrono::microseconds(
+          reflection::adl<int64_t>{}.from(parser));
+        profile.write_bandwidth = reflection::adl<uint64_t>{}.from(parser);
+        vlog(stlog.debug, "loaded persisted io profile: {}", profile);
+        co_return profile;
+    }
+    auto profile = co_await calibrate(dir);
+    vlog(stlog.info, "io calibration for {}: {}", dir, profile);
+    iobuf val;
+    reflection::serialize(
+      val,
+      io_profile_version,
+      static_cast<int64_t>(profile.write_latency.count()),
+      profile.write_bandwidth);
+    co_await kvs.put(
+      kvstore::key_space::storage, std::move(key), std::move(val));
+    co_return profile;
+}
+
+} // namespace storage
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+#include "storage/kvstore.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/sstring.hh>
+
+#include <chrono>
+#include <iosfwd>
+
+namespace storage {
+
+/**
+ * I/O profile of the device backing the data directory.
+ *
+ * Measured once per shard on first boot by a short write probe and then
+ * persisted in the kvstore, so subsequent boots skip the probe. The
+ * probes on all shards run concurrently, which means each shard observes
+ * roughly its fair share of device throughput - the same budget its
+ * partitions compete for at runtime.
+ */
+struct io_profile {
+    /// mean latency of a small flushed write
+    std::chrono::microseconds write_latency{0};
+    /// sequential write throughput in bytes per second
+    uint64_t write_bandwidth{0};
+
+    /// fallocation step for partitions with no append history yet. capped
+    /// at the static default so fast devices keep today's behavior, while
+    /// slow devices reserve at most ~125ms of their observed throughput
+    /// per idle partition. the per-partition append-rate sizing takes over
+    /// once a partition has history.
+    size_t initial_falloc_step() const;
+
+    /// number of write-behind chunks per segment appender, sized from the
+    /// bandwidth-delay product so the device stays busy while one head
+    /// write's completion is outstanding.
+    size_t appender_chunks() const;
+};
+
+std::ostream& operator<<(std::ostream&, const io_profile&);
+
+class io_calibration {
+public:
+    /**
+     * Return the profile persisted in the kvstore's storage key space, or
+     * run the probe against \p dir and persist its result. Must run after
+     * the kvstore has been started.
+     */
+    static ss::future<io_profile> load_or_calibrate(kvstore&, ss::sstring dir);
+
+    /**
+     * Measure the device backing \p dir with short dma write bursts: a
+     * flushed small-write phase for latency and a sequential burst for
+     * bandwidth. The probe file is removed before the future resolves.
+     */
+    static ss::future<io_profile> calibrate(ss::sstring dir);
+};
+
+} // namespace storage
@@ -14,6 +14,7 @@
 #include "prometheus/prometheus_sanitize.h"
 #include "raft/types.h"
 #include "reflection/adl.h"
+#include "resource_mgmt/io_priority.h"
 #include "storage/record_batch_builder.h"
 #include "storage/segment_set.h"
 #include "storage/types.h"
@@ -33,7 +34,7 @@ kvstore::kvstore(kvstore_config kv_conf)
   , _ntpc(model::kvstore_ntp(ss::this_shard_id()), _conf.base_dir)
   , _snap(
       std::filesystem::path(_ntpc.work_directory()),
-      ss::default_priority_class())
+      kvstore_priority())
   , _timer([this] { _sem.signal(); }) {}
 
 ss::future<> kvstore::start() {
@@ -59,6 +60,20 @@ ss::future<> kvstore::start() {
               "entries_removed",
               [this] { return _probe.entries_removed; },
               ss::metrics::description("Number of entries removaled")),
+            ss::metrics::make_total_operations(
+              "flushes",
+              [this] { return _probe.flushes; },
+              ss::metrics::description("Number of flushes")),
+            ss::metrics::make_total_operations(
+              "flushed_ops",
+              [this] { return _probe.flushed_ops; },
+              ss::metrics::description(
+                "Number of operations group-committed by flushes")),
+            ss::metrics::make_total_operations(
+              "coalesced_ops",
+              [this] { return _probe.coalesced_ops; },
+              ss::metrics::description(
+                "Number of operations deduplicated before hitting disk")),
             ss::metrics::make_current_bytes(
               "cached_bytes",
               [this] { return _probe.cached_bytes; },
@@ -214,9 +229,38 @@ ss::future<> kvstore::flush_and_apply_ops() {
     // flush and apply whatever happens to be queued up
     auto ops = std::exchange(_ops, {});
 
+    /*
+     * coalesce: multiple updates to the same key within a flush window only
+     * need their final value logged and applied. raft storms the store with
+     * vote/term updates for the same keys, so this regularly collapses many
+     * queued ops into a few records. the last write for a key wins, which is
+     * exactly what applying the ops in order would have produced.
+     */
+    absl::
+      flat_hash_map<bytes_view, size_t, bytes_type_hash, bytes_type_eq>
+        last_op_for_key;
+    last_op_for_key.reserve(ops.size());
+    for (size_t i = 0; i < ops.size(); ++i) {
+        last_op_for_key.insert_or_assign(bytes_view(ops[i].key), i);
+    }
+
+    // the map views into the op keys which are moved during apply, so
+    // resolve the winners into flags up-front
+    std::vector<bool> is_winner(ops.size(), false);
+    for (size_t i = 0; i < ops.size(); ++i) {
+        is_winner[i] = last_op_for_key[bytes_view(ops[i].key)] == i;
+    }
+    last_op_for_key.clear();
+
     // build the operation batch to be logged
+    size_t coalesced = 0;
     storage::record_batch_builder builder(kvstore_batch_type, _next_offset);
-    for (auto& op : ops) {
+    for (size_t i = 0; i < ops.size(); ++i) {
+        auto& op = ops[i];
+        if (!is_winner[i]) {
+            ++coalesced;
+            continue;
+        }
         std::optional<iobuf> value;
         if (op.value) {
             value = op.value->share(0, op.value->size_bytes());
@@ -226,6 +270,7 @@ ss::future<> kvstore::flush_and_apply_ops() {
     }
     auto batch = std::move(builder).build();
     auto last_offset = batch.last_offset();
+    _probe.flush_batch(ops.size(), coalesced);
 
     /*
      * 1. write batch
@@ -235,9 +280,17 @@ ss::future<> kvstore::flush_and_apply_ops() {
      */
     return _segment->append(std::move(batch))
       .then([this](append_result) { return _segment->flush(); })
-      .then([this, last_offset, ops = std::move(ops)]() mutable {
-          for (auto& op : ops) {
-              apply_op(std::move(op.key), std::move(op.value));
+      .then([this,
+             last_offset,
+             ops = std::move(ops),
+             is_winner = std::move(is_winner)]() mutable {
+          for (size_t i = 0; i < ops.size(); ++i) {
+              auto& op = ops[i];
+              // superseded ops are not applied; their promise resolves once
+              // the op that shadowed them is durable
+              if (is_winner[i]) {
+                  apply_op(std::move(op.key), std::move(op.value));
+              }
               op.done.set_value();
           }
           _next_offset = last_offset + model::offset(1);
@@ -250,9 +303,11 @@ ss::future<> kvstore::roll() {
                  _ntpc,
                  model::offset(_next_offset),
                  model::term_id(0),
-                 ss::default_priority_class(),
+                 kvstore_priority(),
                  record_version_type::v1,
                  default_segment_readahead_size,
+                 segment_appender::fallocation_step,
+                 segment_appender::chunks_no_buffer,
                  _conf.sanitize_fileops,
                  std::nullopt)
           .then([this](ss::lw_shared_ptr<segment> seg) {
@@ -290,9 +345,11 @@ ss::future<> kvstore::roll() {
                        _ntpc,
                        model::offset(_next_offset),
                        model::term_id(0),
-                       ss::default_priority_class(),
+                       kvstore_priority(),
                        record_version_type::v1,
                        default_segment_readahead_size,
+                       segment_appender::fallocation_step,
+                       segment_appender::chunks_no_buffer,
                        _conf.sanitize_fileops,
                        std::nullopt)
                 .then([this](ss::lw_shared_ptr<segment> seg) {
@@ -496,7 +553,7 @@ void kvstore::replay_segments_in_thread(segment_set segs) {
           seg->offsets().base_offset,
           _next_offset);
 
-        auto input = seg->reader().data_stream(0, ss::default_priority_class());
+        auto input = seg->reader().data_stream(0, kvstore_priority());
         auto parser = std::make_unique<continuous_batch_parser>(
           std::make_unique<replay_consumer>(this), std::move(input));
         auto p = parser.get();
@@ -196,11 +196,19 @@ private:
         void entry_removed() { ++entries_removed; }
         void add_cached_bytes(size_t count) { cached_bytes += count; }
         void dec_cached_bytes(size_t count) { cached_bytes -= count; }
+        void flush_batch(size_t ops, size_t coalesced) {
+            ++flushes;
+            flushed_ops += ops;
+            coalesced_ops += coalesced;
+        }
 
         uint64_t segments_rolled{0};
         uint64_t entries_fetched{0};
         uint64_t entries_written{0};
         uint64_t entries_removed{0};
+        uint64_t flushes{0};
+        uint64_t flushed_ops{0};
+        uint64_t coalesced_ops{0};
         size_t cached_bytes{0};
 
         ss::metrics::metric_groups metrics;
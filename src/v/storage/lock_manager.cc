@@ -29,11 +29,22 @@ range(segment_set::underlying_t segs) {
     return ss::when_all_succeed(dispatch.begin(), dispatch.end())
       .then(
         [ctx = std::move(ctx)](std::vector<ss::rwlock::holder> lks) mutable {
-            ctx->locks = std::move(lks);
+            ctx->locks.reserve(lks.size());
+            for (auto& h : lks) {
+                ctx->locks.emplace_back(std::move(h));
+            }
             return std::move(ctx);
         });
 }
 
+void lock_manager::lease::release_until(const segment_set::iterator& it) {
+    auto upto = std::min(
+      static_cast<size_t>(std::distance(range.begin(), it)), locks.size());
+    for (; _released_prefix < upto; ++_released_prefix) {
+        locks[_released_prefix] = std::nullopt;
+    }
+}
+
 ss::future<std::unique_ptr<lock_manager::lease>>
 lock_manager::range_lock(const timequery_config& cfg) {
     segment_set::underlying_t tmp;
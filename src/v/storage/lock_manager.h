@@ -18,6 +18,8 @@
 
 #include <seastar/core/rwlock.hh>
 
+#include <optional>
+
 namespace storage {
 class lock_manager {
 public:
@@ -32,10 +34,22 @@ public:
         lease(const lease&) = delete;
         lease& operator=(const lease&) = delete;
 
+        /// drop the read locks of every segment that precedes the given
+        /// position in the range. readers call this as their cursor moves
+        /// forward so that compaction of segments they already consumed
+        /// does not have to wait for the whole read to finish. the
+        /// segments stay in the range - only their locks are returned
+        void release_until(const segment_set::iterator&);
+
         segment_set range;
-        std::vector<ss::rwlock::holder> locks;
+        // parallel to range; holders released by release_until() are
+        // reset in place so iterators into the range stay valid
+        std::vector<std::optional<ss::rwlock::holder>> locks;
 
         friend std::ostream& operator<<(std::ostream&, const lease&);
+
+    private:
+        size_t _released_prefix{0};
     };
 
     ss::future<std::unique_ptr<lease>> range_lock(const timequery_config& cfg);
@@ -23,6 +23,7 @@
 #include <seastar/core/shared_ptr.hh>
 
 #include <utility>
+#include <vector>
 
 namespace storage {
 
@@ -75,6 +76,23 @@ public:
         monitor_eviction(ss::abort_source&) = 0;
         virtual void set_collectible_offset(model::offset) = 0;
 
+        /// opt-in I/O attribution ring; only the disk backend records
+        /// samples, see log_config::sampled_attribution
+        virtual std::vector<attribution_sample> attribution_samples() const {
+            return {};
+        }
+
+        /// housekeeping scheduling hint: the timestamp of the oldest
+        /// data retention could evict, or std::nullopt when no amount
+        /// of waiting makes anything evictable. A log whose work is
+        /// already due (compacted topics, size budget exceeded) returns
+        /// model::timestamp(0). Must be cheap and synchronous - it runs
+        /// for every log on every housekeeping cycle
+        virtual std::optional<model::timestamp>
+        retention_eligible_at(std::optional<size_t>) const {
+            return std::nullopt;
+        }
+
     private:
         ntp_config _config;
     };
@@ -131,6 +149,15 @@ public:
     std::optional<model::term_id> get_term(model::offset o) const {
         return _impl->get_term(o);
     }
+
+    std::vector<attribution_sample> attribution_samples() const {
+        return _impl->attribution_samples();
+    }
+
+    std::optional<model::timestamp>
+    retention_eligible_at(std::optional<size_t> retention_bytes) const {
+        return _impl->retention_eligible_at(retention_bytes);
+    }
     ss::future<std::optional<timequery_result>>
     timequery(timequery_config cfg) {
         return _impl->timequery(cfg);
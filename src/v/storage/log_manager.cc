@@ -13,6 +13,9 @@
 #include "likely.h"
 #include "model/fundamental.h"
 #include "model/timestamp.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "reflection/adl.h"
+#include "resource_mgmt/io_priority.h"
 #include "storage/batch_cache.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/fs_utils.h"
@@ -24,6 +27,7 @@
 #include "storage/segment_reader.h"
 #include "storage/segment_set.h"
 #include "storage/segment_utils.h"
+#include "ssx/future-util.h"
 #include "utils/directory_walker.h"
 #include "utils/file_sanitizer.h"
 #include "vlog.h"
@@ -31,6 +35,7 @@
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/file.hh>
 #include <seastar/core/future-util.hh>
+#include <seastar/core/metrics.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/print.hh>
@@ -52,9 +57,38 @@ log_manager::log_manager(log_config config, kvstore& kvstore) noexcept
   : _config(std::move(config))
   , _kvstore(kvstore)
   , _jitter(_config.compaction_interval)
-  , _batch_cache(config.reclaim_opts) {
+  , _batch_cache(config.reclaim_opts)
+  , _recovery_sem(std::max<size_t>(1, _config.max_concurrent_recoveries)) {
+    if (!_config.archival_cache_dir.empty()) {
+        _hydrated_cache = std::make_unique<hydrated_segment_cache>(
+          _config.archival_cache_dir, _config.archival_cache_max_bytes);
+    }
     _compaction_timer.set_callback([this] { trigger_housekeeping(); });
     _compaction_timer.rearm(_jitter());
+    setup_metrics();
+}
+
+void log_manager::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("storage:manager"),
+      {
+        sm::make_gauge(
+          "logs_recovery_pending",
+          [this] { return _recovery_progress.pending; },
+          sm::description("Number of logs waiting for a recovery slot")),
+        sm::make_gauge(
+          "logs_recovery_active",
+          [this] { return _recovery_progress.active; },
+          sm::description("Number of logs currently being recovered")),
+        sm::make_derive(
+          "logs_recovery_completed",
+          [this] { return _recovery_progress.completed; },
+          sm::description("Total number of logs recovered")),
+      });
 }
 void log_manager::trigger_housekeeping() {
     (void)ss::with_gate(_open_gate, [this] {
@@ -75,22 +109,63 @@ void log_manager::trigger_housekeeping() {
 ss::future<> log_manager::stop() {
     _compaction_timer.cancel();
     _abort_source.request_abort();
-    return _open_gate.close().then([this] {
-        return ss::parallel_for_each(_logs, [](logs_type::value_type& entry) {
-            return entry.second.handle.close();
-        });
-    });
+    auto stopped_cache = _hydrated_cache ? _hydrated_cache->stop()
+                                         : ss::make_ready_future<>();
+    return stopped_cache.then([this] { return _open_gate.close(); })
+      .then([this] {
+          // closing flushes every log; chunk the shutdown the same way
+          // recovery is bounded so a shard with thousands of logs does not
+          // materialize one close continuation per log at once
+          return ss::do_with(size_t{0}, [this](size_t& closed) {
+              return ssx::concurrent_for_each(
+                _logs.begin(),
+                _logs.end(),
+                [this, &closed](logs_type::value_type& entry) {
+                    return entry.second.handle.close().then([this, &closed] {
+                        // leave a trail on wide shards so a slow clean
+                        // shutdown is distinguishable from a hung one
+                        if (++closed % 1000 == 0) {
+                            vlog(
+                              stlog.info,
+                              "closed {}/{} logs",
+                              closed,
+                              _logs.size());
+                        }
+                    });
+                },
+                std::max<size_t>(1, _config.max_concurrent_recoveries));
+          });
+      });
 }
 
-static inline logs_type::iterator find_next_non_compacted_log(logs_type& logs) {
+static inline logs_type::iterator find_next_due_log(
+  logs_type& logs,
+  model::timestamp collection_threshold,
+  const std::optional<size_t>& retention_bytes) {
     using bflags = log_housekeeping_meta::bitflags;
     return std::find_if(
-      logs.begin(), logs.end(), [](const logs_type::value_type& l) {
-          return bflags::none == (l.second.flags & bflags::compacted);
+      logs.begin(),
+      logs.end(),
+      [collection_threshold,
+       &retention_bytes](const logs_type::value_type& l) {
+          if (bflags::none != (l.second.flags & bflags::compacted)) {
+              return false;
+          }
+          // cheap synchronous probe: a log with nothing evictable is
+          // skipped without building a compaction future or touching
+          // the disk, so an idle shard's housekeeping cycle does no
+          // per-log work beyond this check
+          auto eligible = l.second.handle.retention_eligible_at(
+            retention_bytes);
+          return eligible.has_value() && *eligible <= collection_threshold;
       });
 }
 
 ss::future<> log_manager::housekeeping() {
+    // idle-time pass over the batch cache: re-pack fragmented resident
+    // payloads that were too large to compact inline at admission
+    _batch_cache.defragment();
+
     auto collection_threshold = model::timestamp(
       model::timestamp::now().value() - _config.delete_retention.count());
     /**
@@ -110,12 +185,14 @@ ss::future<> log_manager::housekeeping() {
      */
     using bflags = log_housekeeping_meta::bitflags;
     return ss::do_until(
-             [this] {
-                 auto it = find_next_non_compacted_log(_logs);
+             [this, collection_threshold] {
+                 auto it = find_next_due_log(
+                   _logs, collection_threshold, _config.retention_bytes);
                  return it == _logs.end();
              },
              [this, collection_threshold] {
-                 auto it = find_next_non_compacted_log(_logs);
+                 auto it = find_next_due_log(
+                   _logs, collection_threshold, _config.retention_bytes);
                  if (it == _logs.end()) {
                      // must check again because between the stop condition
                      // and this continuation we might have removed the log
@@ -127,8 +204,9 @@ ss::future<> log_manager::housekeeping() {
                    collection_threshold,
                    // TODO: [ch433] - this configuration needs to be updated
                    _config.retention_bytes,
-                   // TODO: change default priority in application.cc
-                   ss::default_priority_class(),
+                   // dedicated lane: housekeeping reads/writes are shaped
+                   // by the io scheduler instead of competing with appends
+                   compaction_priority(),
                    _abort_source));
              })
       .finally([this] {
@@ -143,9 +221,11 @@ ss::future<ss::lw_shared_ptr<segment>> log_manager::make_log_segment(
   model::term_id term,
   ss::io_priority_class pc,
   record_version_type version,
-  size_t buf_size) {
+  size_t buf_size,
+  size_t falloc_step) {
     return ss::with_gate(
-      _open_gate, [this, &ntp, base_offset, term, pc, version, buf_size] {
+      _open_gate,
+      [this, &ntp, base_offset, term, pc, version, buf_size, falloc_step] {
           return make_segment(
             ntp,
             base_offset,
@@ -153,6 +233,8 @@ ss::future<ss::lw_shared_ptr<segment>> log_manager::make_log_segment(
             pc,
             version,
             buf_size,
+            falloc_step,
+            _config.segment_appender_chunks,
             _config.sanitize_fileops,
             create_cache(ntp.cache_enabled()));
       });
@@ -177,15 +259,21 @@ ss::future<log> log_manager::manage(ntp_config cfg) {
 
 ss::future<> log_manager::recover_log_state(const ntp_config& cfg) {
     return ss::file_exists(cfg.work_directory())
-      .then(
-        [this, key = internal::start_offset_key(cfg.ntp())](bool dir_exists) {
-            if (dir_exists) {
-                return ss::now();
-            }
-            // directory was deleted, make sure we do not have any state in KV
-            // store.
-            return _kvstore.remove(kvstore::key_space::storage, key);
-        });
+      .then([this,
+             offset_key = internal::start_offset_key(cfg.ntp()),
+             manifest_key = internal::segment_manifest_key(cfg.ntp())](
+              bool dir_exists) {
+          if (dir_exists) {
+              return ss::now();
+          }
+          // directory was deleted, make sure we do not have any state in KV
+          // store.
+          return _kvstore.remove(kvstore::key_space::storage, offset_key)
+            .then([this, manifest_key] {
+                return _kvstore.remove(
+                  kvstore::key_space::storage, manifest_key);
+            });
+      });
 }
 
 ss::future<log> log_manager::do_manage(ntp_config cfg) {
@@ -197,7 +285,9 @@ ss::future<log> log_manager::do_manage(ntp_config cfg) {
     vassert(
       _logs.find(cfg.ntp()) == _logs.end(), "cannot double register same ntp");
 
-    if (_config.stype == log_config::storage_type::memory) {
+    if (
+      _config.stype == log_config::storage_type::memory
+      || cfg.is_in_memory()) {
         auto path = cfg.work_directory();
         auto l = storage::make_memory_backed_log(std::move(cfg));
         _logs.emplace(l.config().ntp(), l);
@@ -208,19 +298,71 @@ ss::future<log> log_manager::do_manage(ntp_config cfg) {
     return recover_log_state(cfg).then([this, cfg = std::move(cfg)]() mutable {
         ss::sstring path = cfg.work_directory();
         with_cache cache_enabled = cfg.cache_enabled();
-        return recover_segments(
-                 std::filesystem::path(path),
-                 _config.sanitize_fileops,
-                 cfg.is_compacted(),
-                 [this, cache_enabled] { return create_cache(cache_enabled); },
-                 _abort_source)
+        bool is_compacted = cfg.is_compacted();
+        /*
+         * the manifest names this ntp's segment files so recovery opens
+         * exactly those instead of walking and stat-ing the directory;
+         * missing manifests (first boot, wipe) and stale ones fall back
+         * to the walk
+         */
+        std::optional<std::vector<ss::sstring>> manifest;
+        if (auto buf = _kvstore.get(
+              kvstore::key_space::storage,
+              internal::segment_manifest_key(cfg.ntp()));
+            buf) {
+            manifest = reflection::adl<std::vector<ss::sstring>>{}.from(
+              std::move(*buf));
+        }
+        /*
+         * the recovery semaphore lets independent ntp directories be
+         * opened/replayed in parallel while bounding startup I/O to
+         * max_concurrent_recoveries logs at a time.
+         */
+        ++_recovery_progress.pending;
+        return ss::with_semaphore(
+                 _recovery_sem,
+                 1,
+                 [this,
+                  path,
+                  cache_enabled,
+                  is_compacted,
+                  manifest = std::move(manifest)]() mutable {
+                     --_recovery_progress.pending;
+                     ++_recovery_progress.active;
+                     return recover_segments(
+                              std::filesystem::path(path),
+                              _config.sanitize_fileops,
+                              is_compacted,
+                              [this, cache_enabled] {
+                                  return create_cache(cache_enabled);
+                              },
+                              _abort_source,
+                              std::move(manifest))
+                       .finally([this] {
+                           --_recovery_progress.active;
+                           ++_recovery_progress.completed;
+                       });
+                 })
           .then([this, cfg = std::move(cfg)](segment_set segments) mutable {
-              auto l = storage::make_disk_backed_log(
-                std::move(cfg), *this, std::move(segments), _kvstore);
-              auto [_, success] = _logs.emplace(l.config().ntp(), l);
-              vassert(
-                success, "Could not keep track of:{} - concurrency issue", l);
-              return l;
+              /*
+               * the recovered set is authoritative - a walker fallback or a
+               * segment renamed as unrecoverable may have diverged from the
+               * manifest - so rewrite it before the log goes live
+               */
+              return internal::persist_segment_manifest(
+                       _kvstore, cfg.ntp(), segments)
+                .then([this,
+                       cfg = std::move(cfg),
+                       segments = std::move(segments)]() mutable {
+                    auto l = storage::make_disk_backed_log(
+                      std::move(cfg), *this, std::move(segments), _kvstore);
+                    auto [_, success] = _logs.emplace(l.config().ntp(), l);
+                    vassert(
+                      success,
+                      "Could not keep track of:{} - concurrency issue",
+                      l);
+                    return l;
+                });
           });
     });
 }
@@ -307,7 +449,8 @@ std::ostream& operator<<(std::ostream& o, const log_config& c) {
     return o << ", compaction_interval_ms:" << c.compaction_interval.count()
              << ", delete_reteion_ms:" << c.delete_retention.count()
              << ", with_cache:" << c.cache
-             << ", relcaim_opts:" << c.reclaim_opts << "}";
+             << ", relcaim_opts:" << c.reclaim_opts
+             << ", sampled_attribution:" << c.sampled_attribution << "}";
 }
 std::ostream& operator<<(std::ostream& o, const log_manager& m) {
     return o << "{config:" << m._config << ", logs.size:" << m._logs.size()
@@ -15,6 +15,7 @@
 #include "random/simple_time_jitter.h"
 #include "seastarx.h"
 #include "storage/batch_cache.h"
+#include "storage/hydrated_segment_cache.h"
 #include "storage/kvstore.h"
 #include "storage/log.h"
 #include "storage/log_housekeeping_meta.h"
@@ -29,6 +30,8 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/sstring.hh>
 
 #include <absl/container/flat_hash_map.h>
@@ -39,6 +42,8 @@
 
 namespace storage {
 
+class remote_fetcher;
+
 struct log_config {
     enum class storage_type { memory, disk };
     log_config(
@@ -108,6 +113,22 @@ struct log_config {
     // same as delete.retention.ms in kafka - default 1 week
     std::chrono::milliseconds delete_retention = std::chrono::minutes(10080);
     with_cache cache = with_cache::yes;
+    // number of logs that may be opened/replayed in parallel during
+    // startup. bounds recovery I/O while letting independent ntp
+    // directories recover concurrently.
+    size_t max_concurrent_recoveries = 8;
+    // seeded from the boot-time device calibration (see io_calibration.h)
+    // before the log manager is constructed. used for segments until the
+    // per-partition append history can size these itself.
+    size_t initial_fallocation_step = segment_appender::fallocation_step;
+    size_t segment_appender_chunks = segment_appender::chunks_no_buffer;
+    // opt-in per-ntp I/O attribution sampling, dumped via the admin api.
+    // high cardinality, so off by default
+    bool sampled_attribution = false;
+    // directory for segments hydrated from object storage; empty
+    // disables the hydrated segment cache
+    ss::sstring archival_cache_dir;
+    size_t archival_cache_max_bytes = 20_GiB;
     batch_cache::reclaim_options reclaim_opts{
       .growth_window = std::chrono::seconds(3),
       .stable_window = std::chrono::seconds(10),
@@ -176,7 +197,8 @@ public:
       model::term_id,
       ss::io_priority_class pc,
       record_version_type = record_version_type::v1,
-      size_t buffer_size = default_segment_readahead_size);
+      size_t buffer_size = default_segment_readahead_size,
+      size_t falloc_step = segment_appender::fallocation_step);
 
     const log_config& config() const { return _config; }
 
@@ -191,9 +213,37 @@ public:
         return std::nullopt;
     }
 
+    /// Invokes the callback once for every log under management.
+    template<typename Fn>
+    void for_each_log(Fn&& f) const {
+        for (const auto& [ntp, meta] : _logs) {
+            f(ntp, meta.handle);
+        }
+    }
+
     /// Returns the logs that match a model::topic_namespace
     absl::flat_hash_map<model::ntp, log> get(const model::topic_namespace&);
 
+    /// Install the hook used to serve reads below the local log start
+    /// from archived segments. The pointer is held, not owned; the
+    /// caller keeps the fetcher alive until after stop().
+    void set_remote_fetch_hook(remote_fetcher* f) { _remote_fetcher = f; }
+    remote_fetcher* remote_fetch_hook() const { return _remote_fetcher; }
+
+    /// disk cache for hydrated remote segments; nullptr unless the
+    /// config carries a cache directory
+    hydrated_segment_cache* hydrated_cache() { return _hydrated_cache.get(); }
+
+    /// startup recovery progress; also exported as metrics
+    struct recovery_progress {
+        uint32_t pending{0}; // waiting for a recovery slot
+        uint32_t active{0};  // currently opening/replaying
+        uint64_t completed{0};
+    };
+    const recovery_progress& recovery_status() const {
+        return _recovery_progress;
+    }
+
 private:
     using logs_type = absl::flat_hash_map<model::ntp, log_housekeeping_meta>;
 
@@ -206,6 +256,7 @@ private:
     void trigger_housekeeping();
     void arm_housekeeping();
     ss::future<> housekeeping();
+    void setup_metrics();
 
     std::optional<batch_cache_index> create_cache(with_cache);
 
@@ -220,6 +271,11 @@ private:
     batch_cache _batch_cache;
     ss::gate _open_gate;
     ss::abort_source _abort_source;
+    ss::semaphore _recovery_sem;
+    recovery_progress _recovery_progress;
+    remote_fetcher* _remote_fetcher{nullptr};
+    std::unique_ptr<hydrated_segment_cache> _hydrated_cache;
+    ss::metrics::metric_groups _metrics;
 
     friend std::ostream& operator<<(std::ostream&, const log_manager&);
 };
@@ -12,6 +12,7 @@
 #include "bytes/iobuf.h"
 #include "model/record.h"
 #include "storage/logger.h"
+#include "utils/lazy_message.h"
 #include "vassert.h"
 #include "vlog.h"
 
@@ -20,6 +21,8 @@
 
 #include <fmt/ostream.h>
 
+#include <algorithm>
+
 namespace storage {
 using records_t = ss::circular_buffer<model::record_batch>;
 
@@ -52,6 +55,12 @@ batch_consumer::consume_result skipping_consumer::consume_batch_start(
         _reader._config.start_offset = header.last_offset() + model::offset(1);
         return skip_batch::yes;
     }
+    // pushdown filter: reject on the header alone, before the record
+    // payload is materialized
+    if (_reader._config.filter && !_reader._config.filter(header)) {
+        _reader._config.start_offset = header.last_offset() + model::offset(1);
+        return skip_batch::yes;
+    }
     if (_reader._config.first_timestamp > header.first_timestamp) {
         // kakfa needs to guarantee that the returned record is >=
         // first_timestamp
@@ -101,7 +110,7 @@ batch_consumer::stop_parser skipping_consumer::consume_batch_end() {
         return stop_parser::yes;
     }
     _header = {};
-    return stop_parser(_reader._state.is_full());
+    return stop_parser(_reader._state.is_full(_reader._read_window));
 }
 
 void skipping_consumer::print(std::ostream& os) const {
@@ -109,15 +118,41 @@ void skipping_consumer::print(std::ostream& os) const {
 }
 
 log_segment_batch_reader::log_segment_batch_reader(
-  segment& seg, log_reader_config& config, probe& p) noexcept
+  segment& seg,
+  log_reader_config& config,
+  probe& p,
+  const size_t& read_window) noexcept
   : _seg(seg)
   , _config(config)
-  , _probe(p) {}
+  , _probe(p)
+  , _read_window(read_window) {}
 
 std::unique_ptr<continuous_batch_parser> log_segment_batch_reader::initialize(
   model::timeout_clock::time_point timeout,
   std::optional<model::offset> next_cached_batch) {
-    auto input = _seg.offset_data_stream(_config.start_offset, _config.prio);
+    /*
+     * size the stream from the remaining byte budget. deepen readahead
+     * for readers with a large budget (catch-up consumers scanning
+     * historical data): prefetch enough buffers to cover the budget so
+     * the next windows are already in flight while the current one is
+     * parsed, bounded so memory stays in check. conversely, cap the
+     * buffer size for readers with a small budget (interactive tooling
+     * probing a handful of batches) so they issue proportionally small
+     * disk reads instead of a full window that is mostly thrown away.
+     */
+    const auto remaining = _config.max_bytes
+                           - std::min(_config.max_bytes, _config.bytes_consumed);
+    const auto readahead = std::clamp(
+      remaining / default_segment_readahead_size,
+      _config.readahead_count,
+      log_reader_config::max_readahead_count);
+    // the byte budget bounds what this read may deliver; the adaptive
+    // window bounds what this consumer has shown it can drain per poll
+    auto input = _seg.offset_data_stream(
+      _config.start_offset,
+      _config.prio,
+      readahead,
+      std::min(remaining, _read_window));
     return std::make_unique<continuous_batch_parser>(
       std::make_unique<skipping_consumer>(*this, timeout, next_cached_batch),
       std::move(input));
@@ -132,13 +167,16 @@ ss::future<> log_segment_batch_reader::close() {
 
 void log_segment_batch_reader::add_one(model::record_batch&& batch) {
     _state.buffer.emplace_back(std::move(batch));
-    const auto& b = _state.buffer.back();
+    auto& b = _state.buffer.back();
     _config.start_offset = b.header().last_offset() + model::offset(1);
     const auto size_bytes = b.header().size_bytes;
     _config.bytes_consumed += size_bytes;
     _state.buffer_size += size_bytes;
     _probe.add_bytes_read(size_bytes);
     if (!_config.skip_batch_cache) {
+        // deep copy on admission. the parser hands out batches that share
+        // slices of whole read-window buffers, so caching a shared view
+        // would pin the entire buffer for as long as the entry lives.
         _seg.cache_put(b);
     }
 }
@@ -153,7 +191,7 @@ log_segment_batch_reader::read_some(model::timeout_clock::time_point timeout) {
       _config.max_offset,
       _config.type_filter,
       _config.first_timestamp,
-      max_buffer_size,
+      _read_window,
       _config.skip_batch_cache);
 
     // handles cases where the type filter skipped batches. see
@@ -167,6 +205,20 @@ log_segment_batch_reader::read_some(model::timeout_clock::time_point timeout) {
         _probe.add_bytes_read(cache_read.memory_usage);
         _probe.add_cached_bytes_read(cache_read.memory_usage);
         _probe.add_cached_batches_read(cache_read.batches.size());
+        // apply the pushdown filter to cache hits as well. the batches
+        // are already materialized in memory here so this only avoids
+        // handing them to the consumer; offsets advanced via next_batch
+        // above, and an all-filtered read simply yields an empty slice
+        if (unlikely(bool(_config.filter)) && !cache_read.batches.empty()) {
+            records_t kept;
+            kept.reserve(cache_read.batches.size());
+            for (auto& b : cache_read.batches) {
+                if (_config.filter(b.header())) {
+                    kept.push_back(std::move(b));
+                }
+            }
+            cache_read.batches = std::move(kept);
+        }
         return ss::make_ready_future<result<records_t>>(
           std::move(cache_read.batches));
     }
@@ -217,7 +269,29 @@ log_reader::log_reader(
 
     if (_iterator.next_seg != _lease->range.end()) {
         _iterator.reader = std::make_unique<log_segment_batch_reader>(
-          **_iterator.next_seg, _config, _probe);
+          **_iterator.next_seg, _config, _probe, _read_window);
+    }
+}
+
+void log_reader::reset_config(log_reader_config config) {
+    vassert(
+      config.start_offset == _config.start_offset,
+      "cached readers resume exactly where they stopped: {} != {}",
+      config.start_offset,
+      _config.start_offset);
+    _config = config;
+    _eos = false;
+    _last_base = model::model_limits<model::offset>::min();
+    _as_sub = ss::abort_source::subscription{};
+    if (config.abort_source) {
+        auto op_sub = config.abort_source.value().get().subscribe(
+          [this]() noexcept { set_end_of_stream(); });
+        if (op_sub) {
+            _as_sub = std::move(*op_sub);
+        } else {
+            // already aborted
+            set_end_of_stream();
+        }
     }
 }
 
@@ -235,9 +309,12 @@ ss::future<> log_reader::find_next_valid_iterator() {
             break;
         }
     }
+    // the cursor moved forward; hand back the read locks of the segments
+    // it left behind so gc/compaction does not wait on this reader
+    _lease->release_until(_iterator.next_seg);
     if (_iterator.next_seg != _lease->range.end()) {
         _iterator.reader = std::make_unique<log_segment_batch_reader>(
-          **_iterator.next_seg, _config, _probe);
+          **_iterator.next_seg, _config, _probe, _read_window);
     }
     if (tmp_reader) {
         auto raw = tmp_reader.get();
@@ -252,15 +329,17 @@ log_reader::do_load_slice(model::timeout_clock::time_point timeout) {
         // must keep this function because, the segment might not be done
         // but offsets might have exceeded the read
         set_end_of_stream();
-        return _iterator.close().then(
-          [] { return ss::make_ready_future<storage_t>(); });
+        // the iterator stays open so that if this reader lands in the
+        // readers cache the next sequential read resumes the warm parser;
+        // finally() closes it for readers that are not cached
+        return ss::make_ready_future<storage_t>();
     }
     if (_last_base == _config.start_offset) {
         set_end_of_stream();
-        return _iterator.close().then(
-          [] { return ss::make_ready_future<storage_t>(); });
+        return ss::make_ready_future<storage_t>();
     }
     _last_base = _config.start_offset;
+    const auto consumed_before = _config.bytes_consumed;
     ss::future<> fut = find_next_valid_iterator();
     if (is_end_of_stream()) {
         return fut.then([] { return ss::make_ready_future<storage_t>(); });
@@ -270,10 +349,11 @@ log_reader::do_load_slice(model::timeout_clock::time_point timeout) {
       .then([this, timeout](result<records_t> recs) -> ss::future<storage_t> {
           if (!recs) {
               set_end_of_stream();
+              _failed = true;
               vlog(
                 stlog.info,
                 "stopped reading stream: {}",
-                recs.error().message());
+                lazy::msg(recs.error()));
               return _iterator.close().then(
                 [] { return ss::make_ready_future<storage_t>(); });
           }
@@ -288,16 +368,27 @@ log_reader::do_load_slice(model::timeout_clock::time_point timeout) {
               return do_load_slice(timeout);
           }
           _probe.add_batches_read(recs.value().size());
+          adjust_read_window(_config.bytes_consumed - consumed_before);
           return ss::make_ready_future<storage_t>(std::move(recs.value()));
       })
       .handle_exception([this](std::exception_ptr e) {
           set_end_of_stream();
+          _failed = true;
           _probe.batch_parse_error();
           return _iterator.close().then(
             [e] { return ss::make_exception_future<storage_t>(e); });
       });
 }
 
+void log_reader::adjust_read_window(size_t slice_bytes) {
+    if (slice_bytes >= _read_window) {
+        _read_window = std::min(_read_window * 2, max_read_window);
+    } else if (slice_bytes < _read_window / 4) {
+        _read_window = std::max(_read_window / 2, min_read_window);
+    }
+    _probe.set_read_window(_read_window);
+}
+
 static inline bool is_finished_offset(segment_set& s, model::offset o) {
     if (s.empty()) {
         return true;
@@ -84,7 +84,10 @@ public:
     static constexpr size_t max_buffer_size = 32 * 1024; // 32KB
 
     log_segment_batch_reader(
-      segment&, log_reader_config& config, probe& p) noexcept;
+      segment&,
+      log_reader_config& config,
+      probe& p,
+      const size_t& read_window) noexcept;
     log_segment_batch_reader(log_segment_batch_reader&&) noexcept = default;
     log_segment_batch_reader&
     operator=(log_segment_batch_reader&&) noexcept = delete;
@@ -109,12 +112,15 @@ private:
     struct tmp_state {
         ss::circular_buffer<model::record_batch> buffer;
         size_t buffer_size = 0;
-        bool is_full() const { return buffer_size >= max_buffer_size; }
+        bool is_full(size_t window) const { return buffer_size >= window; }
     };
 
     segment& _seg;
     log_reader_config& _config;
     probe& _probe;
+    // window size owned by the log_reader so adaptation survives segment
+    // boundaries and cached-reader reuse
+    const size_t& _read_window;
 
     std::unique_ptr<continuous_batch_parser> _iterator;
     tmp_state _state;
@@ -135,7 +141,7 @@ public:
     }
 
     bool is_end_of_stream() const final {
-        return _iterator.next_seg == _lease->range.end();
+        return _eos || _iterator.next_seg == _lease->range.end();
     }
 
     ss::future<storage_t> do_load_slice(model::timeout_clock::time_point) final;
@@ -146,11 +152,50 @@ public:
         fmt::print(os, "storage::log_reader. config {}", _config);
     }
 
+    /// next offset this reader would deliver; the readers cache keys on it
+    model::offset next_read_offset() const { return _config.start_offset; }
+
+    /// a reader that hit a parse error or ran its segment cursor off the
+    /// end of its lease has nothing left to resume and must not be cached
+    bool is_reusable() const {
+        return !_failed && _iterator.next_seg != _lease->range.end();
+    }
+
+    /// whether this reader's lease still has data at the given offset. a
+    /// segment rolled after the lease was taken is not covered, so a
+    /// cached reader must not be handed out for offsets that live there
+    bool lease_covers(model::offset o) const {
+        return !_lease->range.empty()
+               && o >= _lease->range.front()->offsets().base_offset
+               && o <= _lease->range.back()->offsets().dirty_offset;
+    }
+
+    /// resume a cached reader for a new read starting exactly at the
+    /// offset where the previous one left off
+    void reset_config(log_reader_config);
+
+    /// the caller's abort source may not outlive a parked reader, so the
+    /// cache drops the subscription; reset_config installs the next one
+    void detach_abort_source() { _as_sub = ss::abort_source::subscription{}; }
+
 private:
-    void set_end_of_stream() { _iterator.next_seg = _lease->range.end(); }
+    void set_end_of_stream() { _eos = true; }
     bool is_done();
     ss::future<> find_next_valid_iterator();
 
+    /*
+     * consumption-rate adaptive window sizing. each poll that drains the
+     * full window doubles it and a poll that drains well under a quarter
+     * of it halves it, between min_read_window and max_read_window. tail
+     * consumers fetching a few batches settle on small disk reads that do
+     * not churn the cache, while catch-up replays quickly grow to large
+     * sequential reads. the window persists across segment boundaries and
+     * across fetches for readers parked in the readers cache.
+     */
+    static constexpr size_t min_read_window = 16 * 1024;
+    static constexpr size_t max_read_window = 4 * 1024 * 1024;
+    void adjust_read_window(size_t slice_bytes);
+
     using reader_available = ss::bool_class<struct create_reader_tag>;
     reader_available maybe_create_segment_reader();
 
@@ -179,6 +224,12 @@ private:
     model::offset _last_base;
     probe& _probe;
     ss::abort_source::subscription _as_sub;
+    size_t _read_window{log_segment_batch_reader::max_buffer_size};
+    // end-of-stream is a flag rather than a sentinel iterator so that a
+    // finished reader keeps its segment cursor and can be cached for the
+    // next sequential read
+    bool _eos{false};
+    bool _failed{false};
 };
 
 } // namespace storage
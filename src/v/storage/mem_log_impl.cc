@@ -160,7 +160,7 @@ struct mem_log_impl final : log::impl {
     ss::future<> remove() final { return ss::make_ready_future<>(); }
     ss::future<> flush() final { return ss::make_ready_future<>(); }
     ss::future<> compact(compaction_config cfg) final {
-        return gc(cfg.eviction_time, cfg.max_bytes);
+        return gc(cfg.eviction_time, effective_retention_bytes(cfg.max_bytes));
     }
     std::ostream& print(std::ostream& o) const final {
         fmt::print(o, "{{mem_log_impl:{}}}", offsets());
@@ -280,6 +280,34 @@ struct mem_log_impl final : log::impl {
         return ss::now();
     }
 
+    // the topic level retention_bytes override is the memory budget for
+    // in-memory partitions; fall back to the cluster wide default
+    std::optional<size_t>
+    effective_retention_bytes(std::optional<size_t> default_bytes) const {
+        if (config().has_overrides()) {
+            const auto& bytes = config().get_overrides().retention_bytes;
+            if (bytes.is_disabled()) {
+                return std::nullopt;
+            }
+            if (bytes.has_value()) {
+                return bytes.value();
+            }
+        }
+        return default_bytes;
+    }
+
+    std::optional<model::timestamp>
+    retention_eligible_at(std::optional<size_t> retention_bytes) const final {
+        if (_data.empty()) {
+            return std::nullopt;
+        }
+        auto budget = effective_retention_bytes(retention_bytes);
+        if (budget && _probe.partition_bytes > *budget) {
+            return model::timestamp(0);
+        }
+        return _data.front().header().max_timestamp;
+    }
+
     ss::future<model::offset> monitor_eviction(ss::abort_source& as) final {
         if (_eviction_monitor) {
             throw std::logic_error("Eviction promise already registered. "
@@ -37,6 +37,9 @@ public:
         tristate<std::chrono::milliseconds> retention_time{std::nullopt};
         // if set, log will not use batch cache
         with_cache cache_enabled = with_cache::yes;
+        // if set, the partition lives entirely in memory. data does not
+        // survive a restart and retention_bytes acts as the memory budget
+        bool in_memory = false;
 
         friend std::ostream&
         operator<<(std::ostream&, const default_overrides&);
@@ -111,6 +114,8 @@ public:
         return with_cache(!has_overrides() || _overrides->cache_enabled);
     }
 
+    bool is_in_memory() const { return _overrides && _overrides->in_memory; }
+
 private:
     model::ntp _ntp;
     /// \brief currently this is the basedir. In the future
@@ -74,109 +74,122 @@ model::record_batch_header header_from_iobuf(iobuf b) {
     return hdr;
 }
 
-static ss::future<result<iobuf>> verify_read_iobuf(
-  ss::input_stream<char>& in, size_t expected, ss::sstring msg) {
-    return read_iobuf_exactly(in, expected)
-      .then([msg = std::move(msg), expected](iobuf b) {
-          if (likely(b.size_bytes() == expected)) {
-              return ss::make_ready_future<result<iobuf>>(std::move(b));
-          }
-          stlog.error(
-            "Cannot continue parsing. recived size:{} bytes, expected:{} "
-            "bytes. context:{}",
-            b.size_bytes(),
-            expected,
-            msg);
-          return ss::make_ready_future<result<iobuf>>(
-            parser_errc::input_stream_not_enough_bytes);
+ss::future<> continuous_batch_parser::fill_window(size_t min_bytes) {
+    return ss::do_until(
+      [this, min_bytes] {
+          return _window.size_bytes() >= min_bytes || _input.eof();
+      },
+      [this] {
+          // take whole stream buffers at a time. every complete batch in
+          // the window is then decoded without touching the stream again
+          return _input.read().then([this](ss::temporary_buffer<char> b) {
+              if (b.size()) {
+                  _window.append(std::move(b));
+              }
+          });
       });
 }
 
-ss::future<result<stop_parser>> continuous_batch_parser::consume_header() {
-    return read_iobuf_exactly(_input, model::packed_record_batch_header_size)
-      .then([this](iobuf b) -> result<iobuf> {
-          if (b.empty()) {
-              // benign outcome. happens at end of file
-              return parser_errc::end_of_stream;
-          }
-          if (b.size_bytes() != model::packed_record_batch_header_size) {
+ss::future<result<iobuf>>
+continuous_batch_parser::read_window(size_t expected, ss::sstring msg) {
+    if (likely(_window.size_bytes() >= expected)) {
+        auto b = _window.share(0, expected);
+        _window.trim_front(expected);
+        return ss::make_ready_future<result<iobuf>>(std::move(b));
+    }
+    return fill_window(expected).then(
+      [this, expected, msg = std::move(msg)]() -> result<iobuf> {
+          if (unlikely(_window.size_bytes() < expected)) {
               stlog.error(
-                "Could not parse header. Expected:{}, but Got:{}. consumer:{}",
-                model::packed_record_batch_header_size,
-                b.size_bytes(),
-                *_consumer);
+                "Cannot continue parsing. recived size:{} bytes, expected:{} "
+                "bytes. context:{}",
+                _window.size_bytes(),
+                expected,
+                msg);
               return parser_errc::input_stream_not_enough_bytes;
           }
-          return b;
-      })
-      .then([](result<iobuf> b) {
-          if (!b) {
-              return ss::make_ready_future<result<model::record_batch_header>>(
-                b.error());
-          }
-          return ss::make_ready_future<result<model::record_batch_header>>(
-            header_from_iobuf(std::move(b.value())));
-      })
-      .then([this](result<model::record_batch_header> o) {
-          if (!o) {
-              return ss::make_ready_future<result<stop_parser>>(o.error());
-          }
-          if (o.value().header_crc == 0) {
-              // happens when we fallocate the file
-              return ss::make_ready_future<result<stop_parser>>(
-                parser_errc::end_of_stream);
-          }
-          if (auto computed_crc = model::internal_header_only_crc(o.value());
-              unlikely(o.value().header_crc != computed_crc)) {
-              vlog(
-                stlog.error,
-                "detected header corruption. stopping parser. Expected CRC of "
-                "{}, but got header CRC: {} - {}. consumer:{}",
-                computed_crc,
-                o.value().header_crc,
-                o.value(),
-                *_consumer);
-              return ss::make_ready_future<result<stop_parser>>(
-                parser_errc::header_only_crc_missmatch);
-          }
-          if (unlikely(o.value().header_crc == 0)) {
-              return ss::make_ready_future<result<stop_parser>>(
-                parser_errc::fallocated_file_read_zero_bytes_for_header);
-          }
-          _header = o.value();
-          const auto size_on_disk = _header.size_bytes;
-          auto ret = _consumer->consume_batch_start(
-            _header, _physical_base_offset, size_on_disk);
-          _physical_base_offset += size_on_disk;
-          if (std::holds_alternative<skip_batch>(ret)) {
-              auto s = std::get<skip_batch>(ret);
-              if (unlikely(bool(s))) {
-                  auto remaining = _header.size_bytes
-                                   - model::packed_record_batch_header_size;
-                  return verify_read_iobuf(
-                           _input, remaining, "parser::skip_batch")
-                    .then([this](result<iobuf> b) {
-                        if (!b) {
-                            return ss::make_ready_future<result<stop_parser>>(
-                              b.error());
-                        }
-                        // start again
-                        add_bytes_and_reset();
-                        return consume_header();
-                    });
-              }
-              return ss::make_ready_future<result<stop_parser>>(
-                stop_parser::no);
-          }
-          auto s = std::get<stop_parser>(ret);
-          if (unlikely(bool(s))) {
-              return ss::make_ready_future<result<stop_parser>>(
-                stop_parser::yes);
-          }
-          return ss::make_ready_future<result<stop_parser>>(stop_parser::no);
+          auto b = _window.share(0, expected);
+          _window.trim_front(expected);
+          return result<iobuf>(std::move(b));
       });
 }
 
+ss::future<result<stop_parser>> continuous_batch_parser::consume_header() {
+    if (unlikely(
+          _window.size_bytes() < model::packed_record_batch_header_size)) {
+        return fill_window(model::packed_record_batch_header_size)
+          .then([this]() -> ss::future<result<stop_parser>> {
+              if (
+                _window.size_bytes()
+                < model::packed_record_batch_header_size) {
+                  if (_window.empty()) {
+                      // benign outcome. happens at end of file
+                      return ss::make_ready_future<result<stop_parser>>(
+                        parser_errc::end_of_stream);
+                  }
+                  stlog.error(
+                    "Could not parse header. Expected:{}, but Got:{}. "
+                    "consumer:{}",
+                    model::packed_record_batch_header_size,
+                    _window.size_bytes(),
+                    *_consumer);
+                  return ss::make_ready_future<result<stop_parser>>(
+                    parser_errc::input_stream_not_enough_bytes);
+              }
+              return consume_header();
+          });
+    }
+    auto b = _window.share(0, model::packed_record_batch_header_size);
+    _window.trim_front(model::packed_record_batch_header_size);
+    auto o = header_from_iobuf(std::move(b));
+    if (o.header_crc == 0) {
+        // happens when we fallocate the file
+        return ss::make_ready_future<result<stop_parser>>(
+          parser_errc::end_of_stream);
+    }
+    if (auto computed_crc = model::internal_header_only_crc(o);
+        unlikely(o.header_crc != computed_crc)) {
+        vlog(
+          stlog.error,
+          "detected header corruption. stopping parser. Expected CRC of "
+          "{}, but got header CRC: {} - {}. consumer:{}",
+          computed_crc,
+          o.header_crc,
+          o,
+          *_consumer);
+        return ss::make_ready_future<result<stop_parser>>(
+          parser_errc::header_only_crc_missmatch);
+    }
+    _header = o;
+    const auto size_on_disk = _header.size_bytes;
+    auto ret = _consumer->consume_batch_start(
+      _header, _physical_base_offset, size_on_disk);
+    _physical_base_offset += size_on_disk;
+    if (std::holds_alternative<skip_batch>(ret)) {
+        auto s = std::get<skip_batch>(ret);
+        if (unlikely(bool(s))) {
+            auto remaining = _header.size_bytes
+                             - model::packed_record_batch_header_size;
+            return read_window(remaining, "parser::skip_batch")
+              .then([this](result<iobuf> b) {
+                  if (!b) {
+                      return ss::make_ready_future<result<stop_parser>>(
+                        b.error());
+                  }
+                  // start again
+                  add_bytes_and_reset();
+                  return consume_header();
+              });
+        }
+        return ss::make_ready_future<result<stop_parser>>(stop_parser::no);
+    }
+    auto s = std::get<stop_parser>(ret);
+    if (unlikely(bool(s))) {
+        return ss::make_ready_future<result<stop_parser>>(stop_parser::yes);
+    }
+    return ss::make_ready_future<result<stop_parser>>(stop_parser::no);
+}
+
 ss::future<result<stop_parser>> continuous_batch_parser::consume_one() {
     return consume_header().then([this](result<stop_parser> st) {
         if (!st) {
@@ -199,7 +212,7 @@ void continuous_batch_parser::add_bytes_and_reset() {
 }
 ss::future<result<stop_parser>> continuous_batch_parser::consume_records() {
     auto sz = _header.size_bytes - model::packed_record_batch_header_size;
-    return verify_read_iobuf(_input, sz, "parser::consume_records")
+    return read_window(sz, "parser::consume_records")
       .then([this](result<iobuf> record) -> result<stop_parser> {
           if (!record) {
               return record.error();
@@ -216,7 +229,9 @@ ss::future<result<size_t>> continuous_batch_parser::consume() {
     return ss::repeat([this] {
                return consume_one().then([this](result<stop_parser> s) {
                    add_bytes_and_reset();
-                   if (_input.eof()) {
+                   // the stream may be exhausted while the window still
+                   // holds complete batches; only stop once both are dry
+                   if (_input.eof() && _window.empty()) {
                        return ss::stop_iteration::yes;
                    }
                    if (!s) {
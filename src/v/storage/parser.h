@@ -68,6 +68,13 @@ inline std::ostream& operator<<(std::ostream& os, const batch_consumer& c) {
     return os;
 }
 
+/**
+ * Pull-based batch parser. Reads whole buffers from the input stream
+ * into an internal window and decodes every complete batch found there
+ * without touching the stream again, so for small batches the cost is
+ * one stream read and one task per window instead of per batch. Only a
+ * batch spanning the window boundary falls back to reading more.
+ */
 class continuous_batch_parser {
 public:
     continuous_batch_parser(
@@ -101,9 +108,20 @@ private:
     size_t consumed_batch_bytes() const;
     void add_bytes_and_reset();
 
+    /// append stream buffers to the window until it holds at least
+    /// @min_bytes or the stream is exhausted
+    ss::future<> fill_window(size_t min_bytes);
+
+    /// detach exactly @expected bytes from the front of the window,
+    /// reading more from the stream only when the window runs short
+    ss::future<result<iobuf>> read_window(size_t expected, ss::sstring msg);
+
 private:
     std::unique_ptr<batch_consumer> _consumer;
     ss::input_stream<char> _input;
+    /// bytes buffered off the stream but not yet handed to the consumer.
+    /// survives a consumer stop so a resumed parse picks up mid-window
+    iobuf _window;
     model::record_batch_header _header;
     parser_errc _err = parser_errc::none;
     size_t _bytes_consumed{0};
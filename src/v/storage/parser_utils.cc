@@ -18,9 +18,21 @@
 #include "vlog.h"
 
 #include <seastar/core/byteorder.hh>
+#include <seastar/core/future-util.hh>
+
+#include <optional>
 
 namespace storage::internal {
 
+// isolates codec cpu from the request scheduling groups. set once at
+// startup; unset in unit tests and tools, where codec work stays in the
+// caller's group.
+static thread_local std::optional<ss::scheduling_group> codec_sg;
+
+void set_compression_scheduling_group(ss::scheduling_group sg) {
+    codec_sg = sg;
+}
+
 ss::future<model::record_batch> decompress_batch(model::record_batch&& b) {
     if (!b.compressed()) {
         return ss::make_ready_future<model::record_batch>(std::move(b));
@@ -28,6 +40,17 @@ ss::future<model::record_batch> decompress_batch(model::record_batch&& b) {
     return decompress_batch(b);
 }
 
+static model::record_batch do_decompress_batch(const model::record_batch& b) {
+    iobuf body_buf = compression::compressor::uncompress(
+      b.data(), b.header().attrs.compression());
+    // must remove compression first!
+    auto h = b.header();
+    h.attrs.remove_compression();
+    reset_size_checksum_metadata(h, body_buf);
+    return model::record_batch(
+      h, std::move(body_buf), model::record_batch::tag_ctor_ng{});
+}
+
 ss::future<model::record_batch> decompress_batch(const model::record_batch& b) {
     if (unlikely(!b.compressed())) {
         return ss::make_exception_future<model::record_batch>(
@@ -36,15 +59,12 @@ ss::future<model::record_batch> decompress_batch(const model::record_batch& b) {
             "Asked to decompressed a non-compressed batch:{}",
             b.header())));
     }
-    iobuf body_buf = compression::compressor::uncompress(
-      b.data(), b.header().attrs.compression());
-    // must remove compression first!
-    auto h = b.header();
-    h.attrs.remove_compression();
-    reset_size_checksum_metadata(h, body_buf);
-    auto batch = model::record_batch(
-      h, std::move(body_buf), model::record_batch::tag_ctor_ng{});
-    return ss::make_ready_future<model::record_batch>(std::move(batch));
+    if (!codec_sg) {
+        return ss::make_ready_future<model::record_batch>(
+          do_decompress_batch(b));
+    }
+    return ss::with_scheduling_group(
+      *codec_sg, [&b] { return do_decompress_batch(b); });
 }
 
 ss::future<model::record_batch>
@@ -61,6 +81,17 @@ compress_batch(model::compression c, model::record_batch&& b) {
         return compress_batch(c, b);
     });
 }
+static model::record_batch
+do_compress_batch(model::compression c, const model::record_batch& b) {
+    auto payload = compression::compressor::compress(b.data(), c);
+    auto h = b.header();
+    // compression bit must be set first!
+    h.attrs |= c;
+    reset_size_checksum_metadata(h, payload);
+    return model::record_batch(
+      h, std::move(payload), model::record_batch::tag_ctor_ng{});
+}
+
 ss::future<model::record_batch>
 compress_batch(model::compression c, const model::record_batch& b) {
     vassert(
@@ -68,14 +99,12 @@ compress_batch(model::compression c, const model::record_batch& b) {
       "Asked to compress a batch with type `none`: {} - {}",
       c,
       b.header());
-    auto payload = compression::compressor::compress(b.data(), c);
-    auto h = b.header();
-    // compression bit must be set first!
-    h.attrs |= c;
-    reset_size_checksum_metadata(h, payload);
-    auto batch = model::record_batch(
-      h, std::move(payload), model::record_batch::tag_ctor_ng{});
-    return ss::make_ready_future<model::record_batch>(std::move(batch));
+    if (!codec_sg) {
+        return ss::make_ready_future<model::record_batch>(
+          do_compress_batch(c, b));
+    }
+    return ss::with_scheduling_group(
+      *codec_sg, [c, &b] { return do_compress_batch(c, b); });
 }
 
 /// \brief resets the size, header crc and payload crc
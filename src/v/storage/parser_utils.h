@@ -13,9 +13,17 @@
 
 #include "bytes/iobuf_parser.h"
 #include "model/record.h"
+#include "seastarx.h"
+
+#include <seastar/core/scheduling.hh>
 
 namespace storage::internal {
 
+/// \brief scheduling group used for batch codec work on this shard.
+/// when unset, compression and decompression run inline in the caller's
+/// group. already-uncompressed batches always bypass the group switch.
+void set_compression_scheduling_group(ss::scheduling_group);
+
 /// \brief batch decompression
 ss::future<model::record_batch> decompress_batch(model::record_batch&&);
 /// \brief batch decompression
@@ -63,6 +63,22 @@ void probe::setup_metrics(const model::ntp& ntp) {
           [this] { return _cached_batches_read; },
           sm::description("Total number of cached batches read"),
           labels),
+        sm::make_derive(
+          "reader_cache_hits",
+          [this] { return _reader_cache_hits; },
+          sm::description("Number of fetches served by a cached log reader"),
+          labels),
+        sm::make_derive(
+          "reader_cache_misses",
+          [this] { return _reader_cache_misses; },
+          sm::description("Number of fetches that created a new log reader"),
+          labels),
+        sm::make_gauge(
+          "read_window_bytes",
+          [this] { return _read_window; },
+          sm::description(
+            "Read window last chosen by the rate-adaptive reader sizing"),
+          labels),
         sm::make_derive(
           "log_segments_created",
           [this] { return _log_segments_created; },
@@ -97,6 +113,20 @@ void probe::setup_metrics(const model::ntp& ntp) {
       });
 }
 
+std::vector<attribution_sample> probe::attribution_samples() const {
+    std::vector<attribution_sample> out;
+    out.reserve(_samples.size());
+    if (_samples.size() < attribution_ring_capacity) {
+        // ring not yet full, samples are already in insertion order
+        out.assign(_samples.begin(), _samples.end());
+        return out;
+    }
+    for (size_t i = 0; i < _samples.size(); ++i) {
+        out.push_back(_samples[(_sample_head + i) % _samples.size()]);
+    }
+    return out;
+}
+
 void probe::add_initial_segment(const segment& s) {
     _partition_bytes += s.reader().file_size();
 }
@@ -13,21 +13,43 @@
 #include "model/fundamental.h"
 #include "storage/logger.h"
 #include "storage/segment.h"
+#include "storage/types.h"
 
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/shared_ptr.hh>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <vector>
 
 namespace storage {
 class probe {
 public:
+    /// granularity of the append rate estimate below
+    static constexpr std::chrono::seconds append_rate_window{5};
+
+    /// depth of the attribution ring; at one sample per second this keeps
+    /// about two minutes of history per partition
+    static constexpr size_t attribution_ring_capacity = 128;
+    /// floor between attribution samples. the writer is a handful of
+    /// integer stores behind this gate, which keeps the instrumentation
+    /// cost negligible on hot append paths
+    static constexpr std::chrono::seconds attribution_sample_interval{1};
+
     void add_bytes_written(uint64_t written) {
         _partition_bytes += written;
         _bytes_written += written;
+        _rate_window_bytes += written;
+        maybe_roll_rate_window();
+        maybe_sample();
     }
 
-    void add_bytes_read(uint64_t read) { _bytes_read += read; }
+    void add_bytes_read(uint64_t read) {
+        _bytes_read += read;
+        maybe_sample();
+    }
     void add_cached_bytes_read(uint64_t read) { _cached_bytes_read += read; }
 
     void batch_written() { ++_batches_written; }
@@ -50,6 +72,34 @@ public:
 
     void batch_parse_error() { ++_batch_parse_errors; }
 
+    void reader_cache_hit() { ++_reader_cache_hits; }
+    void reader_cache_miss() { ++_reader_cache_misses; }
+    uint64_t reader_cache_hits() const { return _reader_cache_hits; }
+
+    /// window last chosen by the rate-adaptive log reader sizing
+    void set_read_window(size_t window) { _read_window = window; }
+    size_t read_window() const { return _read_window; }
+
+    /// opt-in per-ntp attribution sampling, disabled unless the log
+    /// backend asks for it (see log_config::sampled_attribution)
+    void enable_attribution() {
+        _attribution = true;
+        _samples.reserve(attribution_ring_capacity);
+    }
+    bool attribution_enabled() const { return _attribution; }
+
+    void add_append_latency(ss::lowres_clock::duration d) {
+        if (!_attribution) {
+            return;
+        }
+        _last_append_latency_us
+          = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+        maybe_sample();
+    }
+
+    /// snapshot of the attribution ring, oldest sample first
+    std::vector<attribution_sample> attribution_samples() const;
+
     void setup_metrics(const model::ntp&);
 
     void delete_segment(const segment&);
@@ -58,7 +108,64 @@ public:
     void add_initial_segment(const segment&);
     void remove_partition_bytes(size_t remove) { _partition_bytes -= remove; }
 
+    /// decayed estimate of this partition's append rate in bytes/sec.
+    /// queried at segment roll to size the next fallocation step
+    uint64_t append_rate_bps() {
+        maybe_roll_rate_window();
+        return _append_rate_bps;
+    }
+
 private:
+    void maybe_sample() {
+        if (!_attribution) {
+            return;
+        }
+        const auto now = ss::lowres_clock::now();
+        if (now - _last_sample < attribution_sample_interval) {
+            return;
+        }
+        _last_sample = now;
+        auto s = attribution_sample{
+          .when = ss::lowres_system_clock::now(),
+          .bytes_written = _bytes_written,
+          .bytes_read = _bytes_read + _cached_bytes_read,
+          .batches_written = _batches_written,
+          .append_latency_us = _last_append_latency_us,
+        };
+        if (_samples.size() < attribution_ring_capacity) {
+            _samples.push_back(s);
+        } else {
+            _samples[_sample_head] = s;
+        }
+        _sample_head = (_sample_head + 1) % attribution_ring_capacity;
+    }
+
+    void maybe_roll_rate_window() {
+        const auto now = ss::lowres_clock::now();
+        const auto elapsed = now - _rate_window_start;
+        if (elapsed < append_rate_window) {
+            return;
+        }
+        const auto secs = std::chrono::duration_cast<std::chrono::seconds>(
+                            elapsed)
+                            .count();
+        const uint64_t current = _rate_window_bytes
+                                 / std::max<int64_t>(secs, 1);
+        // halve the estimate once per elapsed window so long-idle
+        // partitions decay toward zero, then blend in the current window.
+        // one hot window moves the estimate but does not commit to it
+        const auto windows = std::min<uint64_t>(
+          elapsed / append_rate_window, 32);
+        _append_rate_bps >>= windows;
+        _append_rate_bps += current / 2;
+        _rate_window_bytes = 0;
+        _rate_window_start = now;
+    }
+
+    uint64_t _rate_window_bytes = 0;
+    uint64_t _append_rate_bps = 0;
+    ss::lowres_clock::time_point _rate_window_start{ss::lowres_clock::now()};
+
     uint64_t _partition_bytes = 0;
     uint64_t _bytes_written = 0;
     uint64_t _bytes_read = 0;
@@ -68,6 +175,18 @@ private:
     uint64_t _batches_read = 0;
     uint64_t _cached_batches_read = 0;
 
+    uint64_t _reader_cache_hits = 0;
+    uint64_t _reader_cache_misses = 0;
+    size_t _read_window = 0;
+
+    bool _attribution = false;
+    uint64_t _last_append_latency_us = 0;
+    ss::lowres_clock::time_point _last_sample;
+    // fixed capacity ring, _sample_head is the next slot overwritten once
+    // the ring is full
+    std::vector<attribution_sample> _samples;
+    size_t _sample_head = 0;
+
     uint32_t _segment_compacted = 0;
     uint32_t _corrupted_compaction_index = 0;
     uint32_t _log_segments_created = 0;
@@ -0,0 +1,174 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/readers_cache.h"
+
+#include "storage/logger.h"
+#include "vlog.h"
+
+#include <seastar/core/future-util.hh>
+
+#include <fmt/ostream.h>
+
+#include <algorithm>
+
+namespace storage {
+
+/*
+ * Delegating record_batch_reader implementation that offers the
+ * underlying log_reader back to the cache once the consumer runs
+ * finally(), instead of closing it.
+ */
+class readers_cache::cached_reader final
+  : public model::record_batch_reader::impl {
+public:
+    cached_reader(std::unique_ptr<log_reader> r, readers_cache* cache) noexcept
+      : _underlying(std::move(r))
+      , _cache(cache)
+      , _epoch(cache->_eviction_epoch) {}
+
+    bool is_end_of_stream() const final {
+        return _underlying->is_end_of_stream();
+    }
+
+    ss::future<model::record_batch_reader::storage_t>
+    do_load_slice(model::timeout_clock::time_point t) final {
+        return _underlying->do_load_slice(t);
+    }
+
+    void print(std::ostream& os) final {
+        fmt::print(os, "storage::readers_cache::cached_reader - ");
+        _underlying->print(os);
+    }
+
+    ss::future<> finally() noexcept final {
+        return _cache->offer(std::move(_underlying), _epoch);
+    }
+
+private:
+    std::unique_ptr<log_reader> _underlying;
+    readers_cache* _cache;
+    uint64_t _epoch;
+};
+
+readers_cache::readers_cache(
+  model::ntp ntp, probe& p, eviction_clock::duration eviction_timeout)
+  : _ntp(std::move(ntp))
+  , _probe(p)
+  , _eviction_timeout(eviction_timeout) {
+    _eviction_timer.set_callback([this] { evict_stale(); });
+}
+
+std::optional<model::record_batch_reader>
+readers_cache::get(const log_reader_config& cfg) {
+    if (_stopped) {
+        return std::nullopt;
+    }
+    auto it = std::find_if(
+      _readers.begin(), _readers.end(), [&cfg](const entry& e) {
+          return e.reader->next_read_offset() == cfg.start_offset
+                 && e.reader->lease_covers(cfg.start_offset);
+      });
+    if (it == _readers.end()) {
+        _probe.reader_cache_miss();
+        return std::nullopt;
+    }
+    auto reader = std::move(it->reader);
+    _readers.erase(it);
+    reader->reset_config(cfg);
+    _probe.reader_cache_hit();
+    vlog(
+      stlog.trace,
+      "{} readers cache hit for offset {}",
+      _ntp,
+      cfg.start_offset);
+    return wrap(std::move(reader));
+}
+
+model::record_batch_reader
+readers_cache::wrap(std::unique_ptr<log_reader> reader) {
+    return model::record_batch_reader(
+      std::make_unique<cached_reader>(std::move(reader), this));
+}
+
+ss::future<>
+readers_cache::offer(std::unique_ptr<log_reader> reader, uint64_t epoch) {
+    if (_stopped || epoch != _eviction_epoch || !reader->is_reusable()) {
+        // an eviction epoch mismatch means evict_all ran while this
+        // reader was out on a fetch; its lease may cover segments a
+        // truncation is waiting to write lock, so it must not re-park
+        return close_reader(std::move(reader));
+    }
+    reader->detach_abort_source();
+    entry e{
+      .reader = std::move(reader),
+      .last_used = eviction_clock::now(),
+    };
+    if (_readers.size() < max_readers) {
+        _readers.push_back(std::move(e));
+        maybe_arm_eviction_timer();
+        return ss::make_ready_future<>();
+    }
+    // full: replace the least recently used reader
+    auto victim_it = std::min_element(
+      _readers.begin(), _readers.end(), [](const entry& a, const entry& b) {
+          return a.last_used < b.last_used;
+      });
+    auto victim = std::exchange(*victim_it, std::move(e));
+    return close_reader(std::move(victim.reader));
+}
+
+ss::future<> readers_cache::close_reader(std::unique_ptr<log_reader> reader) {
+    auto raw = reader.get();
+    return raw->finally().finally([reader = std::move(reader)] {});
+}
+
+ss::future<> readers_cache::evict_all() {
+    ++_eviction_epoch;
+    return ss::do_with(
+      std::exchange(_readers, {}), [](std::vector<entry>& readers) {
+          return ss::do_for_each(readers, [](entry& e) {
+              return close_reader(std::move(e.reader));
+          });
+      });
+}
+
+void readers_cache::evict_stale() {
+    const auto expired = eviction_clock::now() - _eviction_timeout;
+    auto it = std::stable_partition(
+      _readers.begin(), _readers.end(), [expired](const entry& e) {
+          return e.last_used > expired;
+      });
+    for (auto i = it; i != _readers.end(); ++i) {
+        vlog(
+          stlog.debug,
+          "{} closing idle cached reader at offset {}",
+          _ntp,
+          i->reader->next_read_offset());
+        (void)ss::with_gate(_gate, [r = std::move(i->reader)]() mutable {
+            return close_reader(std::move(r));
+        });
+    }
+    _readers.erase(it, _readers.end());
+    maybe_arm_eviction_timer();
+}
+
+void readers_cache::maybe_arm_eviction_timer() {
+    if (!_readers.empty() && !_eviction_timer.armed()) {
+        _eviction_timer.arm(_eviction_timeout);
+    }
+}
+
+ss::future<> readers_cache::stop() {
+    _stopped = true;
+    _eviction_timer.cancel();
+    return evict_all().then([this] { return _gate.close(); });
+}
+
+} // namespace storage
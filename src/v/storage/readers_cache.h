@@ -0,0 +1,109 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "model/record_batch_reader.h"
+#include "storage/log_reader.h"
+#include "storage/probe.h"
+
+#include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/timer.hh>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace storage {
+
+/**
+ * Per-partition cache of warm log readers.
+ *
+ * A sequential consumer issues one fetch after another, each starting
+ * exactly where the previous one ended - and each fetch used to pay for
+ * a fresh range lock, a segment set lookup and an index seek. When a
+ * reader finishes a fetch cleanly its consumer offers it back here,
+ * keyed by the offset it would deliver next; the next fetch starting at
+ * that offset picks it up with its lease, segment cursor and parser
+ * state intact.
+ *
+ * Cached readers pin their lease's segment read locks, so the log must
+ * evict this cache before any operation that takes segment write locks
+ * (truncation, compaction, removal). Idle readers are closed after
+ * eviction_timeout to release their file handles.
+ */
+class readers_cache {
+public:
+    static constexpr size_t max_readers = 10;
+    using eviction_clock = ss::lowres_clock;
+    static constexpr eviction_clock::duration default_eviction_timeout
+      = std::chrono::seconds(30);
+
+    readers_cache(
+      model::ntp,
+      probe&,
+      eviction_clock::duration eviction_timeout = default_eviction_timeout);
+    readers_cache(const readers_cache&) = delete;
+    readers_cache& operator=(const readers_cache&) = delete;
+    readers_cache(readers_cache&&) = delete;
+    readers_cache& operator=(readers_cache&&) = delete;
+    ~readers_cache() noexcept = default;
+
+    /// \brief returns a cached reader positioned exactly at
+    /// cfg.start_offset, reconfigured for this read, or std::nullopt
+    std::optional<model::record_batch_reader> get(const log_reader_config&);
+
+    /// \brief wrap a freshly created reader so its consumer offers it
+    /// back to this cache when done with it
+    model::record_batch_reader wrap(std::unique_ptr<log_reader>);
+
+    /// \brief close every cached reader, releasing their segment read
+    /// locks, and fence readers currently out on a fetch so they are
+    /// closed instead of re-cached when their consumer finishes. must run
+    /// before any operation that takes segment write locks
+    ss::future<> evict_all();
+
+    /// \brief evict everything and refuse new entries; readers offered
+    /// back after this point are closed instead of cached
+    ss::future<> stop();
+
+    size_t size() const { return _readers.size(); }
+
+private:
+    class cached_reader;
+    struct entry {
+        std::unique_ptr<log_reader> reader;
+        eviction_clock::time_point last_used;
+    };
+
+    /// called by cached_reader when the consumer finished with the
+    /// reader. epoch is the eviction epoch the reader was handed out in;
+    /// if an evict_all happened since, the reader is closed, not cached
+    ss::future<> offer(std::unique_ptr<log_reader>, uint64_t epoch);
+    static ss::future<> close_reader(std::unique_ptr<log_reader>);
+    void evict_stale();
+    void maybe_arm_eviction_timer();
+
+    model::ntp _ntp;
+    probe& _probe;
+    eviction_clock::duration _eviction_timeout;
+    std::vector<entry> _readers;
+    // bumped by evict_all; readers wrapped under an older epoch may hold
+    // read locks on segments that have since been truncated or removed
+    uint64_t _eviction_epoch{0};
+    bool _stopped{false};
+    ss::gate _gate;
+    ss::timer<eviction_clock> _eviction_timer;
+};
+
+} // namespace storage
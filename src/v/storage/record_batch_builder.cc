@@ -27,7 +27,7 @@ record_batch_builder::~record_batch_builder() {}
 
 model::record_batch record_batch_builder::build() && {
     int32_t offset_delta = 0;
-    auto now_ts = model::timestamp::now();
+    auto now_ts = model::timestamp::now_coarse();
 
     model::record_batch_header header = {
       .size_bytes = 0,
@@ -46,6 +46,20 @@ model::record_batch record_batch_builder::build() && {
         model::term_id(0), ss::this_shard_id())};
 
     iobuf records;
+    /*
+     * the payload size is exactly computable up front - every field is
+     * either fixed width or a vint over known lengths - so reserve it in
+     * one shot. the batch then lands in a single fragment instead of
+     * growing the fragment list record by record, and no append below
+     * allocates.
+     */
+    size_t payload_size = 0;
+    int32_t size_delta = 0;
+    for (const auto& sr : _records) {
+        const auto rec_sz = record_size(size_delta++, sr);
+        payload_size += vint::vint_size(rec_sz) + rec_sz;
+    }
+    records.reserve_memory(payload_size);
     for (auto& sr : _records) {
         auto rec_sz = record_size(offset_delta, sr);
         auto kz = sr.key.size_bytes();
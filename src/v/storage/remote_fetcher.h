@@ -0,0 +1,53 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "model/record_batch_reader.h"
+#include "seastarx.h"
+#include "storage/types.h"
+
+#include <seastar/core/future.hh>
+
+#include <optional>
+
+namespace storage {
+
+/// \brief Hook for reading log data that is no longer held locally.
+///
+/// Retention deletes local segments, but archived copies may still exist
+/// in object storage. When a reader asks for an offset below the local
+/// start of the log, disk_log_impl consults this hook (when one is
+/// installed on the log_manager) instead of failing the read.
+///
+/// Implementations live above the storage layer - they need an object
+/// store client - so storage only defines the extension point and takes
+/// no dependency on any particular backend.
+class remote_fetcher {
+public:
+    remote_fetcher() noexcept = default;
+    remote_fetcher(const remote_fetcher&) = delete;
+    remote_fetcher& operator=(const remote_fetcher&) = delete;
+    remote_fetcher(remote_fetcher&&) noexcept = default;
+    remote_fetcher& operator=(remote_fetcher&&) noexcept = default;
+    virtual ~remote_fetcher() noexcept = default;
+
+    /// Build a reader over archived batches for the requested range.
+    ///
+    /// \return a reader delivering batches within [start_offset,
+    /// max_offset], or std::nullopt when nothing is archived for this
+    /// ntp in that range.
+    virtual ss::future<std::optional<model::record_batch_reader>>
+    fetch(const model::ntp&, log_reader_config) = 0;
+};
+
+} // namespace storage
@@ -11,6 +11,7 @@
 
 #include "compression/compression.h"
 #include "config/configuration.h"
+#include "storage/clean_checkpoint.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/fs_utils.h"
 #include "storage/logger.h"
@@ -92,9 +93,10 @@ ss::future<> segment::remove_persistent_state() {
     vassert(is_closed(), "Cannot clear state from unclosed segment");
 
     std::vector<std::filesystem::path> rm;
-    rm.reserve(3);
+    rm.reserve(4);
     rm.emplace_back(reader().filename().c_str());
     rm.emplace_back(index().filename().c_str());
+    rm.emplace_back(clean_checkpoint_path(reader().filename()));
     if (is_compacted_segment()) {
         rm.push_back(
           internal::compacted_index_path(reader().filename().c_str()));
@@ -120,7 +122,24 @@ ss::future<> segment::remove_tombstones() {
 }
 
 ss::future<> segment::do_close() {
-    auto f = _reader.close();
+    auto f = ss::now();
+    if (_appender) {
+        // a final checkpoint marks the whole segment clean so the next
+        // startup can skip replaying it
+        f = write_clean_checkpoint(
+              _reader.filename(),
+              clean_checkpoint{
+                .last_offset = _tracker.committed_offset,
+                .file_pos = _appender->file_byte_offset()})
+              .handle_exception([this](const std::exception_ptr& e) {
+                  vlog(
+                    stlog.warn,
+                    "failed to write clean checkpoint for {}: {}",
+                    _reader.filename(),
+                    e);
+              });
+    }
+    f = f.then([this] { return _reader.close(); });
     if (_appender) {
         f = f.then([this] { return _appender->close(); });
     }
@@ -143,6 +162,7 @@ ss::future<> segment::do_release_appender(
       [this, cache = std::move(cache)](
         std::optional<segment_appender>& appender,
         std::optional<compacted_index_writer>& compacted_index) {
+          const auto fpos = appender->file_byte_offset();
           return appender->close()
             .then([this] { return _idx.flush(); })
             .then([&compacted_index] {
@@ -150,6 +170,21 @@ ss::future<> segment::do_release_appender(
                     return compacted_index->close();
                 }
                 return ss::now();
+            })
+            .then([this, fpos] {
+                // the segment is sealed; checkpoint it as fully clean
+                return write_clean_checkpoint(
+                         _reader.filename(),
+                         clean_checkpoint{
+                           .last_offset = _tracker.committed_offset,
+                           .file_pos = fpos})
+                  .handle_exception([this](const std::exception_ptr& e) {
+                      vlog(
+                        stlog.warn,
+                        "failed to write clean checkpoint for {}: {}",
+                        _reader.filename(),
+                        e);
+                  });
             });
       });
 }
@@ -234,9 +269,41 @@ ss::future<> segment::do_flush() {
         _tracker.committed_offset = o;
         _tracker.stable_offset = o;
         _reader.set_file_size(fsize);
+        return maybe_persist_clean_checkpoint(o, fsize);
     });
 }
 
+/*
+ * periodically checkpoint the flushed prefix of the segment so replay
+ * after a crash can verify the clean prefix in one read instead of
+ * streaming it through storage::parser. see clean_checkpoint.h.
+ */
+static constexpr size_t clean_checkpoint_step = 32_MiB;
+
+ss::future<>
+segment::maybe_persist_clean_checkpoint(model::offset o, size_t fsize) {
+    if (fsize < _clean_ckpt_pos + clean_checkpoint_step) {
+        return ss::make_ready_future<>();
+    }
+    _clean_ckpt_pos = fsize;
+    // the fast replay path seeds the offset tracker from the on-disk
+    // index, so the index must be at least as new as the checkpoint it
+    // validates against
+    return _idx.flush()
+      .then([this, o, fsize] {
+          return write_clean_checkpoint(
+            _reader.filename(),
+            clean_checkpoint{.last_offset = o, .file_pos = fsize});
+      })
+      .handle_exception([this](const std::exception_ptr& e) {
+          vlog(
+            stlog.warn,
+            "failed to write clean checkpoint for {}: {}",
+            _reader.filename(),
+            e);
+      });
+}
+
 ss::future<> remove_compacted_index(const ss::sstring& reader_path) {
     auto path = internal::compacted_index_path(reader_path.c_str());
     return ss::remove_file(path.c_str())
@@ -277,6 +344,10 @@ segment::do_truncate(model::offset prev_last_offset, size_t physical) {
           [this] { return remove_compacted_index(_reader.filename()); });
     }
 
+    // any previously checkpointed clean prefix may now be invalid
+    _clean_ckpt_pos = 0;
+    f = f.then([this] { return remove_clean_checkpoint(_reader.filename()); });
+
     f = f.then(
       [this, prev_last_offset] { return _idx.truncate(prev_last_offset); });
 
@@ -427,15 +498,18 @@ ss::future<append_result> segment::append(model::record_batch&& b) {
     });
 }
 
-ss::input_stream<char>
-segment::offset_data_stream(model::offset o, ss::io_priority_class iopc) {
+ss::input_stream<char> segment::offset_data_stream(
+  model::offset o,
+  ss::io_priority_class iopc,
+  size_t readahead_count,
+  size_t max_buffer_size) {
     check_segment_not_closed("offset_data_stream()");
     auto nearest = _idx.find_nearest(o);
     size_t position = 0;
     if (nearest) {
         position = nearest->filepos;
     }
-    return _reader.data_stream(position, iopc);
+    return _reader.data_stream(position, iopc, readahead_count, max_buffer_size);
 }
 
 void segment::advance_stable_offset(size_t offset) {
@@ -602,6 +676,8 @@ ss::future<ss::lw_shared_ptr<segment>> make_segment(
   ss::io_priority_class pc,
   record_version_type version,
   size_t buf_size,
+  size_t falloc_step,
+  size_t appender_chunks,
   debug_sanitize_files sanitize_fileops,
   std::optional<batch_cache_index> batch_cache) {
     auto path = segment_path::make_segment_path(
@@ -609,17 +685,19 @@ ss::future<ss::lw_shared_ptr<segment>> make_segment(
     vlog(stlog.info, "Creating new segment {}", path.string());
     return open_segment(
              path, sanitize_fileops, std::move(batch_cache), buf_size)
-      .then([path, &ntpc, sanitize_fileops, pc](
+      .then([path, &ntpc, sanitize_fileops, pc, falloc_step, appender_chunks](
               ss::lw_shared_ptr<segment> seg) {
           return with_segment(
             std::move(seg),
-            [path, &ntpc, sanitize_fileops, pc](
+            [path, &ntpc, sanitize_fileops, pc, falloc_step, appender_chunks](
               const ss::lw_shared_ptr<segment>& seg) {
                 return internal::make_segment_appender(
                          path,
                          sanitize_fileops,
-                         internal::number_of_chunks_from_config(ntpc),
-                         pc)
+                         internal::number_of_chunks_from_config(
+                           ntpc, appender_chunks),
+                         pc,
+                         falloc_step)
                   .then([seg](segment_appender_ptr a) {
                       return ss::make_ready_future<ss::lw_shared_ptr<segment>>(
                         ss::make_lw_shared<segment>(
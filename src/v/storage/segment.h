@@ -24,6 +24,7 @@
 #include <seastar/core/rwlock.hh>
 
 #include <exception>
+#include <limits>
 #include <optional>
 
 namespace storage {
@@ -92,8 +93,11 @@ public:
     ss::future<bool> materialize_index();
 
     /// main read interface
-    ss::input_stream<char>
-      offset_data_stream(model::offset, ss::io_priority_class);
+    ss::input_stream<char> offset_data_stream(
+      model::offset,
+      ss::io_priority_class,
+      size_t readahead_count = log_reader_config::default_readahead_count,
+      size_t max_buffer_size = std::numeric_limits<size_t>::max());
 
     const offset_tracker& offsets() const { return _tracker; }
     bool empty() const;
@@ -133,6 +137,8 @@ public:
       size_t max_bytes,
       bool skip_lru_promote);
     void cache_put(const model::record_batch& batch);
+    // zero-copy variant; the cache shares the batch's iobuf fragments
+    void cache_put(model::record_batch&& batch);
 
     ss::future<ss::rwlock::holder> read_lock(
       ss::semaphore::time_point timeout = ss::semaphore::time_point::max());
@@ -156,6 +162,7 @@ private:
     ss::future<> remove_tombstones();
     ss::future<> compaction_index_batch(const model::record_batch&);
     ss::future<> do_compaction_index_batch(const model::record_batch&);
+    ss::future<> maybe_persist_clean_checkpoint(model::offset, size_t fsize);
 
     struct appender_callbacks : segment_appender::callbacks {
         explicit appender_callbacks(segment* segment)
@@ -181,6 +188,8 @@ private:
     std::optional<batch_cache_index> _cache;
     ss::rwlock _destructive_ops;
     ss::gate _gate;
+    // file position covered by the last persisted clean checkpoint
+    size_t _clean_ckpt_pos{0};
 
     absl::btree_map<size_t, model::offset> _inflight;
 
@@ -215,6 +224,8 @@ ss::future<ss::lw_shared_ptr<segment>> make_segment(
   ss::io_priority_class pc,
   record_version_type version,
   size_t buf_size,
+  size_t falloc_step,
+  size_t appender_chunks,
   debug_sanitize_files sanitize_fileops,
   std::optional<batch_cache_index> batch_cache);
 
@@ -304,6 +315,11 @@ inline void segment::cache_put(const model::record_batch& batch) {
         _cache->put(batch);
     }
 }
+inline void segment::cache_put(model::record_batch&& batch) {
+    if (likely(bool(_cache))) {
+        _cache->put(std::move(batch));
+    }
+}
 inline ss::future<ss::rwlock::holder>
 segment::read_lock(ss::semaphore::time_point timeout) {
     return _destructive_ops.hold_read_lock(timeout);
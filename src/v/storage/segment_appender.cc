@@ -23,6 +23,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 namespace storage {
 
 [[gnu::cold]] static ss::future<>
@@ -31,10 +33,22 @@ size_missmatch_error(const char* ctx, size_t expected, size_t got) {
       "{}. Size missmatch. Expected:{}, Got:{}", ctx, expected, got));
 }
 
+/*
+ * bounds and target for the adaptive write-behind window. the target is a
+ * per-write completion latency a healthy NVMe device sustains at full queue
+ * depth; spinning disks will simply converge on the minimum window.
+ */
+static constexpr size_t min_inflight_window = 1;
+static constexpr size_t max_inflight_window = 64;
+static constexpr std::chrono::microseconds write_latency_target{2000};
+
 segment_appender::segment_appender(ss::file f, options opts)
   : _out(std::move(f))
   , _opts(opts)
   , _concurrent_flushes(ss::semaphore::max_counter())
+  , _inflight_window(
+      std::clamp(opts.number_of_chunks, min_inflight_window, max_inflight_window))
+  , _inflight_sem(_inflight_window)
   , _inactive_timer([this] { handle_inactive_timer(); }) {
     const auto alignment = _out.disk_write_dma_alignment();
     vassert(
@@ -66,6 +80,11 @@ segment_appender::segment_appender(segment_appender&& o) noexcept
   , _head(std::move(o._head))
   , _inflight(std::move(o._inflight))
   , _callbacks(std::exchange(o._callbacks, nullptr))
+  , _coalesce(std::move(o._coalesce))
+  , _coalesce_bytes(std::exchange(o._coalesce_bytes, 0))
+  , _inflight_window(o._inflight_window)
+  , _inflight_sem(std::move(o._inflight_sem))
+  , _write_latency_ewma(o._write_latency_ewma)
   , _inactive_timer([this] { handle_inactive_timer(); })
   , _previously_inactive(o._previously_inactive) {
     o._closed = true;
@@ -174,6 +193,8 @@ void segment_appender::handle_inactive_timer() {
          */
         dispatch_background_head_write();
     }
+    // an inactive appender should not sit on a staged write batch
+    dispatch_coalesced_writes();
 
     /*
      * inactive segment chunk reclaim
@@ -291,7 +312,19 @@ ss::future<> segment_appender::close() {
       .then([this] { return _out.close(); });
 }
 
+ss::future<> segment_appender::prefallocate() {
+    if (_closed || _fallocation_offset > next_committed_offset()) {
+        // closed, or space is already reserved
+        return ss::now();
+    }
+    // an append racing us would at worst reserve one extra step, which is
+    // exactly what it would have reserved on its own a few batches later
+    return do_next_adaptive_fallocation();
+}
+
 ss::future<> segment_appender::do_next_adaptive_fallocation() {
+    // submit any staged writes before waiting for quiescence below
+    dispatch_coalesced_writes();
     return ss::with_semaphore(
              _concurrent_flushes,
              ss::semaphore::max_counter(),
@@ -383,25 +416,90 @@ void segment_appender::dispatch_background_head_write() {
     _inflight.emplace_back(
       ss::make_lw_shared<inflight_write>(_committed_offset));
     auto w = _inflight.back();
+
+    /*
+     * stage the chunk write. a batch is cut eagerly when this chunk is not
+     * contiguous with the staged range or when the batch would exceed the
+     * vectored write ceiling; otherwise submission is deferred to the next
+     * flush/timer/fallocation trigger so adjacent chunks merge into a
+     * single I/O.
+     */
+    const bool contiguous
+      = _coalesce.empty()
+        || _coalesce.back().offset + _coalesce.back().expected == start_offset;
+    if (
+      !contiguous
+      || (!_coalesce.empty() && _coalesce_bytes + expected > max_coalesced_write)) {
+        dispatch_coalesced_writes();
+    }
+    _coalesce.push_back(staged_chunk_write{
+      .chk = h, .write = w, .offset = start_offset, .expected = expected, .src = src});
+    _coalesce_bytes += expected;
+    if (_coalesce_bytes >= max_coalesced_write) {
+        dispatch_coalesced_writes();
+    }
+}
+
+void segment_appender::dispatch_coalesced_writes() {
+    if (_coalesce.empty()) {
+        return;
+    }
+    auto batch = std::exchange(_coalesce, {});
+    _coalesce_bytes = 0;
+    const size_t start_offset = batch.front().offset;
+    size_t expected = 0;
+    std::vector<iovec> iov;
+    iov.reserve(batch.size());
+    for (auto& p : batch) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        iov.push_back(iovec{const_cast<char*>(p.src), p.expected});
+        expected += p.expected;
+    }
     (void)ss::with_semaphore(
       _concurrent_flushes,
       1,
-      [h, w, this, start_offset, expected, src] {
-          return _out.dma_write(start_offset, src, expected, _opts.priority)
-            .then([this, h, w, expected](size_t got) {
-                if (h->is_full()) {
-                    h->reset();
-                }
-                if (h->is_empty()) {
-                    internal::chunks().add(h);
-                } else {
-                    _head = h;
-                }
-                if (unlikely(expected != got)) {
-                    return size_missmatch_error("chunk::write", expected, got);
-                }
-                maybe_advance_stable_offset(w);
-                return ss::make_ready_future<>();
+      [this,
+       batch = std::move(batch),
+       iov = std::move(iov),
+       start_offset,
+       expected]() mutable {
+          // _inflight_sem bounds the write-behind window; waiting here
+          // back-pressures dispatch when the device falls behind.
+          return ss::with_semaphore(
+            _inflight_sem,
+            1,
+            [this,
+             batch = std::move(batch),
+             iov = std::move(iov),
+             start_offset,
+             expected]() mutable {
+                auto submitted = std::chrono::steady_clock::now();
+                return _out.dma_write(start_offset, std::move(iov), _opts.priority)
+                  .then([this, batch = std::move(batch), expected, submitted](
+                          size_t got) {
+                      adjust_inflight_window(
+                        std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - submitted));
+                      for (auto& p : batch) {
+                          auto h = p.chk;
+                          if (h->is_full()) {
+                              h->reset();
+                          }
+                          if (h->is_empty()) {
+                              internal::chunks().add(h);
+                          } else {
+                              _head = h;
+                          }
+                      }
+                      if (unlikely(expected != got)) {
+                          return size_missmatch_error(
+                            "chunk::write", expected, got);
+                      }
+                      for (auto& p : batch) {
+                          maybe_advance_stable_offset(p.write);
+                      }
+                      return ss::make_ready_future<>();
+                  });
             });
       })
       .handle_exception([this](std::exception_ptr e) {
@@ -409,11 +507,39 @@ void segment_appender::dispatch_background_head_write() {
       });
 }
 
+void segment_appender::adjust_inflight_window(
+  std::chrono::microseconds write_latency) {
+    // EWMA with alpha = 1/8 to smooth out scheduler noise
+    if (_write_latency_ewma.count() == 0) {
+        _write_latency_ewma = write_latency;
+    } else {
+        _write_latency_ewma = (_write_latency_ewma * 7 + write_latency) / 8;
+    }
+    if (
+      _write_latency_ewma <= write_latency_target
+      && _inflight_window < max_inflight_window) {
+        // device keeps up; widen the window one chunk at a time
+        ++_inflight_window;
+        _inflight_sem.signal();
+    } else if (
+      _write_latency_ewma >= 2 * write_latency_target
+      && _inflight_window > min_inflight_window) {
+        // device is congested; halve the window. consume() may drive the
+        // semaphore negative which naturally drains in flight writes first.
+        const auto next = std::max(min_inflight_window, _inflight_window / 2);
+        _inflight_sem.consume(_inflight_window - next);
+        _inflight_window = next;
+        // restart the average so recovery is observed quickly
+        _write_latency_ewma = write_latency_target;
+    }
+}
+
 ss::future<> segment_appender::flush() {
     _inactive_timer.cancel();
     if (_head && _head->bytes_pending()) {
         dispatch_background_head_write();
     }
+    dispatch_coalesced_writes();
     return ss::with_semaphore(
              _concurrent_flushes,
              ss::semaphore::max_counter(),
@@ -426,6 +552,7 @@ ss::future<> segment_appender::flush() {
 std::ostream& operator<<(std::ostream& o, const segment_appender& a) {
     // NOTE: intrusivelist.size() == O(N) but often N is very small, ~8
     return o << "{no_of_chunks:" << a._opts.number_of_chunks
+             << ", inflight_window:" << a._inflight_window
              << ", closed:" << a._closed
              << ", fallocation_offset:" << a._fallocation_offset
              << ", committed_offset:" << a._committed_offset
@@ -23,7 +23,9 @@
 #include <seastar/core/iostream.hh>
 #include <seastar/core/sstring.hh>
 
+#include <chrono>
 #include <iostream>
+#include <vector>
 
 namespace storage {
 
@@ -40,6 +42,11 @@ public:
                                                      / chunk::chunk_size;
     static constexpr const size_t chunk_size = chunk::chunk_size;
     static constexpr const size_t fallocation_step = 32_MiB;
+    /// bounds for the append-rate driven step chosen at segment roll
+    static constexpr const size_t min_fallocation_step = 4_MiB;
+    static constexpr const size_t max_fallocation_step = 1_GiB;
+    /// ceiling for a single vectored dma_write of coalesced dirty chunks
+    static constexpr const size_t max_coalesced_write = 1_MiB;
 
     struct options {
         options(ss::io_priority_class p, size_t chunks_no)
@@ -74,12 +81,21 @@ public:
     ss::future<> close();
     ss::future<> flush();
 
+    /// eagerly reserve the first fallocation step for a fresh segment so
+    /// the initial append does not stall on file metadata I/O. safe to
+    /// run in the background concurrently with appends.
+    ss::future<> prefallocate();
+
     struct callbacks {
         virtual void committed_physical_offset(size_t) = 0;
     };
 
     void set_callbacks(callbacks* callbacks) { _callbacks = callbacks; }
 
+    /// current number of writes the appender is willing to keep in flight.
+    /// adjusted dynamically from observed dma_write completion latency.
+    size_t inflight_window() const { return _inflight_window; }
+
 private:
     void dispatch_background_head_write();
     ss::future<> do_next_adaptive_fallocation();
@@ -123,6 +139,36 @@ private:
     callbacks* _callbacks = nullptr;
     void maybe_advance_stable_offset(const ss::lw_shared_ptr<inflight_write>&);
 
+    /*
+     * filled chunks whose file ranges are contiguous are staged here and
+     * submitted as one vectored dma_write of up to max_coalesced_write
+     * bytes, instead of one submission per 16KiB chunk. the batch is cut
+     * on a range gap, on reaching the byte ceiling, and from flush(), the
+     * inactive timer and fallocation.
+     */
+    struct staged_chunk_write {
+        ss::lw_shared_ptr<chunk> chk;
+        ss::lw_shared_ptr<inflight_write> write;
+        size_t offset; // dma aligned start of the write
+        size_t expected;
+        const char* src;
+    };
+    void dispatch_coalesced_writes();
+    std::vector<staged_chunk_write> _coalesce;
+    size_t _coalesce_bytes{0};
+
+    /*
+     * write-behind window feedback loop. every dma_write completion feeds
+     * its latency into an EWMA; a fast device widens the window (additive
+     * increase) and a congested device halves it (multiplicative decrease),
+     * so the number of in flight writes tracks device capability instead of
+     * the static options::number_of_chunks.
+     */
+    void adjust_inflight_window(std::chrono::microseconds write_latency);
+    size_t _inflight_window;
+    ss::semaphore _inflight_sem;
+    std::chrono::microseconds _write_latency_ewma{0};
+
     ss::timer<ss::lowres_clock> _inactive_timer;
     void handle_inactive_timer();
     bool _previously_inactive = false;
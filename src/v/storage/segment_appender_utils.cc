@@ -11,55 +11,66 @@
 
 #include "model/record.h"
 #include "model/timestamp.h"
-#include "reflection/adl.h"
 #include "storage/logger.h"
-#include "utils/vint.h"
 #include "vassert.h"
 
 #include <seastar/core/byteorder.hh>
+#include <seastar/core/do_with.hh>
 #include <seastar/core/future-util.hh>
 
-#include <bits/stdint-uintn.h>
+#include <cstring>
 
-#include <memory>
-#include <type_traits>
 namespace storage {
 
-static iobuf disk_header_to_iobuf(const model::record_batch_header& h) {
+namespace {
+template<typename T>
+char* encode_le(char* p, T v) {
+    auto le = ss::cpu_to_le(v);
+    std::memcpy(p, &le, sizeof(le));
+    return p + sizeof(le); // NOLINT
+}
+} // namespace
+
+std::array<char, model::packed_record_batch_header_size>
+encode_disk_header(const model::record_batch_header& h) {
 #ifndef NDEBUG
     vassert(h.header_crc != 0, "Header cannot have an unset crc:{}", h);
 #endif
-    iobuf b;
-    reflection::serialize(
-      b,
-      h.header_crc,
-      h.size_bytes,
-      h.base_offset(),
-      h.type(),
-      h.crc,
-      h.attrs.value(),
-      h.last_offset_delta,
-      h.first_timestamp.value(),
-      h.max_timestamp.value(),
-      h.producer_id,
-      h.producer_epoch,
-      h.base_sequence,
-      h.record_count);
+    std::array<char, model::packed_record_batch_header_size> b; // NOLINT
+    char* p = b.data();
+    p = encode_le(p, h.header_crc);
+    p = encode_le(p, h.size_bytes);
+    p = encode_le(p, h.base_offset());
+    p = encode_le(p, h.type());
+    p = encode_le(p, h.crc);
+    p = encode_le(p, h.attrs.value());
+    p = encode_le(p, h.last_offset_delta);
+    p = encode_le(p, h.first_timestamp.value());
+    p = encode_le(p, h.max_timestamp.value());
+    p = encode_le(p, h.producer_id);
+    p = encode_le(p, h.producer_epoch);
+    p = encode_le(p, h.base_sequence);
+    p = encode_le(p, h.record_count);
     vassert(
-      b.size_bytes() == model::packed_record_batch_header_size,
+      p == b.data() + b.size(),
       "disk headers must be of static size:{}, but got{}",
       model::packed_record_batch_header_size,
-      b.size_bytes());
+      p - b.data());
     return b;
 }
 
 ss::future<>
 write(segment_appender& appender, const model::record_batch& batch) {
-    auto hdrbuf = std::make_unique<iobuf>(disk_header_to_iobuf(batch.header()));
-    auto ptr = hdrbuf.get();
-    return appender.append(*ptr).then(
-      [&appender, &batch, cpy = std::move(hdrbuf)] {
-          return appender.append(batch.data());
+    // the encoded header lives in the do_with state instead of a
+    // standalone heap iobuf; the appender copies it straight into its
+    // active chunk.
+    return ss::do_with(
+      encode_disk_header(batch.header()),
+      [&appender, &batch](
+        const std::array<char, model::packed_record_batch_header_size>& hdr) {
+          return appender.append(hdr.data(), hdr.size())
+            .then(
+              [&appender, &batch] { return appender.append(batch.data()); });
       });
 }
 
@@ -14,8 +14,20 @@
 #include "model/record.h"
 #include "storage/segment_appender.h"
 
+#include <array>
+
 namespace storage {
 
+/**
+ * Fixed-layout encoding of a record batch header as it appears on disk:
+ * the adl little-endian serialization of each field in declaration
+ * order. Encoding into a flat array instead of an iobuf avoids a
+ * fragment allocation and a staging copy on every appended batch; the
+ * appender copies the bytes straight into its active chunk.
+ */
+std::array<char, model::packed_record_batch_header_size>
+encode_disk_header(const model::record_batch_header& h);
+
 ss::future<>
 write(segment_appender& appender, const model::record_batch& batch);
 
@@ -47,11 +47,15 @@ void segment_index::reset() {
     _state = {};
     _state.base_offset = base;
     _acc = 0;
+    _tail.clear();
+    _hydrated = true;
 }
 
 void segment_index::swap_index_state(index_state&& o) {
     _needs_persistence = true;
     _acc = 0;
+    _tail.clear();
+    _hydrated = true;
     std::swap(_state, o);
 }
 
@@ -68,35 +72,99 @@ void segment_index::maybe_track(
           hdr.max_timestamp)) {
         _acc = 0;
     }
+    // remember every recent batch, not just the ones that crossed _step
+    if (_tail.size() == max_tail_entries) {
+        _tail.pop_front();
+    }
+    _tail.push_back(entry{
+      .offset = hdr.base_offset,
+      .timestamp = hdr.max_timestamp,
+      .filepos = filepos,
+    });
     _needs_persistence = true;
 }
 
+std::optional<segment_index::entry>
+segment_index::find_tail_entry(model::offset o) const {
+    for (auto it = _tail.rbegin(); it != _tail.rend(); ++it) {
+        if (it->offset <= o) {
+            return *it;
+        }
+    }
+    return std::nullopt;
+}
+
+/*
+ * entries record a sampled batch's last timestamp. assuming timestamps do
+ * not go backwards across batches, the greatest entry with a recorded
+ * timestamp strictly below the needle is a safe place to start reading: no
+ * batch at or before that file position can contain the answer. the time
+ * column is close to linear in entry position - entries are cut every
+ * `step` bytes at steady throughput and every
+ * index_state::max_time_between_entries_ms otherwise - so an interpolation
+ * probe lands within a few entries of the target instead of touching
+ * log2(n) compressed frames like a binary search would.
+ */
 std::optional<segment_index::entry>
 segment_index::find_nearest(model::timestamp t) {
+    if (unlikely(!_hydrated)) {
+        // a miss only degrades the first read into a scan from the segment
+        // start; kick off hydration so the next lookup is indexed
+        request_background_hydration();
+        return std::nullopt;
+    }
     if (t < _state.base_timestamp) {
         return std::nullopt;
     }
     if (_state.empty()) {
         return std::nullopt;
     }
-    const uint32_t i = t() - _state.base_timestamp();
-    auto it = std::lower_bound(
-      std::begin(_state.relative_time_index),
-      std::end(_state.relative_time_index),
-      i,
-      std::less<uint32_t>{});
-    if (it == _state.relative_offset_index.end()) {
-        return std::nullopt;
+    const uint32_t needle = t() - _state.base_timestamp();
+    const auto& col = _state.relative_time_index;
+    // interpolation search for the first entry with time >= needle; the
+    // answer index stays in [lo, hi]
+    size_t lo = 0;
+    size_t hi = col.size();
+    while (lo < hi) {
+        const uint32_t lo_v = col[lo];
+        if (lo_v >= needle) {
+            break;
+        }
+        const uint32_t hi_v = col[hi - 1];
+        if (hi_v < needle) {
+            lo = hi;
+            break;
+        }
+        // lo_v < needle <= hi_v, so hi_v > lo_v and the probe is in range
+        const auto probe
+          = lo
+            + size_t(uint64_t(needle - lo_v) * (hi - 1 - lo) / (hi_v - lo_v));
+        if (col[probe] < needle) {
+            lo = probe + 1;
+        } else {
+            hi = probe;
+        }
     }
-    auto dist = std::distance(_state.relative_offset_index.begin(), it);
-    return translate_index_entry(_state, _state.get_entry(dist));
+    // step back one entry for the safe scan start. the first entry always
+    // tracks the segment's first batch, so entry 0 covers needles below
+    // every recorded time
+    const size_t i = lo == 0 ? 0 : lo - 1;
+    return translate_index_entry(_state, _state.get_entry(i));
 }
 
 std::optional<segment_index::entry>
 segment_index::find_nearest(model::offset o) {
+    if (unlikely(!_hydrated)) {
+        request_background_hydration();
+        return std::nullopt;
+    }
     if (o < _state.base_offset || _state.empty()) {
         return std::nullopt;
     }
+    // the in-memory tail is batch granular; when the needle falls inside
+    // it (truncation after a leadership change, tail reads) it beats the
+    // persisted entries by up to _step bytes of scanning
+    auto best = find_tail_entry(o);
     const uint32_t needle = o() - _state.base_offset();
     auto it = std::lower_bound(
       std::begin(_state.relative_offset_index),
@@ -110,17 +178,28 @@ segment_index::find_nearest(model::offset o) {
     int i = std::distance(_state.relative_offset_index.begin(), it);
     do {
         if (_state.relative_offset_index[i] <= needle) {
-            return translate_index_entry(_state, _state.get_entry(i));
+            auto e = translate_index_entry(_state, _state.get_entry(i));
+            if (!best || e.filepos > best->filepos) {
+                best = e;
+            }
+            break;
         }
     } while (i-- > 0);
 
-    return std::nullopt;
+    return best;
 }
 
 ss::future<> segment_index::truncate(model::offset o) {
+    if (unlikely(!_hydrated)) {
+        // truncation mutates the entry columns; they must be resident
+        return hydrate().then([this, o] { return truncate(o); });
+    }
     if (o < _state.base_offset) {
         return ss::now();
     }
+    while (!_tail.empty() && _tail.back().offset >= o) {
+        _tail.pop_back();
+    }
     const uint32_t i = o() - _state.base_offset();
     auto it = std::lower_bound(
       std::begin(_state.relative_offset_index),
@@ -147,26 +226,86 @@ ss::future<> segment_index::truncate(model::offset o) {
     return flush();
 }
 
+// version + size + checksum + bitflags + offsets/timestamps; see
+// index_state.h for the file layout
+static constexpr size_t index_header_prefix_size
+  = sizeof(int8_t) + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t)
+    + (2 * sizeof(int64_t)) + (2 * sizeof(int64_t));
+
 ss::future<bool> segment_index::materialize_index() {
     return _out.size()
       .then([this](uint64_t size) mutable {
-          return _out.dma_read_bulk<char>(0, size);
+          return _out
+            .dma_read_bulk<char>(
+              0, std::min<uint64_t>(size, index_header_prefix_size))
+            .then([size](ss::temporary_buffer<char> buf) {
+                return std::make_pair(size, std::move(buf));
+            });
       })
-      .then([this](ss::temporary_buffer<char> buf) {
+      .then([this](std::pair<uint64_t, ss::temporary_buffer<char>> p) {
+          auto& [file_size, buf] = p;
           if (buf.empty()) {
               return false;
           }
           iobuf b;
           b.append(std::move(buf));
-          auto hydrated = index_state::hydrate_from_buffer(std::move(b));
+          auto hydrated = index_state::hydrate_header_from_buffer(
+            std::move(b), file_size);
           if (!hydrated) {
               return false;
           }
           _state = std::move(hydrated.value());
+          // the entry columns stay on disk until the first lookup
+          _hydrated = false;
           return true;
       });
 }
 
+ss::future<> segment_index::hydrate() {
+    if (_hydrated) {
+        return ss::now();
+    }
+    if (!_hydration) {
+        _hydration.emplace(do_hydrate());
+    }
+    return _hydration->get_future();
+}
+
+ss::future<> segment_index::do_hydrate() {
+    return _out.size()
+      .then([this](uint64_t size) mutable {
+          return _out.dma_read_bulk<char>(0, size);
+      })
+      .then([this](ss::temporary_buffer<char> buf) {
+          if (_hydrated) {
+              // reset()/swap_index_state() superseded this pass
+              return;
+          }
+          iobuf b;
+          b.append(std::move(buf));
+          auto hydrated = index_state::hydrate_from_buffer(std::move(b));
+          if (hydrated) {
+              _state = std::move(hydrated.value());
+          } else {
+              // reads against this segment fall back to sequential scans
+              // from the segment start; do not retry on every lookup
+              vlog(
+                stlog.info,
+                "Lazy hydration of index {} failed, serving reads without "
+                "index entries",
+                _name);
+          }
+          _hydrated = true;
+      });
+}
+
+void segment_index::request_background_hydration() {
+    (void)hydrate().handle_exception([this](std::exception_ptr e) {
+        vlog(
+          stlog.warn, "Background hydration of index {} failed: {}", _name, e);
+    });
+}
+
 ss::future<> segment_index::drop_all_data() {
     reset();
     return _out.truncate(0);
@@ -197,12 +336,19 @@ ss::future<> segment_index::flush() {
       });
 }
 ss::future<> segment_index::close() {
-    return flush().then([this] { return _out.close(); });
+    // wait out any in-flight lazy hydration before closing the handle
+    auto f = _hydration ? _hydration->get_future().handle_exception(
+               [](const std::exception_ptr&) {})
+                        : ss::now();
+    return f.then([this] { return flush(); }).then([this] {
+        return _out.close();
+    });
 }
 std::ostream& operator<<(std::ostream& o, const segment_index& i) {
     return o << "{file:" << i.filename() << ", offsets:" << i.base_offset()
              << ", index:" << i._state << ", step:" << i._step
-             << ", needs_persistence:" << i._needs_persistence << "}";
+             << ", needs_persistence:" << i._needs_persistence
+             << ", hydrated:" << i._hydrated << "}";
 }
 std::ostream& operator<<(std::ostream& o, const segment_index_ptr& i) {
     if (i) {
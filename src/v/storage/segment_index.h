@@ -15,7 +15,9 @@
 #include "model/timestamp.h"
 #include "storage/index_state.h"
 
+#include <seastar/core/circular_buffer.hh>
 #include <seastar/core/file.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/unaligned.hh>
 
 #include <memory>
@@ -48,6 +50,10 @@ public:
     // 32KB - a well known number as a sweet spot for fetching data from disk
     static constexpr size_t default_data_buffer_step = 4096 * 8;
 
+    // batch-granular entries kept in memory for the newest appends; see
+    // _tail below
+    static constexpr size_t max_tail_entries = 128;
+
     segment_index(
       ss::sstring filename, ss::file, model::offset base, size_t step);
     ~segment_index() noexcept = default;
@@ -66,7 +72,16 @@ public:
     model::timestamp base_timestamp() const { return _state.base_timestamp; }
     const ss::sstring& filename() const { return _name; }
 
+    /*
+     * decodes only the fixed-layout header of the index file, so log open
+     * does not touch the entry payload. entries are hydrated on first
+     * lookup; see hydrate().
+     */
     ss::future<bool> materialize_index();
+    /// load and verify the entry columns if only the header was
+    /// materialized. concurrent callers share one hydration pass.
+    ss::future<> hydrate();
+    bool hydrated() const { return _hydrated; }
     ss::future<> close();
     ss::future<> flush();
     ss::future<> truncate(model::offset);
@@ -84,11 +99,26 @@ public:
     index_state release_index_state() && { return std::move(_state); }
 
 private:
+    ss::future<> do_hydrate();
+    void request_background_hydration();
+    std::optional<entry> find_tail_entry(model::offset) const;
+
     ss::sstring _name;
     ss::file _out;
     size_t _step;
     size_t _acc{0};
+    /*
+     * memory-only entries for the last max_tail_entries appended batches,
+     * tracked at batch granularity regardless of _step. truncation after
+     * a leadership change lands near the tail, and these turn the scan
+     * from the nearest persisted entry (up to _step bytes behind) into a
+     * scan from the exact batch. never persisted; rebuilt by appends
+     */
+    ss::circular_buffer<entry> _tail;
     bool _needs_persistence{false};
+    // false while the entry columns still live only on disk
+    bool _hydrated{true};
+    std::optional<ss::shared_future<>> _hydration;
     index_state _state;
 
     friend std::ostream& operator<<(std::ostream&, const segment_index&);
@@ -17,6 +17,8 @@
 #include <seastar/core/reactor.hh>
 #include <seastar/core/sstring.hh>
 
+#include <algorithm>
+
 namespace storage {
 
 segment_reader::segment_reader(
@@ -29,17 +31,25 @@ segment_reader::segment_reader(
   , _file_size(file_size)
   , _buffer_size(buffer_size) {}
 
-ss::input_stream<char>
-segment_reader::data_stream(size_t pos, const ss::io_priority_class& pc) {
+// floor for budget-clamped stream buffers: one dma-aligned page is
+// always enough to peek the next batch header
+static constexpr size_t min_stream_buffer_size = 4096;
+
+ss::input_stream<char> segment_reader::data_stream(
+  size_t pos,
+  const ss::io_priority_class& pc,
+  size_t readahead_count,
+  size_t max_buffer_size) {
     vassert(
       pos <= _file_size,
       "cannot read negative bytes. Asked to read at position: '{}' - {}",
       pos,
       *this);
     ss::file_input_stream_options options;
-    options.buffer_size = _buffer_size;
+    options.buffer_size = std::min(
+      std::max(max_buffer_size, min_stream_buffer_size), _buffer_size);
     options.io_priority_class = pc;
-    options.read_ahead = 4; // FIXME: scylla uses 10
+    options.read_ahead = static_cast<uint32_t>(readahead_count);
     options.dynamic_adjustments = _history;
     return make_file_input_stream(
       _data_file, pos, _file_size - pos, std::move(options));
@@ -20,6 +20,7 @@
 #include <seastar/core/iostream.hh>
 #include <seastar/util/log.hh>
 
+#include <limits>
 #include <optional>
 #include <type_traits>
 #include <vector>
@@ -61,9 +62,16 @@ public:
     ss::future<> flush() { return _data_file.flush(); }
 
     /// create an input stream _sharing_ the underlying file handle
-    /// starting at position @pos
-    ss::input_stream<char>
-    data_stream(size_t pos, const ss::io_priority_class&);
+    /// starting at position @pos. @readahead_count controls how many
+    /// stream buffers are prefetched while the caller consumes.
+    /// @max_buffer_size caps the size of each stream buffer so readers
+    /// with a small remaining byte budget issue proportionally small
+    /// disk reads instead of pulling a full window they will discard
+    ss::input_stream<char> data_stream(
+      size_t pos,
+      const ss::io_priority_class&,
+      size_t readahead_count = 4,
+      size_t max_buffer_size = std::numeric_limits<size_t>::max());
 
 private:
     ss::sstring _filename;
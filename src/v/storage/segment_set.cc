@@ -9,6 +9,7 @@
 
 #include "storage/segment_set.h"
 
+#include "storage/clean_checkpoint.h"
 #include "storage/fs_utils.h"
 #include "storage/log_replayer.h"
 #include "storage/logger.h"
@@ -42,6 +43,10 @@ struct segment_ordering {
 segment_set::segment_set(segment_set::underlying_t segs)
   : _handles(std::move(segs)) {
     std::sort(_handles.begin(), _handles.end(), segment_ordering{});
+    _base_offsets.reserve(_handles.size());
+    for (auto& s : _handles) {
+        _base_offsets.push_back(s->offsets().base_offset);
+    }
 }
 
 void segment_set::add(ss::lw_shared_ptr<segment> h) {
@@ -55,12 +60,23 @@ void segment_set::add(ss::lw_shared_ptr<segment> h) {
           *h,
           *this);
     }
+    _base_offsets.push_back(h->offsets().base_offset);
     _handles.emplace_back(std::move(h));
 }
 
-void segment_set::pop_back() { _handles.pop_back(); }
-void segment_set::pop_front() { _handles.pop_front(); }
+void segment_set::pop_back() {
+    _handles.pop_back();
+    _base_offsets.pop_back();
+}
+void segment_set::pop_front() {
+    _handles.pop_front();
+    _base_offsets.erase(_base_offsets.begin());
+}
 void segment_set::erase(iterator begin, iterator end) {
+    auto first = std::distance(_handles.begin(), begin);
+    auto last = std::distance(_handles.begin(), end);
+    _base_offsets.erase(
+      _base_offsets.begin() + first, _base_offsets.begin() + last);
     _handles.erase(begin, end);
 }
 
@@ -107,19 +123,48 @@ Iterator segments_lower_bound(Iterator begin, Iterator end, Needle needle) {
     return end;
 }
 
-/// lower_bound returns the element that is _strictly_ greater than or equal
-/// to bucket->dirty_offset() - see comparator above because our offsets are
-/// _inclusive_ we must check the previous iterator in the case that we are at
-/// the end, we also check the last element.
+static bool needle_in_segment(const segment_set::type& s, model::offset o) {
+    return !s->empty() && o >= s->offsets().base_offset
+           && o <= s->offsets().dirty_offset;
+}
+
+/// index of the segment containing the offset, or size() when no segment
+/// covers it. the common case - a lookup at the tail for an append or a
+/// follower fetch - is answered by the active segment check without any
+/// search; everything else binary searches the flat base offset array so
+/// each probe stays within a couple of cache lines
+size_t segment_set::lower_bound_idx(model::offset o) const {
+    if (_handles.empty()) {
+        return _handles.size();
+    }
+    if (needle_in_segment(_handles.back(), o)) {
+        return _handles.size() - 1;
+    }
+    auto it = std::upper_bound(_base_offsets.begin(), _base_offsets.end(), o);
+    if (it == _base_offsets.begin()) {
+        // precedes the first segment
+        return _handles.size();
+    }
+    auto idx = static_cast<size_t>(
+      std::distance(_base_offsets.begin(), std::prev(it)));
+    if (needle_in_segment(_handles[idx], o)) {
+        return idx;
+    }
+    // the last segment with base_offset <= o may be empty; the match, if
+    // any, can only be its predecessor
+    if (idx > 0 && needle_in_segment(_handles[idx - 1], o)) {
+        return idx - 1;
+    }
+    return _handles.size();
+}
+
 segment_set::iterator segment_set::lower_bound(model::offset offset) {
-    return segments_lower_bound(
-      std::begin(_handles), std::end(_handles), offset);
+    return std::begin(_handles) + lower_bound_idx(offset);
 }
 
 segment_set::const_iterator
 segment_set::lower_bound(model::offset offset) const {
-    return segments_lower_bound(
-      std::cbegin(_handles), std::cend(_handles), offset);
+    return std::cbegin(_handles) + lower_bound_idx(offset);
 }
 // Lower bound for timestamp based indexing
 //
@@ -218,6 +263,44 @@ unsafe_do_recover(segment_set&& segments, ss::abort_source& as) {
             if (unlikely(as.abort_requested())) {
                 return segment_set(std::move(good));
             }
+            /*
+             * fast path: a clean checkpoint matching the exact file size
+             * proves the segment was fully flushed before shutdown, so
+             * verifying it needs one small read instead of replaying the
+             * whole file through the parser. any mismatch (crash
+             * mid-append, truncation) falls through to a full replay.
+             */
+            auto ckpt = read_clean_checkpoint(s->reader().filename()).get0();
+            if (ckpt) {
+                auto stat = s->reader().stat().get0();
+                if (
+                  static_cast<uint64_t>(stat.st_size) == ckpt->file_pos
+                  && s->materialize_index().get0()) {
+                    /*
+                     * the index seeds the offset tracker, so a stale one
+                     * (checkpointed after appends the index flush missed)
+                     * would hide committed batches and hand out duplicate
+                     * offsets. only trust it when it agrees with the
+                     * checkpoint; otherwise replay rebuilds it.
+                     */
+                    if (s->index().max_offset() == ckpt->last_offset) {
+                        vlog(
+                          stlog.info,
+                          "Clean checkpoint {} matched, skipping replay of {}",
+                          *ckpt,
+                          s);
+                        good.emplace_back(std::move(s));
+                        continue;
+                    }
+                    vlog(
+                      stlog.info,
+                      "Clean checkpoint {} does not match index max offset "
+                      "{}, replaying {}",
+                      *ckpt,
+                      s->index().max_offset(),
+                      s);
+                }
+            }
             auto replayer = log_replayer(*s);
             auto recovered = replayer.recover_in_thread(
               ss::default_priority_class());
@@ -236,6 +319,13 @@ unsafe_do_recover(segment_set&& segments, ss::abort_source& as) {
               .get();
             // persist index
             s->index().flush().get();
+            // checkpoint the verified prefix for the next restart
+            write_clean_checkpoint(
+              s->reader().filename(),
+              clean_checkpoint{
+                .last_offset = recovered.last_offset.value(),
+                .file_pos = recovered.truncate_file_pos.value()})
+              .get();
             vlog(stlog.info, "Recovered: {}", s);
             good.emplace_back(std::move(s));
         }
@@ -335,14 +425,103 @@ static ss::future<segment_set::underlying_t> open_segments(
       });
 }
 
+/**
+ * \brief Open exactly the segments listed in a manifest.
+ *
+ * Returns std::nullopt when any listed file is missing, in which case the
+ * caller falls back to the directory walk. Existence of every file is
+ * verified before the first segment is opened so the fallback never has
+ * half-opened segments to clean up.
+ */
+static ss::future<std::optional<segment_set::underlying_t>>
+open_manifest_segments(
+  ss::sstring dir,
+  std::vector<ss::sstring> manifest,
+  debug_sanitize_files sanitize_fileops,
+  std::function<std::optional<batch_cache_index>()> cache_factory,
+  ss::abort_source& as) {
+    using segs_type = segment_set::underlying_t;
+    using ret_type = std::optional<segs_type>;
+    return ss::do_with(
+      std::move(manifest),
+      segs_type{},
+      true,
+      [&as, cache_factory, sanitize_fileops, dir = std::move(dir)](
+        std::vector<ss::sstring>& manifest, segs_type& segs, bool& complete) {
+          return ss::do_for_each(
+                   manifest,
+                   [dir, &complete](const ss::sstring& name) {
+                       return ss::file_exists(fmt::format("{}/{}", dir, name))
+                         .then(
+                           [&complete](bool exists) { complete &= exists; });
+                   })
+            .then([&as,
+                   cache_factory,
+                   sanitize_fileops,
+                   dir,
+                   &manifest,
+                   &segs,
+                   &complete] {
+                if (!complete) {
+                    return ss::make_ready_future<ret_type>(std::nullopt);
+                }
+                return ss::do_for_each(
+                         manifest,
+                         [&as, cache_factory, sanitize_fileops, dir, &segs](
+                           const ss::sstring& name) {
+                             if (as.abort_requested()) {
+                                 return ss::now();
+                             }
+                             auto path = std::filesystem::path(
+                               fmt::format("{}/{}", dir, name));
+                             return open_segment(
+                                      path, sanitize_fileops, cache_factory())
+                               .then([&segs](ss::lw_shared_ptr<segment> p) {
+                                   segs.push_back(std::move(p));
+                               });
+                         })
+                  .then([&segs] {
+                      return ss::make_ready_future<ret_type>(std::move(segs));
+                  });
+            });
+      });
+}
+
 ss::future<segment_set> recover_segments(
   std::filesystem::path path,
   debug_sanitize_files sanitize_fileops,
   bool is_compaction_enabled,
   std::function<std::optional<batch_cache_index>()> cache_factory,
-  ss::abort_source& as) {
+  ss::abort_source& as,
+  std::optional<std::vector<ss::sstring>> manifest) {
     return ss::recursive_touch_directory(path.string())
-      .then([&as, cache_factory, sanitize_fileops, path = std::move(path)] {
+      .then([&as,
+             cache_factory,
+             sanitize_fileops,
+             path = std::move(path),
+             manifest = std::move(manifest)]() mutable {
+          if (manifest) {
+              return open_manifest_segments(
+                       path.string(),
+                       std::move(*manifest),
+                       sanitize_fileops,
+                       cache_factory,
+                       as)
+                .then([&as, cache_factory, sanitize_fileops, path](
+                        std::optional<segment_set::underlying_t> segs) {
+                    if (segs) {
+                        return ss::make_ready_future<
+                          segment_set::underlying_t>(std::move(*segs));
+                    }
+                    vlog(
+                      stlog.info,
+                      "Stale segment manifest for {}, falling back to "
+                      "directory scan",
+                      path.string());
+                    return open_segments(
+                      path.string(), sanitize_fileops, cache_factory, as);
+                });
+          }
           return open_segments(
             path.string(), sanitize_fileops, cache_factory, as);
       })
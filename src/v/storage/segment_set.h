@@ -16,6 +16,7 @@
 #include <seastar/core/circular_buffer.hh>
 
 #include <deque>
+#include <vector>
 
 namespace storage {
 /*
@@ -82,17 +83,34 @@ public:
     const_iterator end() const { return _handles.end(); }
 
 private:
+    size_t lower_bound_idx(model::offset) const;
+
     underlying_t _handles;
+    // parallel to _handles: the immutable base offset of every segment.
+    // offset lookups run on every read and append, so the binary search
+    // probes this flat array instead of chasing a segment pointer per
+    // step; only the final containment check touches a segment. dirty
+    // offsets are mutable on the active segment and deliberately not
+    // mirrored here
+    std::vector<model::offset> _base_offsets;
 
     friend std::ostream& operator<<(std::ostream&, const segment_set&);
 };
 
+/**
+ * When a manifest (list of segment file names, maintained in the kvstore)
+ * is passed only the listed files are opened, skipping the directory walk
+ * entirely. A manifest naming a file that no longer exists is considered
+ * stale - e.g. a crash between a segment delete and the manifest update -
+ * and recovery falls back to walking the directory.
+ */
 ss::future<segment_set> recover_segments(
   std::filesystem::path path,
   debug_sanitize_files sanitize_fileops,
   bool is_compaction_enabled,
   std::function<std::optional<batch_cache_index>()> batch_cache_factory,
-  ss::abort_source& as);
+  ss::abort_source& as,
+  std::optional<std::vector<ss::sstring>> manifest = std::nullopt);
 
 std::ostream& operator<<(std::ostream&, const segment_set&);
 
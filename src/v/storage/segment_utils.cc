@@ -20,11 +20,13 @@
 #include "storage/compacted_index_writer.h"
 #include "storage/compaction_reducers.h"
 #include "storage/index_state.h"
+#include "storage/kvstore.h"
 #include "storage/lock_manager.h"
 #include "storage/log_reader.h"
 #include "storage/logger.h"
 #include "storage/parser_utils.h"
 #include "storage/segment.h"
+#include "storage/segment_set.h"
 #include "storage/types.h"
 #include "units.h"
 #include "utils/file_sanitizer.h"
@@ -128,16 +130,19 @@ ss::future<segment_appender_ptr> make_segment_appender(
   const std::filesystem::path& path,
   debug_sanitize_files debug,
   size_t number_of_chunks,
-  ss::io_priority_class iopc) {
+  ss::io_priority_class iopc,
+  size_t falloc_step) {
     return internal::make_writer_handle(path, debug)
-      .then([number_of_chunks, iopc, path](ss::file writer) {
+      .then([number_of_chunks, iopc, falloc_step, path](ss::file writer) {
           try {
               // NOTE: This try-catch is needed to not uncover the real
               // exception during an OOM condition, since the appender allocates
               // 1MB of memory aligned buffers
               return ss::make_ready_future<segment_appender_ptr>(
                 std::make_unique<segment_appender>(
-                  writer, segment_appender::options(iopc, number_of_chunks)));
+                  writer,
+                  segment_appender::options(
+                    iopc, number_of_chunks, falloc_step)));
           } catch (...) {
               auto e = std::current_exception();
               vlog(stlog.error, "could not allocate appender: {}", e);
@@ -148,15 +153,15 @@ ss::future<segment_appender_ptr> make_segment_appender(
       });
 }
 
-size_t number_of_chunks_from_config(const ntp_config& ntpc) {
+size_t number_of_chunks_from_config(const ntp_config& ntpc, size_t base_chunks) {
     if (!ntpc.has_overrides()) {
-        return segment_appender::chunks_no_buffer;
+        return base_chunks;
     }
     auto& o = ntpc.get_overrides();
     if (o.compaction_strategy) {
-        return segment_appender::chunks_no_buffer / 2;
+        return base_chunks / 2;
     }
-    return segment_appender::chunks_no_buffer;
+    return base_chunks;
 }
 
 ss::future<Roaring>
@@ -275,18 +280,78 @@ generate_compacted_list(model::offset o, compacted_index_reader reader) {
       .finally([reader] {});
 }
 
-ss::future<>
-do_compact_segment_index(ss::lw_shared_ptr<segment> s, compaction_config cfg) {
-    auto compacted_path = std::filesystem::path(s->reader().filename());
-    compacted_path.replace_extension(".compaction_index");
-    vlog(stlog.trace, "compacting index:{}", compacted_path);
-    return make_reader_handle(compacted_path, cfg.sanitize)
-      .then([cfg, compacted_path, s](ss::file f) {
-          auto reader = make_file_backed_compacted_reader(
-            compacted_path.string(), std::move(f), cfg.iopc, 64_KiB);
-          return write_clean_compacted_index(reader, cfg);
+/// writes the filtered entries of the raw index into a clean
+/// `.compacted_index` (staging file + rename) and *closes* the reader
+static ss::future<> write_clean_index_from_bitmap(
+  compacted_index_reader reader, Roaring bitmap, compaction_config cfg) {
+    const auto tmpname = std::filesystem::path(
+      fmt::format("{}.staging", reader.filename()));
+    return make_handle(
+             tmpname,
+             ss::open_flags::rw | ss::open_flags::truncate
+               | ss::open_flags::create,
+             writer_opts(),
+             cfg.sanitize)
+      .then([tmpname, cfg, reader, bm = std::move(bitmap)](ss::file f) mutable {
+          auto writer = make_file_backed_compacted_index(
+            tmpname.string(),
+            std::move(f),
+            cfg.iopc,
+            segment_appender::write_behind_memory / 2);
+          return copy_filtered_entries(
+            reader, std::move(bm), std::move(writer));
+      })
+      .then([old_name = tmpname.string(), new_name = reader.filename()] {
+          return ss::rename_file(old_name, new_name);
+      })
+      .finally([reader]() mutable {
+          return reader.close().then_wrapped(
+            [reader](ss::future<>) { /*ignore*/ });
       });
 }
+
+static ss::future<compacted_offset_list> generate_filtered_compacted_list(
+  model::offset o, compacted_index_reader reader, Roaring bitmap) {
+    reader.reset();
+    return reader
+      .consume(
+        index_filtered_offset_list_reducer(std::move(bitmap), o),
+        model::no_timeout)
+      .finally([reader]() mutable {
+          return reader.close().then_wrapped(
+            [reader](ss::future<>) { /*ignore*/ });
+      });
+}
+
+ss::future<storage::index_state> do_copy_segment_data(
+  ss::lw_shared_ptr<segment> s,
+  compaction_config cfg,
+  storage::probe& pb,
+  ss::rwlock::holder h,
+  compacted_offset_list list) {
+    const auto tmpname = data_segment_staging_name(s);
+    return make_segment_appender(
+             tmpname, cfg.sanitize, segment_appender::chunks_no_buffer, cfg.iopc)
+      .then([l = std::move(list), &pb, h = std::move(h), cfg, s](
+              segment_appender_ptr w) mutable {
+          auto raw = w.get();
+          auto red = copy_data_segment_reducer(std::move(l), raw);
+          auto r = create_segment_full_reader(s, cfg, pb, std::move(h));
+          return std::move(r)
+            .consume(std::move(red), model::no_timeout)
+            .finally([raw, w = std::move(w)]() mutable {
+                return raw->close()
+                  .handle_exception([](std::exception_ptr e) {
+                      vlog(
+                        stlog.error,
+                        "Error copying index to new segment:{}",
+                        e);
+                  })
+                  .finally([w = std::move(w)] {});
+            });
+      });
+}
+
 ss::future<storage::index_state> do_copy_segment_data(
   ss::lw_shared_ptr<segment> s,
   compaction_config cfg,
@@ -305,33 +370,63 @@ ss::future<storage::index_state> do_copy_segment_data(
       })
       .then(
         [cfg, s, &pb, h = std::move(h)](compacted_offset_list list) mutable {
-            const auto tmpname = data_segment_staging_name(s);
-            return make_segment_appender(
-                     tmpname,
-                     cfg.sanitize,
-                     segment_appender::chunks_no_buffer,
-                     cfg.iopc)
-              .then([l = std::move(list), &pb, h = std::move(h), cfg, s](
-                      segment_appender_ptr w) mutable {
-                  auto raw = w.get();
-                  auto red = copy_data_segment_reducer(std::move(l), raw);
-                  auto r = create_segment_full_reader(s, cfg, pb, std::move(h));
-                  return std::move(r)
-                    .consume(std::move(red), model::no_timeout)
-                    .finally([raw, w = std::move(w)]() mutable {
-                        return raw->close()
-                          .handle_exception([](std::exception_ptr e) {
-                              vlog(
-                                stlog.error,
-                                "Error copying index to new segment:{}",
-                                e);
-                          })
-                          .finally([w = std::move(w)] {});
-                    });
-              });
+            return do_copy_segment_data(
+              s, cfg, pb, std::move(h), std::move(list));
         });
 }
 
+/// pipelined self compaction: a single key-reduction pass over the raw
+/// compaction index produces the natural-index bitmap, after which the
+/// clean-index rewrite and the filtered data copy only depend on that
+/// bitmap and run concurrently over separate read handles - instead of
+/// rewriting the index, re-reading it from disk and only then copying
+static ss::future<storage::index_state> do_compact_segment_pipelined(
+  ss::lw_shared_ptr<segment> s,
+  compaction_config cfg,
+  storage::probe& pb,
+  ss::rwlock::holder h) {
+    auto idx_path = compacted_index_path(
+      std::filesystem::path(s->reader().filename()));
+    vlog(stlog.trace, "compacting index:{}", idx_path);
+    auto key_file = co_await make_reader_handle(idx_path, cfg.sanitize);
+    auto key_reader = make_file_backed_compacted_reader(
+      idx_path.string(), std::move(key_file), cfg.iopc, 64_KiB);
+
+    Roaring bitmap;
+    try {
+        bitmap = co_await natural_index_of_entries_to_keep(key_reader);
+    } catch (...) {
+        auto e = std::current_exception();
+        co_await key_reader.close().then_wrapped([](ss::future<>) {});
+        std::rethrow_exception(e);
+    }
+
+    // the second handle over the raw index must be opened *before* the
+    // clean rewrite renames over it, so both sides observe the unfiltered
+    // entries that the bitmap's natural indices refer to
+    auto list_file = co_await make_reader_handle(idx_path, cfg.sanitize);
+    auto list_reader = make_file_backed_compacted_reader(
+      idx_path.string(), std::move(list_file), cfg.iopc, 64_KiB);
+
+    auto clean_fut = write_clean_index_from_bitmap(key_reader, bitmap, cfg);
+    auto copy_fut = generate_filtered_compacted_list(
+                      s->offsets().base_offset,
+                      list_reader,
+                      std::move(bitmap))
+                      .then([cfg, s, &pb, h = std::move(h)](
+                              compacted_offset_list list) mutable {
+                          return do_copy_segment_data(
+                            s, cfg, pb, std::move(h), std::move(list));
+                      });
+    auto [clean_res, copy_res] = co_await ss::when_all(
+      std::move(clean_fut), std::move(copy_fut));
+    if (clean_res.failed()) {
+        copy_res.ignore_ready_future();
+        std::rethrow_exception(clean_res.get_exception());
+    }
+    co_return co_await std::move(copy_res);
+}
+
 model::record_batch_reader create_segment_full_reader(
   ss::lw_shared_ptr<storage::segment> s,
   storage::compaction_config cfg,
@@ -396,12 +491,9 @@ ss::future<> do_self_compact_segment(
                 segment_closed_exception());
           }
 
-          return do_compact_segment_index(s, cfg)
-            // copy the bytes after segment is good - note that we
-            // need to do it with the READ-lock, not the write lock
-            .then([cfg, s, h = std::move(h), &pb]() mutable {
-                return do_copy_segment_data(s, cfg, pb, std::move(h));
-            });
+          // rewrites the index and copies the bytes concurrently - note
+          // that we need to do it with the READ-lock, not the write lock
+          return do_compact_segment_pipelined(s, cfg, pb, std::move(h));
       })
       .then([s](storage::index_state idx) {
           return s->write_lock().then(
@@ -455,6 +547,88 @@ ss::future<> rebuild_compaction_index(
       });
 }
 
+ss::future<bool> try_merge_compacted_indexes(
+  std::filesystem::path target,
+  const std::vector<ss::lw_shared_ptr<segment>>& segments,
+  compaction_config cfg) {
+    std::vector<compacted_index_reader> readers;
+    readers.reserve(segments.size());
+    bool usable = true;
+    for (const auto& s : segments) {
+        auto path = compacted_index_path(
+          std::filesystem::path(s->reader().filename()));
+        try {
+            if (!co_await ss::file_exists(path.string())) {
+                usable = false;
+                break;
+            }
+            auto f = co_await make_reader_handle(path, cfg.sanitize);
+            auto reader = make_file_backed_compacted_reader(
+              path.string(), std::move(f), cfg.iopc, 64_KiB);
+            readers.push_back(reader);
+            co_await reader.verify_integrity();
+            auto footer = co_await reader.load_footer();
+            if (bool(
+                  footer.flags & compacted_index::footer_flags::truncation)) {
+                // the merge writer buffers keys in memory, so it does not
+                // preserve the entry order truncation markers rely on
+                usable = false;
+                break;
+            }
+        } catch (...) {
+            vlog(
+              stlog.info,
+              "will not merge compacted index {}: {}",
+              path,
+              std::current_exception());
+            usable = false;
+            break;
+        }
+    }
+    std::exception_ptr eptr;
+    if (usable) {
+        try {
+            auto writer = co_await make_compacted_index_writer(
+              target, cfg.sanitize, cfg.iopc);
+            std::exception_ptr copy_eptr;
+            try {
+                // segments are adjacent and entries order independent, so
+                // the merge is a sequential copy in segment order
+                for (auto& r : readers) {
+                    r.reset();
+                    co_await r.consume(
+                      index_copy_reducer(writer), model::no_timeout);
+                }
+            } catch (...) {
+                copy_eptr = std::current_exception();
+            }
+            co_await writer.close().handle_exception([](std::exception_ptr e) {
+                vlog(stlog.warn, "error closing compacted index:{}", e);
+            });
+            if (copy_eptr) {
+                std::rethrow_exception(copy_eptr);
+            }
+        } catch (...) {
+            eptr = std::current_exception();
+        }
+    }
+    for (auto& r : readers) {
+        co_await r.close().then_wrapped([](ss::future<>) {});
+    }
+    if (eptr) {
+        vlog(
+          stlog.info,
+          "compacted index merge into {} failed: {}",
+          target,
+          eptr);
+        if (co_await ss::file_exists(target.string())) {
+            co_await ss::remove_file(target.string());
+        }
+        co_return false;
+    }
+    co_return usable;
+}
+
 ss::future<> self_compact_segment(
   ss::lw_shared_ptr<segment> s, compaction_config cfg, storage::probe& pb) {
     if (s->has_appender()) {
@@ -661,4 +835,25 @@ bytes start_offset_key(model::ntp ntp) {
     return iobuf_to_bytes(buf);
 }
 
+bytes segment_manifest_key(model::ntp ntp) {
+    iobuf buf;
+    reflection::serialize(
+      buf, kvstore_key_type::segment_manifest, std::move(ntp));
+    return iobuf_to_bytes(buf);
+}
+
+ss::future<> persist_segment_manifest(
+  kvstore& kvs, const model::ntp& ntp, const segment_set& segs) {
+    std::vector<ss::sstring> files;
+    files.reserve(segs.size());
+    for (const auto& s : segs) {
+        files.push_back(ss::sstring(
+          std::filesystem::path(s->reader().filename()).filename().string()));
+    }
+    return kvs.put(
+      kvstore::key_space::storage,
+      segment_manifest_key(ntp),
+      reflection::to_iobuf(std::move(files)));
+}
+
 } // namespace storage::internal
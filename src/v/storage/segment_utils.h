@@ -26,6 +26,11 @@
 
 #include <roaring/roaring.hh>
 
+namespace storage {
+class kvstore;
+class segment_set;
+} // namespace storage
+
 namespace storage::internal {
 
 /// \brief, this method will acquire it's own locks on the segment
@@ -57,6 +62,22 @@ ss::future<ss::lw_shared_ptr<segment>> make_concatenated_segment(
   std::vector<ss::lw_shared_ptr<segment>>,
   compaction_config);
 
+/*
+ * Merge the raw compacted indexes of the given segments into a single
+ * index at @target so the combined segment's self-compaction can dedup
+ * from it directly instead of rebuilding the index by re-reading all of
+ * the concatenated batch data.
+ *
+ * Returns false - leaving no file at @target - when any source index is
+ * missing, fails its checksum, or contains truncation entries (the merge
+ * does not preserve entry order, which only plain key entries tolerate).
+ * The caller then falls back to the regular rebuild-from-data path.
+ */
+ss::future<bool> try_merge_compacted_indexes(
+  std::filesystem::path target,
+  const std::vector<ss::lw_shared_ptr<segment>>& segments,
+  compaction_config cfg);
+
 ss::future<std::vector<ss::rwlock::holder>> transfer_segment(
   ss::lw_shared_ptr<segment> to,
   ss::lw_shared_ptr<segment> from,
@@ -92,9 +113,12 @@ ss::future<segment_appender_ptr> make_segment_appender(
   const std::filesystem::path& path,
   storage::debug_sanitize_files debug,
   size_t number_of_chunks,
-  ss::io_priority_class iopc);
+  ss::io_priority_class iopc,
+  size_t falloc_step = segment_appender::fallocation_step);
 
-size_t number_of_chunks_from_config(const storage::ntp_config&);
+size_t number_of_chunks_from_config(
+  const storage::ntp_config&,
+  size_t base_chunks = segment_appender::chunks_no_buffer);
 
 /*
 1. if footer.flags == truncate write new .compacted_index file
@@ -138,6 +162,15 @@ ss::future<storage::index_state> do_copy_segment_data(
   storage::probe&,
   ss::rwlock::holder);
 
+/// \brief copies the filtered batches using a precomputed offset list,
+/// allowing the copy to overlap with the clean-index rewrite
+ss::future<storage::index_state> do_copy_segment_data(
+  ss::lw_shared_ptr<storage::segment>,
+  storage::compaction_config,
+  storage::probe&,
+  ss::rwlock::holder,
+  storage::compacted_offset_list);
+
 ss::future<> do_swap_data_file_handles(
   std::filesystem::path compacted,
   ss::lw_shared_ptr<storage::segment>,
@@ -155,8 +188,18 @@ size_t
 // key types used to store data in key-value store
 enum class kvstore_key_type : int8_t {
     start_offset = 0,
+    // per-shard boot-time device profile, see io_calibration.h
+    io_profile = 1,
+    // per-ntp list of segment file names, see log_manager::do_manage
+    segment_manifest = 2,
 };
 
 bytes start_offset_key(model::ntp ntp);
 
+bytes segment_manifest_key(model::ntp ntp);
+
+/// \brief rewrite the kvstore segment manifest to match the given set
+ss::future<>
+persist_segment_manifest(kvstore&, const model::ntp&, const segment_set&);
+
 } // namespace storage::internal
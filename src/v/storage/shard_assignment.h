@@ -20,13 +20,17 @@
 
 namespace storage {
 
-inline ss::shard_id shard_of(const model::ntp& ntp) {
+inline ss::shard_id shard_of(const model::ntp& ntp, uint32_t cores) {
     incremental_xxhash64 inc;
     inc.update(ntp.ns());
     inc.update(ntp.tp.topic());
     auto p = ntp.tp.partition();
     inc.update((const char*)&p, sizeof(model::partition_id::type));
-    return jump_consistent_hash(inc.digest(), ss::smp::count);
+    return jump_consistent_hash(inc.digest(), cores);
+}
+
+inline ss::shard_id shard_of(const model::ntp& ntp) {
+    return shard_of(ntp, ss::smp::count);
 }
 
 } // namespace storage
@@ -16,6 +16,8 @@
 #include "reflection/adl.h"
 #include "utils/directory_walker.h"
 
+#include <seastar/core/do_with.hh>
+#include <seastar/core/future-util.hh>
 #include <seastar/core/iostream.hh>
 
 #include <regex>
@@ -263,4 +265,189 @@ ss::future<> snapshot_writer::close() {
     });
 }
 
+ss::future<> chunked_snapshot_writer::write(iobuf buf) {
+    vassert(!_finished, "cannot write to a finished chunked snapshot");
+    _pending.append(std::move(buf));
+    return ss::do_until(
+      [this] { return _pending.size_bytes() < _chunk_size; },
+      [this] {
+          auto chunk = _pending.share(0, _chunk_size);
+          _pending.trim_front(_chunk_size);
+          return flush_chunk(std::move(chunk));
+      });
+}
+
+ss::future<> chunked_snapshot_writer::flush_chunk(iobuf chunk) {
+    crc32 crc;
+    crc_extend_iobuf(crc, chunk);
+    _index.push_back(chunk_entry{
+      .size = static_cast<uint32_t>(chunk.size_bytes()), .crc = crc.value()});
+    _data_size += chunk.size_bytes();
+    return write_iobuf_to_output_stream(std::move(chunk), _out);
+}
+
+ss::future<> chunked_snapshot_writer::finish() {
+    vassert(!_finished, "chunked snapshot already finished");
+    _finished = true;
+    auto tail = _pending.size_bytes() > 0
+                  ? flush_chunk(std::exchange(_pending, iobuf{}))
+                  : ss::now();
+    return tail.then([this] {
+        iobuf index_buf;
+        for (const auto& e : _index) {
+            reflection::serialize(index_buf, e.size, e.crc);
+        }
+
+        crc32 index_crc;
+        crc_extend_iobuf(index_crc, index_buf);
+        index_crc.extend(ss::cpu_to_le(static_cast<uint32_t>(_index.size())));
+        index_crc.extend(ss::cpu_to_le(static_cast<uint32_t>(_chunk_size)));
+        index_crc.extend(ss::cpu_to_le(_data_size));
+        index_crc.extend(ss::cpu_to_le(version));
+
+        reflection::serialize(
+          index_buf,
+          static_cast<uint32_t>(_index.size()),
+          static_cast<uint32_t>(_chunk_size),
+          _data_size,
+          index_crc.value(),
+          version);
+        return write_iobuf_to_output_stream(std::move(index_buf), _out);
+    });
+}
+
+ss::input_stream<char>
+chunked_snapshot_reader::stream_at(uint64_t offset, uint64_t len) {
+    ss::file_input_stream_options options;
+    options.io_priority_class = _io_prio;
+    return ss::make_file_input_stream(_file, offset, len, options);
+}
+
+ss::future<> chunked_snapshot_reader::load_index() {
+    if (_end < _begin + trailer_ondisk_size) {
+        return ss::make_exception_future<>(std::runtime_error(fmt::format(
+          "Corrupt snapshot. Region of {} bytes cannot hold a chunk trailer",
+          _end - _begin)));
+    }
+    const uint64_t trailer_offset = _end - trailer_ondisk_size;
+    return ss::do_with(
+             stream_at(trailer_offset, trailer_ondisk_size),
+             [](ss::input_stream<char>& in) {
+                 return read_iobuf_exactly(in, trailer_ondisk_size)
+                   .finally([&in] { return in.close(); });
+             })
+      .then([this, trailer_offset](iobuf buf) {
+          if (buf.size_bytes() != trailer_ondisk_size) {
+              return ss::make_exception_future<>(std::runtime_error(
+                "Corrupt snapshot. Failed to read chunk trailer"));
+          }
+
+          iobuf_parser parser(std::move(buf));
+          const auto count = reflection::adl<uint32_t>{}.from(parser);
+          const auto chunk_size = reflection::adl<uint32_t>{}.from(parser);
+          const auto data_size = reflection::adl<uint64_t>{}.from(parser);
+          const auto index_crc = reflection::adl<uint32_t>{}.from(parser);
+          const auto version = reflection::adl<int8_t>{}.from(parser);
+
+          if (version != chunked_snapshot_writer::version) {
+              return ss::make_exception_future<>(
+                std::runtime_error(fmt::format(
+                  "Invalid chunked snapshot version {} != {}",
+                  version,
+                  chunked_snapshot_writer::version)));
+          }
+
+          const uint64_t index_size = uint64_t(count) * 2 * sizeof(uint32_t);
+          if (trailer_offset < _begin + index_size) {
+              return ss::make_exception_future<>(std::runtime_error(
+                "Corrupt snapshot. Chunk index exceeds region"));
+          }
+
+          return ss::do_with(
+                   stream_at(trailer_offset - index_size, index_size),
+                   [index_size](ss::input_stream<char>& in) {
+                       return read_iobuf_exactly(in, index_size)
+                         .finally([&in] { return in.close(); });
+                   })
+            .then([this, count, chunk_size, data_size, index_crc, version](
+                    iobuf buf) {
+                crc32 crc;
+                crc_extend_iobuf(crc, buf);
+                crc.extend(ss::cpu_to_le(count));
+                crc.extend(ss::cpu_to_le(chunk_size));
+                crc.extend(ss::cpu_to_le(data_size));
+                crc.extend(ss::cpu_to_le(version));
+                if (crc.value() != index_crc) {
+                    throw std::runtime_error(fmt::format(
+                      "Corrupt snapshot. Failed to verify chunk index crc: "
+                      "{} != {}",
+                      crc.value(),
+                      index_crc));
+                }
+
+                _chunk_size = chunk_size;
+                _data_size = data_size;
+                _index.clear();
+                _index.reserve(count);
+                iobuf_parser parser(std::move(buf));
+                uint64_t total = 0;
+                for (uint32_t i = 0; i < count; ++i) {
+                    const auto size = reflection::adl<uint32_t>{}.from(parser);
+                    const auto entry_crc = reflection::adl<uint32_t>{}.from(
+                      parser);
+                    // all but the last chunk are exactly chunk_size, that
+                    // is what makes chunk offsets derivable
+                    if (i + 1 < count && size != chunk_size) {
+                        throw std::runtime_error(fmt::format(
+                          "Corrupt snapshot. Chunk {} has size {} != {}",
+                          i,
+                          size,
+                          chunk_size));
+                    }
+                    total += size;
+                    _index.push_back(chunked_snapshot_writer::chunk_entry{
+                      .size = size, .crc = entry_crc});
+                }
+                if (total != _data_size) {
+                    throw std::runtime_error(fmt::format(
+                      "Corrupt snapshot. Chunk sizes sum to {} != {}",
+                      total,
+                      _data_size));
+                }
+            });
+      });
+}
+
+ss::future<iobuf> chunked_snapshot_reader::read_chunk(size_t chunk) {
+    vassert(
+      chunk < _index.size(),
+      "chunk {} out of range, index holds {} chunks",
+      chunk,
+      _index.size());
+    const auto entry = _index[chunk];
+    const uint64_t offset = _begin + uint64_t(chunk) * _chunk_size;
+    return ss::do_with(
+             stream_at(offset, entry.size),
+             [size = entry.size](ss::input_stream<char>& in) {
+                 return read_iobuf_exactly(in, size).finally(
+                   [&in] { return in.close(); });
+             })
+      .then([chunk, entry](iobuf buf) {
+          if (buf.size_bytes() != entry.size) {
+              throw std::runtime_error(fmt::format(
+                "Corrupt snapshot. Failed to read chunk {}", chunk));
+          }
+          crc32 crc;
+          crc_extend_iobuf(crc, buf);
+          if (crc.value() != entry.crc) {
+              throw std::runtime_error(fmt::format(
+                "Corrupt snapshot. Failed to verify chunk {} crc: {} != {}",
+                chunk,
+                crc.value(),
+                entry.crc));
+          }
+          return buf;
+      });
+}
+
 } // namespace storage
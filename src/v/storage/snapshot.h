@@ -20,6 +20,7 @@
 #include <seastar/util/log.hh>
 
 #include <filesystem>
+#include <vector>
 
 namespace storage {
 
@@ -228,4 +229,117 @@ private:
     bool _closed = false;
 };
 
+/**
+ * Chunked snapshot container (format version 2).
+ *
+ * The v1 snapshot blob is one opaque stream: nothing can be served until
+ * the whole stream has been read and no part of it can be verified in
+ * isolation. The chunked container splits the blob into fixed-size
+ * checksummed chunks followed by an index and a trailer:
+ *
+ *    [chunk 0][chunk 1]...[chunk n-1][index: {size, crc} * n][trailer]
+ *
+ * All chunks but the last are exactly chunk_size bytes, so a chunk's file
+ * offset is derived from its number and the index only records sizes and
+ * crcs. The trailer carries the chunk count, chunk size, total data size
+ * and a crc over the index, mirroring the header/metadata crc scheme of
+ * the v1 envelope.
+ *
+ * The container is self-delimiting within a file region, so it layers
+ * under the existing envelope: a state machine writes its blob through a
+ * chunked_snapshot_writer wrapping snapshot_writer::output(), and on
+ * restore opens a chunked_snapshot_reader over the blob region. Chunks
+ * are read and verified individually and in any order, so a restore can
+ * start serving from the chunks it needs before the tail was decoded and
+ * a corruption is pinned to one chunk instead of the whole file.
+ */
+class chunked_snapshot_writer {
+public:
+    static constexpr int8_t version = 2;
+    static constexpr size_t default_chunk_size = 1 << 20;
+
+    /// per-chunk index entry; the on disk form is {size, crc}
+    struct chunk_entry {
+        uint32_t size;
+        uint32_t crc;
+    };
+
+    explicit chunked_snapshot_writer(
+      ss::output_stream<char>& out, size_t chunk_size = default_chunk_size)
+      : _out(out)
+      , _chunk_size(chunk_size) {}
+
+    /// Append bytes to the container. Full chunks are checksummed and
+    /// written out as they accumulate.
+    ss::future<> write(iobuf);
+
+    /// Writes the final partial chunk, the index and the trailer. The
+    /// underlying stream is not flushed or closed; that stays with the
+    /// owning snapshot_writer.
+    ss::future<> finish();
+
+    uint64_t data_size() const { return _data_size; }
+    size_t chunk_count() const { return _index.size(); }
+
+private:
+    ss::future<> flush_chunk(iobuf);
+
+    ss::output_stream<char>& _out;
+    size_t _chunk_size;
+    iobuf _pending;
+    std::vector<chunk_entry> _index;
+    uint64_t _data_size{0};
+    bool _finished{false};
+};
+
+/**
+ * Reader for the chunked snapshot container; see chunked_snapshot_writer.
+ *
+ * Construct over the file region holding the container, call load_index
+ * once, then read chunks lazily in any order. Each read verifies only the
+ * chunk it returns. The reader borrows the file handle and closes only
+ * the streams it creates.
+ */
+class chunked_snapshot_reader {
+public:
+    chunked_snapshot_reader(
+      ss::file file,
+      uint64_t region_begin,
+      uint64_t region_end,
+      ss::io_priority_class io_prio)
+      : _file(std::move(file))
+      , _begin(region_begin)
+      , _end(region_end)
+      , _io_prio(io_prio) {}
+
+    /// Reads and verifies the trailer and the chunk index.
+    ss::future<> load_index();
+
+    /// Reads and verifies a single chunk.
+    ss::future<iobuf> read_chunk(size_t chunk);
+
+    size_t chunk_count() const { return _index.size(); }
+    uint64_t data_size() const { return _data_size; }
+    size_t chunk_size() const { return _chunk_size; }
+
+private:
+    /// fixed-layout tail of the container: chunk count, chunk size, data
+    /// size, index crc and format version
+    static constexpr size_t trailer_ondisk_size = sizeof(uint32_t)
+                                                  + sizeof(uint32_t)
+                                                  + sizeof(uint64_t)
+                                                  + sizeof(uint32_t)
+                                                  + sizeof(int8_t);
+
+    ss::input_stream<char> stream_at(uint64_t offset, uint64_t len);
+
+    ss::file _file;
+    uint64_t _begin;
+    uint64_t _end;
+    ss::io_priority_class _io_prio;
+    size_t _chunk_size{0};
+    uint64_t _data_size{0};
+    std::vector<chunked_snapshot_writer::chunk_entry> _index;
+};
+
 } // namespace storage
@@ -10,6 +10,7 @@
 #include "storage/spill_key_index.h"
 
 #include "bytes/bytes.h"
+#include "likely.h"
 #include "random/generators.h"
 #include "reflection/adl.h"
 #include "storage/compacted_index_writer.h"
@@ -36,7 +37,11 @@ spill_key_index::spill_key_index(
   size_t max_memory)
   : compacted_index_writer::impl(std::move(name))
   , _appender(std::move(index_file), segment_appender::options(p, 1))
-  , _max_mem(max_memory) {}
+  , _max_mem(max_memory)
+  // one filter bit per byte of the in-memory key budget, i.e. 1/8 of the
+  // budget in actual memory - a few percent false positives at the key
+  // cardinalities that saturate the map
+  , _spilled_keys(std::max<size_t>(max_memory, 4_KiB)) {}
 
 spill_key_index::~spill_key_index() {
     vassert(
@@ -75,10 +80,23 @@ ss::future<> spill_key_index::add_key(bytes b, value_type v) {
                   return _midx.empty() || _midx.load_factor() <= 0.86;
               },
               [this] {
-                  // evict random entry
+                  // evict random entry, preferring keys that were never
+                  // spilled: re-spilling a recurring key produces yet
+                  // another duplicate index entry for later merge passes
                   auto n = random_generators::get_int<size_t>(
                     0, _midx.size() - 1);
                   auto mit = std::next(_midx.begin(), n);
+                  for (int attempt = 0; attempt < 4; ++attempt) {
+                      if (!_spilled_keys.maybe_contains(
+                            // NOLINTNEXTLINE
+                            reinterpret_cast<const char*>(mit->first.data()),
+                            mit->first.size())) {
+                          break;
+                      }
+                      n = random_generators::get_int<size_t>(
+                        0, _midx.size() - 1);
+                      mit = std::next(_midx.begin(), n);
+                  }
                   auto node = _midx.extract(mit);
 
                   return ss::do_with(
@@ -93,6 +111,15 @@ ss::future<> spill_key_index::add_key(bytes b, value_type v) {
     }
 
     return f.then([this, b = std::move(b), v]() mutable {
+        if (unlikely(_spilled_keys.maybe_contains(
+              // NOLINTNEXTLINE
+              reinterpret_cast<const char*>(b.data()),
+              b.size()))) {
+            // the key (probably) already has an on-disk entry; we still
+            // must record this later occurrence, but account for the
+            // duplicate so it shows up in diagnostics
+            ++_probably_dup_keys;
+        }
         // convert iobuf to key
         _keys_mem_usage += b.size();
         _midx.insert({std::move(b), v});
@@ -156,6 +183,13 @@ ss::future<> spill_key_index::spill(
     const size_t size_le = ss::cpu_to_le(size); // downcast
     ph.write(reinterpret_cast<const char*>(&size_le), size_reservation);
 
+    if (type == compacted_index::entry_type::key) {
+        _spilled_keys.add(
+          // NOLINTNEXTLINE
+          reinterpret_cast<const char*>(b.data()),
+          b.size());
+    }
+
     // update internal state
     _footer.size += payload.size_bytes();
     for (auto& f : payload) {
@@ -233,12 +267,13 @@ std::ostream& operator<<(std::ostream& o, const spill_key_index& k) {
     fmt::print(
       o,
       "{{name:{}, max_mem:{}, key_mem_usage:{}, persisted_entries:{}, "
-      "in_memory_entries:{}, file_appender:{}}}",
+      "in_memory_entries:{}, probably_dup_keys:{}, file_appender:{}}}",
       k.filename(),
       k._max_mem,
       k._keys_mem_usage,
       k._footer.keys,
       k._midx.size(),
+      k._probably_dup_keys,
       k._appender);
     return o;
 }
@@ -16,6 +16,7 @@
 #include "storage/compacted_index.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/segment_appender.h"
+#include "utils/bloom_filter.h"
 #include "utils/vint.h"
 
 #include <seastar/core/file.hh>
@@ -81,6 +82,13 @@ private:
     size_t _keys_mem_usage{0};
     compacted_index::footer _footer;
     crc32 _crc;
+    /// summary of the keys already spilled to disk. we cannot *drop* a
+    /// re-occurring key (offsets only grow and the latest must win), but
+    /// the filter lets eviction prefer keys that were never spilled, so
+    /// recurring hot keys stay coalesced in memory instead of producing
+    /// one duplicate entry per eviction for downstream merge passes
+    bloom_filter _spilled_keys;
+    size_t _probably_dup_keys{0};
 
     friend std::ostream& operator<<(std::ostream&, const spill_key_index&);
 };
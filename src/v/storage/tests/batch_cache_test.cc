@@ -13,6 +13,8 @@
 
 #include <seastar/testing/thread_test_case.hh>
 
+#include <cstring>
+
 static storage::batch_cache::reclaim_options opts = {
   .growth_window = std::chrono::milliseconds(3000),
   .stable_window = std::chrono::milliseconds(10000),
@@ -260,3 +262,48 @@ SEASTAR_THREAD_TEST_CASE(index_truncate_hole_missing_prev) {
     BOOST_CHECK(!index.get(model::offset(11)));
     BOOST_CHECK(!index.get(model::offset(41)));
 }
+
+// a batch whose payload is split into many full fragments of frag_size bytes
+static model::record_batch make_fragmented_batch(size_t frag_size, size_t n) {
+    iobuf payload;
+    for (size_t i = 0; i < n; i++) {
+        ss::temporary_buffer<char> b(frag_size);
+        std::memset(b.get_write(), 'x', frag_size);
+        payload.append_take_ownership(
+          new iobuf::fragment(std::move(b), iobuf::fragment::full{}));
+    }
+    model::record_batch_header hdr{
+      .size_bytes = static_cast<int32_t>(
+        model::packed_record_batch_header_size + payload.size_bytes()),
+      .base_offset = model::offset(0),
+      .type = model::record_batch_type(1),
+      .record_count = 1};
+    return model::record_batch(
+      hdr, std::move(payload), model::record_batch::tag_ctor_ng{});
+}
+
+SEASTAR_THREAD_TEST_CASE(put_compacts_small_fragmented_batches) {
+    storage::batch_cache c(opts);
+    storage::batch_cache_index index(c);
+
+    auto b = make_fragmented_batch(16, 64);
+    BOOST_REQUIRE(b.data().should_compact());
+    auto w = c.put(index, std::move(b));
+    // re-packed inline at admission
+    BOOST_CHECK(!w->batch().data().should_compact());
+}
+
+SEASTAR_THREAD_TEST_CASE(defragment_repacks_large_residents) {
+    storage::batch_cache c(opts);
+    storage::batch_cache_index index(c);
+
+    // too large to compact inline on the admission path
+    auto b = make_fragmented_batch(512, 128);
+    auto w = c.put(index, std::move(b));
+    BOOST_REQUIRE(w->batch().data().should_compact());
+
+    BOOST_CHECK_EQUAL(c.defragment(), 1);
+    BOOST_CHECK(!w->batch().data().should_compact());
+    // nothing left to do
+    BOOST_CHECK_EQUAL(c.defragment(), 0);
+}
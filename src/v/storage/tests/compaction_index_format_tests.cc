@@ -92,6 +92,61 @@ FIXTURE_TEST(format_verification_max_key, compacted_topic_fixture) {
         - 2 * vint::max_length + vint::vint_size(42) + vint::vint_size(66) + 1
         + 2);
 }
+FIXTURE_TEST(index_copy_reducer_merge, compacted_topic_fixture) {
+    // two raw indexes, as adjacent-segment compaction sees them
+    tmpbuf_file::store_t first_data;
+    auto first = storage::make_file_backed_compacted_index(
+      "first",
+      ss::file(ss::make_shared(tmpbuf_file(first_data))),
+      ss::default_priority_class(),
+      1_KiB);
+    first.index(random_generators::get_bytes(128), model::offset(1), 0).get();
+    first.index(random_generators::get_bytes(128), model::offset(2), 0).get();
+    first.close().get();
+
+    tmpbuf_file::store_t second_data;
+    auto second = storage::make_file_backed_compacted_index(
+      "second",
+      ss::file(ss::make_shared(tmpbuf_file(second_data))),
+      ss::default_priority_class(),
+      1_KiB);
+    second.index(random_generators::get_bytes(128), model::offset(10), 0).get();
+    second.index(random_generators::get_bytes(128), model::offset(11), 0).get();
+    second.close().get();
+
+    tmpbuf_file::store_t merged_data;
+    auto merged = storage::make_file_backed_compacted_index(
+      "merged",
+      ss::file(ss::make_shared(tmpbuf_file(merged_data))),
+      ss::default_priority_class(),
+      1_KiB);
+    for (auto* data : {&first_data, &second_data}) {
+        auto rdr = storage::make_file_backed_compacted_reader(
+          "source",
+          ss::file(ss::make_shared(tmpbuf_file(*data))),
+          ss::default_priority_class(),
+          32_KiB);
+        rdr.load_footer().get0();
+        rdr.reset();
+        rdr
+          .consume(
+            storage::internal::index_copy_reducer(merged), model::no_timeout)
+          .get();
+        rdr.close().get();
+    }
+    merged.close().get();
+
+    auto rdr = storage::make_file_backed_compacted_reader(
+      "merged",
+      ss::file(ss::make_shared(tmpbuf_file(merged_data))),
+      ss::default_priority_class(),
+      32_KiB);
+    rdr.verify_integrity().get();
+    auto footer = rdr.load_footer().get0();
+    BOOST_REQUIRE_EQUAL(footer.keys, 4);
+    auto vec = compaction_index_reader_to_memory(std::move(rdr)).get0();
+    BOOST_REQUIRE_EQUAL(vec.size(), 4);
+}
 FIXTURE_TEST(format_verification_roundtrip, compacted_topic_fixture) {
     tmpbuf_file::store_t index_data;
     auto idx = storage::make_file_backed_compacted_index(
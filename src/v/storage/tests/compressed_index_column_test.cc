@@ -0,0 +1,81 @@
+#define BOOST_TEST_MODULE storage
+#include "random/generators.h"
+#include "storage/compressed_index_column.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(column_roundtrip_monotonic) {
+    storage::compressed_index_column col;
+    std::vector<uint32_t> ref;
+    uint32_t v = 0;
+    for (int i = 0; i < 1000; ++i) {
+        v += random_generators::get_int<uint32_t>(0, 32768);
+        col.push_back(v);
+        ref.push_back(v);
+    }
+    BOOST_REQUIRE_EQUAL(col.size(), ref.size());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(col[i], ref[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(column_roundtrip_random) {
+    storage::compressed_index_column col;
+    std::vector<uint32_t> ref;
+    for (int i = 0; i < 555; ++i) {
+        auto v = random_generators::get_int<uint32_t>();
+        col.push_back(v);
+        ref.push_back(v);
+    }
+    for (size_t i = 0; i < ref.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(col[i], ref[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(column_pop_back_reopens_frames) {
+    storage::compressed_index_column col;
+    std::vector<uint32_t> ref;
+    for (uint32_t i = 0; i < 100; ++i) {
+        col.push_back(i * 7);
+        ref.push_back(i * 7);
+    }
+    while (!ref.empty()) {
+        BOOST_REQUIRE_EQUAL(col.back(), ref.back());
+        col.pop_back();
+        ref.pop_back();
+        BOOST_REQUIRE_EQUAL(col.size(), ref.size());
+    }
+    BOOST_REQUIRE(col.empty());
+}
+
+BOOST_AUTO_TEST_CASE(column_lower_bound) {
+    storage::compressed_index_column col;
+    std::vector<uint32_t> ref;
+    uint32_t v = 0;
+    for (int i = 0; i < 333; ++i) {
+        v += random_generators::get_int<uint32_t>(1, 100);
+        col.push_back(v);
+        ref.push_back(v);
+    }
+    for (uint32_t needle = 0; needle <= v + 1; needle += 13) {
+        auto it = std::lower_bound(col.begin(), col.end(), needle);
+        auto rit = std::lower_bound(ref.begin(), ref.end(), needle);
+        BOOST_REQUIRE_EQUAL(
+          std::distance(col.begin(), it), std::distance(ref.begin(), rit));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(column_equality) {
+    storage::compressed_index_column a;
+    storage::compressed_index_column b;
+    for (uint32_t i = 0; i < 50; ++i) {
+        a.push_back(i);
+        b.push_back(i);
+    }
+    BOOST_REQUIRE(a == b);
+    b.push_back(1);
+    BOOST_REQUIRE(!(a == b));
+}
@@ -126,3 +126,49 @@ FIXTURE_TEST(iterator_invalidation, log_builder_fixture) {
     BOOST_REQUIRE_EQUAL(config_batches.size(), 2);
     BOOST_REQUIRE_EQUAL(all_batches.size(), 4);
 }
+
+FIXTURE_TEST(header_filter_pushdown, log_builder_fixture) {
+    using namespace storage; // NOLINT
+    constexpr const model::record_batch_type configuration
+      = model::record_batch_type(2);
+    constexpr const model::record_batch_type data = model::record_batch_type(1);
+
+    b | start() | add_segment(0)
+      | add_random_batch(0, 1, maybe_compress_batches::yes, configuration)
+      | add_random_batch(1, 1, maybe_compress_batches::yes, data)
+      | add_random_batch(2, 1, maybe_compress_batches::yes, configuration)
+      | add_random_batch(3, 1, maybe_compress_batches::yes, data);
+
+    auto type_cfg = log_reader_config(
+      model::offset(0),
+      model::model_limits<model::offset>::max(),
+      ss::default_priority_class());
+    type_cfg.filter = [data](const model::record_batch_header& h) {
+        return h.type == data;
+    };
+    auto data_batches = b.consume(type_cfg).get0();
+
+    auto range_cfg = log_reader_config(
+      model::offset(0),
+      model::model_limits<model::offset>::max(),
+      ss::default_priority_class());
+    range_cfg.filter = [](const model::record_batch_header& h) {
+        return h.base_offset >= model::offset(2);
+    };
+    auto tail_batches = b.consume(range_cfg).get0();
+
+    auto all_batches = b.consume().get0();
+    b | stop();
+
+    BOOST_REQUIRE_EQUAL(data_batches.size(), 2);
+    for (auto& batch : data_batches) {
+        BOOST_REQUIRE(batch.header().type == data);
+    }
+    BOOST_REQUIRE_EQUAL(data_batches.front().base_offset(), model::offset(1));
+    BOOST_REQUIRE_EQUAL(data_batches.back().base_offset(), model::offset(3));
+
+    BOOST_REQUIRE_EQUAL(tail_batches.size(), 2);
+    BOOST_REQUIRE_EQUAL(tail_batches.front().base_offset(), model::offset(2));
+
+    BOOST_REQUIRE_EQUAL(all_batches.size(), 4);
+}
@@ -0,0 +1,103 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "random/generators.h"
+#include "seastarx.h"
+#include "storage/hydrated_segment_cache.h"
+
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+static ss::sstring make_cache_dir() {
+    return ss::format(
+      "test.cache.dir_{}", random_generators::gen_alphanum_string(7));
+}
+
+static ss::sstring read_all(ss::file f) {
+    auto size = f.size().get0();
+    auto buf = f.dma_read_bulk<char>(0, size).get0();
+    auto str = ss::sstring(buf.get(), buf.size());
+    f.close().get();
+    return str;
+}
+
+static storage::hydrated_segment_cache::hydrate_func
+writer_of(ss::sstring payload, size_t& downloads) {
+    return [payload{std::move(payload)},
+            &downloads](ss::output_stream<char>& out) {
+        ++downloads;
+        return out.write(payload.data(), payload.size());
+    };
+}
+
+SEASTAR_THREAD_TEST_CASE(hit_after_miss_downloads_once) {
+    storage::hydrated_segment_cache cache(make_cache_dir(), 1 << 20);
+    size_t downloads = 0;
+
+    auto f = cache.get("kafka/t/0/0-1-v1.log", writer_of("payload", downloads))
+               .get0();
+    BOOST_REQUIRE_EQUAL(read_all(std::move(f)), "payload");
+    BOOST_REQUIRE_EQUAL(downloads, 1);
+
+    // second read is a hit and must not download
+    f = cache.get("kafka/t/0/0-1-v1.log", writer_of("payload", downloads))
+          .get0();
+    BOOST_REQUIRE_EQUAL(read_all(std::move(f)), "payload");
+    BOOST_REQUIRE_EQUAL(downloads, 1);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1);
+    cache.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(concurrent_misses_share_one_download) {
+    storage::hydrated_segment_cache cache(make_cache_dir(), 1 << 20);
+    size_t downloads = 0;
+
+    auto f1 = cache.get(
+      "kafka/t/0/0-1-v1.log", writer_of("payload", downloads));
+    auto f2 = cache.get(
+      "kafka/t/0/0-1-v1.log", writer_of("payload", downloads));
+    BOOST_REQUIRE_EQUAL(read_all(f1.get0()), "payload");
+    BOOST_REQUIRE_EQUAL(read_all(f2.get0()), "payload");
+    BOOST_REQUIRE_EQUAL(downloads, 1);
+    cache.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(lru_eviction_respects_budget) {
+    // budget fits roughly two of the three entries
+    const auto payload = random_generators::gen_alphanum_string(1000);
+    storage::hydrated_segment_cache cache(make_cache_dir(), 2500);
+    size_t downloads = 0;
+
+    read_all(
+      cache.get("kafka/t/0/0-1-v1.log", writer_of(payload, downloads)).get0());
+    read_all(
+      cache.get("kafka/t/0/100-1-v1.log", writer_of(payload, downloads))
+        .get0());
+    // touch the first entry so the second becomes the LRU victim
+    read_all(
+      cache.get("kafka/t/0/0-1-v1.log", writer_of(payload, downloads)).get0());
+    read_all(
+      cache.get("kafka/t/0/200-1-v1.log", writer_of(payload, downloads))
+        .get0());
+    BOOST_REQUIRE_EQUAL(downloads, 3);
+    BOOST_REQUIRE_EQUAL(cache.size(), 2);
+    BOOST_REQUIRE(cache.disk_usage() <= 2500);
+
+    // the victim re-downloads, the survivor does not
+    read_all(
+      cache.get("kafka/t/0/100-1-v1.log", writer_of(payload, downloads))
+        .get0());
+    BOOST_REQUIRE_EQUAL(downloads, 4);
+    read_all(
+      cache.get("kafka/t/0/200-1-v1.log", writer_of(payload, downloads))
+        .get0());
+    BOOST_REQUIRE_EQUAL(downloads, 4);
+    cache.stop().get();
+}
@@ -0,0 +1,90 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "random/generators.h"
+#include "storage/io_calibration.h"
+#include "storage/kvstore.h"
+#include "storage/segment_appender.h"
+
+#include <seastar/core/seastar.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+template<typename T>
+static void set_configuration(ss::sstring p_name, T v) {
+    ss::smp::invoke_on_all([p_name, v = std::move(v)] {
+        config::shard_local_cfg().get(p_name).set_value(v);
+    }).get0();
+}
+
+static storage::kvstore_config get_conf(ss::sstring dir) {
+    return storage::kvstore_config(
+      8192,
+      std::chrono::milliseconds(10),
+      dir,
+      storage::debug_sanitize_files::yes);
+}
+
+SEASTAR_THREAD_TEST_CASE(calibrate_probe) {
+    auto dir = fmt::format(
+      "io_calib_test_{}", random_generators::get_int(4000));
+    ss::recursive_touch_directory(dir).get();
+
+    auto profile = storage::io_calibration::calibrate(dir).get0();
+    BOOST_REQUIRE(profile.write_bandwidth > 0);
+    BOOST_REQUIRE(profile.write_latency.count() >= 0);
+
+    // derived knobs stay inside the appender's static bounds
+    BOOST_REQUIRE_GE(
+      profile.initial_falloc_step(),
+      storage::segment_appender::min_fallocation_step);
+    BOOST_REQUIRE_LE(
+      profile.initial_falloc_step(),
+      storage::segment_appender::fallocation_step);
+    BOOST_REQUIRE_GE(
+      profile.appender_chunks(),
+      storage::segment_appender::chunks_no_buffer);
+    BOOST_REQUIRE_LE(
+      profile.appender_chunks(),
+      2 * storage::segment_appender::chunks_no_buffer);
+
+    // the probe cleans up after itself
+    const auto probe_file = fmt::format("{}/calibration.0.probe", dir);
+    BOOST_REQUIRE(!ss::file_exists(probe_file).get0());
+}
+
+SEASTAR_THREAD_TEST_CASE(profile_persisted) {
+    set_configuration("disable_metrics", true);
+
+    auto dir = fmt::format(
+      "io_calib_test_{}", random_generators::get_int(4000));
+    auto conf = get_conf(dir);
+
+    auto kvs = std::make_unique<storage::kvstore>(conf);
+    kvs->start().get();
+
+    // first call probes and persists, second call must serve the
+    // persisted profile
+    auto first
+      = storage::io_calibration::load_or_calibrate(*kvs, dir).get0();
+    auto second
+      = storage::io_calibration::load_or_calibrate(*kvs, dir).get0();
+    BOOST_REQUIRE(first.write_latency == second.write_latency);
+    BOOST_REQUIRE(first.write_bandwidth == second.write_bandwidth);
+
+    kvs->stop().get();
+
+    // still served from the store after recovery
+    kvs = std::make_unique<storage::kvstore>(conf);
+    kvs->start().get();
+    auto recovered
+      = storage::io_calibration::load_or_calibrate(*kvs, dir).get0();
+    BOOST_REQUIRE(first.write_latency == recovered.write_latency);
+    BOOST_REQUIRE(first.write_bandwidth == recovered.write_bandwidth);
+    kvs->stop().get();
+}
@@ -8,9 +8,12 @@
 // by the Apache License, Version 2.0
 
 #include "bytes/iobuf.h"
+#include "model/record.h"
 #include "random/generators.h"
+#include "reflection/adl.h"
 #include "seastarx.h"
 #include "storage/segment_appender.h"
+#include "storage/segment_appender_utils.h"
 
 #include <seastar/core/reactor.hh>
 #include <seastar/core/thread.hh>
@@ -217,3 +220,43 @@ SEASTAR_THREAD_TEST_CASE(test_can_append_little_data) {
     BOOST_REQUIRE_EQUAL(appender.file_byte_offset(), data.size());
     appender.close().get();
 }
+
+SEASTAR_THREAD_TEST_CASE(test_disk_header_encoding_matches_adl_layout) {
+    model::record_batch_header h{
+      .header_crc = 11,
+      .size_bytes = 61,
+      .base_offset = model::offset(42),
+      .type = model::record_batch_type(1),
+      .crc = 12345,
+      .last_offset_delta = 9,
+      .first_timestamp = model::timestamp(100),
+      .max_timestamp = model::timestamp(200),
+      .producer_id = 7,
+      .producer_epoch = 3,
+      .base_sequence = 5,
+      .record_count = 10};
+
+    // the iobuf serialization this encoder replaced; the on-disk layout
+    // must not drift
+    iobuf expected;
+    reflection::serialize(
+      expected,
+      h.header_crc,
+      h.size_bytes,
+      h.base_offset(),
+      h.type(),
+      h.crc,
+      h.attrs.value(),
+      h.last_offset_delta,
+      h.first_timestamp.value(),
+      h.max_timestamp.value(),
+      h.producer_id,
+      h.producer_epoch,
+      h.base_sequence,
+      h.record_count);
+
+    auto encoded = encode_disk_header(h);
+    iobuf actual;
+    actual.append(encoded.data(), encoded.size());
+    BOOST_REQUIRE_EQUAL(actual, expected);
+}
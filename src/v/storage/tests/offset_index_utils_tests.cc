@@ -95,6 +95,24 @@ FIXTURE_TEST(bucket_bug1, context) {
         BOOST_REQUIRE_EQUAL(p->filepos, 600121);
     }
 }
+FIXTURE_TEST(tail_batch_granularity, context) {
+    info("index: {}", _idx);
+    info("Testing batch granular tail entries");
+    _idx->maybe_track(modify_get(model::offset{824}, 155103), 0); // indexed
+    // too small to cross the step; only the in-memory tail knows them
+    _idx->maybe_track(modify_get(model::offset{849}, 100), 155103);
+    _idx->maybe_track(modify_get(model::offset{852}, 100), 155203);
+    index_entry_expect(849, 155103);
+    index_entry_expect(852, 155203);
+    // truncation drops tail entries at and above the target
+    _idx->truncate(model::offset(852)).get();
+    {
+        auto p = _idx->find_nearest(model::offset(852));
+        BOOST_REQUIRE(bool(p));
+        BOOST_REQUIRE_EQUAL(p->offset, model::offset(849));
+        BOOST_REQUIRE_EQUAL(p->filepos, 155103);
+    }
+}
 FIXTURE_TEST(bucket_truncate, context) {
     info("index: {}", _idx);
     info("Testing bucket truncate");
@@ -0,0 +1,117 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "model/fundamental.h"
+#include "seastarx.h"
+#include "storage/tests/disk_log_builder_fixture.h"
+#include "test_utils/fixture.h"
+
+static ss::circular_buffer<model::record_batch>
+read_range(storage::disk_log_builder& b, model::offset start, model::offset max) {
+    return b
+      .consume(storage::log_reader_config(
+        start, max, ss::default_priority_class()))
+      .get0();
+}
+
+FIXTURE_TEST(sequential_fetch_reuses_reader, log_builder_fixture) {
+    using namespace storage; // NOLINT
+
+    b | start() | add_segment(0)
+      | add_random_batch(0, 10, maybe_compress_batches::yes)
+      | add_random_batch(10, 10, maybe_compress_batches::yes);
+    auto& impl = b.get_disk_log_impl();
+
+    auto first = read_range(b, model::offset(0), model::offset(9));
+    BOOST_REQUIRE(!first.empty());
+    // the finished reader was parked, keyed by the next offset
+    BOOST_REQUIRE_EQUAL(impl.reader_cache().size(), 1);
+
+    auto second = read_range(b, model::offset(10), model::offset(19));
+    BOOST_REQUIRE(!second.empty());
+    BOOST_REQUIRE_EQUAL(second.front().base_offset(), model::offset(10));
+    BOOST_REQUIRE_EQUAL(impl.get_probe().reader_cache_hits(), 1);
+    BOOST_REQUIRE_EQUAL(impl.reader_cache().size(), 1);
+
+    b | stop();
+}
+
+FIXTURE_TEST(truncate_evicts_cached_readers, log_builder_fixture) {
+    using namespace storage; // NOLINT
+
+    b | start() | add_segment(0)
+      | add_random_batch(0, 10, maybe_compress_batches::yes)
+      | add_random_batch(10, 10, maybe_compress_batches::yes);
+    auto& impl = b.get_disk_log_impl();
+
+    auto first = read_range(b, model::offset(0), model::offset(9));
+    BOOST_REQUIRE_EQUAL(impl.reader_cache().size(), 1);
+
+    b.truncate(model::offset(10)).get();
+    BOOST_REQUIRE_EQUAL(impl.reader_cache().size(), 0);
+
+    // the log is still fully readable after eviction
+    auto batches = read_range(b, model::offset(0), model::offset(9));
+    BOOST_REQUIRE(!batches.empty());
+    BOOST_REQUIRE_EQUAL(batches.back().last_offset(), model::offset(9));
+
+    b | stop();
+}
+
+FIXTURE_TEST(evict_all_fences_in_flight_readers, log_builder_fixture) {
+    using namespace storage; // NOLINT
+
+    b | start() | add_segment(0)
+      | add_random_batch(0, 10, maybe_compress_batches::yes)
+      | add_random_batch(10, 10, maybe_compress_batches::yes);
+    auto& impl = b.get_disk_log_impl();
+
+    auto first = read_range(b, model::offset(0), model::offset(9));
+    BOOST_REQUIRE_EQUAL(impl.reader_cache().size(), 1);
+
+    // take the parked reader out as a fetch would
+    auto reader = impl.reader_cache().get(storage::log_reader_config(
+      model::offset(10), model::offset(19), ss::default_priority_class()));
+    BOOST_REQUIRE(reader.has_value());
+
+    // eviction (e.g. ahead of a truncation) while the fetch is in flight
+    impl.reader_cache().evict_all().get();
+
+    auto batches = model::consume_reader_to_memory(
+                     std::move(*reader), model::no_timeout)
+                     .get0();
+    BOOST_REQUIRE(!batches.empty());
+    // the fenced reader must close rather than re-park with its old lease
+    BOOST_REQUIRE_EQUAL(impl.reader_cache().size(), 0);
+
+    b | stop();
+}
+
+FIXTURE_TEST(no_stale_reads_across_segment_roll, log_builder_fixture) {
+    using namespace storage; // NOLINT
+
+    b | start() | add_segment(0)
+      | add_random_batch(0, 10, maybe_compress_batches::yes);
+    auto& impl = b.get_disk_log_impl();
+
+    auto first = read_range(b, model::offset(0), model::offset(9));
+    BOOST_REQUIRE_EQUAL(impl.reader_cache().size(), 1);
+
+    // data at offset 10 lands in a segment the cached reader's lease does
+    // not cover; the cache must not serve the stale reader for it
+    b | add_segment(10)
+      | add_random_batch(10, 10, maybe_compress_batches::yes);
+
+    auto batches = read_range(b, model::offset(10), model::offset(19));
+    BOOST_REQUIRE(!batches.empty());
+    BOOST_REQUIRE_EQUAL(batches.front().base_offset(), model::offset(10));
+    BOOST_REQUIRE_EQUAL(impl.get_probe().reader_cache_hits(), 0);
+
+    b | stop();
+}
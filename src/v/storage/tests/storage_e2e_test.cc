@@ -22,6 +22,7 @@
 #include "storage/tests/utils/disk_log_builder.h"
 #include "storage/tests/utils/random_batch.h"
 #include "storage/types.h"
+#include "utils/directory_walker.h"
 
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/sleep.hh>
@@ -1343,3 +1344,82 @@ FIXTURE_TEST(many_segment_locking, storage_test_fixture) {
         BOOST_REQUIRE(locks.size() == segments.size());
     }
 }
+
+FIXTURE_TEST(test_in_memory_topic_override, storage_test_fixture) {
+    // a topic level override selects the in-memory backend even when the
+    // log manager is configured for disk storage
+    storage::log_manager mgr = make_log_manager();
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto ntp = model::ntp("default", "ephemeral", 0);
+    auto overrides
+      = std::make_unique<storage::ntp_config::default_overrides>();
+    overrides->in_memory = true;
+    auto ntp_cfg = storage::ntp_config(
+      ntp, mgr.config().base_dir, std::move(overrides));
+    auto work_dir = ntp_cfg.work_directory();
+    auto log = mgr.manage(std::move(ntp_cfg)).get0();
+    auto headers = append_random_batches(log, 5);
+    log.flush().get0();
+    auto batches = read_and_validate_all_batches(log);
+    BOOST_REQUIRE_EQUAL(headers.size(), batches.size());
+    // no segment files are ever written for an in-memory partition
+    size_t files = 0;
+    directory_walker::walk(work_dir, [&files](ss::directory_entry) {
+        ++files;
+        return ss::now();
+    }).get0();
+    BOOST_REQUIRE_EQUAL(files, 0);
+}
+
+FIXTURE_TEST(test_lease_release_until, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    cfg.stype = storage::log_config::storage_type::disk;
+    storage::log_manager mgr = make_log_manager(cfg);
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto ntp = model::ntp("default", "test", 0);
+    auto log
+      = mgr.manage(storage::ntp_config(ntp, mgr.config().base_dir)).get0();
+    auto disk_log = get_disk_log(log);
+    append_single_record_batch(log, 20, model::term_id(1));
+    disk_log->force_roll(ss::default_priority_class()).get();
+    append_single_record_batch(log, 30, model::term_id(1));
+    disk_log->force_roll(ss::default_priority_class()).get();
+    append_single_record_batch(log, 40, model::term_id(1));
+    log.flush().get0();
+    BOOST_REQUIRE_EQUAL(disk_log->segment_count(), 3);
+
+    storage::lock_manager lm(disk_log->segments());
+    auto lease = lm.range_lock(storage::log_reader_config(
+                                 model::offset(0),
+                                 disk_log->offsets().dirty_offset,
+                                 ss::default_priority_class()))
+                   .get0();
+    BOOST_REQUIRE_EQUAL(lease->range.size(), 3);
+
+    // every leased segment is read locked, so write locking times out
+    std::vector<ss::lw_shared_ptr<storage::segment>> first{
+      lease->range.front()};
+    BOOST_REQUIRE_THROW(
+      storage::internal::write_lock_segments(
+        first, std::chrono::seconds(1), 1)
+        .get0(),
+      ss::semaphore_timed_out);
+
+    // a reader that advanced past the first segment hands its lock back
+    lease->release_until(std::next(lease->range.begin()));
+    {
+        auto locks = storage::internal::write_lock_segments(
+                       first, std::chrono::seconds(1), 1)
+                       .get0();
+        BOOST_REQUIRE_EQUAL(locks.size(), 1);
+    }
+
+    // the rest of the range stays locked
+    std::vector<ss::lw_shared_ptr<storage::segment>> second{
+      *std::next(lease->range.begin())};
+    BOOST_REQUIRE_THROW(
+      storage::internal::write_lock_segments(
+        second, std::chrono::seconds(1), 1)
+        .get0(),
+      ss::semaphore_timed_out);
+}
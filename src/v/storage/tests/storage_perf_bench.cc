@@ -0,0 +1,155 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "model/fundamental.h"
+#include "model/limits.h"
+#include "model/record.h"
+#include "storage/ntp_config.h"
+#include "storage/tests/utils/disk_log_builder.h"
+#include "storage/types.h"
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/testing/perf_tests.hh>
+
+/*
+ * Reproducible benchmarks for the storage append/read path. Each run
+ * builds a throwaway log on local disk, exercises one stage end-to-end
+ * and reports per-batch cost, so regressions in the appender, the reader
+ * or compaction show up here instead of in production. The per-iteration
+ * numbers feed the seastar perf runner's machine readable output for CI
+ * tracking.
+ */
+
+static storage::log_append_config no_fsync_append_config() {
+    return storage::log_append_config{
+      .should_fsync = storage::log_append_config::fsync::no,
+      .io_priority = ss::default_priority_class(),
+      .timeout = model::no_timeout};
+}
+
+// sustained appends of batch_count batches of records_per_batch records
+// each; one flush at the end so the measurement covers the append path,
+// not per-batch fsync
+static ss::future<size_t>
+run_append_bench(int records_per_batch, int batch_count) {
+    return ss::async([records_per_batch, batch_count] {
+        storage::disk_log_builder b;
+        b.start().get();
+        b.add_segment(model::offset(0)).get();
+        auto cfg = no_fsync_append_config();
+        int64_t offset = 0;
+        perf_tests::start_measuring_time();
+        for (int i = 0; i < batch_count; ++i) {
+            b.add_random_batch(
+               model::offset(offset),
+               records_per_batch,
+               storage::maybe_compress_batches::no,
+               model::record_batch_type(1),
+               cfg,
+               storage::disk_log_builder::should_flush_after::no)
+              .get();
+            offset += records_per_batch;
+        }
+        b.get_log().flush().get();
+        perf_tests::stop_measuring_time();
+        b.stop().get();
+        return size_t(batch_count);
+    });
+}
+
+PERF_TEST(storage_append, single_record_batches) {
+    return run_append_bench(1, 200);
+}
+
+PERF_TEST(storage_append, ten_record_batches) {
+    return run_append_bench(10, 200);
+}
+
+PERF_TEST(storage_append, hundred_record_batches) {
+    return run_append_bench(100, 50);
+}
+
+// full scan of a populated log. cold reads bypass the batch cache and go
+// through the disk parser; warm reads are served from cache entries
+// populated by a priming scan
+static ss::future<size_t> run_scan_bench(bool warm) {
+    return ss::async([warm] {
+        constexpr int batch_count = 200;
+        storage::disk_log_builder b;
+        b.start().get();
+        b.add_segment(model::offset(0)).get();
+        b.add_random_batches(model::offset(0), batch_count, false).get();
+        if (warm) {
+            b.consume().get0();
+        }
+        auto cfg = storage::log_reader_config(
+          model::offset(0),
+          model::model_limits<model::offset>::max(),
+          ss::default_priority_class());
+        cfg.skip_batch_cache = !warm;
+        perf_tests::start_measuring_time();
+        auto batches = b.consume(cfg).get0();
+        perf_tests::stop_measuring_time();
+        perf_tests::do_not_optimize(batches.size());
+        const auto read = batches.size();
+        b.stop().get();
+        return read;
+    });
+}
+
+PERF_TEST(storage_scan, cold_disk) { return run_scan_bench(false); }
+
+PERF_TEST(storage_scan, warm_batch_cache) { return run_scan_bench(true); }
+
+// end-to-end compaction of sealed segments of a compacted topic: index
+// materialization, key deduplication and segment rewrite
+PERF_TEST(storage_compaction, end_to_end) {
+    return ss::async([] {
+        constexpr int batches_per_segment = 50;
+        storage::disk_log_builder b;
+        auto overrides
+          = std::make_unique<storage::ntp_config::default_overrides>();
+        overrides->cleanup_policy_bitflags
+          = model::cleanup_policy_bitflags::compaction;
+        b.start(storage::ntp_config(
+                  storage::log_builder_ntp(),
+                  b.get_log_config().base_dir,
+                  std::move(overrides)))
+          .get();
+        auto cfg = no_fsync_append_config();
+        int64_t offset = 0;
+        for (int seg = 0; seg < 2; ++seg) {
+            b.add_segment(model::offset(offset)).get();
+            for (int i = 0; i < batches_per_segment; ++i) {
+                b.add_random_batch(
+                   model::offset(offset),
+                   10,
+                   storage::maybe_compress_batches::no,
+                   model::record_batch_type(1),
+                   cfg,
+                   storage::disk_log_builder::should_flush_after::no)
+                  .get();
+                offset += 10;
+            }
+        }
+        b.get_log().flush().get();
+        ss::abort_source as;
+        storage::compaction_config ccfg(
+          model::timestamp::min(),
+          std::nullopt,
+          ss::default_priority_class(),
+          as);
+        perf_tests::start_measuring_time();
+        b.get_log().compact(ccfg).get();
+        perf_tests::stop_measuring_time();
+        b.stop().get();
+        return size_t(2 * batches_per_segment);
+    });
+}
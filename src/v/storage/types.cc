@@ -54,12 +54,13 @@ operator<<(std::ostream& o, const ntp_config::default_overrides& v) {
     fmt::print(
       o,
       "{{compaction_strategy: {}, cleanup_policy_bitflags: {}, segment_size: "
-      "{}, retention_bytes: {}, retention_time_ms: {}}}",
+      "{}, retention_bytes: {}, retention_time_ms: {}, in_memory: {}}}",
       v.compaction_strategy,
       v.cleanup_policy_bitflags,
       v.segment_size,
       v.retention_bytes,
-      v.retention_time);
+      v.retention_time,
+      v.in_memory);
 
     return o;
 }
@@ -21,9 +21,11 @@
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/file.hh> //io_priority
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/rwlock.hh>
 #include <seastar/util/bool_class.hh>
 
+#include <functional>
 #include <optional>
 #include <vector>
 
@@ -73,6 +75,21 @@ struct append_result {
     friend std::ostream& operator<<(std::ostream& o, const append_result&);
 };
 
+/**
+ * One entry of the opt-in per-ntp I/O attribution ring, see
+ * log_config::sampled_attribution. Counters are cumulative snapshots of the
+ * probe at sampling time; consumers diff adjacent samples to recover rates.
+ */
+struct attribution_sample {
+    /// wall clock, for correlating dumps across nodes
+    ss::lowres_system_clock::time_point when;
+    uint64_t bytes_written{0};
+    uint64_t bytes_read{0};
+    uint64_t batches_written{0};
+    /// latency of the most recent append at sampling time
+    uint64_t append_latency_us{0};
+};
+
 using opt_abort_source_t
   = std::optional<std::reference_wrapper<ss::abort_source>>;
 
@@ -146,6 +163,15 @@ struct truncate_prefix_config {
  * Start and max offset are inclusive.
  */
 struct log_reader_config {
+    /// batch-level filter pushdown: evaluated against batch headers inside
+    /// the log reader, before record payloads are materialized or copied
+    /// out of the batch cache. batches it rejects are skipped exactly like
+    /// type_filter mismatches. the predicate must be cheap and side-effect
+    /// free - it runs once per batch header on the read path - and
+    /// copyable, since reader configurations are copied freely
+    using batch_predicate
+      = std::function<bool(const model::record_batch_header&)>;
+
     model::offset start_offset;
     model::offset max_offset;
     size_t min_bytes;
@@ -157,6 +183,9 @@ struct log_reader_config {
     /// it is the std::lower_bound
     std::optional<model::timestamp> first_timestamp;
 
+    /// header predicate, see batch_predicate above. empty means no filter
+    batch_predicate filter;
+
     /// abort source for read operations
     opt_abort_source_t abort_source;
 
@@ -177,6 +206,15 @@ struct log_reader_config {
     // historical read-once workloads like compaction).
     bool skip_batch_cache{false};
 
+    // minimum number of stream buffers prefetched ahead of the parser when
+    // reading from disk. readers with a large remaining byte budget (e.g.
+    // catch-up consumers) get their readahead deepened automatically up to
+    // max_readahead_count so sequential scans keep the device busy while
+    // the current window is being consumed.
+    static constexpr size_t default_readahead_count = 4;
+    static constexpr size_t max_readahead_count = 16;
+    size_t readahead_count{default_readahead_count};
+
     log_reader_config(
       model::offset start_offset,
       model::offset max_offset,
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "likely.h"
+#include "seastarx.h"
+#include "vlog.h"
+
+#include <seastar/core/chunked_fifo.hh>
+#include <seastar/core/future-util.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/util/log.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+/**
+ * Deferred-formatting log queue.
+ *
+ * vlog formats its arguments inline at the callsite, so an enabled
+ * info/debug line pays the full fmt cost on the reactor in whatever
+ * scheduling group the caller happens to run in. For hot paths that is
+ * measurable, and enabling debug logging to diagnose an incident makes
+ * the incident worse.
+ *
+ * vlog_deferred captures the arguments by value into a per-shard queue
+ * and formats them later from a background scheduling group, so the hot
+ * path pays only the copy. When the queue is full new records are
+ * dropped and counted rather than blocking the caller; a summary line
+ * is emitted once the drain catches up.
+ *
+ * Arguments are copied, so they must be copyable and cheap to copy -
+ * exactly the values one would pass to vlog anyway. Lines from one
+ * shard are emitted in submission order, but may interleave differently
+ * with synchronous vlog lines than the callsites executed.
+ */
+class async_log_queue {
+public:
+    /// per-shard bound on captured-but-unformatted records
+    static constexpr size_t max_depth = 4096;
+    /// records formatted per background task before yielding
+    static constexpr size_t max_drain_batch = 128;
+
+    static async_log_queue& instance() {
+        static thread_local async_log_queue queue;
+        return queue;
+    }
+
+    /// set the scheduling group used for formatting. global scheduling
+    /// groups are valid on every shard; call on each shard at startup.
+    void set_scheduling_group(ss::scheduling_group sg) { _sg = sg; }
+
+    template<typename... Args>
+    void submit(
+      ss::logger& log,
+      ss::log_level level,
+      const char* file,
+      int line,
+      const char* format,
+      Args&&... args) {
+        if (unlikely(_records.size() >= max_depth)) {
+            ++_dropped;
+            return;
+        }
+        _records.push_back(record{
+          .log = &log,
+          .level = level,
+          .render =
+            [file,
+             line,
+             format,
+             t = std::make_tuple(std::forward<Args>(args)...)] {
+                return std::apply(
+                  [&](const auto&... a) {
+                      return ss::sstring(fmt::format(
+                        "{}:{} - {}", file, line, fmt::format(format, a...)));
+                  },
+                  t);
+            }});
+        if (!_draining) {
+            _draining = true;
+            (void)ss::later().then([this] { return drain(); });
+        }
+    }
+
+    uint64_t dropped() const { return _dropped; }
+    size_t depth() const { return _records.size(); }
+    bool draining() const { return _draining; }
+
+private:
+    struct record {
+        ss::logger* log;
+        ss::log_level level;
+        ss::noncopyable_function<ss::sstring()> render;
+    };
+
+    ss::future<> drain() {
+        return ss::with_scheduling_group(
+                 _sg,
+                 [this] {
+                     return ss::do_until(
+                       [this] { return _records.empty(); },
+                       [this] {
+                           for (size_t i = 0;
+                                i < max_drain_batch && !_records.empty();
+                                ++i) {
+                               auto rec = std::move(_records.front());
+                               _records.pop_front();
+                               rec.log->log(rec.level, "{}", rec.render());
+                           }
+                           // returning lets the reactor preempt between
+                           // batches so a deep queue cannot hog the group
+                           return ss::now();
+                       });
+                 })
+          .finally([this] {
+              _draining = false;
+              if (auto d = _dropped - _dropped_reported; d > 0) {
+                  _dropped_reported = _dropped;
+                  static ss::logger dlog("async_log");
+                  dlog.warn(
+                    "dropped {} deferred log records under pressure", d);
+              }
+          });
+    }
+
+    ss::chunked_fifo<record> _records;
+    ss::scheduling_group _sg;
+    uint64_t _dropped{0};
+    uint64_t _dropped_reported{0};
+    bool _draining{false};
+};
+
+/// Drop-in sibling of vlog for hot paths: the level is checked inline
+/// and formatting is deferred to the background scheduling group.
+///
+///    vlog_deferred(stlog, debug, "closing segment {}", path);
+///
+// NOLINTNEXTLINE
+#define vlog_deferred(log, lvl, fmt, args...)                                  \
+    do {                                                                       \
+        if ((log).is_enabled(ss::log_level::lvl)) {                            \
+            async_log_queue::instance().submit(                                \
+              (log),                                                           \
+              ss::log_level::lvl,                                              \
+              (const char*)&__FILE__[vlog_internal::log_basename_start<        \
+                vlog_internal::basename_index(__FILE__)>::value],              \
+              __LINE__,                                                        \
+              fmt,                                                             \
+              ##args);                                                         \
+        }                                                                      \
+    } while (0)
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "hashing/xx.h"
+#include "vassert.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief small fixed-size bloom filter over byte strings.
+ *
+ * Uses double hashing (Kirsch-Mitzenmacher) over a single xxhash64 of the
+ * input, so adds and queries cost one hash regardless of the number of
+ * probes. There is no removal; saturation only raises the false positive
+ * rate, it never produces false negatives.
+ */
+class bloom_filter {
+public:
+    explicit bloom_filter(size_t num_bits, uint32_t num_hashes = 2)
+      : _num_bits(num_bits)
+      , _num_hashes(num_hashes)
+      , _bits((num_bits + word_bits - 1) / word_bits, 0) {
+        vassert(num_bits > 0, "bloom filter must have at least one bit");
+        vassert(num_hashes > 0, "bloom filter must probe at least once");
+    }
+
+    void add(const char* data, size_t size) {
+        const uint64_t h = xxhash_64(data, size);
+        const uint64_t delta = (h >> 32U) | 1U; // odd => full period
+        for (uint32_t i = 0; i < _num_hashes; ++i) {
+            set_bit((h + i * delta) % _num_bits);
+        }
+        ++_approx_count;
+    }
+
+    /// may return true for items never added; never returns false for
+    /// items that were added
+    bool maybe_contains(const char* data, size_t size) const {
+        const uint64_t h = xxhash_64(data, size);
+        const uint64_t delta = (h >> 32U) | 1U;
+        for (uint32_t i = 0; i < _num_hashes; ++i) {
+            if (!test_bit((h + i * delta) % _num_bits)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void clear() {
+        std::fill(_bits.begin(), _bits.end(), 0);
+        _approx_count = 0;
+    }
+
+    /// number of calls to add(); an upper bound on distinct items
+    size_t approx_count() const { return _approx_count; }
+    size_t memory_usage() const { return _bits.size() * sizeof(uint64_t); }
+
+private:
+    static constexpr size_t word_bits = 64;
+
+    void set_bit(uint64_t i) {
+        _bits[i / word_bits] |= uint64_t(1) << (i % word_bits);
+    }
+    bool test_bit(uint64_t i) const {
+        return _bits[i / word_bits] & (uint64_t(1) << (i % word_bits));
+    }
+
+    size_t _num_bits;
+    uint32_t _num_hashes;
+    size_t _approx_count{0};
+    std::vector<uint64_t> _bits;
+};
@@ -0,0 +1,219 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/cpu_profiler.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <fmt/format.h>
+
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace profiling {
+
+/// the profiler owning the calling reactor thread, consulted by the
+/// signal handler. set while that shard's profiler is running
+static thread_local cpu_profiler* active_profiler = nullptr;
+
+namespace {
+/// blocks SIGPROF on the calling thread for the scope so the handler
+/// cannot observe or rotate the ring mid-update
+class sigprof_guard {
+public:
+    sigprof_guard() noexcept {
+        sigset_t set;
+        ::sigemptyset(&set);
+        ::sigaddset(&set, SIGPROF);
+        ::pthread_sigmask(SIG_BLOCK, &set, &_old);
+    }
+    sigprof_guard(const sigprof_guard&) = delete;
+    sigprof_guard& operator=(const sigprof_guard&) = delete;
+    ~sigprof_guard() noexcept {
+        ::pthread_sigmask(SIG_SETMASK, &_old, nullptr);
+    }
+
+private:
+    sigset_t _old;
+};
+} // namespace
+
+cpu_profiler& cpu_profiler::shard_local() {
+    static thread_local cpu_profiler p;
+    return p;
+}
+
+cpu_profiler::~cpu_profiler() noexcept { stop(); }
+
+void cpu_profiler::on_sigprof(int) {
+    if (auto* p = active_profiler) {
+        p->record();
+    }
+}
+
+void cpu_profiler::record() noexcept {
+    // async-signal context: the ring is preallocated and backtrace(3)
+    // was primed by start(), so nothing here allocates. the first
+    // frames are this handler and the kernel signal trampoline; skip
+    // them so stacks begin at the interrupted frame
+    constexpr int skip = 2;
+    std::array<void*, max_frames + skip> raw{};
+    int n = ::backtrace(raw.data(), raw.size());
+    auto& s = _ring[_taken % ring_capacity];
+    s.depth = 0;
+    for (int i = skip; i < n && s.depth < max_frames; ++i) {
+        s.frames[s.depth++] = raw[i];
+    }
+    ++_taken;
+}
+
+void cpu_profiler::start(std::chrono::milliseconds period) {
+    if (_running) {
+        return;
+    }
+    if (period.count() <= 0) {
+        throw std::invalid_argument(
+          fmt::format("invalid profiler period: {}ms", period.count()));
+    }
+    // the first backtrace(3) call loads the unwinder library, which is
+    // not async-signal-safe; prime it here, outside the handler
+    void* self = nullptr;
+    ::backtrace(&self, 1);
+
+    _ring.assign(ring_capacity, sample{});
+    _taken = 0;
+
+    struct sigaction sa {};
+    sa.sa_handler = &cpu_profiler::on_sigprof;
+    ::sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    if (::sigaction(SIGPROF, &sa, nullptr) != 0) {
+        throw std::runtime_error(fmt::format(
+          "installing SIGPROF handler failed: errno {}", errno));
+    }
+    active_profiler = this;
+
+    // deliver SIGPROF to this reactor thread only, driven by its CPU
+    // clock so time spent idle takes no samples
+    struct sigevent sev {};
+    sev.sigev_notify = SIGEV_THREAD_ID;
+    sev.sigev_signo = SIGPROF;
+    // NOLINTNEXTLINE: glibc spells sigev_notify_thread_id this way
+    sev._sigev_un._tid = static_cast<pid_t>(::syscall(SYS_gettid));
+    if (::timer_create(CLOCK_THREAD_CPUTIME_ID, &sev, &_timer) != 0) {
+        active_profiler = nullptr;
+        throw std::runtime_error(
+          fmt::format("creating profiler timer failed: errno {}", errno));
+    }
+    struct itimerspec its {};
+    its.it_interval.tv_sec = period.count() / 1000;
+    its.it_interval.tv_nsec = (period.count() % 1000) * 1000000;
+    its.it_value = its.it_interval;
+    if (::timer_settime(_timer, 0, &its, nullptr) != 0) {
+        ::timer_delete(_timer);
+        active_profiler = nullptr;
+        throw std::runtime_error(
+          fmt::format("arming profiler timer failed: errno {}", errno));
+    }
+    _running = true;
+}
+
+void cpu_profiler::stop() noexcept {
+    if (!_running) {
+        return;
+    }
+    // a final tick may already be pending; keep it blocked until the
+    // handler has been detached
+    sigprof_guard guard;
+    ::timer_delete(_timer);
+    active_profiler = nullptr;
+    _running = false;
+}
+
+size_t cpu_profiler::sample_count() const noexcept {
+    return std::min(_taken, ring_capacity);
+}
+
+namespace {
+ss::sstring symbolize(
+  void* addr, absl::flat_hash_map<void*, ss::sstring>& cache) {
+    auto it = cache.find(addr);
+    if (it != cache.end()) {
+        return it->second;
+    }
+    // fall back to the raw address for frames without a symbol
+    ss::sstring name = fmt::format("{}", addr);
+    char** symbols = ::backtrace_symbols(&addr, 1);
+    if (symbols != nullptr) {
+        // format is "binary(mangled+0x1f) [0x...]"
+        std::string_view line(symbols[0]);
+        auto open = line.find('(');
+        auto plus = line.find('+', open == std::string_view::npos ? 0 : open);
+        if (
+          open != std::string_view::npos && plus != std::string_view::npos
+          && plus > open + 1) {
+            std::string mangled(line.substr(open + 1, plus - open - 1));
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(
+              mangled.c_str(), nullptr, nullptr, &status);
+            name = status == 0 ? ss::sstring(demangled)
+                               : ss::sstring(mangled);
+            // NOLINTNEXTLINE: __cxa_demangle output must be free()d
+            std::free(demangled);
+        }
+        // NOLINTNEXTLINE: backtrace_symbols output must be free()d
+        std::free(symbols);
+    }
+    // the fold separator is part of the output format, scrub it
+    std::replace(name.begin(), name.end(), ';', ':');
+    cache.emplace(addr, name);
+    return name;
+}
+} // namespace
+
+ss::sstring cpu_profiler::folded_stacks() const {
+    // keep a running profiler from rotating the ring mid-read
+    sigprof_guard guard;
+    const size_t held = sample_count();
+    // fold first so each distinct stack is symbolized and emitted once
+    absl::flat_hash_map<ss::sstring, size_t> folded;
+    absl::flat_hash_map<void*, ss::sstring> cache;
+    for (size_t i = 0; i < held; ++i) {
+        const auto& s = _ring[i];
+        if (s.depth == 0) {
+            continue;
+        }
+        ss::sstring line;
+        // backtrace is innermost-first, folded stacks are outermost-first
+        for (size_t f = s.depth; f-- > 0;) {
+            if (!line.empty()) {
+                line += ";";
+            }
+            line += symbolize(s.frames[f], cache);
+        }
+        ++folded[line];
+    }
+    ss::sstring out;
+    for (const auto& [stack, count] : folded) {
+        out += stack;
+        out += fmt::format(" {}\n", count);
+    }
+    return out;
+}
+
+} // namespace profiling
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/sstring.hh>
+
+#include <array>
+#include <chrono>
+#include <ctime>
+#include <vector>
+
+namespace profiling {
+
+/**
+ * Shard-local sampled CPU profiler.
+ *
+ * While running, a POSIX timer bound to the reactor thread's CPU clock
+ * delivers SIGPROF at the configured period and the handler walks the
+ * interrupted stack into a fixed ring of raw return addresses. Dumping
+ * symbolizes the addresses and folds identical stacks into the
+ * "outermost;...;leaf count" lines that flamegraph tooling consumes.
+ *
+ * The timer ticks on on-CPU time, so an idle shard takes no samples and
+ * the overhead while enabled is bounded by the sample period; a profiler
+ * that was never started costs nothing.
+ */
+class cpu_profiler {
+public:
+    /// frames kept per sample, deeper stacks are truncated
+    static constexpr size_t max_frames = 32;
+    /// samples retained per shard before the oldest are overwritten.
+    /// the ring is ~1MiB and is allocated on first start
+    static constexpr size_t ring_capacity = 4096;
+    static constexpr auto default_period = std::chrono::milliseconds(10);
+
+    cpu_profiler() noexcept = default;
+    cpu_profiler(const cpu_profiler&) = delete;
+    cpu_profiler& operator=(const cpu_profiler&) = delete;
+    cpu_profiler(cpu_profiler&&) = delete;
+    cpu_profiler& operator=(cpu_profiler&&) = delete;
+    ~cpu_profiler() noexcept;
+
+    /// begin sampling the calling reactor thread every period of on-CPU
+    /// time, discarding samples from any previous run. no-op when
+    /// already running
+    void start(std::chrono::milliseconds period = default_period);
+    /// stop sampling. collected samples remain available for dumping
+    void stop() noexcept;
+    bool running() const noexcept { return _running; }
+
+    /// samples currently held in the ring, at most ring_capacity
+    size_t sample_count() const noexcept;
+    /// samples taken since the last start, including overwritten ones
+    size_t samples_taken() const noexcept { return _taken; }
+
+    /// collapse the collected stacks into flamegraph collapsed-stack
+    /// format: one "outermost;...;leaf count" line per distinct stack
+    ss::sstring folded_stacks() const;
+
+    static cpu_profiler& shard_local();
+
+private:
+    struct sample {
+        std::array<void*, max_frames> frames;
+        size_t depth{0};
+    };
+
+    static void on_sigprof(int);
+    void record() noexcept;
+
+    bool _running{false};
+    timer_t _timer{};
+    std::vector<sample> _ring;
+    size_t _taken{0};
+};
+
+} // namespace profiling
@@ -11,12 +11,12 @@
 
 #pragma once
 #include "seastarx.h"
+#include "utils/timing_wheel.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/shared_future.hh>
-#include <seastar/core/timer.hh>
 
 #include <system_error>
 
@@ -60,7 +60,10 @@ public:
                   }
                   unlink_abort_source();
               });
-            _timer.arm(timeout);
+            // timeouts from every promise on this shard share one timing
+            // wheel instead of each occupying a slot in the reactor's
+            // timer heap
+            timing_wheel<Clock>::shard_local().arm(_timer, timeout);
         }
 
         auto f = _promise.get_shared_future();
@@ -106,6 +109,6 @@ private:
     }
 
     ss::shared_promise<T> _promise;
-    ss::timer<Clock> _timer;
+    typename timing_wheel<Clock>::entry _timer;
     ss::abort_source::subscription _sub;
 };
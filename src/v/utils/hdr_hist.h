@@ -58,11 +58,18 @@ public:
         }
         measurement(const measurement&) = delete;
         measurement& operator=(const measurement&) = delete;
+        // moving a measurement transfers its probe list membership, so
+        // measurements can be held by value instead of behind a unique_ptr
         measurement(measurement&& o) noexcept
           : _detached(o._detached)
           , _trace(o._trace)
           , _h(o._h)
           , _begin_t(o._begin_t) {
+            if (!_detached) {
+                auto& probes = _h.get()._probes;
+                probes.erase(probes.iterator_to(o));
+                probes.push_back(*this);
+            }
             o.detach_hdr_hist();
         }
         measurement& operator=(measurement&& o) noexcept {
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include <iostream>
+#include <system_error>
+
+/// \brief usage: vlog(log.trace, "replicate failed: {}", lazy::msg(ec));
+///
+/// std::error_category::message() returns a std::string, so passing
+/// `ec.message()` to a logger allocates on every call - including when
+/// the log level is disabled, because arguments are evaluated at the
+/// call site. This wrapper holds only the error_code itself and renders
+/// the message at format time, i.e. only when the line is actually
+/// emitted.
+namespace lazy {
+struct msg {
+    explicit msg(std::error_code e) noexcept
+      : ec(e) {}
+    std::error_code ec;
+    friend std::ostream& operator<<(std::ostream& o, const msg& m) {
+        return o << m.ec.message();
+    }
+};
+} // namespace lazy
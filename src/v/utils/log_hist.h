@@ -0,0 +1,130 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/bitops.hh>
+#include <seastar/core/metrics_types.hh>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+/**
+ * A cheap fixed-bucket logarithmic histogram for hot-path instrumentation.
+ *
+ * Buckets double from an upper bound of 10 - the exact shape
+ * hdr_hist::seastar_histogram_logform reports at scrape time - but
+ * record() is two additions and one array increment instead of an
+ * hdr_histogram update, and a measurement is a plain value instead of a
+ * heap-allocated list-linked probe. The cumulative form prometheus wants
+ * is only computed when the histogram is scraped.
+ *
+ * One instance lives per core like any other probe member; values above
+ * the last bucket bound are clamped into it (and always included in
+ * sample_count/sample_sum).
+ */
+class log_hist {
+public:
+    using clock_type = std::chrono::high_resolution_clock;
+    static constexpr size_t num_buckets = 26;
+    static constexpr uint64_t first_upper_bound = 10;
+
+    /// \brief move-only duration tracker, records on destruction.
+    /// the histogram must outlive the measurement
+    class measurement {
+    public:
+        explicit measurement(log_hist& h)
+          : _h(&h)
+          , _begin_t(clock_type::now()) {}
+        measurement(const measurement&) = delete;
+        measurement& operator=(const measurement&) = delete;
+        measurement(measurement&& o) noexcept
+          : _h(std::exchange(o._h, nullptr))
+          , _begin_t(o._begin_t) {}
+        measurement& operator=(measurement&& o) noexcept {
+            if (this != &o) {
+                this->~measurement();
+                new (this) measurement(std::move(o));
+            }
+            return *this;
+        }
+        ~measurement() noexcept {
+            if (_h) {
+                _h->record(std::chrono::duration_cast<std::chrono::microseconds>(
+                             clock_type::now() - _begin_t)
+                             .count());
+            }
+        }
+
+        /// drop the measurement without recording it
+        void cancel() { _h = nullptr; }
+
+    private:
+        log_hist* _h;
+        clock_type::time_point _begin_t;
+    };
+
+    void record(uint64_t value) {
+        ++_sample_count;
+        _sample_sum += value;
+        ++_counts[bucket_index(value)];
+    }
+
+    measurement auto_measure() { return measurement(*this); }
+
+    log_hist& operator+=(const log_hist& o) {
+        for (size_t i = 0; i < num_buckets; ++i) {
+            _counts[i] += o._counts[i];
+        }
+        _sample_count += o._sample_count;
+        _sample_sum += o._sample_sum;
+        return *this;
+    }
+
+    uint64_t sample_count() const { return _sample_count; }
+    uint64_t sample_sum() const { return _sample_sum; }
+
+    ss::metrics::histogram seastar_histogram_logform() const {
+        ss::metrics::histogram sshist;
+        sshist.buckets.resize(num_buckets);
+        sshist.sample_count = _sample_count;
+        sshist.sample_sum = static_cast<double>(_sample_sum);
+        uint64_t cumulative = 0;
+        uint64_t bound = first_upper_bound;
+        for (size_t i = 0; i < num_buckets; ++i) {
+            cumulative += _counts[i];
+            sshist.buckets[i].count = cumulative;
+            sshist.buckets[i].upper_bound = static_cast<double>(bound);
+            bound *= 2;
+        }
+        return sshist;
+    }
+
+private:
+    friend measurement;
+
+    // smallest bucket whose upper bound covers the value
+    static size_t bucket_index(uint64_t v) {
+        if (v <= first_upper_bound) {
+            return 0;
+        }
+        const uint64_t q = (v + first_upper_bound - 1) / first_upper_bound;
+        return std::min<size_t>(ss::log2ceil(q), num_buckets - 1);
+    }
+
+    std::array<uint64_t, num_buckets> _counts{};
+    uint64_t _sample_count{0};
+    uint64_t _sample_sum{0};
+};
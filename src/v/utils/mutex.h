@@ -10,10 +10,14 @@
  */
 
 #pragma once
+#include "likely.h"
 #include "seastarx.h"
+#include "utils/mutex_stats.h"
 
 #include <seastar/core/semaphore.hh>
 
+#include <chrono>
+
 /*
  * A traditional mutex. If you are trying to count things or need timeouts, you
  * probably want to stick with a standard semaphore. The primary motivation for
@@ -37,9 +41,23 @@ public:
     mutex()
       : _sem(1) {}
 
+    /*
+     * Instrumented mutex: acquisitions that block are sampled into the
+     * shard-local contention entry registered under the given name, which
+     * must be a string literal. Instances sharing a name aggregate into
+     * one entry; see mutex_stats.
+     */
+    explicit mutex(const char* name)
+      : _sem(1)
+      , _stats(&mutex_stats::shard_local().register_mutex(name)) {}
+
     template<typename Func>
     auto with(Func&& func) noexcept {
-        return ss::with_semaphore(_sem, 1, std::forward<Func>(func));
+        return get_units().then(
+          [func = std::forward<Func>(func)](auto units) mutable {
+              return ss::futurize_invoke(std::forward<Func>(func))
+                .finally([units = std::move(units)] {});
+          });
     }
 
     template<typename Func>
@@ -56,8 +74,37 @@ public:
           });
     }
 
-    auto get_units() noexcept { return ss::get_units(_sem, 1); }
+    ss::future<ss::semaphore_units<>> get_units() noexcept {
+        if (likely(_stats == nullptr)) {
+            return ss::get_units(_sem, 1);
+        }
+        return instrumented_get_units();
+    }
+
+    /// \brief true if the mutex can be taken without waiting.
+    bool ready() const noexcept { return _sem.available_units() > 0; }
 
 private:
+    ss::future<ss::semaphore_units<>> instrumented_get_units() {
+        ++_stats->acquisitions;
+        // uncontended or unsampled acquisitions never touch the clock
+        if (ready() || !mutex_stats::shard_local().should_sample()) {
+            return ss::get_units(_sem, 1);
+        }
+        ++_stats->waiting;
+        return ss::get_units(_sem, 1).then_wrapped(
+          [this, start = std::chrono::steady_clock::now()](
+            ss::future<ss::semaphore_units<>> f) {
+              --_stats->waiting;
+              if (!f.failed()) {
+                  _stats->record_wait(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - start));
+              }
+              return f;
+          });
+    }
+
     ss::semaphore _sem;
+    mutex_stats::entry* _stats{nullptr};
 };
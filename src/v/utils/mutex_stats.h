@@ -0,0 +1,132 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "prometheus/prometheus_sanitize.h"
+#include "seastarx.h"
+#include "utils/hdr_hist.h"
+
+#include <seastar/core/metrics.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sstring.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+/**
+ * Shard-local contention statistics for named mutexes.
+ *
+ * A mutex constructed with a name registers into (or joins) the entry of
+ * that name here; every instance sharing the name aggregates into one
+ * wait histogram, which keeps per-partition locks like raft's op_lock at
+ * a bounded metric cardinality. Only acquisitions that would block are
+ * timed, and those 1-in-N; with sampling off (the default) an
+ * instrumented mutex costs one counter increment and two branches per
+ * acquisition, an uninstrumented one a null check.
+ */
+class mutex_stats {
+public:
+    struct entry {
+        explicit entry(const char* n)
+          : name(n) {}
+
+        const char* name;
+        /// microseconds waited by sampled acquisitions that had to queue
+        hdr_hist wait_hist;
+        uint64_t acquisitions{0};
+        uint64_t sampled_waits{0};
+        uint64_t total_wait_us{0};
+        uint64_t max_wait_us{0};
+        /// sampled acquisitions currently queued
+        int64_t waiting{0};
+        ss::metrics::metric_groups metrics;
+
+        void record_wait(std::chrono::microseconds wait) {
+            const auto us = static_cast<uint64_t>(wait.count());
+            wait_hist.record(std::max<uint64_t>(us, 1));
+            ++sampled_waits;
+            total_wait_us += us;
+            max_wait_us = std::max(max_wait_us, us);
+        }
+    };
+
+    static mutex_stats& shard_local() {
+        static thread_local mutex_stats s;
+        return s;
+    }
+
+    /// one in rate blocking acquisitions is timed; 0 disables sampling
+    void set_sampling_rate(uint32_t rate) { _rate = rate; }
+    uint32_t sampling_rate() const { return _rate; }
+
+    bool should_sample() { return _rate != 0 && ++_counter % _rate == 0; }
+
+    entry& register_mutex(const char* name) {
+        auto it = _entries.find(name);
+        if (it != _entries.end()) {
+            return *it->second;
+        }
+        auto e = std::make_unique<entry>(name);
+        setup_metrics(*e);
+        auto [eit, inserted] = _entries.emplace(
+          ss::sstring(name), std::move(e));
+        return *eit->second;
+    }
+
+    /// entries ordered by accumulated sampled wait, worst first
+    std::vector<const entry*> ranked() const {
+        std::vector<const entry*> out;
+        out.reserve(_entries.size());
+        for (const auto& [name, e] : _entries) {
+            out.push_back(e.get());
+        }
+        std::sort(out.begin(), out.end(), [](const entry* a, const entry* b) {
+            return a->total_wait_us > b->total_wait_us;
+        });
+        return out;
+    }
+
+private:
+    void setup_metrics(entry& e) {
+        namespace sm = ss::metrics;
+        const std::vector<sm::label_instance> labels = {
+          sm::label("mutex")(e.name)};
+        e.metrics.add_group(
+          prometheus_sanitize::metrics_name("utils:mutex"),
+          {
+            sm::make_derive(
+              "acquisitions",
+              [&e] { return e.acquisitions; },
+              sm::description("Total acquisitions of mutexes with this name"),
+              labels),
+            sm::make_gauge(
+              "waiting",
+              [&e] { return e.waiting; },
+              sm::description("Sampled acquisitions currently queued"),
+              labels),
+            sm::make_histogram(
+              "wait_us",
+              [&e] { return e.wait_hist.seastar_histogram_logform(); },
+              sm::description(
+                "Microseconds sampled acquisitions waited for the mutex"),
+              labels),
+          });
+    }
+
+    absl::flat_hash_map<ss::sstring, std::unique_ptr<entry>> _entries;
+    uint32_t _rate{0};
+    uint64_t _counter{0};
+};
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/lowres_clock.hh>
+
+#include <array>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+namespace tracing {
+
+/**
+ * Shard-local sampled latency tracer.
+ *
+ * A sampled request carries a move-only token through its processing
+ * stages; each stage() call records the time elapsed since the trace
+ * started, and when the token is destroyed the completed trace lands in
+ * a fixed ring that the admin API can dump. Sampling is 1-in-N behind a
+ * single counter increment, so the untraced fast path costs one branch.
+ *
+ * Tokens commit into the tracer of the shard they are destroyed on; keep
+ * a trace on one shard for a coherent timeline.
+ */
+class stage_tracer {
+public:
+    /// traces retained per shard; old traces are overwritten
+    static constexpr size_t ring_capacity = 256;
+    /// stage marks a single trace can hold, extra marks are dropped
+    static constexpr size_t max_stages = 8;
+
+    struct stage {
+        const char* name{nullptr};
+        /// time since the trace started
+        std::chrono::microseconds elapsed{0};
+    };
+
+    struct completed_trace {
+        const char* op{nullptr};
+        /// wall clock, for correlating dumps across nodes
+        ss::lowres_system_clock::time_point started_at;
+        std::chrono::microseconds total{0};
+        std::array<stage, max_stages> stages;
+        size_t stage_count{0};
+    };
+
+    class token {
+    public:
+        token() noexcept = default;
+        token(token&& o) noexcept
+          : _tracer(std::exchange(o._tracer, nullptr))
+          , _trace(o._trace)
+          , _start(o._start) {}
+        token& operator=(token&& o) noexcept {
+            if (this != &o) {
+                finish();
+                _tracer = std::exchange(o._tracer, nullptr);
+                _trace = o._trace;
+                _start = o._start;
+            }
+            return *this;
+        }
+        token(const token&) = delete;
+        token& operator=(const token&) = delete;
+        ~token() noexcept { finish(); }
+
+        /// true when this request was selected for tracing
+        explicit operator bool() const noexcept { return _tracer != nullptr; }
+
+        /// record the time since the trace started under the given name.
+        /// the name must be a string literal, it is kept by pointer
+        void stage(const char* name) {
+            if (_tracer == nullptr || _trace.stage_count >= max_stages) {
+                return;
+            }
+            _trace.stages[_trace.stage_count++] = {name, since_start()};
+        }
+
+    private:
+        friend class stage_tracer;
+        token(stage_tracer* t, const char* op) noexcept
+          : _tracer(t)
+          , _start(std::chrono::steady_clock::now()) {
+            _trace.op = op;
+            _trace.started_at = ss::lowres_system_clock::now();
+        }
+
+        std::chrono::microseconds since_start() const {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - _start);
+        }
+
+        void finish() noexcept {
+            if (_tracer == nullptr) {
+                return;
+            }
+            _trace.total = since_start();
+            _tracer->commit(_trace);
+            _tracer = nullptr;
+        }
+
+        stage_tracer* _tracer{nullptr};
+        completed_trace _trace;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    /// one in rate requests get a trace; 0 disables sampling entirely
+    void set_sampling_rate(uint32_t rate) { _rate = rate; }
+    uint32_t sampling_rate() const { return _rate; }
+
+    token maybe_sample(const char* op) {
+        if (_rate == 0 || ++_counter % _rate != 0) {
+            return token{};
+        }
+        return token(this, op);
+    }
+
+    /// snapshot of the ring, oldest trace first
+    std::vector<completed_trace> dump() const {
+        std::vector<completed_trace> out;
+        out.reserve(_ring.size());
+        if (_ring.size() < ring_capacity) {
+            out.assign(_ring.begin(), _ring.end());
+            return out;
+        }
+        for (size_t i = 0; i < _ring.size(); ++i) {
+            out.push_back(_ring[(_head + i) % _ring.size()]);
+        }
+        return out;
+    }
+
+    static stage_tracer& shard_local() {
+        static thread_local stage_tracer t;
+        return t;
+    }
+
+private:
+    void commit(const completed_trace& t) {
+        if (_ring.size() < ring_capacity) {
+            _ring.push_back(t);
+        } else {
+            _ring[_head] = t;
+        }
+        _head = (_head + 1) % ring_capacity;
+    }
+
+    uint32_t _rate{0};
+    uint64_t _counter{0};
+    std::vector<completed_trace> _ring;
+    size_t _head{0};
+};
+
+} // namespace tracing
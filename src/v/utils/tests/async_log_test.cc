@@ -0,0 +1,64 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/async_log.h"
+
+#include <seastar/core/future-util.hh>
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/log.hh>
+
+static ss::logger tlog("async_log_test");
+
+static void drain_queue() {
+    auto& q = async_log_queue::instance();
+    while (q.depth() > 0 || q.draining()) {
+        ss::later().get();
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(submit_defers_and_drains_in_background) {
+    auto& q = async_log_queue::instance();
+    drain_queue();
+
+    tlog.set_level(ss::log_level::debug);
+    for (int i = 0; i < 10; ++i) {
+        vlog_deferred(tlog, debug, "deferred record {}", i);
+    }
+    // nothing was formatted on this task; records wait in the queue
+    BOOST_REQUIRE_EQUAL(q.depth(), 10);
+    drain_queue();
+    BOOST_REQUIRE_EQUAL(q.depth(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(disabled_level_skips_capture) {
+    auto& q = async_log_queue::instance();
+    drain_queue();
+
+    tlog.set_level(ss::log_level::info);
+    vlog_deferred(tlog, debug, "never captured {}", 1);
+    BOOST_REQUIRE_EQUAL(q.depth(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(full_queue_drops_and_counts) {
+    auto& q = async_log_queue::instance();
+    drain_queue();
+    auto dropped_before = q.dropped();
+
+    // trace is disabled so the drain discards the rendered lines instead
+    // of spamming the test output
+    tlog.set_level(ss::log_level::info);
+    for (size_t i = 0; i < async_log_queue::max_depth + 5; ++i) {
+        q.submit(
+          tlog, ss::log_level::trace, "async_log_test.cc", 1, "record {}", i);
+    }
+    BOOST_REQUIRE_EQUAL(q.depth(), async_log_queue::max_depth);
+    BOOST_REQUIRE_EQUAL(q.dropped() - dropped_before, 5);
+    drain_queue();
+    BOOST_REQUIRE_EQUAL(q.depth(), 0);
+}
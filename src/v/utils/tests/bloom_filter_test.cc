@@ -0,0 +1,55 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE utils
+#include "utils/bloom_filter.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+BOOST_AUTO_TEST_CASE(bloom_no_false_negatives) {
+    bloom_filter bf(64 * 1024);
+    for (int i = 0; i < 1000; ++i) {
+        auto k = std::string("key-") + std::to_string(i);
+        bf.add(k.data(), k.size());
+    }
+    BOOST_REQUIRE_EQUAL(bf.approx_count(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+        auto k = std::string("key-") + std::to_string(i);
+        BOOST_REQUIRE(bf.maybe_contains(k.data(), k.size()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bloom_low_false_positive_rate) {
+    // 64K bits, 1000 keys => expected fpr well below 1%
+    bloom_filter bf(64 * 1024);
+    for (int i = 0; i < 1000; ++i) {
+        auto k = std::string("key-") + std::to_string(i);
+        bf.add(k.data(), k.size());
+    }
+    int false_positives = 0;
+    for (int i = 0; i < 10000; ++i) {
+        auto k = std::string("other-") + std::to_string(i);
+        if (bf.maybe_contains(k.data(), k.size())) {
+            ++false_positives;
+        }
+    }
+    BOOST_REQUIRE_LT(false_positives, 200);
+}
+
+BOOST_AUTO_TEST_CASE(bloom_clear) {
+    bloom_filter bf(1024);
+    std::string k = "hello";
+    bf.add(k.data(), k.size());
+    BOOST_REQUIRE(bf.maybe_contains(k.data(), k.size()));
+    bf.clear();
+    BOOST_REQUIRE(!bf.maybe_contains(k.data(), k.size()));
+    BOOST_REQUIRE_EQUAL(bf.approx_count(), 0);
+}
@@ -0,0 +1,60 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/cpu_profiler.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <chrono>
+
+// burn on-CPU time so the thread-CPU-clock timer ticks; volatile keeps
+// the loop from being optimized away
+static void burn_cpu(std::chrono::milliseconds d) {
+    auto deadline = std::chrono::steady_clock::now() + d;
+    volatile uint64_t sink = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        for (int i = 0; i < 1000; ++i) {
+            sink = sink + i;
+        }
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(unused_profiler_holds_nothing) {
+    profiling::cpu_profiler p;
+    BOOST_REQUIRE(!p.running());
+    BOOST_REQUIRE_EQUAL(p.sample_count(), 0);
+    BOOST_REQUIRE_EQUAL(p.samples_taken(), 0);
+    BOOST_REQUIRE(p.folded_stacks().empty());
+    // stopping a profiler that never ran is a no-op
+    p.stop();
+}
+
+SEASTAR_THREAD_TEST_CASE(profiler_collects_samples_while_running) {
+    auto& p = profiling::cpu_profiler::shard_local();
+    p.start(std::chrono::milliseconds(1));
+    BOOST_REQUIRE(p.running());
+    // idempotent while running
+    p.start(std::chrono::milliseconds(1));
+
+    burn_cpu(std::chrono::milliseconds(200));
+    p.stop();
+    BOOST_REQUIRE(!p.running());
+
+    BOOST_REQUIRE_GT(p.samples_taken(), 0);
+    auto folded = p.folded_stacks();
+    BOOST_REQUIRE(!folded.empty());
+    // every line of the fold carries a trailing count
+    BOOST_REQUIRE_EQUAL(folded[folded.size() - 1], '\n');
+
+    // samples survive stop() but not a restart
+    auto taken = p.samples_taken();
+    p.start(std::chrono::milliseconds(100));
+    BOOST_REQUIRE_LT(p.samples_taken(), taken);
+    p.stop();
+}
@@ -0,0 +1,85 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE log_hist
+#include "utils/log_hist.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+
+BOOST_AUTO_TEST_CASE(bucket_boundaries) {
+    log_hist h;
+    // first bucket covers everything up to and including 10
+    h.record(0);
+    h.record(10);
+    // (10, 20]
+    h.record(11);
+    h.record(20);
+    // (20, 40]
+    h.record(21);
+
+    auto sshist = h.seastar_histogram_logform();
+    BOOST_REQUIRE_EQUAL(sshist.sample_count, 5);
+    BOOST_REQUIRE_EQUAL(sshist.sample_sum, 62);
+    BOOST_REQUIRE_EQUAL(sshist.buckets.size(), log_hist::num_buckets);
+    BOOST_REQUIRE_EQUAL(sshist.buckets[0].upper_bound, 10);
+    BOOST_REQUIRE_EQUAL(sshist.buckets[0].count, 2);
+    BOOST_REQUIRE_EQUAL(sshist.buckets[1].upper_bound, 20);
+    BOOST_REQUIRE_EQUAL(sshist.buckets[1].count, 4);
+    BOOST_REQUIRE_EQUAL(sshist.buckets[2].upper_bound, 40);
+    BOOST_REQUIRE_EQUAL(sshist.buckets[2].count, 5);
+    // cumulative counts carry through the padding buckets
+    BOOST_REQUIRE_EQUAL(sshist.buckets.back().count, 5);
+}
+
+BOOST_AUTO_TEST_CASE(overflow_clamps_into_last_bucket) {
+    log_hist h;
+    h.record(std::numeric_limits<uint32_t>::max());
+    auto sshist = h.seastar_histogram_logform();
+    BOOST_REQUIRE_EQUAL(sshist.sample_count, 1);
+    BOOST_REQUIRE_EQUAL(
+      sshist.buckets[log_hist::num_buckets - 2].count, 0);
+    BOOST_REQUIRE_EQUAL(sshist.buckets.back().count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(merge) {
+    log_hist a;
+    log_hist b;
+    a.record(5);
+    b.record(15);
+    b.record(1000);
+    a += b;
+    auto sshist = a.seastar_histogram_logform();
+    BOOST_REQUIRE_EQUAL(sshist.sample_count, 3);
+    BOOST_REQUIRE_EQUAL(sshist.sample_sum, 1020);
+    BOOST_REQUIRE_EQUAL(sshist.buckets[0].count, 1);
+    BOOST_REQUIRE_EQUAL(sshist.buckets[1].count, 2);
+    BOOST_REQUIRE_EQUAL(sshist.buckets.back().count, 3);
+}
+
+BOOST_AUTO_TEST_CASE(measurement_records_once) {
+    log_hist h;
+    { auto m = h.auto_measure(); }
+    BOOST_REQUIRE_EQUAL(h.sample_count(), 1);
+
+    // moved-from measurements do not double record
+    {
+        auto m = h.auto_measure();
+        auto m2 = std::move(m);
+    }
+    BOOST_REQUIRE_EQUAL(h.sample_count(), 2);
+
+    // cancelled measurements do not record
+    {
+        auto m = h.auto_measure();
+        m.cancel();
+    }
+    BOOST_REQUIRE_EQUAL(h.sample_count(), 2);
+}
@@ -0,0 +1,85 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/mutex.h"
+#include "utils/mutex_stats.h"
+
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+SEASTAR_THREAD_TEST_CASE(unnamed_mutex_registers_nothing) {
+    mutex m;
+    m.with([] {}).get();
+    BOOST_CHECK(m.ready());
+}
+
+SEASTAR_THREAD_TEST_CASE(instances_sharing_a_name_share_an_entry) {
+    auto& a = mutex_stats::shard_local().register_mutex("test::shared");
+    auto& b = mutex_stats::shard_local().register_mutex("test::shared");
+    BOOST_CHECK_EQUAL(&a, &b);
+}
+
+SEASTAR_THREAD_TEST_CASE(sampled_blocking_acquisition_records_wait) {
+    auto& stats = mutex_stats::shard_local();
+    stats.set_sampling_rate(1);
+
+    mutex m("test::contended");
+    auto& e = stats.register_mutex("test::contended");
+    const auto waits_before = e.sampled_waits;
+
+    std::optional<ss::semaphore_units<>> held = m.get_units().get0();
+    // second acquisition has to queue and is sampled
+    auto blocked = m.get_units();
+    ss::sleep(std::chrono::milliseconds(1)).get();
+    held.reset();
+    blocked.get0();
+
+    BOOST_CHECK_EQUAL(e.sampled_waits, waits_before + 1);
+    BOOST_CHECK_GT(e.total_wait_us, 0);
+    BOOST_CHECK_EQUAL(e.waiting, 0);
+
+    stats.set_sampling_rate(0);
+}
+
+SEASTAR_THREAD_TEST_CASE(sampling_off_skips_the_histogram) {
+    auto& stats = mutex_stats::shard_local();
+    stats.set_sampling_rate(0);
+
+    mutex m("test::unsampled");
+    auto& e = stats.register_mutex("test::unsampled");
+    const auto waits_before = e.sampled_waits;
+    const auto acquisitions_before = e.acquisitions;
+
+    std::optional<ss::semaphore_units<>> held = m.get_units().get0();
+    auto blocked = m.get_units();
+    held.reset();
+    blocked.get0();
+
+    BOOST_CHECK_EQUAL(e.sampled_waits, waits_before);
+    BOOST_CHECK_EQUAL(e.acquisitions, acquisitions_before + 2);
+}
+
+SEASTAR_THREAD_TEST_CASE(report_ranks_by_total_wait) {
+    auto& stats = mutex_stats::shard_local();
+    auto& loud = stats.register_mutex("test::rank_loud");
+    auto& quiet = stats.register_mutex("test::rank_quiet");
+    loud.record_wait(std::chrono::microseconds(1000));
+    quiet.record_wait(std::chrono::microseconds(1));
+
+    auto ranked = stats.ranked();
+    auto loud_it = std::find(ranked.begin(), ranked.end(), &loud);
+    auto quiet_it = std::find(ranked.begin(), ranked.end(), &quiet);
+    BOOST_REQUIRE(loud_it != ranked.end());
+    BOOST_REQUIRE(quiet_it != ranked.end());
+    BOOST_CHECK(loud_it < quiet_it);
+}
@@ -0,0 +1,98 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/stage_tracer.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+SEASTAR_THREAD_TEST_CASE(rate_zero_samples_nothing) {
+    tracing::stage_tracer t;
+    for (int i = 0; i < 100; ++i) {
+        auto tok = t.maybe_sample("op");
+        BOOST_REQUIRE(!tok);
+        // stage on an inactive token is a no-op
+        tok.stage("ignored");
+    }
+    BOOST_REQUIRE(t.dump().empty());
+}
+
+SEASTAR_THREAD_TEST_CASE(one_in_n_sampling) {
+    tracing::stage_tracer t;
+    t.set_sampling_rate(4);
+    size_t sampled = 0;
+    for (int i = 0; i < 100; ++i) {
+        auto tok = t.maybe_sample("op");
+        if (tok) {
+            sampled++;
+        }
+    }
+    BOOST_REQUIRE_EQUAL(sampled, 25);
+    BOOST_REQUIRE_EQUAL(t.dump().size(), 25);
+}
+
+SEASTAR_THREAD_TEST_CASE(stages_recorded_in_order) {
+    tracing::stage_tracer t;
+    t.set_sampling_rate(1);
+    {
+        auto tok = t.maybe_sample("produce");
+        tok.stage("first");
+        tok.stage("second");
+    }
+    auto traces = t.dump();
+    BOOST_REQUIRE_EQUAL(traces.size(), 1);
+    const auto& tr = traces[0];
+    BOOST_REQUIRE_EQUAL(tr.op, "produce");
+    BOOST_REQUIRE_EQUAL(tr.stage_count, 2);
+    BOOST_REQUIRE_EQUAL(tr.stages[0].name, "first");
+    BOOST_REQUIRE_EQUAL(tr.stages[1].name, "second");
+    BOOST_REQUIRE(tr.stages[0].elapsed <= tr.stages[1].elapsed);
+    BOOST_REQUIRE(tr.stages[1].elapsed <= tr.total);
+}
+
+SEASTAR_THREAD_TEST_CASE(extra_stages_are_dropped) {
+    tracing::stage_tracer t;
+    t.set_sampling_rate(1);
+    {
+        auto tok = t.maybe_sample("op");
+        for (size_t i = 0; i < tracing::stage_tracer::max_stages + 3; ++i) {
+            tok.stage("s");
+        }
+    }
+    auto traces = t.dump();
+    BOOST_REQUIRE_EQUAL(traces.size(), 1);
+    BOOST_REQUIRE_EQUAL(
+      traces[0].stage_count, tracing::stage_tracer::max_stages);
+}
+
+SEASTAR_THREAD_TEST_CASE(moved_from_token_does_not_commit) {
+    tracing::stage_tracer t;
+    t.set_sampling_rate(1);
+    {
+        auto tok = t.maybe_sample("op");
+        auto moved = std::move(tok);
+        BOOST_REQUIRE(!tok); // NOLINT(bugprone-use-after-move)
+        BOOST_REQUIRE(bool(moved));
+    }
+    BOOST_REQUIRE_EQUAL(t.dump().size(), 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(ring_overwrites_oldest) {
+    tracing::stage_tracer t;
+    t.set_sampling_rate(1);
+    constexpr size_t cap = tracing::stage_tracer::ring_capacity;
+    // one beyond capacity: the very first trace should be evicted
+    for (size_t i = 0; i < cap + 1; ++i) {
+        t.maybe_sample(i == 0 ? "oldest" : "newer");
+    }
+    auto traces = t.dump();
+    BOOST_REQUIRE_EQUAL(traces.size(), cap);
+    for (const auto& tr : traces) {
+        BOOST_REQUIRE_EQUAL(tr.op, "newer");
+    }
+}
@@ -0,0 +1,110 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "seastarx.h"
+#include "utils/timing_wheel.h"
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+using namespace std::chrono_literals; // NOLINT
+
+SEASTAR_THREAD_TEST_CASE(wheel_fires_after_deadline) {
+    timing_wheel<ss::lowres_clock> w(20ms);
+    bool fired = false;
+    timing_wheel<ss::lowres_clock>::entry e;
+    e.set_callback([&fired] { fired = true; });
+    w.arm(e, ss::lowres_clock::now() + 50ms);
+    BOOST_REQUIRE(e.armed());
+
+    ss::sleep(500ms).get();
+    BOOST_REQUIRE(fired);
+    BOOST_REQUIRE(!e.armed());
+    BOOST_REQUIRE(w.empty());
+}
+
+SEASTAR_THREAD_TEST_CASE(cancel_prevents_firing) {
+    timing_wheel<ss::lowres_clock> w(20ms);
+    bool fired = false;
+    timing_wheel<ss::lowres_clock>::entry e;
+    e.set_callback([&fired] { fired = true; });
+    w.arm(e, ss::lowres_clock::now() + 50ms);
+    BOOST_REQUIRE(e.cancel());
+    // a disarmed entry reports it had nothing to cancel
+    BOOST_REQUIRE(!e.cancel());
+
+    ss::sleep(500ms).get();
+    BOOST_REQUIRE(!fired);
+    BOOST_REQUIRE(w.empty());
+}
+
+SEASTAR_THREAD_TEST_CASE(rearm_replaces_previous_deadline) {
+    timing_wheel<ss::lowres_clock> w(20ms);
+    int fires = 0;
+    timing_wheel<ss::lowres_clock>::entry e;
+    e.set_callback([&fires] { ++fires; });
+    w.arm(e, ss::lowres_clock::now() + 100s);
+    w.arm(e, ss::lowres_clock::now() + 50ms);
+
+    ss::sleep(500ms).get();
+    BOOST_REQUIRE_EQUAL(fires, 1);
+    BOOST_REQUIRE(w.empty());
+}
+
+SEASTAR_THREAD_TEST_CASE(deadlines_beyond_one_revolution) {
+    // 4 slots x 20ms: anything past 80ms out wraps around the wheel
+    timing_wheel<ss::lowres_clock> w(20ms, 4);
+    bool near_fired = false;
+    bool far_fired = false;
+    timing_wheel<ss::lowres_clock>::entry near;
+    timing_wheel<ss::lowres_clock>::entry far;
+    near.set_callback([&near_fired] { near_fired = true; });
+    far.set_callback([&far_fired] { far_fired = true; });
+    w.arm(near, ss::lowres_clock::now() + 40ms);
+    w.arm(far, ss::lowres_clock::now() + 10s);
+
+    ss::sleep(500ms).get();
+    BOOST_REQUIRE(near_fired);
+    // hashing into an already-swept slot must not expire the entry early
+    BOOST_REQUIRE(!far_fired);
+    BOOST_REQUIRE(far.armed());
+    far.cancel();
+}
+
+SEASTAR_THREAD_TEST_CASE(entry_destruction_disarms) {
+    timing_wheel<ss::lowres_clock> w(20ms);
+    bool fired = false;
+    {
+        timing_wheel<ss::lowres_clock>::entry e;
+        e.set_callback([&fired] { fired = true; });
+        w.arm(e, ss::lowres_clock::now() + 50ms);
+    }
+    BOOST_REQUIRE(w.empty());
+
+    ss::sleep(500ms).get();
+    BOOST_REQUIRE(!fired);
+}
+
+SEASTAR_THREAD_TEST_CASE(move_transfers_the_armed_slot) {
+    timing_wheel<ss::lowres_clock> w(20ms);
+    bool fired = false;
+    timing_wheel<ss::lowres_clock>::entry moved_to;
+    {
+        timing_wheel<ss::lowres_clock>::entry e;
+        e.set_callback([&fired] { fired = true; });
+        w.arm(e, ss::lowres_clock::now() + 50ms);
+        moved_to = std::move(e);
+        BOOST_REQUIRE(!e.armed());
+    }
+    BOOST_REQUIRE(moved_to.armed());
+
+    ss::sleep(500ms).get();
+    BOOST_REQUIRE(fired);
+}
@@ -0,0 +1,95 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/bytes.h"
+#include "utils/vint.h"
+
+#include <seastar/testing/perf_tests.hh>
+
+#include <array>
+
+// a typical record vint run: length, timestamp delta, offset delta, key
+// and value lengths
+static constexpr std::array<int64_t, 5> record_fields{
+  1376, 1234567, 42, 128, 1024};
+
+PERF_TEST(vint, encode_to_bytes) {
+    perf_tests::start_measuring_time();
+    size_t total = 0;
+    for (auto v : record_fields) {
+        auto b = vint::to_bytes(v);
+        total += b.size();
+    }
+    perf_tests::do_not_optimize(total);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vint, encode_field_at_a_time) {
+    std::array<uint8_t, record_fields.size() * vint::max_length> out{};
+    perf_tests::start_measuring_time();
+    size_t idx = 0;
+    for (auto v : record_fields) {
+        idx += vint::serialize(v, out.data() + idx);
+    }
+    perf_tests::do_not_optimize(idx);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vint, encode_batch) {
+    std::array<uint8_t, record_fields.size() * vint::max_length> out{};
+    perf_tests::start_measuring_time();
+    auto idx = vint::serialize_batch(
+      out.data(),
+      record_fields[0],
+      record_fields[1],
+      record_fields[2],
+      record_fields[3],
+      record_fields[4]);
+    perf_tests::do_not_optimize(idx);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vint, decode_field_at_a_time) {
+    std::array<uint8_t, record_fields.size() * vint::max_length> buf{};
+    auto len = vint::serialize_batch(
+      buf.data(),
+      record_fields[0],
+      record_fields[1],
+      record_fields[2],
+      record_fields[3],
+      record_fields[4]);
+    perf_tests::start_measuring_time();
+    size_t consumed = 0;
+    int64_t sum = 0;
+    for (size_t i = 0; i < record_fields.size(); ++i) {
+        auto [v, sz] = vint::deserialize(
+          bytes_view(buf.data() + consumed, len - consumed));
+        sum += v;
+        consumed += sz;
+    }
+    perf_tests::do_not_optimize(sum);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vint, decode_batch) {
+    std::array<uint8_t, record_fields.size() * vint::max_length> buf{};
+    auto len = vint::serialize_batch(
+      buf.data(),
+      record_fields[0],
+      record_fields[1],
+      record_fields[2],
+      record_fields[3],
+      record_fields[4]);
+    perf_tests::start_measuring_time();
+    auto [values, consumed] = vint::deserialize_batch<record_fields.size()>(
+      buf.data(), len);
+    perf_tests::do_not_optimize(values);
+    perf_tests::do_not_optimize(consumed);
+    perf_tests::stop_measuring_time();
+}
@@ -14,6 +14,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <iostream>
@@ -36,3 +37,28 @@ void check_roundtrip_sweep(int64_t count) {
 SEASTAR_THREAD_TEST_CASE(sanity_signed_sweep_64) {
     check_roundtrip_sweep(100000000);
 }
+
+SEASTAR_THREAD_TEST_CASE(batch_kernels_match_single_value_codec) {
+    const std::array<int64_t, 5> values{1376, 1234567, -42, 0, 1024};
+
+    std::array<uint8_t, 5 * vint::max_length> batch{};
+    const auto batch_len = vint::serialize_batch(
+      batch.data(), values[0], values[1], values[2], values[3], values[4]);
+
+    // the batch layout is the per-value encodings back to back
+    std::array<uint8_t, 5 * vint::max_length> singles{};
+    size_t singles_len = 0;
+    for (auto v : values) {
+        singles_len += vint::serialize(v, singles.data() + singles_len);
+    }
+    BOOST_REQUIRE_EQUAL(batch_len, singles_len);
+    BOOST_REQUIRE(std::equal(
+      batch.begin(), batch.begin() + batch_len, singles.begin()));
+
+    auto [decoded, consumed] = vint::deserialize_batch<5>(
+      batch.data(), batch_len);
+    BOOST_REQUIRE_EQUAL(consumed, batch_len);
+    for (size_t i = 0; i < values.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(decoded[i], values[i]);
+    }
+}
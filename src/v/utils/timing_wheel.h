@@ -0,0 +1,192 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+#include "utils/intrusive_list_helpers.h"
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+/**
+ * A hashed timing wheel for coarse timeouts.
+ *
+ * Every `ss::timer` lives in the reactor's timer heap, so arming one
+ * per in-flight request means a heap insert on every dispatch and a
+ * rebalance on every completion - even though almost no request ever
+ * times out. The wheel replaces that with intrusive list operations:
+ * arm() hashes the deadline into one of a fixed number of slots and
+ * links the entry there, cancel() unlinks it, both O(1). A single
+ * driver timer per wheel ticks at the wheel resolution and expires
+ * whatever slots fell due; it disarms itself when the wheel drains.
+ *
+ * The trade-off is precision: expiry is rounded up to the next tick,
+ * so a timeout may fire up to one resolution late (never early).
+ * Request timeouts are approximate by nature, which is exactly why
+ * they tolerate this. Do not use the wheel where firing on time
+ * matters - that is what `ss::timer` is for.
+ *
+ * Entries must stay at a stable address while armed, and callbacks
+ * that capture the owning object's `this` must not outlive a move of
+ * that object - the same contract `ss::timer` imposes.
+ */
+template<typename Clock = ss::lowres_clock>
+class timing_wheel {
+public:
+    using time_point = typename Clock::time_point;
+    using duration = typename Clock::duration;
+
+    static constexpr size_t default_num_slots = 128;
+    static constexpr std::chrono::milliseconds default_resolution{100};
+
+    class entry {
+    public:
+        entry() noexcept = default;
+        entry(const entry&) = delete;
+        entry& operator=(const entry&) = delete;
+        entry(entry&& o) noexcept
+          : _callback(std::move(o._callback))
+          , _tick(o._tick) {
+            _hook.swap_nodes(o._hook);
+        }
+        entry& operator=(entry&& o) noexcept {
+            if (this != &o) {
+                cancel();
+                _callback = std::move(o._callback);
+                _tick = o._tick;
+                _hook.swap_nodes(o._hook);
+            }
+            return *this;
+        }
+        ~entry() noexcept = default; // auto-unlink hook cancels for us
+
+        void set_callback(ss::noncopyable_function<void()> cb) {
+            _callback = std::move(cb);
+        }
+        bool armed() const { return _hook.is_linked(); }
+        /// \brief disarm, returns true if the entry was armed
+        bool cancel() {
+            if (!_hook.is_linked()) {
+                return false;
+            }
+            _hook.unlink();
+            return true;
+        }
+
+    private:
+        friend timing_wheel;
+        intrusive_list_hook _hook;
+        ss::noncopyable_function<void()> _callback;
+        int64_t _tick{0};
+    };
+
+    explicit timing_wheel(
+      duration resolution
+      = std::chrono::duration_cast<duration>(default_resolution),
+      size_t num_slots = default_num_slots)
+      : _resolution(resolution)
+      , _slots(num_slots)
+      , _last_tick(tick_of(Clock::now())) {
+        _driver.set_callback([this] { service(); });
+    }
+    timing_wheel(const timing_wheel&) = delete;
+    timing_wheel& operator=(const timing_wheel&) = delete;
+    timing_wheel(timing_wheel&&) = delete;
+    timing_wheel& operator=(timing_wheel&&) = delete;
+    ~timing_wheel() noexcept = default;
+
+    /// \brief the wheel every subsystem on this shard shares. created on
+    /// first use; its driver timer is disarmed whenever the wheel is empty
+    static timing_wheel& shard_local() {
+        static thread_local timing_wheel w;
+        return w;
+    }
+
+    /// \brief (re)arm \p e to fire no earlier than \p deadline. the entry
+    /// callback must be set and must stay valid until it fires or is
+    /// cancelled
+    void arm(entry& e, time_point deadline) {
+        e.cancel();
+        e._tick = tick_of(deadline);
+        _slots[static_cast<size_t>(e._tick) % _slots.size()].push_back(e);
+        if (!_driver.armed()) {
+            _driver.arm(_resolution);
+        }
+    }
+
+    bool empty() const {
+        return std::all_of(_slots.begin(), _slots.end(), [](const slot_t& s) {
+            return s.empty();
+        });
+    }
+
+private:
+    using slot_t = intrusive_list<entry, &entry::_hook>;
+
+    // round up so an entry never fires before its deadline. written to
+    // avoid overflow for deadlines near time_point::max() (rpc::no_timeout)
+    int64_t tick_of(time_point t) const {
+        const auto d = t.time_since_epoch();
+        int64_t tick = d / _resolution;
+        if (d % _resolution != duration::zero()) {
+            ++tick;
+        }
+        return tick;
+    }
+
+    void service() {
+        const int64_t now_tick = Clock::now().time_since_epoch() / _resolution;
+        const auto n = static_cast<int64_t>(_slots.size());
+        // visit every slot whose turn came up since the last run; capping at
+        // one full revolution still covers every slot if we fell behind
+        const int64_t behind = std::min(now_tick - _last_tick, n);
+        for (int64_t i = 1; i <= behind; ++i) {
+            expire_slot(
+              _slots[static_cast<size_t>(_last_tick + i) % n], now_tick);
+        }
+        _last_tick = now_tick;
+        if (!empty()) {
+            _driver.arm(_resolution);
+        }
+    }
+
+    void expire_slot(slot_t& slot, int64_t now_tick) {
+        // move due entries aside first: callbacks may arm or cancel other
+        // entries in this very slot, invalidating a live iterator
+        slot_t due;
+        for (auto it = slot.begin(); it != slot.end();) {
+            entry& e = *it;
+            ++it;
+            if (e._tick <= now_tick) {
+                e._hook.unlink();
+                due.push_back(e);
+            }
+        }
+        while (!due.empty()) {
+            entry& e = due.front();
+            e._hook.unlink();
+            // detach before invoking: the callback may destroy the entry
+            auto cb = std::move(e._callback);
+            cb();
+        }
+    }
+
+    duration _resolution;
+    std::vector<slot_t> _slots;
+    int64_t _last_tick;
+    ss::timer<Clock> _driver;
+};
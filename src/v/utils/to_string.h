@@ -34,4 +34,9 @@ operator<<(std::ostream& o, const ss::lowres_clock::duration& d) {
     return ss::fmt_print(o, "{}", d.count());
 }
 
+static inline std::ostream&
+operator<<(std::ostream& o, const std::chrono::microseconds& d) {
+    return ss::fmt_print(o, "{}", d.count());
+}
+
 } // namespace std
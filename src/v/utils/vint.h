@@ -12,7 +12,9 @@
 #pragma once
 #include "bytes/bytes.h"
 
+#include <array>
 #include <cstdint>
+#include <type_traits>
 
 // class is actually zigzag vint; always signed ints
 // matches exactly the kafka encoding which uses protobuf
@@ -75,6 +77,25 @@ inline bytes to_bytes(int64_t value) noexcept {
     return out;
 }
 
+/*
+ * bulk kernels. record framing emits a run of small vints back to back
+ * (length, timestamp delta, offset delta, key/value lengths); transcoding
+ * the whole run over one stack buffer is cheaper than a call and a
+ * temporary `bytes` per field - see utils/tests/vint_bench.cc
+ */
+
+/// \brief serialize every value into `out` back to back, returning the
+/// total number of bytes written. the buffer must have room for
+/// `max_length * sizeof...(T)` bytes
+template<typename... T>
+inline size_t serialize_batch(uint8_t* out, T... xs) noexcept {
+    static_assert(sizeof...(T) > 0);
+    static_assert((std::is_convertible_v<T, int64_t> && ...));
+    size_t idx = 0;
+    ((idx += serialize(static_cast<int64_t>(xs), out + idx)), ...);
+    return idx;
+}
+
 /// \brief almost identical impl to leveldb, made generic for c++
 /// friendliness
 /// https://github.com/google/leveldb/blob/201f52201f/util/coding.cc#L116
@@ -97,4 +118,20 @@ inline std::pair<int64_t, size_t> deserialize(Range&& r) noexcept {
     return {decode_zigzag(result), bytes_read};
 }
 
+/// \brief decode `N` values laid out back to back in one contiguous
+/// buffer, returning the values and the total number of bytes consumed
+template<size_t N>
+inline std::pair<std::array<int64_t, N>, size_t>
+deserialize_batch(const uint8_t* src, size_t len) noexcept {
+    static_assert(N > 0);
+    std::array<int64_t, N> values{};
+    size_t consumed = 0;
+    for (auto& v : values) {
+        auto [val, sz] = deserialize(bytes_view(src + consumed, len - consumed));
+        v = val;
+        consumed += sz;
+    }
+    return {values, consumed};
+}
+
 } // namespace vint
@@ -49,6 +49,7 @@ RPC_TEMPLATE = """
 #include <chrono>
 #include <tuple>
 #include <cstdint>
+#include <vector>
 
 namespace {{namespace}} {
 
@@ -88,6 +89,14 @@ public:
          default: return nullptr;
        }
     }
+
+    std::vector<uint32_t> method_ids() const final {
+       return {
+       {%- for method in methods %}
+         {{method.id}}{{ "," if not loop.last }}
+       {%- endfor %}
+       };
+    }
     {%- for method in methods %}
     /// \\brief {{method.input_type}} -> {{method.output_type}}
     virtual ss::future<rpc::netbuf>